@@ -0,0 +1,216 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+#include <limits>
+
+#include <cisstNumerical/nmrKdTree.h>
+
+namespace {
+    // Compare indices of points along one axis, used to find the median
+    class nmrKdTreeAxisCompare
+    {
+    public:
+        nmrKdTreeAxisCompare(const vctDynamicVector<vct3> & points, const int axis):
+            Points(points),
+            Axis(axis)
+        {}
+        inline bool operator()(const size_t a, const size_t b) const {
+            return Points[a][Axis] < Points[b][Axis];
+        }
+    private:
+        const vctDynamicVector<vct3> & Points;
+        const int Axis;
+    };
+}
+
+
+nmrKdTree::nmrKdTree(void):
+    LeafSize(1)
+{
+}
+
+
+void nmrKdTree::BuildInternal(const size_type leafSize)
+{
+    const size_type numPoints = Points.size();
+    LeafSize = (leafSize > 0) ? leafSize : 1;
+    Nodes.clear();
+    Nodes.reserve(2 * (numPoints / LeafSize + 1));
+    Indices.SetSize(numPoints);
+    for (size_type index = 0; index < numPoints; ++index) {
+        Indices[index] = index;
+    }
+    if (numPoints == 0) {
+        InverseIndices.SetSize(0);
+        return;
+    }
+    BuildNode(0, numPoints);
+
+    // store points in tree order so that leaves are contiguous
+    vctDynamicVector<vct3> sorted(numPoints);
+    InverseIndices.SetSize(numPoints);
+    for (size_type index = 0; index < numPoints; ++index) {
+        sorted[index] = Points[Indices[index]];
+        InverseIndices[Indices[index]] = index;
+    }
+    Points.Assign(sorted);
+}
+
+
+nmrKdTree::size_type nmrKdTree::BuildNode(const size_type begin, const size_type end)
+{
+    const size_type nodeIndex = Nodes.size();
+    Nodes.push_back(Node());
+    Nodes[nodeIndex].Begin = begin;
+    Nodes[nodeIndex].End = end;
+    Nodes[nodeIndex].Axis = -1;
+    Nodes[nodeIndex].Split = 0.0;
+    Nodes[nodeIndex].Left = Nodes[nodeIndex].Right = 0;
+
+    if ((end - begin) <= LeafSize) {
+        return nodeIndex;
+    }
+
+    // split along the axis with the largest extent
+    vct3 lower(Points[Indices[begin]]);
+    vct3 upper(lower);
+    for (size_type index = begin + 1; index < end; ++index) {
+        lower.ElementwiseMin(Points[Indices[index]]);
+        upper.ElementwiseMax(Points[Indices[index]]);
+    }
+    const vct3 extent(upper - lower);
+    int axis = 0;
+    if (extent[1] > extent[axis]) axis = 1;
+    if (extent[2] > extent[axis]) axis = 2;
+    if (extent[axis] <= 0.0) {
+        // all points are identical, keep as a leaf
+        return nodeIndex;
+    }
+
+    const size_type middle = begin + (end - begin) / 2;
+    std::nth_element(Indices.Pointer(begin), Indices.Pointer(middle), Indices.Pointer(0) + end,
+                     nmrKdTreeAxisCompare(Points, axis));
+    const double split = Points[Indices[middle]][axis];
+
+    // children are built after the parent so Nodes can be reallocated, don't keep references
+    const size_type left = BuildNode(begin, middle);
+    const size_type right = BuildNode(middle, end);
+    Nodes[nodeIndex].Axis = axis;
+    Nodes[nodeIndex].Split = split;
+    Nodes[nodeIndex].Left = left;
+    Nodes[nodeIndex].Right = right;
+    return nodeIndex;
+}
+
+
+bool nmrKdTree::FindNearest(const vct3 & query,
+                            size_type & index, double & distanceSquared,
+                            const double maxDistance) const
+{
+    if (Nodes.empty()) {
+        return false;
+    }
+    size_type bestIndex = Points.size();
+    double bestDistanceSquared = (maxDistance >= 0.0) ?
+        maxDistance * maxDistance : std::numeric_limits<double>::max();
+    SearchNearest(0, query, bestIndex, bestDistanceSquared);
+    if (bestIndex == Points.size()) {
+        return false;
+    }
+    index = Indices[bestIndex];
+    distanceSquared = bestDistanceSquared;
+    return true;
+}
+
+
+void nmrKdTree::SearchNearest(const size_type nodeIndex, const vct3 & query,
+                              size_type & bestIndex, double & bestDistanceSquared) const
+{
+    const Node & node = Nodes[nodeIndex];
+    if (node.Axis < 0) {
+        const vct3 * point = Points.Pointer(node.Begin);
+        for (size_type index = node.Begin; index < node.End; ++index, ++point) {
+            const double dx = query.X() - point->X();
+            const double dy = query.Y() - point->Y();
+            const double dz = query.Z() - point->Z();
+            const double distanceSquared = dx * dx + dy * dy + dz * dz;
+            if (distanceSquared < bestDistanceSquared) {
+                bestDistanceSquared = distanceSquared;
+                bestIndex = index;
+            }
+        }
+        return;
+    }
+    // visit the side containing the query first, the other one only if the plane is close enough
+    const double offset = query[node.Axis] - node.Split;
+    const size_type nearChild = (offset < 0.0) ? node.Left : node.Right;
+    const size_type farChild = (offset < 0.0) ? node.Right : node.Left;
+    SearchNearest(nearChild, query, bestIndex, bestDistanceSquared);
+    if (offset * offset < bestDistanceSquared) {
+        SearchNearest(farChild, query, bestIndex, bestDistanceSquared);
+    }
+}
+
+
+nmrKdTree::size_type nmrKdTree::FindKNearest(const vct3 & query, const size_type k,
+                                             vctDynamicVector<size_type> & indices,
+                                             vctDoubleVec & distancesSquared) const
+{
+    if (Nodes.empty() || (k == 0)) {
+        return 0;
+    }
+    std::vector<NeighborType> heap;
+    heap.reserve(k + 1);
+    SearchKNearest(0, query, k, heap);
+    std::sort_heap(heap.begin(), heap.end());
+    const size_type found = heap.size();
+    indices.SetSize(found);
+    distancesSquared.SetSize(found);
+    for (size_type index = 0; index < found; ++index) {
+        distancesSquared[index] = heap[index].first;
+        indices[index] = Indices[heap[index].second];
+    }
+    return found;
+}
+
+
+void nmrKdTree::SearchKNearest(const size_type nodeIndex, const vct3 & query, const size_type k,
+                               std::vector<NeighborType> & heap) const
+{
+    const Node & node = Nodes[nodeIndex];
+    if (node.Axis < 0) {
+        for (size_type index = node.Begin; index < node.End; ++index) {
+            const double distanceSquared = (query - Points[index]).NormSquare();
+            if (heap.size() < k) {
+                heap.push_back(NeighborType(distanceSquared, index));
+                std::push_heap(heap.begin(), heap.end());
+            } else if (distanceSquared < heap.front().first) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = NeighborType(distanceSquared, index);
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        return;
+    }
+    const double offset = query[node.Axis] - node.Split;
+    const size_type nearChild = (offset < 0.0) ? node.Left : node.Right;
+    const size_type farChild = (offset < 0.0) ? node.Right : node.Left;
+    SearchKNearest(nearChild, query, k, heap);
+    if ((heap.size() < k) || (offset * offset < heap.front().first)) {
+        SearchKNearest(farChild, query, k, heap);
+    }
+}
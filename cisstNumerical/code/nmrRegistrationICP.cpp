@@ -0,0 +1,394 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstVector/vctRodriguezRotation3.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstNumerical/nmrSVD.h>
+#include <cisstNumerical/nmrRegistrationICP.h>
+
+// range of source points processed by one worker thread; the thread
+// waits for Start, processes its range and raises Done until Stop is set
+struct nmrRegistrationICPRange {
+    nmrRegistrationICP * ICP;
+    size_t Begin, End;
+    bool Stop;
+    osaThread Thread;
+    osaThreadSignal Start;
+    osaThreadSignal Done;
+};
+
+struct nmrRegistrationICPWorkers {
+    std::vector<nmrRegistrationICPRange *> Ranges;
+};
+
+namespace {
+    void * nmrRegistrationICPWorker(nmrRegistrationICPRange * range)
+    {
+        while (true) {
+            range->Start.Wait();
+            if (range->Stop) {
+                break;
+            }
+            range->ICP->FindCorrespondences(range->Begin, range->End);
+            range->Done.Raise();
+        }
+        return 0;
+    }
+
+    // solve A x = b for a symmetric positive definite 6x6 matrix using Cholesky
+    bool nmrRegistrationICPSolve6x6(vctFixedSizeMatrix<double, 6, 6> & A,
+                                    const vctFixedSizeVector<double, 6> & b,
+                                    vctFixedSizeVector<double, 6> & x)
+    {
+        size_t i, j, k;
+        for (j = 0; j < 6; j++) {
+            double diagonal = A.Element(j, j);
+            for (k = 0; k < j; k++) {
+                diagonal -= A.Element(j, k) * A.Element(j, k);
+            }
+            if (diagonal <= 1e-12) {
+                return false;
+            }
+            A.Element(j, j) = sqrt(diagonal);
+            for (i = j + 1; i < 6; i++) {
+                double value = A.Element(i, j);
+                for (k = 0; k < j; k++) {
+                    value -= A.Element(i, k) * A.Element(j, k);
+                }
+                A.Element(i, j) = value / A.Element(j, j);
+            }
+        }
+        // forward and back substitution with L and L^T
+        for (i = 0; i < 6; i++) {
+            double value = b[i];
+            for (k = 0; k < i; k++) {
+                value -= A.Element(i, k) * x[k];
+            }
+            x[i] = value / A.Element(i, i);
+        }
+        for (i = 6; i-- > 0; ) {
+            double value = x[i];
+            for (k = i + 1; k < 6; k++) {
+                value -= A.Element(k, i) * x[k];
+            }
+            x[i] = value / A.Element(i, i);
+        }
+        return true;
+    }
+}
+
+
+nmrRegistrationICP::nmrRegistrationICP(void):
+    Metric(POINT_TO_POINT),
+    MaxIterations(50),
+    Tolerance(1e-6),
+    MaxCorrespondenceDistance(-1.0),
+    OutlierFactor(3.0),
+    NumberOfThreads(1),
+    NormalNeighbors(8),
+    LeafSize(8),
+    Workers(0),
+    NumberOfIterations(0),
+    NumberOfInliers(0)
+{
+}
+
+
+nmrRegistrationICP::~nmrRegistrationICP(void)
+{
+    StopThreads();
+}
+
+
+void nmrRegistrationICP::SetMetric(const MetricType metric)
+{
+    Metric = metric;
+    if ((Metric == POINT_TO_PLANE)
+        && (Tree.size() > 0)
+        && (TargetNormals.size() != Tree.size())) {
+        EstimateTargetNormals();
+    }
+}
+
+
+void nmrRegistrationICP::EstimateTargetNormals(void)
+{
+    const size_type numPoints = Tree.size();
+    TargetNormals.SetSize(numPoints);
+    vctDynamicVector<size_type> neighbors;
+    vctDoubleVec distancesSquared;
+    vctDouble3x3 covariance, U, Vt, outer;
+    vct3 S, mean;
+    for (size_type index = 0; index < numPoints; ++index) {
+        const size_type found = Tree.FindKNearest(Tree.Point(index), NormalNeighbors,
+                                                  neighbors, distancesSquared);
+        mean.SetAll(0.0);
+        for (size_type n = 0; n < found; ++n) {
+            mean.Add(Tree.Point(neighbors[n]));
+        }
+        mean.Divide(static_cast<double>(found));
+        covariance.SetAll(0.0);
+        for (size_type n = 0; n < found; ++n) {
+            const vct3 centered(Tree.Point(neighbors[n]) - mean);
+            outer.OuterProductOf(centered, centered);
+            covariance.Add(outer);
+        }
+        // normal is the direction of least variance
+        nmrSVD(covariance, U, S, Vt);
+        TargetNormals[index].Assign(U.Column(2));
+    }
+}
+
+
+void nmrRegistrationICP::FindCorrespondences(const size_type begin, const size_type end)
+{
+    for (size_type index = begin; index < end; ++index) {
+        Estimate.ApplyTo(Source[index], Transformed[index]);
+        double distanceSquared;
+        if (Tree.FindNearest(Transformed[index], Matches[index], distanceSquared,
+                             MaxCorrespondenceDistance)) {
+            Distances[index] = sqrt(distanceSquared);
+        } else {
+            Distances[index] = -1.0;
+        }
+    }
+}
+
+
+void nmrRegistrationICP::StartThreads(void)
+{
+    StopThreads();
+    const size_type numPoints = Source.size();
+    size_type numThreads = NumberOfThreads;
+    if (numThreads > numPoints) {
+        numThreads = (numPoints > 0) ? numPoints : 1;
+    }
+    if (numThreads == 1) {
+        return;
+    }
+    // the calling thread processes the first range
+    Workers = new nmrRegistrationICPWorkers;
+    Workers->Ranges.resize(numThreads);
+    const size_type rangeSize = numPoints / numThreads;
+    for (size_type thread = 0; thread < numThreads; ++thread) {
+        nmrRegistrationICPRange * range = new nmrRegistrationICPRange;
+        range->ICP = this;
+        range->Begin = thread * rangeSize;
+        range->End = (thread == numThreads - 1) ? numPoints : (thread + 1) * rangeSize;
+        range->Stop = false;
+        Workers->Ranges[thread] = range;
+        if (thread > 0) {
+            range->Thread.Create(&nmrRegistrationICPWorker, range, "nmrICP");
+        }
+    }
+}
+
+
+void nmrRegistrationICP::StopThreads(void)
+{
+    if (!Workers) {
+        return;
+    }
+    const size_type numThreads = Workers->Ranges.size();
+    for (size_type thread = 1; thread < numThreads; ++thread) {
+        Workers->Ranges[thread]->Stop = true;
+        Workers->Ranges[thread]->Start.Raise();
+        Workers->Ranges[thread]->Thread.Wait();
+    }
+    for (size_type thread = 0; thread < numThreads; ++thread) {
+        delete Workers->Ranges[thread];
+    }
+    delete Workers;
+    Workers = 0;
+}
+
+
+void nmrRegistrationICP::ComputeCorrespondences(void)
+{
+    if (!Workers) {
+        FindCorrespondences(0, Source.size());
+        return;
+    }
+    const size_type numThreads = Workers->Ranges.size();
+    for (size_type thread = 1; thread < numThreads; ++thread) {
+        Workers->Ranges[thread]->Start.Raise();
+    }
+    FindCorrespondences(Workers->Ranges[0]->Begin, Workers->Ranges[0]->End);
+    for (size_type thread = 1; thread < numThreads; ++thread) {
+        Workers->Ranges[thread]->Done.Wait();
+    }
+}
+
+
+double nmrRegistrationICP::RejectOutliers(void)
+{
+    const size_type numPoints = Source.size();
+    double threshold = -1.0;
+    if (OutlierFactor > 0.0) {
+        size_type valid = 0;
+        for (size_type index = 0; index < numPoints; ++index) {
+            if (Distances[index] >= 0.0) {
+                SortedDistances[valid] = Distances[index];
+                ++valid;
+            }
+        }
+        if (valid > 0) {
+            double * median = SortedDistances.Pointer(valid / 2);
+            std::nth_element(SortedDistances.Pointer(0), median, SortedDistances.Pointer(0) + valid);
+            // perfect matches would reject everything else
+            if (*median > 0.0) {
+                threshold = OutlierFactor * (*median);
+            }
+        }
+    }
+
+    double sumSquares = 0.0;
+    NumberOfInliers = 0;
+    for (size_type index = 0; index < numPoints; ++index) {
+        const double distance = Distances[index];
+        if ((distance < 0.0)
+            || ((threshold >= 0.0) && (distance > threshold))) {
+            continue;
+        }
+        InlierSource[NumberOfInliers] = (Metric == POINT_TO_PLANE) ? Transformed[index] : Source[index];
+        InlierTarget[NumberOfInliers] = Tree.Point(Matches[index]);
+        if (Metric == POINT_TO_PLANE) {
+            InlierNormal[NumberOfInliers] = TargetNormals[Matches[index]];
+        }
+        sumSquares += distance * distance;
+        ++NumberOfInliers;
+    }
+    if (NumberOfInliers == 0) {
+        return 0.0;
+    }
+    return sqrt(sumSquares / NumberOfInliers);
+}
+
+
+bool nmrRegistrationICP::SolvePointToPlane(vctFrm3 & transform)
+{
+    // minimize sum ((R p + t - q) . n)^2 linearized around identity, x = [omega, t]
+    vctFixedSizeMatrix<double, 6, 6> JtJ(0.0);
+    vctFixedSizeVector<double, 6> Jtr(0.0), x, row;
+    for (size_type index = 0; index < NumberOfInliers; ++index) {
+        const vct3 & p = InlierSource[index];
+        const vct3 & n = InlierNormal[index];
+        const vct3 pxn(vctCrossProduct(p, n));
+        row[0] = pxn[0]; row[1] = pxn[1]; row[2] = pxn[2];
+        row[3] = n[0]; row[4] = n[1]; row[5] = n[2];
+        const double residual = vctDotProduct(p - InlierTarget[index], n);
+        for (size_type i = 0; i < 6; ++i) {
+            for (size_type j = i; j < 6; ++j) {
+                JtJ.Element(i, j) += row[i] * row[j];
+            }
+            Jtr[i] -= row[i] * residual;
+        }
+    }
+    for (size_type i = 0; i < 6; ++i) {
+        for (size_type j = 0; j < i; ++j) {
+            JtJ.Element(i, j) = JtJ.Element(j, i);
+        }
+    }
+    if (!nmrRegistrationICPSolve6x6(JtJ, Jtr, x)) {
+        CMN_LOG_RUN_WARNING << "nmrRegistrationICP: point-to-plane system is singular" << std::endl;
+        return false;
+    }
+    const vctRodRot3 rodriguez(x[0], x[1], x[2]);
+    vctMatRot3 rotation;
+    rotation.From(rodriguez);
+    const vctFrm3 delta(rotation, vct3(x[3], x[4], x[5]));
+    transform = delta * transform;
+    return true;
+}
+
+
+bool nmrRegistrationICP::RegisterInternal(vctFrm3 & transform, double * rms)
+{
+    const size_type numPoints = Source.size();
+    NumberOfIterations = 0;
+    NumberOfInliers = 0;
+    if (Tree.size() == 0) {
+        CMN_LOG_RUN_WARNING << "nmrRegistrationICP: target not set" << std::endl;
+        return false;
+    }
+    if (numPoints < 3) {
+        CMN_LOG_RUN_WARNING << "nmrRegistrationICP called for " << numPoints << " points." << std::endl;
+        return false;
+    }
+    if ((Metric == POINT_TO_PLANE) && (TargetNormals.size() != Tree.size())) {
+        CMN_LOG_RUN_WARNING << "nmrRegistrationICP: point-to-plane requires one normal per target point" << std::endl;
+        return false;
+    }
+
+    // buffers are only reallocated if the number of points changed
+    Transformed.SetSize(numPoints);
+    Matches.SetSize(numPoints);
+    Distances.SetSize(numPoints);
+    SortedDistances.SetSize(numPoints);
+    InlierSource.SetSize(numPoints);
+    InlierTarget.SetSize(numPoints);
+    if (Metric == POINT_TO_PLANE) {
+        InlierNormal.SetSize(numPoints);
+    }
+
+    Estimate = transform;
+    StartThreads();
+    double error = 0.0;
+    double previousError = -1.0;
+    while (NumberOfIterations < MaxIterations) {
+        ++NumberOfIterations;
+        ComputeCorrespondences();
+        error = RejectOutliers();
+        if (NumberOfInliers < 3) {
+            CMN_LOG_RUN_WARNING << "nmrRegistrationICP: not enough inliers ("
+                                << NumberOfInliers << ") at iteration " << NumberOfIterations << std::endl;
+            StopThreads();
+            return false;
+        }
+        if ((previousError >= 0.0)
+            && (fabs(previousError - error) <= Tolerance * previousError)) {
+            break;
+        }
+        previousError = error;
+
+        if (Metric == POINT_TO_PLANE) {
+            if (!SolvePointToPlane(Estimate)) {
+                StopThreads();
+                return false;
+            }
+        } else {
+            // closed form solution from original source points to matched target points
+            vctDynamicConstVectorRef<vct3> source(InlierSource, 0, NumberOfInliers);
+            vctDynamicConstVectorRef<vct3> target(InlierTarget, 0, NumberOfInliers);
+            if (!nmrRegistrationRigid(source, target, Estimate)) {
+                StopThreads();
+                return false;
+            }
+        }
+    }
+
+    StopThreads();
+    transform = Estimate;
+    if (rms) {
+        *rms = error;
+    }
+    return true;
+}
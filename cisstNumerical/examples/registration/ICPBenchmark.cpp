@@ -0,0 +1,140 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// This program measures the time spent building the nmrKdTree, searching
+// for correspondences and running nmrRegistrationICP on synthetic point
+// clouds sampled on a sphere with a bump.  Default is 100k points per cloud.
+//
+// Syntax: nmrExRegistrationICP [number_of_points] [max_threads]
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cisstVector/vctRandom.h>
+#include <cisstOSAbstraction/osaStopwatch.h>
+#include <cisstNumerical/nmrKdTree.h>
+#include <cisstNumerical/nmrRegistrationICP.h>
+
+using namespace std;
+
+// Sample points on a unit sphere with a bump so that the registration is
+// not rotationally ambiguous
+void CreateCloud(vctDynamicVector<vct3> & points, const double radius)
+{
+    for (size_t index = 0; index < points.size(); ++index) {
+        vct3 direction;
+        do {
+            vctRandom(direction, -1.0, 1.0);
+        } while ((direction.Norm() > 1.0) || (direction.Norm() < 1e-3));
+        direction.NormalizedSelf();
+        double scale = radius;
+        if (direction.Z() > 0.8) {
+            scale += 0.2 * radius * (direction.Z() - 0.8) / 0.2;
+        }
+        if (direction.X() > 0.9) {
+            scale -= 0.1 * radius;
+        }
+        points[index] = scale * direction;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    size_t numPoints = 100000;
+    size_t maxThreads = 4;
+    if (argc > 1) {
+        numPoints = static_cast<size_t>(atoi(argv[1]));
+    }
+    if (argc > 2) {
+        maxThreads = static_cast<size_t>(atoi(argv[2]));
+    }
+
+    vctDynamicVector<vct3> target(numPoints), scan(numPoints);
+    CreateCloud(target, 100.0);
+    CreateCloud(scan, 100.0);
+
+    vctMatRot3 rotation;
+    rotation.From(vctAxAnRot3(vct3(0.2, 0.3, 1.0).Normalized(), 5.0 * cmnPI_180));
+    const vctFrm3 motion(rotation, vct3(2.0, -3.0, 1.0));
+    const vctFrm3 inverse(motion.Inverse());
+    for (size_t index = 0; index < numPoints; ++index) {
+        scan[index] = inverse * scan[index];
+    }
+
+    osaStopwatch stopwatch;
+    nmrKdTree tree;
+    stopwatch.Start();
+    tree.Build(target);
+    stopwatch.Stop();
+    printf("Points per cloud: %lu\n", static_cast<unsigned long>(numPoints));
+    printf("k-d tree build:   %8.3lf ms\n", 1000.0 * stopwatch.GetElapsedTime());
+
+    // exhaustive search on a small subset, extrapolated
+    const size_t bruteForceQueries = 100;
+    stopwatch.Reset();
+    stopwatch.Start();
+    double checksum = 0.0;
+    for (size_t query = 0; query < bruteForceQueries; ++query) {
+        double best = (target[0] - scan[query]).NormSquare();
+        for (size_t index = 1; index < numPoints; ++index) {
+            const double distance = (target[index] - scan[query]).NormSquare();
+            if (distance < best) {
+                best = distance;
+            }
+        }
+        checksum += best;
+    }
+    stopwatch.Stop();
+    printf("Exhaustive search: %8.3lf ms for all points (extrapolated)\n",
+           1000.0 * stopwatch.GetElapsedTime() * numPoints / bruteForceQueries);
+
+    size_t found;
+    double distanceSquared;
+    stopwatch.Reset();
+    stopwatch.Start();
+    for (size_t index = 0; index < numPoints; ++index) {
+        tree.FindNearest(scan[index], found, distanceSquared);
+        checksum += distanceSquared;
+    }
+    stopwatch.Stop();
+    printf("k-d tree search:   %8.3lf ms for all points\n", 1000.0 * stopwatch.GetElapsedTime());
+
+    nmrRegistrationICP icp;
+    icp.SetTarget(target);
+    for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        icp.SetNumberOfThreads(numThreads);
+        for (int metric = 0; metric < 2; ++metric) {
+            icp.SetMetric(metric ? nmrRegistrationICP::POINT_TO_PLANE : nmrRegistrationICP::POINT_TO_POINT);
+            vctFrm3 transform;
+            double rms = 0.0;
+            stopwatch.Reset();
+            stopwatch.Start();
+            const bool result = icp.Register(scan, transform, &rms);
+            stopwatch.Stop();
+            const vctFrm3 error(motion.Inverse() * transform);
+            printf("ICP %s, %lu thread(s): %s, %3lu iterations, %8.3lf ms, rms %8.5lf, translation error %8.5lf\n",
+                   metric ? "point-to-plane" : "point-to-point",
+                   static_cast<unsigned long>(numThreads),
+                   result ? "ok" : "failed",
+                   static_cast<unsigned long>(icp.GetNumberOfIterations()),
+                   1000.0 * stopwatch.GetElapsedTime(), rms,
+                   error.Translation().Norm());
+        }
+    }
+    // prevent the searches from being optimized out
+    return (checksum < 0.0) ? 1 : 0;
+}
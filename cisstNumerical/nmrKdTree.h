@@ -0,0 +1,133 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _nmrKdTree_h
+#define _nmrKdTree_h
+
+#include <vector>
+
+#include <cisstVector/vctTypes.h>
+#include <cisstVector/vctDynamicVectorTypes.h>
+
+// Always include last
+#include <cisstNumerical/nmrExport.h>
+
+/*! \brief k-d tree for nearest neighbor queries on a set of 3D points.
+
+  The tree is built once from a set of vct3 (O(N log N), splitting
+  along the axis of largest extent at the median) and can then be
+  queried for the nearest point or the k nearest points of any query
+  position.  Points are stored internally in tree order so that the
+  points of a leaf are contiguous in memory; all returned indices
+  refer to the position of the point in the original data set.
+
+  Queries are const and do not modify the tree, so a single tree can
+  be searched concurrently from several threads (see
+  nmrRegistrationICP).
+*/
+class CISST_EXPORT nmrKdTree
+{
+public:
+    typedef size_t size_type;
+
+    /*! Default constructor, creates an empty tree. */
+    nmrKdTree(void);
+
+    /*! Constructor, builds the tree from a set of points. */
+    template <class _vectorOwnerType>
+    nmrKdTree(const vctDynamicConstVectorBase<_vectorOwnerType, vct3> & points,
+              const size_type leafSize = 8):
+        LeafSize(1)
+    {
+        Build(points, leafSize);
+    }
+
+    /*! Build the tree from a set of points.  The points are copied
+      so the input can be released after this call.  The leaf size is
+      the maximum number of points stored in a leaf, small values lead
+      to deeper trees. */
+    template <class _vectorOwnerType>
+    void Build(const vctDynamicConstVectorBase<_vectorOwnerType, vct3> & points,
+               const size_type leafSize = 8)
+    {
+        Points.SetSize(points.size());
+        for (size_type index = 0; index < points.size(); ++index) {
+            Points[index] = points[index];
+        }
+        BuildInternal(leafSize);
+    }
+
+    /*! Number of points in the tree. */
+    inline size_type size(void) const {
+        return Points.size();
+    }
+
+    /*! Point stored in the tree, using the index of the original data set. */
+    inline const vct3 & Point(const size_type index) const {
+        return Points[InverseIndices[index]];
+    }
+
+    /*! Find the nearest point to query.  If maxDistance is positive,
+      only points closer than maxDistance are considered.
+      \param query Query position
+      \param index Index of the nearest point in the original data set
+      \param distanceSquared Squared distance to the nearest point
+      \param maxDistance Maximum search radius, ignored if negative
+      \returns false if the tree is empty or no point was found within maxDistance */
+    bool FindNearest(const vct3 & query,
+                     size_type & index, double & distanceSquared,
+                     const double maxDistance = -1.0) const;
+
+    /*! Find the k nearest points to query, sorted by increasing
+      distance.  The output vectors are resized only if needed.
+      \returns number of points found, i.e. min(k, size()) */
+    size_type FindKNearest(const vct3 & query, const size_type k,
+                           vctDynamicVector<size_type> & indices,
+                           vctDoubleVec & distancesSquared) const;
+
+protected:
+    /*! Node of the tree.  Leaves have Axis set to -1 and refer to the
+      range [Begin, End) of Points.  Inner nodes store the splitting
+      plane and the indices of their children in Nodes. */
+    struct Node {
+        double Split;
+        int Axis;
+        size_type Begin, End;
+        size_type Left, Right;
+    };
+
+    /*! Build the tree from Points, reorders Points */
+    void BuildInternal(const size_type leafSize);
+    size_type BuildNode(const size_type begin, const size_type end);
+
+    void SearchNearest(const size_type nodeIndex, const vct3 & query,
+                       size_type & bestIndex, double & bestDistanceSquared) const;
+
+    typedef std::pair<double, size_type> NeighborType;
+    void SearchKNearest(const size_type nodeIndex, const vct3 & query, const size_type k,
+                        std::vector<NeighborType> & heap) const;
+
+    size_type LeafSize;
+    std::vector<Node> Nodes;
+    /*! Points sorted in tree order */
+    vctDynamicVector<vct3> Points;
+    /*! Tree order to original index */
+    vctDynamicVector<size_type> Indices;
+    /*! Original index to tree order */
+    vctDynamicVector<size_type> InverseIndices;
+};
+
+#endif // _nmrKdTree_h
@@ -0,0 +1,215 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _nmrRegistrationICP_h
+#define _nmrRegistrationICP_h
+
+#include <cisstVector/vctTypes.h>
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstNumerical/nmrKdTree.h>
+#include <cisstNumerical/nmrRegistrationRigid.h>
+
+// Always include last
+#include <cisstNumerical/nmrExport.h>
+
+/*! \brief Iterative Closest Point (ICP) registration of a point cloud
+  to a target point cloud.
+
+  The target is indexed once with a nmrKdTree (see SetTarget) and can
+  then be used for any number of registrations.  Each iteration:
+
+  - transforms the source points with the current estimate and finds
+    the closest target point of each source point.  The search is
+    split over NumberOfThreads threads (osaThread), each thread
+    processing a contiguous range of source points.
+  - rejects outliers, i.e. pairs further apart than the maximum
+    correspondence distance or than OutlierFactor times the median
+    pair distance.
+  - computes the new estimate.  For the POINT_TO_POINT metric the
+    closed form solution of nmrRegistrationRigid is used on the
+    inlier pairs, for POINT_TO_PLANE the linearized point-to-plane
+    error (Chen and Medioni, 1991) is minimized using the target
+    normals.
+
+  Iterations stop when the relative change of the RMS error is below
+  the tolerance or after MaxIterations.  All buffers are kept between
+  calls and only reallocated when the number of source points changes.
+  The worker threads are created once per call to Register and reused
+  for all its iterations.
+
+  \code
+  nmrRegistrationICP icp;
+  icp.SetTarget(model);
+  icp.SetNumberOfThreads(4);
+  vctFrm3 transform; // initial guess, identity
+  double rms;
+  if (icp.Register(scan, transform, &rms)) {
+      ...
+  }
+  \endcode
+*/
+struct nmrRegistrationICPWorkers;
+
+class CISST_EXPORT nmrRegistrationICP
+{
+public:
+    typedef size_t size_type;
+
+    typedef enum {POINT_TO_POINT, POINT_TO_PLANE} MetricType;
+
+    nmrRegistrationICP(void);
+    ~nmrRegistrationICP(void);
+
+    /*! Set target points.  Builds the search tree.  If the metric
+      is POINT_TO_PLANE, normals are estimated from the
+      NormalNeighbors closest points of each target point. */
+    template <class _vectorOwnerType>
+    void SetTarget(const vctDynamicConstVectorBase<_vectorOwnerType, vct3> & points) {
+        Tree.Build(points, LeafSize);
+        TargetNormals.SetSize(0);
+        if (Metric == POINT_TO_PLANE) {
+            EstimateTargetNormals();
+        }
+    }
+
+    /*! Set target points and their unit normals. */
+    template <class _vectorOwnerType1, class _vectorOwnerType2>
+    void SetTarget(const vctDynamicConstVectorBase<_vectorOwnerType1, vct3> & points,
+                   const vctDynamicConstVectorBase<_vectorOwnerType2, vct3> & normals) {
+        Tree.Build(points, LeafSize);
+        TargetNormals.ForceAssign(normals);
+    }
+
+    /*! Register source points to the target.
+      \param source Source points
+      \param transform On input, initial estimate.  On output, computed
+      transformation from source to target
+      \param rms Pointer to location to store the RMS distance between
+      inlier pairs, if not 0.
+      \returns true if registration successful */
+    template <class _vectorOwnerType>
+    bool Register(const vctDynamicConstVectorBase<_vectorOwnerType, vct3> & source,
+                  vctFrm3 & transform, double * rms = 0) {
+        Source.ForceAssign(source);
+        return RegisterInternal(transform, rms);
+    }
+
+    /*! Metric minimized at each iteration, default is POINT_TO_POINT. */
+    void SetMetric(const MetricType metric);
+    inline MetricType GetMetric(void) const {
+        return Metric;
+    }
+
+    /*! Maximum number of iterations, default is 50. */
+    inline void SetMaxIterations(const size_type maxIterations) {
+        MaxIterations = maxIterations;
+    }
+
+    /*! Convergence threshold on relative change of RMS error, default is 1e-6. */
+    inline void SetTolerance(const double tolerance) {
+        Tolerance = tolerance;
+    }
+
+    /*! Pairs further apart are never used, default is negative, i.e. no limit. */
+    inline void SetMaxCorrespondenceDistance(const double distance) {
+        MaxCorrespondenceDistance = distance;
+    }
+
+    /*! Pairs further apart than factor times the median distance are
+      rejected, default is 3.  Use 0 to disable. */
+    inline void SetOutlierFactor(const double factor) {
+        OutlierFactor = factor;
+    }
+
+    /*! Number of threads used for correspondence search, default is 1. */
+    inline void SetNumberOfThreads(const size_type numberOfThreads) {
+        NumberOfThreads = (numberOfThreads > 0) ? numberOfThreads : 1;
+    }
+
+    /*! Number of neighbors used to estimate target normals, default is 8. */
+    inline void SetNormalNeighbors(const size_type neighbors) {
+        NormalNeighbors = (neighbors >= 3) ? neighbors : 3;
+    }
+
+    /*! Search tree used for the target points. */
+    inline const nmrKdTree & GetTargetTree(void) const {
+        return Tree;
+    }
+
+    /*! Target normals, empty unless provided or estimated. */
+    inline const vctDynamicVector<vct3> & GetTargetNormals(void) const {
+        return TargetNormals;
+    }
+
+    /*! Results of last call to Register. */
+    //@{
+    inline size_type GetNumberOfIterations(void) const {
+        return NumberOfIterations;
+    }
+    inline size_type GetNumberOfInliers(void) const {
+        return NumberOfInliers;
+    }
+    //@}
+
+    /*! Find closest target point for source points [begin, end), used by worker threads. */
+    void FindCorrespondences(const size_type begin, const size_type end);
+
+protected:
+    bool RegisterInternal(vctFrm3 & transform, double * rms);
+    void EstimateTargetNormals(void);
+    void ComputeCorrespondences(void);
+    /*! Create and stop the worker threads used by ComputeCorrespondences */
+    void StartThreads(void);
+    void StopThreads(void);
+    /*! Keep inliers, returns rms distance of inliers */
+    double RejectOutliers(void);
+    bool SolvePointToPlane(vctFrm3 & transform);
+
+    MetricType Metric;
+    size_type MaxIterations;
+    double Tolerance;
+    double MaxCorrespondenceDistance;
+    double OutlierFactor;
+    size_type NumberOfThreads;
+    size_type NormalNeighbors;
+    size_type LeafSize;
+
+    nmrKdTree Tree;
+    vctDynamicVector<vct3> TargetNormals;
+
+    /*! Buffers, reused between iterations and calls */
+    //@{
+    vctDynamicVector<vct3> Source;
+    vctDynamicVector<vct3> Transformed;
+    vctDynamicVector<size_type> Matches;
+    vctDoubleVec Distances;
+    vctDoubleVec SortedDistances;
+    vctDynamicVector<vct3> InlierSource;
+    vctDynamicVector<vct3> InlierTarget;
+    vctDynamicVector<vct3> InlierNormal;
+    //@}
+
+    /*! Worker threads, only while Register runs */
+    nmrRegistrationICPWorkers * Workers;
+
+    /*! Current estimate, used by worker threads */
+    vctFrm3 Estimate;
+
+    size_type NumberOfIterations;
+    size_type NumberOfInliers;
+};
+
+#endif // _nmrRegistrationICP_h
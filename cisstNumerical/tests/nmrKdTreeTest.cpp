@@ -0,0 +1,140 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+
+#include <cisstVector/vctRandom.h>
+
+#include "nmrKdTreeTest.h"
+
+
+size_t nmrKdTreeTest::BruteForceNearest(const vctDynamicVector<vct3> & points,
+                                        const vct3 & query, double & distanceSquared)
+{
+    size_t best = 0;
+    distanceSquared = (points[0] - query).NormSquare();
+    for (size_t index = 1; index < points.size(); ++index) {
+        const double current = (points[index] - query).NormSquare();
+        if (current < distanceSquared) {
+            distanceSquared = current;
+            best = index;
+        }
+    }
+    return best;
+}
+
+
+void nmrKdTreeTest::TestEmpty(void)
+{
+    nmrKdTree tree;
+    size_t index;
+    double distanceSquared;
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), tree.size());
+    CPPUNIT_ASSERT(!tree.FindNearest(vct3(0.0), index, distanceSquared));
+}
+
+
+void nmrKdTreeTest::TestFindNearest(void)
+{
+    vctDynamicVector<vct3> points(1000);
+    size_t index;
+    for (index = 0; index < points.size(); ++index) {
+        vctRandom(points[index], -100.0, 100.0);
+    }
+    nmrKdTree tree(points, 4);
+    CPPUNIT_ASSERT_EQUAL(points.size(), tree.size());
+    for (index = 0; index < points.size(); ++index) {
+        CPPUNIT_ASSERT(points[index].Equal(tree.Point(index)));
+    }
+
+    vct3 query;
+    size_t found, expected;
+    double distanceSquared, expectedDistanceSquared;
+    for (index = 0; index < 200; ++index) {
+        vctRandom(query, -120.0, 120.0);
+        expected = BruteForceNearest(points, query, expectedDistanceSquared);
+        CPPUNIT_ASSERT(tree.FindNearest(query, found, distanceSquared));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedDistanceSquared, distanceSquared, 1e-9);
+        CPPUNIT_ASSERT(points[expected].Equal(points[found]));
+    }
+}
+
+
+void nmrKdTreeTest::TestFindNearestMaxDistance(void)
+{
+    vctDynamicVector<vct3> points(3);
+    points[0].Assign(0.0, 0.0, 0.0);
+    points[1].Assign(10.0, 0.0, 0.0);
+    points[2].Assign(0.0, 10.0, 0.0);
+    nmrKdTree tree(points, 1);
+    size_t index;
+    double distanceSquared;
+    CPPUNIT_ASSERT(!tree.FindNearest(vct3(5.0, 5.0, 5.0), index, distanceSquared, 1.0));
+    CPPUNIT_ASSERT(tree.FindNearest(vct3(9.5, 0.0, 0.0), index, distanceSquared, 1.0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), index);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, distanceSquared, 1e-12);
+}
+
+
+void nmrKdTreeTest::TestFindKNearest(void)
+{
+    vctDynamicVector<vct3> points(500);
+    size_t index;
+    for (index = 0; index < points.size(); ++index) {
+        vctRandom(points[index], -10.0, 10.0);
+    }
+    nmrKdTree tree(points);
+
+    const size_t k = 7;
+    vctDynamicVector<size_t> indices;
+    vctDoubleVec distancesSquared;
+    vctDoubleVec allDistances(points.size());
+    vct3 query;
+    for (size_t test = 0; test < 50; ++test) {
+        vctRandom(query, -10.0, 10.0);
+        CPPUNIT_ASSERT_EQUAL(k, tree.FindKNearest(query, k, indices, distancesSquared));
+        for (index = 0; index < points.size(); ++index) {
+            allDistances[index] = (points[index] - query).NormSquare();
+        }
+        std::sort(allDistances.begin(), allDistances.end());
+        for (index = 0; index < k; ++index) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(allDistances[index], distancesSquared[index], 1e-9);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(allDistances[index],
+                                         (points[indices[index]] - query).NormSquare(), 1e-9);
+        }
+    }
+    // more neighbors than points
+    vctDynamicVector<vct3> few(3, vct3(1.0));
+    nmrKdTree small(few);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), small.FindKNearest(query, k, indices, distancesSquared));
+}
+
+
+void nmrKdTreeTest::TestDuplicates(void)
+{
+    vctDynamicVector<vct3> points(100, vct3(1.0, 2.0, 3.0));
+    points[42].Assign(5.0, 5.0, 5.0);
+    nmrKdTree tree(points, 2);
+    size_t index;
+    double distanceSquared;
+    CPPUNIT_ASSERT(tree.FindNearest(vct3(5.0, 5.0, 4.0), index, distanceSquared));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(42), index);
+    CPPUNIT_ASSERT(tree.FindNearest(vct3(1.0, 2.0, 3.5), index, distanceSquared));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, distanceSquared, 1e-12);
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(nmrKdTreeTest);
@@ -0,0 +1,57 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#ifndef _nmrKdTreeTest_h
+#define _nmrKdTreeTest_h
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cisstNumerical/nmrKdTree.h>
+
+class nmrKdTreeTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(nmrKdTreeTest);
+
+    CPPUNIT_TEST(TestEmpty);
+    CPPUNIT_TEST(TestFindNearest);
+    CPPUNIT_TEST(TestFindNearestMaxDistance);
+    CPPUNIT_TEST(TestFindKNearest);
+    CPPUNIT_TEST(TestDuplicates);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void setUp()
+    {}
+
+    void tearDown()
+    {}
+
+    /*! Nearest point using exhaustive search */
+    static size_t BruteForceNearest(const vctDynamicVector<vct3> & points,
+                                    const vct3 & query, double & distanceSquared);
+
+    void TestEmpty(void);
+    void TestFindNearest(void);
+    void TestFindNearestMaxDistance(void);
+    void TestFindKNearest(void);
+    void TestDuplicates(void);
+};
+
+#endif // _nmrKdTreeTest_h
@@ -0,0 +1,124 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctRandom.h>
+
+#include "nmrRegistrationICPTest.h"
+
+
+void nmrRegistrationICPTest::setUp(void)
+{
+    // sample a non-symmetric box so that the registration is well defined
+    const vct3 size(40.0, 25.0, 15.0);
+    Model.SetSize(3000);
+    for (size_t index = 0; index < Model.size(); ++index) {
+        vct3 & point = Model[index];
+        vctRandom(point, 0.0, 1.0);
+        const size_t face = index % 3;
+        point[face] = ((index / 3) % 2) ? 1.0 : 0.0;
+        point.ElementwiseMultiply(size);
+    }
+    vctMatRot3 rotation;
+    rotation.From(vctAxAnRot3(vct3(0.3, 1.0, 0.2).Normalized(), 6.0 * cmnPI_180));
+    Motion.Assign(rotation, vct3(1.5, -2.0, 0.8));
+}
+
+
+void nmrRegistrationICPTest::CreateScan(const vctFrm3 & transform, vctDynamicVector<vct3> & scan) const
+{
+    // scan is Model in the source frame, i.e. target = transform * scan
+    const vctFrm3 inverse(transform.Inverse());
+    scan.SetSize(Model.size());
+    for (size_t index = 0; index < Model.size(); ++index) {
+        scan[index] = inverse * Model[index];
+    }
+}
+
+
+void nmrRegistrationICPTest::CheckTransform(const vctFrm3 & expected, const vctFrm3 & computed,
+                                            const double tolerance) const
+{
+    CPPUNIT_ASSERT(expected.Translation().AlmostEqual(computed.Translation(), tolerance));
+    CPPUNIT_ASSERT(expected.Rotation().AlmostEqual(computed.Rotation(), tolerance));
+}
+
+
+void nmrRegistrationICPTest::TestPointToPoint(void)
+{
+    vctDynamicVector<vct3> scan;
+    CreateScan(Motion, scan);
+    nmrRegistrationICP icp;
+    icp.SetMaxIterations(100);
+    icp.SetTarget(Model);
+    vctFrm3 transform;
+    double rms;
+    CPPUNIT_ASSERT(icp.Register(scan, transform, &rms));
+    CheckTransform(Motion, transform, 1e-3);
+    CPPUNIT_ASSERT(rms < 1e-3);
+    CPPUNIT_ASSERT(icp.GetNumberOfIterations() > 1);
+}
+
+
+void nmrRegistrationICPTest::TestPointToPlane(void)
+{
+    vctDynamicVector<vct3> scan;
+    CreateScan(Motion, scan);
+    nmrRegistrationICP icp;
+    icp.SetMetric(nmrRegistrationICP::POINT_TO_PLANE);
+    icp.SetTarget(Model);
+    CPPUNIT_ASSERT_EQUAL(Model.size(), icp.GetTargetNormals().size());
+    vctFrm3 transform;
+    double rms;
+    CPPUNIT_ASSERT(icp.Register(scan, transform, &rms));
+    CheckTransform(Motion, transform, 1e-3);
+}
+
+
+void nmrRegistrationICPTest::TestOutliers(void)
+{
+    vctDynamicVector<vct3> scan;
+    CreateScan(Motion, scan);
+    // move 5% of the points far away
+    for (size_t index = 0; index < scan.size(); index += 20) {
+        scan[index].Add(vct3(0.0, 0.0, 50.0));
+    }
+    nmrRegistrationICP icp;
+    icp.SetMaxIterations(100);
+    icp.SetTarget(Model);
+    vctFrm3 transform;
+    CPPUNIT_ASSERT(icp.Register(scan, transform));
+    CheckTransform(Motion, transform, 1e-2);
+    CPPUNIT_ASSERT(icp.GetNumberOfInliers() < scan.size());
+}
+
+
+void nmrRegistrationICPTest::TestThreads(void)
+{
+    vctDynamicVector<vct3> scan;
+    CreateScan(Motion, scan);
+    nmrRegistrationICP single, multiple;
+    single.SetTarget(Model);
+    multiple.SetTarget(Model);
+    multiple.SetNumberOfThreads(4);
+    vctFrm3 transformSingle, transformMultiple;
+    CPPUNIT_ASSERT(single.Register(scan, transformSingle));
+    CPPUNIT_ASSERT(multiple.Register(scan, transformMultiple));
+    CPPUNIT_ASSERT_EQUAL(single.GetNumberOfIterations(), multiple.GetNumberOfIterations());
+    CheckTransform(transformSingle, transformMultiple, 1e-12);
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(nmrRegistrationICPTest);
@@ -0,0 +1,62 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#ifndef _nmrRegistrationICPTest_h
+#define _nmrRegistrationICPTest_h
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cisstNumerical/nmrRegistrationICP.h>
+
+class nmrRegistrationICPTest : public CppUnit::TestCase
+{
+    CPPUNIT_TEST_SUITE(nmrRegistrationICPTest);
+
+    CPPUNIT_TEST(TestPointToPoint);
+    CPPUNIT_TEST(TestPointToPlane);
+    CPPUNIT_TEST(TestOutliers);
+    CPPUNIT_TEST(TestThreads);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void setUp();
+
+    void tearDown()
+    {}
+
+    /*! Apply transform to Model and add small motion to create Scan */
+    void CreateScan(const vctFrm3 & transform, vctDynamicVector<vct3> & scan) const;
+
+    /*! Compare computed transformation to expected one */
+    void CheckTransform(const vctFrm3 & expected, const vctFrm3 & computed, const double tolerance) const;
+
+    void TestPointToPoint(void);
+    void TestPointToPlane(void);
+    void TestOutliers(void);
+    void TestThreads(void);
+
+protected:
+    /*! Points sampled on the surface of a box */
+    vctDynamicVector<vct3> Model;
+    /*! Transformation used to create scans, close to identity */
+    vctFrm3 Motion;
+};
+
+#endif // _nmrRegistrationICPTest_h
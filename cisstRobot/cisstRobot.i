@@ -102,3 +102,11 @@ namespace std {
 %include "cisstRobot/robDH.h"
 %include "cisstRobot/robModifiedDH.h"
 %include "cisstRobot/robHayati.h"
+
+// Trajectory generators.  EvaluateTimes and EvaluatePeriod use
+// vctDynamicMatrixRef outputs so preallocated numpy arrays (one row
+// per sample, one column per joint) are filled in place
+%include "cisstRobot/robLSPB.h"
+%include "cisstRobot/robFunction.h"
+%include "cisstRobot/robFunctionRn.h"
+%include "cisstRobot/robQuintic.h"
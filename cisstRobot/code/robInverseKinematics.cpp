@@ -0,0 +1,507 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*-    */
+/* ex: set filetype=cpp softtabstop=2 shiftwidth=2 tabstop=2 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstCommon/cmnConstants.h>
+#include <cisstCommon/cmnTypeTraits.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstRobot/robInverseKinematics.h>
+
+namespace {
+
+  // range of targets or thread index processed by one thread
+  struct robInverseKinematicsTask {
+    robInverseKinematics* solver;
+    size_t thread;
+    size_t begin, end;
+  };
+
+  void* robInverseKinematicsBatchWorker( robInverseKinematicsTask* task ){
+    task->solver->SolveRange( task->thread, task->begin, task->end );
+    return NULL;
+  }
+
+  void* robInverseKinematicsSeedsWorker( robInverseKinematicsTask* task ){
+    task->solver->SolveSeeds( task->thread );
+    return NULL;
+  }
+
+  // solve A x = b in place (b <- x) for a 6x6 symmetric positive definite A
+  bool robInverseKinematicsSolve6x6( vctFixedSizeMatrix<double,6,6>& A,
+                                     vctFixedSizeVector<double,6>& b ){
+    for( size_t j=0; j<6; j++ ){
+      double d = A[j][j];
+      for( size_t k=0; k<j; k++ ) { d -= A[j][k]*A[j][k]; }
+      if( d <= 0.0 ) { return false; }
+      A[j][j] = sqrt( d );
+      for( size_t r=j+1; r<6; r++ ){
+        double s = A[r][j];
+        for( size_t k=0; k<j; k++ ) { s -= A[r][k]*A[j][k]; }
+        A[r][j] = s / A[j][j];
+      }
+    }
+    for( size_t r=0; r<6; r++ ){
+      for( size_t k=0; k<r; k++ ) { b[r] -= A[r][k]*b[k]; }
+      b[r] /= A[r][r];
+    }
+    for( int r=5; 0<=r; r-- ){
+      for( size_t k=r+1; k<6; k++ ) { b[r] -= A[k][r]*b[k]; }
+      b[r] /= A[r][r];
+    }
+    return true;
+  }
+
+}
+
+robInverseKinematics::robInverseKinematics( const robManipulator& robot ) :
+  robot( robot ),
+  positionTolerance( 1e-6 ),
+  orientationTolerance( 1e-6 ),
+  maxIterations( 100 ),
+  damping( 1e-3 ),
+  jointLimits( true ),
+  numberOfThreads( 1 ),
+  numberOfSeeds( 1 ),
+  randomSeed( 1 ),
+  numberOfIterations( 0 ),
+  positionError( 0.0 ),
+  orientationError( 0.0 ),
+  batchTargets( NULL ),
+  batchSolutions( NULL ),
+  batchConverged( NULL ),
+  multiStartTarget( NULL ),
+  multiStartGuess( NULL ),
+  multiStartNextSeed( 0 ),
+  multiStartDone( false ),
+  multiStartBestError( 0.0 ){}
+
+robInverseKinematics::~robInverseKinematics(){
+  for( size_t i=0; i<workspaces.size(); i++ )
+    { delete workspaces[i]; }
+}
+
+void robInverseKinematics::SetTolerance( double position, double orientation ){
+  positionTolerance = position;
+  orientationTolerance = orientation;
+}
+
+void robInverseKinematics::SetNumberOfThreads( size_t threads )
+{ numberOfThreads = ( threads > 0 ) ? threads : 1; }
+
+void robInverseKinematics::AllocateWorkspaces(){
+
+  const size_t N = robot.links.size();
+  while( workspaces.size() < numberOfThreads ){
+    Workspace* workspace = new Workspace;
+    workspace->random = randomSeed + 7919*workspaces.size();
+    if( workspace->random == 0 ) { workspace->random = 1; }
+    workspaces.push_back( workspace );
+  }
+
+  for( size_t i=0; i<workspaces.size(); i++ ){
+    Workspace& workspace = *(workspaces[i]);
+    workspace.states[0].SetSize( N );
+    workspace.states[1].SetSize( N );
+    workspace.J.SetSize( 6, N );
+    workspace.dq.SetSize( N );
+    workspace.qtrial.SetSize( N );
+    workspace.qbest.SetSize( N );
+  }
+
+}
+
+double robInverseKinematics::Error( const robManipulatorState& state,
+                                    const vctFrame4x4<double>& Rts,
+                                    vctFixedSizeVector<double,6>& e,
+                                    double& ep,
+                                    double& eo ) const {
+
+  const vctFrame4x4<double> Rt = state.ForwardKinematics();
+
+  // position error
+  vctFixedSizeVector<double,3> dt( Rts[0][3]-Rt[0][3],
+                                   Rts[1][3]-Rt[1][3],
+                                   Rts[2][3]-Rt[2][3] );
+
+  // orientation error: 0.5 sum( ni x nd ) = sin(theta) k for the rotation
+  // of angle theta about k from Rt to Rts (as robManipulator::InverseKinematics)
+  vctFixedSizeVector<double,3> n1( Rt[0][0],  Rt[1][0],  Rt[2][0] );
+  vctFixedSizeVector<double,3> o1( Rt[0][1],  Rt[1][1],  Rt[2][1] );
+  vctFixedSizeVector<double,3> a1( Rt[0][2],  Rt[1][2],  Rt[2][2] );
+  vctFixedSizeVector<double,3> n2( Rts[0][0], Rts[1][0], Rts[2][0] );
+  vctFixedSizeVector<double,3> o2( Rts[0][1], Rts[1][1], Rts[2][1] );
+  vctFixedSizeVector<double,3> a2( Rts[0][2], Rts[1][2], Rts[2][2] );
+  vctFixedSizeVector<double,3> dr = 0.5*( (n1%n2) + (o1%o2) + (a1%a2) );
+  const double s = dr.Norm();
+  const double c = 0.5*( (n1*n2) + (o1*o2) + (a1*a2) - 1.0 );
+  const double theta = atan2( s, c );
+
+  // scale sin(theta) to theta such that the error is monotonic up to pi
+  if( 1e-9 < s )
+    { dr *= theta / s; }
+  else if( c < 0.0 ){
+    // half turn: the axis is a column of Rts Rt' + I = 2 k k'
+    vctFixedSizeVector<double,3> k(0.0);
+    for( size_t j=0; j<3; j++ ){
+      vctFixedSizeVector<double,3> column;
+      for( size_t i=0; i<3; i++ ){
+        column[i] = Rts[i][0]*Rt[j][0] + Rts[i][1]*Rt[j][1] + Rts[i][2]*Rt[j][2];
+      }
+      column[j] += 1.0;
+      if( k.NormSquare() < column.NormSquare() ) { k = column; }
+    }
+    dr = k * ( theta / k.Norm() );
+  }
+
+  e[0] = dt[0]; e[1] = dt[1]; e[2] = dt[2];
+  e[3] = dr[0]; e[4] = dr[1]; e[5] = dr[2];
+
+  ep = dt.Norm();
+  eo = theta;
+  return ep*ep + eo*eo;
+
+}
+
+void robInverseKinematics::ClipToLimits( vctDynamicVector<double>& q ) const {
+  if( !jointLimits ) return;
+  for( size_t i=0; i<q.size(); i++ ){
+    const double qmin = robot.links[i].PositionMin();
+    const double qmax = robot.links[i].PositionMax();
+    if( qmin < qmax ){
+      if( q[i] < qmin ) q[i] = qmin;
+      if( qmax < q[i] ) q[i] = qmax;
+    }
+  }
+}
+
+void robInverseKinematics::RandomConfiguration( Workspace& workspace,
+                                                vctDynamicVector<double>& q ) const {
+  for( size_t i=0; i<q.size(); i++ ){
+    double qmin = robot.links[i].PositionMin();
+    double qmax = robot.links[i].PositionMax();
+    if( !jointLimits || !( qmin < qmax ) ){
+      qmin = -cmnPI;
+      qmax =  cmnPI;
+    }
+    // xorshift, the generator of cmnRandomSequence is shared by all threads
+    workspace.random ^= workspace.random << 13;
+    workspace.random ^= workspace.random >> 17;
+    workspace.random ^= workspace.random << 5;
+    q[i] = qmin + ( qmax - qmin ) * ( workspace.random / 4294967296.0 );
+  }
+}
+
+bool robInverseKinematics::Iterate( Workspace& workspace,
+                                    vctDynamicVector<double>& q,
+                                    const vctFrame4x4<double>& Rts,
+                                    const volatile bool* stop ){
+
+  const size_t N = robot.links.size();
+  vctFixedSizeVector<double,6> e, etrial;
+  double ep, eo, eptrial, eotrial;
+
+  ClipToLimits( q );
+  size_t current = 0;
+  robot.UpdateState( workspace.states[current], q );
+  double cost = Error( workspace.states[current], Rts, e, ep, eo );
+  double lambda = damping;
+
+  workspace.iterations = 0;
+  while( !( ep <= positionTolerance && eo <= orientationTolerance ) &&
+         workspace.iterations < maxIterations ){
+
+    if( stop != NULL && *stop ) break;
+    workspace.iterations++;
+
+    // Jacobian of the tool control point: v = vs + w x p
+    const vctDynamicMatrix<double>& Js =
+      robot.JacobianSpatial( workspace.states[current] );
+    const vctFrame4x4<double> Rt = workspace.states[current].ForwardKinematics();
+    for( size_t j=0; j<N; j++ ){
+      workspace.J[0][j] = Js[0][j] + Js[4][j]*Rt[2][3] - Js[5][j]*Rt[1][3];
+      workspace.J[1][j] = Js[1][j] + Js[5][j]*Rt[0][3] - Js[3][j]*Rt[2][3];
+      workspace.J[2][j] = Js[2][j] + Js[3][j]*Rt[1][3] - Js[4][j]*Rt[0][3];
+      workspace.J[3][j] = Js[3][j];
+      workspace.J[4][j] = Js[4][j];
+      workspace.J[5][j] = Js[5][j];
+    }
+
+    // dq = J' ( J J' + lambda I )^-1 e. The joints at a limit that would be
+    // pushed beyond it are removed from J and the step is evaluated again.
+    bool singular = false;
+    double ndq = 0.0;
+    for( size_t pass=0; pass<=N; pass++ ){
+
+      vctFixedSizeMatrix<double,6,6> A;
+      for( size_t r=0; r<6; r++ ){
+        for( size_t c=r; c<6; c++ ){
+          double s = 0.0;
+          for( size_t k=0; k<N; k++ ) { s += workspace.J[r][k]*workspace.J[c][k]; }
+          A[r][c] = A[c][r] = s;
+        }
+        A[r][r] += lambda;
+      }
+
+      vctFixedSizeVector<double,6> y( e );
+      if( !robInverseKinematicsSolve6x6( A, y ) ){
+        singular = true;
+        break;
+      }
+
+      ndq = 0.0;
+      for( size_t k=0; k<N; k++ ){
+        double s = 0.0;
+        for( size_t r=0; r<6; r++ ) { s += workspace.J[r][k]*y[r]; }
+        workspace.dq[k] = s;
+        ndq += s*s;
+      }
+
+      bool blocked = false;
+      if( jointLimits ){
+        for( size_t k=0; k<N; k++ ){
+          const double qmin = robot.links[k].PositionMin();
+          const double qmax = robot.links[k].PositionMax();
+          if( qmin < qmax && workspace.dq[k] != 0.0 &&
+              ( ( q[k] <= qmin && workspace.dq[k] < 0.0 ) ||
+                ( qmax <= q[k] && 0.0 < workspace.dq[k] ) ) ){
+            for( size_t r=0; r<6; r++ ) { workspace.J[r][k] = 0.0; }
+            blocked = true;
+          }
+        }
+      }
+      if( !blocked ) break;
+    }
+
+    if( singular ){
+      lambda *= 10.0;
+      continue;
+    }
+
+    workspace.qtrial.SumOf( q, workspace.dq );
+    ClipToLimits( workspace.qtrial );
+
+    const size_t trial = 1 - current;
+    robot.UpdateState( workspace.states[trial], workspace.qtrial );
+    const double costtrial =
+      Error( workspace.states[trial], Rts, etrial, eptrial, eotrial );
+
+    if( costtrial < cost ){
+      // accept the step and move toward Gauss-Newton
+      q.Assign( workspace.qtrial );
+      current = trial;
+      cost = costtrial;
+      e = etrial;
+      ep = eptrial;
+      eo = eotrial;
+      lambda = ( lambda*0.1 < 1e-12 ) ? 1e-12 : lambda*0.1;
+    }
+    else{
+      // reject the step and move toward gradient descent
+      lambda *= 10.0;
+      if( ndq < 1e-24 || 1e12 < lambda ) break;   // stuck
+    }
+  }
+
+  workspace.positionError = ep;
+  workspace.orientationError = eo;
+  return ep <= positionTolerance && eo <= orientationTolerance;
+
+}
+
+robInverseKinematics::Errno
+robInverseKinematics::Solve( vctDynamicVector<double>& q,
+                             const vctFrame4x4<double>& Rts ){
+
+  if( q.size() != robot.links.size() ){
+    CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                      << ": Expected " << robot.links.size() << " joints values. "
+                      << " Got " << q.size()
+                      << std::endl;
+    return robInverseKinematics::EFAILURE;
+  }
+
+  AllocateWorkspaces();
+  Workspace& workspace = *(workspaces[0]);
+  bool converged = Iterate( workspace, q, Rts, NULL );
+
+  numberOfIterations = workspace.iterations;
+  positionError = workspace.positionError;
+  orientationError = workspace.orientationError;
+
+  if( converged ) return robInverseKinematics::ESUCCESS;
+  return robInverseKinematics::EFAILURE;
+
+}
+
+void robInverseKinematics::SolveSeeds( size_t thread ){
+
+  Workspace& workspace = *(workspaces[thread]);
+
+  while( true ){
+
+    // take the next seed
+    multiStartMutex.Lock();
+    const size_t seed = multiStartNextSeed++;
+    const bool done = multiStartDone;
+    multiStartMutex.Unlock();
+    if( done || numberOfSeeds <= seed ) return;
+
+    if( seed == 0 ) { workspace.qbest.Assign( *multiStartGuess ); }
+    else            { RandomConfiguration( workspace, workspace.qbest ); }
+
+    const bool converged =
+      Iterate( workspace, workspace.qbest, *multiStartTarget, &multiStartDone );
+    const double error = workspace.positionError + workspace.orientationError;
+
+    // keep the first converged seed or the closest one
+    multiStartMutex.Lock();
+    if( !multiStartDone &&
+        ( converged || error < multiStartBestError ) ){
+      multiStartSolution.Assign( workspace.qbest );
+      multiStartBestError = error;
+      multiStartDone = converged;
+      numberOfIterations = workspace.iterations;
+      positionError = workspace.positionError;
+      orientationError = workspace.orientationError;
+    }
+    multiStartMutex.Unlock();
+  }
+
+}
+
+robInverseKinematics::Errno
+robInverseKinematics::SolveMultiStart( vctDynamicVector<double>& q,
+                                       const vctFrame4x4<double>& Rts ){
+
+  if( q.size() != robot.links.size() ){
+    CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                      << ": Expected " << robot.links.size() << " joints values. "
+                      << " Got " << q.size()
+                      << std::endl;
+    return robInverseKinematics::EFAILURE;
+  }
+
+  AllocateWorkspaces();
+  multiStartTarget = &Rts;
+  multiStartGuess = &q;
+  multiStartNextSeed = 0;
+  multiStartDone = false;
+  multiStartBestError = cmnTypeTraits<double>::MaxPositiveValue();
+  multiStartSolution.ForceAssign( q );
+
+  size_t threads = numberOfThreads;
+  if( numberOfSeeds < threads ) threads = numberOfSeeds;
+
+  // the calling thread is the first worker
+  std::vector<robInverseKinematicsTask> tasks( threads );
+  osaThread* workers = new osaThread[threads];
+  for( size_t i=0; i<threads; i++ ){
+    tasks[i].solver = this;
+    tasks[i].thread = i;
+    tasks[i].begin = tasks[i].end = 0;
+    if( 0 < i )
+      { workers[i].Create( &robInverseKinematicsSeedsWorker, &tasks[i], "robIK" ); }
+  }
+  SolveSeeds( 0 );
+  for( size_t i=1; i<threads; i++ )
+    { workers[i].Wait(); }
+  delete[] workers;
+
+  q.Assign( multiStartSolution );
+  if( multiStartDone ) return robInverseKinematics::ESUCCESS;
+  return robInverseKinematics::EFAILURE;
+
+}
+
+bool robInverseKinematics::SolveSeeded( Workspace& workspace,
+                                        vctDynamicVector<double>& q,
+                                        const vctFrame4x4<double>& Rts ){
+
+  if( Iterate( workspace, q, Rts, NULL ) ) return true;
+
+  double best = workspace.positionError + workspace.orientationError;
+  for( size_t seed=1; seed<numberOfSeeds; seed++ ){
+    workspace.qbest.Assign( q );
+    RandomConfiguration( workspace, q );
+    if( Iterate( workspace, q, Rts, NULL ) ) return true;
+    const double error = workspace.positionError + workspace.orientationError;
+    if( best <= error ) { q.Assign( workspace.qbest ); }
+    else                { best = error; }
+  }
+  return false;
+
+}
+
+void robInverseKinematics::SolveRange( size_t thread, size_t begin, size_t end ){
+
+  Workspace& workspace = *(workspaces[thread]);
+  const size_t N = robot.links.size();
+  std::vector< vctDynamicVector<double> >& solutions = *batchSolutions;
+
+  for( size_t i=begin; i<end; i++ ){
+    vctDynamicVector<double>& q = solutions[i];
+    if( q.size() != N ){
+      // warm start from the previous target
+      if( begin < i ) { q.ForceAssign( solutions[i-1] ); }
+      else            { q.SetSize( N ); q.SetAll( 0.0 ); }
+    }
+    (*batchConverged)[i] = SolveSeeded( workspace, q, (*batchTargets)[i] );
+  }
+
+}
+
+size_t
+robInverseKinematics::SolveBatch( const std::vector< vctFrame4x4<double> >& targets,
+                                  std::vector< vctDynamicVector<double> >& solutions,
+                                  vctDynamicVector<bool>& converged ){
+
+  const size_t count = targets.size();
+  solutions.resize( count );
+  converged.SetSize( count );
+  converged.SetAll( false );
+  if( count == 0 ) return 0;
+
+  AllocateWorkspaces();
+  batchTargets = &targets;
+  batchSolutions = &solutions;
+  batchConverged = &converged;
+
+  size_t threads = numberOfThreads;
+  if( count < threads ) threads = count;
+
+  // the calling thread processes the first range
+  std::vector<robInverseKinematicsTask> tasks( threads );
+  osaThread* workers = new osaThread[threads];
+  const size_t range = count / threads;
+  for( size_t i=0; i<threads; i++ ){
+    tasks[i].solver = this;
+    tasks[i].thread = i;
+    tasks[i].begin = i*range;
+    tasks[i].end = ( i == threads-1 ) ? count : (i+1)*range;
+    if( 0 < i )
+      { workers[i].Create( &robInverseKinematicsBatchWorker, &tasks[i], "robIK" ); }
+  }
+  SolveRange( 0, tasks[0].begin, tasks[0].end );
+  for( size_t i=1; i<threads; i++ )
+    { workers[i].Wait(); }
+  delete[] workers;
+
+  size_t total = 0;
+  for( size_t i=0; i<count; i++ )
+    { if( converged[i] ) total++; }
+  return total;
+
+}
@@ -195,6 +195,99 @@ void robLSPB::Evaluate(const double absoluteTime,
     Evaluate(absoluteTime, position, mTemp, mTemp);
 }
 
+void robLSPB::EvaluateTimes(vctDynamicConstVectorRef<double> times,
+                            vctDynamicMatrixRef<double> position,
+                            vctDynamicMatrixRef<double> velocity,
+                            vctDynamicMatrixRef<double> acceleration)
+{
+    if (position.rows() != times.size()) {
+        cmnThrow("robLSPB::EvaluateTimes: position rows don't match number of times");
+    }
+    EvaluateSamples(times.Pointer(), times.stride(), 0.0, 0.0,
+                    position, velocity, acceleration);
+}
+
+void robLSPB::EvaluatePeriod(const double startTime,
+                             const double period,
+                             vctDynamicMatrixRef<double> position,
+                             vctDynamicMatrixRef<double> velocity,
+                             vctDynamicMatrixRef<double> acceleration)
+{
+    EvaluateSamples(0, 0, startTime, period,
+                    position, velocity, acceleration);
+}
+
+void robLSPB::EvaluateSamples(const double * times,
+                              const vctDynamicConstVectorRef<double>::stride_type timesStride,
+                              const double startTime,
+                              const double period,
+                              vctDynamicMatrixRef<double> & position,
+                              vctDynamicMatrixRef<double> & velocity,
+                              vctDynamicMatrixRef<double> & acceleration)
+{
+    // sanity checks
+    if (!mIsSet) {
+        cmnThrow("robLSPB::Evaluate trajectory parameters are not set yet");
+    }
+    if (position.cols() != mDimension) {
+        cmnThrow("robLSPB::Evaluate: position doesn't match dimension");
+    }
+    if (!velocity.sizes().Equal(position.sizes())) {
+        cmnThrow("robLSPB::Evaluate: velocity doesn't match position size");
+    }
+    if (!acceleration.sizes().Equal(position.sizes())) {
+        cmnThrow("robLSPB::Evaluate: acceleration doesn't match position size");
+    }
+
+    const size_t nbSamples = position.rows();
+    if (nbSamples == 0) {
+        return;
+    }
+    const ptrdiff_t pStride = position.row_stride();
+    const ptrdiff_t vStride = velocity.row_stride();
+    const ptrdiff_t aStride = acceleration.row_stride();
+
+    // one joint at a time so all parameters stay in registers.  Each
+    // phase is written as c0 + c1 * t + c2 * t^2 and selected without
+    // branches, time is clamped to [0, finish time] which gives the
+    // start and finish positions with null velocity outside the
+    // trajectory.
+    for (size_t i = 0;
+         i < mDimension;
+         ++i) {
+        const double scale = (mCoordination == LSPB_DURATION) ? mTimeScale[i] : 1.0;
+        const double finishTime = mFinishTime[i];
+        const double decelerationTime = finishTime - mAccelerationTime[i];
+        const double accelerationTime = mAccelerationTime[i];
+        const double halfAcceleration = 0.5 * mAcceleration[i];
+        const double accelerationC0 = mStart[i];
+        const double decelerationC0 = mFinish[i] - halfAcceleration * finishTime * finishTime;
+        const double decelerationC1 = mAcceleration[i] * finishTime;
+        const double constantC0 = 0.5 * (mFinish[i] + mStart[i] - mVelocity[i] * finishTime);
+        const double constantC1 = mVelocity[i];
+
+        double * p = position.Pointer(0, i);
+        double * v = velocity.Pointer(0, i);
+        double * a = acceleration.Pointer(0, i);
+        for (size_t k = 0;
+             k < nbSamples;
+             ++k) {
+            const double absoluteTime = times ? times[k * timesStride] : (startTime + k * period);
+            const double dimTime = (absoluteTime - mStartTime) * scale;
+            const double t = (dimTime <= 0.0) ? 0.0 : ((dimTime >= finishTime) ? finishTime : dimTime);
+            const bool accelerating = (t <= accelerationTime);
+            const bool decelerating = (t >= decelerationTime);
+            const double c0 = accelerating ? accelerationC0 : (decelerating ? decelerationC0 : constantC0);
+            const double c1 = accelerating ? 0.0 : (decelerating ? decelerationC1 : constantC1);
+            const double c2 = accelerating ? halfAcceleration : (decelerating ? -halfAcceleration : 0.0);
+            const bool moving = (dimTime > 0.0) && (dimTime < finishTime);
+            p[k * pStride] = c0 + (c1 + c2 * t) * t;
+            v[k * vStride] = c1 + 2.0 * c2 * t;
+            a[k * aStride] = moving ? 2.0 * c2 : 0.0;
+        }
+    }
+}
+
 double & robLSPB::StartTime(void) {
     return mStartTime;
 }
@@ -1073,6 +1073,441 @@ void robManipulator::OSinertia( double Ac[6][6],
   free_rmatrix( JAi, 0, 0 );
 }
 
+robManipulator::Errno
+robManipulator::JSinertia( vctDynamicMatrix<double>& M,
+                           const vctDynamicVector<double>& q ) const {
+  if( UpdateState( workspace, q ) != robManipulator::ESUCCESS )
+    { return robManipulator::EFAILURE; }
+  return JSinertia( workspace, M );
+}
+
+robManipulator::Errno
+robManipulator::OSinertia( vctFixedSizeMatrix<double,6,6>& Ac,
+                           const vctDynamicVector<double>& q ) const {
+  if( UpdateState( workspace, q ) != robManipulator::ESUCCESS )
+    { return robManipulator::EFAILURE; }
+  return OSinertia( workspace, Ac );
+}
+
+//////////////////////////////////////
+//         CACHED STATE
+//////////////////////////////////////
+
+robManipulator::Errno
+robManipulator::UpdateState( robManipulatorState& state,
+                             const vctDynamicVector<double>& q ) const {
+
+  const size_t N = links.size();
+  if( q.size() != N ){
+    CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                      << ": Expected " << N << " values. "
+                      << "Got " << q.size()
+                      << std::endl;
+    return robManipulator::EFAILURE;
+  }
+
+  state.SetSize( N );
+  state.q.Assign( q );
+
+  state.Rtwi[0] = Rtw0;
+  for( size_t i=0; i<N; i++ ){
+    state.Rtl[i] = links[i].ForwardKinematics( q[i] );
+    state.Rtwi[i+1] = state.Rtwi[i] * state.Rtl[i];
+    state.pstar[i] = links[i].PStar();
+  }
+
+  // same as ForwardKinematics: the tool is a rigid transformation
+  state.hasTool = false;
+  if( tools.size() == 1 ){
+    if( tools[0] != NULL ){
+      state.hasTool = true;
+      state.Rtnt = tools[0]->ForwardKinematics( q, 0 );
+    }
+  }
+
+  state.valid = true;
+  state.JnValid = false;
+  state.JsValid = false;
+
+  return robManipulator::ESUCCESS;
+}
+
+/*
+ * The axis of joint i is the z axis of the frame of link i-1 (link i for the
+ * modified DH convention) as in JacobianBody. Revolute columns of the spatial
+ * Jacobian are [ p x z ; z ] and prismatic columns [ z ; 0 ] where p is the
+ * origin of the frame. The body Jacobian is obtained by expressing the same
+ * twists in the frame of the tool control point.
+ */
+const vctDynamicMatrix<double>&
+robManipulator::JacobianBody( robManipulatorState& state ) const {
+
+  if( state.JnValid ) { return state.Jn; }
+
+  const vctFrame4x4<double> Rtwn = state.ForwardKinematics();
+  const vctFixedSizeVector<double,3> on( Rtwn[0][3], Rtwn[1][3], Rtwn[2][3] );
+
+  for( size_t j=0; j<links.size(); j++ ){
+
+    size_t k = j;
+    if( links[j].GetConvention() == robKinematics::MODIFIED_DH ) { k = j+1; }
+    const vctFrame4x4<double>& Rtwk = state.Rtwi[k];
+    const vctFixedSizeVector<double,3> z( Rtwk[0][2], Rtwk[1][2], Rtwk[2][2] );
+    const vctFixedSizeVector<double,3> p( Rtwk[0][3], Rtwk[1][3], Rtwk[2][3] );
+
+    vctFixedSizeVector<double,3> v(0.0), w(0.0);
+    if( links[j].GetType() == robJoint::HINGE ){
+      v = z % ( on - p );
+      w = z;
+    }
+    if( links[j].GetType() == robJoint::SLIDER )
+      { v = z; }
+
+    // rotate in the frame of the tool control point
+    for( size_t r=0; r<3; r++ ){
+      state.Jn[r  ][j] = Rtwn[0][r]*v[0] + Rtwn[1][r]*v[1] + Rtwn[2][r]*v[2];
+      state.Jn[r+3][j] = Rtwn[0][r]*w[0] + Rtwn[1][r]*w[1] + Rtwn[2][r]*w[2];
+    }
+  }
+
+  state.JnValid = true;
+  return state.Jn;
+}
+
+const vctDynamicMatrix<double>&
+robManipulator::JacobianSpatial( robManipulatorState& state ) const {
+
+  if( state.JsValid ) { return state.Js; }
+
+  for( size_t j=0; j<links.size(); j++ ){
+
+    size_t k = j;
+    if( links[j].GetConvention() == robKinematics::MODIFIED_DH ) { k = j+1; }
+    const vctFrame4x4<double>& Rtwk = state.Rtwi[k];
+    const vctFixedSizeVector<double,3> z( Rtwk[0][2], Rtwk[1][2], Rtwk[2][2] );
+    const vctFixedSizeVector<double,3> p( Rtwk[0][3], Rtwk[1][3], Rtwk[2][3] );
+
+    vctFixedSizeVector<double,3> v(0.0), w(0.0);
+    if( links[j].GetType() == robJoint::HINGE ){
+      v = p % z;
+      w = z;
+    }
+    if( links[j].GetType() == robJoint::SLIDER )
+      { v = z; }
+
+    for( size_t r=0; r<3; r++ ){
+      state.Js[r  ][j] = v[r];
+      state.Js[r+3][j] = w[r];
+    }
+  }
+
+  state.JsValid = true;
+  return state.Js;
+}
+
+robManipulator::Errno
+robManipulator::RNE( robManipulatorState& state,
+                     const vctDynamicVector<double>& qd,
+                     const vctDynamicVector<double>& qdd,
+                     const vctFixedSizeVector<double,6>& fext,
+                     vctDynamicVector<double>& tau,
+                     double g ) const {
+
+  const size_t N = links.size();
+  if( !state.valid || state.size() != N || qd.size() != N || qdd.size() != N ){
+    CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                      << ": The state or the size of qd/qdd do not match "
+                      << "the manipulator."
+                      << std::endl;
+    return robManipulator::EFAILURE;
+  }
+  tau.SetSize( N );
+
+  vctFixedSizeVector<double,3> w    (0.0); // angular velocity
+  vctFixedSizeVector<double,3> wd   (0.0); // angular acceleration
+  vctFixedSizeVector<double,3> vd   (0.0); // linear acceleration
+  vctFixedSizeVector<double,3> vdhat(0.0);
+  vctFixedSizeVector<double,3> z0(0.0, 0.0, 1.0);
+
+  // gravity in the robot coordinate frame
+  vd[0] = Rtw0[2][0]*g;
+  vd[1] = Rtw0[2][1]*g;
+  vd[2] = Rtw0[2][2]*g;
+
+  // Forward recursion
+  for( size_t i=0; i<N; i++ ){
+
+    vctMatrixRotation3<double> A; // iA(i-1)
+    const vctFrame4x4<double>& Rt = state.Rtl[i];
+    for( size_t r=0; r<3; r++ )
+      for( size_t c=0; c<3; c++ )
+        { A[r][c] = Rt[c][r]; }
+    const vctFixedSizeVector<double,3>& ps = state.pstar[i];
+    const vctFixedSizeVector<double,3> s = links[i].CenterOfMass();
+    const vctFixedSizeMatrix<double,3,3> I = links[i].MomentOfInertia();
+
+    wd = A*( wd + (z0*qdd[i]) + (w%(z0*qd[i])) );
+    w  = A*( w  + (z0*qd[i]) );
+    vd = (wd%ps) + (w%(w%ps)) + A*vd;
+
+    vdhat = (wd%s) + (w%(w%s)) + vd;
+    state.F[i] = links[i].Mass()*vdhat;
+    state.N[i] = (I*wd) + (w%(I*w));
+  }
+
+  vctFixedSizeVector<double,3> f( fext[0], fext[1], fext[2] );
+  vctFixedSizeVector<double,3> n( fext[3], fext[4], fext[5] );
+
+  // Backward recursion
+  for( int i=(int)N-1; 0<=i; i-- ){
+
+    if( i != (int)N-1 ){
+      // rotate from link i+1 to link i
+      const vctFrame4x4<double>& Rt = state.Rtl[i+1];
+      vctFixedSizeVector<double,3> Af, An;
+      for( size_t r=0; r<3; r++ ){
+        Af[r] = Rt[r][0]*f[0] + Rt[r][1]*f[1] + Rt[r][2]*f[2];
+        An[r] = Rt[r][0]*n[0] + Rt[r][1]*n[1] + Rt[r][2]*n[2];
+      }
+      f = Af;
+      n = An;
+    }
+
+    const vctFixedSizeVector<double,3>& ps = state.pstar[i];
+    const vctFixedSizeVector<double,3> s = links[i].CenterOfMass();
+    f = f + state.F[i];
+    n = n + (ps%f) + (s%state.F[i]) + state.N[i];
+
+    // z0 of link i-1 in link i
+    const vctFrame4x4<double>& Rt = state.Rtl[i];
+    const vctFixedSizeVector<double,3> z( Rt[2][0], Rt[2][1], Rt[2][2] );
+
+    tau[i] = 0.0;
+    if( links[i].GetType() == robJoint::HINGE )
+      tau[i] = n*z;
+    if( links[i].GetType() == robJoint::SLIDER )
+      tau[i] = f*z;
+  }
+
+  return robManipulator::ESUCCESS;
+}
+
+vctFixedSizeVector<double,6>
+robManipulator::BiasAcceleration( const robManipulatorState& state,
+                                  const vctDynamicVector<double>& qd ) const {
+
+  vctFixedSizeVector<double,3> w (0.0); // angular velocity
+  vctFixedSizeVector<double,3> wd(0.0); // angular acceleration
+  vctFixedSizeVector<double,3> vd(0.0); // linear velocity
+
+  vctFixedSizeVector<double,3> z0(0.0, 0.0, 1.0);
+
+  const size_t N = links.size();
+  if( !state.valid || state.size() != N || qd.size() != N ){
+    CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                      << ": Expected a state and " << N << " joint velocities. "
+                      << "Got " << qd.size() << " joint velocities."
+                      << std::endl;
+    return vctFixedSizeVector<double,6>(0.0);
+  }
+
+  for( size_t i=0; i<N; i++ ){
+
+    vctMatrixRotation3<double> A; // iA(i-1)
+    const vctFrame4x4<double>& Rt = state.Rtl[i];
+    for( size_t r=0; r<3; r++ )
+      for( size_t c=0; c<3; c++ )
+        { A[r][c] = Rt[c][r]; }
+    const vctFixedSizeVector<double,3>& ps = state.pstar[i];
+
+    wd = A*( wd + ( w%(z0*qd[i]) ) );
+    w  = A*( w  + (    z0*qd[i]  ) );
+    vd = (wd%ps) + (w%(w%ps)) + A*vd;
+  }
+
+  return vctFixedSizeVector<double,6>(vd[0], vd[1], vd[2], wd[0], wd[1], wd[2]);
+}
+
+// Composite rigid body algorithm. The kinematics and the inertias are the same
+// as RNE such that M matches the columns evaluated by JSinertia( q ).
+robManipulator::Errno
+robManipulator::JSinertia( robManipulatorState& state,
+                           vctDynamicMatrix<double>& M ) const {
+
+  const size_t N = links.size();
+  if( !state.valid || state.size() != N ){
+    CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                      << ": The state does not match the manipulator."
+                      << std::endl;
+    return robManipulator::EFAILURE;
+  }
+
+  M.SetSize( N, N );
+
+  // the inertias are expressed in the base frame (Rtw0 only affects gravity)
+  vctFixedSizeVector<double,3> z0(0.0, 0.0, 1.0);
+  vctMatrixRotation3<double> R;            // orientation of link i-1
+  vctFixedSizeVector<double,3> o(0.0);     // origin of link i-1
+
+  // Forward: joint axes and the inertia of each link in the base frame
+  for( size_t i=0; i<N; i++ ){
+    robManipulatorState::CompositeBody& body = state.composites[i];
+    body.axis = R*z0;
+    body.point = o;
+
+    const vctFrame4x4<double>& Rt = state.Rtl[i];
+    vctMatrixRotation3<double> Ri;
+    for( size_t r=0; r<3; r++ )
+      for( size_t c=0; c<3; c++ )
+        { Ri[r][c] = Rt[r][c]; }
+    R = R*Ri;
+    o = o + R*state.pstar[i];
+
+    const double m = links[i].Mass();
+    const vctFixedSizeVector<double,3> c = o + R*links[i].CenterOfMass();
+    const vctFixedSizeMatrix<double,3,3> I = links[i].MomentOfInertia();
+
+    body.m = m;
+    body.h = m*c;
+    // rotate the inertia and translate it to the base origin
+    body.I = R*I*R.Transpose();
+    const double cc = c*c;
+    for( size_t r=0; r<3; r++ ){
+      for( size_t k=0; k<3; k++ )
+        { body.I[r][k] -= m*c[r]*c[k]; }
+      body.I[r][r] += m*cc;
+    }
+  }
+
+  // Backward: accumulate the composite bodies i..N-1
+  for( int i=(int)N-2; 0<=i; i-- ){
+    state.composites[i].m += state.composites[i+1].m;
+    state.composites[i].h += state.composites[i+1].h;
+    state.composites[i].I += state.composites[i+1].I;
+  }
+
+  for( size_t i=0; i<N; i++ ){
+    const robManipulatorState::CompositeBody& body = state.composites[i];
+
+    // spatial velocity of joint i at the base origin
+    vctFixedSizeVector<double,3> w(0.0), v;
+    if( links[i].GetType() == robJoint::SLIDER )
+      { v = body.axis; }
+    else{
+      w = body.axis;
+      v = body.point % body.axis;
+    }
+
+    // momentum of the composite body i wrt the base origin
+    const vctFixedSizeVector<double,3> L = body.m*v + (w%body.h);
+    const vctFixedSizeVector<double,3> H = body.I*w + (body.h%v);
+
+    // project on the joints that support the composite body
+    for( size_t j=0; j<=i; j++ ){
+      const robManipulatorState::CompositeBody& support = state.composites[j];
+      double Mji = 0.0;
+      if( links[j].GetType() == robJoint::HINGE )
+        { Mji = support.axis*H + (support.point%support.axis)*L; }
+      if( links[j].GetType() == robJoint::SLIDER )
+        { Mji = support.axis*L; }
+      M[j][i] = M[i][j] = Mji;
+    }
+  }
+
+  return robManipulator::ESUCCESS;
+}
+
+robManipulator::Errno
+robManipulator::OSinertia( robManipulatorState& state,
+                           vctFixedSizeMatrix<double,6,6>& Ac ) const {
+
+  const size_t N = links.size();
+  vctDynamicMatrix<double>& L = state.M;
+  if( JSinertia( state, L ) != robManipulator::ESUCCESS )
+    { return robManipulator::EFAILURE; }
+
+  // Cholesky factorization M = L L' (lower triangle)
+  for( size_t j=0; j<N; j++ ){
+    double d = L[j][j];
+    for( size_t k=0; k<j; k++ ) { d -= L[j][k]*L[j][k]; }
+    if( d <= 0.0 ){
+      CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                        << ": The inertia matrix is not positive definite."
+                        << std::endl;
+      return robManipulator::EFAILURE;
+    }
+    L[j][j] = sqrt( d );
+    for( size_t r=j+1; r<N; r++ ){
+      double s = L[r][j];
+      for( size_t k=0; k<j; k++ ) { s -= L[r][k]*L[j][k]; }
+      L[r][j] = s / L[j][j];
+    }
+  }
+
+  const vctDynamicMatrix<double>& J = JacobianBody( state );
+
+  // M^-1 Jn' by forward and backward substitution
+  vctDynamicMatrix<double>& X = state.MinvJt;
+  for( size_t c=0; c<6; c++ ){
+    for( size_t r=0; r<N; r++ ){
+      double s = J[c][r];
+      for( size_t k=0; k<r; k++ ) { s -= L[r][k]*X[k][c]; }
+      X[r][c] = s / L[r][r];
+    }
+    for( int r=(int)N-1; 0<=r; r-- ){
+      double s = X[r][c];
+      for( size_t k=r+1; k<N; k++ ) { s -= L[k][r]*X[k][c]; }
+      X[r][c] = s / L[r][r];
+    }
+  }
+
+  // Jn M^-1 Jn'
+  vctFixedSizeMatrix<double,6,6> Aci;
+  for( size_t r=0; r<6; r++ ){
+    for( size_t c=r; c<6; c++ ){
+      double s = 0.0;
+      for( size_t k=0; k<N; k++ ) { s += J[r][k]*X[k][c]; }
+      Aci[r][c] = Aci[c][r] = s;
+    }
+  }
+
+  // (Jn M^-1 Jn')^-1 from its Cholesky factor
+  vctFixedSizeMatrix<double,6,6> Lc(0.0);
+  for( size_t j=0; j<6; j++ ){
+    double d = Aci[j][j];
+    for( size_t k=0; k<j; k++ ) { d -= Lc[j][k]*Lc[j][k]; }
+    if( d <= 1e-12*Aci[j][j] || d <= 0.0 ){
+      CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                        << ": The manipulator is at a singular configuration."
+                        << std::endl;
+      return robManipulator::EFAILURE;
+    }
+    Lc[j][j] = sqrt( d );
+    for( size_t r=j+1; r<6; r++ ){
+      double s = Aci[r][j];
+      for( size_t k=0; k<j; k++ ) { s -= Lc[r][k]*Lc[j][k]; }
+      Lc[r][j] = s / Lc[j][j];
+    }
+  }
+
+  // Ac = Lc'^-1 Lc^-1 by solving for each column of the identity
+  for( size_t c=0; c<6; c++ ){
+    double y[6];
+    for( size_t r=0; r<6; r++ ){
+      double s = ( r == c ) ? 1.0 : 0.0;
+      for( size_t k=0; k<r; k++ ) { s -= Lc[r][k]*y[k]; }
+      y[r] = s / Lc[r][r];
+    }
+    for( int r=5; 0<=r; r-- ){
+      double s = y[r];
+      for( size_t k=r+1; k<6; k++ ) { s -= Lc[k][r]*Ac[k][c]; }
+      Ac[r][c] = s / Lc[r][r];
+    }
+  }
+
+  return robManipulator::ESUCCESS;
+}
+
 vctDynamicVector<double>
 robManipulator::InverseDynamics(const vctDynamicVector<double>& q,
                                 const vctDynamicVector<double>& qd,
@@ -0,0 +1,59 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*-    */
+/* ex: set filetype=cpp softtabstop=2 shiftwidth=2 tabstop=2 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstRobot/robManipulatorState.h>
+
+robManipulatorState::robManipulatorState()
+  : valid( false ), JnValid( false ), JsValid( false ), hasTool( false ) {}
+
+robManipulatorState::robManipulatorState( size_t N )
+  : valid( false ), JnValid( false ), JsValid( false ), hasTool( false )
+{ SetSize( N ); }
+
+void robManipulatorState::SetSize( size_t N ){
+
+  if( N == size() && !Rtwi.empty() ) return;
+
+  valid = JnValid = JsValid = false;
+
+  q.SetSize( N );
+  Rtwi.resize( N+1 );
+  Rtl.resize( N );
+  pstar.resize( N );
+
+  Jn.SetSize( 6, N );
+  Js.SetSize( 6, N );
+
+  F.resize( N );
+  this->N.resize( N );
+
+  composites.resize( N );
+  M.SetSize( N, N );
+  MinvJt.SetSize( N, 6 );
+
+}
+
+vctFrame4x4<double> robManipulatorState::ForwardKinematics( int N ) const {
+
+  if( N == 0 || Rtwi.empty() ) return Rtwi.empty() ? vctFrame4x4<double>() : Rtwi[0];
+
+  // if N < 0 then we want the end-effector
+  if( N < 0 || (size_t)N > size() ) N = size();
+
+  if( hasTool ) { return Rtwi[N] * Rtnt; }
+  return Rtwi[N];
+
+}
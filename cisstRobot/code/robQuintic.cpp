@@ -270,6 +270,102 @@ void robQuintic::Evaluate( double t,
 
 
 
+void robQuintic::EvaluateTimes( vctDynamicConstVectorRef<double> times,
+                                vctDynamicMatrixRef<double> y,
+                                vctDynamicMatrixRef<double> yd,
+                                vctDynamicMatrixRef<double> ydd ){
+    if( y.rows() != times.size() ){
+        CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                          << ": Expected " << times.size() << " rows. Got "
+                          << y.rows()
+                          << std::endl;
+        return;
+    }
+    EvaluateSamples( times.Pointer(), times.stride(), 0.0, 0.0, y, yd, ydd );
+}
+
+void robQuintic::EvaluatePeriod( double startTime,
+                                 double period,
+                                 vctDynamicMatrixRef<double> y,
+                                 vctDynamicMatrixRef<double> yd,
+                                 vctDynamicMatrixRef<double> ydd ){
+    EvaluateSamples( NULL, 0, startTime, period, y, yd, ydd );
+}
+
+void robQuintic::EvaluateSamples( const double* times,
+                                  vctDynamicConstVectorRef<double>::stride_type stride,
+                                  double startTime,
+                                  double period,
+                                  vctDynamicMatrixRef<double>& y,
+                                  vctDynamicMatrixRef<double>& yd,
+                                  vctDynamicMatrixRef<double>& ydd ){
+    if( !IsSet ){
+        CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                          << ": parameters not set"
+                          << std::endl;
+        return;
+    }
+
+    if( y.cols() != X.size() ||
+        !yd.sizes().Equal( y.sizes() ) || !ydd.sizes().Equal( y.sizes() ) ){
+        CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                          << ": Expected matrices with " << X.size()
+                          << " columns and the same sizes. Got "
+                          << y.sizes() << ", " << yd.sizes() << " and "
+                          << ydd.sizes()
+                          << std::endl;
+        return;
+    }
+
+    if( y1.size() != X.size() || y1d.size() != X.size() || y1dd.size() != X.size() ||
+        y2.size() != X.size() || y2d.size() != X.size() || y2dd.size() != X.size() ){
+        CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                          << ": Not an Rn trajectory. Sizes of vectors are"
+                          << ": size(y1) = " << y1.size()
+                          << "; size(y2) = " << y2.size()
+                          << std::endl;
+        return;
+    }
+
+    const size_t K = y.rows();
+    const ptrdiff_t ys = y.row_stride();
+    const ptrdiff_t yds = yd.row_stride();
+    const ptrdiff_t ydds = ydd.row_stride();
+
+    // One quintic at a time over all the samples. The polynomial is evaluated
+    // with Horner's rule at the time clamped to [t1, t2] and the initial or
+    // final values are selected outside of the interval, without branches.
+    for( size_t i=0; i<X.size(); i++ ){
+
+        const vctFixedSizeVector<double,6>& x = X[i];
+        const double y1i = y1[i], y1di = y1d[i], y1ddi = y1dd[i];
+        const double y2i = y2[i], y2di = y2d[i], y2ddi = y2dd[i];
+
+        double* py = y.Pointer( 0, i );
+        double* pyd = yd.Pointer( 0, i );
+        double* pydd = ydd.Pointer( 0, i );
+
+        for( size_t k=0; k<K; k++ ){
+            const double t = times ? times[k*stride] : startTime + k*period;
+            const bool before = t < t1;
+            const bool after = t2 < t;
+            const double tc = ( before ? t1 : ( after ? t2 : t ) ) - t1;
+
+            const double q   = (((( x[5]*tc + x[4])*tc + x[3])*tc + x[2])*tc + x[1])*tc + x[0];
+            const double qd  = ((( 5*x[5]*tc + 4*x[4])*tc + 3*x[3])*tc + 2*x[2])*tc + x[1];
+            const double qdd = (( 20*x[5]*tc + 12*x[4])*tc + 6*x[3])*tc + 2*x[2];
+
+            py[k*ys]     = before ? y1i   : ( after ? y2i   : q );
+            pyd[k*yds]   = before ? y1di  : ( after ? y2di  : qd );
+            pydd[k*ydds] = before ? y1ddi : ( after ? y2ddi : qdd );
+        }
+    }
+
+}
+
+
+
+
 vctFixedSizeVector<double,6>
 robQuintic::ComputeParameters( double t1, double q1, double q1d, double q1dd,
                                double t2, double q2, double q2d, double q2dd ){
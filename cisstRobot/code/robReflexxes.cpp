@@ -212,3 +212,82 @@ void robReflexxes::Evaluate(vctDoubleVec & CurrentPosition,
         mCurrentAcceleration[i] = OP->NewAccelerationVector->VecData[i];
     }
 }
+
+void robReflexxes::EvaluateCycles(vctDoubleVec & CurrentPosition,
+                                  vctDoubleVec & CurrentVelocity,
+                                  const vctDoubleVec & TargetPosition,
+                                  const vctDoubleVec & TargetVelocity,
+                                  vctDynamicMatrixRef<double> Position,
+                                  vctDynamicMatrixRef<double> Velocity,
+                                  vctDynamicMatrixRef<double> Acceleration)
+{
+    // sanity checks, Evaluate checks the vectors
+    if (Position.cols() != mDimension) {
+        cmnThrow("robReflexxes::EvaluateCycles: position doesn't match dimension");
+    }
+    if (!Velocity.sizes().Equal(Position.sizes())) {
+        cmnThrow("robReflexxes::EvaluateCycles: velocity doesn't match position size");
+    }
+    if (!Acceleration.sizes().Equal(Position.sizes())) {
+        cmnThrow("robReflexxes::EvaluateCycles: acceleration doesn't match position size");
+    }
+
+    const size_t nbCycles = Position.rows();
+    size_t cycle = 0;
+    for (;
+         cycle < nbCycles;
+         ++cycle) {
+        // first cycle sets the input parameters and checks sizes,
+        // following cycles only feed back the output parameters
+        if (cycle == 0) {
+            Evaluate(CurrentPosition, CurrentVelocity, TargetPosition, TargetVelocity);
+        } else {
+            *(IP->CurrentPositionVector) = *(OP->NewPositionVector);
+            *(IP->CurrentVelocityVector) = *(OP->NewVelocityVector);
+            *(IP->CurrentAccelerationVector) = *(OP->NewAccelerationVector);
+            const int rmlResult = RML->RMLPosition(*IP, OP, *mFlags);
+            switch (rmlResult) {
+            case ReflexxesAPI::RML_WORKING:
+                mResultValue = Reflexxes_WORKING;
+                break;
+            case ReflexxesAPI::RML_FINAL_STATE_REACHED:
+                mResultValue = Reflexxes_FINAL_STATE_REACHED;
+                break;
+            default:
+                mResultValue = Reflexxes_ERROR;
+                break;
+            }
+        }
+        for (size_t i = 0;
+             i < mDimension;
+             ++i) {
+            Position.Element(cycle, i) = OP->NewPositionVector->VecData[i];
+            Velocity.Element(cycle, i) = OP->NewVelocityVector->VecData[i];
+            Acceleration.Element(cycle, i) = OP->NewAccelerationVector->VecData[i];
+        }
+        if (mResultValue != Reflexxes_WORKING) {
+            ++cycle;
+            break;
+        }
+    }
+
+    // trajectory is over, repeat the last state
+    if ((cycle > 0) && (cycle < nbCycles)) {
+        for (size_t remaining = cycle; remaining < nbCycles; ++remaining) {
+            Position.Row(remaining).Assign(Position.Row(cycle - 1));
+            Velocity.Row(remaining).Assign(Velocity.Row(cycle - 1));
+            Acceleration.Row(remaining).Assign(Acceleration.Row(cycle - 1));
+        }
+    }
+
+    // feed back the last cycle
+    if (nbCycles > 0) {
+        for (size_t i = 0;
+             i < mDimension;
+             ++i) {
+            CurrentPosition[i] = OP->NewPositionVector->VecData[i];
+            CurrentVelocity[i] = OP->NewVelocityVector->VecData[i];
+            mCurrentAcceleration[i] = OP->NewAccelerationVector->VecData[i];
+        }
+    }
+}
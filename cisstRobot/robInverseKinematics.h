@@ -0,0 +1,225 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*-    */
+/* ex: set filetype=cpp softtabstop=2 shiftwidth=2 tabstop=2 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _robInverseKinematics_h
+#define _robInverseKinematics_h
+
+#include <vector>
+
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstRobot/robManipulator.h>
+
+#include <cisstRobot/robExport.h>
+
+//! Damped least squares inverse kinematics
+/**
+   robInverseKinematics solves the inverse kinematics of a robManipulator with
+   the Levenberg-Marquardt algorithm: each iteration solves
+   dq = J' ( J J' + lambda I )^-1 e
+   where e is the position/orientation error of the tool control point and J
+   the Jacobian of the tool control point. The damping lambda is decreased
+   when a step reduces the error and increased (and the step rejected)
+   otherwise, so the solver behaves like Gauss-Newton far from singularities
+   and like gradient descent close to them. If joint limits are enabled, each
+   step is clipped to the limits of the links (links with a minimum not lower
+   than their maximum are not limited).
+
+   The manipulator is only used through robManipulatorState so the same
+   robManipulator can be used by several solvers or threads. Each call uses
+   one workspace per thread and doesn't allocate memory once the workspaces
+   exist.
+
+   Besides Solve, the solver provides:
+   - SolveMultiStart: tries the initial guess and NumberOfSeeds-1 random
+     seeds within the joint limits in parallel and returns the first solution
+     that converges, the other threads are then stopped.
+   - SolveBatch: solves many targets in parallel, each thread processing a
+     contiguous range of targets. A target without initial guess is warm
+     started from the solution of the previous target of the same range,
+     which is efficient for targets along a path.
+
+   A solver must not be used by several threads at the same time.
+*/
+class CISST_EXPORT robInverseKinematics{
+
+ public:
+
+  enum Errno{ ESUCCESS, EFAILURE };
+
+  //! Create a solver for a manipulator
+  /**
+     The manipulator is not copied and must remain valid while the solver is
+     used.
+  */
+  robInverseKinematics( const robManipulator& robot );
+
+  ~robInverseKinematics();
+
+  //! Convergence thresholds on the position and orientation errors
+  void SetTolerance( double position, double orientation );
+
+  //! Maximum number of iterations for each seed (default 100)
+  void SetMaxIterations( size_t iterations ){ maxIterations = iterations; }
+
+  //! Initial damping (default 1e-3)
+  void SetDamping( double lambda ){ damping = lambda; }
+
+  //! Clip the joint positions to the limits of the links (default true)
+  void SetJointLimits( bool enable ){ jointLimits = enable; }
+
+  //! Number of threads used by SolveMultiStart and SolveBatch (default 1)
+  void SetNumberOfThreads( size_t threads );
+
+  //! Number of seeds tried by SolveMultiStart and SolveBatch (default 1)
+  /**
+     The first seed is always the initial guess, the others are drawn
+     uniformly within the joint limits (or [-pi, pi] for unlimited joints).
+  */
+  void SetNumberOfSeeds( size_t seeds ){ numberOfSeeds = ( seeds > 0 ) ? seeds : 1; }
+
+  //! Seed of the random sequences used to draw the joint positions
+  void SetRandomSeed( unsigned int seed ){ randomSeed = seed; }
+
+  //! Solve from a single initial guess
+  /**
+     \param[input] q An initial guess of the solution
+     \param[output] q The solution, or the closest configuration found
+     \param Rts The desired position and orientation of the tool control point
+     \return ESUCCESS if the error is below the tolerance
+  */
+  robInverseKinematics::Errno
+  Solve( vctDynamicVector<double>& q, const vctFrame4x4<double>& Rts );
+
+  //! Solve from several seeds in parallel
+  /**
+     \param[input] q An initial guess of the solution, used as first seed
+     \param[output] q The first solution found, or the closest configuration
+     \param Rts The desired position and orientation of the tool control point
+     \return ESUCCESS if one of the seeds converged
+  */
+  robInverseKinematics::Errno
+  SolveMultiStart( vctDynamicVector<double>& q, const vctFrame4x4<double>& Rts );
+
+  //! Solve for many targets in parallel
+  /**
+     \param targets The desired positions and orientations of the tool
+     \param[input] solutions Initial guess for each target. Targets without
+                   a guess of the proper size are warm started from the
+                   previous solution (or from zero for the first target of a
+                   range). solutions is resized to the number of targets.
+     \param[output] solutions The solution of each target
+     \param[output] converged True for the targets that converged
+     \return The number of targets that converged
+  */
+  size_t SolveBatch( const std::vector< vctFrame4x4<double> >& targets,
+                     std::vector< vctDynamicVector<double> >& solutions,
+                     vctDynamicVector<bool>& converged );
+
+  //! Number of iterations of the last call to Solve
+  size_t GetNumberOfIterations() const { return numberOfIterations; }
+
+  //! Position and orientation errors of the last call to Solve
+  double GetPositionError() const { return positionError; }
+  double GetOrientationError() const { return orientationError; }
+
+  //! Per thread workspace, public for the worker threads
+  struct Workspace{
+    robManipulatorState states[2];
+    vctDynamicMatrix<double> J;
+    vctDynamicVector<double> dq;
+    vctDynamicVector<double> qtrial;
+    vctDynamicVector<double> qbest;
+    unsigned int random;                   // state of the random generator
+    size_t iterations;
+    double positionError;
+    double orientationError;
+  };
+
+  //! Solve a range of targets of SolveBatch, used by the worker threads
+  void SolveRange( size_t thread, size_t begin, size_t end );
+
+  //! Try the seeds of SolveMultiStart, used by the worker threads
+  void SolveSeeds( size_t thread );
+
+ protected:
+
+  const robManipulator& robot;
+
+  double positionTolerance;
+  double orientationTolerance;
+  size_t maxIterations;
+  double damping;
+  bool jointLimits;
+  size_t numberOfThreads;
+  size_t numberOfSeeds;
+  unsigned int randomSeed;
+
+  size_t numberOfIterations;
+  double positionError;
+  double orientationError;
+
+  std::vector<Workspace*> workspaces;
+
+  //! Data shared by the threads during SolveBatch/SolveMultiStart
+  //@{
+  const std::vector< vctFrame4x4<double> >* batchTargets;
+  std::vector< vctDynamicVector<double> >* batchSolutions;
+  vctDynamicVector<bool>* batchConverged;
+
+  const vctFrame4x4<double>* multiStartTarget;
+  const vctDynamicVector<double>* multiStartGuess;
+  osaMutex multiStartMutex;
+  size_t multiStartNextSeed;
+  volatile bool multiStartDone;
+  double multiStartBestError;
+  vctDynamicVector<double> multiStartSolution;
+  //@}
+
+  //! Allocate the workspaces for the number of threads and links
+  void AllocateWorkspaces();
+
+  //! Levenberg-Marquardt iterations from q
+  /**
+     \param stop If not NULL, the iterations are aborted when *stop is true
+     \return true if the error is below the tolerance
+  */
+  bool Iterate( Workspace& workspace,
+                vctDynamicVector<double>& q,
+                const vctFrame4x4<double>& Rts,
+                const volatile bool* stop );
+
+  //! Error of the tool control point of the state
+  double Error( const robManipulatorState& state,
+                const vctFrame4x4<double>& Rts,
+                vctFixedSizeVector<double,6>& e,
+                double& positionError,
+                double& orientationError ) const;
+
+  //! Draw a random configuration within the joint limits
+  void RandomConfiguration( Workspace& workspace,
+                            vctDynamicVector<double>& q ) const;
+
+  //! Clip q to the joint limits
+  void ClipToLimits( vctDynamicVector<double>& q ) const;
+
+  //! Solve one target from q then from random seeds
+  bool SolveSeeded( Workspace& workspace,
+                    vctDynamicVector<double>& q,
+                    const vctFrame4x4<double>& Rts );
+
+};
+
+#endif // _robInverseKinematics_h
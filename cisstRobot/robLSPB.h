@@ -20,7 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _robLSPB_h
 
 #include <cisstVector/vctDynamicVectorTypes.h>
-
+#include <cisstVector/vctDynamicMatrixTypes.h>
 
 // Always include last
 #include <cisstRobot/robExport.h>
@@ -47,6 +47,12 @@ http://www.cisst.org/cisst/license.txt.
  generator returns the start point.  For any time after the end time,
  the generator returns the end point.
 
+ To preview a whole trajectory, EvaluateTimes and EvaluatePeriod
+ evaluate many samples in a single call.  Each row of the output
+ matrices is a sample and each column a joint.  The outputs are
+ references so the caller can provide any memory, including numpy
+ arrays from Python without copies.
+
  \ingroup cisstRobot
 */
 class CISST_EXPORT robLSPB {
@@ -72,6 +78,16 @@ class CISST_EXPORT robLSPB {
         mTimeScale,
         mTemp;
 
+    /*! Evaluate the samples of EvaluateTimes or, if times is null,
+      EvaluatePeriod. */
+    void EvaluateSamples(const double * times,
+                         const vctDynamicConstVectorRef<double>::stride_type timesStride,
+                         const double startTime,
+                         const double period,
+                         vctDynamicMatrixRef<double> & position,
+                         vctDynamicMatrixRef<double> & velocity,
+                         vctDynamicMatrixRef<double> & acceleration);
+
  public:
     robLSPB(void);
     robLSPB(const vctDoubleVec & start,
@@ -108,6 +124,29 @@ class CISST_EXPORT robLSPB {
     void Evaluate(const double time,
                   vctDoubleVec & position);
 
+    /*! \brief Evaluate the trajectory at multiple times.  The
+      matrices must have one row per time and one column per degree
+      of freedom.  Times don't need to be sorted.
+
+      \param times Absolute times
+      \param position Positions, one row per time
+      \param velocity Velocities, one row per time
+      \param acceleration Accelerations, one row per time
+    */
+    void EvaluateTimes(vctDynamicConstVectorRef<double> times,
+                       vctDynamicMatrixRef<double> position,
+                       vctDynamicMatrixRef<double> velocity,
+                       vctDynamicMatrixRef<double> acceleration);
+
+    /*! \brief Evaluate the trajectory at regular intervals, i.e. at
+      startTime + k * period for each row k of the output matrices.
+      See EvaluateTimes. */
+    void EvaluatePeriod(const double startTime,
+                        const double period,
+                        vctDynamicMatrixRef<double> position,
+                        vctDynamicMatrixRef<double> velocity,
+                        vctDynamicMatrixRef<double> acceleration);
+
     //! Return start time
     double & StartTime(void);
 
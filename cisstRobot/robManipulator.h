@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstVector/vctTransformationTypes.h>
 #include <cisstRobot/robLink.h>
+#include <cisstRobot/robManipulatorState.h>
 
 #if CISST_HAS_JSON
 #include <json/json.h>
@@ -38,6 +39,13 @@ class CISST_EXPORT robManipulator{
   //! A vector of tools
   std::vector<robManipulator*> tools;
 
+  //! Workspace of the methods that don't take a state
+  /**
+     Like Jn and Js, this is overwritten by the const methods and is not
+     thread safe. Use a robManipulatorState per thread instead.
+  */
+  mutable robManipulatorState workspace;
+
  public:
 
   enum Errno{ ESUCCESS, EFAILURE };
@@ -170,6 +178,97 @@ class CISST_EXPORT robManipulator{
   */
   void OSinertia(double Ac[6][6], const vctDynamicVector<double>& q) const;
 
+  //! Compute the NxN manipulator inertia matrix (composite rigid body)
+  /**
+     Evaluate the joint space inertia matrix with the composite rigid body
+     algorithm (Walker and Orin 82). This is O(N^2) instead of the N calls to
+     RNE used by JSinertia( q ) and it does not allocate memory once M has
+     the proper size and the method has been called once.
+     \param[output] M The NxN manipulator inertia matrix. M is only resized if
+                      its size is not NxN.
+     \param q The joint positions
+  */
+  robManipulator::Errno
+  JSinertia( vctDynamicMatrix<double>& M,
+             const vctDynamicVector<double>& q ) const;
+
+  //! Compute the 6x6 manipulator inertia matrix in operation space
+  /**
+     Evaluate (Jn M^-1 Jn')^-1 where M is computed by the composite rigid body
+     algorithm and Jn is the body Jacobian. M^-1 Jn' is computed by solving
+     with the Cholesky factor of M instead of inverting M and the 6x6 result
+     is inverted by its Cholesky factor. No memory is allocated after the
+     first call.
+     \param[output] Ac The 6x6 manipulator inertia matrix in operation space
+     \param q The joint positions
+     \return EFAILURE if M is not positive definite or if the manipulator is
+             at a singular configuration (Ac is then left unchanged)
+  */
+  robManipulator::Errno
+  OSinertia( vctFixedSizeMatrix<double,6,6>& Ac,
+             const vctDynamicVector<double>& q ) const;
+
+  //! Evaluate and cache the link frames
+  /**
+     Evaluate the transformation of each link once and store them in the
+     state. The state is resized if needed. All the methods below use the
+     frames of the last update and don't modify the manipulator such that
+     several threads can use the same manipulator with different states.
+     \param[output] state The state of the manipulator
+     \param q The joint positions
+  */
+  robManipulator::Errno
+  UpdateState( robManipulatorState& state,
+               const vctDynamicVector<double>& q ) const;
+
+  //! Evaluate the 6xN body Jacobian of the state
+  /**
+     The Jacobian is stored in the state and is only evaluated once per update.
+     \return The body Jacobian, same as JacobianBody( q, J )
+  */
+  const vctDynamicMatrix<double>&
+  JacobianBody( robManipulatorState& state ) const;
+
+  //! Evaluate the 6xN spatial Jacobian of the state
+  /**
+     The Jacobian is stored in the state and is only evaluated once per update.
+     Unlike JacobianSpatial( q ), this does not require the body Jacobian.
+     \return The spatial Jacobian, same as JacobianSpatial( q, J )
+  */
+  const vctDynamicMatrix<double>&
+  JacobianSpatial( robManipulatorState& state ) const;
+
+  //! Recursive Newton-Euler algorithm using the frames of the state
+  /**
+     \param[output] tau The joint forces/torques, resized only if needed
+     \sa RNE( q, qd, qdd, f, g )
+  */
+  robManipulator::Errno
+  RNE( robManipulatorState& state,
+       const vctDynamicVector<double>& qd,
+       const vctDynamicVector<double>& qdd,
+       const vctFixedSizeVector<double,6>& f,
+       vctDynamicVector<double>& tau,
+       double g = 9.81 ) const;
+
+  /**
+     Compute the bias acceleration using the frames of the state. Returns
+     zero if the state or the size of qd does not match the manipulator.
+  */
+  vctFixedSizeVector<double,6>
+  BiasAcceleration( const robManipulatorState& state,
+                    const vctDynamicVector<double>& qd ) const;
+
+  //! Compute the NxN manipulator inertia matrix using the frames of the state
+  robManipulator::Errno
+  JSinertia( robManipulatorState& state,
+             vctDynamicMatrix<double>& M ) const;
+
+  //! Compute the 6x6 OS inertia matrix using the frames of the state
+  robManipulator::Errno
+  OSinertia( robManipulatorState& state,
+             vctFixedSizeMatrix<double,6,6>& Ac ) const;
+
   vctFixedSizeMatrix<double,4,4>
     SE3Difference( const vctFrame4x4<double>& Rt1,
                    const vctFrame4x4<double>& Rt2 ) const;
@@ -0,0 +1,147 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*-    */
+/* ex: set filetype=cpp softtabstop=2 shiftwidth=2 tabstop=2 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _robManipulatorState_h
+#define _robManipulatorState_h
+
+#include <vector>
+
+#include <cisstVector/vctTransformationTypes.h>
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstVector/vctDynamicMatrixTypes.h>
+
+#include <cisstRobot/robExport.h>
+
+class robManipulator;
+
+//! Kinematics and dynamics workspace of a manipulator
+/**
+   robManipulatorState caches the link frames of a robManipulator for a given
+   vector of joint positions and holds all the buffers used to evaluate the
+   Jacobians, the inverse dynamics and the inertia matrices. The frames are
+   evaluated once by robManipulator::UpdateState and are then reused by the
+   other methods of robManipulator that take a state. Once the state has the
+   size of the manipulator no memory is allocated.
+
+   The manipulator itself is not modified by these methods so a single
+   robManipulator can be shared by several threads as long as each thread uses
+   its own state.
+
+   \code
+   robManipulatorState state;
+   robot.UpdateState( state, q );
+   vctFrame4x4<double> Rtwn = state.ForwardKinematics();
+   robot.JacobianSpatial( state );
+   robot.RNE( state, qd, qdd, fext, tau );
+   \endcode
+*/
+class CISST_EXPORT robManipulatorState{
+
+  friend class robManipulator;
+
+ public:
+
+  //! Composite body used by the composite rigid body algorithm
+  /**
+     All the quantities are expressed in the base frame of the manipulator.
+  */
+  struct CompositeBody{
+    vctFixedSizeVector<double,3> axis;     // joint axis
+    vctFixedSizeVector<double,3> point;    // a point on the joint axis
+    double m;                              // mass
+    vctFixedSizeVector<double,3> h;        // first moment of mass
+    vctFixedSizeMatrix<double,3,3> I;      // inertia wrt the base origin
+  };
+
+  robManipulatorState();
+
+  //! Allocate a state for a manipulator with N links
+  robManipulatorState( size_t N );
+
+  //! Allocate the buffers for a manipulator with N links
+  /**
+     Nothing is done if the state already has N links. The state must be
+     updated after it has been resized.
+  */
+  void SetSize( size_t N );
+
+  //! The number of links
+  size_t size() const { return Rtl.size(); }
+
+  //! True if the state has been updated since it was resized
+  bool IsValid() const { return valid; }
+
+  //! The joint positions of the last update
+  const vctDynamicVector<double>& JointPositions() const { return q; }
+
+  //! Position and orientation of a link wrt the world frame
+  /**
+     \param i The link number (0 => base, i.e. Rtw0)
+  */
+  const vctFrame4x4<double>& LinkFrame( size_t i ) const { return Rtwi[i]; }
+
+  //! Position and orientation of a link wrt the previous one
+  const vctFrame4x4<double>& LinkTransformation( size_t i ) const
+  { return Rtl[i]; }
+
+  //! Forward kinematics from the cached frames
+  /**
+     Same as robManipulator::ForwardKinematics for the joint positions of the
+     last update.
+     \param N The link number (0 => base, negative => end-effector)
+  */
+  vctFrame4x4<double> ForwardKinematics( int N = -1 ) const;
+
+  //! The 6xN body Jacobian evaluated by robManipulator::JacobianBody
+  const vctDynamicMatrix<double>& JacobianBody() const { return Jn; }
+
+  //! The 6xN spatial Jacobian evaluated by robManipulator::JacobianSpatial
+  const vctDynamicMatrix<double>& JacobianSpatial() const { return Js; }
+
+ protected:
+
+  bool valid;
+  bool JnValid;
+  bool JsValid;
+
+  vctDynamicVector<double> q;
+
+  //! Link frames wrt the world (N+1 frames, starting with Rtw0)
+  std::vector< vctFrame4x4<double> > Rtwi;
+  //! Link frames wrt the previous link
+  std::vector< vctFrame4x4<double> > Rtl;
+  //! Position of each link wrt the previous one (in the link frame)
+  std::vector< vctFixedSizeVector<double,3> > pstar;
+
+  //! Transformation of the tool, if any
+  bool hasTool;
+  vctFrame4x4<double> Rtnt;
+
+  vctDynamicMatrix<double> Jn;
+  vctDynamicMatrix<double> Js;
+
+  //! Force and moment of each link (RNE)
+  std::vector< vctFixedSizeVector<double,3> > F;
+  std::vector< vctFixedSizeVector<double,3> > N;
+
+  //! Composite rigid body algorithm
+  std::vector<CompositeBody> composites;
+  vctDynamicMatrix<double> M;            // NxN inertia/Cholesky factor
+  vctDynamicMatrix<double> MinvJt;       // Nx6 M^-1 Jn'
+
+};
+
+#endif // _robManipulatorState_h
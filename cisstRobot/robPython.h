@@ -34,5 +34,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstRobot/robDH.h>
 #include <cisstRobot/robModifiedDH.h>
 #include <cisstRobot/robHayati.h>
+#include <cisstRobot/robLSPB.h>
+#include <cisstRobot/robQuintic.h>
 
 #endif // _robPython_h
@@ -21,6 +21,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _robQuintic_h
 
 //#include <cisstVector/vctFixedSizeVector.h>
+#include <cisstVector/vctDynamicMatrixTypes.h>
 #include <cisstRobot/robFunctionRn.h>
 #include <cisstRobot/robExport.h>
 
@@ -39,6 +40,14 @@ class CISST_EXPORT robQuintic : public robFunctionRn {
                           const vctFixedSizeVector<double,6>& x,
                           double& y, double& yd, double& ydd);
 
+    void EvaluateSamples( const double* times,
+                          vctDynamicConstVectorRef<double>::stride_type stride,
+                          double startTime,
+                          double period,
+                          vctDynamicMatrixRef<double>& y,
+                          vctDynamicMatrixRef<double>& yd,
+                          vctDynamicMatrixRef<double>& ydd );
+
  public:
 
     /*! Default constructor */
@@ -111,6 +120,28 @@ class CISST_EXPORT robQuintic : public robFunctionRn {
                    vctDynamicVector<double>& yd,
                    vctDynamicVector<double>& ydd );
 
+    //! Evaluate the N quintics at multiple times
+    /**
+       Each row of the output matrices is a sample and each column one of the
+       N quintics. The matrices must be sized by the caller, they are
+       references so numpy arrays can be used from Python without copies.
+       \param times The times to evaluate, not necessarily sorted
+       \param y The values, one row per time
+       \param yd The 1st derivatives, one row per time
+       \param ydd The 2nd derivatives, one row per time
+    */
+    void EvaluateTimes( vctDynamicConstVectorRef<double> times,
+                        vctDynamicMatrixRef<double> y,
+                        vctDynamicMatrixRef<double> yd,
+                        vctDynamicMatrixRef<double> ydd );
+
+    //! Evaluate the N quintics at startTime + k*period for each row k
+    void EvaluatePeriod( double startTime,
+                         double period,
+                         vctDynamicMatrixRef<double> y,
+                         vctDynamicMatrixRef<double> yd,
+                         vctDynamicMatrixRef<double> ydd );
+
 
     void Blend( robFunction* function,
                 const vctDynamicVector<double>& qdmax,
@@ -26,6 +26,7 @@ class RMLPositionOutputParameters;
 class RMLPositionFlags;
 
 #include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstVector/vctDynamicMatrixTypes.h>
 
 // Always include last
 #include <cisstRobot/robExport.h>
@@ -109,6 +110,30 @@ public:
                   vctDoubleVec & CurrentVelocity,
                   const vctDoubleVec & TargetPosition,
                   const vctDoubleVec & TargetVelocity);
+
+    /*! \brief Evaluate as many control cycles as there are rows in
+      the output matrices, i.e. a preview of the trajectory over a
+      horizon of Position.rows() * CycleTime.  Each row of the output
+      matrices is a cycle and each column a degree of freedom.  The
+      outputs are references so numpy arrays can be used from Python
+      without copies.  Once the final state is reached, the remaining
+      rows are set to the last state without calling Reflexxes.
+
+      \param current position, updated to the last cycle
+      \param current velocity, updated to the last cycle
+      \param target position
+      \param target velocities
+      \param positions for each cycle
+      \param velocities for each cycle
+      \param accelerations for each cycle
+    */
+    void EvaluateCycles(vctDoubleVec & CurrentPosition,
+                        vctDoubleVec & CurrentVelocity,
+                        const vctDoubleVec & TargetPosition,
+                        const vctDoubleVec & TargetVelocity,
+                        vctDynamicMatrixRef<double> Position,
+                        vctDynamicMatrixRef<double> Velocity,
+                        vctDynamicMatrixRef<double> Acceleration);
 };
 
 #endif // _robReflexxes_h
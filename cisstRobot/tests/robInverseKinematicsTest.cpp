@@ -0,0 +1,115 @@
+#include <stdlib.h>
+
+#include <cisstRobot/robInverseKinematics.h>
+#include "robInverseKinematicsTest.h"
+
+#include "robRobotsKinematics.h"
+
+void robInverseKinematicsTest::setUp(){
+  CPPUNIT_ASSERT( LoadWAM7Dynamics( WAM7 ) );
+}
+
+// random configuration within the limits of the WAM
+vctDynamicVector<double> robInverseKinematicsTest::RandomWAMVector() const {
+  vctDynamicVector<double> q( 7, 0.0 );
+  for( size_t i=0; i<7; i++ ){
+    double t = ((double)rand()) / ( (double) RAND_MAX );
+    double qmin = WAM7.links[i].PositionMin();
+    double qmax = WAM7.links[i].PositionMax();
+    q[i] = qmin + 0.1 + t*( qmax - qmin - 0.2 );
+  }
+  return q;
+}
+
+void robInverseKinematicsTest::TestSolve(){
+
+  robInverseKinematics ik( WAM7 );
+  ik.SetTolerance( 1e-8, 1e-8 );
+
+  for( size_t i=0; i<10; i++ ){
+
+    vctDynamicVector<double> q = RandomWAMVector();
+    vctFrame4x4<double> Rts = WAM7.ForwardKinematics( q );
+
+    vctDynamicVector<double> qs( q );
+    for( size_t j=0; j<7; j++ ) { qs[j] += 0.1; }
+    CPPUNIT_ASSERT( ik.Solve( qs, Rts ) == robInverseKinematics::ESUCCESS );
+    CPPUNIT_ASSERT( Rts.AlmostEqual( WAM7.ForwardKinematics( qs ), 1e-6 ) );
+    CPPUNIT_ASSERT( ik.GetPositionError() <= 1e-8 );
+    CPPUNIT_ASSERT( ik.GetOrientationError() <= 1e-8 );
+  }
+
+  vctDynamicVector<double> q( 6, 0.0 );
+  CPPUNIT_ASSERT( ik.Solve( q, WAM7.ForwardKinematics( RandomWAMVector() ) )
+                  == robInverseKinematics::EFAILURE );
+
+}
+
+void robInverseKinematicsTest::TestJointLimits(){
+
+  robInverseKinematics ik( WAM7 );
+
+  for( size_t i=0; i<10; i++ ){
+
+    vctDynamicVector<double> q = RandomWAMVector();
+    vctFrame4x4<double> Rts = WAM7.ForwardKinematics( q );
+
+    // start outside of the limits
+    vctDynamicVector<double> qs( q );
+    qs[0] = 4.0;
+    ik.Solve( qs, Rts );
+    for( size_t j=0; j<7; j++ ){
+      CPPUNIT_ASSERT( WAM7.links[j].PositionMin() <= qs[j] );
+      CPPUNIT_ASSERT( qs[j] <= WAM7.links[j].PositionMax() );
+    }
+  }
+
+}
+
+void robInverseKinematicsTest::TestMultiStart(){
+
+  robInverseKinematics ik( WAM7 );
+  ik.SetNumberOfSeeds( 16 );
+  ik.SetNumberOfThreads( 4 );
+
+  for( size_t i=0; i<5; i++ ){
+
+    vctFrame4x4<double> Rts = WAM7.ForwardKinematics( RandomWAMVector() );
+
+    // a far initial guess
+    vctDynamicVector<double> qs = RandomWAMVector();
+    CPPUNIT_ASSERT( ik.SolveMultiStart( qs, Rts ) == robInverseKinematics::ESUCCESS );
+    CPPUNIT_ASSERT( Rts.AlmostEqual( WAM7.ForwardKinematics( qs ), 1e-5 ) );
+  }
+
+}
+
+void robInverseKinematicsTest::TestBatch(){
+
+  // targets along a path
+  const size_t count = 64;
+  vctDynamicVector<double> q0 = RandomWAMVector();
+  vctDynamicVector<double> q1 = RandomWAMVector();
+  std::vector< vctFrame4x4<double> > targets( count );
+  for( size_t i=0; i<count; i++ ){
+    double t = ((double)i) / ((double)(count-1));
+    targets[i] = WAM7.ForwardKinematics( q0 + t*(q1 - q0) );
+  }
+
+  robInverseKinematics ik( WAM7 );
+  ik.SetNumberOfThreads( 3 );
+  ik.SetNumberOfSeeds( 8 );
+
+  // warm start from the start of the path only
+  std::vector< vctDynamicVector<double> > solutions( 1, q0 );
+  vctDynamicVector<bool> converged;
+  CPPUNIT_ASSERT_EQUAL( count, ik.SolveBatch( targets, solutions, converged ) );
+  CPPUNIT_ASSERT_EQUAL( count, solutions.size() );
+  for( size_t i=0; i<count; i++ ){
+    CPPUNIT_ASSERT( converged[i] );
+    CPPUNIT_ASSERT( targets[i].AlmostEqual( WAM7.ForwardKinematics( solutions[i] ), 1e-5 ) );
+  }
+
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION( robInverseKinematicsTest );
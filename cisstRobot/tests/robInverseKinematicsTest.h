@@ -0,0 +1,33 @@
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cisstRobot/robManipulator.h>
+
+class robInverseKinematicsTest : public CppUnit::TestFixture {
+
+private:
+
+  CPPUNIT_TEST_SUITE( robInverseKinematicsTest );
+
+  CPPUNIT_TEST(TestSolve);
+  CPPUNIT_TEST(TestJointLimits);
+  CPPUNIT_TEST(TestMultiStart);
+  CPPUNIT_TEST(TestBatch);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  robManipulator WAM7;
+
+  vctDynamicVector<double> RandomWAMVector() const;
+
+public:
+
+  void setUp();
+
+  void TestSolve();
+  void TestJointLimits();
+  void TestMultiStart();
+  void TestBatch();
+
+};
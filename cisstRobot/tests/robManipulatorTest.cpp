@@ -79,4 +79,89 @@ void robManipulatorTest::TestInverseDynamics(){
 
 }
 
+void robManipulatorTest::TestJSinertia(){
+
+  robManipulator WAM7;
+  CPPUNIT_ASSERT( LoadWAM7Dynamics( WAM7 ) );
+
+  vctDynamicMatrix<double> M;
+  for( size_t i=0; i<10; i++ ){
+
+    vctDynamicVector<double> q = RandomWAMVector();
+    vctDynamicMatrix<double> A = WAM7.JSinertia( q );
+
+    CPPUNIT_ASSERT( WAM7.JSinertia( M, q ) == robManipulator::ESUCCESS );
+    CPPUNIT_ASSERT_EQUAL( (size_t)7, M.rows() );
+    CPPUNIT_ASSERT_EQUAL( (size_t)7, M.cols() );
+    CPPUNIT_ASSERT( M.AlmostEqual( A, 1e-9 ) );
+    CPPUNIT_ASSERT( M.AlmostEqual( M.Transpose(), 1e-12 ) );
+  }
+
+}
+
+void robManipulatorTest::TestOSinertia(){
+
+  robManipulator WAM7;
+  CPPUNIT_ASSERT( LoadWAM7Dynamics( WAM7 ) );
+
+  for( size_t i=0; i<10; i++ ){
+
+    vctDynamicVector<double> q = RandomWAMVector();
+
+    // column major result of the RNE/LAPACK path
+    double A[6][6];
+    WAM7.OSinertia( A, q );
+
+    vctFixedSizeMatrix<double,6,6> Ac;
+    CPPUNIT_ASSERT( WAM7.OSinertia( Ac, q ) == robManipulator::ESUCCESS );
+    for( size_t r=0; r<6; r++ ){
+      for( size_t c=0; c<6; c++ ){
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( A[c][r], Ac[r][c],
+                                      1e-6 * ( 1.0 + fabs( A[c][r] ) ) );
+      }
+    }
+  }
+
+}
+
+void robManipulatorTest::TestState(){
+
+  robManipulator WAM7;
+  CPPUNIT_ASSERT( LoadWAM7Dynamics( WAM7 ) );
+  WAM7.Rtw0 = vctFrame4x4<double>( vctMatrixRotation3<double>( 0.0, 0.0, 1.0,
+                                                               1.0, 0.0, 0.0,
+                                                               0.0, 1.0, 0.0 ),
+                                   vctFixedSizeVector<double,3>( 0.1, 0.2, 0.3 ) );
+
+  robManipulatorState state;
+  vctDynamicMatrix<double> Jn( 6, 7 ), Js( 6, 7 );
+  vctDynamicVector<double> tau;
+  for( size_t i=0; i<10; i++ ){
+
+    vctDynamicVector<double> q = RandomWAMVector();
+    vctDynamicVector<double> qd = RandomWAMVector();
+    vctDynamicVector<double> qdd = RandomWAMVector();
+    vctFixedSizeVector<double,6> fext( 1.0, -2.0, 3.0, 0.1, 0.2, -0.3 );
+
+    CPPUNIT_ASSERT( WAM7.UpdateState( state, q ) == robManipulator::ESUCCESS );
+    CPPUNIT_ASSERT( state.IsValid() );
+
+    for( int n=0; n<=7; n++ )
+      { CPPUNIT_ASSERT( state.ForwardKinematics( n ).AlmostEqual( WAM7.ForwardKinematics( q, n ) ) ); }
+
+    WAM7.JacobianBody( q, Jn );
+    WAM7.JacobianSpatial( q, Js );
+    CPPUNIT_ASSERT( WAM7.JacobianBody( state ).AlmostEqual( Jn, 1e-9 ) );
+    CPPUNIT_ASSERT( WAM7.JacobianSpatial( state ).AlmostEqual( Js, 1e-9 ) );
+
+    CPPUNIT_ASSERT( WAM7.RNE( state, qd, qdd, fext, tau ) == robManipulator::ESUCCESS );
+    CPPUNIT_ASSERT( tau.AlmostEqual( WAM7.RNE( q, qd, qdd, fext ), 1e-9 ) );
+
+    CPPUNIT_ASSERT( WAM7.BiasAcceleration( state, qd ).AlmostEqual( WAM7.BiasAcceleration( q, qd ), 1e-9 ) );
+    // joint velocities that do not match the manipulator are rejected
+    CPPUNIT_ASSERT( WAM7.BiasAcceleration( state, vctDynamicVector<double>( 3, 1.0 ) ).Equal( vctFixedSizeVector<double,6>( 0.0 ) ) );
+  }
+
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION( robManipulatorTest );
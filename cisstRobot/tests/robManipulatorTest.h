@@ -3,6 +3,7 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <cisstRobot/robDH.h>
+#include <cisstRobot/robManipulator.h>
 
 class robManipulatorTest : public CppUnit::TestFixture {
   
@@ -12,6 +13,9 @@ private:
 
   CPPUNIT_TEST(TestForwardKinematics);
   CPPUNIT_TEST(TestInverseKinematics);
+  CPPUNIT_TEST(TestJSinertia);
+  CPPUNIT_TEST(TestOSinertia);
+  CPPUNIT_TEST(TestState);
 
   //CPPUNIT_TEST(TestInverseDynamics);
 
@@ -23,6 +27,10 @@ public:
 
   void TestForwardKinematics();
   void TestInverseKinematics();
+
+  void TestJSinertia();
+  void TestOSinertia();
+  void TestState();
   
   void TestInverseDynamics();
 
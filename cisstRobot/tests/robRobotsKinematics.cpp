@@ -1,3 +1,5 @@
+#include <sstream>
+
 #include "robRobotsKinematics.h"
 
 vctFrame4x4<double> FKineWAM7( size_t i, double t ){
@@ -54,3 +56,31 @@ vctFrame4x4<double> FKinePUMA560( size_t i, double t ){
   return Rt;
   
 }
+
+bool LoadWAM7Dynamics( robManipulator& WAM7 ){
+
+  // DH parameters of the WAM followed by the mass, center of mass, principal
+  // moments of inertia and principal axes of each link
+  const char* parameters[7] = {
+    "-1.5708  0.000 0 0.000 hinge active 0 -2.6 2.6 77.3 10.7 -0.004  0.121 -0.007 0.13 0.11 0.09 1 0 0 0 1 0 0 0 1",
+    " 1.5708  0.000 0 0.000 hinge active 0 -2.0 2.0 160.6 3.87 -0.002  0.031  0.016 0.02 0.02 0.01 1 0 0 0 0.8 0.6 0 -0.6 0.8",
+    "-1.5708  0.045 0 0.550 hinge active 0 -2.8 2.8 95.6 1.80 -0.038  0.207  0.003 0.06 0.06 0.002 1 0 0 0 1 0 0 0 1",
+    " 1.5708 -0.045 0 0.000 hinge active 0 -0.9 3.1 29.4 2.40  0.006  0.000  0.144 0.03 0.03 0.002 0 1 0 -1 0 0 0 0 1",
+    "-1.5708  0.000 0 0.300 hinge active 0 -4.8 1.3 11.6 0.12  0.000  0.005  0.011 0.0001 0.0001 0.0001 1 0 0 0 1 0 0 0 1",
+    " 1.5708  0.000 0 0.000 hinge active 0 -1.6 1.6 11.6 0.42  0.000  0.012  0.022 0.0005 0.0003 0.0005 1 0 0 0 1 0 0 0 1",
+    " 0.0000  0.000 0 0.062 hinge active 0 -3.0 3.0 2.7 0.07  0.000  0.000 -0.004 0.00004 0.00004 0.00007 1 0 0 0 1 0 0 0 1" };
+
+  std::vector<robKinematics*> kinematics;
+  for( size_t i=0; i<7; i++ )
+    { kinematics.push_back( robKinematics::Instantiate( "standard" ) ); }
+  if( WAM7.LoadRobot( kinematics ) != robManipulator::ESUCCESS )
+    { return false; }
+
+  for( size_t i=0; i<7; i++ ){
+    std::istringstream is( parameters[i] );
+    if( WAM7.links[i].Read( is ) != robLink::ESUCCESS )
+      { return false; }
+  }
+
+  return true;
+}
@@ -3,8 +3,12 @@
 #define _robRobotsKinematics_h
 
 #include <cisstVector/vctFrame4x4.h>
+#include <cisstRobot/robManipulator.h>
 
 vctFrame4x4<double> FKineWAM7( size_t i, double t );
 vctFrame4x4<double> FKinePUMA560( size_t i, double t );
 
+//! Load the WAM kinematics with arbitrary (non zero) link masses
+bool LoadWAM7Dynamics( robManipulator& WAM7 );
+
 #endif
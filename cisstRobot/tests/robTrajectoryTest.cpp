@@ -0,0 +1,110 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*-    */
+/* ex: set filetype=cpp softtabstop=2 shiftwidth=2 tabstop=2 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctDynamicMatrixTypes.h>
+#include <cisstRobot/robLSPB.h>
+#include <cisstRobot/robQuintic.h>
+#include "robTrajectoryTest.h"
+
+void robTrajectoryTest::TestLSPBSamples(){
+
+  // joints with a constant velocity phase, with and without motion
+  vctDoubleVec start( 4 ), finish( 4 ), velocity( 4 ), acceleration( 4 );
+  start.Assign( 0.0, 1.0, -0.5, 2.0 );
+  finish.Assign( 1.0, -1.0, -0.45, 2.0 );
+  velocity.Assign( 0.5, 1.0, 2.0, 1.0 );
+  acceleration.Assign( 2.0, 1.0, 1.0, 1.0 );
+
+  for( int c=0; c<2; c++ ){
+
+    robLSPB::CoordinationType coordination
+      = ( c == 0 ) ? robLSPB::LSPB_NONE : robLSPB::LSPB_DURATION;
+    robLSPB lspb( start, finish, velocity, acceleration, 1.0, coordination );
+
+    // unsorted times before, during and after the trajectory
+    const size_t K = 64;
+    vctDoubleVec times( K );
+    for( size_t k=0; k<K; k++ )
+      { times[k] = 0.5 + ( (k*37) % K ) * ( lspb.Duration() + 1.0 ) / K; }
+
+    vctDoubleMat P( K, 4 ), V( K, 4 ), A( K, 4 );
+    lspb.EvaluateTimes( times, P, V, A );
+
+    // column major outputs are filled the same way
+    vctDoubleMat Pc( K, 4, VCT_COL_MAJOR ), Vc( K, 4, VCT_COL_MAJOR ), Ac( K, 4, VCT_COL_MAJOR );
+    lspb.EvaluateTimes( times, Pc, Vc, Ac );
+
+    vctDoubleVec p( 4 ), v( 4 ), a( 4 );
+    for( size_t k=0; k<K; k++ ){
+      lspb.Evaluate( times[k], p, v, a );
+      CPPUNIT_ASSERT( P.Row( k ).AlmostEqual( p, 1e-12 ) );
+      CPPUNIT_ASSERT( V.Row( k ).AlmostEqual( v, 1e-12 ) );
+      CPPUNIT_ASSERT( A.Row( k ).AlmostEqual( a, 1e-12 ) );
+    }
+    CPPUNIT_ASSERT( Pc.AlmostEqual( P, 1e-12 ) );
+    CPPUNIT_ASSERT( Vc.AlmostEqual( V, 1e-12 ) );
+    CPPUNIT_ASSERT( Ac.AlmostEqual( A, 1e-12 ) );
+
+    // fixed period
+    lspb.EvaluatePeriod( 0.5, 0.1, P, V, A );
+    for( size_t k=0; k<K; k++ ){
+      lspb.Evaluate( 0.5 + k*0.1, p, v, a );
+      CPPUNIT_ASSERT( P.Row( k ).AlmostEqual( p, 1e-12 ) );
+      CPPUNIT_ASSERT( V.Row( k ).AlmostEqual( v, 1e-12 ) );
+      CPPUNIT_ASSERT( A.Row( k ).AlmostEqual( a, 1e-12 ) );
+    }
+
+  }
+
+}
+
+void robTrajectoryTest::TestQuinticSamples(){
+
+  vctDynamicVector<double> y1( 3 ), y1d( 3 ), y1dd( 3 );
+  vctDynamicVector<double> y2( 3 ), y2d( 3 ), y2dd( 3 );
+  y1.Assign( 0.0, 1.0, -2.0 );   y2.Assign( 1.0, 0.0, 2.0 );
+  y1d.Assign( 0.1, 0.0, 0.0 );   y2d.Assign( 0.0, -0.2, 0.0 );
+  y1dd.Assign( 0.0, 0.0, 0.5 );  y2dd.Assign( 0.0, 0.0, 0.0 );
+
+  robQuintic quintic( 1.0, y1, y1d, y1dd, 3.0, y2, y2d, y2dd );
+
+  const size_t K = 50;
+  vctDynamicMatrix<double> Y( K, 3 ), Yd( K, 3 ), Ydd( K, 3 );
+  quintic.EvaluatePeriod( 0.5, 0.06, Y, Yd, Ydd );
+
+  vctDynamicVector<double> y( 3 ), yd( 3 ), ydd( 3 );
+  for( size_t k=0; k<K; k++ ){
+    quintic.Evaluate( 0.5 + k*0.06, y, yd, ydd );
+    CPPUNIT_ASSERT( Y.Row( k ).AlmostEqual( y, 1e-9 ) );
+    CPPUNIT_ASSERT( Yd.Row( k ).AlmostEqual( yd, 1e-9 ) );
+    CPPUNIT_ASSERT( Ydd.Row( k ).AlmostEqual( ydd, 1e-9 ) );
+  }
+
+  // the same samples in reverse order
+  vctDynamicVector<double> times( K );
+  for( size_t k=0; k<K; k++ )
+    { times[k] = 0.5 + ( K-1-k )*0.06; }
+  vctDynamicMatrix<double> R( K, 3 ), Rd( K, 3 ), Rdd( K, 3 );
+  quintic.EvaluateTimes( times, R, Rd, Rdd );
+  for( size_t k=0; k<K; k++ ){
+    CPPUNIT_ASSERT( R.Row( k ).AlmostEqual( Y.Row( K-1-k ), 1e-12 ) );
+    CPPUNIT_ASSERT( Rd.Row( k ).AlmostEqual( Yd.Row( K-1-k ), 1e-12 ) );
+    CPPUNIT_ASSERT( Rdd.Row( k ).AlmostEqual( Ydd.Row( K-1-k ), 1e-12 ) );
+  }
+
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION( robTrajectoryTest );
@@ -0,0 +1,36 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*-    */
+/* ex: set filetype=cpp softtabstop=2 shiftwidth=2 tabstop=2 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class robTrajectoryTest : public CppUnit::TestFixture {
+
+private:
+
+  CPPUNIT_TEST_SUITE( robTrajectoryTest );
+
+  CPPUNIT_TEST(TestLSPBSamples);
+  CPPUNIT_TEST(TestQuinticSamples);
+
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void TestLSPBSamples();
+  void TestQuinticSamples();
+
+};
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlBufferSample.h>
+#include <cisstStereoVision/svlSamplePool.h>
 
 
 /*********************************/
@@ -28,35 +29,39 @@ http://www.cisst.org/cisst/license.txt.
 
 svlBufferSample::svlBufferSample(svlStreamType type)
 {
-    Buffer[0] = svlSample::GetNewFromType(type);
-    Buffer[1] = svlSample::GetNewFromType(type);
-    Buffer[2] = svlSample::GetNewFromType(type);
+    // Slots are recycled from the sample pool when the stream is restarted
+    svlSamplePool* pool = svlSamplePool::GetInstance();
+    Buffer[0] = pool->Acquire(type);
+    Buffer[1] = pool->Acquire(type);
+    Buffer[2] = pool->Acquire(type);
 
     Latest = 0;
     Next = 1;
     Locked = 2;
+    Unread = 0;
+    DroppedSamples = 0;
 }
 
 svlBufferSample::svlBufferSample(const svlSample &sample)
 {
-    Buffer[0] = svlSample::GetNewFromType(sample.GetType());
-    Buffer[1] = svlSample::GetNewFromType(sample.GetType());
-    Buffer[2] = svlSample::GetNewFromType(sample.GetType());
-
-    Buffer[0]->SetSize(sample);
-    Buffer[1]->SetSize(sample);
-    Buffer[2]->SetSize(sample);
+    svlSamplePool* pool = svlSamplePool::GetInstance();
+    Buffer[0] = pool->Acquire(&sample);
+    Buffer[1] = pool->Acquire(&sample);
+    Buffer[2] = pool->Acquire(&sample);
 
     Latest = 0;
     Next = 1;
     Locked = 2;
+    Unread = 0;
+    DroppedSamples = 0;
 }
 
 svlBufferSample::~svlBufferSample()
 {
-    delete Buffer[0];
-    delete Buffer[1];
-    delete Buffer[2];
+    svlSamplePool* pool = svlSamplePool::GetInstance();
+    pool->Release(Buffer[0]);
+    pool->Release(Buffer[1]);
+    pool->Release(Buffer[2]);
 }
 
 svlStreamType svlBufferSample::GetType() const
@@ -71,6 +76,7 @@ int svlBufferSample::Push(const svlSample* sample)
     // Atomic exchange of values
 #if (CISST_OS == CISST_WINDOWS)
     Next = InterlockedExchange(&Latest, Next);
+    if (InterlockedExchange(&Unread, 1)) InterlockedIncrement(&DroppedSamples);
 #endif
 
 #if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS)
@@ -78,6 +84,9 @@ int svlBufferSample::Push(const svlSample* sample)
         int ti = Next;
         Next = Latest;
         Latest = ti;
+        // The previous sample has not been pulled
+        if (Unread) DroppedSamples ++;
+        Unread = 1;
     CS.Leave();
 #endif
 
@@ -88,13 +97,21 @@ int svlBufferSample::Push(const svlSample* sample)
 
 svlSample* svlBufferSample::Pull(bool waitfornew, double timeout)
 {
-    if (!waitfornew) return Buffer[Latest];
+    if (!waitfornew) {
+#if (CISST_OS == CISST_WINDOWS)
+        InterlockedExchange(&Unread, 0);
+#else
+        Unread = 0;
+#endif
+        return Buffer[Latest];
+    }
 
     if (!NewSampleEvent.Wait(timeout)) return 0;
 
     // Atomic exchange of values
 #if (CISST_OS == CISST_WINDOWS)
     Locked = InterlockedExchange(&Latest, Locked);
+    InterlockedExchange(&Unread, 0);
 #endif
 
 #if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS)
@@ -102,12 +119,18 @@ svlSample* svlBufferSample::Pull(bool waitfornew, double timeout)
         int ti = Locked;
         Locked = Latest;
         Latest = ti;
+        Unread = 0;
     CS.Leave();
 #endif
 
     return Buffer[Locked];
 }
 
+unsigned int svlBufferSample::GetDroppedSampleCount() const
+{
+    return static_cast<unsigned int>(DroppedSamples);
+}
+
 svlSample* svlBufferSample::GetPushBuffer()
 {
     return Buffer[Next];
@@ -118,6 +141,7 @@ void svlBufferSample::Push()
     // Atomic exchange of values
 #if (CISST_OS == CISST_WINDOWS)
     Next = InterlockedExchange(&Latest, Next);
+    if (InterlockedExchange(&Unread, 1)) InterlockedIncrement(&DroppedSamples);
 #endif
 
 #if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS)
@@ -125,6 +149,9 @@ void svlBufferSample::Push()
         int ti = Next;
         Next = Latest;
         Latest = ti;
+        // The previous sample has not been pulled
+        if (Unread) DroppedSamples ++;
+        Unread = 1;
     CS.Leave();
 #endif
 
@@ -0,0 +1,213 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlCompressionLZ.h"
+#include <cstring>
+
+
+namespace
+{
+    enum {
+        MinMatch     = 4,
+        MaxOffset    = 65535,
+        HashBits     = 12,
+        LastLiterals = 5,   // the last bytes of a block are always literals
+        MatchLimit   = 12   // no match may start closer than this to the end
+    };
+
+    inline unsigned int Read32(const unsigned char* p)
+    {
+        unsigned int value;
+        memcpy(&value, p, 4);
+        return value;
+    }
+
+    inline unsigned int Hash(const unsigned int value)
+    {
+        return (value * 2654435761u) >> (32 - HashBits);
+    }
+
+    // Token nibble and the extra length bytes beyond 15
+    inline unsigned char* WriteLength(unsigned char* output, unsigned int length)
+    {
+        length -= 15;
+        while (length >= 255) {
+            *output = 255; output ++;
+            length -= 255;
+        }
+        *output = static_cast<unsigned char>(length); output ++;
+        return output;
+    }
+
+    inline unsigned char* WriteLiterals(unsigned char* output, unsigned char* token, const unsigned char* literals, const unsigned int length)
+    {
+        if (length >= 15) {
+            *token = 15 << 4;
+            output = WriteLength(output, length);
+        }
+        else {
+            *token = static_cast<unsigned char>(length << 4);
+        }
+        memcpy(output, literals, length);
+        return output + length;
+    }
+
+    // Returns false if the length runs past the end of the input
+    inline bool ReadLength(const unsigned char* &input, const unsigned char* end, unsigned int &length)
+    {
+        unsigned int value;
+        do {
+            if (input >= end) return false;
+            value = *input; input ++;
+            length += value;
+        } while (value == 255);
+        return true;
+    }
+}
+
+
+unsigned int svlCompressionLZ::GetMaxCompressedSize(const unsigned int size)
+{
+    return size + size / 255 + 16;
+}
+
+unsigned int svlCompressionLZ::Compress(const unsigned char* input, const unsigned int inputsize,
+                                        unsigned char* output, const unsigned int outputsize)
+{
+    if (!input || !output || outputsize < GetMaxCompressedSize(inputsize)) return 0;
+
+    const unsigned char* const end = input + inputsize;
+    const unsigned char* anchor = input;
+    unsigned char* out = output;
+
+    if (inputsize > MatchLimit) {
+
+        const unsigned char* const matchstart_limit = end - MatchLimit;
+        const unsigned char* const matchend_limit = end - LastLiterals;
+        unsigned int table[1 << HashBits];
+        const unsigned char* ip = input;
+        const unsigned char* ref;
+        unsigned char* token;
+        unsigned int h, length, offset;
+
+        memset(table, 0, sizeof(table));
+
+        while (ip < matchstart_limit) {
+
+            // Candidate: last position with the same hash
+            h = Hash(Read32(ip));
+            ref = input + table[h];
+            table[h] = static_cast<unsigned int>(ip - input);
+            if (ref >= ip || (ip - ref) > MaxOffset || Read32(ref) != Read32(ip)) {
+                // Skip faster through incompressible data
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            // Extend the match backwards over pending literals, then forward
+            while (ip > anchor && ref > input && ip[-1] == ref[-1]) {
+                ip --; ref --;
+            }
+            length = MinMatch;
+            while (ip + length + 4 <= matchend_limit && Read32(ip + length) == Read32(ref + length)) length += 4;
+            while (ip + length < matchend_limit && ip[length] == ref[length]) length ++;
+
+            // Sequence: literals, offset, match length
+            token = out; out ++;
+            out = WriteLiterals(out, token, anchor, static_cast<unsigned int>(ip - anchor));
+            offset = static_cast<unsigned int>(ip - ref);
+            out[0] = static_cast<unsigned char>(offset);
+            out[1] = static_cast<unsigned char>(offset >> 8);
+            out += 2;
+            if (length - MinMatch >= 15) {
+                *token |= 15;
+                out = WriteLength(out, length - MinMatch);
+            }
+            else {
+                *token |= static_cast<unsigned char>(length - MinMatch);
+            }
+
+            ip += length;
+            anchor = ip;
+
+            // Position inside the match, so that repetitions are found sooner
+            if (ip < matchstart_limit) table[Hash(Read32(ip - 2))] = static_cast<unsigned int>(ip - 2 - input);
+        }
+    }
+
+    // Last literals
+    unsigned char* token = out; out ++;
+    out = WriteLiterals(out, token, anchor, static_cast<unsigned int>(end - anchor));
+
+    return static_cast<unsigned int>(out - output);
+}
+
+int svlCompressionLZ::Decompress(const unsigned char* input, const unsigned int inputsize,
+                                 unsigned char* output, const unsigned int outputsize)
+{
+    if (!input || !output || inputsize == 0) return -1;
+
+    const unsigned char* const end = input + inputsize;
+    unsigned char* const outend = output + outputsize;
+    unsigned char* out = output;
+    const unsigned char* ref;
+    unsigned int token, length, offset;
+
+    while (1) {
+
+        if (input >= end) return -1;
+        token = *input; input ++;
+
+        // Literals
+        length = token >> 4;
+        if (length == 15 && !ReadLength(input, end, length)) return -1;
+        if (length > static_cast<unsigned int>(end - input) ||
+            length > static_cast<unsigned int>(outend - out)) return -1;
+        memcpy(out, input, length);
+        input += length;
+        out += length;
+
+        // The last sequence has no match
+        if (input == end) break;
+
+        // Match
+        if (end - input < 2) return -1;
+        offset = input[0] | (input[1] << 8);
+        input += 2;
+        if (offset == 0 || offset > static_cast<unsigned int>(out - output)) return -1;
+        length = token & 15;
+        if (length == 15 && !ReadLength(input, end, length)) return -1;
+        length += MinMatch;
+        if (length > static_cast<unsigned int>(outend - out)) return -1;
+
+        ref = out - offset;
+        if (offset >= length) {
+            memcpy(out, ref, length);
+            out += length;
+        }
+        else {
+            // Overlapping copy repeats the last 'offset' bytes
+            while (length) {
+                *out = *ref; out ++; ref ++;
+                length --;
+            }
+        }
+    }
+
+    return static_cast<int>(out - output);
+}
+
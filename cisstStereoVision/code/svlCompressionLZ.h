@@ -0,0 +1,44 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlCompressionLZ_h
+#define _svlCompressionLZ_h
+
+
+// Fast LZ77 compression of memory blocks.
+// The compressed data is in the LZ4 block format: sequences of literals
+// and matches of at least 4 bytes within a 64 KB window, found with a
+// single hash table lookup per position.  Compression is several times
+// faster than zlib at its lowest level, at the cost of a lower ratio.
+// Decompression validates all lengths and offsets, so corrupted input
+// fails instead of accessing memory outside the buffers.
+namespace svlCompressionLZ
+{
+    //! Size of the output buffer needed to compress 'size' bytes in the worst case
+    unsigned int GetMaxCompressedSize(const unsigned int size);
+
+    //! Returns the compressed size, or 0 if the output buffer is smaller than GetMaxCompressedSize(inputsize)
+    unsigned int Compress(const unsigned char* input, const unsigned int inputsize,
+                          unsigned char* output, const unsigned int outputsize);
+
+    //! Returns the decompressed size, or -1 if the data is invalid or does not fit in the output buffer
+    int Decompress(const unsigned char* input, const unsigned int inputsize,
+                   unsigned char* output, const unsigned int outputsize);
+}
+
+#endif // _svlCompressionLZ_h
+
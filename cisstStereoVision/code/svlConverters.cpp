@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlConverters.h>
+#include "svlConvertersSIMD.h"
 
 #define ACCURATE_COLOR_TO_GRAYSCALE     false
 
@@ -182,11 +183,27 @@ int Converter(svlStreamType intype, svlStreamType outtype, unsigned char* inputb
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
             return SVL_FAIL;
     }
     return SVL_OK;
 }
 
+bool svlConverter::IsSIMDSupported()
+{
+    return svlConverterSIMD::IsSupported();
+}
+
+bool svlConverter::GetSIMDEnabled()
+{
+    return svlConverterSIMD::IsEnabled();
+}
+
+void svlConverter::SetSIMDEnabled(bool enable)
+{
+    svlConverterSIMD::SetEnabled(enable);
+}
+
 int svlConverter::ConvertSample(const svlSample* input, svlSample* output, unsigned int threads, unsigned int threadid)
 {
     if (!input || !output) return SVL_FAIL;
@@ -304,7 +321,12 @@ void svlConverter::Gray16toRGB24(unsigned short* input, unsigned char* output, c
 {
     unsigned short shval;
     unsigned char chval;
-    for (unsigned int i = 0; i < pixelcount; i ++) {
+
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    const unsigned int done = svlConverterSIMD::Gray16toRGB24(input, output, pixelcount, shiftdown);
+    input += done; output += done * 3;
+
+    for (unsigned int i = done; i < pixelcount; i ++) {
         shval = (*input) >> shiftdown; input ++;
         if (shval < 256) chval = static_cast<unsigned char>(shval);
         else chval = 255;
@@ -333,7 +355,12 @@ void svlConverter::Gray16toGray8(unsigned short* input, unsigned char* output, c
 {
     unsigned short shval;
     unsigned char chval;
-    for (unsigned int i = 0; i < pixelcount; i ++) {
+
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    const unsigned int done = svlConverterSIMD::Gray16toGray8(input, output, pixelcount, shiftdown);
+    input += done; output += done;
+
+    for (unsigned int i = done; i < pixelcount; i ++) {
         shval = (*input) >> shiftdown;
         if (shval < 256) chval = static_cast<unsigned char>(shval);
         else chval = 255;
@@ -523,8 +550,13 @@ void svlConverter::float32toRGB24(float* input, unsigned char* output, const uns
     int ival;
     unsigned int i;
     float shadingratio = static_cast<float>(256.0 * scalingratio);
+
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    const unsigned int done = svlConverterSIMD::float32toRGB24(input, output, pixelcount, scalingratio, elementstride);
+    input += done * elementstride; output += done * 3;
+
     if (scalingratio == 1.0f) {
-        for (i = 0; i < pixelcount; i ++) {
+        for (i = done; i < pixelcount; i ++) {
             ival = static_cast<int>(*input); input += elementstride;
             if (ival > 255) ival = 255;
             else if (ival < 0) ival = 0;
@@ -534,7 +566,7 @@ void svlConverter::float32toRGB24(float* input, unsigned char* output, const uns
         }
     }
     else {
-        for (i = 0; i < pixelcount; i ++) {
+        for (i = done; i < pixelcount; i ++) {
             ival = static_cast<int>(*input * shadingratio) >> 8; input += elementstride;
             if (ival > 255) ival = 255;
             else if (ival < 0) ival = 0;
@@ -579,8 +611,13 @@ void svlConverter::float32toGray8(float* input, unsigned char* output, const uns
     int ival;
     unsigned int i;
     float shadingratio = static_cast<float>(256.0 * scalingratio);
+
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    const unsigned int done = svlConverterSIMD::float32toGray8(input, output, pixelcount, scalingratio, elementstride);
+    input += done * elementstride; output += done;
+
     if (scalingratio == 1.0f) {
-        for (i = 0; i < pixelcount; i ++) {
+        for (i = done; i < pixelcount; i ++) {
             ival = static_cast<int>(*input); input += elementstride;
             if (ival > 0xFF) ival = 0xFF;
             else if (ival < 0) ival = 0;
@@ -588,7 +625,7 @@ void svlConverter::float32toGray8(float* input, unsigned char* output, const uns
         }
     }
     else {
-        for (i = 0; i < pixelcount; i ++) {
+        for (i = done; i < pixelcount; i ++) {
             ival = static_cast<int>(*input * shadingratio) >> 8; input += elementstride;
             if (ival > 0xFF) ival = 0xFF;
             else if (ival < 0) ival = 0;
@@ -671,9 +708,14 @@ void svlConverter::RGB24toRGBA32(unsigned char* input, unsigned char* output, co
 void svlConverter::RGB24toGray8(unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool accurate, bool bgr)
 {
     unsigned int i, sum;
+
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    const unsigned int done = svlConverterSIMD::RGB24toGray8(input, output, pixelcount, accurate, bgr);
+    input += done * 3; output += done;
+
     if (accurate) {
         if (bgr) {
-            for (i = 0; i < pixelcount; i ++) {
+            for (i = done; i < pixelcount; i ++) {
                 sum  = 28  * (*input); input ++;
                 sum += 150 * (*input); input ++;
                 sum += 77  * (*input); input ++;
@@ -681,7 +723,7 @@ void svlConverter::RGB24toGray8(unsigned char* input, unsigned char* output, con
             }
         }
         else {
-            for (i = 0; i < pixelcount; i ++) {
+            for (i = done; i < pixelcount; i ++) {
                 sum  = 77  * (*input); input ++;
                 sum += 150 * (*input); input ++;
                 sum += 28  * (*input); input ++;
@@ -690,7 +732,7 @@ void svlConverter::RGB24toGray8(unsigned char* input, unsigned char* output, con
         }
     }
     else {
-        for (i = 0; i < pixelcount; i ++) {
+        for (i = done; i < pixelcount; i ++) {
             sum  = *input; input ++;
             sum += *input; input ++;
             sum += *input; input ++;
@@ -829,7 +871,12 @@ void svlConverter::BGR24toYUV422(unsigned char* input, unsigned char* output, co
     int r, g, b, y1, y2, u1, u2, v1, v2;
     const unsigned int pixelcounthalf = pixelcount >> 1;
 
-    for (unsigned int i = 0; i < pixelcounthalf; i ++) {
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    unsigned int done = 0;
+    if (ch1 && ch2 && ch3) done = svlConverterSIMD::RGB24toYUV422(input, output, pixelcount, true);
+    input += done * 3; output += done * 2;
+
+    for (unsigned int i = done >> 1; i < pixelcounthalf; i ++) {
         b = *input; input ++;
         g = *input; input ++;
         r = *input; input ++;
@@ -880,7 +927,12 @@ void svlConverter::RGB24toYUV422(unsigned char* input, unsigned char* output, co
     int r, g, b, y1, y2, u1, u2, v1, v2;
     const unsigned int pixelcounthalf = pixelcount >> 1;
 
-    for (unsigned int i = 0; i < pixelcounthalf; i ++) {
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    unsigned int done = 0;
+    if (ch1 && ch2 && ch3) done = svlConverterSIMD::RGB24toYUV422(input, output, pixelcount, false);
+    input += done * 3; output += done * 2;
+
+    for (unsigned int i = done >> 1; i < pixelcounthalf; i ++) {
         r = *input; input ++;
         g = *input; input ++;
         b = *input; input ++;
@@ -1176,9 +1228,14 @@ void svlConverter::RGBA32toRGB24(unsigned char* input, unsigned char* output, co
 void svlConverter::RGBA32toGray8(unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool accurate, bool bgr)
 {
     unsigned int i, sum;
+
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    const unsigned int done = svlConverterSIMD::RGBA32toGray8(input, output, pixelcount, accurate, bgr);
+    input += done * 4; output += done;
+
     if (accurate) {
         if (bgr) {
-            for (i = 0; i < pixelcount; i ++) {
+            for (i = done; i < pixelcount; i ++) {
                 sum  = 28  * (*input); input ++;
                 sum += 150 * (*input); input ++;
                 sum += 77  * (*input); input += 2;
@@ -1186,7 +1243,7 @@ void svlConverter::RGBA32toGray8(unsigned char* input, unsigned char* output, co
             }
         }
         else {
-            for (i = 0; i < pixelcount; i ++) {
+            for (i = done; i < pixelcount; i ++) {
                 sum  = 77  * (*input); input ++;
                 sum += 150 * (*input); input ++;
                 sum += 28  * (*input); input += 2;
@@ -1195,7 +1252,7 @@ void svlConverter::RGBA32toGray8(unsigned char* input, unsigned char* output, co
         }
     }
     else {
-        for (i = 0; i < pixelcount; i ++) {
+        for (i = done; i < pixelcount; i ++) {
             sum  = *input; input ++;
             sum += *input; input ++;
             sum += *input; input += 2;
@@ -1337,6 +1394,11 @@ void svlConverter::YUV422toRGB24(unsigned char* input, unsigned char* output, co
     unsigned char *y1, *y2, *u, *v, *r1, *g1, *b1, *r2, *g2, *b2;
     int ty1, ty2, tv1, tv2, tu1, tu2, res;
 
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    unsigned int done = 0;
+    if (ch1 && ch2 && ch3) done = svlConverterSIMD::YUV422toRGB24(input, output, pixelcount, false);
+    input += done * 2; output += done * 3;
+
     y1 = input;
     u  = y1 + 1;
     y2 = u  + 1;
@@ -1349,7 +1411,7 @@ void svlConverter::YUV422toRGB24(unsigned char* input, unsigned char* output, co
     g2 = b2 + 1;
     r2 = g2 + 1;
 
-    for (unsigned int i = 0; i < pixelcounthalf; i ++) {
+    for (unsigned int i = done >> 1; i < pixelcounthalf; i ++) {
         tu1 = *u;
         tu1 -= 128;
 
@@ -1598,6 +1660,11 @@ void svlConverter::UYVYtoRGB24(unsigned char* input, unsigned char* output, cons
     unsigned char *y1, *y2, *u, *v, *r1, *g1, *b1, *r2, *g2, *b2;
     int ty1, ty2, tv1, tv2, tu1, tu2, res;
 
+    // Vectorized conversion of the bulk of the buffer, the rest is converted below
+    unsigned int done = 0;
+    if (ch1 && ch2 && ch3) done = svlConverterSIMD::YUV422toRGB24(input, output, pixelcount, true);
+    input += done * 2; output += done * 3;
+
     u  = input;
     y1 = u  + 1;
     v  = y1 + 1;
@@ -1610,7 +1677,7 @@ void svlConverter::UYVYtoRGB24(unsigned char* input, unsigned char* output, cons
     g2 = b2 + 1;
     r2 = g2 + 1;
 
-    for (unsigned int i = 0; i < pixelcounthalf; i ++) {
+    for (unsigned int i = done >> 1; i < pixelcounthalf; i ++) {
         tu1 = *u;
         tu1 -= 128;
 
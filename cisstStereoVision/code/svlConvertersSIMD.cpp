@@ -0,0 +1,447 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlConvertersSIMD.h"
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+static bool SIMDEnabled = true;
+
+bool svlConverterSIMD::IsSupported()
+{
+#ifdef SVL_CONVERTER_HAS_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool svlConverterSIMD::IsEnabled()
+{
+    return SIMDEnabled && IsSupported();
+}
+
+void svlConverterSIMD::SetEnabled(bool enable)
+{
+    SIMDEnabled = enable;
+}
+
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+
+/**************************/
+/*** SSE2 helpers *********/
+/**************************/
+
+// Pair of 16 bit coefficients for _mm_madd_epi16: 'a' multiplies the
+// even (low) lanes, 'b' the odd (high) lanes
+static inline __m128i CoeffPair(int a, int b)
+{
+    return _mm_set1_epi32(static_cast<int>((static_cast<unsigned int>(static_cast<unsigned short>(b)) << 16) |
+                                           static_cast<unsigned short>(a)));
+}
+
+// Splits 16 interleaved 3-byte pixels into 3 planes
+static inline void Deinterleave3(const unsigned char* input, __m128i& c0, __m128i& c1, __m128i& c2)
+{
+    const __m128i t00 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    const __m128i t01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16));
+    const __m128i t02 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 32));
+
+    const __m128i t10 = _mm_unpacklo_epi8(t00, _mm_unpackhi_epi64(t01, t01));
+    const __m128i t11 = _mm_unpacklo_epi8(_mm_unpackhi_epi64(t00, t00), t02);
+    const __m128i t12 = _mm_unpacklo_epi8(t01, _mm_unpackhi_epi64(t02, t02));
+
+    const __m128i t20 = _mm_unpacklo_epi8(t10, _mm_unpackhi_epi64(t11, t11));
+    const __m128i t21 = _mm_unpacklo_epi8(_mm_unpackhi_epi64(t10, t10), t12);
+    const __m128i t22 = _mm_unpacklo_epi8(t11, _mm_unpackhi_epi64(t12, t12));
+
+    const __m128i t30 = _mm_unpacklo_epi8(t20, _mm_unpackhi_epi64(t21, t21));
+    const __m128i t31 = _mm_unpacklo_epi8(_mm_unpackhi_epi64(t20, t20), t22);
+    const __m128i t32 = _mm_unpacklo_epi8(t21, _mm_unpackhi_epi64(t22, t22));
+
+    c0 = _mm_unpacklo_epi8(t30, _mm_unpackhi_epi64(t31, t31));
+    c1 = _mm_unpacklo_epi8(_mm_unpackhi_epi64(t30, t30), t32);
+    c2 = _mm_unpacklo_epi8(t31, _mm_unpackhi_epi64(t32, t32));
+}
+
+// Merges 3 planes of 16 bytes into 16 interleaved 3-byte pixels
+static inline void Interleave3(unsigned char* output, const __m128i& c0, const __m128i& c1, const __m128i& c2)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    // 4-byte pixels: c0 c1 c2 0
+    const __m128i c01l = _mm_unpacklo_epi8(c0, c1);
+    const __m128i c01h = _mm_unpackhi_epi8(c0, c1);
+    const __m128i c2zl = _mm_unpacklo_epi8(c2, zero);
+    const __m128i c2zh = _mm_unpackhi_epi8(c2, zero);
+    __m128i p0 = _mm_unpacklo_epi16(c01l, c2zl);
+    __m128i p1 = _mm_unpackhi_epi16(c01l, c2zl);
+    __m128i p2 = _mm_unpacklo_epi16(c01h, c2zh);
+    __m128i p3 = _mm_unpackhi_epi16(c01h, c2zh);
+
+    // Remove the 4th byte of each pixel within each 64 bit half:
+    // [a0 a1 a2 0 b0 b1 b2 0] -> [a0 a1 a2 b0 b1 b2 0 0]
+    const __m128i lo24 = _mm_set1_epi64x(0x0000000000FFFFFFLL);
+    const __m128i hi24 = _mm_set1_epi64x(0x00FFFFFF00000000LL);
+    p0 = _mm_or_si128(_mm_and_si128(p0, lo24), _mm_srli_epi64(_mm_and_si128(p0, hi24), 8));
+    p1 = _mm_or_si128(_mm_and_si128(p1, lo24), _mm_srli_epi64(_mm_and_si128(p1, hi24), 8));
+    p2 = _mm_or_si128(_mm_and_si128(p2, lo24), _mm_srli_epi64(_mm_and_si128(p2, hi24), 8));
+    p3 = _mm_or_si128(_mm_and_si128(p3, lo24), _mm_srli_epi64(_mm_and_si128(p3, hi24), 8));
+
+    // Each register now holds 2 x 6 valid bytes: [6 bytes, 0, 0, 6 bytes, 0, 0]
+    // Compact them to 12 bytes: [6 bytes, 6 bytes, 0, 0, 0, 0]
+    const __m128i lo48 = _mm_set_epi32(0, 0, 0x0000FFFF, static_cast<int>(0xFFFFFFFF));
+    p0 = _mm_or_si128(_mm_and_si128(p0, lo48), _mm_srli_si128(_mm_andnot_si128(lo48, p0), 2));
+    p1 = _mm_or_si128(_mm_and_si128(p1, lo48), _mm_srli_si128(_mm_andnot_si128(lo48, p1), 2));
+    p2 = _mm_or_si128(_mm_and_si128(p2, lo48), _mm_srli_si128(_mm_andnot_si128(lo48, p2), 2));
+    p3 = _mm_or_si128(_mm_and_si128(p3, lo48), _mm_srli_si128(_mm_andnot_si128(lo48, p3), 2));
+
+    // Concatenate 4 x 12 bytes into 3 x 16 bytes
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),      _mm_or_si128(p0, _mm_slli_si128(p1, 12)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_or_si128(_mm_srli_si128(p1, 4), _mm_slli_si128(p2, 8)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 32), _mm_or_si128(_mm_srli_si128(p2, 8), _mm_slli_si128(p3, 4)));
+}
+
+// Weighted or plain average of 8 pixels given as 16 bit planes, as computed by the scalar code
+static inline __m128i GrayFromChannels(const __m128i& c0, const __m128i& c1, const __m128i& c2,
+                                       bool accurate, const __m128i& w0, const __m128i& w1, const __m128i& w2)
+{
+    if (accurate) {
+        // At most 255 * 255, no overflow in 16 bit unsigned arithmetic
+        __m128i sum = _mm_mullo_epi16(c0, w0);
+        sum = _mm_add_epi16(sum, _mm_mullo_epi16(c1, w1));
+        sum = _mm_add_epi16(sum, _mm_mullo_epi16(c2, w2));
+        return _mm_srli_epi16(sum, 8);
+    }
+    // (sum * 21846) >> 16 equals sum / 3 for sum <= 765
+    const __m128i sum = _mm_add_epi16(_mm_add_epi16(c0, c1), c2);
+    return _mm_mulhi_epu16(sum, _mm_set1_epi16(21846));
+}
+
+// min(value, 255) for unsigned 16 bit values
+static inline __m128i SaturateTo8(const __m128i& value)
+{
+    return _mm_sub_epi16(value, _mm_subs_epu16(value, _mm_set1_epi16(255)));
+}
+
+// Conversion of 16 float values to bytes, as computed by the scalar code
+static inline __m128i FloatsToBytes(const float* input, const int stride, const bool scale, const __m128 ratio)
+{
+    __m128i ival[4];
+    __m128 fval;
+
+    for (int k = 0; k < 4; k ++) {
+        if (stride == 1) {
+            fval = _mm_loadu_ps(input);
+        }
+        else {
+            fval = _mm_set_ps(input[3 * stride], input[2 * stride], input[stride], input[0]);
+        }
+        input += 4 * stride;
+
+        if (scale) ival[k] = _mm_srai_epi32(_mm_cvttps_epi32(_mm_mul_ps(fval, ratio)), 8);
+        else ival[k] = _mm_cvttps_epi32(fval);
+    }
+
+    return _mm_packus_epi16(_mm_packs_epi32(ival[0], ival[1]), _mm_packs_epi32(ival[2], ival[3]));
+}
+
+
+/**************************/
+/*** SSE2 kernels *********/
+/**************************/
+
+unsigned int svlConverterSIMD::RGB24toGray8(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool accurate, bool bgr)
+{
+    if (!SIMDEnabled) return 0;
+
+    const unsigned int count = pixelcount & ~15u;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i w0 = _mm_set1_epi16(bgr ? 28 : 77);
+    const __m128i w1 = _mm_set1_epi16(150);
+    const __m128i w2 = _mm_set1_epi16(bgr ? 77 : 28);
+    __m128i c0, c1, c2, lo, hi;
+
+    for (unsigned int i = 0; i < count; i += 16) {
+        Deinterleave3(input, c0, c1, c2);
+        lo = GrayFromChannels(_mm_unpacklo_epi8(c0, zero), _mm_unpacklo_epi8(c1, zero), _mm_unpacklo_epi8(c2, zero),
+                              accurate, w0, w1, w2);
+        hi = GrayFromChannels(_mm_unpackhi_epi8(c0, zero), _mm_unpackhi_epi8(c1, zero), _mm_unpackhi_epi8(c2, zero),
+                              accurate, w0, w1, w2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(lo, hi));
+        input += 48;
+        output += 16;
+    }
+
+    return count;
+}
+
+unsigned int svlConverterSIMD::RGBA32toGray8(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool accurate, bool bgr)
+{
+    if (!SIMDEnabled) return 0;
+
+    const unsigned int count = pixelcount & ~15u;
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i w0 = _mm_set1_epi16(bgr ? 28 : 77);
+    const __m128i w1 = _mm_set1_epi16(150);
+    const __m128i w2 = _mm_set1_epi16(bgr ? 77 : 28);
+    __m128i px[4], c0, c1, c2, gray[2];
+
+    for (unsigned int i = 0; i < count; i += 16) {
+        for (int k = 0; k < 4; k ++) {
+            px[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16 * k));
+        }
+        for (int k = 0; k < 2; k ++) {
+            const __m128i& a = px[2 * k];
+            const __m128i& b = px[2 * k + 1];
+            c0 = _mm_packs_epi32(_mm_and_si128(a, mask),                     _mm_and_si128(b, mask));
+            c1 = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(a, 8), mask),  _mm_and_si128(_mm_srli_epi32(b, 8), mask));
+            c2 = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(a, 16), mask), _mm_and_si128(_mm_srli_epi32(b, 16), mask));
+            gray[k] = GrayFromChannels(c0, c1, c2, accurate, w0, w1, w2);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(gray[0], gray[1]));
+        input += 64;
+        output += 16;
+    }
+
+    return count;
+}
+
+unsigned int svlConverterSIMD::Gray16toGray8(const unsigned short* input, unsigned char* output, const unsigned int pixelcount, const unsigned int shiftdown)
+{
+    if (!SIMDEnabled) return 0;
+
+    const unsigned int count = pixelcount & ~15u;
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(shiftdown));
+    __m128i lo, hi;
+
+    for (unsigned int i = 0; i < count; i += 16) {
+        lo = _mm_srl_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), shift);
+        hi = _mm_srl_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 8)), shift);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(SaturateTo8(lo), SaturateTo8(hi)));
+        input += 16;
+        output += 16;
+    }
+
+    return count;
+}
+
+unsigned int svlConverterSIMD::Gray16toRGB24(const unsigned short* input, unsigned char* output, const unsigned int pixelcount, const unsigned int shiftdown)
+{
+    if (!SIMDEnabled) return 0;
+
+    const unsigned int count = pixelcount & ~15u;
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(shiftdown));
+    __m128i lo, hi, gray;
+
+    for (unsigned int i = 0; i < count; i += 16) {
+        lo = _mm_srl_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), shift);
+        hi = _mm_srl_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 8)), shift);
+        gray = _mm_packus_epi16(SaturateTo8(lo), SaturateTo8(hi));
+        Interleave3(output, gray, gray, gray);
+        input += 16;
+        output += 48;
+    }
+
+    return count;
+}
+
+unsigned int svlConverterSIMD::float32toGray8(const float* input, unsigned char* output, const unsigned int pixelcount, const float scalingratio, const int elementstride)
+{
+    if (!SIMDEnabled || elementstride < 1) return 0;
+
+    const unsigned int count = pixelcount & ~15u;
+    const bool scale = (scalingratio != 1.0f);
+    const __m128 ratio = _mm_set1_ps(static_cast<float>(256.0 * scalingratio));
+
+    for (unsigned int i = 0; i < count; i += 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), FloatsToBytes(input, elementstride, scale, ratio));
+        input += 16 * elementstride;
+        output += 16;
+    }
+
+    return count;
+}
+
+unsigned int svlConverterSIMD::float32toRGB24(const float* input, unsigned char* output, const unsigned int pixelcount, const float scalingratio, const int elementstride)
+{
+    if (!SIMDEnabled || elementstride < 1) return 0;
+
+    const unsigned int count = pixelcount & ~15u;
+    const bool scale = (scalingratio != 1.0f);
+    const __m128 ratio = _mm_set1_ps(static_cast<float>(256.0 * scalingratio));
+    __m128i gray;
+
+    for (unsigned int i = 0; i < count; i += 16) {
+        gray = FloatsToBytes(input, elementstride, scale, ratio);
+        Interleave3(output, gray, gray, gray);
+        input += 16 * elementstride;
+        output += 48;
+    }
+
+    return count;
+}
+
+unsigned int svlConverterSIMD::RGB24toYUV422(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool bgr)
+{
+    if (!SIMDEnabled) return 0;
+
+    const unsigned int count = pixelcount & ~15u;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low16 = _mm_set1_epi32(0xFFFF);
+    const __m128i y_rg = CoeffPair(2104, 4130), y_b = CoeffPair(802, 0);
+    const __m128i u_rg = CoeffPair(-1214, -2384), u_b = CoeffPair(3598, 0);
+    const __m128i v_rg = CoeffPair(3598, -3013), v_b = CoeffPair(-585, 0);
+    const __m128i y_offset = _mm_set1_epi32(4096 + 131072);
+    const __m128i uv_offset = _mm_set1_epi32(4096 + 1048576);
+    const __m128i y_max = _mm_set1_epi16(235);
+    const __m128i uv_max = _mm_set1_epi16(240);
+    __m128i c0, c1, c2, r8, g8, b8, y16[2], u16[2], v16[2], uavg[2], vavg[2], rg, bz, t0, t1, y8, uv8;
+
+    for (unsigned int i = 0; i < count; i += 16) {
+        Deinterleave3(input, c0, c1, c2);
+        if (bgr) { r8 = c2; b8 = c0; }
+        else     { r8 = c0; b8 = c2; }
+        g8 = c1;
+
+        for (int k = 0; k < 2; k ++) {
+            const __m128i r = k ? _mm_unpackhi_epi8(r8, zero) : _mm_unpacklo_epi8(r8, zero);
+            const __m128i g = k ? _mm_unpackhi_epi8(g8, zero) : _mm_unpacklo_epi8(g8, zero);
+            const __m128i b = k ? _mm_unpackhi_epi8(b8, zero) : _mm_unpacklo_epi8(b8, zero);
+
+            // All sums are positive, so the scalar code's sign correction is not needed
+            rg = _mm_unpacklo_epi16(r, g); bz = _mm_unpacklo_epi16(b, zero);
+            t0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, y_rg), _mm_madd_epi16(bz, y_b)), y_offset), 13);
+            rg = _mm_unpackhi_epi16(r, g); bz = _mm_unpackhi_epi16(b, zero);
+            t1 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, y_rg), _mm_madd_epi16(bz, y_b)), y_offset), 13);
+            y16[k] = _mm_min_epi16(_mm_packs_epi32(t0, t1), y_max);
+
+            rg = _mm_unpacklo_epi16(r, g); bz = _mm_unpacklo_epi16(b, zero);
+            t0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, u_rg), _mm_madd_epi16(bz, u_b)), uv_offset), 13);
+            rg = _mm_unpackhi_epi16(r, g); bz = _mm_unpackhi_epi16(b, zero);
+            t1 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, u_rg), _mm_madd_epi16(bz, u_b)), uv_offset), 13);
+            u16[k] = _mm_min_epi16(_mm_packs_epi32(t0, t1), uv_max);
+
+            rg = _mm_unpacklo_epi16(r, g); bz = _mm_unpacklo_epi16(b, zero);
+            t0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, v_rg), _mm_madd_epi16(bz, v_b)), uv_offset), 13);
+            rg = _mm_unpackhi_epi16(r, g); bz = _mm_unpackhi_epi16(b, zero);
+            t1 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, v_rg), _mm_madd_epi16(bz, v_b)), uv_offset), 13);
+            v16[k] = _mm_min_epi16(_mm_packs_epi32(t0, t1), uv_max);
+
+            // Chroma averaged over pixel pairs
+            uavg[k] = _mm_srli_epi32(_mm_add_epi32(_mm_and_si128(u16[k], low16), _mm_srli_epi32(u16[k], 16)), 1);
+            vavg[k] = _mm_srli_epi32(_mm_add_epi32(_mm_and_si128(v16[k], low16), _mm_srli_epi32(v16[k], 16)), 1);
+        }
+
+        y8 = _mm_packus_epi16(y16[0], y16[1]);
+        uv8 = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_packs_epi32(uavg[0], uavg[1]), zero),
+                                _mm_packus_epi16(_mm_packs_epi32(vavg[0], vavg[1]), zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output),      _mm_unpacklo_epi8(y8, uv8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi8(y8, uv8));
+        input += 48;
+        output += 32;
+    }
+
+    return count;
+}
+
+unsigned int svlConverterSIMD::YUV422toRGB24(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool uyvy)
+{
+    if (!SIMDEnabled) return 0;
+
+    const unsigned int count = pixelcount & ~15u;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low8 = _mm_set1_epi16(0xFF);
+    const __m128i low16 = _mm_set1_epi32(0xFFFF);
+    const __m128i y_offset = _mm_set1_epi16(16);
+    const __m128i uv_offset = _mm_set1_epi16(128);
+    const __m128i b_yu = CoeffPair(298, 517);
+    const __m128i g_yu = CoeffPair(298, 100), g_v = CoeffPair(-208, 0);
+    const __m128i r_yv = CoeffPair(298, 409);
+    __m128i packed, y, uv, u, v, yu, yv, vz, t0, t1, b16[2], g16[2], r16[2];
+
+    for (unsigned int i = 0; i < count; i += 16) {
+        for (int k = 0; k < 2; k ++) {
+            packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16 * k));
+            if (uyvy) {
+                y  = _mm_srli_epi16(packed, 8);
+                uv = _mm_and_si128(packed, low8);
+            }
+            else {
+                y  = _mm_and_si128(packed, low8);
+                uv = _mm_srli_epi16(packed, 8);
+            }
+
+            // Chroma of each pixel pair duplicated for both pixels
+            u = _mm_and_si128(uv, low16);
+            u = _mm_or_si128(u, _mm_slli_epi32(u, 16));
+            v = _mm_srli_epi32(uv, 16);
+            v = _mm_or_si128(v, _mm_slli_epi32(v, 16));
+
+            y = _mm_sub_epi16(y, y_offset);
+            u = _mm_sub_epi16(u, uv_offset);
+            v = _mm_sub_epi16(v, uv_offset);
+
+            yu = _mm_unpacklo_epi16(y, u);
+            t0 = _mm_srai_epi32(_mm_madd_epi16(yu, b_yu), 8);
+            yu = _mm_unpackhi_epi16(y, u);
+            t1 = _mm_srai_epi32(_mm_madd_epi16(yu, b_yu), 8);
+            b16[k] = _mm_packs_epi32(t0, t1);
+
+            yu = _mm_unpacklo_epi16(y, u); vz = _mm_unpacklo_epi16(v, zero);
+            t0 = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu, g_yu), _mm_madd_epi16(vz, g_v)), 8);
+            yu = _mm_unpackhi_epi16(y, u); vz = _mm_unpackhi_epi16(v, zero);
+            t1 = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yu, g_yu), _mm_madd_epi16(vz, g_v)), 8);
+            g16[k] = _mm_packs_epi32(t0, t1);
+
+            yv = _mm_unpacklo_epi16(y, v);
+            t0 = _mm_srai_epi32(_mm_madd_epi16(yv, r_yv), 8);
+            yv = _mm_unpackhi_epi16(y, v);
+            t1 = _mm_srai_epi32(_mm_madd_epi16(yv, r_yv), 8);
+            r16[k] = _mm_packs_epi32(t0, t1);
+        }
+
+        // Saturation to [0, 255] as in the scalar code; the scalar code writes BGR
+        Interleave3(output,
+                    _mm_packus_epi16(b16[0], b16[1]),
+                    _mm_packus_epi16(g16[0], g16[1]),
+                    _mm_packus_epi16(r16[0], r16[1]));
+        input += 32;
+        output += 48;
+    }
+
+    return count;
+}
+
+
+#else // SVL_CONVERTER_HAS_SSE2
+
+unsigned int svlConverterSIMD::RGB24toGray8(const unsigned char*, unsigned char*, const unsigned int, bool, bool) { return 0; }
+unsigned int svlConverterSIMD::RGBA32toGray8(const unsigned char*, unsigned char*, const unsigned int, bool, bool) { return 0; }
+unsigned int svlConverterSIMD::Gray16toGray8(const unsigned short*, unsigned char*, const unsigned int, const unsigned int) { return 0; }
+unsigned int svlConverterSIMD::Gray16toRGB24(const unsigned short*, unsigned char*, const unsigned int, const unsigned int) { return 0; }
+unsigned int svlConverterSIMD::float32toGray8(const float*, unsigned char*, const unsigned int, const float, const int) { return 0; }
+unsigned int svlConverterSIMD::float32toRGB24(const float*, unsigned char*, const unsigned int, const float, const int) { return 0; }
+unsigned int svlConverterSIMD::RGB24toYUV422(const unsigned char*, unsigned char*, const unsigned int, bool) { return 0; }
+unsigned int svlConverterSIMD::YUV422toRGB24(const unsigned char*, unsigned char*, const unsigned int, bool) { return 0; }
+
+#endif // SVL_CONVERTER_HAS_SSE2
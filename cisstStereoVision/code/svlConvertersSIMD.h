@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlConvertersSIMD_h
+#define _svlConvertersSIMD_h
+
+#include <cisstStereoVision/svlConfig.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define SVL_CONVERTER_HAS_SSE2
+#endif
+
+
+// Vectorized kernels of svlConverter.
+// Each kernel converts the largest part of the buffer it can handle and
+// returns the number of pixels converted; the caller converts the rest
+// with the scalar code.  Kernels return 0 if SIMD is not available or
+// has been disabled.  Results are bit-exact with the scalar code.
+namespace svlConverterSIMD
+{
+    bool IsSupported();
+    bool IsEnabled();
+    void SetEnabled(bool enable);
+
+    unsigned int RGB24toGray8(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool accurate, bool bgr);
+    unsigned int RGBA32toGray8(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool accurate, bool bgr);
+    unsigned int Gray16toGray8(const unsigned short* input, unsigned char* output, const unsigned int pixelcount, const unsigned int shiftdown);
+    unsigned int Gray16toRGB24(const unsigned short* input, unsigned char* output, const unsigned int pixelcount, const unsigned int shiftdown);
+    unsigned int float32toGray8(const float* input, unsigned char* output, const unsigned int pixelcount, const float scalingratio, const int elementstride);
+    unsigned int float32toRGB24(const float* input, unsigned char* output, const unsigned int pixelcount, const float scalingratio, const int elementstride);
+    unsigned int RGB24toYUV422(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool bgr);
+    unsigned int YUV422toRGB24(const unsigned char* input, unsigned char* output, const unsigned int pixelcount, bool uyvy);
+}
+
+#endif // _svlConvertersSIMD_h
@@ -0,0 +1,446 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlConvolutionSIMD.h"
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+static bool SIMDEnabled = true;
+
+bool svlConvolutionSIMD::IsSupported()
+{
+#ifdef SVL_CONVERTER_HAS_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool svlConvolutionSIMD::IsEnabled()
+{
+    return SIMDEnabled && IsSupported();
+}
+
+void svlConvolutionSIMD::SetEnabled(bool enable)
+{
+    SIMDEnabled = enable;
+}
+
+bool svlConvolutionSIMD::IsKernelSupported(const int* kernel, const unsigned int kernelsize)
+{
+    // Coefficients are multiplied as signed 16 bit values and the
+    // sums of products have to fit in 32 bits
+    if (!kernel || kernelsize < 1 || kernelsize > MaxKernelSize) return false;
+    for (unsigned int k = 0; k < kernelsize; k ++) {
+        if (kernel[k] < -32767 || kernel[k] > 32767) return false;
+    }
+    return true;
+}
+
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+
+/**************************/
+/*** SSE2 helpers *********/
+/**************************/
+
+// Pair of 16 bit coefficients for _mm_madd_epi16: 'a' multiplies the
+// even (low) lanes, 'b' the odd (high) lanes
+static inline int CoeffPair(int a, int b)
+{
+    return static_cast<int>((static_cast<unsigned int>(static_cast<unsigned short>(b)) << 16) |
+                            static_cast<unsigned short>(a));
+}
+
+// Loads 16 elements of tap 'p' widened to 16 bits; with a symmetric
+// kernel tap 'p' stands for the sum of the taps p and kernelsize-1-p
+static inline void LoadTap(const unsigned char* const* taps, const unsigned int p, const unsigned int kernelsize,
+                           bool symmetric, const unsigned int i, __m128i& lo, __m128i& hi)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(taps[p] + i));
+    lo = _mm_unpacklo_epi8(v, zero);
+    hi = _mm_unpackhi_epi8(v, zero);
+    if (symmetric && p != kernelsize - 1 - p) {
+        v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(taps[kernelsize - 1 - p] + i));
+        lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+        hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+    }
+}
+
+// Fixed point shift and optional absolute value of 4 sums
+static inline __m128i Finish(__m128i sum, bool absres)
+{
+    sum = _mm_srai_epi32(sum, 10);
+    if (absres) {
+        const __m128i sign = _mm_srai_epi32(sum, 31);
+        sum = _mm_sub_epi32(_mm_xor_si128(sum, sign), sign);
+    }
+    return sum;
+}
+
+// Saturates 16 sums to [0, 255] and stores them
+static inline void Store16(unsigned char* output, __m128i s0, __m128i s1, __m128i s2, __m128i s3)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     _mm_packus_epi16(_mm_packs_epi32(s0, s1), _mm_packs_epi32(s2, s3)));
+}
+
+
+/**************************/
+/*** Kernels **************/
+/**************************/
+
+unsigned int svlConvolutionSIMD::Filter(const unsigned char* const* taps, unsigned char* output, const unsigned int count,
+                                        const int* kernel, const unsigned int kernelsize, bool symmetric, bool absres)
+{
+    if (!IsEnabled() || !IsKernelSupported(kernel, kernelsize)) return 0;
+
+    const unsigned int bulk = count & ~15u;
+    if (bulk == 0) return 0;
+
+    // With a symmetric kernel, mirrored taps share their coefficient
+    const unsigned int taps_eff = symmetric ? (kernelsize + 1) / 2 : kernelsize;
+    int coeffs[(MaxKernelSize + 1) / 2];
+    unsigned int p, q;
+    for (p = 0, q = 0; p < taps_eff; p += 2, q ++) {
+        coeffs[q] = CoeffPair(kernel[p], (p + 1 < taps_eff) ? kernel[p + 1] : 0);
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a_lo, a_hi, b_lo, b_hi, c, s0, s1, s2, s3;
+
+    for (unsigned int i = 0; i < bulk; i += 16) {
+
+        s0 = s1 = s2 = s3 = zero;
+
+        // Two taps per multiply-add
+        for (p = 0, q = 0; p < taps_eff; p += 2, q ++) {
+            LoadTap(taps, p, kernelsize, symmetric, i, a_lo, a_hi);
+            if (p + 1 < taps_eff) {
+                LoadTap(taps, p + 1, kernelsize, symmetric, i, b_lo, b_hi);
+            }
+            else {
+                b_lo = b_hi = zero;
+            }
+            c = _mm_set1_epi32(coeffs[q]);
+            s0 = _mm_add_epi32(s0, _mm_madd_epi16(_mm_unpacklo_epi16(a_lo, b_lo), c));
+            s1 = _mm_add_epi32(s1, _mm_madd_epi16(_mm_unpackhi_epi16(a_lo, b_lo), c));
+            s2 = _mm_add_epi32(s2, _mm_madd_epi16(_mm_unpacklo_epi16(a_hi, b_hi), c));
+            s3 = _mm_add_epi32(s3, _mm_madd_epi16(_mm_unpackhi_epi16(a_hi, b_hi), c));
+        }
+
+        Store16(output + i, Finish(s0, absres), Finish(s1, absres), Finish(s2, absres), Finish(s3, absres));
+    }
+
+    return bulk;
+}
+
+unsigned int svlConvolutionSIMD::BoxColumns(short* sums, const unsigned char* add, const unsigned char* sub, unsigned char* output,
+                                            const unsigned int count, const int coeff, bool absres)
+{
+    if (!IsEnabled() || !IsKernelSupported(&coeff, 1)) return 0;
+
+    const unsigned int bulk = count & ~15u;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i k = _mm_set1_epi16(static_cast<short>(coeff));
+    __m128i a, s, sum_lo, sum_hi, lo, hi;
+
+    for (unsigned int i = 0; i < bulk; i += 16) {
+
+        // Sliding the window by one row
+        a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(add + i));
+        s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sub + i));
+        sum_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + i));
+        sum_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + i + 8));
+        sum_lo = _mm_add_epi16(sum_lo, _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(s, zero)));
+        sum_hi = _mm_add_epi16(sum_hi, _mm_sub_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(s, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + i), sum_lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + i + 8), sum_hi);
+
+        // 32 bit products from the low and high halves of the 16 bit products
+        lo = _mm_mullo_epi16(sum_lo, k);
+        hi = _mm_mulhi_epi16(sum_lo, k);
+        const __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+        const __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+        lo = _mm_mullo_epi16(sum_hi, k);
+        hi = _mm_mulhi_epi16(sum_hi, k);
+        const __m128i p2 = _mm_unpacklo_epi16(lo, hi);
+        const __m128i p3 = _mm_unpackhi_epi16(lo, hi);
+
+        Store16(output + i, Finish(p0, absres), Finish(p1, absres), Finish(p2, absres), Finish(p3, absres));
+    }
+
+    return bulk;
+}
+
+unsigned int svlConvolutionSIMD::WeightedRows(const unsigned char* const* rows, unsigned char* output, const unsigned int count,
+                                              const int* weights, const unsigned int rowcount)
+{
+    if (!IsEnabled() || !IsKernelSupported(weights, rowcount)) return 0;
+
+    const unsigned int bulk = count & ~15u;
+    if (bulk == 0) return 0;
+
+    int coeffs[(MaxKernelSize + 1) / 2];
+    unsigned int p, q;
+    for (p = 0, q = 0; p < rowcount; p += 2, q ++) {
+        coeffs[q] = CoeffPair(weights[p], (p + 1 < rowcount) ? weights[p + 1] : 0);
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << 13);
+    __m128i a, b, a_lo, a_hi, b_lo, b_hi, c, s0, s1, s2, s3;
+
+    for (unsigned int i = 0; i < bulk; i += 16) {
+
+        s0 = s1 = s2 = s3 = round;
+
+        // Two rows per multiply-add
+        for (p = 0, q = 0; p < rowcount; p += 2, q ++) {
+            a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[p] + i));
+            b = (p + 1 < rowcount) ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[p + 1] + i)) : zero;
+            a_lo = _mm_unpacklo_epi8(a, zero);
+            a_hi = _mm_unpackhi_epi8(a, zero);
+            b_lo = _mm_unpacklo_epi8(b, zero);
+            b_hi = _mm_unpackhi_epi8(b, zero);
+            c = _mm_set1_epi32(coeffs[q]);
+            s0 = _mm_add_epi32(s0, _mm_madd_epi16(_mm_unpacklo_epi16(a_lo, b_lo), c));
+            s1 = _mm_add_epi32(s1, _mm_madd_epi16(_mm_unpackhi_epi16(a_lo, b_lo), c));
+            s2 = _mm_add_epi32(s2, _mm_madd_epi16(_mm_unpacklo_epi16(a_hi, b_hi), c));
+            s3 = _mm_add_epi32(s3, _mm_madd_epi16(_mm_unpackhi_epi16(a_hi, b_hi), c));
+        }
+
+        Store16(output + i, _mm_srai_epi32(s0, 14), _mm_srai_epi32(s1, 14), _mm_srai_epi32(s2, 14), _mm_srai_epi32(s3, 14));
+    }
+
+    return bulk;
+}
+
+unsigned int svlConvolutionSIMD::AccumulateRow(unsigned short* sums, const unsigned char* row, const unsigned int count)
+{
+    if (!IsEnabled()) return 0;
+
+    const unsigned int bulk = count & ~15u;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a, sum_lo, sum_hi;
+
+    for (unsigned int i = 0; i < bulk; i += 16) {
+        a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        sum_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + i));
+        sum_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + i + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + i),     _mm_add_epi16(sum_lo, _mm_unpacklo_epi8(a, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + i + 8), _mm_add_epi16(sum_hi, _mm_unpackhi_epi8(a, zero)));
+    }
+
+    return bulk;
+}
+
+unsigned int svlConvolutionSIMD::Binomial5Rows(const unsigned char* const* rows, unsigned short* output, const unsigned int count)
+{
+    if (!IsEnabled()) return 0;
+
+    const unsigned int bulk = count & ~15u;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i r0, r1, r2, r3, r4, outer, inner, center;
+
+    for (unsigned int i = 0; i < bulk; i += 16) {
+        r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[0] + i));
+        r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[1] + i));
+        r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[2] + i));
+        r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[3] + i));
+        r4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[4] + i));
+
+        // Sums of up to 16 * 255 fit in 16 bits
+        outer  = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r4, zero));
+        inner  = _mm_add_epi16(_mm_unpacklo_epi8(r1, zero), _mm_unpacklo_epi8(r3, zero));
+        center = _mm_unpacklo_epi8(r2, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         _mm_add_epi16(_mm_add_epi16(outer, _mm_slli_epi16(inner, 2)),
+                                       _mm_add_epi16(_mm_slli_epi16(center, 2), _mm_slli_epi16(center, 1))));
+
+        outer  = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r4, zero));
+        inner  = _mm_add_epi16(_mm_unpackhi_epi8(r1, zero), _mm_unpackhi_epi8(r3, zero));
+        center = _mm_unpackhi_epi8(r2, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 8),
+                         _mm_add_epi16(_mm_add_epi16(outer, _mm_slli_epi16(inner, 2)),
+                                       _mm_add_epi16(_mm_slli_epi16(center, 2), _mm_slli_epi16(center, 1))));
+    }
+
+    return bulk;
+}
+
+unsigned int svlConvolutionSIMD::AbsDiffRows(const unsigned char* img, const unsigned int imgstride, const unsigned char* tmp, const unsigned int tmpstride,
+                                             const unsigned int width, const unsigned int rows, int & sum)
+{
+    if (!IsEnabled()) return 0;
+
+    const unsigned int bulk = width & ~15u;
+    if (bulk == 0) return 0;
+
+    __m128i acc = _mm_setzero_si128();
+    unsigned int i, j;
+
+    for (j = 0; j < rows; j ++, img += imgstride, tmp += tmpstride) {
+        for (i = 0; i < bulk; i += 16) {
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(img + i)),
+                                                  _mm_loadu_si128(reinterpret_cast<const __m128i*>(tmp + i))));
+        }
+    }
+    sum += _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+
+    return bulk;
+}
+
+unsigned int svlConvolutionSIMD::SqDiffRows(const unsigned char* img, const unsigned int imgstride, const unsigned char* tmp, const unsigned int tmpstride,
+                                            const unsigned int width, const unsigned int rows, int & sum)
+{
+    if (!IsEnabled()) return 0;
+
+    const unsigned int bulk = width & ~15u;
+    if (bulk == 0) return 0;
+
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero, a, b, d;
+    unsigned int i, j;
+
+    for (j = 0; j < rows; j ++, img += imgstride, tmp += tmpstride) {
+        for (i = 0; i < bulk; i += 16) {
+            a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(img + i));
+            b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tmp + i));
+            d = _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(d, d));
+            d = _mm_sub_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(d, d));
+        }
+    }
+    acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+    sum += _mm_cvtsi128_si32(acc);
+
+    return bulk;
+}
+
+// The channel of the first element of each block of 8 cycles through
+// R, B, G; RGBChannelMasks[phase][channel] selects the elements of a channel
+static const short RGBChannelMasks[3][3][8] = {
+    { { -1,  0,  0, -1,  0,  0, -1,  0 }, {  0, -1,  0,  0, -1,  0,  0, -1 }, {  0,  0, -1,  0,  0, -1,  0,  0 } },
+    { {  0, -1,  0,  0, -1,  0,  0, -1 }, {  0,  0, -1,  0,  0, -1,  0,  0 }, { -1,  0,  0, -1,  0,  0, -1,  0 } },
+    { {  0,  0, -1,  0,  0, -1,  0,  0 }, { -1,  0,  0, -1,  0,  0, -1,  0 }, {  0, -1,  0,  0, -1,  0,  0, -1 } }
+};
+
+unsigned int svlConvolutionSIMD::CorrelateRowsRGB(const unsigned char* img, const unsigned int imgstride, const short* tmp, const unsigned int tmpstride,
+                                                  const unsigned int width, const unsigned int rows, int* sums)
+{
+    if (!IsEnabled()) return 0;
+
+    const unsigned int bulk = width & ~7u;
+    if (bulk == 0) return 0;
+
+    __m128i mask[3][3];
+    unsigned int i, j, c, phase;
+    for (phase = 0; phase < 3; phase ++) {
+        for (c = 0; c < 3; c ++) {
+            mask[phase][c] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(RGBChannelMasks[phase][c]));
+        }
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0 = zero, acc1 = zero, acc2 = zero, a, t;
+
+    for (j = 0; j < rows; j ++, img += imgstride, tmp += tmpstride) {
+        for (i = 0, phase = 0; i < bulk; i += 8, phase = (phase == 2) ? 0 : phase + 1) {
+            a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(img + i)), zero);
+            t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tmp + i));
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(a, _mm_and_si128(t, mask[phase][0])));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(a, _mm_and_si128(t, mask[phase][1])));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(a, _mm_and_si128(t, mask[phase][2])));
+        }
+    }
+
+    __m128i* acc[3] = { &acc0, &acc1, &acc2 };
+    for (c = 0; c < 3; c ++) {
+        a = _mm_add_epi32(*acc[c], _mm_srli_si128(*acc[c], 8));
+        a = _mm_add_epi32(a, _mm_srli_si128(a, 4));
+        sums[c] += _mm_cvtsi128_si32(a);
+    }
+
+    return bulk;
+}
+
+unsigned int svlConvolutionSIMD::SumRowsRGB(const unsigned char* img, const unsigned int imgstride, const unsigned int width, const unsigned int rows,
+                                            int* sums, int* sqsums)
+{
+    if (!IsEnabled()) return 0;
+
+    const unsigned int bulk = width & ~7u;
+    if (bulk == 0) return 0;
+
+    const __m128i one = _mm_set1_epi16(1);
+    __m128i mask[3][3];
+    unsigned int i, j, c, phase;
+    for (phase = 0; phase < 3; phase ++) {
+        for (c = 0; c < 3; c ++) {
+            mask[phase][c] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(RGBChannelMasks[phase][c]));
+        }
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum[3] = { zero, zero, zero };
+    __m128i sqsum[3] = { zero, zero, zero };
+    __m128i a, m;
+
+    for (j = 0; j < rows; j ++, img += imgstride) {
+        for (i = 0, phase = 0; i < bulk; i += 8, phase = (phase == 2) ? 0 : phase + 1) {
+            a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(img + i)), zero);
+            for (c = 0; c < 3; c ++) {
+                m = _mm_and_si128(a, mask[phase][c]);
+                sum[c]   = _mm_add_epi32(sum[c],   _mm_madd_epi16(m, one));
+                sqsum[c] = _mm_add_epi32(sqsum[c], _mm_madd_epi16(m, m));
+            }
+        }
+    }
+
+    for (c = 0; c < 3; c ++) {
+        a = _mm_add_epi32(sum[c], _mm_srli_si128(sum[c], 8));
+        a = _mm_add_epi32(a, _mm_srli_si128(a, 4));
+        sums[c] += _mm_cvtsi128_si32(a);
+        a = _mm_add_epi32(sqsum[c], _mm_srli_si128(sqsum[c], 8));
+        a = _mm_add_epi32(a, _mm_srli_si128(a, 4));
+        sqsums[c] += _mm_cvtsi128_si32(a);
+    }
+
+    return bulk;
+}
+
+
+#else // SVL_CONVERTER_HAS_SSE2
+
+unsigned int svlConvolutionSIMD::Filter(const unsigned char* const*, unsigned char*, const unsigned int, const int*, const unsigned int, bool, bool) { return 0; }
+unsigned int svlConvolutionSIMD::BoxColumns(short*, const unsigned char*, const unsigned char*, unsigned char*, const unsigned int, const int, bool) { return 0; }
+unsigned int svlConvolutionSIMD::WeightedRows(const unsigned char* const*, unsigned char*, const unsigned int, const int*, const unsigned int) { return 0; }
+unsigned int svlConvolutionSIMD::AccumulateRow(unsigned short*, const unsigned char*, const unsigned int) { return 0; }
+unsigned int svlConvolutionSIMD::Binomial5Rows(const unsigned char* const*, unsigned short*, const unsigned int) { return 0; }
+unsigned int svlConvolutionSIMD::AbsDiffRows(const unsigned char*, const unsigned int, const unsigned char*, const unsigned int, const unsigned int, const unsigned int, int &) { return 0; }
+unsigned int svlConvolutionSIMD::SqDiffRows(const unsigned char*, const unsigned int, const unsigned char*, const unsigned int, const unsigned int, const unsigned int, int &) { return 0; }
+unsigned int svlConvolutionSIMD::CorrelateRowsRGB(const unsigned char*, const unsigned int, const short*, const unsigned int, const unsigned int, const unsigned int, int*) { return 0; }
+unsigned int svlConvolutionSIMD::SumRowsRGB(const unsigned char*, const unsigned int, const unsigned int, const unsigned int, int*, int*) { return 0; }
+
+#endif // SVL_CONVERTER_HAS_SSE2
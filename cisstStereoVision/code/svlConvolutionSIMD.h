@@ -0,0 +1,86 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlConvolutionSIMD_h
+#define _svlConvolutionSIMD_h
+
+#include "svlConvertersSIMD.h"
+
+
+// Vectorized 1D convolution kernels on 8 bit data.
+// Both kernels compute, for each element 'i' of the output:
+//     ((sum_k kernel[k] * taps[k][i]) >> 10)
+// followed by the absolute value (if 'absres' is true) and saturation
+// to [0, 255], exactly like svlImageProcessingHelper::ConvolutionRGB.
+// A horizontal pass passes taps shifted by the pixel size, a vertical
+// pass passes the rows covered by the kernel.
+// Kernels process the largest multiple of 16 elements they can handle and
+// return the number of elements processed; the caller processes the rest.
+// Kernels return 0 if SIMD is not available, has been disabled, or the
+// coefficients do not fit in 16 bits.
+namespace svlConvolutionSIMD
+{
+    bool IsSupported();
+    bool IsEnabled();
+    void SetEnabled(bool enable);
+
+    //! Longest kernel handled by the kernels
+    const unsigned int MaxKernelSize = 256;
+
+    //! True if all coefficients can be handled by the kernels
+    bool IsKernelSupported(const int* kernel, const unsigned int kernelsize);
+
+    //! If 'symmetric' is true, kernel[k] == kernel[kernelsize-1-k] and taps k and kernelsize-1-k are added before multiplication
+    unsigned int Filter(const unsigned char* const* taps, unsigned char* output, const unsigned int count,
+                        const int* kernel, const unsigned int kernelsize, bool symmetric, bool absres);
+
+    //! Box filter along columns: sums[i] += add[i] - sub[i], then output[i] = (sums[i] * coeff) >> 10 (sums must fit in 16 bits)
+    unsigned int BoxColumns(short* sums, const unsigned char* add, const unsigned char* sub, unsigned char* output,
+                            const unsigned int count, const int coeff, bool absres);
+
+    //! Weighted sum of rows with 14 bit fixed point weights, rounded and saturated:
+    //! output[i] = (sum_k weights[k] * rows[k][i] + 8192) >> 14
+    unsigned int WeightedRows(const unsigned char* const* rows, unsigned char* output, const unsigned int count,
+                              const int* weights, const unsigned int rowcount);
+
+    //! Column sums: sums[i] += row[i]
+    unsigned int AccumulateRow(unsigned short* sums, const unsigned char* row, const unsigned int count);
+
+    //! Binomial filter across five rows: output[i] = r0[i] + 4 * (r1[i] + r3[i]) + 6 * r2[i] + r4[i]
+    unsigned int Binomial5Rows(const unsigned char* const* rows, unsigned short* output, const unsigned int count);
+
+    // Block matching kernels: process the leading columns of 'rows' rows of
+    // 'width' bytes and return the number of columns processed per row.
+
+    //! sum += |img[i] - tmp[i]|
+    unsigned int AbsDiffRows(const unsigned char* img, const unsigned int imgstride, const unsigned char* tmp, const unsigned int tmpstride,
+                             const unsigned int width, const unsigned int rows, int & sum);
+
+    //! sum += (img[i] - tmp[i])^2
+    unsigned int SqDiffRows(const unsigned char* img, const unsigned int imgstride, const unsigned char* tmp, const unsigned int tmpstride,
+                            const unsigned int width, const unsigned int rows, int & sum);
+
+    //! Correlation of RGB pixels with a 16 bit template: sums[i % 3] += img[i] * tmp[i] (|tmp[i]| < 256)
+    unsigned int CorrelateRowsRGB(const unsigned char* img, const unsigned int imgstride, const short* tmp, const unsigned int tmpstride,
+                                  const unsigned int width, const unsigned int rows, int* sums);
+
+    //! Sums of RGB pixels: sums[i % 3] += img[i], sqsums[i % 3] += img[i]^2
+    unsigned int SumRowsRGB(const unsigned char* img, const unsigned int imgstride, const unsigned int width, const unsigned int rows,
+                            int* sums, int* sqsums);
+}
+
+#endif // _svlConvolutionSIMD_h
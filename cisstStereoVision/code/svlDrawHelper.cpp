@@ -20,10 +20,20 @@
  */
 
 #include "svlDrawHelper.h"
+#include "svlConvertersSIMD.h"
+#include <string.h>
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    #include <emmintrin.h>
+#endif
 
 #define __LARGE_NUMBER   100000000
 #define __SMALL_NUMBER  -100000000
 
+#define WARP_TILE_SIZE          64
+#define WARP_MAX_COORDINATE     16383
+#define WARP_MAX_DERIVATIVE     (1 << 24)
+
 
 /******************************/
 /*** svlDrawInternals class ***/
@@ -863,31 +873,182 @@ void svlDrawHelper::ShapeInternals::DrawRGB(int x1, int y1, int x2, int y2, int
 }
 
 
+/*******************************/
+/*** Warping kernels ***********/
+/*******************************/
+
+static long long FloorDiv(const long long n, const long long d)
+{
+    long long q = n / d;
+    if ((n % d) != 0 && ((n < 0) != (d < 0))) q --;
+    return q;
+}
+
+// Fixed point sample positions of 'count' consecutive output pixels
+static void StepCoordinates(int* us, int* vs, int u, int v, const int du, const int dv, const int count)
+{
+    int i = 0;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    if (count >= 4) {
+        __m128i uu = _mm_setr_epi32(u, u + du, u + 2 * du, u + 3 * du);
+        __m128i vv = _mm_setr_epi32(v, v + dv, v + 2 * dv, v + 3 * dv);
+        const __m128i ustep = _mm_set1_epi32(du * 4);
+        const __m128i vstep = _mm_set1_epi32(dv * 4);
+
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(us + i), uu);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(vs + i), vv);
+            uu = _mm_add_epi32(uu, ustep);
+            vv = _mm_add_epi32(vv, vstep);
+        }
+        u += i * du;
+        v += i * dv;
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    for (; i < count; i ++) {
+        us[i] = u; u += du;
+        vs[i] = v; v += dv;
+    }
+}
+
+// dst = (a * (256 - w) + b * w + 128) >> 8
+static void LerpBytes(unsigned char* dst, const unsigned char* a, const unsigned char* b, const unsigned char* w, const int length)
+{
+    int i = 0;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    // The weighted sum is at most 256 * 255 + 128 and fits in 16 bits
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(256);
+    const __m128i half = _mm_set1_epi16(128);
+    __m128i va, vb, vw, lo, hi, wlo, whi;
+
+    for (; i + 16 <= length; i += 16) {
+        va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        vw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+        wlo = _mm_unpacklo_epi8(vw, zero);
+        whi = _mm_unpackhi_epi8(vw, zero);
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, zero), _mm_sub_epi16(full, wlo)),
+                           _mm_mullo_epi16(_mm_unpacklo_epi8(vb, zero), wlo));
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, zero), _mm_sub_epi16(full, whi)),
+                           _mm_mullo_epi16(_mm_unpackhi_epi8(vb, zero), whi));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, half), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, half), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    for (; i < length; i ++) {
+        dst[i] = static_cast<unsigned char>((a[i] * (256 - w[i]) + b[i] * w[i] + 128) >> 8);
+    }
+}
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+// 4 bytes at each of two addresses as 16 bit values
+static inline __m128i LoadPixelPair(const unsigned char* p1, const unsigned char* p2)
+{
+    int a, b;
+    memcpy(&a, p1, 4);
+    memcpy(&b, p2, 4);
+    return _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b)), _mm_setzero_si128());
+}
+
+// (a * (256 - w) + b * w + 128) >> 8 on 16 bit values
+static inline __m128i Lerp16(const __m128i a, const __m128i b, const __m128i w)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(a, _mm_sub_epi16(_mm_set1_epi16(256), w)),
+                                                      _mm_mullo_epi16(b, w)),
+                                        _mm_set1_epi16(128)), 8);
+}
+
+// Bilinear samples of 3 or 4 byte pixels, two at a time.  All four
+// neighbors of each sample have to be inside the image and readable as
+// 4 bytes.  Rounding is the same as that of three LerpBytes passes.  The
+// fourth byte is stored in 'alpha' if not null.
+static void SampleBilinear4(unsigned char* color, unsigned char* alpha,
+                            const unsigned char* input, const int inbpp, const int instride,
+                            const int* us, const int* vs, const int count)
+{
+    const unsigned char *p1, *p2;
+    __m128i wu, wv, upper, lower;
+    int i, j, k, u1, u2, v1, v2, value;
+
+    for (i = 0; i < count; i += 2) {
+        j = (i + 1 < count) ? i + 1 : i;
+        p1 = input + (vs[i] >> 16) * instride + (us[i] >> 16) * inbpp;
+        p2 = input + (vs[j] >> 16) * instride + (us[j] >> 16) * inbpp;
+        u1 = (us[i] >> 8) & 0xFF; u2 = (us[j] >> 8) & 0xFF;
+        v1 = (vs[i] >> 8) & 0xFF; v2 = (vs[j] >> 8) & 0xFF;
+        wu = _mm_unpacklo_epi64(_mm_set1_epi16(static_cast<short>(u1)), _mm_set1_epi16(static_cast<short>(u2)));
+        wv = _mm_unpacklo_epi64(_mm_set1_epi16(static_cast<short>(v1)), _mm_set1_epi16(static_cast<short>(v2)));
+
+        upper = Lerp16(LoadPixelPair(p1, p2), LoadPixelPair(p1 + inbpp, p2 + inbpp), wu);
+        lower = Lerp16(LoadPixelPair(p1 + instride, p2 + instride),
+                       LoadPixelPair(p1 + instride + inbpp, p2 + instride + inbpp), wu);
+        upper = Lerp16(upper, lower, wv);
+        upper = _mm_packus_epi16(upper, upper);
+
+        for (k = i; k <= j; k ++, color += 3) {
+            value = _mm_cvtsi128_si32(upper);
+            color[0] = static_cast<unsigned char>(value);
+            color[1] = static_cast<unsigned char>(value >> 8);
+            color[2] = static_cast<unsigned char>(value >> 16);
+            if (alpha) alpha[k] = static_cast<unsigned char>(value >> 24);
+            upper = _mm_srli_si128(upper, 4);
+        }
+    }
+}
+#endif // SVL_CONVERTER_HAS_SSE2
+
+// dst = (src * w + dst * (256 - w)) >> 8, w in [0, 256]
+static void BlendBytes(unsigned char* dst, const unsigned char* src, const unsigned short* w, const int length)
+{
+    int i = 0;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(256);
+    __m128i vs, vd, wlo, whi, lo, hi;
+
+    for (; i + 16 <= length; i += 16) {
+        vs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        vd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        wlo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+        whi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i + 8));
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(vs, zero), wlo),
+                           _mm_mullo_epi16(_mm_unpacklo_epi8(vd, zero), _mm_sub_epi16(full, wlo)));
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(vs, zero), whi),
+                           _mm_mullo_epi16(_mm_unpackhi_epi8(vd, zero), _mm_sub_epi16(full, whi)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    for (; i < length; i ++) {
+        dst[i] = static_cast<unsigned char>((src[i] * w[i] + dst[i] * (256 - w[i])) >> 8);
+    }
+}
+
+
 /******************************************/
 /*** svlDrawHelper::WarpInternals class ***/
 /******************************************/
 
 svlDrawHelper::WarpInternals::WarpInternals(unsigned int vertices) :
     svlDrawInternals(),
+    Vertices(vertices),
     Input(0),
     Output(0),
-    _ilen(0),
-    _olen(0),
-    _in_idxs(0),
-    _out_idxs(0),
-    _lm_x(0),
-    _rm_x(0),
-    _lm_id(0),
-    _rm_id(0),
-    _lm_pos(0),
-    _rm_pos(0)
+    TriangleCount(0),
+    SpanTop(0)
 {
-    AllocateBuffers(vertices, MAX_DIMENSION * 2);
 }
 
 svlDrawHelper::WarpInternals::~WarpInternals()
 {
-    ReleaseBuffers();
 }
 
 bool svlDrawHelper::WarpInternals::SetInputImage(svlSampleImage* image, unsigned int channel)
@@ -931,148 +1092,12 @@ void svlDrawHelper::WarpInternals::Draw(unsigned int thread_count, unsigned int
                                         int ox1, int oy1, int ox2, int oy2, int ox3, int oy3,
                                         unsigned int alpha)
 {
-    if (_ixs.size() < 3) return;
-    if (!Input || !Output || alpha == 0) return;
-    if (InPixelType != svlPixelMono8 &&
-        InPixelType != svlPixelRGB &&
-        InPixelType != svlPixelRGBA) return;
-    if ((InPixelType == svlPixelMono8 || InPixelType == svlPixelRGB) && InPixelType != OutPixelType) return;
-    if (InPixelType == svlPixelRGBA && OutPixelType != svlPixelRGB) return;
-
-    ix1 <<= 1; iy1 <<= 1; ix2 <<= 1; iy2 <<= 1; ix3 <<= 1; iy3 <<= 1;
-    ox1 <<= 1; oy1 <<= 1; ox2 <<= 1; oy2 <<= 1; ox3 <<= 1; oy3 <<= 1;
-
-    const int out_height_dbl = OutHeight << 1;
-    int miny = MIN3(oy1, oy2, oy3);
-    int maxy = MAX3(oy1, oy2, oy3);
-    if (miny < 0) miny = 0;
-    if (maxy >= out_height_dbl) maxy = out_height_dbl - 1;
-
-    int i, j, x, y, len;
-    int *xs, *ys;
-
-    // Trace source and destination triangle contours
-    if (iy1 <= iy2) {
-        _ilen[0] = GetLinePixels(_ixs[0], _iys[0], ix1, iy1, ix2, iy2);
-        _olen[0] = GetLinePixels(_oxs[0], _oys[0], ox1, oy1, ox2, oy2);
-    }
-    else {
-        _ilen[0] = GetLinePixels(_ixs[0], _iys[0], ix2, iy2, ix1, iy1);
-        _olen[0] = GetLinePixels(_oxs[0], _oys[0], ox2, oy2, ox1, oy1);
-    }
-    if (iy2 <= iy3) {
-        _ilen[1] = GetLinePixels(_ixs[1], _iys[1], ix2, iy2, ix3, iy3);
-        _olen[1] = GetLinePixels(_oxs[1], _oys[1], ox2, oy2, ox3, oy3);
-    }
-    else {
-        _ilen[1] = GetLinePixels(_ixs[1], _iys[1], ix3, iy3, ix2, iy2);
-        _olen[1] = GetLinePixels(_oxs[1], _oys[1], ox3, oy3, ox2, oy2);
-    }
-    if (iy3 <= iy1) {
-        _ilen[2] = GetLinePixels(_ixs[2], _iys[2], ix3, iy3, ix1, iy1);
-        _olen[2] = GetLinePixels(_oxs[2], _oys[2], ox3, oy3, ox1, oy1);
-    }
-    else {
-        _ilen[2] = GetLinePixels(_ixs[2], _iys[2], ix1, iy1, ix3, iy3);
-        _olen[2] = GetLinePixels(_oxs[2], _oys[2], ox1, oy1, ox3, oy3);
-    }
+    if (Vertices < 3 || !CheckFormats(alpha)) return;
 
-    for (i = miny; i <= maxy; i ++) {
-        _lm_x[i] = __LARGE_NUMBER;
-        _rm_x[i] = __SMALL_NUMBER;
-    }
-
-    for (j = 0; j < 3; j ++) {
-        len = _olen[j];
-        xs = _oxs[j];
-        ys = _oys[j];
-
-        for (i = 0; i < len; i ++) {
-            x = *xs; xs ++;
-            y = *ys; ys ++;
-            if (y < 0 || y >= out_height_dbl) continue;
-
-            if (x < _lm_x[y]) {
-                _lm_x[y] = x;
-                _lm_id[y] = j;
-                _lm_pos[y] = i;
-            }
-            if (x > _rm_x[y]) {
-                _rm_x[y] = x;
-                _rm_id[y] = j;
-                _rm_pos[y] = i;
-            }
-        }
-    }
+    SetupTriangle(Triangles[0], ix1, iy1, ix2, iy2, ix3, iy3, ox1, oy1, ox2, oy2, ox3, oy3);
+    TriangleCount = 1;
 
-    vctInt3 ratio;
-    ratio[0] = (_ilen[0] << 10) / _olen[0];
-    ratio[1] = (_ilen[1] << 10) / _olen[1];
-    ratio[2] = (_ilen[2] << 10) / _olen[2];
-
-    int id1, id2, pos1, pos2;
-
-    // Calculate range for multithreaded processing
-    int full_range = maxy - miny;
-    int _to = full_range / thread_count + 1;
-    int _from = thread_id * _to;
-    _to += _from;
-    if (_to > full_range) _to = full_range;
-    _from += miny + 1;
-    _to += miny + 1;
-
-    for (i = _from; i < _to; i += 2) {
-        id1 = _lm_id[i];
-        id2 = _rm_id[i];
-
-        pos1 = (_lm_pos[i] * ratio[id1] + 512) >> 10;
-        pos2 = (_rm_pos[i] * ratio[id2] + 512) >> 10;
-        if (pos1 >= _ilen[id1]) pos1 = _ilen[id1] - 1;
-        if (pos2 >= _ilen[id2]) pos2 = _ilen[id2] - 1;
-
-        if (_lm_x[i] != __LARGE_NUMBER &&
-            _rm_x[i] != __SMALL_NUMBER) {
-
-            if (InPixelType != svlPixelRGBA) {
-                if (alpha == 256) {
-                    if (InPixelType == svlPixelMono8) {
-                        ResampleLineMono8((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                          (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                          (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                          (_rm_x[i] + 1) >> 1, (i + 1) >> 1);
-                    }
-                    else {
-                        ResampleLineRGB((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                        (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                        (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                        (_rm_x[i] + 1) >> 1, (i + 1) >> 1);
-                    }
-                }
-                else {
-                    if (InPixelType == svlPixelMono8) {
-                        ResampleLineAlphaMono8((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                               (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                               (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                               (_rm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                               alpha);
-                    }
-                    else if (InPixelType == svlPixelRGB) {
-                        ResampleLineAlphaRGB((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                             (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                             (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                             (_rm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                             alpha);
-                    }
-                }
-            }
-            else {
-                ResampleLineRGBA((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                 (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                 (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                 (_rm_x[i] + 1) >> 1, (i + 1) >> 1);
-            }
-        }
-    }
+    Rasterize(thread_count, thread_id, alpha);
 }
 
 void svlDrawHelper::WarpInternals::Draw(unsigned int thread_count, unsigned int thread_id,
@@ -1080,1410 +1105,345 @@ void svlDrawHelper::WarpInternals::Draw(unsigned int thread_count, unsigned int
                                         int ox1, int oy1, int ox2, int oy2, int ox3, int oy3, int ox4, int oy4,
                                         unsigned int alpha)
 {
-    if (_ixs.size() < 4) return;
-    if (!Input || !Output || alpha == 0) return;
-    if (InPixelType != svlPixelMono8 &&
-        InPixelType != svlPixelRGB &&
-        InPixelType != svlPixelRGBA) return;
-    if ((InPixelType == svlPixelMono8 || InPixelType == svlPixelRGB) && InPixelType != OutPixelType) return;
-    if (InPixelType == svlPixelRGBA && OutPixelType != svlPixelRGB) return;
-
-    ix1 <<= 1; iy1 <<= 1; ix2 <<= 1; iy2 <<= 1; ix3 <<= 1; iy3 <<= 1; ix4 <<= 1; iy4 <<= 1;
-    ox1 <<= 1; oy1 <<= 1; ox2 <<= 1; oy2 <<= 1; ox3 <<= 1; oy3 <<= 1; ox4 <<= 1; oy4 <<= 1;
-
-    const int out_height_dbl = OutHeight << 1;
-    int miny = oy1, maxy = oy1;
-    if (oy2 < miny) miny = oy2;
-    if (oy3 < miny) miny = oy3;
-    if (oy4 < miny) miny = oy4;
-    if (oy2 > maxy) maxy = oy2;
-    if (oy3 > maxy) maxy = oy3;
-    if (oy4 > maxy) maxy = oy4;
-    if (miny < 0) miny = 0;
-    if (maxy >= out_height_dbl) maxy = out_height_dbl - 1;
-
-    int i, j, x, y, len;
-    int *xs, *ys;
-
-    // Trace source and destination quad contours
-    if (iy1 <= iy2) {
-        _ilen[0] = GetLinePixels(_ixs[0], _iys[0], ix1, iy1, ix2, iy2);
-        _olen[0] = GetLinePixels(_oxs[0], _oys[0], ox1, oy1, ox2, oy2);
-    }
-    else {
-        _ilen[0] = GetLinePixels(_ixs[0], _iys[0], ix2, iy2, ix1, iy1);
-        _olen[0] = GetLinePixels(_oxs[0], _oys[0], ox2, oy2, ox1, oy1);
-    }
-    if (iy2 <= iy3) {
-        _ilen[1] = GetLinePixels(_ixs[1], _iys[1], ix2, iy2, ix3, iy3);
-        _olen[1] = GetLinePixels(_oxs[1], _oys[1], ox2, oy2, ox3, oy3);
-    }
-    else {
-        _ilen[1] = GetLinePixels(_ixs[1], _iys[1], ix3, iy3, ix2, iy2);
-        _olen[1] = GetLinePixels(_oxs[1], _oys[1], ox3, oy3, ox2, oy2);
-    }
-    if (iy3 <= iy4) {
-        _ilen[2] = GetLinePixels(_ixs[2], _iys[2], ix3, iy3, ix4, iy4);
-        _olen[2] = GetLinePixels(_oxs[2], _oys[2], ox3, oy3, ox4, oy4);
-    }
-    else {
-        _ilen[2] = GetLinePixels(_ixs[2], _iys[2], ix4, iy4, ix3, iy3);
-        _olen[2] = GetLinePixels(_oxs[2], _oys[2], ox4, oy4, ox3, oy3);
-    }
-    if (iy4 <= iy1) {
-        _ilen[3] = GetLinePixels(_ixs[3], _iys[3], ix4, iy4, ix1, iy1);
-        _olen[3] = GetLinePixels(_oxs[3], _oys[3], ox4, oy4, ox1, oy1);
-    }
-    else {
-        _ilen[3] = GetLinePixels(_ixs[3], _iys[3], ix1, iy1, ix4, iy4);
-        _olen[3] = GetLinePixels(_oxs[3], _oys[3], ox1, oy1, ox4, oy4);
-    }
-
-    for (i = miny; i <= maxy; i ++) {
-        _lm_x[i] = __LARGE_NUMBER;
-        _rm_x[i] = __SMALL_NUMBER;
-    }
+    if (Vertices < 4 || !CheckFormats(alpha)) return;
 
-    for (j = 0; j < 4; j ++) {
-        len = _olen[j];
-        xs = _oxs[j];
-        ys = _oys[j];
+    SetupTriangle(Triangles[0], ix1, iy1, ix2, iy2, ix3, iy3, ox1, oy1, ox2, oy2, ox3, oy3);
+    SetupTriangle(Triangles[1], ix1, iy1, ix3, iy3, ix4, iy4, ox1, oy1, ox3, oy3, ox4, oy4);
+    TriangleCount = 2;
 
-        for (i = 0; i < len; i ++) {
-            x = *xs; xs ++;
-            y = *ys; ys ++;
-            if (y < 0 || y >= out_height_dbl) continue;
+    Rasterize(thread_count, thread_id, alpha);
+}
 
-            if (x < _lm_x[y]) {
-                _lm_x[y] = x;
-                _lm_id[y] = j;
-                _lm_pos[y] = i;
-            }
-            if (x > _rm_x[y]) {
-                _rm_x[y] = x;
-                _rm_id[y] = j;
-                _rm_pos[y] = i;
-            }
-        }
-    }
+bool svlDrawHelper::WarpInternals::CheckFormats(unsigned int alpha) const
+{
+    if (!Input || !Output || alpha == 0) return false;
+    if (InPixelType != svlPixelMono8 &&
+        InPixelType != svlPixelRGB &&
+        InPixelType != svlPixelRGBA) return false;
+    if ((InPixelType == svlPixelMono8 || InPixelType == svlPixelRGB) && InPixelType != OutPixelType) return false;
+    if (InPixelType == svlPixelRGBA && OutPixelType != svlPixelRGB) return false;
+    if (InWidth > WARP_MAX_COORDINATE + 1 || InHeight > WARP_MAX_COORDINATE + 1) return false;
+    return true;
+}
 
-    vctInt4 ratio;
-    ratio[0] = (_ilen[0] << 10) / _olen[0];
-    ratio[1] = (_ilen[1] << 10) / _olen[1];
-    ratio[2] = (_ilen[2] << 10) / _olen[2];
-    ratio[3] = (_ilen[3] << 10) / _olen[3];
-
-    int id1, id2, pos1, pos2;
-
-    // Calculate range for multithreaded processing
-    int full_range = maxy - miny;
-    int _to = full_range / thread_count + 1;
-    int _from = thread_id * _to;
-    _to += _from;
-    if (_to > full_range) _to = full_range;
-    _from += miny + 1;
-    _to += miny + 1;
-
-    for (i = _from; i < _to; i += 2) {
-        id1 = _lm_id[i];
-        id2 = _rm_id[i];
-
-        pos1 = (_lm_pos[i] * ratio[id1] + 512) >> 10;        
-        pos2 = (_rm_pos[i] * ratio[id2] + 512) >> 10;
-        if (pos1 >= _ilen[id1]) pos1 = _ilen[id1] - 1;
-        if (pos2 >= _ilen[id2]) pos2 = _ilen[id2] - 1;
-
-        if (_lm_x[i] != __LARGE_NUMBER &&
-            _rm_x[i] != __SMALL_NUMBER) {
-
-            if (InPixelType != svlPixelRGBA) {
-                if (alpha == 256) {
-                    if (InPixelType == svlPixelMono8) {
-                        ResampleLineMono8((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                          (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                          (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                          (_rm_x[i] + 1) >> 1, (i + 1) >> 1);
-                    }
-                    else {
-                        ResampleLineRGB((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                        (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                        (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                        (_rm_x[i] + 1) >> 1, (i + 1) >> 1);
-                    }
-                }
-                else {
-                    if (InPixelType == svlPixelMono8) {
-                        ResampleLineAlphaMono8((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                               (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                               (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                               (_rm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                               alpha);
-                    }
-                    else {
-                        ResampleLineAlphaRGB((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                             (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                             (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                             (_rm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                             alpha);
-                    }
-                }
-            }
-            else {
-                ResampleLineRGBA((_ixs[id1][pos1] + 1) >> 1, (_iys[id1][pos1] + 1) >> 1,
-                                 (_ixs[id2][pos2] + 1) >> 1, (_iys[id2][pos2] + 1) >> 1,
-                                 (_lm_x[i] + 1) >> 1, (i + 1) >> 1,
-                                 (_rm_x[i] + 1) >> 1, (i + 1) >> 1);
-            }
-        }
-    }
+void svlDrawHelper::WarpInternals::SetupTriangle(Triangle & triangle,
+                                                 int ix1, int iy1, int ix2, int iy2, int ix3, int iy3,
+                                                 int ox1, int oy1, int ox2, int oy2, int ox3, int oy3)
+{
+    triangle.Valid = false;
+
+    if (ix1 < -WARP_MAX_COORDINATE - 1 || ix1 > WARP_MAX_COORDINATE ||
+        ix2 < -WARP_MAX_COORDINATE - 1 || ix2 > WARP_MAX_COORDINATE ||
+        ix3 < -WARP_MAX_COORDINATE - 1 || ix3 > WARP_MAX_COORDINATE ||
+        iy1 < -WARP_MAX_COORDINATE - 1 || iy1 > WARP_MAX_COORDINATE ||
+        iy2 < -WARP_MAX_COORDINATE - 1 || iy2 > WARP_MAX_COORDINATE ||
+        iy3 < -WARP_MAX_COORDINATE - 1 || iy3 > WARP_MAX_COORDINATE) return;
+
+    triangle.Top    = MIN3(oy1, oy2, oy3);
+    triangle.Bottom = MAX3(oy1, oy2, oy3);
+    if (triangle.Top < 0) triangle.Top = 0;
+    if (triangle.Bottom >= OutHeight) triangle.Bottom = OutHeight - 1;
+    if (triangle.Top > triangle.Bottom) return;
+
+    const long long ax = ox2 - ox1, ay = oy2 - oy1;
+    const long long bx = ox3 - ox1, by = oy3 - oy1;
+    long long det = ax * by - ay * bx;
+    if (det == 0) return;
+
+    // Edge functions are non-negative inside for both orientations
+    const int xs[3] = {ox1, ox2, ox3};
+    const int ys[3] = {oy1, oy2, oy3};
+    const long long sign = (det > 0) ? 1 : -1;
+    int i, j;
+
+    for (i = 0; i < 3; i ++) {
+        j = (i + 1) % 3;
+        triangle.EA[i] = -sign * (ys[j] - ys[i]);
+        triangle.EB[i] =  sign * (xs[j] - xs[i]);
+        triangle.EC[i] =  sign * (static_cast<long long>(ys[j] - ys[i]) * xs[i] -
+                                  static_cast<long long>(xs[j] - xs[i]) * ys[i]);
+    }
+
+    // Derivatives of the output to input mapping in 16.16 fixed point,
+    // rounded to the nearest integer
+    const long long du2 = ix2 - ix1, du3 = ix3 - ix1;
+    const long long dv2 = iy2 - iy1, dv3 = iy3 - iy1;
+    const long long n[4] = {(by * du2 - ay * du3) << 16, (ax * du3 - bx * du2) << 16,
+                            (by * dv2 - ay * dv3) << 16, (ax * dv3 - bx * dv2) << 16};
+    long long d[4];
+
+    if (det < 0) det = -det;
+    for (i = 0; i < 4; i ++) {
+        d[i] = FloorDiv(2 * sign * n[i] + det, 2 * det);
+        if (d[i] > WARP_MAX_DERIVATIVE || d[i] < -WARP_MAX_DERIVATIVE) return;
+    }
+
+    triangle.OX  = ox1;
+    triangle.OY  = oy1;
+    triangle.U   = ix1 << 16;
+    triangle.V   = iy1 << 16;
+    triangle.DUX = static_cast<int>(d[0]);
+    triangle.DUY = static_cast<int>(d[1]);
+    triangle.DVX = static_cast<int>(d[2]);
+    triangle.DVY = static_cast<int>(d[3]);
+
+    triangle.Valid = true;
 }
 
-int svlDrawHelper::WarpInternals::GetLinePixels(int* xs, int* ys, int x1, int y1, int x2, int y2)
+void svlDrawHelper::WarpInternals::Rasterize(unsigned int thread_count, unsigned int thread_id, unsigned int alpha)
 {
-    if (x1 == x2 && y1 == y2) {
-        *xs = x1; *ys = y1;
-        return 1;
-    }
+    if (thread_id >= thread_count) return;
 
-    int x = x1, y = y1, dx, dy = y2 - y1, eps = 0, len = 0;
+    unsigned int t;
+    int top = OutHeight, bottom = -1;
 
-    if (y1 == y2) {
-    // Horizontal line
-        if (x2 > x1) {
-            for (x = x1; x <= x2; x ++) {
-                *xs = x; *ys = y1; xs ++; ys ++; len ++;
-            }
-        }
-        else {
-            for (x = x1; x >= x2; x --) {
-                *xs = x; *ys = y1; xs ++; ys ++; len ++;
-            }
-        }
-        return len;
-    }
-    else if (x1 == x2) {
-    // Vertical line
-        if (y2 > y1) {
-            for (y = y1; y <= y2; y ++) {
-                *xs = x1; *ys = y; xs ++; ys ++; len ++;
-            }
-        }
-        else {
-            for (y = y1; y >= y2; y --) {
-                *xs = x1; *ys = y; xs ++; ys ++; len ++;
-            }
-        }
-        return len;
+    for (t = 0; t < TriangleCount; t ++) {
+        if (!Triangles[t].Valid) continue;
+        if (Triangles[t].Top    < top)    top    = Triangles[t].Top;
+        if (Triangles[t].Bottom > bottom) bottom = Triangles[t].Bottom;
     }
+    if (top > bottom) return;
 
-    if (x1 < x2) {
+    const unsigned int size = (bottom - top + 1) * 2;
+    if (SpanLeft.size()  < size) SpanLeft.SetSize(size);
+    if (SpanRight.size() < size) SpanRight.SetSize(size);
+    SpanTop = top;
 
-        dx = x2 - x1;
+    long long left, right, a, k;
+    int i, x, y, idx;
 
-        if (dy > 0) {
-            if (dx >= dy) {
-                for (x = x1; x <= x2; x ++) {
-                    *xs = x; *ys = y; xs ++; ys ++; len ++;
-                    
-                    eps += dy;
-                    if ((eps << 1) >= dx) {
-                        y ++;
-                        eps -= dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y <= y2; y ++) {
-                    *xs = x; *ys = y; xs ++; ys ++; len ++;
-                    
-                    eps += dx;
-                    if ((eps << 1) >= dy) {
-                        x ++;
-                        eps -= dy;
-                    }
-                }
-            }
-        }
-        else {
-            if (dx >= abs(dy)) {
-                for (x = x1; x <= x2; x ++) {
-                    *xs = x; *ys = y; xs ++; ys ++; len ++;
-                    
-                    eps += dy;
-                    if ((eps << 1) <= -dx) {
-                        y --;
-                        eps += dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y >= y2; y --) {
-                    *xs = x; *ys = y; xs ++; ys ++; len ++;
-                    
-                    eps += dx;
-                    if ((eps << 1) >= -dy) {
-                        x ++;
-                        eps -= -dy;
-                    }
-                }
-            }
-        }
-    }
-    else {
+    // Pixel spans covered by the triangles in each row
+    for (y = top, idx = 0; y <= bottom; y ++, idx += 2) {
+        for (t = 0; t < 2; t ++) {
+            const Triangle & triangle = Triangles[t];
 
-        dx = x1 - x2;
-
-        if (dy > 0) {
-            if (dx >= dy) {
-                for (x = x1; x >= x2; x --) {
-                    *xs = x; *ys = y; xs ++; ys ++; len ++;
-                    
-                    eps += dy;
-                    if ((eps << 1) >= dx) {
-                        y ++;
-                        eps -= dx;
-                    }
-                }
+            left  = 0;
+            right = OutWidth - 1;
+
+            if (t >= TriangleCount || !triangle.Valid || y < triangle.Top || y > triangle.Bottom) {
+                right = -1;
             }
             else {
-                for (y = y1; y <= y2; y ++) {
-                    *xs = x; *ys = y; xs ++; ys ++; len ++;
-                    
-                    eps += dx;
-                    if ((eps << 1) >= dy) {
-                        x --;
-                        eps -= dy;
+                // a * x >= k on the inner side of each edge
+                for (i = 0; i < 3; i ++) {
+                    a = triangle.EA[i];
+                    k = -(triangle.EB[i] * y + triangle.EC[i]);
+                    if (a > 0) {
+                        k = -FloorDiv(-k, a);
+                        if (k > left) left = k;
                     }
-                }
-            }
-        }
-        else {
-            if (dx >= abs(dy)) {
-                for (x = x1; x >= x2; x --) {
-                    *xs = x; *ys = y; xs ++; ys ++; len ++;
-                    
-                    eps += dy;
-                    if ((eps << 1) <= -dx) {
-                        y --;
-                        eps += dx;
+                    else if (a < 0) {
+                        k = FloorDiv(k, a);
+                        if (k < right) right = k;
                     }
-                }
-            }
-            else {
-                for (y = y1; y >= y2; y --) {
-                    *xs = x; *ys = y; xs ++; ys ++; len ++;
-                    
-                    eps += dx;
-                    if ((eps << 1) >= -dy) {
-                        x --;
-                        eps -= -dy;
+                    else if (k > 0) {
+                        right = -1;
                     }
                 }
             }
-        }
-    }
-
-    return len;
-}
-
-int svlDrawHelper::WarpInternals::GetLinePixelsMono8(int* idxs, int x1, int y1, int x2, int y2, const int w, const int h)
-{
-    const int stride = w;
-
-    if (x1 == x2 && y1 == y2) {
-
-        if (x1 >= 0 && x1 < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x1;
-        else *idxs = -1;
 
-        return 1;
-    }
-
-    int x = x1, y = y1, dx, dy = y2 - y1, eps = 0, len = 0;
-
-    if (y1 == y2) {
-    // Horizontal line
-        if (x2 > x1) {
-            for (x = x1; x <= x2; x ++) {
-                if (x >= 0 && x < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        else {
-            for (x = x1; x >= x2; x --) {
-                if (x >= 0 && x < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        return len;
-    }
-    else if (x1 == x2) {
-    // Vertical line
-        if (y2 > y1) {
-            for (y = y1; y <= y2; y ++) {
-                if (x1 >= 0 && x1 < w && y >= 0 && y < h) *idxs = y * stride + x1;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        else {
-            for (y = y1; y >= y2; y --) {
-                if (x1 >= 0 && x1 < w && y >= 0 && y < h) *idxs = y * stride + x1;
-                else *idxs = -1;
-                idxs ++; len ++;
+            if (left > right) {
+                left  = 0;
+                right = -1;
             }
+            SpanLeft[idx + t]  = static_cast<int>(left);
+            SpanRight[idx + t] = static_cast<int>(right);
         }
-        return len;
     }
 
-    if (x1 < x2) {
-
-        dx = x2 - x1;
+    // Tiles intersecting the spans are owned by the threads in a diagonal
+    // pattern fixed to the image; each pixel is always written by the same
+    // thread, regardless of the order and extent of the triangles
+    int tx, ty, tx_from, tx_to, y0, y1;
 
-        if (dy > 0) {
-            if (dx >= dy) {
-                for (x = x1; x <= x2; x ++) {
+    for (ty = top / WARP_TILE_SIZE; ty <= bottom / WARP_TILE_SIZE; ty ++) {
+        y0 = ty * WARP_TILE_SIZE;
+        y1 = y0 + WARP_TILE_SIZE - 1;
+        if (y0 < top) y0 = top;
+        if (y1 > bottom) y1 = bottom;
 
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) >= dx) {
-                        y ++;
-                        eps -= dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y <= y2; y ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= dy) {
-                        x ++;
-                        eps -= dy;
-                    }
-                }
+        tx_from = OutWidth;
+        tx_to   = -1;
+        for (y = y0, idx = (y0 - top) * 2; y <= y1; y ++, idx += 2) {
+            for (t = 0; t < 2; t ++) {
+                if (SpanLeft[idx + t] > SpanRight[idx + t]) continue;
+                x = SpanLeft[idx + t];
+                if (x < tx_from) tx_from = x;
+                x = SpanRight[idx + t];
+                if (x > tx_to) tx_to = x;
             }
         }
-        else {
-            if (dx >= abs(dy)) {
-                for (x = x1; x <= x2; x ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) <= -dx) {
-                        y --;
-                        eps += dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y >= y2; y --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x;
-                    else *idxs = -1;
-                    idxs ++; len ++;
+        if (tx_from > tx_to) continue;
 
-                    eps += dx;
-                    if ((eps << 1) >= -dy) {
-                        x ++;
-                        eps -= -dy;
-                    }
-                }
-            }
+        tx_from /= WARP_TILE_SIZE;
+        tx_to   /= WARP_TILE_SIZE;
+        for (tx = tx_from; tx <= tx_to; tx ++) {
+            if (static_cast<unsigned int>(tx + ty) % thread_count != thread_id) continue;
+            DrawTile(tx, y0, y1, alpha);
         }
     }
-    else {
-
-        dx = x1 - x2;
-
-        if (dy > 0) {
-            if (dx >= dy) {
-                for (x = x1; x >= x2; x --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x;
-                    else *idxs = -1;
-                    idxs ++; len ++;
+}
 
-                    eps += dy;
-                    if ((eps << 1) >= dx) {
-                        y ++;
-                        eps -= dx;
-                    }
-                }
+void svlDrawHelper::WarpInternals::DrawTile(int tx, int top, int bottom, unsigned int alpha)
+{
+    const int x0 = tx * WARP_TILE_SIZE;
+    const int x1 = x0 + WARP_TILE_SIZE - 1;
+    int from[3], to[3], triangle[3];
+    int i, y, idx, l0, r0, l1, r1, count;
+
+    for (y = top, idx = (top - SpanTop) * 2; y <= bottom; y ++, idx += 2) {
+        l0 = SpanLeft[idx];
+        r0 = SpanRight[idx];
+        l1 = SpanLeft[idx + 1];
+        r1 = SpanRight[idx + 1];
+
+        // First triangle, then the parts of the second one not covered by the first
+        count = 0;
+        if (l0 <= r0) {
+            triangle[count] = 0; from[count] = l0; to[count] = r0; count ++;
+        }
+        if (l1 <= r1) {
+            if (l0 <= r0) {
+                triangle[count] = 1; from[count] = l1; to[count] = (r1 < l0 - 1) ? r1 : l0 - 1; count ++;
+                triangle[count] = 1; from[count] = (l1 > r0 + 1) ? l1 : r0 + 1; to[count] = r1; count ++;
             }
             else {
-                for (y = y1; y <= y2; y ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= dy) {
-                        x --;
-                        eps -= dy;
-                    }
-                }
+                triangle[count] = 1; from[count] = l1; to[count] = r1; count ++;
             }
         }
-        else {
-            if (dx >= abs(dy)) {
-                for (x = x1; x >= x2; x --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) <= -dx) {
-                        y --;
-                        eps += dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y >= y2; y --) {
 
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= -dy) {
-                        x --;
-                        eps -= -dy;
-                    }
-                }
-            }
+        for (i = 0; i < count; i ++) {
+            if (from[i] < x0) from[i] = x0;
+            if (to[i]   > x1) to[i]   = x1;
+            if (from[i] > to[i]) continue;
+            DrawSpan(Triangles[triangle[i]], from[i], y, to[i] - from[i] + 1, alpha);
         }
     }
-
-    return len;
 }
 
-int svlDrawHelper::WarpInternals::GetLinePixelsRGB(int* idxs, int x1, int y1, int x2, int y2, const int w, const int h)
+void svlDrawHelper::WarpInternals::DrawSpan(const Triangle & triangle, int x, int y, int length, unsigned int alpha)
 {
-    const int stride = w * 3;
-
-    if (x1 == x2 && y1 == y2) {
-
-        if (x1 >= 0 && x1 < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x1 * 3;
-        else *idxs = -1;
-
-        return 1;
+    int us[WARP_TILE_SIZE], vs[WARP_TILE_SIZE];
+    unsigned char p00[WARP_TILE_SIZE * 4], p01[WARP_TILE_SIZE * 4], p10[WARP_TILE_SIZE * 4], p11[WARP_TILE_SIZE * 4];
+    unsigned char fu[WARP_TILE_SIZE * 4], fv[WARP_TILE_SIZE * 4];
+    unsigned char upper[WARP_TILE_SIZE * 4], lower[WARP_TILE_SIZE * 4], result[WARP_TILE_SIZE * 4];
+    unsigned char valid[WARP_TILE_SIZE];
+    unsigned short weight[WARP_TILE_SIZE * 3];
+
+    const long long dx = x - triangle.OX, dy = y - triangle.OY;
+    StepCoordinates(us, vs,
+                    static_cast<int>(triangle.U + triangle.DUX * dx + triangle.DUY * dy),
+                    static_cast<int>(triangle.V + triangle.DVX * dx + triangle.DVY * dy),
+                    triangle.DUX, triangle.DVX, length);
+
+    // Color bytes per pixel; RGBA input has its alpha channel interpolated
+    // after the color bytes and is composited on RGB output
+    const bool rgba = (InPixelType == svlPixelRGBA);
+    const int bpp = (InPixelType == svlPixelMono8) ? 1 : 3;
+    const int inbpp = rgba ? 4 : bpp;
+    const int instride = InWidth * inbpp;
+    const int colorbytes = length * bpp;
+    const int bytes = colorbytes + (rgba ? length : 0);
+    // Samples are valid if the nearest input pixel is inside the image
+    const int umax = ((InWidth  - 1) << 16) + 32768;
+    const int vmax = ((InHeight - 1) << 16) + 32768;
+
+    const unsigned char *row0, *row1;
+    int i, c, j, u, v, xi, yi, o0, o1, y0, y1;
+    unsigned char wu, wv;
+    bool sampled = false;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    if (bpp == 3) {
+        // The mapping is affine, so all samples are inside the image if the
+        // first and last ones are; 3 byte pixels need one more readable byte
+        const int xlast = (InWidth  - (rgba ? 1 : 2)) << 16;
+        const int ylast = (InHeight - 1) << 16;
+        if (us[0] >= 0 && us[0] < xlast && us[length - 1] >= 0 && us[length - 1] < xlast &&
+            vs[0] >= 0 && vs[0] < ylast && vs[length - 1] >= 0 && vs[length - 1] < ylast) {
+            SampleBilinear4(result, rgba ? result + colorbytes : 0, Input, inbpp, instride, us, vs, length);
+            memset(valid, 1, length);
+            sampled = true;
+        }
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    if (!sampled) {
+        // Gather the four neighbors of each sample position
+        for (i = 0, j = 0; i < length; i ++, j += bpp) {
+            u = us[i];
+            v = vs[i];
+
+            if (u < -32768 || u >= umax || v < -32768 || v >= vmax) {
+                valid[i] = 0;
+                for (c = 0; c < bpp; c ++) {
+                    p00[j + c] = p01[j + c] = p10[j + c] = p11[j + c] = fu[j + c] = fv[j + c] = 0;
+                }
+                if (rgba) {
+                    c = colorbytes + i;
+                    p00[c] = p01[c] = p10[c] = p11[c] = fu[c] = fv[c] = 0;
+                }
+                continue;
+            }
+            valid[i] = 1;
+
+            xi = u >> 16;
+            yi = v >> 16;
+            wu = static_cast<unsigned char>(u >> 8);
+            wv = static_cast<unsigned char>(v >> 8);
+
+            o0 = (xi < 0) ? 0 : xi * inbpp;
+            o1 = (xi + 1 < InWidth) ? (xi + 1) * inbpp : (InWidth - 1) * inbpp;
+            y0 = (yi < 0) ? 0 : yi;
+            y1 = (yi + 1 < InHeight) ? yi + 1 : InHeight - 1;
+            row0 = Input + y0 * instride;
+            row1 = Input + y1 * instride;
+
+            for (c = 0; c < bpp; c ++) {
+                p00[j + c] = row0[o0 + c];
+                p01[j + c] = row0[o1 + c];
+                p10[j + c] = row1[o0 + c];
+                p11[j + c] = row1[o1 + c];
+                fu[j + c]  = wu;
+                fv[j + c]  = wv;
+            }
+            if (rgba) {
+                c = colorbytes + i;
+                p00[c] = row0[o0 + 3];
+                p01[c] = row0[o1 + 3];
+                p10[c] = row1[o0 + 3];
+                p11[c] = row1[o1 + 3];
+                fu[c]  = wu;
+                fv[c]  = wv;
+            }
+        }
+
+        // Bilinear interpolation
+        LerpBytes(upper,  p00,   p01,   fu, bytes);
+        LerpBytes(lower,  p10,   p11,   fu, bytes);
+        LerpBytes(result, upper, lower, fv, bytes);
+    }
+
+    unsigned char* output = Output + (y * OutWidth + x) * bpp;
+
+    if (!rgba && alpha == 256) {
+        // Samples outside the input image are black
+        memcpy(output, result, colorbytes);
+        return;
     }
 
-    int x = x1, y = y1, dx, dy = y2 - y1, eps = 0, len = 0;
-
-    if (y1 == y2) {
-    // Horizontal line
-        if (x2 > x1) {
-            for (x = x1; x <= x2; x ++) {
-                if (x >= 0 && x < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x * 3;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
+    // Compositing weights; opaque RGBA pixels (255) are copied
+    unsigned int a, w;
+    for (i = 0, j = 0; i < length; i ++, j += bpp) {
+        if (!valid[i]) w = 0;
+        else if (rgba) {
+            a = result[colorbytes + i];
+            w = ((a + (a >> 7)) * alpha) >> 8;
         }
-        else {
-            for (x = x1; x >= x2; x --) {
-                if (x >= 0 && x < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x * 3;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        return len;
-    }
-    else if (x1 == x2) {
-    // Vertical line
-        if (y2 > y1) {
-            for (y = y1; y <= y2; y ++) {
-                if (x1 >= 0 && x1 < w && y >= 0 && y < h) *idxs = y * stride + x1 * 3;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        else {
-            for (y = y1; y >= y2; y --) {
-                if (x1 >= 0 && x1 < w && y >= 0 && y < h) *idxs = y * stride + x1 * 3;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        return len;
+        else w = alpha;
+        for (c = 0; c < bpp; c ++) weight[j + c] = static_cast<unsigned short>(w);
     }
 
-    if (x1 < x2) {
-
-        dx = x2 - x1;
-
-        if (dy > 0) {
-            if (dx >= dy) {
-                for (x = x1; x <= x2; x ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 3;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) >= dx) {
-                        y ++;
-                        eps -= dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y <= y2; y ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 3;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= dy) {
-                        x ++;
-                        eps -= dy;
-                    }
-                }
-            }
-        }
-        else {
-            if (dx >= abs(dy)) {
-                for (x = x1; x <= x2; x ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 3;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) <= -dx) {
-                        y --;
-                        eps += dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y >= y2; y --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 3;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= -dy) {
-                        x ++;
-                        eps -= -dy;
-                    }
-                }
-            }
-        }
-    }
-    else {
-
-        dx = x1 - x2;
-
-        if (dy > 0) {
-            if (dx >= dy) {
-                for (x = x1; x >= x2; x --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 3;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) >= dx) {
-                        y ++;
-                        eps -= dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y <= y2; y ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 3;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= dy) {
-                        x --;
-                        eps -= dy;
-                    }
-                }
-            }
-        }
-        else {
-            if (dx >= abs(dy)) {
-                for (x = x1; x >= x2; x --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 3;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) <= -dx) {
-                        y --;
-                        eps += dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y >= y2; y --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 3;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= -dy) {
-                        x --;
-                        eps -= -dy;
-                    }
-                }
-            }
-        }
-    }
-
-    return len;
-}
-
-int svlDrawHelper::WarpInternals::GetLinePixelsRGBA(int* idxs, int x1, int y1, int x2, int y2, const int w, const int h)
-{
-    const int stride = w * 4;
-
-    if (x1 == x2 && y1 == y2) {
-
-        if (x1 >= 0 && x1 < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x1 * 4;
-        else *idxs = -1;
-
-        return 1;
-    }
-
-    int x = x1, y = y1, dx, dy = y2 - y1, eps = 0, len = 0;
-
-    if (y1 == y2) {
-    // Horizontal line
-        if (x2 > x1) {
-            for (x = x1; x <= x2; x ++) {
-                if (x >= 0 && x < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x * 4;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        else {
-            for (x = x1; x >= x2; x --) {
-                if (x >= 0 && x < w && y1 >= 0 && y1 < h) *idxs = y1 * stride + x * 4;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        return len;
-    }
-    else if (x1 == x2) {
-    // Vertical line
-        if (y2 > y1) {
-            for (y = y1; y <= y2; y ++) {
-                if (x1 >= 0 && x1 < w && y >= 0 && y < h) *idxs = y * stride + x1 * 4;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        else {
-            for (y = y1; y >= y2; y --) {
-                if (x1 >= 0 && x1 < w && y >= 0 && y < h) *idxs = y * stride + x1 * 4;
-                else *idxs = -1;
-                idxs ++; len ++;
-            }
-        }
-        return len;
-    }
-
-    if (x1 < x2) {
-
-        dx = x2 - x1;
-
-        if (dy > 0) {
-            if (dx >= dy) {
-                for (x = x1; x <= x2; x ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 4;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) >= dx) {
-                        y ++;
-                        eps -= dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y <= y2; y ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 4;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= dy) {
-                        x ++;
-                        eps -= dy;
-                    }
-                }
-            }
-        }
-        else {
-            if (dx >= abs(dy)) {
-                for (x = x1; x <= x2; x ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 4;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) <= -dx) {
-                        y --;
-                        eps += dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y >= y2; y --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 4;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= -dy) {
-                        x ++;
-                        eps -= -dy;
-                    }
-                }
-            }
-        }
-    }
-    else {
-
-        dx = x1 - x2;
-
-        if (dy > 0) {
-            if (dx >= dy) {
-                for (x = x1; x >= x2; x --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 4;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) >= dx) {
-                        y ++;
-                        eps -= dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y <= y2; y ++) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 4;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= dy) {
-                        x --;
-                        eps -= dy;
-                    }
-                }
-            }
-        }
-        else {
-            if (dx >= abs(dy)) {
-                for (x = x1; x >= x2; x --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 4;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dy;
-                    if ((eps << 1) <= -dx) {
-                        y --;
-                        eps += dx;
-                    }
-                }
-            }
-            else {
-                for (y = y1; y >= y2; y --) {
-
-                    if (x >= 0 && x < w && y >= 0 && y < h) *idxs = y * stride + x * 4;
-                    else *idxs = -1;
-                    idxs ++; len ++;
-
-                    eps += dx;
-                    if ((eps << 1) >= -dy) {
-                        x --;
-                        eps -= -dy;
-                    }
-                }
-            }
-        }
-    }
-
-    return len;
-}
-
-void svlDrawHelper::WarpInternals::ResampleLineMono8(int ix1, int iy1, int ix2, int iy2,
-                                                     int ox1, int oy1, int ox2, int oy2)
-{
-    int ilen = GetLinePixelsMono8(_in_idxs,  ix1, iy1, ix2, iy2, InWidth, InHeight);
-    int olen = GetLinePixelsMono8(_out_idxs, ox1, oy1, ox2, oy2, OutWidth, OutHeight);
-
-    int* in_idxs = _in_idxs;
-    int* out_idxs = _out_idxs;
-    unsigned char *in_buf, *out_buf;
-    int ipix, opix;
-
-    if (olen == 1) {
-
-        opix = *out_idxs;
-        if (opix >= 0) {
-            out_buf = Output + opix;
-
-            ipix = *in_idxs;
-            if (ipix >= 0) {
-                in_buf  = Input + ipix;
-                *out_buf = *in_buf;
-            }
-            else {
-                *out_buf = 0;
-            }
-        }
-
-        return;
-    }
-
-    int i, eps = 0;
-
-    if (ilen >= olen) {
-        for (i = 0; i < ilen; i ++) {
-            eps += olen;
-            if ((eps << 1) >= ilen) {
-
-                opix = *out_idxs;
-                if (opix >= 0) {
-                    out_buf = Output + opix;
-
-                    ipix = *in_idxs;
-                    if (ipix >= 0) {
-                        in_buf  = Input + ipix;
-                        *out_buf = *in_buf;
-                    }
-                    else {
-                        *out_buf = 0;
-                    }
-                }
-                out_idxs ++;
-
-                eps -= ilen;
-            }
-            in_idxs ++;
-        }
-    }
-    else {
-        for (i = 0; i < olen; i ++) {
-
-            opix = *out_idxs;
-            if (opix >= 0) {
-                out_buf = Output + opix;
-
-                ipix = *in_idxs;
-                if (ipix >= 0) {
-                    in_buf  = Input + ipix;
-                    *out_buf = *in_buf;
-                }
-                else {
-                    *out_buf = 0;
-                }
-            }
-            out_idxs ++;
-
-            if ((eps << 1) >= olen) {
-                eps -= olen;
-                in_idxs ++;
-            }
-            eps += ilen;
-        }
-    }
-}
-
-void svlDrawHelper::WarpInternals::ResampleLineRGB(int ix1, int iy1, int ix2, int iy2,
-                                                   int ox1, int oy1, int ox2, int oy2)
-{
-    int ilen = GetLinePixelsRGB(_in_idxs,  ix1, iy1, ix2, iy2, InWidth, InHeight);
-    int olen = GetLinePixelsRGB(_out_idxs, ox1, oy1, ox2, oy2, OutWidth, OutHeight);
-
-    int* in_idxs = _in_idxs;
-    int* out_idxs = _out_idxs;
-    unsigned char *in_buf, *out_buf;
-    int ipix, opix;
-
-    if (olen == 1) {
-
-        opix = *out_idxs;
-        if (opix >= 0) {
-            out_buf = Output + opix;
-
-            ipix = *in_idxs;
-            if (ipix >= 0) {
-                in_buf  = Input + ipix;
-                *out_buf = *in_buf; out_buf ++; in_buf ++;
-                *out_buf = *in_buf; out_buf ++; in_buf ++;
-                *out_buf = *in_buf;
-            }
-            else {
-                *out_buf = 0; out_buf ++;
-                *out_buf = 0; out_buf ++;
-                *out_buf = 0;
-            }
-        }
-
-        return;
-    }
-
-    int i, eps = 0;
-
-    if (ilen >= olen) {
-        for (i = 0; i < ilen; i ++) {
-            eps += olen;
-            if ((eps << 1) >= ilen) {
-
-                opix = *out_idxs;
-                if (opix >= 0) {
-                    out_buf = Output + opix;
-
-                    ipix = *in_idxs;
-                    if (ipix >= 0) {
-                        in_buf  = Input + ipix;
-                        *out_buf = *in_buf; out_buf ++; in_buf ++;
-                        *out_buf = *in_buf; out_buf ++; in_buf ++;
-                        *out_buf = *in_buf;
-                    }
-                    else {
-                        *out_buf = 0; out_buf ++;
-                        *out_buf = 0; out_buf ++;
-                        *out_buf = 0;
-                    }
-                }
-                out_idxs ++;
-
-                eps -= ilen;
-            }
-            in_idxs ++;
-        }
-    }
-    else {
-        for (i = 0; i < olen; i ++) {
-
-            opix = *out_idxs;
-            if (opix >= 0) {
-                out_buf = Output + opix;
-
-                ipix = *in_idxs;
-                if (ipix >= 0) {
-                    in_buf  = Input + ipix;
-                    *out_buf = *in_buf; out_buf ++; in_buf ++;
-                    *out_buf = *in_buf; out_buf ++; in_buf ++;
-                    *out_buf = *in_buf;
-                }
-                else {
-                    *out_buf = 0; out_buf ++;
-                    *out_buf = 0; out_buf ++;
-                    *out_buf = 0;
-                }
-            }
-            out_idxs ++;
-
-            if ((eps << 1) >= olen) {
-                eps -= olen;
-                in_idxs ++;
-            }
-            eps += ilen;
-        }
-    }
-}
-
-void svlDrawHelper::WarpInternals::ResampleLineRGBA(int ix1, int iy1, int ix2, int iy2,
-                                                    int ox1, int oy1, int ox2, int oy2)
-{
-    int ilen = GetLinePixelsRGBA(_in_idxs,  ix1, iy1, ix2, iy2, InWidth, InHeight);
-    int olen = GetLinePixelsRGB(_out_idxs, ox1, oy1, ox2, oy2, OutWidth, OutHeight);
-
-    int* in_idxs = _in_idxs;
-    int* out_idxs = _out_idxs;
-    unsigned char *in_buf, *out_buf;
-    int ipix, opix, aval, iaval;
-
-    if (olen == 1) {
-
-        opix = *out_idxs;
-        if (opix >= 0) {
-            out_buf = Output + opix;
-
-            ipix = *in_idxs;
-            if (ipix >= 0) {
-                in_buf  = Input + ipix;
-                aval = in_buf[3]; // alpha
-                iaval = 256 - aval; // inverse alpha
-                *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-            }
-        }
-
-        return;
-    }
-
-    int i, eps = 0;
-
-    if (ilen >= olen) {
-        for (i = 0; i < ilen; i ++) {
-            eps += olen;
-            if ((eps << 1) >= ilen) {
-
-                opix = *out_idxs;
-                if (opix >= 0) {
-                    out_buf = Output + opix;
-
-                    ipix = *in_idxs;
-                    if (ipix >= 0) {
-                        in_buf  = Input + ipix;
-                        aval = in_buf[3]; // alpha
-                        iaval = 256 - aval; // inverse alpha
-                        *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                        *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                        *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-                    }
-                }
-                out_idxs ++;
-
-                eps -= ilen;
-            }
-            in_idxs ++;
-        }
-    }
-    else {
-        for (i = 0; i < olen; i ++) {
-
-            opix = *out_idxs;
-            if (opix >= 0) {
-                out_buf = Output + opix;
-
-                ipix = *in_idxs;
-                if (ipix >= 0) {
-                    in_buf  = Input + ipix;
-                    aval = in_buf[3]; // alpha
-                    iaval = 256 - aval; // inverse alpha
-                    *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                    *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                    *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-                }
-            }
-            out_idxs ++;
-
-            if ((eps << 1) >= olen) {
-                eps -= olen;
-                in_idxs ++;
-            }
-            eps += ilen;
-        }
-    }
-}
-
-void svlDrawHelper::WarpInternals::ResampleLineAlphaMono8(int ix1, int iy1, int ix2, int iy2,
-                                                          int ox1, int oy1, int ox2, int oy2,
-                                                          unsigned int alpha)
-{
-    int ilen = GetLinePixelsMono8(_in_idxs,  ix1, iy1, ix2, iy2, InWidth, InHeight);
-    int olen = GetLinePixelsMono8(_out_idxs, ox1, oy1, ox2, oy2, OutWidth, OutHeight);
-
-    int* in_idxs = _in_idxs;
-    int* out_idxs = _out_idxs;
-    unsigned char *in_buf, *out_buf;
-    int ipix, opix, aval = alpha, iaval = 256 - aval;
-
-    if (olen == 1) {
-
-        opix = *out_idxs;
-        if (opix >= 0) {
-            out_buf = Output + opix;
-
-            ipix = *in_idxs;
-            if (ipix >= 0) {
-                in_buf  = Input + ipix;
-                *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-            }
-//            else {
-//                *out_buf = (iaval * (int)(*out_buf)) >> 8;
-//            }
-        }
-
-        return;
-    }
-
-    int i, eps = 0;
-
-    if (ilen >= olen) {
-        for (i = 0; i < ilen; i ++) {
-            eps += olen;
-            if ((eps << 1) >= ilen) {
-
-                opix = *out_idxs;
-                if (opix >= 0) {
-                    out_buf = Output + opix;
-
-                    ipix = *in_idxs;
-                    if (ipix >= 0) {
-                        in_buf  = Input + ipix;
-                        *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-                    }
-//                    else {
-//                        *out_buf = (iaval * (int)(*out_buf)) >> 8;
-//                    }
-                }
-                out_idxs ++;
-
-                eps -= ilen;
-            }
-            in_idxs ++;
-        }
-    }
-    else {
-        for (i = 0; i < olen; i ++) {
-
-            opix = *out_idxs;
-            if (opix >= 0) {
-                out_buf = Output + opix;
-
-                ipix = *in_idxs;
-                if (ipix >= 0) {
-                    in_buf  = Input + ipix;
-                    *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-                }
-//                else {
-//                    *out_buf = (iaval * (int)(*out_buf)) >> 8;
-//                }
-            }
-            out_idxs ++;
-
-            if ((eps << 1) >= olen) {
-                eps -= olen;
-                in_idxs ++;
-            }
-            eps += ilen;
-        }
-    }
-}
-
-void svlDrawHelper::WarpInternals::ResampleLineAlphaRGB(int ix1, int iy1, int ix2, int iy2,
-                                                        int ox1, int oy1, int ox2, int oy2,
-                                                        unsigned int alpha)
-{
-    int ilen = GetLinePixelsRGB(_in_idxs,  ix1, iy1, ix2, iy2, InWidth, InHeight);
-    int olen = GetLinePixelsRGB(_out_idxs, ox1, oy1, ox2, oy2, OutWidth, OutHeight);
-
-    int* in_idxs = _in_idxs;
-    int* out_idxs = _out_idxs;
-    unsigned char *in_buf, *out_buf;
-    int ipix, opix, aval = alpha, iaval = 256 - aval;
-
-    if (olen == 1) {
-
-        opix = *out_idxs;
-        if (opix >= 0) {
-            out_buf = Output + opix;
-
-            ipix = *in_idxs;
-            if (ipix >= 0) {
-                in_buf  = Input + ipix;
-                *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-            }
-//            else {
-//                *out_buf = (iaval * (int)(*out_buf)) >> 8; out_buf ++;
-//                *out_buf = (iaval * (int)(*out_buf)) >> 8; out_buf ++;
-//                *out_buf = (iaval * (int)(*out_buf)) >> 8;
-//            }
-        }
-
-        return;
-    }
-
-    int i, eps = 0;
-
-    if (ilen >= olen) {
-        for (i = 0; i < ilen; i ++) {
-            eps += olen;
-            if ((eps << 1) >= ilen) {
-
-                opix = *out_idxs;
-                if (opix >= 0) {
-                    out_buf = Output + opix;
-
-                    ipix = *in_idxs;
-                    if (ipix >= 0) {
-                        in_buf  = Input + ipix;
-                        *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                        *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                        *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-                    }
-//                    else {
-//                        *out_buf = (iaval * (int)(*out_buf)) >> 8; out_buf ++;
-//                        *out_buf = (iaval * (int)(*out_buf)) >> 8; out_buf ++;
-//                        *out_buf = (iaval * (int)(*out_buf)) >> 8;
-//                    }
-                }
-                out_idxs ++;
-
-                eps -= ilen;
-            }
-            in_idxs ++;
-        }
-    }
-    else {
-        for (i = 0; i < olen; i ++) {
-
-            opix = *out_idxs;
-            if (opix >= 0) {
-                out_buf = Output + opix;
-
-                ipix = *in_idxs;
-                if (ipix >= 0) {
-                    in_buf  = Input + ipix;
-                    *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                    *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8; out_buf ++; in_buf ++;
-                    *out_buf = (aval * (int)(*in_buf) + iaval * (int)(*out_buf)) >> 8;
-                }
-//                else {
-//                    *out_buf = (iaval * (int)(*out_buf)) >> 8; out_buf ++;
-//                    *out_buf = (iaval * (int)(*out_buf)) >> 8; out_buf ++;
-//                    *out_buf = (iaval * (int)(*out_buf)) >> 8;
-//                }
-            }
-            out_idxs ++;
-
-            if ((eps << 1) >= olen) {
-                eps -= olen;
-                in_idxs ++;
-            }
-            eps += ilen;
-        }
-    }
-}
-
-void svlDrawHelper::WarpInternals::AllocateBuffers(unsigned int vertices, unsigned int size)
-{
-    ReleaseBuffers();
-
-    _ilen     = new int[vertices];
-    _olen     = new int[vertices];
-    _in_idxs  = new int[size];
-    _out_idxs = new int[size];
-    _lm_x     = new int[size];
-    _rm_x     = new int[size];
-    _lm_id    = new int[size];
-    _rm_id    = new int[size];
-    _lm_pos   = new int[size];
-    _rm_pos   = new int[size];
-
-    _ixs.SetSize(vertices);
-    _iys.SetSize(vertices);
-    _oxs.SetSize(vertices);
-    _oys.SetSize(vertices);
-
-    for (unsigned int i = 0; i < vertices; i ++) {
-        _ixs[i] = new int[size];
-        _iys[i] = new int[size];
-        _oxs[i] = new int[size];
-        _oys[i] = new int[size];
-    }
-}
-
-void svlDrawHelper::WarpInternals::ReleaseBuffers()
-{
-    if (_ilen) {
-        delete [] _ilen;
-        _ilen = 0;
-    }
-    if (_olen) {
-        delete [] _olen;
-        _olen = 0;
-    }
-    if (_in_idxs) {
-        delete [] _in_idxs;
-        _in_idxs = 0;
-    }
-    if (_out_idxs) {
-        delete [] _out_idxs;
-        _out_idxs = 0;
-    }
-    if (_lm_x) {
-        delete [] _lm_x;
-        _lm_x = 0;
-    }
-    if (_rm_x) {
-        delete [] _rm_x;
-        _rm_x = 0;
-    }
-    if (_lm_id) {
-        delete [] _lm_id;
-        _lm_id = 0;
-    }
-    if (_rm_id) {
-        delete [] _rm_id;
-        _rm_id = 0;
-    }
-    if (_lm_pos) {
-        delete [] _lm_pos;
-        _lm_pos = 0;
-    }
-    if (_rm_pos) {
-        delete [] _rm_pos;
-        _rm_pos = 0;
-    }
-
-    for (unsigned int i = 0; i < _ixs.size(); i ++) {
-        if (_ixs[i]) {
-            delete [] _ixs[i];
-            _ixs[i] = 0;
-        }
-    }
-    for (unsigned int i = 0; i < _iys.size(); i ++) {
-        if (_iys[i]) {
-            delete [] _iys[i];
-            _iys[i] = 0;
-        }
-    }
-    for (unsigned int i = 0; i < _oxs.size(); i ++) {
-        if (_oxs[i]) {
-            delete [] _oxs[i];
-            _oxs[i] = 0;
-        }
-    }
-    for (unsigned int i = 0; i < _oys.size(); i ++) {
-        if (_oys[i]) {
-            delete [] _oys[i];
-            _oys[i] = 0;
-        }
-    }
+    BlendBytes(output, result, weight, colorbytes);
 }
 
@@ -81,6 +81,13 @@ namespace svlDrawHelper
     // Warping //
     /////////////
 
+    // Piecewise-affine warping: the output triangle (a quad is split into
+    // the triangles 1-2-3 and 1-3-4) is rasterized in tiles; every pixel
+    // whose center is inside or on the edge of the output polygon is
+    // bilinearly sampled from the input image at the affine mapped position.
+    // Tiles are distributed among the threads calling Draw with the same
+    // arguments; results do not depend on the number of threads.
+    // Input coordinates have to be within [-16384, 16383].
     class WarpInternals : public svlDrawInternals
     {
     public:
@@ -99,26 +106,32 @@ namespace svlDrawHelper
                   unsigned int alpha = 256);
 
     private:
-        int GetLinePixels(int* xs, int* ys, int x1, int y1, int x2, int y2);
-
-        int  GetLinePixelsMono8(int* idxs, int x1, int y1, int x2, int y2, const int w, const int h);
-        int  GetLinePixelsRGB  (int* idxs, int x1, int y1, int x2, int y2, const int w, const int h);
-        int  GetLinePixelsRGBA (int* idxs, int x1, int y1, int x2, int y2, const int w, const int h);
-
-        void ResampleLineMono8(int ix1, int iy1, int ix2, int iy2, int ox1, int oy1, int ox2, int oy2);
-        void ResampleLineRGB  (int ix1, int iy1, int ix2, int iy2, int ox1, int oy1, int ox2, int oy2);
-        void ResampleLineRGBA (int ix1, int iy1, int ix2, int iy2, int ox1, int oy1, int ox2, int oy2);
-
-        void ResampleLineAlphaMono8(int ix1, int iy1, int ix2, int iy2, int ox1, int oy1, int ox2, int oy2, unsigned int alpha);
-        void ResampleLineAlphaRGB  (int ix1, int iy1, int ix2, int iy2, int ox1, int oy1, int ox2, int oy2, unsigned int alpha);
-
-        void AllocateBuffers(unsigned int vertices, unsigned int size);
-        void ReleaseBuffers();
+        typedef struct _Triangle {
+            bool Valid;
+            // Pixel (x, y) is inside if EA[i] * x + EB[i] * y + EC[i] >= 0 for all edges
+            long long EA[3], EB[3], EC[3];
+            int Top, Bottom;            // output rows
+            // Input position of output pixel (x, y) in 16.16 fixed point:
+            //   U + DUX * (x - OX) + DUY * (y - OY), V + DVX * (x - OX) + DVY * (y - OY)
+            int OX, OY;
+            int U, V;
+            int DUX, DUY, DVX, DVY;
+        } Triangle;
+
+        bool CheckFormats(unsigned int alpha) const;
+        void SetupTriangle(Triangle & triangle,
+                           int ix1, int iy1, int ix2, int iy2, int ix3, int iy3,
+                           int ox1, int oy1, int ox2, int oy2, int ox3, int oy3);
+        void Rasterize(unsigned int thread_count, unsigned int thread_id, unsigned int alpha);
+        void DrawTile(int tx, int top, int bottom, unsigned int alpha);
+        void DrawSpan(const Triangle & triangle, int x, int y, int length, unsigned int alpha);
 
     private:
         // Default constructor is disabled
         WarpInternals();
 
+        unsigned int Vertices;
+
         unsigned char* Input;
         svlPixelType InPixelType;
         int InWidth;
@@ -129,21 +142,13 @@ namespace svlDrawHelper
         int OutWidth;
         int OutHeight;
 
-        int* _ilen;
-        int* _olen;
-        int* _in_idxs;
-        int* _out_idxs;
-        int* _lm_x;
-        int* _rm_x;
-        int* _lm_id;
-        int* _rm_id;
-        int* _lm_pos;
-        int* _rm_pos;
-
-        vctDynamicVector<int*> _ixs;
-        vctDynamicVector<int*> _iys;
-        vctDynamicVector<int*> _oxs;
-        vctDynamicVector<int*> _oys;
+        Triangle Triangles[2];
+        unsigned int TriangleCount;
+
+        // Pixel spans of the triangles in each output row, empty if left > right
+        vctDynamicVector<int> SpanLeft;
+        vctDynamicVector<int> SpanRight;
+        int SpanTop;
     };
 };
 
@@ -0,0 +1,146 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlFileMap.h"
+
+#if (CISST_OS == CISST_WINDOWS)
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+svlFileMap::svlFileMap() :
+    Data(0),
+    Length(0)
+{
+#if (CISST_OS == CISST_WINDOWS)
+    FileHandle = INVALID_HANDLE_VALUE;
+    MappingHandle = 0;
+#else
+    FileDescriptor = -1;
+#endif
+}
+
+// Copies are not mapped, like copies of svlFile are not open
+svlFileMap::svlFileMap(const svlFileMap& CMN_UNUSED(map)) :
+    Data(0),
+    Length(0)
+{
+#if (CISST_OS == CISST_WINDOWS)
+    FileHandle = INVALID_HANDLE_VALUE;
+    MappingHandle = 0;
+#else
+    FileDescriptor = -1;
+#endif
+}
+
+svlFileMap::~svlFileMap()
+{
+    Close();
+}
+
+int svlFileMap::Open(const std::string& filepath)
+{
+    Close();
+
+#if (CISST_OS == CISST_WINDOWS)
+
+    FileHandle = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, 0);
+    if (FileHandle == INVALID_HANDLE_VALUE) return SVL_FAIL;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(FileHandle, &size) || size.QuadPart < 1 ||
+        static_cast<unsigned long long>(size.QuadPart) > static_cast<size_t>(-1)) {
+        Close();
+        return SVL_FAIL;
+    }
+    MappingHandle = CreateFileMappingA(FileHandle, 0, PAGE_READONLY, 0, 0, 0);
+    if (!MappingHandle) {
+        Close();
+        return SVL_FAIL;
+    }
+    Data = reinterpret_cast<const unsigned char*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!Data) {
+        Close();
+        return SVL_FAIL;
+    }
+    Length = size.QuadPart;
+
+#else
+
+    FileDescriptor = open(filepath.c_str(), O_RDONLY);
+    if (FileDescriptor < 0) return SVL_FAIL;
+
+    struct stat status;
+    if (fstat(FileDescriptor, &status) != 0 || status.st_size < 1 ||
+        static_cast<unsigned long long>(status.st_size) > static_cast<size_t>(-1)) {
+        Close();
+        return SVL_FAIL;
+    }
+    void* data = mmap(0, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, FileDescriptor, 0);
+    if (data == MAP_FAILED) {
+        Close();
+        return SVL_FAIL;
+    }
+    // Frames are looked up in arbitrary order
+    madvise(data, static_cast<size_t>(status.st_size), MADV_RANDOM);
+    Data = reinterpret_cast<const unsigned char*>(data);
+    Length = status.st_size;
+
+#endif
+
+    return SVL_OK;
+}
+
+void svlFileMap::Close()
+{
+#if (CISST_OS == CISST_WINDOWS)
+    if (Data) UnmapViewOfFile(Data);
+    if (MappingHandle) CloseHandle(MappingHandle);
+    if (FileHandle != INVALID_HANDLE_VALUE) CloseHandle(FileHandle);
+    MappingHandle = 0;
+    FileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (Data) munmap(const_cast<unsigned char*>(Data), static_cast<size_t>(Length));
+    if (FileDescriptor >= 0) close(FileDescriptor);
+    FileDescriptor = -1;
+#endif
+
+    Data = 0;
+    Length = 0;
+}
+
+bool svlFileMap::IsOpen() const
+{
+    return Data != 0;
+}
+
+const unsigned char* svlFileMap::GetPointer() const
+{
+    return Data;
+}
+
+long long int svlFileMap::GetLength() const
+{
+    return Length;
+}
+
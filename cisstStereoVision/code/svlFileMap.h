@@ -0,0 +1,59 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlFileMap_h
+#define _svlFileMap_h
+
+#include <cisstStereoVision/svlTypes.h>
+
+
+// Read-only memory mapping of a whole file.
+// Pages are loaded by the operating system on first access, so random
+// access to large files does not need seeking or intermediate buffers.
+// Open fails if the file does not fit in the address space (e.g. files
+// larger than 2 GB in 32 bit processes); callers shall fall back to
+// svlFile in that case.
+class svlFileMap
+{
+public:
+    svlFileMap();
+    svlFileMap(const svlFileMap& map);
+    ~svlFileMap();
+
+    int Open(const std::string& filepath);
+    void Close();
+    bool IsOpen() const;
+
+    const unsigned char* GetPointer() const;
+    long long int GetLength() const;
+
+private:
+    const unsigned char* Data;
+    long long int Length;
+
+#if (CISST_OS == CISST_WINDOWS)
+    void* FileHandle;
+    void* MappingHandle;
+#else
+    int FileDescriptor;
+#endif
+
+    svlFileMap& operator=(const svlFileMap&);
+};
+
+#endif // _svlFileMap_h
+
@@ -101,6 +101,7 @@ int svlFilterAddLatency::Initialize(svlSample* syncInput, svlSample* &syncOutput
     case svlTypeTargets:
     case svlTypeText:
     case svlTypeBlobs:
+    case svlTypeImagePyramid:
         CMN_LOG_CLASS_INIT_ERROR << "Initialize: input type \"" << GetInput()->GetType() << "\" not supported" << std::endl;
         return SVL_INVALID_INPUT_TYPE;
     }
@@ -40,6 +40,7 @@ svlFilterBase::svlFilterBase() :
     Initialized(false),
     Running(false),
     AutoType(false),
+    InputModified(true),
     PrevInputTimestamp(-1.0)
 {
 }
@@ -78,6 +79,30 @@ bool svlFilterBase::IsRunning() const
     return Running;
 }
 
+double svlFilterBase::GetBarrierWaitTime() const
+{
+    if (BarrierWaitTime.size() == 0) return 0.0;
+    return BarrierWaitTime.SumOfElements() / (BarrierWaitTime.size() * (FrameCounter + 1.0));
+}
+
+double svlFilterBase::GetBarrierWaitTime(unsigned int threadid) const
+{
+    if (threadid >= BarrierWaitTime.size()) return 0.0;
+    return BarrierWaitTime[threadid];
+}
+
+double svlFilterBase::GetProcessTime() const
+{
+    if (ProcessTime.size() == 0) return 0.0;
+    return ProcessTime.SumOfElements() / (ProcessTime.size() * (FrameCounter + 1.0));
+}
+
+double svlFilterBase::GetProcessTime(unsigned int threadid) const
+{
+    if (threadid >= ProcessTime.size()) return 0.0;
+    return ProcessTime[threadid];
+}
+
 unsigned int svlFilterBase::GetFrameCounter() const
 {
     return FrameCounter;
@@ -192,6 +217,16 @@ void svlFilterBase::SetAutomaticOutputType(bool autotype)
     AutoType = autotype;
 }
 
+void svlFilterBase::SetInputModified(bool modified)
+{
+    InputModified = modified;
+}
+
+bool svlFilterBase::IsInputModified(void) const
+{
+    return InputModified;
+}
+
 void svlFilterBase::SetEnable(const bool & enable)
 {
     Enabled = enable;
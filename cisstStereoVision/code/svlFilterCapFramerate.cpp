@@ -67,6 +67,7 @@ svlFilterBase(),
     AddInputType("input", svlTypeTargets);
     AddInputType("input", svlTypeText);
     AddInputType("input", svlTypeBlobs);
+    AddInputType("input", svlTypeImagePyramid);
 
     AddOutput("output", true);
     SetAutomaticOutputType(true);
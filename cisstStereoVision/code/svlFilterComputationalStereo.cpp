@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include "svlStereoDP.h"
 #include "svlStereoDPMono.h"
+#include "svlStereoBlockMatching.h"
 
 
 /*******************************************/
@@ -131,6 +132,21 @@ int svlFilterComputationalStereo::Initialize(svlSample* syncInput, svlSample* &s
             }
         break;
 
+        case BlockMatching:
+            // Checks left-right consistency without a second pass on mirrored images
+            StereoAlgorithm = new svlStereoBlockMatching(w1, h1,
+                                                         ROI,
+                                                         MinDisparity,
+                                                         MaxDisparity,
+                                                         static_cast<int>(Geometry.GetIntrinsics(SVL_RIGHT).cc[0] -
+                                                                          Geometry.GetIntrinsics(SVL_LEFT ).cc[0]),
+                                                         ScaleFactor,
+                                                         BlockSize,
+                                                         NarrowedSearchRadius,
+                                                         SubpixelPrecision,
+                                                         XCheckEnabled);
+        break;
+
         default:
         break;
     }
@@ -140,7 +156,7 @@ int svlFilterComputationalStereo::Initialize(svlSample* syncInput, svlSample* &s
         return SVL_STEREO_INIT_ERROR;
     }
 
-    if (XCheckEnabled) {
+    if (XCheckEnabled && Method != BlockMatching) {
         // allocate cress check image sample
         if (inputtype == svlTypeImageRGBStereo) XCheckImage = new svlSampleImageRGBStereo;
         else if (inputtype == svlTypeImageMono8Stereo) XCheckImage = new svlSampleImageMono8Stereo;
@@ -203,6 +219,33 @@ int svlFilterComputationalStereo::Process(svlProcInfo* procInfo, svlSample* sync
 
     svlSampleImage* stimg = dynamic_cast<svlSampleImage*>(syncInput);
 
+    if (Method == BlockMatching) {
+
+        // Stereo: computing disparity map on all threads
+        if (StereoAlgorithm->Process(procInfo, stimg, DisparityBuffer.Pointer()) != 0) return SVL_FAIL;
+
+        _SynchronizeThreads(procInfo);
+
+        _OnSingleThread(procInfo) {
+            // Inconsistent disparities have been removed by the method
+            if (XCheckEnabled) FillDisparityHoles();
+
+            ConvertDisparitiesToFloat(DisparityBuffer.Pointer(),
+                                      OutputMatrix->GetPointer(),
+                                      static_cast<int>(OutputMatrix->GetCols()),
+                                      static_cast<int>(OutputMatrix->GetRows()));
+
+            if (SpatialFilterRadius > 0) ApplySpatialFilter(SpatialFilterRadius,
+                                                            OutputMatrix->GetPointer(ROI.left, ROI.top),
+                                                            SpatialFilterBuffer.Pointer(ROI.top, ROI.left),
+                                                            ROI.right - ROI.left,
+                                                            ROI.bottom - ROI.top,
+                                                            static_cast<int>(OutputMatrix->GetCols()));
+        }
+
+        return SVL_OK;
+    }
+
     // Process data
     if (procInfo->count == 1 || procInfo->ID == 1) {
         if (XCheckEnabled) {
@@ -423,9 +466,11 @@ unsigned int svlFilterComputationalStereo::GetSpatialFiltering()
     return SpatialFilterRadius;
 }
 
-void svlFilterComputationalStereo::SetMethod(svlFilterComputationalStereo::StereoMethod method)
+int svlFilterComputationalStereo::SetMethod(svlFilterComputationalStereo::StereoMethod method)
 {
+    if (IsInitialized()) return SVL_FAIL;
     Method = method;
+    return SVL_OK;
 }
 
 svlFilterComputationalStereo::StereoMethod svlFilterComputationalStereo::GetMethod()
@@ -451,7 +496,7 @@ void svlFilterComputationalStereo::PerformXCheck()
 {
     const int width = static_cast<int>(DisparityBuffer.width()) - 1;
     const int height = static_cast<int>(DisparityBuffer.height()) - 1;
-    int i, j, k, r, l, from, to, dispmin, disp, prevdisp;
+    int i, j, r, l;
 
     // find occlusions and inconsistencies
     if (SubpixelPrecision) {
@@ -472,13 +517,21 @@ void svlFilterComputationalStereo::PerformXCheck()
             }
         }
     }
+
+    FillDisparityHoles();
+}
+
+void svlFilterComputationalStereo::FillDisparityHoles()
+{
+    int i, j, k, from, to, dispmin, disp, prevdisp;
+
     // fill holes
-    for (j = ROI.top - 1; j <= ROI.bottom; j ++) {
+    for (j = std::max(ROI.top - 1, 0); j <= ROI.bottom; j ++) {
         from = 0x7FFFFFFF;
         to = -1;
         prevdisp = 0x7FFFFFFF;
         dispmin = 0x7FFFFFFF;
-        for (i = ROI.left - 1; i <= ROI.right; i ++) {
+        for (i = std::max(ROI.left - 1, 0); i <= ROI.right; i ++) {
             disp = DisparityBuffer.Element(j, i);
             if (disp == 0x7FFFFFFF) {
                 if (from == 0x7FFFFFFF) {
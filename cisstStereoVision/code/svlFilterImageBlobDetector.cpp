@@ -130,13 +130,27 @@ int svlFilterImageBlobDetector::Process(svlProcInfo* procInfo, svlSample* syncIn
     unsigned int videochannels = img->GetVideoChannels();
     unsigned int idx;
 
-    _ParallelLoop(procInfo, idx, videochannels)
-    {
-        if (videochannels == 1) {
-            svlImageProcessing::LabelBlobs(dynamic_cast<svlSampleImageMono8*>(img),
-                                           dynamic_cast<svlSampleImageMono32*>(OutputBlobIDs),
-                                           DetectorInternals[idx]);
-            if (BlobsOutputConnected) {
+    // Labeling is split into image strips among all threads
+    if (videochannels == 1) {
+        svlImageProcessing::LabelBlobs(procInfo,
+                                       dynamic_cast<svlSampleImageMono8*>(img),
+                                       dynamic_cast<svlSampleImageMono32*>(OutputBlobIDs),
+                                       DetectorInternals[SVL_LEFT]);
+    }
+    else {
+        svlImageProcessing::LabelBlobs(procInfo,
+                                       dynamic_cast<svlSampleImageMono8Stereo*>(img),
+                                       dynamic_cast<svlSampleImageMono32Stereo*>(OutputBlobIDs),
+                                       DetectorInternals[SVL_LEFT],
+                                       DetectorInternals[SVL_RIGHT]);
+    }
+
+    if (BlobsOutputConnected) {
+        _SynchronizeThreads(procInfo);
+
+        _ParallelLoop(procInfo, idx, videochannels)
+        {
+            if (videochannels == 1) {
                 svlImageProcessing::GetBlobsFromLabels(dynamic_cast<svlSampleImageMono8*>(img),
                                                        dynamic_cast<svlSampleImageMono32*>(OutputBlobIDs),
                                                        OutputBlobs,
@@ -146,13 +160,7 @@ int svlFilterImageBlobDetector::Process(svlProcInfo* procInfo, svlSample* syncIn
                                                        FiltMinCompactness,
                                                        FiltMaxCompactness);
             }
-        }
-        else {
-            svlImageProcessing::LabelBlobs(dynamic_cast<svlSampleImageMono8Stereo*>(img),
-                                           dynamic_cast<svlSampleImageMono32Stereo*>(OutputBlobIDs),
-                                           idx,
-                                           DetectorInternals[idx]);
-            if (BlobsOutputConnected) {
+            else {
                 svlImageProcessing::GetBlobsFromLabels(dynamic_cast<svlSampleImageMono8Stereo*>(img),
                                                        dynamic_cast<svlSampleImageMono32Stereo*>(OutputBlobIDs),
                                                        OutputBlobs,
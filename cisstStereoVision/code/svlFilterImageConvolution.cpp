@@ -63,7 +63,8 @@ svlFilterImageConvolution::svlFilterImageConvolution() :
 void svlFilterImageConvolution::SetKernel(const vctDynamicMatrix<double> & kernel)
 {
     Kernel.ForceAssign(kernel);
-    KernelSeparable = false;
+    // Rank-1 kernels (e.g. 2D Gaussian or box) are processed as two 1D passes
+    KernelSeparable = svlImageProcessing::SeparateKernel(Kernel, KernelHoriz, KernelVert);
 }
 
 void svlFilterImageConvolution::SetKernel(const vctDynamicVector<double> & kernel_horiz, const vctDynamicVector<double> & kernel_vert)
@@ -96,12 +97,17 @@ int svlFilterImageConvolution::Process(svlProcInfo* procInfo, svlSample* syncInp
     unsigned int videochannels = img->GetVideoChannels();
     unsigned int idx;
 
-    _ParallelLoop(procInfo, idx, videochannels)
-    {
-        if (KernelSeparable) {
-            svlImageProcessing::Convolution(img, idx, OutputImage, idx, KernelHoriz, KernelVert, AbsoluteResults);
+    if (KernelSeparable) {
+        // All threads work on each video channel
+        for (idx = 0; idx < videochannels; idx ++) {
+            if (svlImageProcessing::Convolution(procInfo, img, idx, OutputImage, idx, KernelHoriz, KernelVert, AbsoluteResults, ConvolutionInternals[idx]) != SVL_OK) {
+                return SVL_FAIL;
+            }
         }
-        else {
+    }
+    else {
+        _ParallelLoop(procInfo, idx, videochannels)
+        {
             svlImageProcessing::Convolution(img, idx, OutputImage, idx, Kernel, AbsoluteResults);
         }
     }
@@ -21,6 +21,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstStereoVision/svlFilterImageCropper.h>
 #include <cisstStereoVision/svlImageProcessing.h>
+#include <cisstStereoVision/svlSamplePool.h>
 
 
 /******************************************/
@@ -48,6 +49,7 @@ svlFilterImageCropper::svlFilterImageCropper() :
 
     AddOutput("output", true);
     SetAutomaticOutputType(true);
+    SetInputModified(false);
 
     Enabled.SetAll(false);
 }
@@ -125,7 +127,7 @@ int svlFilterImageCropper::Initialize(svlSample* syncInput, svlSample* &syncOutp
 {
     Release();
 
-    OutputImage = dynamic_cast<svlSampleImage*>(syncInput->GetNewInstance());
+    OutputImage = dynamic_cast<svlSampleImage*>(svlSamplePool::GetInstance()->Acquire(syncInput->GetType()));
 
     svlSampleImage* input = dynamic_cast<svlSampleImage*>(syncInput);
 
@@ -163,7 +165,7 @@ int svlFilterImageCropper::Process(svlProcInfo* procInfo, svlSample* syncInput,
 int svlFilterImageCropper::Release()
 {
     if (OutputImage) {
-        delete OutputImage;
+        svlSamplePool::GetInstance()->Release(OutputImage);
         OutputImage = 0;
     }
 
@@ -21,6 +21,9 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstStereoVision/svlFilterImageFileWriter.h>
 #include <cisstStereoVision/svlConverters.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 
 #include <string.h>
 
@@ -33,7 +36,15 @@ CMN_IMPLEMENT_SERVICES_DERIVED(svlFilterImageFileWriter, svlFilterBase)
 
 svlFilterImageFileWriter::svlFilterImageFileWriter() :
     svlFilterBase(),
-    TimestampsEnabled(false)
+    TimestampsEnabled(false),
+    EncoderThreadCount(0),
+    QueueLength(8),
+    Policy(QueueBlock),
+    NewFrameEvent(0),
+    FrameDoneEvent(0),
+    KillEncoderThreads(false),
+    EncoderError(false),
+    NextSequence(0)
 {
     AddInput("input", true);
     AddInputType("input", svlTypeImageRGB);
@@ -41,6 +52,7 @@ svlFilterImageFileWriter::svlFilterImageFileWriter() :
 
     AddOutput("output", true);
     SetAutomaticOutputType(true);
+    SetInputModified(false);
 
     ImageCodec.SetSize(2);
     FilePathPrefix.SetSize(2);
@@ -52,6 +64,8 @@ svlFilterImageFileWriter::svlFilterImageFileWriter() :
 
     // Continuous saving by default
     CaptureLength = -1;
+
+    ResetAsyncStatistics();
 }
 
 svlFilterImageFileWriter::~svlFilterImageFileWriter()
@@ -76,6 +90,11 @@ int svlFilterImageFileWriter::Initialize(svlSample* syncInput, svlSample* &syncO
         }
     }
 
+    if (EncoderThreadCount > 0 && StartEncoderThreads(img) != SVL_OK) {
+        Release();
+        return SVL_FAIL;
+    }
+
     syncOutput = syncInput;
 
     return SVL_OK;
@@ -89,6 +108,19 @@ int svlFilterImageFileWriter::Process(svlProcInfo* procInfo, svlSample* syncInpu
     if (CaptureLength == 0) return SVL_OK;
 
     svlSampleImage* img = dynamic_cast<svlSampleImage*>(syncOutput);
+
+    if (EncoderThreadCount > 0) {
+        int ret = SVL_OK;
+
+        // Encoding happens on the encoder threads
+        _OnSingleThread(procInfo)
+        {
+            ret = Enqueue(img);
+        }
+
+        return ret;
+    }
+
     unsigned int videochannels = img->GetVideoChannels();
     unsigned int idx;
 
@@ -96,21 +128,10 @@ int svlFilterImageFileWriter::Process(svlProcInfo* procInfo, svlSample* syncInpu
     {
         if (Disabled[idx]) continue;
 
-        std::stringstream path;
-        path << FilePathPrefix[idx];
-
-        if (TimestampsEnabled) {
-            path.precision(3);
-            path << std::fixed << syncInput->GetTimestamp();
-        }
-        else {
-            path.fill('0');
-            path << std::setw(7) << FrameCounter << std::setw(1);
-        }
-
-        path << "." << Extension[idx];
+        std::string path;
+        GetFilePath(path, idx, syncInput->GetTimestamp());
 
-        if (ImageCodec[idx]->Write(*img, idx, path.str(), Compression[idx]) != SVL_OK) return SVL_FAIL;
+        if (ImageCodec[idx]->Write(*img, idx, path, Compression[idx]) != SVL_OK) return SVL_FAIL;
     }
 
     _SynchronizeThreads(procInfo);
@@ -125,6 +146,8 @@ int svlFilterImageFileWriter::Process(svlProcInfo* procInfo, svlSample* syncInpu
 
 int svlFilterImageFileWriter::Release()
 {
+    StopEncoderThreads();
+
     for (unsigned int i = 0; i < ImageCodec.size(); i ++) {
         svlImageIO::ReleaseCodec(ImageCodec[i]);
         ImageCodec[i] = 0;
@@ -190,3 +213,244 @@ void svlFilterImageFileWriter::Record(int frames)
     CaptureLength = frames;
 }
 
+int svlFilterImageFileWriter::SetAsync(unsigned int threads, unsigned int queuelength, QueuePolicy policy)
+{
+    if (IsInitialized() == true)
+        return SVL_ALREADY_INITIALIZED;
+    if (threads > 0 && queuelength < 1)
+        return SVL_FAIL;
+
+    EncoderThreadCount = threads;
+    QueueLength = queuelength;
+    Policy = policy;
+
+    return SVL_OK;
+}
+
+void svlFilterImageFileWriter::GetAsyncStatistics(AsyncStatistics & stats)
+{
+    QueueCS.Enter();
+    stats = Statistics;
+    stats.AvgEncodeTime = (Statistics.FramesWritten > 0) ? TotalEncodeTime / Statistics.FramesWritten : 0.0;
+    QueueCS.Leave();
+}
+
+void svlFilterImageFileWriter::ResetAsyncStatistics()
+{
+    QueueCS.Enter();
+    // The current depth is a state, not a statistic
+    const unsigned int depth = (Queue.empty()) ? 0 : Statistics.QueueDepth;
+    memset(&Statistics, 0, sizeof(AsyncStatistics));
+    Statistics.QueueDepth = depth;
+    Statistics.MaxQueueDepth = depth;
+    TotalEncodeTime = 0.0;
+    QueueCS.Leave();
+}
+
+void svlFilterImageFileWriter::GetFilePath(std::string & path, const unsigned int videoch, const double timestamp) const
+{
+    std::stringstream strpath;
+    strpath << FilePathPrefix[videoch];
+
+    if (TimestampsEnabled) {
+        strpath.precision(3);
+        strpath << std::fixed << timestamp;
+    }
+    else {
+        strpath.fill('0');
+        strpath << std::setw(7) << FrameCounter << std::setw(1);
+    }
+
+    strpath << "." << Extension[videoch];
+
+    path = strpath.str();
+}
+
+int svlFilterImageFileWriter::Enqueue(svlSampleImage* image)
+{
+    const unsigned int videochannels = image->GetVideoChannels();
+    unsigned int i, idx;
+
+    QueueCS.Enter();
+
+    while (1) {
+        if (EncoderError) {
+            QueueCS.Leave();
+            return SVL_FAIL;
+        }
+
+        for (idx = 0; idx < Queue.size(); idx ++) {
+            if (Queue[idx].State == QueueSlot::Free) break;
+        }
+        if (idx < Queue.size()) break;
+
+        if (Policy == QueueDropNewest) {
+            Statistics.FramesDropped ++;
+            QueueCS.Leave();
+            return SVL_OK;
+        }
+
+        // Back-pressure: wait for an encoder thread to finish a frame
+        QueueCS.Leave();
+        FrameDoneEvent->Wait(0.005);
+        QueueCS.Enter();
+    }
+
+    QueueCS.Leave();
+
+    // Encoder threads only take queued slots, so the free slot
+    // can be filled without holding the lock
+    QueueSlot & slot = Queue[idx];
+    if (slot.Image->CopyOf(image) != SVL_OK) return SVL_FAIL;
+    for (i = 0; i < videochannels; i ++) {
+        if (Disabled[i]) slot.Paths[i].clear();
+        else GetFilePath(slot.Paths[i], i, image->GetTimestamp());
+    }
+
+    QueueCS.Enter();
+    slot.Sequence = NextSequence ++;
+    slot.State = QueueSlot::Queued;
+    Statistics.QueueDepth ++;
+    if (Statistics.QueueDepth > Statistics.MaxQueueDepth) Statistics.MaxQueueDepth = Statistics.QueueDepth;
+    QueueCS.Leave();
+
+    NewFrameEvent->Raise();
+
+    if (CaptureLength > 0) CaptureLength --;
+
+    return SVL_OK;
+}
+
+int svlFilterImageFileWriter::StartEncoderThreads(svlSampleImage* image)
+{
+    const unsigned int videochannels = image->GetVideoChannels();
+    unsigned int i, j;
+
+    Queue.resize(QueueLength);
+    for (i = 0; i < QueueLength; i ++) {
+        Queue[i].State = QueueSlot::Free;
+        Queue[i].Sequence = 0;
+        Queue[i].Image = dynamic_cast<svlSampleImage*>(image->GetNewInstance());
+        Queue[i].Image->SetSize(*image);
+        Queue[i].Paths.resize(videochannels);
+    }
+
+    // Codecs keep state while writing, so each thread has its own
+    EncoderCodecs.resize(EncoderThreadCount);
+    for (i = 0; i < EncoderThreadCount; i ++) {
+        EncoderCodecs[i].SetSize(videochannels);
+        EncoderCodecs[i].SetAll(0);
+        for (j = 0; j < videochannels; j ++) {
+            EncoderCodecs[i][j] = svlImageIO::GetCodec("." + Extension[j]);
+            if (EncoderCodecs[i][j] == 0) return SVL_FAIL;
+        }
+    }
+
+    KillEncoderThreads = false;
+    EncoderError       = false;
+    NextSequence       = 0;
+    NewFrameEvent      = new osaThreadSignal;
+    FrameDoneEvent     = new osaThreadSignal;
+    ResetAsyncStatistics();
+
+    EncoderThreads.resize(EncoderThreadCount);
+    for (i = 0; i < EncoderThreadCount; i ++) {
+        EncoderThreads[i] = new osaThread;
+        EncoderThreads[i]->Create<svlFilterImageFileWriter, int>(this, &svlFilterImageFileWriter::EncoderProc, static_cast<int>(i));
+    }
+
+    return SVL_OK;
+}
+
+void svlFilterImageFileWriter::StopEncoderThreads()
+{
+    unsigned int i, j;
+
+    // The threads write all queued frames before exiting
+    QueueCS.Enter();
+    KillEncoderThreads = true;
+    QueueCS.Leave();
+
+    for (i = 0; i < EncoderThreads.size(); i ++) {
+        NewFrameEvent->Raise();
+        EncoderThreads[i]->Wait();
+        delete EncoderThreads[i];
+    }
+    EncoderThreads.clear();
+
+    delete NewFrameEvent;
+    delete FrameDoneEvent;
+    NewFrameEvent  = 0;
+    FrameDoneEvent = 0;
+
+    for (i = 0; i < EncoderCodecs.size(); i ++) {
+        for (j = 0; j < EncoderCodecs[i].size(); j ++) {
+            svlImageIO::ReleaseCodec(EncoderCodecs[i][j]);
+        }
+    }
+    EncoderCodecs.clear();
+
+    for (i = 0; i < Queue.size(); i ++) delete Queue[i].Image;
+    Queue.clear();
+}
+
+void* svlFilterImageFileWriter::EncoderProc(int param)
+{
+    vctDynamicVector<svlImageCodecBase*> & codecs = EncoderCodecs[param];
+    unsigned int i, videochannels;
+    int idx, ret;
+    double time;
+
+    while (1) {
+
+        QueueCS.Enter();
+
+        // Oldest queued frame first
+        idx = -1;
+        for (i = 0; i < Queue.size(); i ++) {
+            if (Queue[i].State == QueueSlot::Queued &&
+                (idx < 0 || Queue[i].Sequence < Queue[idx].Sequence)) idx = static_cast<int>(i);
+        }
+
+        if (idx < 0) {
+            const bool kill = KillEncoderThreads;
+            QueueCS.Leave();
+            if (kill) break;
+            NewFrameEvent->Wait(0.01);
+            continue;
+        }
+
+        Queue[idx].State = QueueSlot::Encoding;
+        QueueCS.Leave();
+
+        QueueSlot & slot = Queue[idx];
+        videochannels = slot.Image->GetVideoChannels();
+        ret = SVL_OK;
+
+        time = osaGetTime();
+        for (i = 0; i < videochannels; i ++) {
+            if (slot.Paths[i].empty()) continue;
+            if (codecs[i]->Write(*slot.Image, i, slot.Paths[i], Compression[i]) != SVL_OK) ret = SVL_FAIL;
+        }
+        time = osaGetTime() - time;
+
+        QueueCS.Enter();
+        slot.State = QueueSlot::Free;
+        Statistics.QueueDepth --;
+        if (ret == SVL_OK) {
+            Statistics.FramesWritten ++;
+            TotalEncodeTime += time;
+            if (time > Statistics.MaxEncodeTime) Statistics.MaxEncodeTime = time;
+        }
+        else {
+            CMN_LOG_CLASS_RUN_ERROR << "EncoderProc: failed to write frame #" << slot.Sequence << std::endl;
+            EncoderError = true;
+        }
+        QueueCS.Leave();
+
+        FrameDoneEvent->Raise();
+    }
+
+    return this;
+}
+
@@ -276,6 +276,7 @@ int svlFilterImageFlipRotate::Process(svlProcInfo* procInfo, svlSample* syncInpu
             case svlTypeText:
             case svlTypeCameraGeometry:
             case svlTypeBlobs:
+            case svlTypeImagePyramid:
                 return SVL_FAIL;
         }
     }
@@ -23,6 +23,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterInput.h>
 #include <cisstStereoVision/svlFilterOutput.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
+#include "svlOverlayLayer.h"
 
 
 /***************************************/
@@ -48,7 +49,10 @@ svlFilterImageOverlay::svlFilterImageOverlay() :
     TextInputsToAdd(10),
     OverlaysToAdd(10),
     EnableInputSync(true),
-    EnableTransformSync(true)
+    EnableTransformSync(true),
+    EnableCaching(false),
+    CacheBlack(0),
+    CacheWhite(0)
 {
     svlFilterBase::AddInput("input", true);
     AddInputType("input", svlTypeImageRGB);
@@ -76,6 +80,9 @@ svlFilterImageOverlay::~svlFilterImageOverlay()
             iterxform->second.signal = 0;
         }
     }
+    if (CacheBlack) delete CacheBlack;
+    if (CacheWhite) delete CacheWhite;
+
     // TO DO: this needs to be fixed sometime
 /*
     while (FirstOverlay) {
@@ -333,6 +340,16 @@ bool svlFilterImageOverlay::GetEnableTransformSync() const
     return EnableTransformSync;
 }
 
+void svlFilterImageOverlay::SetEnableCaching(bool enabled)
+{
+    EnableCaching = enabled;
+}
+
+bool svlFilterImageOverlay::GetEnableCaching() const
+{
+    return EnableCaching;
+}
+
 int svlFilterImageOverlay::Initialize(svlSample* syncInput, svlSample* &syncOutput)
 {
     syncOutput = syncInput;
@@ -344,9 +361,12 @@ int svlFilterImageOverlay::Process(svlProcInfo* procInfo, svlSample* syncInput,
     syncOutput = syncInput;
     _SkipIfDisabled();
 
+    svlSampleImage* src_image = dynamic_cast<svlSampleImage*>(syncInput);
+
     _OnSingleThread(procInfo)
     {
         double current_time = syncInput->GetTimestamp();
+        DrawSteps.clear();
 
         // Add queued inputs and overlays in a thread safe manner
         if (ImageInputsToAddUsed  ||
@@ -401,7 +421,6 @@ int svlFilterImageOverlay::Process(svlProcInfo* procInfo, svlSample* syncInput,
         TransformCS.Leave();
 
         _SampleCacheMap::iterator itersample;
-        svlSampleImage* src_image = dynamic_cast<svlSampleImage*>(syncInput);
         svlOverlayInput* overlayinput = 0;
         svlFilterInput* input = 0;
         svlSample* ovrlsample = 0;
@@ -440,7 +459,7 @@ int svlFilterImageOverlay::Process(svlProcInfo* procInfo, svlSample* syncInput,
                             if (EnableInputSync && overlayinput->GetInputSynchronized()) {
                                 if (ovrlsample->GetTimestamp() >= current_time) {
                                 // Sample is most recent
-                                    overlay->Draw(src_image, ovrlsample);
+                                    AddDrawStep(overlay, src_image, ovrlsample);
                                 }
                                 else {
                                 // Sample is not recent
@@ -452,11 +471,11 @@ int svlFilterImageOverlay::Process(svlProcInfo* procInfo, svlSample* syncInput,
                                            EnableInputSync &&
                                            overlayinput->GetInputSynchronized() &&
                                            (!ovrlsample || ovrlsample->GetTimestamp() < current_time));
-                                    if (IsRunning()) overlay->Draw(src_image, ovrlsample);
+                                    if (IsRunning()) AddDrawStep(overlay, src_image, ovrlsample);
                                 }
                             }
                             else {
-                                overlay->Draw(src_image, ovrlsample);
+                                AddDrawStep(overlay, src_image, ovrlsample);
                             }
                         }
                     }
@@ -464,16 +483,89 @@ int svlFilterImageOverlay::Process(svlProcInfo* procInfo, svlSample* syncInput,
             }
             else {
             // Overlays without input
-                overlay->Draw(src_image, 0);
+                AddDrawStep(overlay, src_image, 0);
             }
 
             overlay = overlay->Next;
         }
     }
 
+    _SynchronizeThreads(procInfo);
+
+    const unsigned int stepcount = static_cast<unsigned int>(DrawSteps.size());
+    const unsigned int videochannels = src_image->GetVideoChannels();
+    unsigned int first = 0, last, i, vch, from, to;
+
+    // Draw the overlays in order, cached ones in batches
+    while (first < stepcount) {
+        last = first;
+        if (DrawSteps[first].layer) {
+            while (last < stepcount && DrawSteps[last].layer) last ++;
+
+            // Each thread composites a horizontal band of all video channels
+            for (vch = 0; vch < videochannels; vch ++) {
+                _GetParallelSubRange(procInfo, src_image->GetHeight(vch), from, to);
+                for (i = first; i < last; i ++) {
+                    DrawSteps[i].layer->Composite(src_image, vch, from, to);
+                }
+            }
+        }
+        else {
+            while (last < stepcount && !DrawSteps[last].layer) last ++;
+
+            _OnSingleThread(procInfo)
+            {
+                for (i = first; i < last; i ++) {
+                    DrawSteps[i].overlay->Draw(src_image, DrawSteps[i].input);
+                }
+            }
+        }
+        first = last;
+
+        if (first < stepcount) _SynchronizeThreads(procInfo);
+    }
+
     return SVL_OK;
 }
 
+void svlFilterImageOverlay::AddDrawStep(svlOverlay* overlay, svlSampleImage* image, svlSample* input)
+{
+    DrawStep step;
+    step.overlay = overlay;
+    step.input   = input;
+    step.layer   = 0;
+
+    if (EnableCaching && overlay->Visible && overlay->IsCacheable()) {
+        if (overlay->Modified) {
+            // Draw directly until the overlay stops changing
+            overlay->Modified = false;
+            if (overlay->Layer) overlay->Layer->Invalidate();
+        }
+        else {
+            if (!overlay->Layer) overlay->Layer = new svlOverlayLayer;
+            if (!overlay->Layer->IsValid(image)) {
+                if (!svlOverlayLayer::IsSameSize(CacheBlack, image)) {
+                    if (CacheBlack) delete CacheBlack;
+                    if (CacheWhite) delete CacheWhite;
+                    CacheBlack = dynamic_cast<svlSampleImage*>(image->GetNewInstance());
+                    CacheWhite = dynamic_cast<svlSampleImage*>(image->GetNewInstance());
+                    CacheBlack->SetSize(*image);
+                    CacheWhite->SetSize(*image);
+                    svlOverlayLayer::Fill(CacheBlack, 0);
+                    svlOverlayLayer::Fill(CacheWhite, 255);
+                }
+                // Rasterize overlay; Build restores the background values
+                overlay->Draw(CacheBlack, 0);
+                overlay->Draw(CacheWhite, 0);
+                overlay->Layer->Build(CacheBlack, CacheWhite);
+            }
+            step.layer = overlay->Layer;
+        }
+    }
+
+    DrawSteps.push_back(step);
+}
+
 void svlFilterImageOverlay::OnStop()
 {
     // Remove overlay objects that we didn't have a chance to remove earlier
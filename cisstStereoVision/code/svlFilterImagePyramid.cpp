@@ -0,0 +1,160 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstStereoVision/svlFilterImagePyramid.h>
+#include <cisstStereoVision/svlSamplePool.h>
+#include <cisstStereoVision/svlFilterInput.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+
+
+/******************************************/
+/*** svlFilterImagePyramid class **********/
+/******************************************/
+
+CMN_IMPLEMENT_SERVICES_DERIVED(svlFilterImagePyramid, svlFilterBase)
+
+svlFilterImagePyramid::svlFilterImagePyramid() :
+    svlFilterBase(),
+    OutputPyramid(0),
+    Levels(4),
+    Filter(svlImageProcessing::PY_Gaussian)
+{
+    CreateInterfaces();
+
+    AddInput("input", true);
+    AddInputType("input", svlTypeImageRGB);
+    AddInputType("input", svlTypeImageMono8);
+    AddInputType("input", svlTypeImageRGBStereo);
+    AddInputType("input", svlTypeImageMono8Stereo);
+
+    AddOutput("output", true);
+}
+
+svlFilterImagePyramid::~svlFilterImagePyramid()
+{
+    Release();
+}
+
+int svlFilterImagePyramid::SetLevels(const unsigned int levels)
+{
+    if (IsInitialized() == true || levels < 1) return SVL_FAIL;
+    Levels = levels;
+    return SVL_OK;
+}
+
+unsigned int svlFilterImagePyramid::GetLevels() const
+{
+    return Levels;
+}
+
+void svlFilterImagePyramid::SetFilter(const int & filter)
+{
+    if (filter != svlImageProcessing::PY_Box && filter != svlImageProcessing::PY_Gaussian) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetFilter: invalid pyramid filter (" << filter << ")" << std::endl;
+        return;
+    }
+    Filter = filter;
+}
+
+void svlFilterImagePyramid::GetFilter(int & filter) const
+{
+    filter = Filter;
+}
+
+int svlFilterImagePyramid::OnConnectInput(svlFilterInput &input, svlStreamType type)
+{
+    // Check if type is on the supported list
+    if (!input.IsTypeSupported(type)) return SVL_FAIL;
+
+    SetOutputType("output", svlTypeImagePyramid);
+
+    return SVL_OK;
+}
+
+int svlFilterImagePyramid::Initialize(svlSample* syncInput, svlSample* &syncOutput)
+{
+    Release();
+
+    svlSampleImage* inputimage = dynamic_cast<svlSampleImage*>(syncInput);
+    if (!inputimage) return SVL_FAIL;
+
+    OutputPyramid = dynamic_cast<svlSampleImagePyramid*>(svlSamplePool::GetInstance()->Acquire(svlTypeImagePyramid));
+    if (!OutputPyramid) return SVL_FAIL;
+    if (OutputPyramid->SetSize(*inputimage, Levels) != SVL_OK) return SVL_FAIL;
+
+    syncOutput = OutputPyramid;
+
+    return SVL_OK;
+}
+
+int svlFilterImagePyramid::Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput)
+{
+    syncOutput = OutputPyramid;
+    _SkipIfAlreadyProcessed(syncInput, syncOutput);
+    _SkipIfDisabled();
+
+    svlSampleImage* inputimage = dynamic_cast<svlSampleImage*>(syncInput);
+
+    _OnSingleThread(procInfo) {
+        // The pyramid follows changes of the input size
+        OutputPyramid->SetSize(*inputimage, Levels);
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    return svlImageProcessing::BuildPyramid(procInfo, inputimage, OutputPyramid,
+                                            static_cast<svlImageProcessing::PY_Filter>(Filter),
+                                            PyramidInternals);
+}
+
+int svlFilterImagePyramid::Release()
+{
+    if (OutputPyramid) {
+        svlSamplePool::GetInstance()->Release(OutputPyramid);
+        OutputPyramid = 0;
+    }
+    return SVL_OK;
+}
+
+void svlFilterImagePyramid::CreateInterfaces()
+{
+    // Add NON-QUEUED provided interface for configuration management
+    mtsInterfaceProvided* provided = AddInterfaceProvided("Settings", MTS_COMMANDS_SHOULD_NOT_BE_QUEUED);
+    if (provided) {
+        provided->AddCommandWrite(&svlFilterImagePyramid::SetLevelsCommand, this, "SetLevels");
+        provided->AddCommandWrite(&svlFilterImagePyramid::SetFilter,        this, "SetFilter");
+        provided->AddCommandRead (&svlFilterImagePyramid::GetLevelsCommand, this, "GetLevels");
+        provided->AddCommandRead (&svlFilterImagePyramid::GetFilter,        this, "GetFilter");
+    }
+}
+
+void svlFilterImagePyramid::SetLevelsCommand(const int & levels)
+{
+    if (IsInitialized()) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetLevelsCommand: failed to set level count; filter is already initialized" << std::endl;
+        return;
+    }
+    if (levels < 1 || SetLevels(static_cast<unsigned int>(levels)) != SVL_OK) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetLevelsCommand: invalid level count (" << levels << ")" << std::endl;
+    }
+}
+
+void svlFilterImagePyramid::GetLevelsCommand(int & levels) const
+{
+    levels = static_cast<int>(Levels);
+}
+
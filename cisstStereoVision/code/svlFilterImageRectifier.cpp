@@ -44,6 +44,7 @@ svlFilterImageRectifier::svlFilterImageRectifier() :
 
     AddOutput("output", true);
     SetAutomaticOutputType(true);
+    SetInputModified(false);
 }
 
 svlFilterImageRectifier::~svlFilterImageRectifier()
@@ -117,28 +118,29 @@ int svlFilterImageRectifier::Process(svlProcInfo* procInfo, svlSample* syncInput
 
     _SynchronizeThreads(procInfo);
 
-    _ParallelLoop(procInfo, idx, videochannels)
-    {
-        // Processing
+    for (idx = 0; idx < videochannels; idx ++) {
+        // Processing: the tiles of each channel are split among the threads
         table = dynamic_cast<svlImageProcessingHelper::RectificationInternals*>(Tables[idx].Get());
         if (table) {
-            svlImageProcessing::Rectify(inimg, idx, OutputImage, idx, InterpolationEnabled, Tables[idx]);
+            svlImageProcessing::Rectify(procInfo, inimg, idx, OutputImage, idx, InterpolationEnabled, Tables[idx]);
         }
         else {
-            memcpy(OutputImage->GetUCharPointer(idx), inimg->GetUCharPointer(idx), inimg->GetDataSize(idx));
+            _OnSingleThread(procInfo) {
+                memcpy(OutputImage->GetUCharPointer(idx), inimg->GetUCharPointer(idx), inimg->GetDataSize(idx));
+            }
         }
     }
 
     return SVL_OK;
 }
 
-int svlFilterImageRectifier::LoadTable(const std::string &filepath, unsigned int videoch, int exponentlen)
+int svlFilterImageRectifier::LoadTable(const std::string &filepath, unsigned int videoch, int exponentlen, bool usecache)
 {
     if (IsInitialized() == true) return SVL_ALREADY_INITIALIZED;
     if (videoch >= SVL_MAX_CHANNELS) return SVL_FAIL;
 
     svlImageProcessingHelper::RectificationInternals* table = new svlImageProcessingHelper::RectificationInternals;
-    if (!table->Load(filepath, exponentlen)) {
+    if (!table->Load(filepath, exponentlen, usecache)) {
         delete table;
         return SVL_FAIL;
     }
@@ -187,6 +189,16 @@ int svlFilterImageRectifier::SetTableFromCameraCalibration(unsigned int height,u
 
 }
 
+int svlFilterImageRectifier::SaveTable(const std::string &filepath, unsigned int videoch)
+{
+    if (videoch >= SVL_MAX_CHANNELS) return SVL_FAIL;
+
+    svlImageProcessingHelper::RectificationInternals* table = dynamic_cast<svlImageProcessingHelper::RectificationInternals*>(Tables[videoch].Get());
+    if (!table || !table->SaveCompact(filepath)) return SVL_FAIL;
+
+    return SVL_OK;
+}
+
 void svlFilterImageRectifier::EnableInterpolation(bool enable)
 {
     InterpolationEnabled = enable;
@@ -20,9 +20,11 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlFilterImageResizer.h>
-#include <cisstStereoVision/svlImageProcessing.h>
+#include <cisstStereoVision/svlSamplePool.h>
 #include <cisstStereoVision/svlFilterInput.h>
+#include <cisstStereoVision/svlFilterOutput.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <sstream>
 
 
 /******************************************/
@@ -47,13 +49,13 @@ svlFilterImageResizer::svlFilterImageResizer() :
 //    svlTypeImageMono32 and svlTypeImageMono32Stereo
 
     AddOutput("output", true);
-    SetAutomaticOutputType(true);
+    SetInputModified(false);
 
     for (unsigned int i = 0; i < 2; i ++) {
         WidthRatio[i] = HeightRatio[i] = 1.0;
         Width[i] = Height[i] = 0;
     }
-    InterpolationEnabled = false;
+    Method = svlImageProcessing::RS_Nearest;
 }
 
 svlFilterImageResizer::~svlFilterImageResizer()
@@ -71,12 +73,57 @@ int svlFilterImageResizer::SetOutputSize(unsigned int width, unsigned int height
 
 void svlFilterImageResizer::SetInterpolation(const bool & enable)
 {
-    InterpolationEnabled = enable;
+    Method = enable ? svlImageProcessing::RS_Bilinear : svlImageProcessing::RS_Nearest;
 }
 
 void svlFilterImageResizer::GetInterpolation(bool & enable) const
 {
-    enable = InterpolationEnabled;
+    enable = (Method != svlImageProcessing::RS_Nearest);
+}
+
+void svlFilterImageResizer::SetMethod(const int & method)
+{
+    if (method < svlImageProcessing::RS_Nearest || method > svlImageProcessing::RS_Area) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetMethod: invalid resizing method (" << method << ")" << std::endl;
+        return;
+    }
+    Method = method;
+}
+
+void svlFilterImageResizer::GetMethod(int & method) const
+{
+    method = Method;
+}
+
+int svlFilterImageResizer::AddScaledOutput(const std::string & name, double widthratio, double heightratio)
+{
+    if (IsInitialized() == true || name.empty() || GetOutput(name) || widthratio <= 0.0 || heightratio <= 0.0) return SVL_FAIL;
+
+    AddOutput(name, false);
+    if (GetInput()->IsConnected()) SetOutputType(name, GetInput()->GetType());
+
+    ScaledOutput output;
+    output.Name = name;
+    output.WidthRatio = widthratio;
+    output.HeightRatio = heightratio;
+    output.Image = 0;
+    ScaledOutputs.push_back(output);
+
+    return SVL_OK;
+}
+
+int svlFilterImageResizer::AddPyramidOutputs(unsigned int levels)
+{
+    if (IsInitialized() == true || levels < 1) return SVL_FAIL;
+
+    double ratio = 1.0;
+    for (unsigned int i = 1; i <= levels; i ++) {
+        std::stringstream name;
+        name << "level" << i;
+        ratio /= 2.0;
+        if (AddScaledOutput(name.str(), ratio, ratio) != SVL_OK) return SVL_FAIL;
+    }
+    return SVL_OK;
 }
 
 int svlFilterImageResizer::SetOutputRatio(double widthratio, double heightratio, unsigned int videoch)
@@ -89,6 +136,19 @@ int svlFilterImageResizer::SetOutputRatio(double widthratio, double heightratio,
     return SVL_OK;
 }
 
+int svlFilterImageResizer::OnConnectInput(svlFilterInput &input, svlStreamType type)
+{
+    // Check if type is on the supported list
+    if (!input.IsTypeSupported(type)) return SVL_FAIL;
+
+    SetOutputType("output", type);
+    for (unsigned int i = 0; i < ScaledOutputs.size(); i ++) {
+        SetOutputType(ScaledOutputs[i].Name, type);
+    }
+
+    return SVL_OK;
+}
+
 int svlFilterImageResizer::Initialize(svlSample* syncInput, svlSample* &syncOutput)
 {
     Release();
@@ -117,7 +177,7 @@ int svlFilterImageResizer::Initialize(svlSample* syncInput, svlSample* &syncOutp
             case svlTypeImageRGBStereo:
             case svlTypeImageMono8:
             case svlTypeImageMono8Stereo:
-                OutputImage = dynamic_cast<svlSampleImage*>(svlSample::GetNewFromType(type));
+                OutputImage = dynamic_cast<svlSampleImage*>(svlSamplePool::GetInstance()->Acquire(type));
             break;
 
             case svlTypeImageRGBA:          // To be added
@@ -158,6 +218,7 @@ int svlFilterImageResizer::Initialize(svlSample* syncInput, svlSample* &syncOutp
             case svlTypeText:
             case svlTypeCameraGeometry:
             case svlTypeBlobs:
+            case svlTypeImagePyramid:
             break;
         }
 
@@ -178,22 +239,41 @@ int svlFilterImageResizer::Initialize(svlSample* syncInput, svlSample* &syncOutp
         }
 
         syncOutput = OutputImage;
+        Destinations.push_back(OutputImage);
     }
     else {
         syncOutput = syncInput;
     }
 
+    // Scaled outputs are only computed if connected
+    for (i = 0; i < ScaledOutputs.size(); i ++) {
+        ScaledOutput & output = ScaledOutputs[i];
+        if (!GetOutput(output.Name)->IsConnected()) continue;
+
+        output.Image = dynamic_cast<svlSampleImage*>(svlSamplePool::GetInstance()->Acquire(GetInput()->GetType()));
+        if (!output.Image) return SVL_FAIL;
+
+        for (unsigned int vch = 0; vch < numofchannels; vch ++) {
+            output.Image->SetSize(vch,
+                                  std::max(static_cast<unsigned int>(output.WidthRatio  * inputimage->GetWidth(vch)),  1u),
+                                  std::max(static_cast<unsigned int>(output.HeightRatio * inputimage->GetHeight(vch)), 1u));
+        }
+        output.Image->SetTimestamp(syncInput->GetTimestamp());
+        GetOutput(output.Name)->SetupSample(output.Image);
+        Destinations.push_back(output.Image);
+    }
+
     return SVL_OK;
 }
 
 int svlFilterImageResizer::Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput)
 {
-    if (EqualSize) {
+    if (Destinations.empty()) {
         syncOutput = syncInput;
         return SVL_OK;
     }
 
-    syncOutput = OutputImage;
+    syncOutput = EqualSize ? syncInput : OutputImage;
 
     if (IsDisabled()) {
         // Do not process; resend the last processed output sample
@@ -204,9 +284,24 @@ int svlFilterImageResizer::Process(svlProcInfo* procInfo, svlSample* syncInput,
     unsigned int videochannels = id->GetVideoChannels();
     unsigned int idx;
 
-    _ParallelLoop(procInfo, idx, videochannels)
-    {
-        svlImageProcessing::Resize(id, idx, OutputImage, idx, InterpolationEnabled, Internals[idx]);
+    // All threads work on each video channel; the output and the scaled
+    // outputs are computed together while the input is read once
+    for (idx = 0; idx < videochannels; idx ++) {
+        if (svlImageProcessing::Resize(procInfo, id, idx, Destinations, idx,
+                                       static_cast<svlImageProcessing::RS_Method>(Method),
+                                       ResizeInternals[idx]) != SVL_OK) return SVL_FAIL;
+    }
+
+    if (Destinations.size() > (EqualSize ? 0u : 1u)) {
+        _SynchronizeThreads(procInfo);
+
+        _OnSingleThread(procInfo) {
+            for (idx = 0; idx < ScaledOutputs.size(); idx ++) {
+                if (!ScaledOutputs[idx].Image) continue;
+                ScaledOutputs[idx].Image->SetTimestamp(syncInput->GetTimestamp());
+                GetOutput(ScaledOutputs[idx].Name)->PushSample(ScaledOutputs[idx].Image);
+            }
+        }
     }
 
     return SVL_OK;
@@ -215,9 +310,16 @@ int svlFilterImageResizer::Process(svlProcInfo* procInfo, svlSample* syncInput,
 int svlFilterImageResizer::Release()
 {
     if (OutputImage) {
-        delete OutputImage;
+        svlSamplePool::GetInstance()->Release(OutputImage);
         OutputImage = 0;
     }
+    for (unsigned int i = 0; i < ScaledOutputs.size(); i ++) {
+        if (ScaledOutputs[i].Image) {
+            svlSamplePool::GetInstance()->Release(ScaledOutputs[i].Image);
+            ScaledOutputs[i].Image = 0;
+        }
+    }
+    Destinations.clear();
     return SVL_OK;
 }
 
@@ -227,6 +329,7 @@ void svlFilterImageResizer::CreateInterfaces()
     mtsInterfaceProvided* provided = AddInterfaceProvided("Settings", MTS_COMMANDS_SHOULD_NOT_BE_QUEUED);
     if (provided) {
         provided->AddCommandWrite(&svlFilterImageResizer::SetInterpolation,           this, "SetInterpolation");
+        provided->AddCommandWrite(&svlFilterImageResizer::SetMethod,                  this, "SetMethod");
         provided->AddCommandWrite(&svlFilterImageResizer::SetOutputDimensionLCommand, this, "SetOutputDimension");
         provided->AddCommandWrite(&svlFilterImageResizer::SetOutputDimensionLCommand, this, "SetLeftOutputDimension");
         provided->AddCommandWrite(&svlFilterImageResizer::SetOutputDimensionRCommand, this, "SetRightOutputDimension");
@@ -234,6 +337,7 @@ void svlFilterImageResizer::CreateInterfaces()
         provided->AddCommandWrite(&svlFilterImageResizer::SetOutputRatioLCommand,     this, "SetLeftOutputRatio");
         provided->AddCommandWrite(&svlFilterImageResizer::SetOutputRatioRCommand,     this, "SetRightOutputRatio");
         provided->AddCommandRead (&svlFilterImageResizer::GetInterpolation,           this, "GetInterpolation");
+        provided->AddCommandRead (&svlFilterImageResizer::GetMethod,                  this, "GetMethod");
         provided->AddCommandRead (&svlFilterImageResizer::GetOutputDimensionLCommand, this, "GetOutputDimension");
         provided->AddCommandRead (&svlFilterImageResizer::GetOutputDimensionLCommand, this, "GetLeftOutputDimension");
         provided->AddCommandRead (&svlFilterImageResizer::GetOutputDimensionRCommand, this, "GetRightOutputDimension");
@@ -46,6 +46,7 @@ svlFilterImageSampler::svlFilterImageSampler() :
 
     AddOutput("output", true);
     SetAutomaticOutputType(true);
+    SetInputModified(false);
 
     CallbackObj = 0;
     FileHeader[0] = FileHeader[1] = 0;
@@ -285,6 +286,7 @@ int svlFilterImageSampler::Initialize(svlSample* syncInput, svlSample* &syncOutp
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
             return SVL_INVALID_INPUT_TYPE;
     }
 
@@ -387,6 +389,7 @@ int svlFilterImageSampler::Process(svlProcInfo* procInfo, svlSample* syncInput,
             case svlTypeText:
             case svlTypeCameraGeometry:
             case svlTypeBlobs:
+            case svlTypeImagePyramid:
                 return SVL_INVALID_INPUT_TYPE;
         }
 
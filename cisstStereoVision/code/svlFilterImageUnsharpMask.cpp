@@ -99,6 +99,7 @@ int svlFilterImageUnsharpMask::Initialize(svlSample* syncInput, svlSample* &sync
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
             return SVL_INVALID_INPUT_TYPE;
     }
 
@@ -120,34 +121,54 @@ int svlFilterImageUnsharpMask::Process(svlProcInfo* procInfo, svlSample* syncInp
     unsigned int videochannels = input->GetVideoChannels();
     unsigned int idx;
 
-    _ParallelLoop(procInfo, idx, videochannels)
-    {
-        if (Radius == 0 || Amount == 256) {
+    if (Radius == 0 || Amount == 256) {
+        _ParallelLoop(procInfo, idx, videochannels)
+        {
             memcpy(OutputImage->GetUCharPointer(idx), input->GetUCharPointer(idx), OutputImage->GetDataSize(idx));
-            continue;
         }
+        return SVL_OK;
+    }
 
 #if CISST_SVL_HAS_OPENCV
 
+    _ParallelLoop(procInfo, idx, videochannels)
+    {
         cvSmooth(input->IplImageRef(idx), OutputImage->IplImageRef(idx), CV_GAUSSIAN, Radius * 2 + 1);
 
-#else // CISST_SVL_HAS_OPENCV
-
-        FilterBlur(input->GetUCharPointer(idx),
+        Sharpening(input->GetUCharPointer(idx),
+                   OutputImage->GetUCharPointer(idx),
                    OutputImage->GetUCharPointer(idx),
                    input->GetWidth(idx),
-                   input->GetHeight(idx),
-                   Radius);
+                   input->GetHeight(idx));
+    }
 
-#endif // CISST_SVL_HAS_OPENCV
+#else // CISST_SVL_HAS_OPENCV
 
-        Sharpening(input->GetUCharPointer(idx),
-                   OutputImage->GetUCharPointer(idx),
+    // All threads work on each video channel, each on a strip of rows
+    unsigned int row_from, row_to, offset;
+
+    for (idx = 0; idx < videochannels; idx ++) {
+        const unsigned int height = input->GetHeight(idx);
+        _GetParallelSubRange(procInfo, height, row_from, row_to);
+        if (row_from >= row_to) continue;
+
+        FilterBlur(input->GetUCharPointer(idx),
                    OutputImage->GetUCharPointer(idx),
                    input->GetWidth(idx),
-                   input->GetHeight(idx));
+                   height,
+                   Radius,
+                   row_from, row_to);
+
+        offset = row_from * input->GetWidth(idx) * 3;
+        Sharpening(input->GetUCharPointer(idx) + offset,
+                   OutputImage->GetUCharPointer(idx) + offset,
+                   OutputImage->GetUCharPointer(idx) + offset,
+                   input->GetWidth(idx),
+                   row_to - row_from);
     }
 
+#endif // CISST_SVL_HAS_OPENCV
+
     return SVL_OK;
 }
 
@@ -189,100 +210,85 @@ int svlFilterImageUnsharpMask::SetThreshold(int threshold)
     return SVL_OK;
 }
 
-void svlFilterImageUnsharpMask::FilterBlur(unsigned char* img_in, unsigned char* img_out, const int width, const int height, int radius)
+void svlFilterImageUnsharpMask::FilterBlur(unsigned char* img_in, unsigned char* img_out, const int width, const int height, int radius, const int row_from, const int row_to)
 {
     const int rowstride = width * 3;
-    const int rs_minus2 = rowstride - 2;
 
-    int i, j, k, l;
-    int xstart, xend, ystart, yend;
+    int i, j, l, xstart, xend, ystart, yend, xcount, ycount;
     int sum_r, sum_g, sum_b, divider;
-    unsigned char *input, *OutputImage;
+    unsigned char *input, *output;
+    int *colsum;
+
+    // Sums of the columns of the window, updated with the rows entering and
+    // leaving the window, so each output pixel costs the same for any radius
+    std::vector<int> colsums(rowstride, 0);
+
+    ystart = std::max(row_from - radius, 0);
+    yend   = std::min(row_from + radius, height - 1);
+    for (l = ystart; l <= yend; l ++) {
+        input = img_in + l * rowstride;
+        for (i = 0; i < rowstride; i ++) colsums[i] += input[i];
+    }
 
-    for (j = 0; j < height; j ++) {
+    for (j = row_from; j < row_to; j ++) {
 
-        sum_r = 0;
-        sum_g = 0;
-        sum_b = 0;
-        divider = 0;
+        if (j > row_from) {
+            // Subtracting previous row
+            l = j - radius - 1;
+            if (l >= 0) {
+                input = img_in + l * rowstride;
+                for (i = 0; i < rowstride; i ++) colsums[i] -= input[i];
+            }
 
-        // Initializing region of processing
-        xstart = 0;
-        xend = radius;
-        ystart = j - radius;
-        if (ystart < 0) ystart = 0;
-        yend = j + radius;
-        if (yend >= height) yend = height - 1;
-
-        // Computing initial sum
-        for (l = ystart; l <= yend; l ++) {
-            input = img_in + l * rowstride + xstart * 3;
-            for (k = xstart; k <= xend; k ++) {
-
-                sum_r += *input;
-                input ++;
-                sum_g += *input;
-                input ++;
-                sum_b += *input;
-                input ++;
-
-                divider ++;
+            // Adding next row
+            l = j + radius;
+            if (l < height) {
+                input = img_in + l * rowstride;
+                for (i = 0; i < rowstride; i ++) colsums[i] += input[i];
             }
         }
 
-        // Setting value of first column
-        OutputImage = img_out + j * rowstride;
-        *OutputImage = sum_r / divider;
-        OutputImage ++;
-        *OutputImage = sum_g / divider;
-        OutputImage ++;
-        *OutputImage = sum_b / divider;
-        OutputImage ++;
+        ycount = std::min(j + radius, height - 1) - std::max(j - radius, 0) + 1;
 
-        // Proceeding on the rest of the line
-        for (i = 1; i < width; i ++) {
+        // Initializing region of processing
+        sum_r = sum_g = sum_b = 0;
+        xend = std::min(radius, width - 1);
+        for (i = 0, colsum = &(colsums[0]); i <= xend; i ++) {
+            sum_r += *colsum; colsum ++;
+            sum_g += *colsum; colsum ++;
+            sum_b += *colsum; colsum ++;
+        }
+        xcount = xend + 1;
+
+        output = img_out + j * rowstride;
+
+        for (i = 0; i < width; i ++) {
+
+            // Setting value
+            divider = xcount * ycount;
+            *output = sum_r / divider; output ++;
+            *output = sum_g / divider; output ++;
+            *output = sum_b / divider; output ++;
 
             // Subtracting previous column
-            xstart = i - radius - 1;
+            xstart = i - radius;
             if (xstart >= 0) {
-                input = img_in + ystart * rowstride + xstart * 3;
-                for (l = ystart; l <= yend; l ++) {
-
-                    sum_r -= *input;
-                    input ++;
-                    sum_g -= *input;
-                    input ++;
-                    sum_b -= *input;
-                    input += rs_minus2;
-
-                    divider --;
-                }
+                colsum = &(colsums[xstart * 3]);
+                sum_r -= colsum[0];
+                sum_g -= colsum[1];
+                sum_b -= colsum[2];
+                xcount --;
             }
 
             // Adding next column
-            xend = i + radius;
+            xend = i + radius + 1;
             if (xend < width) {
-                input = img_in + ystart * rowstride + xend * 3;
-                for (l = ystart; l <= yend; l ++) {
-
-                    sum_r += *input;
-                    input ++;
-                    sum_g += *input;
-                    input ++;
-                    sum_b += *input;
-                    input += rs_minus2;
-
-                    divider ++;
-                }
+                colsum = &(colsums[xend * 3]);
+                sum_r += colsum[0];
+                sum_g += colsum[1];
+                sum_b += colsum[2];
+                xcount ++;
             }
-
-            // Setting value
-            *OutputImage = sum_r / divider;
-            OutputImage ++;
-            *OutputImage = sum_g / divider;
-            OutputImage ++;
-            *OutputImage = sum_b / divider;
-            OutputImage ++;
         }
     }
 }
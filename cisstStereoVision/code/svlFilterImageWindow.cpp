@@ -78,6 +78,7 @@ svlFilterImageWindow::svlFilterImageWindow() :
 
     AddOutput("output", true);
     SetAutomaticOutputType(true);
+    SetInputModified(false);
 }
 
 svlFilterImageWindow::~svlFilterImageWindow()
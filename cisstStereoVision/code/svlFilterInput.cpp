@@ -153,6 +153,12 @@ svlSample* svlFilterInput::PullSample(bool waitfornew, double timeout)
     return Buffer->Pull(waitfornew, timeout);
 }
 
+int svlFilterInput::GetDroppedSampleCount(void)
+{
+    if (!Buffer) return SVL_FAIL;
+    return static_cast<int>(Buffer->GetDroppedSampleCount());
+}
+
 double svlFilterInput::GetTimestamp(void)
 {
     return Timestamp;
@@ -330,6 +330,21 @@ void svlFilterOutput::PushSample(const svlSample* sample)
     }
 }
 
+void svlFilterOutput::PushSharedSample(svlSample* sample)
+{
+    if (sample &&
+        Filter && Filter->Initialized &&
+        !Trunk && Connected && !Blocked) {
+
+        // Stream branches hold a reference to the pooled sample instead of a copy
+        if (Connection->Trunk) BranchSource->PushSharedSample(sample);
+        else if (Connection->Buffer) Connection->Buffer->Push(sample);
+
+        // Store timestamp
+        Timestamp = sample->GetTimestamp();
+    }
+}
+
 double svlFilterOutput::GetTimestamp(void)
 {
     return Timestamp;
@@ -59,9 +59,11 @@ svlFilterSampler::svlFilterSampler() :
     AddInputType("input", svlTypeTargets);
     AddInputType("input", svlTypeText);
     AddInputType("input", svlTypeBlobs);
+    AddInputType("input", svlTypeImagePyramid);
 
     AddOutput("output", true);
     SetAutomaticOutputType(true);
+    SetInputModified(false);
 }
 
 const svlSample* svlFilterSampler::PullSample(bool waitfornew, double timeout)
@@ -22,6 +22,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterSplitter.h>
 #include <cisstStereoVision/svlFilterInput.h>
 #include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstStereoVision/svlSamplePool.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 
 
@@ -73,10 +74,12 @@ svlFilterSplitter::svlFilterSplitter() :
     AddInputType("input", svlTypeTargets);
     AddInputType("input", svlTypeText);
     AddInputType("input", svlTypeBlobs);
+    AddInputType("input", svlTypeImagePyramid);
 
     // Add the trunk output by default
     svlFilterBase::AddOutput("output", true);
     SetAutomaticOutputType(false);
+    SetInputModified(false);
 }
 
 int svlFilterSplitter::AddOutput(const std::string &name, const unsigned int threadcount, const unsigned int buffersize)
@@ -134,11 +137,20 @@ int svlFilterSplitter::Process(svlProcInfo* procInfo, svlSample* syncInput, svlS
     _SkipIfDisabled();
 
     _OnSingleThread(procInfo) {
-        // Non-trunk outputs copy the input sample into their buffers
+        // Non-trunk outputs share a single pooled copy of the input sample
+        svlSamplePool* pool = svlSamplePool::GetInstance();
+        svlSample* shared = 0;
+
         const unsigned int size = static_cast<unsigned int>(AsyncOutputs.size());
         for (unsigned int i = 0; i < size; i ++) {
-            if (AsyncOutputs[i]) AsyncOutputs[i]->PushSample(syncInput);
+            if (!AsyncOutputs[i] || !AsyncOutputs[i]->IsConnected()) continue;
+
+            if (!shared) shared = pool->AcquireCopy(syncInput);
+            if (shared) AsyncOutputs[i]->PushSharedSample(shared);
+            else AsyncOutputs[i]->PushSample(syncInput);
         }
+
+        pool->Release(shared);
     }
 
     return SVL_OK;
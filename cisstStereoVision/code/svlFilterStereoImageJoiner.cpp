@@ -22,6 +22,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterStereoImageJoiner.h>
 #include <cisstStereoVision/svlFilterInput.h>
 #include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstStereoVision/svlSamplePool.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 
 
@@ -99,11 +100,13 @@ int svlFilterStereoImageJoiner::Initialize(svlSample* syncInput, svlSample* &syn
             return SVL_FAIL;
     }
 
-    if      (GetInput()->GetType() == svlTypeImageRGBStereo)    OutputImage = new svlSampleImageRGB;
-    else if (GetInput()->GetType() == svlTypeImageMono8Stereo)  OutputImage = new svlSampleImageMono8;
-    else if (GetInput()->GetType() == svlTypeImageMono16Stereo) OutputImage = new svlSampleImageMono16;
-    else if (GetInput()->GetType() == svlTypeImageMono32Stereo) OutputImage = new svlSampleImageMono32;
+    svlStreamType outputtype;
+    if      (GetInput()->GetType() == svlTypeImageRGBStereo)    outputtype = svlTypeImageRGB;
+    else if (GetInput()->GetType() == svlTypeImageMono8Stereo)  outputtype = svlTypeImageMono8;
+    else if (GetInput()->GetType() == svlTypeImageMono16Stereo) outputtype = svlTypeImageMono16;
+    else if (GetInput()->GetType() == svlTypeImageMono32Stereo) outputtype = svlTypeImageMono32;
     else return SVL_FAIL;
+    OutputImage = dynamic_cast<svlSampleImage*>(svlSamplePool::GetInstance()->Acquire(outputtype));
     OutputImage->SetSize(width, height);
 
     syncOutput = OutputImage;
@@ -192,7 +195,7 @@ int svlFilterStereoImageJoiner::Process(svlProcInfo* procInfo, svlSample* syncIn
 int svlFilterStereoImageJoiner::Release()
 {
     if (OutputImage) {
-        delete OutputImage;
+        svlSamplePool::GetInstance()->Release(OutputImage);
         OutputImage = 0;
     }
     return SVL_OK;
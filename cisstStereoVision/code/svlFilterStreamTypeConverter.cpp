@@ -22,6 +22,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterStreamTypeConverter.h>
 #include <cisstStereoVision/svlConverters.h>
 #include <cisstStereoVision/svlFilterInput.h>
+#include <cisstStereoVision/svlSamplePool.h>
 #include <cisstStereoVision/svlFilterOutput.h>
 
 
@@ -50,7 +51,7 @@ svlFilterStreamTypeConverter::svlFilterStreamTypeConverter(svlStreamType inputty
 
 svlFilterStreamTypeConverter::~svlFilterStreamTypeConverter()
 {
-    if (OutputSample) delete OutputSample;
+    if (OutputSample) svlSamplePool::GetInstance()->Release(OutputSample);
 }
 
 int svlFilterStreamTypeConverter::SetType(svlStreamType inputtype, svlStreamType outputtype)
@@ -143,7 +144,7 @@ int svlFilterStreamTypeConverter::SetType(svlStreamType inputtype, svlStreamType
             GetOutput()->SetType(outputtype);
 
             // initializing output sample
-            OutputSample = svlSample::GetNewFromType(outputtype);
+            OutputSample = svlSamplePool::GetInstance()->Acquire(outputtype);
 
             return SVL_OK;
         }
@@ -181,7 +182,7 @@ int svlFilterStreamTypeConverter::SetType(svlStreamType inputtype, svlStreamType
             GetOutput()->SetType(outputtype);
 
             // initializing output sample
-            OutputSample = svlSample::GetNewFromType(outputtype);
+            OutputSample = svlSamplePool::GetInstance()->Acquire(outputtype);
 
             return SVL_OK;
         }
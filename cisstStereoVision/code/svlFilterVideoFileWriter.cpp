@@ -48,6 +48,7 @@ svlFilterVideoFileWriter::svlFilterVideoFileWriter() :
 
     AddOutput("output", true);
     SetAutomaticOutputType(true);
+    SetInputModified(false);
 
     UpdateCodecCount(2);
 
@@ -534,6 +535,51 @@ int svlFilterVideoFileWriter::GetCodecParams(svlVideoIO::Compression **compressi
     return SVL_OK;
 }
 
+double svlFilterVideoFileWriter::GetCompressionTime(unsigned int videoch)
+{
+    if (videoch >= Codec.size()) {
+        CMN_LOG_CLASS_INIT_ERROR << "GetCompressionTime: video channel out of range: " << videoch << std::endl;
+        return -1.0;
+    }
+
+    double time = -1.0;
+    CS.Enter();
+    if (Codec[videoch]) time = Codec[videoch]->GetCompressionTime();
+    CS.Leave();
+
+    return time;
+}
+
+double svlFilterVideoFileWriter::GetAverageCompressionTime(unsigned int videoch)
+{
+    if (videoch >= Codec.size()) {
+        CMN_LOG_CLASS_INIT_ERROR << "GetAverageCompressionTime: video channel out of range: " << videoch << std::endl;
+        return -1.0;
+    }
+
+    double time = -1.0;
+    CS.Enter();
+    if (Codec[videoch]) time = Codec[videoch]->GetAverageCompressionTime();
+    CS.Leave();
+
+    return time;
+}
+
+int svlFilterVideoFileWriter::GetClientStatistics(std::vector<svlVideoIO::ClientStatistics> &stats, unsigned int videoch)
+{
+    if (videoch >= Codec.size()) {
+        CMN_LOG_CLASS_INIT_ERROR << "GetClientStatistics: video channel out of range: " << videoch << std::endl;
+        return SVL_FAIL;
+    }
+
+    int ret = SVL_FAIL;
+    CS.Enter();
+    if (Codec[videoch]) ret = Codec[videoch]->GetClientStatistics(stats);
+    CS.Leave();
+
+    return ret;
+}
+
 int svlFilterVideoFileWriter::OpenFile(unsigned int videoch)
 {
     UpdateCodecCount(videoch + 1);
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlImageProcessing.h>
+#include <cisstStereoVision/svlSyncPoint.h>
 #include "svlImageProcessingHelper.h"
 
 
@@ -27,6 +28,50 @@ http://www.cisst.org/cisst/license.txt.
 /*** svlImageProcessing namespace ***/
 /************************************/
 
+// Mono16 and Mono32 images, single threaded; the vertical pass goes through
+// the image buffer of the internals, thus the source image is left unmodified
+// and the result ends up in dst_img
+static int ConvolutionWide(svlSampleImage* src_img, unsigned int src_videoch,
+                           svlSampleImage* dst_img, unsigned int dst_videoch,
+                           svlImageProcessingHelper::ConvolutionInternals & internals,
+                           bool absres)
+{
+    const int width  = static_cast<int>(src_img->GetWidth(src_videoch));
+    const int height = static_cast<int>(src_img->GetHeight(src_videoch));
+    unsigned char* buffer = internals.GetImageBuffer(dst_img->GetDataSize(dst_videoch));
+
+    switch (src_img->GetPixelType()) {
+        case svlPixelMono16:
+            svlImageProcessingHelper::ConvolutionMono16(reinterpret_cast<unsigned short*>(src_img->GetUCharPointer(src_videoch)),
+                                                        reinterpret_cast<unsigned short*>(dst_img->GetUCharPointer(dst_videoch)),
+                                                        width, height,
+                                                        internals.FPKernelHoriz, true, absres);
+            svlImageProcessingHelper::ConvolutionMono16(reinterpret_cast<unsigned short*>(dst_img->GetUCharPointer(dst_videoch)),
+                                                        reinterpret_cast<unsigned short*>(buffer),
+                                                        width, height,
+                                                        internals.FPKernelVert, false, absres);
+        break;
+
+        case svlPixelMono32:
+            svlImageProcessingHelper::ConvolutionMono32(reinterpret_cast<unsigned int*>(src_img->GetUCharPointer(src_videoch)),
+                                                        reinterpret_cast<unsigned int*>(dst_img->GetUCharPointer(dst_videoch)),
+                                                        width, height,
+                                                        internals.FPKernelHoriz, true, absres);
+            svlImageProcessingHelper::ConvolutionMono32(reinterpret_cast<unsigned int*>(dst_img->GetUCharPointer(dst_videoch)),
+                                                        reinterpret_cast<unsigned int*>(buffer),
+                                                        width, height,
+                                                        internals.FPKernelVert, false, absres);
+        break;
+
+        default:
+            return SVL_FAIL;
+    }
+
+    memcpy(dst_img->GetUCharPointer(dst_videoch), buffer, dst_img->GetDataSize(dst_videoch));
+
+    return SVL_OK;
+}
+
 int svlImageProcessing::Convolution(svlSampleImage* src_img, unsigned int src_videoch,
                                     svlSampleImage* dst_img, unsigned int dst_videoch,
                                     vctDynamicVector<double> kernel_horiz,
@@ -44,75 +89,76 @@ int svlImageProcessing::Convolution(svlSampleImage* src_img, unsigned int src_vi
         width  < 1 || width  != static_cast<int>(dst_img->GetWidth(dst_videoch)) ||
         height < 1 || height != static_cast<int>(dst_img->GetHeight(dst_videoch))) return SVL_FAIL;
 
-    vctDynamicVector<int> fp_kernel_horiz, fp_kernel_vert;
-    fp_kernel_horiz.SetSize(kernel_horiz.size());
-    fp_kernel_vert.SetSize(kernel_vert.size());
-    fp_kernel_horiz.Assign(kernel_horiz.Multiply(1024));
-    fp_kernel_vert.Assign(kernel_vert.Multiply(1024));
+    svlImageProcessingHelper::ConvolutionInternals internals;
+    internals.SetKernels(kernel_horiz, kernel_vert);
+    internals.SetThreadCount(1);
 
-    switch (type) {
-        case svlPixelRGB:
-            svlImageProcessingHelper::ConvolutionRGB(src_img->GetUCharPointer(src_videoch),
-                                                     dst_img->GetUCharPointer(dst_videoch),
-                                                     width, height,
-                                                     fp_kernel_horiz, true, absres);
-            svlImageProcessingHelper::ConvolutionRGB(dst_img->GetUCharPointer(dst_videoch),
-                                                     src_img->GetUCharPointer(src_videoch),
-                                                     width, height,
-                                                     fp_kernel_vert, false, absres);
-        break;
+    if (type != svlPixelRGB && type != svlPixelRGBA && type != svlPixelMono8) {
+        return ConvolutionWide(src_img, src_videoch, dst_img, dst_videoch, internals, absres);
+    }
 
-        case svlPixelRGBA:
-            svlImageProcessingHelper::ConvolutionRGBA(src_img->GetUCharPointer(src_videoch),
-                                                      dst_img->GetUCharPointer(dst_videoch),
-                                                      width, height,
-                                                      fp_kernel_horiz, true, absres);
-            svlImageProcessingHelper::ConvolutionRGBA(dst_img->GetUCharPointer(dst_videoch),
-                                                      src_img->GetUCharPointer(src_videoch),
-                                                      width, height,
-                                                      fp_kernel_vert, false, absres);
-        break;
+    svlImageProcessingHelper::ConvolutionRows8(src_img->GetUCharPointer(src_videoch),
+                                               dst_img->GetUCharPointer(dst_videoch),
+                                               width, height, static_cast<int>(src_img->GetBPP()),
+                                               0, height, internals, 0, absres);
+    return SVL_OK;
+}
 
-        case svlPixelMono8:
-            svlImageProcessingHelper::ConvolutionMono8(src_img->GetUCharPointer(src_videoch),
-                                                       dst_img->GetUCharPointer(dst_videoch),
-                                                       width, height,
-                                                       fp_kernel_horiz, true, absres);
-            svlImageProcessingHelper::ConvolutionMono8(dst_img->GetUCharPointer(dst_videoch),
-                                                       src_img->GetUCharPointer(src_videoch),
-                                                       width, height,
-                                                       fp_kernel_vert, false, absres);
-        break;
+int svlImageProcessing::Convolution(svlProcInfo* procInfo,
+                                    svlSampleImage* src_img, unsigned int src_videoch,
+                                    svlSampleImage* dst_img, unsigned int dst_videoch,
+                                    const vctDynamicVector<double> & kernel_horiz,
+                                    const vctDynamicVector<double> & kernel_vert,
+                                    bool absres,
+                                    svlImageProcessing::Internals& internals)
+{
+    if (!procInfo ||
+        !src_img || src_img->GetVideoChannels() <= src_videoch ||
+        !dst_img || dst_img->GetVideoChannels() <= dst_videoch ||
+        (src_img == dst_img && src_videoch == dst_videoch) ||
+        kernel_horiz.size() < 1 || kernel_vert.size() < 1) return SVL_FAIL;
 
-        case svlPixelMono16:
-            svlImageProcessingHelper::ConvolutionMono16(reinterpret_cast<unsigned short*>(src_img->GetUCharPointer(src_videoch)),
-                                                        reinterpret_cast<unsigned short*>(dst_img->GetUCharPointer(dst_videoch)),
-                                                        width, height,
-                                                        fp_kernel_horiz, true, absres);
-            svlImageProcessingHelper::ConvolutionMono16(reinterpret_cast<unsigned short*>(dst_img->GetUCharPointer(dst_videoch)),
-                                                        reinterpret_cast<unsigned short*>(src_img->GetUCharPointer(src_videoch)),
-                                                        width, height,
-                                                        fp_kernel_vert, false, absres);
-        break;
+    const svlPixelType type = src_img->GetPixelType();
+    const int width  = static_cast<int>(src_img->GetWidth(src_videoch));
+    const int height = static_cast<int>(src_img->GetHeight(src_videoch));
 
-        case svlPixelMono32:
-            svlImageProcessingHelper::ConvolutionMono32(reinterpret_cast<unsigned int*>(src_img->GetUCharPointer(src_videoch)),
-                                                        reinterpret_cast<unsigned int*>(dst_img->GetUCharPointer(dst_videoch)),
-                                                        width, height,
-                                                        fp_kernel_horiz, true, absres);
-            svlImageProcessingHelper::ConvolutionMono32(reinterpret_cast<unsigned int*>(dst_img->GetUCharPointer(dst_videoch)),
-                                                        reinterpret_cast<unsigned int*>(src_img->GetUCharPointer(src_videoch)),
-                                                        width, height,
-                                                        fp_kernel_vert, false, absres);
-        break;
+    if (type != dst_img->GetPixelType() ||
+        width  < 1 || width  != static_cast<int>(dst_img->GetWidth(dst_videoch)) ||
+        height < 1 || height != static_cast<int>(dst_img->GetHeight(dst_videoch))) return SVL_FAIL;
 
-        default:
-            return SVL_FAIL;
+    _OnSingleThread(procInfo) {
+        svlImageProcessingHelper::ConvolutionInternals* convolution = dynamic_cast<svlImageProcessingHelper::ConvolutionInternals*>(internals.Get());
+        if (!convolution) {
+            convolution = new svlImageProcessingHelper::ConvolutionInternals;
+            internals.Set(convolution);
+        }
+
+        // Will not do anything if neither the kernels nor the threads have changed
+        convolution->SetKernels(kernel_horiz, kernel_vert);
+        convolution->SetThreadCount(procInfo->count);
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    svlImageProcessingHelper::ConvolutionInternals* convolution = dynamic_cast<svlImageProcessingHelper::ConvolutionInternals*>(internals.Get());
+    if (!convolution) return SVL_FAIL;
+
+    if (type != svlPixelRGB && type != svlPixelRGBA && type != svlPixelMono8) {
+        _OnSingleThread(procInfo) {
+            return ConvolutionWide(src_img, src_videoch, dst_img, dst_videoch, *convolution, absres);
+        }
+        return SVL_OK;
     }
 
-    memcpy(dst_img->GetUCharPointer(dst_videoch),
-           src_img->GetUCharPointer(src_videoch),
-           src_img->GetDataSize(src_videoch));
+    // Each thread filters a strip of rows
+    unsigned int row_from, row_to;
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(height), row_from, row_to);
+
+    svlImageProcessingHelper::ConvolutionRows8(src_img->GetUCharPointer(src_videoch),
+                                               dst_img->GetUCharPointer(dst_videoch),
+                                               width, height, static_cast<int>(src_img->GetBPP()),
+                                               static_cast<int>(row_from), static_cast<int>(row_to),
+                                               *convolution, procInfo->ID, absres);
 
     return SVL_OK;
 }
@@ -173,6 +219,44 @@ int svlImageProcessing::Convolution(svlSampleImage* src_img, unsigned int src_vi
     return SVL_OK;
 }
 
+bool svlImageProcessing::SeparateKernel(const vctDynamicMatrix<double> & kernel,
+                                        vctDynamicVector<double> & kernel_horiz,
+                                        vctDynamicVector<double> & kernel_vert)
+{
+    const unsigned int rows = kernel.rows();
+    const unsigned int cols = kernel.cols();
+    if (rows < 1 || cols < 1) return false;
+
+    // The intermediate results of a separable convolution are saturated to
+    // [0, 255], so only non-negative kernels are separated; with the
+    // horizontal kernel summing to 1 the intermediate results do not saturate
+    if (kernel.MinElement() < 0.0) return false;
+    const double sum = kernel.SumOfElements();
+    if (sum <= 0.0) return false;
+
+    // Rank-1 kernel K = v * h: v is the sums of rows, h the normalized sums of columns
+    vctDynamicVector<double> horiz(cols, 0.0), vert(rows, 0.0);
+    unsigned int i, j;
+    for (j = 0; j < rows; j ++) {
+        for (i = 0; i < cols; i ++) {
+            vert[j]  += kernel.Element(j, i);
+            horiz[i] += kernel.Element(j, i) / sum;
+        }
+    }
+
+    const double tolerance = 1e-6 * kernel.MaxElement();
+    for (j = 0; j < rows; j ++) {
+        for (i = 0; i < cols; i ++) {
+            if (fabs(kernel.Element(j, i) - vert[j] * horiz[i]) > tolerance) return false;
+        }
+    }
+
+    kernel_horiz.ForceAssign(horiz);
+    kernel_vert.ForceAssign(vert);
+
+    return true;
+}
+
 int svlImageProcessing::UnsharpMask(const svlSampleImage* src_img,
                                     unsigned int src_videoch,
                                     svlSampleImage* dst_img,
@@ -459,6 +543,160 @@ int svlImageProcessing::Resize(svlSampleImage* src_img, unsigned int src_videoch
     return SVL_OK;
 }
 
+int svlImageProcessing::Resize(svlProcInfo* procInfo,
+                               svlSampleImage* src_img, unsigned int src_videoch,
+                               svlSampleImage* dst_img, unsigned int dst_videoch,
+                               svlImageProcessing::RS_Method method,
+                               svlImageProcessing::Internals& internals)
+{
+    std::vector<svlSampleImage*> dst_imgs(1, dst_img);
+    return Resize(procInfo, src_img, src_videoch, dst_imgs, dst_videoch, method, internals);
+}
+
+int svlImageProcessing::Resize(svlProcInfo* procInfo,
+                               svlSampleImage* src_img, unsigned int src_videoch,
+                               const std::vector<svlSampleImage*> & dst_imgs, unsigned int dst_videoch,
+                               svlImageProcessing::RS_Method method,
+                               svlImageProcessing::Internals& internals)
+{
+    if (!procInfo ||
+        !src_img || src_img->GetVideoChannels() <= src_videoch ||
+        (src_img->GetBPP() != 1 && src_img->GetBPP() != 3) ||
+        src_img->GetWidth(src_videoch) < 1 || src_img->GetHeight(src_videoch) < 1 ||
+        dst_imgs.empty()) return SVL_FAIL;
+
+    const unsigned int levels = static_cast<unsigned int>(dst_imgs.size());
+    unsigned int l;
+
+    for (l = 0; l < levels; l ++) {
+        if (!dst_imgs[l] || dst_imgs[l]->GetVideoChannels() <= dst_videoch ||
+            dst_imgs[l]->GetPixelType() != src_img->GetPixelType() ||
+            (dst_imgs[l] == src_img && dst_videoch == src_videoch) ||
+            dst_imgs[l]->GetWidth(dst_videoch) < 1 || dst_imgs[l]->GetHeight(dst_videoch) < 1) return SVL_FAIL;
+    }
+
+    _OnSingleThread(procInfo) {
+        svlImageProcessingHelper::ResizeInternals* resize = dynamic_cast<svlImageProcessingHelper::ResizeInternals*>(internals.Get());
+        if (!resize) {
+            resize = new svlImageProcessingHelper::ResizeInternals;
+            internals.Set(resize);
+        }
+
+        std::vector<unsigned int> widths(levels), heights(levels);
+        for (l = 0; l < levels; l ++) {
+            widths[l]  = dst_imgs[l]->GetWidth(dst_videoch);
+            heights[l] = dst_imgs[l]->GetHeight(dst_videoch);
+        }
+
+        // Will not do anything if neither the sizes, the method, nor the threads have changed
+        resize->Setup(src_img->GetWidth(src_videoch), src_img->GetHeight(src_videoch), src_img->GetBPP(),
+                      widths, heights, method, procInfo->count);
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    svlImageProcessingHelper::ResizeInternals* resize = dynamic_cast<svlImageProcessingHelper::ResizeInternals*>(internals.Get());
+    if (!resize) return SVL_FAIL;
+
+    std::vector<unsigned char*> dst_bufs(levels);
+    for (l = 0; l < levels; l ++) dst_bufs[l] = dst_imgs[l]->GetUCharPointer(dst_videoch);
+
+    // Each thread processes a range of source bands for all destinations
+    unsigned int band_from, band_to;
+    _GetParallelSubRange(procInfo, resize->GetBandCount(), band_from, band_to);
+    if (band_from < band_to) {
+        svlImageProcessingHelper::ResizeBands8(src_img->GetUCharPointer(src_videoch),
+                                               src_img->GetWidth(src_videoch),
+                                               src_img->GetBPP(),
+                                               &(dst_bufs[0]), band_from, band_to,
+                                               *resize, procInfo->ID);
+    }
+
+    return SVL_OK;
+}
+
+
+int svlImageProcessing::BuildPyramid(svlProcInfo* procInfo,
+                                     svlSampleImage* src_img,
+                                     svlSampleImagePyramid* pyramid,
+                                     svlImageProcessing::PY_Filter filter,
+                                     svlImageProcessing::Internals& internals)
+{
+    if (!procInfo || !src_img || !pyramid ||
+        pyramid->GetLevelCount() < 1 ||
+        src_img->GetPixelType() != pyramid->GetPixelType() ||
+        src_img->GetVideoChannels() != pyramid->GetVideoChannels()) return SVL_FAIL;
+
+    const unsigned int videochannels = pyramid->GetVideoChannels();
+    const unsigned int levels = pyramid->GetLevelCount();
+    const unsigned int bpp = pyramid->GetBPP();
+    unsigned int vch, l;
+
+    for (vch = 0; vch < videochannels; vch ++) {
+        if (src_img->GetWidth(vch) != pyramid->GetWidth(0, vch) ||
+            src_img->GetHeight(vch) != pyramid->GetHeight(0, vch)) return SVL_FAIL;
+    }
+
+    _OnSingleThread(procInfo) {
+        svlImageProcessingHelper::PyramidInternals* pyr = dynamic_cast<svlImageProcessingHelper::PyramidInternals*>(internals.Get());
+        if (!pyr) {
+            pyr = new svlImageProcessingHelper::PyramidInternals;
+            internals.Set(pyr);
+        }
+        pyr->SetThreadCount(procInfo->count);
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    svlImageProcessingHelper::PyramidInternals* pyr = dynamic_cast<svlImageProcessingHelper::PyramidInternals*>(internals.Get());
+    if (!pyr) return SVL_FAIL;
+
+    if (filter == PY_Box) {
+        std::vector<svlSampleImage*> dst_imgs(levels);
+        for (l = 0; l < levels; l ++) dst_imgs[l] = pyramid->GetLevel(l);
+
+        for (vch = 0; vch < videochannels; vch ++) {
+            if (Resize(procInfo, src_img, vch, dst_imgs, vch, RS_Area, pyr->ResizeInternals[vch]) != SVL_OK) return SVL_FAIL;
+        }
+        return SVL_OK;
+    }
+
+    unsigned int row_from, row_to, width, stride;
+    unsigned short* buffer;
+
+    // Level 0 is a copy of the source
+    for (vch = 0; vch < videochannels; vch ++) {
+        stride = pyramid->GetWidth(0, vch) * bpp;
+        _GetParallelSubRange(procInfo, pyramid->GetHeight(0, vch), row_from, row_to);
+        if (row_from < row_to) {
+            memcpy(pyramid->GetUCharPointer(0, vch) + row_from * stride,
+                   src_img->GetUCharPointer(vch) + row_from * stride,
+                   (row_to - row_from) * stride);
+        }
+    }
+
+    // Each level is computed from the previous one
+    for (l = 1; l < levels; l ++) {
+
+        _SynchronizeThreads(procInfo);
+
+        for (vch = 0; vch < videochannels; vch ++) {
+            width = pyramid->GetWidth(l - 1, vch);
+            buffer = pyr->GetRowBuffer(procInfo->ID, width * bpp);
+            if (!buffer) return SVL_FAIL;
+
+            _GetParallelSubRange(procInfo, pyramid->GetHeight(l, vch), row_from, row_to);
+            if (row_from < row_to) {
+                svlImageProcessingHelper::PyramidDownRows8(pyramid->GetUCharPointer(l - 1, vch), width, pyramid->GetHeight(l - 1, vch), bpp,
+                                                           pyramid->GetUCharPointer(l, vch), pyramid->GetWidth(l, vch),
+                                                           row_from, row_to, buffer);
+            }
+        }
+    }
+
+    return SVL_OK;
+}
+
 
 int svlImageProcessing::Deinterlace(svlSampleImage* image, unsigned int videoch, svlImageProcessing::DI_Algorithm algorithm)
 {
@@ -605,6 +843,11 @@ int svlImageProcessing::Rectify(svlSampleImage* src_img, unsigned int src_videoc
     unsigned char* srcimg = src_img->GetUCharPointer(src_videoch);
     unsigned char* destimg = dst_img->GetUCharPointer(dst_videoch);
 
+    if (table->IsCompact()) {
+        table->RemapTiles(srcimg, destimg, 0, table->GetTileCount(), interpolation);
+        return SVL_OK;
+    }
+
     unsigned char *srcbld1, *srcbld2, *srcbld3, *srcbld4;
     unsigned int *destidx, *srcidx1, *srcidx2, *srcidx3, *srcidx4;
     unsigned char *destr, *destg, *destb;
@@ -726,6 +969,40 @@ int svlImageProcessing::Rectify(svlSampleImage* src_img, unsigned int src_videoc
     return Rectify(src_img, src_videoch, dst_img, dst_videoch, "", interpolation, internals);
 }
 
+int svlImageProcessing::Rectify(svlProcInfo* procInfo,
+                                svlSampleImage* src_img, unsigned int src_videoch,
+                                svlSampleImage* dst_img, unsigned int dst_videoch,
+                                bool interpolation,
+                                svlImageProcessing::Internals& internals)
+{
+    svlImageProcessingHelper::RectificationInternals* table = dynamic_cast<svlImageProcessingHelper::RectificationInternals*>(internals.Get());
+
+    if (!procInfo || !table ||
+        !src_img || src_img->GetVideoChannels() <= src_videoch ||
+        !dst_img || dst_img->GetVideoChannels() <= dst_videoch ||
+        src_img->GetBPP() != 3 || dst_img->GetBPP() != 3 ||
+        table->Width  != src_img->GetWidth(src_videoch)  || table->Width  != dst_img->GetWidth(dst_videoch) ||
+        table->Height != src_img->GetHeight(src_videoch) || table->Height != dst_img->GetHeight(dst_videoch)) return SVL_FAIL;
+
+    // Tables that could not be compacted are processed on a single thread
+    if (!table->IsCompact()) {
+        _OnSingleThread(procInfo) {
+            return Rectify(src_img, src_videoch, dst_img, dst_videoch, interpolation, internals);
+        }
+        return SVL_OK;
+    }
+
+    unsigned int tile_from, tile_to;
+    const unsigned int tiles = table->GetTileCount();
+    _GetParallelSubRange(procInfo, tiles, tile_from, tile_to);
+    if (tile_from < tiles) {
+        table->RemapTiles(src_img->GetUCharPointer(src_videoch), dst_img->GetUCharPointer(dst_videoch),
+                          tile_from, tile_to, interpolation);
+    }
+
+    return SVL_OK;
+}
+
 
 int svlImageProcessing::SetExposure(svlSampleImage* image, unsigned int videoch, double brightness, double contrast, double gamma)
 {
@@ -1008,6 +1285,75 @@ unsigned int svlImageProcessing::LabelBlobs(const svlSampleImageMono8Stereo* ima
     return detector->CalculateLabels(image, labels, videoch);
 }
 
+static int LabelBlobsParallel(svlProcInfo* procInfo,
+                              svlSampleImage* image,
+                              svlSampleImage* labels,
+                              svlImageProcessing::Internals** internals,
+                              const unsigned int channels)
+{
+    svlImageProcessingHelper::BlobDetectorInternals* detectors[2];
+    unsigned int i;
+
+    if (!procInfo || !image || !labels || channels > 2) return SVL_FAIL;
+    for (i = 0; i < channels; i ++) {
+        if (image->GetWidth(i)  != labels->GetWidth(i) ||
+            image->GetHeight(i) != labels->GetHeight(i)) return SVL_FAIL;
+    }
+
+    _OnSingleThread(procInfo) {
+        for (i = 0; i < channels; i ++) {
+            svlImageProcessingHelper::BlobDetectorInternals* detector = dynamic_cast<svlImageProcessingHelper::BlobDetectorInternals*>(internals[i]->Get());
+            if (detector == 0) {
+                detector = new svlImageProcessingHelper::BlobDetectorInternals;
+                internals[i]->Set(detector);
+            }
+            detector->SetImageSize(image, i);
+            detector->SetStripCount(procInfo->count);
+        }
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    for (i = 0; i < channels; i ++) {
+        detectors[i] = dynamic_cast<svlImageProcessingHelper::BlobDetectorInternals*>(internals[i]->Get());
+        detectors[i]->LabelStrip(image, i, procInfo->ID);
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    // Channels are merged on different threads
+    for (i = 0; i < channels; i ++) {
+        if (i % procInfo->count == procInfo->ID) detectors[i]->MergeStrips();
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    for (i = 0; i < channels; i ++) {
+        detectors[i]->WriteLabels(labels, i, procInfo->ID);
+    }
+
+    return SVL_OK;
+}
+
+int svlImageProcessing::LabelBlobs(svlProcInfo* procInfo,
+                                   const svlSampleImageMono8* image,
+                                   svlSampleImageMono32* labels,
+                                   Internals& internals)
+{
+    Internals* channels[1] = { &internals };
+    return LabelBlobsParallel(procInfo, const_cast<svlSampleImageMono8*>(image), labels, channels, 1);
+}
+
+int svlImageProcessing::LabelBlobs(svlProcInfo* procInfo,
+                                   const svlSampleImageMono8Stereo* image,
+                                   svlSampleImageMono32Stereo* labels,
+                                   Internals& internals_left,
+                                   Internals& internals_right)
+{
+    Internals* channels[2] = { &internals_left, &internals_right };
+    return LabelBlobsParallel(procInfo, const_cast<svlSampleImageMono8Stereo*>(image), labels, channels, 2);
+}
+
 int svlImageProcessing::GetBlobsFromLabels(const svlSampleImageMono8* image,
                                            const svlSampleImageMono32* labels,
                                            svlSampleBlobs* blobs,
@@ -20,9 +20,18 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include "svlImageProcessingHelper.h"
+#include <cisstStereoVision/svlImageProcessing.h>
+#include "svlConvolutionSIMD.h"
 #include "cisstCommon/cmnPortability.h"
 #include <fstream>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <sys/stat.h>
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    #include <emmintrin.h>
+#endif
 
 
 /*****************************************/
@@ -488,11 +497,11 @@ void svlImageProcessingHelper::ConvolutionMono16(unsigned short* input, unsigned
 
                 if (absres) {
                     if (sum < 0) sum = -sum; if (sum > 65535) sum = 65535;
-                    *output = static_cast<unsigned char>(sum); output ++;
+                    *output = static_cast<unsigned short>(sum); output ++;
                 }
                 else {
                     if (sum < 0) sum = 0; else if (sum > 65535) sum = 65535;
-                    *output = static_cast<unsigned char>(sum); output ++;
+                    *output = static_cast<unsigned short>(sum); output ++;
                 }
             }
         }
@@ -539,11 +548,11 @@ void svlImageProcessingHelper::ConvolutionMono16(unsigned short* input, unsigned
 
                 if (absres) {
                     if (sum < 0) sum = -sum; if (sum > 65535) sum = 65535;
-                    *output = static_cast<unsigned char>(sum); output ++;
+                    *output = static_cast<unsigned short>(sum); output ++;
                 }
                 else {
                     if (sum < 0) sum = 0; else if (sum > 65535) sum = 65535;
-                    *output = static_cast<unsigned char>(sum); output ++;
+                    *output = static_cast<unsigned short>(sum); output ++;
                 }
             }
         }
@@ -600,11 +609,11 @@ void svlImageProcessingHelper::ConvolutionMono32(unsigned int* input, unsigned i
 
                 if (absres) {
                     if (sum < 0) sum = -sum;
-                    *output = static_cast<unsigned char>(sum); output ++;
+                    *output = static_cast<unsigned int>(sum); output ++;
                 }
                 else {
                     if (sum < 0) sum = 0;
-                    *output = static_cast<unsigned char>(sum); output ++;
+                    *output = static_cast<unsigned int>(sum); output ++;
                 }
             }
         }
@@ -651,11 +660,11 @@ void svlImageProcessingHelper::ConvolutionMono32(unsigned int* input, unsigned i
 
                 if (absres) {
                     if (sum < 0) sum = -sum;
-                    *output = static_cast<unsigned char>(sum); output ++;
+                    *output = static_cast<unsigned int>(sum); output ++;
                 }
                 else {
                     if (sum < 0) sum = 0;
-                    *output = static_cast<unsigned char>(sum); output ++;
+                    *output = static_cast<unsigned int>(sum); output ++;
                 }
             }
         }
@@ -1030,11 +1039,11 @@ void svlImageProcessingHelper::ConvolutionMono16(unsigned short* input, unsigned
 
             if (absres) {
                 if (sum < 0) sum = -sum; if (sum > 65535) sum = 65535;
-                *output = static_cast<unsigned char>(sum); output ++;
+                *output = static_cast<unsigned short>(sum); output ++;
             }
             else {
                 if (sum < 0) sum = 0; else if (sum > 65535) sum = 65535;
-                *output = static_cast<unsigned char>(sum); output ++;
+                *output = static_cast<unsigned short>(sum); output ++;
             }
         }
     }
@@ -1117,13 +1126,206 @@ void svlImageProcessingHelper::ConvolutionMono32(unsigned int* input, unsigned i
 
             if (absres) {
                 if (sum < 0) sum = -sum;
-                *output = static_cast<unsigned char>(sum); output ++;
+                *output = static_cast<unsigned int>(sum); output ++;
             }
             else {
                 if (sum < 0) sum = 0;
-                *output = static_cast<unsigned char>(sum); output ++;
+                *output = static_cast<unsigned int>(sum); output ++;
+            }
+        }
+    }
+}
+
+static inline unsigned char ConvolutionSaturate(int sum, bool absres)
+{
+    if (absres) {
+        if (sum < 0) sum = -sum;
+        if (sum > 255) sum = 255;
+    }
+    else {
+        if (sum < 0) sum = 0; else if (sum > 255) sum = 255;
+    }
+    return static_cast<unsigned char>(sum);
+}
+
+static void ConvolutionTaps(const unsigned char* const* taps, unsigned char* output, const int count,
+                            const int* kernel, const int kernel_size, bool symmetric, bool absres)
+{
+    // Bulk of the elements vectorized, the rest below
+    int i = static_cast<int>(svlConvolutionSIMD::Filter(taps, output, count, kernel, kernel_size, symmetric, absres));
+    const unsigned char* input;
+    int k, k_val, sum0, sum1, sum2, sum3;
+
+    // Remaining elements four at a time
+    for (; i + 4 <= count; i += 4) {
+        sum0 = sum1 = sum2 = sum3 = 0;
+        for (k = 0; k < kernel_size; k ++) {
+            input = taps[k] + i;
+            k_val = kernel[k];
+            sum0 += input[0] * k_val;
+            sum1 += input[1] * k_val;
+            sum2 += input[2] * k_val;
+            sum3 += input[3] * k_val;
+        }
+        output[i]     = ConvolutionSaturate(sum0 >> 10, absres);
+        output[i + 1] = ConvolutionSaturate(sum1 >> 10, absres);
+        output[i + 2] = ConvolutionSaturate(sum2 >> 10, absres);
+        output[i + 3] = ConvolutionSaturate(sum3 >> 10, absres);
+    }
+    for (; i < count; i ++) {
+        sum0 = 0;
+        for (k = 0; k < kernel_size; k ++) sum0 += taps[k][i] * kernel[k];
+        output[i] = ConvolutionSaturate(sum0 >> 10, absres);
+    }
+}
+
+static void ConvolutionBoxColumns(short* sums, const unsigned char* add, const unsigned char* sub, unsigned char* output,
+                                  const int count, const int coeff, bool absres)
+{
+    int i = static_cast<int>(svlConvolutionSIMD::BoxColumns(sums, add, sub, output, count, coeff, absres));
+
+    for (; i < count; i ++) {
+        sums[i] = static_cast<short>(sums[i] + add[i] - sub[i]);
+        output[i] = ConvolutionSaturate((sums[i] * coeff) >> 10, absres);
+    }
+}
+
+static void ConvolutionRow8(const unsigned char* input, unsigned char* output, const int width, const int pixelsize,
+                            svlImageProcessingHelper::ConvolutionInternals & internals, std::vector<const unsigned char*> & taps, bool absres)
+{
+    const int* kernel = internals.FPKernelHoriz.Pointer();
+    const int kernel_size = static_cast<int>(internals.FPKernelHoriz.size());
+    const int kernel_rad = kernel_size / 2;
+    int i, c, k, k_from, k_to, sum;
+
+    // Short box kernels are faster as vectorized symmetric kernels
+    if (internals.TypeHoriz == svlImageProcessingHelper::ConvolutionInternals::KernelBox &&
+        (kernel_size > 16 || !svlConvolutionSIMD::IsEnabled())) {
+
+        // Running sums over the window, all channels at once
+        const int coeff = kernel[0];
+        const unsigned char *add, *sub;
+        int sums[4] = { 0, 0, 0, 0 };
+
+        k_to = std::min(kernel_size - kernel_rad, width);
+        for (i = 0; i < k_to; i ++) {
+            for (c = 0; c < pixelsize; c ++) sums[c] += input[i * pixelsize + c];
+        }
+
+        for (i = 0; i < width; i ++) {
+            k = i + kernel_size - kernel_rad;
+            add = (k < width) ? input + k * pixelsize : 0;
+            k = i - kernel_rad;
+            sub = (k >= 0) ? input + k * pixelsize : 0;
+
+            for (c = 0; c < pixelsize; c ++) {
+                output[c] = ConvolutionSaturate((sums[c] * coeff) >> 10, absres);
+                if (add) sums[c] += add[c];
+                if (sub) sums[c] -= sub[c];
+            }
+            output += pixelsize;
+        }
+
+        return;
+    }
+
+    // Pixels for which the whole kernel is inside the image
+    int inner_from = kernel_rad;
+    int inner_to   = width - kernel_size + kernel_rad + 1;
+    if (inner_to <= inner_from) inner_from = inner_to = width;
+
+    if (inner_from < inner_to) {
+        for (k = 0; k < kernel_size; k ++) taps[k] = input + (inner_from - kernel_rad + k) * pixelsize;
+        ConvolutionTaps(&(taps[0]), output + inner_from * pixelsize, (inner_to - inner_from) * pixelsize,
+                        kernel, kernel_size,
+                        internals.TypeHoriz != svlImageProcessingHelper::ConvolutionInternals::KernelGeneric,
+                        absres);
+    }
+
+    // Pixels along the borders use the part of the kernel inside the image
+    for (i = 0; i < width; i ++) {
+        if (i == inner_from) {
+            i = inner_to - 1;
+            continue;
+        }
+
+        k_from = std::max(0, kernel_rad - i);
+        k_to   = std::min(kernel_size, width - i + kernel_rad);
+
+        for (c = 0; c < pixelsize; c ++) {
+            sum = 0;
+            for (k = k_from; k < k_to; k ++) sum += input[(i - kernel_rad + k) * pixelsize + c] * kernel[k];
+            output[i * pixelsize + c] = ConvolutionSaturate(sum >> 10, absres);
+        }
+    }
+}
+
+void svlImageProcessingHelper::ConvolutionRows8(const unsigned char* input, unsigned char* output, const int width, const int height, const int pixelsize,
+                                                const int row_from, const int row_to, ConvolutionInternals & internals, const unsigned int thread, bool absres)
+{
+    if (!input || !output || width < 1 || row_from >= row_to ||
+        internals.FPKernelHoriz.size() < 1 || internals.FPKernelVert.size() < 1) return;
+
+    const int rowstride = width * pixelsize;
+    const int kernel_size = static_cast<int>(internals.FPKernelVert.size());
+    const int kernel_rad = kernel_size / 2;
+    const int* kernel = internals.FPKernelVert.Pointer();
+
+    // Horizontally filtered rows are kept in a ring buffer covering the
+    // vertical kernel (plus the row leaving a box window) so each input
+    // row is filtered once and the vertical pass reads from cache.
+    // The extra row after the ring is a row of zeros.
+    const int slots = kernel_size + 1;
+    unsigned char* ring = internals.GetRowBuffer(thread, (slots + 1) * rowstride);
+    if (!ring) return;
+    unsigned char* zeros = ring + slots * rowstride;
+    memset(zeros, 0, rowstride);
+
+    std::vector<const unsigned char*> taps(std::max(kernel_size, static_cast<int>(internals.FPKernelHoriz.size())));
+    int i, l, l_from, l_to, next = std::max(0, row_from - kernel_rad);
+
+    for (int j = row_from; j < row_to; j ++) {
+
+        l_from = j - kernel_rad;
+        l_to   = l_from + kernel_size - 1;
+
+        // Horizontal pass on the rows entering the window
+        while (next <= l_to && next < height) {
+            ConvolutionRow8(input + next * rowstride, ring + (next % slots) * rowstride, width, pixelsize, internals, taps, absres);
+            next ++;
+        }
+
+        unsigned char* output2 = output + j * rowstride;
+
+        if (internals.TypeVert == ConvolutionInternals::KernelBox) {
+
+            // Column sums are updated with the rows entering and leaving the window
+            short* sums = internals.GetSumBuffer(thread, rowstride);
+
+            if (j == row_from) {
+                memset(sums, 0, rowstride * sizeof(short));
+                for (l = std::max(l_from, 0); l <= std::min(l_to, height - 1); l ++) {
+                    ConvolutionBoxColumns(sums, ring + (l % slots) * rowstride, zeros, output2, rowstride, kernel[0], absres);
+                }
+            }
+            else {
+                ConvolutionBoxColumns(sums,
+                                      (l_to < height) ? ring + (l_to % slots) * rowstride : zeros,
+                                      (l_from > 0) ? ring + ((l_from - 1) % slots) * rowstride : zeros,
+                                      output2, rowstride, kernel[0], absres);
             }
         }
+        else {
+
+            // Rows outside the image are left out of the kernel
+            const int k_from = std::max(0, -l_from);
+            const int k_to   = std::min(kernel_size, height - l_from);
+            for (i = k_from; i < k_to; i ++) taps[i - k_from] = ring + ((l_from + i) % slots) * rowstride;
+
+            ConvolutionTaps(&(taps[0]), output2, rowstride, kernel + k_from, k_to - k_from,
+                            internals.TypeVert == ConvolutionInternals::KernelSymmetric && k_to - k_from == kernel_size,
+                            absres);
+        }
     }
 }
 
@@ -1539,6 +1741,259 @@ void svlImageProcessingHelper::ResampleAndInterpolateVRGB24(unsigned char* src,
     }
 }
 
+// Rounds and saturates a sum of 14 bit fixed point products
+static inline unsigned char ResizeSaturate(int sum)
+{
+    sum >>= svlImageProcessingHelper::ResizeInternals::WeightShift;
+    if (sum < 0) return 0;
+    if (sum > 255) return 255;
+    return static_cast<unsigned char>(sum);
+}
+
+// Horizontal pass of the table based resampler on one source row
+static void ResizeTableColumns(const unsigned char* input, unsigned char* output, const unsigned int pixelsize,
+                               const svlImageProcessingHelper::ResizeInternals::Level & level)
+{
+    const unsigned int taps = level.TapsX;
+    const int* offset = &(level.ColumnOffset[0]);
+    const int* weight = &(level.ColumnWeight[0]);
+    const int round = 1 << (svlImageProcessingHelper::ResizeInternals::WeightShift - 1);
+    unsigned int i, k, c;
+    int s0, s1, s2;
+
+    if (taps == 1) {
+        for (i = 0; i < level.Width; i ++) {
+            for (c = 0; c < pixelsize; c ++) *output++ = input[offset[i] + c];
+        }
+    }
+    else if (pixelsize == 1) {
+        for (i = 0; i < level.Width; i ++, offset += taps, weight += taps) {
+            s0 = round;
+            for (k = 0; k < taps; k ++) s0 += weight[k] * input[offset[k]];
+            *output++ = ResizeSaturate(s0);
+        }
+    }
+    else if (pixelsize == 3) {
+        const unsigned char* pix;
+        for (i = 0; i < level.Width; i ++, offset += taps, weight += taps) {
+            s0 = s1 = s2 = round;
+            for (k = 0; k < taps; k ++) {
+                pix = input + offset[k];
+                s0 += weight[k] * pix[0];
+                s1 += weight[k] * pix[1];
+                s2 += weight[k] * pix[2];
+            }
+            *output++ = ResizeSaturate(s0);
+            *output++ = ResizeSaturate(s1);
+            *output++ = ResizeSaturate(s2);
+        }
+    }
+    else {
+        for (i = 0; i < level.Width; i ++, offset += taps, weight += taps) {
+            for (c = 0; c < pixelsize; c ++) {
+                s0 = round;
+                for (k = 0; k < taps; k ++) s0 += weight[k] * input[offset[k] + c];
+                *output++ = ResizeSaturate(s0);
+            }
+        }
+    }
+}
+
+// One destination row of the table based resampler: the horizontally
+// resampled source rows are cached per thread so that consecutive
+// destination rows sharing source rows resample them only once
+static void ResizeTableRow(const unsigned char* src, const unsigned int srcwidth, const unsigned int pixelsize,
+                           svlImageProcessingHelper::ResizeInternals::Level & level, const unsigned int row,
+                           unsigned char* output, const unsigned int thread)
+{
+    const unsigned int srcstride = srcwidth * pixelsize;
+    const unsigned int rowsize = level.Width * pixelsize;
+    const unsigned int taps = level.TapsY;
+    const int* index = &(level.RowIndex[row * taps]);
+    const int* weight = &(level.RowWeight[row * taps]);
+    const unsigned char** rows = &(level.RowPointers[thread][0]);
+    unsigned char* cache = &(level.RowCache[thread][0]);
+    int* tag = &(level.RowCacheTag[thread][0]);
+    unsigned int i, k, slot;
+    int sum;
+
+    for (k = 0; k < taps; k ++) {
+        if (level.Width == srcwidth) {
+            // No horizontal resampling
+            rows[k] = src + index[k] * srcstride;
+            continue;
+        }
+        // Source rows of a destination row are less than 'taps' apart, so they never share a slot
+        slot = static_cast<unsigned int>(index[k]) % taps;
+        if (tag[slot] != index[k]) {
+            ResizeTableColumns(src + index[k] * srcstride, cache + slot * rowsize, pixelsize, level);
+            tag[slot] = index[k];
+        }
+        rows[k] = cache + slot * rowsize;
+    }
+
+    if (taps == 1) {
+        memcpy(output, rows[0], rowsize);
+        return;
+    }
+
+    i = svlConvolutionSIMD::WeightedRows(rows, output, rowsize, weight, taps);
+    for (; i < rowsize; i ++) {
+        sum = 1 << (svlImageProcessingHelper::ResizeInternals::WeightShift - 1);
+        for (k = 0; k < taps; k ++) sum += weight[k] * rows[k][i];
+        output[i] = ResizeSaturate(sum);
+    }
+}
+
+// One destination row of the integer ratio box filter
+static void ResizeBoxRow(const unsigned char* src, const unsigned int srcwidth, const unsigned int pixelsize,
+                         svlImageProcessingHelper::ResizeInternals::Level & level, const unsigned int row,
+                         unsigned char* output, const unsigned int thread)
+{
+    const unsigned int srcstride = srcwidth * pixelsize;
+    const unsigned int fx = level.FactorX;
+    const unsigned int scale = level.BoxScale;
+    const unsigned int round = 1 << 21;
+    unsigned short* sums = &(level.ColumnSums[thread][0]);
+    const unsigned char* input = src + row * level.FactorY * srcstride;
+    const unsigned short* psum;
+    unsigned int i, j, k, c, s;
+
+    // Column sums over the rows covered by the destination row
+    memset(sums, 0, srcstride * sizeof(unsigned short));
+    for (j = 0; j < level.FactorY; j ++, input += srcstride) {
+        i = svlConvolutionSIMD::AccumulateRow(sums, input, srcstride);
+        for (; i < srcstride; i ++) sums[i] += input[i];
+    }
+
+    // Adding up 'fx' column sums, then dividing by the area
+    psum = sums;
+    if (pixelsize == 1) {
+        for (i = 0; i < level.Width; i ++) {
+            s = 0;
+            for (k = 0; k < fx; k ++) s += *psum++;
+            *output++ = static_cast<unsigned char>((s * scale + round) >> 22);
+        }
+    }
+    else {
+        for (i = 0; i < level.Width; i ++, psum += fx * pixelsize) {
+            for (c = 0; c < pixelsize; c ++) {
+                s = 0;
+                for (k = 0; k < fx; k ++) s += psum[k * pixelsize + c];
+                *output++ = static_cast<unsigned char>((s * scale + round) >> 22);
+            }
+        }
+    }
+}
+
+void svlImageProcessingHelper::ResizeBands8(const unsigned char* src, const unsigned int srcwidth, const unsigned int pixelsize,
+                                            unsigned char* const* dst, const unsigned int band_from, const unsigned int band_to,
+                                            ResizeInternals & internals, const unsigned int thread)
+{
+    const unsigned int levels = static_cast<unsigned int>(internals.Levels.size());
+    const unsigned int srcstride = srcwidth * pixelsize;
+    unsigned int b, l, j, dststride;
+
+    // Cached rows are from the previous image
+    for (l = 0; l < levels; l ++) {
+        ResizeInternals::Level & level = internals.Levels[l];
+        if (level.Type == ResizeInternals::LevelTable) {
+            std::fill(level.RowCacheTag[thread].begin(), level.RowCacheTag[thread].end(), -1);
+        }
+    }
+
+    // Every level reads the same band of source rows while it is in the cache
+    for (b = band_from; b < band_to && b < internals.GetBandCount(); b ++) {
+        for (l = 0; l < levels; l ++) {
+            ResizeInternals::Level & level = internals.Levels[l];
+            dststride = level.Width * pixelsize;
+
+            for (j = level.BandStart[b]; j < level.BandStart[b + 1]; j ++) {
+                switch (level.Type) {
+                    case ResizeInternals::LevelCopy:
+                        memcpy(dst[l] + j * dststride, src + j * srcstride, srcstride);
+                    break;
+
+                    case ResizeInternals::LevelBox:
+                        ResizeBoxRow(src, srcwidth, pixelsize, level, j, dst[l] + j * dststride, thread);
+                    break;
+
+                    case ResizeInternals::LevelTable:
+                        ResizeTableRow(src, srcwidth, pixelsize, level, j, dst[l] + j * dststride, thread);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Horizontal binomial filter and 2x decimation of a vertically filtered row
+static void PyramidDownColumns(const unsigned short* input, const unsigned int srcwidth, const unsigned int pixelsize,
+                               unsigned char* output, const unsigned int dstwidth)
+{
+    unsigned int i, c, x0, x1, x3, x4;
+    const unsigned short* center;
+
+    for (i = 0; i < dstwidth; i ++) {
+        if (i > 0 && 2 * i + 2 < srcwidth) {
+            // Interior: no clamping needed
+            center = input + 2 * i * pixelsize;
+            for (c = 0; c < pixelsize; c ++, center ++) {
+                *output++ = static_cast<unsigned char>((center[-2 * static_cast<int>(pixelsize)] +
+                                                        4 * (center[-static_cast<int>(pixelsize)] + center[pixelsize]) +
+                                                        6 * center[0] +
+                                                        center[2 * pixelsize] + 128) >> 8);
+            }
+        }
+        else {
+            // Borders are replicated
+            x0 = (2 * i >= 2) ? 2 * i - 2 : 0;
+            x1 = (2 * i >= 1) ? 2 * i - 1 : 0;
+            x3 = std::min(2 * i + 1, srcwidth - 1);
+            x4 = std::min(2 * i + 2, srcwidth - 1);
+            for (c = 0; c < pixelsize; c ++) {
+                *output++ = static_cast<unsigned char>((input[x0 * pixelsize + c] +
+                                                        4 * (input[x1 * pixelsize + c] + input[x3 * pixelsize + c]) +
+                                                        6 * input[std::min(2 * i, srcwidth - 1) * pixelsize + c] +
+                                                        input[x4 * pixelsize + c] + 128) >> 8);
+            }
+        }
+    }
+}
+
+void svlImageProcessingHelper::PyramidDownRows8(const unsigned char* src, const unsigned int srcwidth, const unsigned int srcheight, const unsigned int pixelsize,
+                                                unsigned char* dst, const unsigned int dstwidth, const unsigned int row_from, const unsigned int row_to,
+                                                unsigned short* buffer)
+{
+    const unsigned int srcstride = srcwidth * pixelsize;
+    const unsigned int dststride = dstwidth * pixelsize;
+    const unsigned char* rows[5];
+    const unsigned char *r0, *r1, *r2, *r3, *r4;
+    unsigned int i, j, k;
+    int y;
+
+    for (j = row_from; j < row_to; j ++) {
+
+        // Five source rows centered on row 2j, replicated at the borders
+        for (k = 0; k < 5; k ++) {
+            y = static_cast<int>(2 * j + k) - 2;
+            if (y < 0) y = 0;
+            else if (y >= static_cast<int>(srcheight)) y = srcheight - 1;
+            rows[k] = src + y * srcstride;
+        }
+
+        // Vertical pass
+        i = svlConvolutionSIMD::Binomial5Rows(rows, buffer, srcstride);
+        r0 = rows[0]; r1 = rows[1]; r2 = rows[2]; r3 = rows[3]; r4 = rows[4];
+        for (; i < srcstride; i ++) {
+            buffer[i] = r0[i] + 4 * (r1[i] + r3[i]) + 6 * r2[i] + r4[i];
+        }
+
+        // Horizontal pass
+        PyramidDownColumns(buffer, srcwidth, pixelsize, dst + j * dststride, dstwidth);
+    }
+}
+
 void svlImageProcessingHelper::DeinterlaceBlending(unsigned char* buffer, const unsigned int width, const unsigned int height)
 {
     unsigned int i, j;
@@ -1766,10 +2221,24 @@ bool svlImageProcessingHelper::RectificationInternals::Generate(unsigned int wid
     return false;
 }
 
-bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &filepath, int explen)
+bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &filepath, int explen, bool usecache)
 {
     Release();
 
+    // Compact LUT saved by SaveCompact
+    if (LoadCompact(filepath)) return true;
+
+    // Compact copy of a text LUT, valid as long as the text file is unchanged
+    std::string cachepath;
+    unsigned long long sourcesize = 0, sourcetime = 0;
+    struct stat filestat;
+    if (usecache && stat(filepath.c_str(), &filestat) == 0) {
+        cachepath = filepath + ".cache";
+        sourcesize = static_cast<unsigned long long>(filestat.st_size);
+        sourcetime = static_cast<unsigned long long>(filestat.st_mtime);
+        if (LoadCompact(cachepath, sourcesize, sourcetime)) return true;
+    }
+
     std::ifstream file(filepath.c_str(), std::ios_base::in | std::ios_base::binary);
     if (!file.is_open()) return false;
 
@@ -1946,6 +2415,9 @@ bool svlImageProcessingHelper::RectificationInternals::Load(const std::string &f
     if (dblbuf) delete [] dblbuf;
     if (chbuf) delete [] chbuf;
 
+    // Failing to write the cache (e.g. read-only folder) is not an error
+    if (Compact() && !cachepath.empty()) SaveCompact(cachepath, sourcesize, sourcetime);
+
     return true;
 
 labError:
@@ -2525,6 +2997,8 @@ bool svlImageProcessingHelper::RectificationInternals::SetFromCameraCalibration(
         idxSrc4[i] *= 3;
     }
 
+    Compact();
+
     return true;
 
 labError:
@@ -2768,7 +3242,278 @@ void svlImageProcessingHelper::RectificationInternals::TransposeLUTArray(unsigne
     }
 }
 
-void svlImageProcessingHelper::RectificationInternals::Release()
+bool svlImageProcessingHelper::RectificationInternals::Compact()
+{
+    if (Width < 1 || Height < 1 || Width > 32767 || Height > 32767 ||
+        !idxDest || idxDestSize < 1 ||
+        idxSrc1Size != idxDestSize || idxSrc2Size != idxDestSize || idxSrc3Size != idxDestSize || idxSrc4Size != idxDestSize ||
+        blendSrc1Size != idxDestSize || blendSrc2Size != idxDestSize || blendSrc3Size != idxDestSize || blendSrc4Size != idxDestSize) return false;
+
+    const unsigned int stride = Width * 3;
+    const unsigned int datasize = stride * Height;
+    const unsigned int tiles_x = (Width + TileWidth - 1) / TileWidth;
+    unsigned int i, x, y, tx, ty, tw, dest, src;
+
+    ComputeTileOffsets();
+
+    CompactEntry invalid;
+    invalid.OffsetX = InvalidOffset;
+    invalid.OffsetY = 0;
+    invalid.Weights[0] = invalid.Weights[1] = invalid.Weights[2] = invalid.Weights[3] = 0;
+    CompactTable.assign(Width * Height, invalid);
+
+    for (i = 0; i < static_cast<unsigned int>(idxDestSize); i ++) {
+        dest = idxDest[i];
+        src  = idxSrc1[i];
+
+        // The compact LUT only supports 2x2 source neighborhoods inside the image
+        if (dest % 3 || dest >= datasize || src % 3 ||
+            idxSrc2[i] != src + 3 || idxSrc3[i] != src + stride || idxSrc4[i] != src + stride + 3 ||
+            idxSrc4[i] + 3 > datasize) {
+            CompactTable.clear();
+            TileOffsets.clear();
+            return false;
+        }
+
+        dest /= 3;
+        src  /= 3;
+        x  = dest % Width;
+        y  = dest / Width;
+        tx = x / TileWidth;
+        ty = y / TileHeight;
+        tw = std::min(static_cast<unsigned int>(TileWidth), Width - tx * TileWidth);
+
+        CompactEntry& entry = CompactTable[TileOffsets[ty * tiles_x + tx] + (y - ty * TileHeight) * tw + (x - tx * TileWidth)];
+        entry.OffsetX = static_cast<short>(static_cast<int>(src % Width) - static_cast<int>(x));
+        entry.OffsetY = static_cast<short>(static_cast<int>(src / Width) - static_cast<int>(y));
+        entry.Weights[0] = blendSrc1[i];
+        entry.Weights[1] = blendSrc2[i];
+        entry.Weights[2] = blendSrc3[i];
+        entry.Weights[3] = blendSrc4[i];
+    }
+
+    // The index arrays are no longer needed
+    ReleaseIndices();
+
+    return true;
+}
+
+// Compact LUT file: magic, width, height, tile width, tile height, source
+// size, source time, then one entry per pixel, in the byte order of the
+// machine that wrote it
+static const char RectificationLUTMagic[8] = { 'S', 'V', 'L', 'R', 'L', 'U', 'T', '1' };
+
+bool svlImageProcessingHelper::RectificationInternals::SaveCompact(const std::string &filepath, unsigned long long sourcesize, unsigned long long sourcetime) const
+{
+    if (!IsCompact()) return false;
+
+    std::ofstream file(filepath.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open()) return false;
+
+    const unsigned int header[4] = { Width, Height, TileWidth, TileHeight };
+    const unsigned long long source[2] = { sourcesize, sourcetime };
+
+    file.write(RectificationLUTMagic, sizeof(RectificationLUTMagic));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(source), sizeof(source));
+    file.write(reinterpret_cast<const char*>(&(CompactTable[0])), CompactTable.size() * sizeof(CompactEntry));
+
+    return file.good();
+}
+
+bool svlImageProcessingHelper::RectificationInternals::LoadCompact(const std::string &filepath, unsigned long long sourcesize, unsigned long long sourcetime)
+{
+    Release();
+
+    std::ifstream file(filepath.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!file.is_open()) return false;
+
+    char magic[sizeof(RectificationLUTMagic)];
+    unsigned int header[4];
+    unsigned long long source[2];
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(source), sizeof(source));
+    if (!file.good() ||
+        memcmp(magic, RectificationLUTMagic, sizeof(magic)) != 0 ||
+        header[0] < 1 || header[0] > 32767 || header[1] < 1 || header[1] > 32767 ||
+        header[2] != TileWidth || header[3] != TileHeight) return false;
+
+    // Zeros stand for "any source"
+    if ((sourcesize && source[0] != sourcesize) ||
+        (sourcetime && source[1] != sourcetime)) return false;
+
+    // The file has to hold exactly one entry per pixel
+    const std::streampos tablepos = file.tellg();
+    file.seekg(0, std::ios_base::end);
+    const std::streamoff tablesize = file.tellg() - tablepos;
+    file.seekg(tablepos);
+    if (!file.good() ||
+        tablesize != static_cast<std::streamoff>(header[0]) * header[1] * static_cast<std::streamoff>(sizeof(CompactEntry))) return false;
+
+    CompactTable.resize(header[0] * header[1]);
+    file.read(reinterpret_cast<char*>(&(CompactTable[0])), CompactTable.size() * sizeof(CompactEntry));
+    if (!file.good()) {
+        Release();
+        return false;
+    }
+
+    Width = header[0];
+    Height = header[1];
+    ComputeTileOffsets();
+
+    // RemapTiles does not check the entries: the 2x2 source neighborhood
+    // of every valid entry has to be inside the image
+    const unsigned int tiles_x = (Width + TileWidth - 1) / TileWidth;
+    const unsigned int tilecount = GetTileCount();
+    const long long pixelcount = static_cast<long long>(Width) * Height;
+    const CompactEntry* entry;
+    unsigned int t, x0, y0, tw, th, x, y;
+    long long sx, sy;
+
+    for (t = 0; t < tilecount; t ++) {
+        x0 = (t % tiles_x) * TileWidth;
+        y0 = (t / tiles_x) * TileHeight;
+        tw = std::min(static_cast<unsigned int>(TileWidth), Width - x0);
+        th = std::min(static_cast<unsigned int>(TileHeight), Height - y0);
+        entry = &(CompactTable[TileOffsets[t]]);
+
+        for (y = y0; y < y0 + th; y ++) {
+            for (x = x0; x < x0 + tw; x ++, entry ++) {
+                if (entry->OffsetX == InvalidOffset) continue;
+
+                sx = static_cast<long long>(x) + entry->OffsetX;
+                sy = static_cast<long long>(y) + entry->OffsetY;
+                if (sx < 0 || sx >= Width || sy < 0 ||
+                    (sy + 1) * Width + sx + 1 >= pixelcount) {
+                    Release();
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool svlImageProcessingHelper::RectificationInternals::IsCompact() const
+{
+    return !CompactTable.empty();
+}
+
+unsigned int svlImageProcessingHelper::RectificationInternals::GetTileCount() const
+{
+    return TileOffsets.empty() ? 0 : static_cast<unsigned int>(TileOffsets.size() - 1);
+}
+
+void svlImageProcessingHelper::RectificationInternals::RemapTiles(const unsigned char* src, unsigned char* dst,
+                                                                  unsigned int tile_from, unsigned int tile_to,
+                                                                  bool interpolation) const
+{
+    if (!src || !dst || !IsCompact()) return;
+    if (tile_to > GetTileCount()) tile_to = GetTileCount();
+
+    const int stride = static_cast<int>(Width) * 3;
+    const int datasize = stride * static_cast<int>(Height);
+    const unsigned int tiles_x = (Width + TileWidth - 1) / TileWidth;
+    const CompactEntry* entry;
+    const unsigned char* srcpx;
+    unsigned char* dstpx;
+    unsigned int t, tx, ty, x0, y0, tw, th, x, y;
+    unsigned int resr, resg, resb;
+    int srcofs;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    __m128i top, bottom, weights, sum;
+    int packed;
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    for (t = tile_from; t < tile_to; t ++) {
+
+        tx = t % tiles_x;
+        ty = t / tiles_x;
+        x0 = tx * TileWidth;
+        y0 = ty * TileHeight;
+        tw = std::min(static_cast<unsigned int>(TileWidth), Width - x0);
+        th = std::min(static_cast<unsigned int>(TileHeight), Height - y0);
+        entry = &(CompactTable[TileOffsets[t]]);
+
+        for (y = y0; y < y0 + th; y ++) {
+
+            dstpx = dst + (y * Width + x0) * 3;
+
+            for (x = x0; x < x0 + tw; x ++, entry ++, dstpx += 3) {
+
+                if (entry->OffsetX == InvalidOffset) continue;
+
+                srcofs = ((static_cast<int>(y) + entry->OffsetY) * static_cast<int>(Width) + static_cast<int>(x) + entry->OffsetX) * 3;
+                srcpx = src + srcofs;
+
+                if (!interpolation) {
+                    dstpx[0] = srcpx[0];
+                    dstpx[1] = srcpx[1];
+                    dstpx[2] = srcpx[2];
+                    continue;
+                }
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+                // The 8 byte loads read 2 bytes past the neighborhood
+                if (srcofs + stride + 8 <= datasize) {
+                    // 2 pixels of the top row and 2 pixels of the bottom row, 16 bits per channel
+                    top    = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(srcpx)), zero);
+                    bottom = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(srcpx + stride)), zero);
+
+                    // Weights spread over the channels: (w1 w1 w1 w2 w2 w2 . .) and (w3 w3 w3 w4 w4 w4 . .)
+                    memcpy(&packed, entry->Weights, 4);
+                    weights = _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero);
+                    weights = _mm_unpacklo_epi64(weights, weights);
+
+                    // The weights add up to 256 at most, so the sums fit in 16 bits
+                    sum = _mm_add_epi16(_mm_mullo_epi16(top,    _mm_shufflehi_epi16(_mm_shufflelo_epi16(weights, _MM_SHUFFLE(1, 0, 0, 0)), _MM_SHUFFLE(1, 1, 1, 1))),
+                                        _mm_mullo_epi16(bottom, _mm_shufflehi_epi16(_mm_shufflelo_epi16(weights, _MM_SHUFFLE(3, 2, 2, 2)), _MM_SHUFFLE(3, 3, 3, 3))));
+                    sum = _mm_srli_epi16(_mm_add_epi16(sum, _mm_srli_si128(sum, 6)), 8);
+
+                    packed = _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+                    dstpx[0] = static_cast<unsigned char>(packed);
+                    dstpx[1] = static_cast<unsigned char>(packed >> 8);
+                    dstpx[2] = static_cast<unsigned char>(packed >> 16);
+                    continue;
+                }
+#endif // SVL_CONVERTER_HAS_SSE2
+
+                resr = entry->Weights[0] * srcpx[0] + entry->Weights[1] * srcpx[3] + entry->Weights[2] * srcpx[stride]     + entry->Weights[3] * srcpx[stride + 3];
+                resg = entry->Weights[0] * srcpx[1] + entry->Weights[1] * srcpx[4] + entry->Weights[2] * srcpx[stride + 1] + entry->Weights[3] * srcpx[stride + 4];
+                resb = entry->Weights[0] * srcpx[2] + entry->Weights[1] * srcpx[5] + entry->Weights[2] * srcpx[stride + 2] + entry->Weights[3] * srcpx[stride + 5];
+
+                dstpx[0] = static_cast<unsigned char>(resr >> 8);
+                dstpx[1] = static_cast<unsigned char>(resg >> 8);
+                dstpx[2] = static_cast<unsigned char>(resb >> 8);
+            }
+        }
+    }
+}
+
+void svlImageProcessingHelper::RectificationInternals::ComputeTileOffsets()
+{
+    const unsigned int tiles_x = (Width + TileWidth - 1) / TileWidth;
+    const unsigned int tiles_y = (Height + TileHeight - 1) / TileHeight;
+    unsigned int tx, ty, tw, th, offset = 0;
+
+    TileOffsets.resize(tiles_x * tiles_y + 1);
+    for (ty = 0; ty < tiles_y; ty ++) {
+        th = std::min(static_cast<unsigned int>(TileHeight), Height - ty * TileHeight);
+        for (tx = 0; tx < tiles_x; tx ++) {
+            tw = std::min(static_cast<unsigned int>(TileWidth), Width - tx * TileWidth);
+            TileOffsets[ty * tiles_x + tx] = offset;
+            offset += tw * th;
+        }
+    }
+    TileOffsets[tiles_x * tiles_y] = offset;
+}
+
+void svlImageProcessingHelper::RectificationInternals::ReleaseIndices()
 {
     if (idxDest) delete [] idxDest;
     if (idxSrc1) delete [] idxSrc1;
@@ -2780,8 +3525,6 @@ void svlImageProcessingHelper::RectificationInternals::Release()
     if (blendSrc3) delete [] blendSrc3;
     if (blendSrc4) delete [] blendSrc4;
 
-    Width = 0;
-    Height = 0;
     idxDest = 0;
     idxDestSize = 0;
     idxSrc1 = 0;
@@ -2802,6 +3545,16 @@ void svlImageProcessingHelper::RectificationInternals::Release()
     blendSrc4Size = 0;
 }
 
+void svlImageProcessingHelper::RectificationInternals::Release()
+{
+    ReleaseIndices();
+    CompactTable.clear();
+    TileOffsets.clear();
+
+    Width = 0;
+    Height = 0;
+}
+
 
 /*********************************************************/
 /*** svlImageProcessingHelper::ExposureInternals class ***/
@@ -2888,14 +3641,299 @@ void svlImageProcessingHelper::ExposureInternals::CalculateCurve()
     Modified = false;
 }
 
+/************************************************************/
+/*** svlImageProcessingHelper::ConvolutionInternals class ***/
+/************************************************************/
+
+svlImageProcessingHelper::ConvolutionInternals::ConvolutionInternals() :
+    svlImageProcessingInternals(),
+    TypeHoriz(KernelGeneric),
+    TypeVert(KernelGeneric)
+{
+}
+
+void svlImageProcessingHelper::ConvolutionInternals::SetKernels(const vctDynamicVector<double> & kernel_horiz, const vctDynamicVector<double> & kernel_vert)
+{
+    // Will not do anything if kernels have not changed
+    if (KernelHoriz.size() == kernel_horiz.size() && KernelVert.size() == kernel_vert.size() &&
+        KernelHoriz.Equal(kernel_horiz) && KernelVert.Equal(kernel_vert)) return;
+
+    KernelHoriz.ForceAssign(kernel_horiz);
+    KernelVert.ForceAssign(kernel_vert);
+
+    // Same 10 bit fixed point coefficients as svlImageProcessing::Convolution
+    unsigned int i;
+    FPKernelHoriz.SetSize(KernelHoriz.size());
+    FPKernelVert.SetSize(KernelVert.size());
+    for (i = 0; i < KernelHoriz.size(); i ++) FPKernelHoriz[i] = static_cast<int>(KernelHoriz[i] * 1024);
+    for (i = 0; i < KernelVert.size(); i ++) FPKernelVert[i] = static_cast<int>(KernelVert[i] * 1024);
+
+    TypeHoriz = GetKernelType(FPKernelHoriz);
+    TypeVert  = GetKernelType(FPKernelVert);
+}
+
+void svlImageProcessingHelper::ConvolutionInternals::SetThreadCount(unsigned int count)
+{
+    if (count < 1) count = 1;
+    if (RowBuffers.size() == count) return;
+
+    RowBuffers.SetSize(count);
+    SumBuffers.SetSize(count);
+}
+
+unsigned char* svlImageProcessingHelper::ConvolutionInternals::GetRowBuffer(unsigned int thread, unsigned int size)
+{
+    if (thread >= RowBuffers.size()) return 0;
+    if (RowBuffers[thread].size() < size) RowBuffers[thread].SetSize(size);
+    return RowBuffers[thread].Pointer();
+}
+
+short* svlImageProcessingHelper::ConvolutionInternals::GetSumBuffer(unsigned int thread, unsigned int size)
+{
+    if (thread >= SumBuffers.size()) return 0;
+    if (SumBuffers[thread].size() < size) SumBuffers[thread].SetSize(size);
+    return SumBuffers[thread].Pointer();
+}
+
+unsigned char* svlImageProcessingHelper::ConvolutionInternals::GetImageBuffer(unsigned int size)
+{
+    if (ImageBuffer.size() < size) ImageBuffer.SetSize(size);
+    return ImageBuffer.Pointer();
+}
+
+svlImageProcessingHelper::ConvolutionInternals::KernelType svlImageProcessingHelper::ConvolutionInternals::GetKernelType(const vctDynamicVector<int> & kernel)
+{
+    const unsigned int size = kernel.size();
+    unsigned int i;
+
+    if (size < 2) return KernelGeneric;
+
+    // Box: column sums of up to 128 rows fit in 16 bits
+    for (i = 1; i < size && kernel[i] == kernel[0]; i ++);
+    if (i == size && size <= 128) return KernelBox;
+
+    // Symmetric (e.g. Gaussian): mirrored taps share their coefficient
+    for (i = 0; i < size / 2 && kernel[i] == kernel[size - 1 - i]; i ++);
+    if (i == size / 2) return KernelSymmetric;
+
+    return KernelGeneric;
+}
+
+
+/*******************************************************/
+/*** svlImageProcessingHelper::ResizeInternals class ***/
+/*******************************************************/
+
+svlImageProcessingHelper::ResizeInternals::Level::Level() :
+    Width(0),
+    Height(0),
+    Type(LevelCopy),
+    FactorX(1),
+    FactorY(1),
+    BoxScale(0),
+    TapsX(1),
+    TapsY(1)
+{
+}
+
+svlImageProcessingHelper::ResizeInternals::ResizeInternals() :
+    svlImageProcessingInternals(),
+    SrcWidth(0),
+    SrcHeight(0),
+    PixelSize(0),
+    Method(-1),
+    ThreadCount(0)
+{
+}
+
+void svlImageProcessingHelper::ResizeInternals::Setup(const unsigned int srcwidth, const unsigned int srcheight, const unsigned int pixelsize,
+                                                      const std::vector<unsigned int> & dstwidth, const std::vector<unsigned int> & dstheight,
+                                                      const int method, unsigned int threadcount)
+{
+    if (threadcount < 1) threadcount = 1;
+
+    const unsigned int levels = static_cast<unsigned int>(dstwidth.size());
+    unsigned int l;
+
+    // Will not do anything if nothing has changed
+    bool changed = (SrcWidth != srcwidth || SrcHeight != srcheight || PixelSize != pixelsize ||
+                    Method != method || ThreadCount != threadcount || Levels.size() != levels);
+    for (l = 0; !changed && l < levels; l ++) {
+        if (Levels[l].Width != dstwidth[l] || Levels[l].Height != dstheight[l]) changed = true;
+    }
+    if (!changed) return;
+
+    SrcWidth    = srcwidth;
+    SrcHeight   = srcheight;
+    PixelSize   = pixelsize;
+    Method      = method;
+    ThreadCount = threadcount;
+
+    Levels.assign(levels, Level());
+    for (l = 0; l < levels; l ++) {
+        Levels[l].Width  = dstwidth[l];
+        Levels[l].Height = dstheight[l];
+        SetupLevel(Levels[l], threadcount);
+    }
+}
+
+unsigned int svlImageProcessingHelper::ResizeInternals::GetBandCount() const
+{
+    return (SrcHeight + BandHeight - 1) / BandHeight;
+}
+
+void svlImageProcessingHelper::ResizeInternals::SetupLevel(Level & level, const unsigned int threadcount)
+{
+    unsigned int t;
+
+    if (level.Width == SrcWidth && level.Height == SrcHeight) {
+        level.Type = LevelCopy;
+    }
+    else if (Method == svlImageProcessing::RS_Area &&
+             SrcWidth  % level.Width  == 0 &&
+             SrcHeight % level.Height == 0 &&
+             SrcHeight / level.Height <= 257) {
+        // Column sums of up to 257 rows fit in 16 bits
+        level.Type = LevelBox;
+        level.FactorX = SrcWidth / level.Width;
+        level.FactorY = SrcHeight / level.Height;
+        level.BoxScale = ((1u << 22) + level.FactorX * level.FactorY / 2) / (level.FactorX * level.FactorY);
+        level.ColumnSums.assign(threadcount, std::vector<unsigned short>(SrcWidth * PixelSize));
+    }
+    else {
+        level.Type = LevelTable;
+        BuildTable(SrcWidth,  level.Width,  Method, static_cast<int>(PixelSize), level.TapsX, level.ColumnOffset, level.ColumnWeight);
+        BuildTable(SrcHeight, level.Height, Method, 1,                           level.TapsY, level.RowIndex,     level.RowWeight);
+        level.RowCache.assign(threadcount, std::vector<unsigned char>(level.TapsY * level.Width * PixelSize));
+        level.RowCacheTag.assign(threadcount, std::vector<int>(level.TapsY, -1));
+        level.RowPointers.assign(threadcount, std::vector<const unsigned char*>(level.TapsY));
+    }
+
+    // Each destination row belongs to the band of its first source row
+    const unsigned int bands = GetBandCount();
+    unsigned int row = 0, first;
+
+    level.BandStart.resize(bands + 1);
+    for (t = 0; t < bands; t ++) {
+        while (row < level.Height) {
+            if (level.Type == LevelCopy) first = row;
+            else if (level.Type == LevelBox) first = row * level.FactorY;
+            else first = static_cast<unsigned int>(level.RowIndex[row * level.TapsY]);
+            if (first >= t * BandHeight) break;
+            row ++;
+        }
+        level.BandStart[t] = row;
+    }
+    level.BandStart[bands] = level.Height;
+}
+
+void svlImageProcessingHelper::ResizeInternals::BuildTable(const unsigned int srcsize, const unsigned int dstsize, const int method, const int stride,
+                                                           unsigned int & taps, std::vector<int> & index, std::vector<int> & weight)
+{
+    const double scale = static_cast<double>(srcsize) / dstsize;
+    const bool area = (method == svlImageProcessing::RS_Area && scale > 1.0);
+    const int last = static_cast<int>(srcsize) - 1;
+    const int one = 1 << WeightShift;
+    unsigned int i, k, largest;
+    double pos, t, from, to, a;
+    int first, p, sum;
+
+    if (srcsize == dstsize || method == svlImageProcessing::RS_Nearest) taps = 1;
+    else if (method == svlImageProcessing::RS_Bicubic) taps = 4;
+    else if (area) taps = static_cast<unsigned int>(ceil(scale)) + 1;
+    else taps = 2;
+
+    std::vector<double> w(taps);
+    index.resize(dstsize * taps);
+    weight.resize(dstsize * taps);
+
+    for (i = 0; i < dstsize; i ++) {
+
+        if (taps == 1) {
+            // Same sampling as ResampleMono8 and ResampleRGB24
+            first = static_cast<int>((static_cast<unsigned long long>(i) * srcsize) / dstsize);
+            w[0] = 1.0;
+        }
+        else if (area) {
+            // Fraction of the destination pixel covered by each source pixel
+            from = i * scale;
+            to = from + scale;
+            first = static_cast<int>(floor(from));
+            for (k = 0; k < taps; k ++) {
+                a = std::min(static_cast<double>(first + k + 1), to) - std::max(static_cast<double>(first + k), from);
+                w[k] = (a > 0.0) ? a / scale : 0.0;
+            }
+        }
+        else {
+            // Pixel centers are aligned
+            pos = (i + 0.5) * scale - 0.5;
+            first = static_cast<int>(floor(pos));
+            t = pos - first;
+            if (taps == 2) {
+                w[0] = 1.0 - t;
+                w[1] = t;
+            }
+            else {
+                // Cubic convolution kernel with a = -0.5
+                first --;
+                a = -0.5;
+                w[0] = ((a * (t + 1.0) - 5.0 * a) * (t + 1.0) + 8.0 * a) * (t + 1.0) - 4.0 * a;
+                w[1] = ((a + 2.0) * t - (a + 3.0)) * t * t + 1.0;
+                w[2] = ((a + 2.0) * (1.0 - t) - (a + 3.0)) * (1.0 - t) * (1.0 - t) + 1.0;
+                w[3] = 1.0 - w[0] - w[1] - w[2];
+            }
+        }
+
+        // Fixed point weights adding up to exactly one
+        sum = 0;
+        largest = 0;
+        for (k = 0; k < taps; k ++) {
+            p = first + static_cast<int>(k);
+            if (p < 0) p = 0;
+            else if (p > last) p = last;
+            index[i * taps + k] = p * stride;
+            weight[i * taps + k] = static_cast<int>(floor(w[k] * one + 0.5));
+            sum += weight[i * taps + k];
+            if (w[k] > w[largest]) largest = k;
+        }
+        weight[i * taps + largest] += one - sum;
+    }
+}
+
+
+/********************************************************/
+/*** svlImageProcessingHelper::PyramidInternals class ***/
+/********************************************************/
+
+svlImageProcessingHelper::PyramidInternals::PyramidInternals() :
+    svlImageProcessingInternals()
+{
+}
+
+void svlImageProcessingHelper::PyramidInternals::SetThreadCount(unsigned int count)
+{
+    RowBuffers.resize(count);
+}
+
+unsigned short* svlImageProcessingHelper::PyramidInternals::GetRowBuffer(unsigned int thread, unsigned int size)
+{
+    if (thread >= RowBuffers.size()) return 0;
+    if (RowBuffers[thread].size() < size) RowBuffers[thread].resize(size);
+    return &(RowBuffers[thread][0]);
+}
+
+
 /*************************************************************/
 /*** svlImageProcessingHelper::BlobDetectorInternals class ***/
 /*************************************************************/
 
 svlImageProcessingHelper::BlobDetectorInternals::BlobDetectorInternals() :
     svlImageProcessingInternals(),
-    BlobCount(0)
+    BlobCount(0),
+    Width(0),
+    Height(0)
 {
+    SetStripCount(1);
 }
 
 unsigned int svlImageProcessingHelper::BlobDetectorInternals::CalculateLabels(const svlSampleImageMono8* image,
@@ -2952,108 +3990,315 @@ bool svlImageProcessingHelper::BlobDetectorInternals::GetBlobs(const svlSampleIm
                             max_compactness);
 }
 
-unsigned int svlImageProcessingHelper::BlobDetectorInternals::CalculateLabelsInternal(svlSampleImage* image,
-                                                                                      svlSampleImage* labels,
-                                                                                      const unsigned int videoch)
+// First position from 'x' where the row differs from 'value', or 'width'
+static inline int BlobFindRunEnd(const unsigned char* row, int x, const int width, const unsigned char value)
 {
-    if (!image || !labels || videoch >= image->GetVideoChannels()) return 0;
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i v = _mm_set1_epi8(static_cast<char>(value));
+    unsigned int mask;
+    while (x + 16 <= width) {
+        mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x)), v)) & 0xFFFF;
+        if (mask) {
+            while (!(mask & 1)) {
+                mask >>= 1;
+                x ++;
+            }
+            return x;
+        }
+        x += 16;
+    }
+#endif
+    while (x < width && row[x] == value) x ++;
+    return x;
+}
 
-    const int width  = static_cast<int>(image->GetWidth(videoch));
-    const int height = static_cast<int>(image->GetHeight(videoch));
+// Number of pixels in [from, to] that have a different value above or below
+static inline unsigned int BlobCountEdgePixels(const unsigned char* above, const unsigned char* below,
+                                               int x, const int to, const unsigned char value)
+{
+    unsigned int count = 0;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i v = _mm_set1_epi8(static_cast<char>(value));
+    __m128i same;
+    unsigned int mask;
+    while (x + 16 <= to + 1) {
+        same = _mm_set1_epi8(-1);
+        if (above) same = _mm_and_si128(same, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(above + x)), v));
+        if (below) same = _mm_and_si128(same, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(below + x)), v));
+        mask = ~_mm_movemask_epi8(same) & 0xFFFF;
+        while (mask) {
+            mask &= mask - 1;
+            count ++;
+        }
+        x += 16;
+    }
+#endif
 
-    unsigned int cbufsize = width * height / 2;
-    if (ContourBuffer.cols() < cbufsize) ContourBuffer.SetSize(4, cbufsize);
+    for (; x <= to; x ++) {
+        if ((above && above[x] != value) || (below && below[x] != value)) count ++;
+    }
+    return count;
+}
 
-    int *fx  = ContourBuffer.Pointer();
-    int *fy  = fx + cbufsize;
-    int *fnx = fy + cbufsize;
-    int *fny = fnx + cbufsize;
-    unsigned int fu, fnu;
+static inline unsigned int BlobFindRoot(std::vector<unsigned int>& parents, unsigned int i)
+{
+    unsigned int root = i, next;
+    while (parents[root] != root) root = parents[root];
+    // Path compression
+    while (parents[i] != root) {
+        next = parents[i];
+        parents[i] = root;
+        i = next;
+    }
+    return root;
+}
 
-    unsigned int *blobids = reinterpret_cast<unsigned int*>(labels->GetUCharPointer(videoch));
-    memset(blobids, 0, labels->GetDataSize(videoch));
+// The root of a blob is always its first run in raster order
+static inline void BlobUnion(std::vector<unsigned int>& parents, unsigned int a, unsigned int b)
+{
+    a = BlobFindRoot(parents, a);
+    b = BlobFindRoot(parents, b);
+    if (a < b) parents[b] = a;
+    else if (b < a) parents[a] = b;
+}
 
-    unsigned char *imgbuf = const_cast<unsigned char*>(image->GetUCharPointer(videoch));
-    const int width_m1  = width - 1;
-    const int height_m1 = height - 1;
+void svlImageProcessingHelper::BlobDetectorInternals::SetImageSize(const svlSampleImage* image, const unsigned int videoch)
+{
+    Width  = static_cast<int>(image->GetWidth(videoch));
+    Height = static_cast<int>(image->GetHeight(videoch));
+}
 
-    const unsigned int FBSm1  = cbufsize - 1;
-    unsigned int k, off, off2, imgval, c = 0, maxblobcount = 1;
-    int i, j, x, y;
-    int *tptr;
+void svlImageProcessingHelper::BlobDetectorInternals::SetStripCount(const unsigned int count)
+{
+    StripRuns.resize(std::max(1u, count));
+}
 
+unsigned int svlImageProcessingHelper::BlobDetectorInternals::GetStripCount() const
+{
+    return static_cast<unsigned int>(StripRuns.size());
+}
 
-    for (j = 0; j < height; j ++) {
-        for (i = 0; i < width; i ++) {
-            imgval = imgbuf[c];
-
-            if (imgval == 0 || blobids[c] != 0) {
-                c ++;
-                continue;
-            }
-
-            // Fill current pixel
-            *fnx = i; *fny = j; fnu = 1;
-            blobids[c] = maxblobcount;
-
-            while (fnu) {
-                // Swap fill buffers
-                tptr = fx; fx = fnx; fnx = tptr;
-                tptr = fy; fy = fny; fny = tptr;
-                fu = fnu; fnu = 0;
-
-                for (k = 0; k < fu; k ++) {
-                    x = fx[k]; y = fy[k];
-                    off = y * width + x;
-
-                    // Check left neighbor
-                    if (x > 0) {
-                        off2 = off - 1;
-                        if (blobids[off2] == 0 && imgbuf[off2] == imgval && fnu < FBSm1) {
-                            // Fill pixel
-                            fnx[fnu] = x - 1; fny[fnu] = y; fnu ++;
-                            blobids[off2] = maxblobcount;
-                        }
-                    }
+void svlImageProcessingHelper::BlobDetectorInternals::GetStripRows(const unsigned int strip, int &from, int &to) const
+{
+    const int count = static_cast<int>(StripRuns.size());
+    from = static_cast<int>(strip) * Height / count;
+    to   = (static_cast<int>(strip) + 1) * Height / count;
+}
 
-                    // Check right neighbor
-                    if (x < width_m1) {
-                        off2 = off + 1;
-                        if (blobids[off2] == 0 && imgbuf[off2] == imgval && fnu < FBSm1) {
-                            // Fill pixel
-                            fnx[fnu] = x + 1; fny[fnu] = y; fnu ++;
-                            blobids[off2] = maxblobcount;
-                        }
+void svlImageProcessingHelper::BlobDetectorInternals::LabelStrip(const svlSampleImage* image, const unsigned int videoch, const unsigned int strip)
+{
+    if (strip >= StripRuns.size()) return;
+
+    // Strips are labeled concurrently: the dimensions set by SetImageSize are only read here
+    StripRuns[strip].clear();
+    if (static_cast<int>(image->GetWidth(videoch))  != Width ||
+        static_cast<int>(image->GetHeight(videoch)) != Height) return;
+
+    const unsigned char* imgbuf = image->GetUCharPointer(videoch);
+    const int width_m1 = Width - 1;
+    std::vector<Run>& runs = StripRuns[strip];
+    unsigned int prev_from = 0, prev_to = 0, row_from, p, q, idx;
+    const unsigned char *line, *above, *below;
+    unsigned char value;
+    int x, start, row_from_y, row_to_y;
+    Run run;
+
+    GetStripRows(strip, row_from_y, row_to_y);
+
+    for (int y = row_from_y; y < row_to_y; y ++) {
+
+        line  = imgbuf + y * Width;
+        above = (y > 0) ? line - Width : 0;
+        below = (y < Height - 1) ? line + Width : 0;
+        row_from = static_cast<unsigned int>(runs.size());
+        p = prev_from;
+
+        x = BlobFindRunEnd(line, 0, Width, 0);
+        while (x < Width) {
+
+            value = line[x];
+            start = x;
+            x = BlobFindRunEnd(line, x + 1, Width, value);
+
+            idx = static_cast<unsigned int>(runs.size());
+            run.Row    = y;
+            run.Start  = start;
+            run.End    = x - 1;
+            run.Parent = idx;
+            run.Label  = 0;
+            run.Value  = value;
+
+            // Pixels with a 4-neighbor of different value; the pixels
+            // next to the run in the same row always differ
+            run.Circumference = BlobCountEdgePixels(above, below, run.Start, run.End, value);
+            if (run.Start > 0 &&
+                !((above && above[run.Start] != value) || (below && below[run.Start] != value))) {
+                run.Circumference ++;
+            }
+            if (run.End < width_m1 && !(run.End == run.Start && run.Start > 0) &&
+                !((above && above[run.End] != value) || (below && below[run.End] != value))) {
+                run.Circumference ++;
+            }
+            runs.push_back(run);
+
+            // Connect to overlapping runs of the same value in the row above
+            while (p < prev_to && runs[p].End < run.Start) p ++;
+            for (q = p; q < prev_to && runs[q].Start <= run.End; q ++) {
+                if (runs[q].Value != value) continue;
+                // Strip-local union-find
+                unsigned int a = idx, b = q, next;
+                while (runs[a].Parent != a) a = runs[a].Parent;
+                while (runs[b].Parent != b) b = runs[b].Parent;
+                if (a != b) {
+                    if (a < b) std::swap(a, b);
+                    runs[a].Parent = b;
+                    // Shorten the path from the new run
+                    a = idx;
+                    while (runs[a].Parent != b) {
+                        next = runs[a].Parent;
+                        runs[a].Parent = b;
+                        a = next;
                     }
+                }
+            }
 
-                    // Check top neighbor
-                    if (y > 0) {
-                        off2 = off - width;
-                        if (blobids[off2] == 0 && imgbuf[off2] == imgval && fnu < FBSm1) {
-                            // Fill pixel
-                            fnx[fnu] = x; fny[fnu] = y - 1; fnu ++;
-                            blobids[off2] = maxblobcount;
-                        }
-                    }
+            x = BlobFindRunEnd(line, x, Width, 0);
+        }
 
-                    // Check bottom neighbor
-                    if (y < height_m1) {
-                        off2 = off + width;
-                        if (blobids[off2] == 0 && imgbuf[off2] == imgval && fnu < FBSm1) {
-                            // Fill pixel
-                            fnx[fnu] = x; fny[fnu] = y + 1; fnu ++;
-                            blobids[off2] = maxblobcount;
-                        }
+        prev_from = row_from;
+        prev_to = static_cast<unsigned int>(runs.size());
+    }
+}
+
+unsigned int svlImageProcessingHelper::BlobDetectorInternals::MergeStrips()
+{
+    const unsigned int strips = static_cast<unsigned int>(StripRuns.size());
+    unsigned int s, i, total = 0, offset, prev_offset = 0, p, q, prev_end = 0, cur_end, last_from;
+    int row_from, row_to;
+    int prev_strip = -1;
+
+    for (s = 0; s < strips; s ++) total += static_cast<unsigned int>(StripRuns[s].size());
+    Parents.resize(total);
+
+    offset = 0;
+    for (s = 0; s < strips; s ++) {
+        std::vector<Run>& runs = StripRuns[s];
+        const unsigned int count = static_cast<unsigned int>(runs.size());
+        for (i = 0; i < count; i ++) Parents[offset + i] = offset + runs[i].Parent;
+
+        GetStripRows(s, row_from, row_to);
+        if (row_from < row_to) {
+            // Connect the first row of the strip to the last row of the previous strip
+            if (prev_strip >= 0 && count > 0) {
+                const std::vector<Run>& prev_runs = StripRuns[prev_strip];
+                last_from = prev_end;
+                while (last_from > 0 && prev_runs[last_from - 1].Row == row_from - 1) last_from --;
+                for (cur_end = 0; cur_end < count && runs[cur_end].Row == row_from; cur_end ++);
+
+                p = last_from;
+                for (i = 0; i < cur_end; i ++) {
+                    while (p < prev_end && prev_runs[p].End < runs[i].Start) p ++;
+                    for (q = p; q < prev_end && prev_runs[q].Start <= runs[i].End; q ++) {
+                        if (prev_runs[q].Value == runs[i].Value) BlobUnion(Parents, offset + i, prev_offset + q);
                     }
                 }
             }
+            prev_strip = static_cast<int>(s);
+            prev_offset = offset;
+            prev_end = count;
+        }
+        offset += count;
+    }
+
+    // Number blobs in raster order of their first pixel, like a flood
+    // fill started from each unlabeled pixel in scan order would do
+    BlobCount = 0;
+    Statistics.clear();
+    offset = 0;
+    for (s = 0; s < strips; s ++) {
+        std::vector<Run>& runs = StripRuns[s];
+        const unsigned int count = static_cast<unsigned int>(runs.size());
+        for (i = 0; i < count; i ++) {
+            Run& run = runs[i];
+            const unsigned int root = BlobFindRoot(Parents, offset + i);
+            if (root == offset + i) {
+                BlobCount ++;
+                run.Label = BlobCount;
+                BlobStatistics stats;
+                stats.Left          = run.Start;
+                stats.Right         = run.End;
+                stats.Top           = run.Row;
+                stats.Bottom        = run.Row;
+                stats.SumX          = 0;
+                stats.SumY          = 0;
+                stats.Area          = 0;
+                stats.Circumference = 0;
+                stats.Value         = run.Value;
+                Statistics.push_back(stats);
+            }
+            else {
+                // The root precedes the run, so it is labeled already
+                Parents[offset + i] = root;
+                unsigned int rs = 0, ri = root;
+                while (ri >= StripRuns[rs].size()) {
+                    ri -= static_cast<unsigned int>(StripRuns[rs].size());
+                    rs ++;
+                }
+                run.Label = StripRuns[rs][ri].Label;
+            }
 
-            maxblobcount ++;
-            c ++;
+            // Moments of the blob
+            BlobStatistics& stats = Statistics[run.Label - 1];
+            const unsigned int length = static_cast<unsigned int>(run.End - run.Start + 1);
+            if (run.Start < stats.Left) stats.Left = run.Start;
+            if (run.End > stats.Right) stats.Right = run.End;
+            stats.Bottom = run.Row;
+            stats.SumX += static_cast<long long int>(run.Start + run.End) * length / 2;
+            stats.SumY += static_cast<long long int>(run.Row) * length;
+            stats.Area += length;
+            stats.Circumference += run.Circumference;
         }
+        offset += count;
     }
 
-    BlobCount = maxblobcount - 1;
+    return BlobCount;
+}
+
+void svlImageProcessingHelper::BlobDetectorInternals::WriteLabels(svlSampleImage* labels, const unsigned int videoch, const unsigned int strip)
+{
+    if (strip >= StripRuns.size()) return;
+
+    unsigned int* blobids = reinterpret_cast<unsigned int*>(labels->GetUCharPointer(videoch));
+    const std::vector<Run>& runs = StripRuns[strip];
+    const unsigned int count = static_cast<unsigned int>(runs.size());
+    int row_from, row_to;
+
+    GetStripRows(strip, row_from, row_to);
+    if (row_from >= row_to) return;
+
+    memset(blobids + row_from * Width, 0, (row_to - row_from) * Width * sizeof(unsigned int));
+    for (unsigned int i = 0; i < count; i ++) {
+        std::fill(blobids + runs[i].Row * Width + runs[i].Start,
+                  blobids + runs[i].Row * Width + runs[i].End + 1,
+                  runs[i].Label);
+    }
+}
+
+unsigned int svlImageProcessingHelper::BlobDetectorInternals::CalculateLabelsInternal(svlSampleImage* image,
+                                                                                      svlSampleImage* labels,
+                                                                                      const unsigned int videoch)
+{
+    if (!image || !labels || videoch >= image->GetVideoChannels()) return 0;
+
+    const unsigned int strips = GetStripCount();
+    unsigned int strip;
+
+    SetImageSize(image, videoch);
+    for (strip = 0; strip < strips; strip ++) LabelStrip(image, videoch, strip);
+    MergeStrips();
+    for (strip = 0; strip < strips; strip ++) WriteLabels(labels, videoch, strip);
+
     return BlobCount;
 }
 
@@ -3072,13 +4317,10 @@ bool svlImageProcessingHelper::BlobDetectorInternals::GetBlobsInternal(svlSample
 
     const unsigned int blobsbuffsize = blobs->GetBufferSize();
     const unsigned int maxblobcount = std::min(BlobCount, blobsbuffsize);
-    unsigned int *blobids = reinterpret_cast<unsigned int*>(labels->GetUCharPointer(videoch));
-    unsigned char *imgbuf = image->GetUCharPointer(videoch);
+    unsigned int *blobids;
     svlBlob *blbbuf = blobs->GetBlobsPointer(videoch);
     const int width  = static_cast<int>(image->GetWidth(videoch));
     const int height = static_cast<int>(image->GetHeight(videoch));
-    const int width_m1  = width - 1;
-    const int height_m1 = height - 1;
 
     bool do_filtering = false;
     double compactness, db_area, db_circumference;
@@ -3086,65 +4328,23 @@ bool svlImageProcessingHelper::BlobDetectorInternals::GetBlobsInternal(svlSample
     svlBlob *blob;
     int i, j;
 
+    // Statistics were collected while labeling
+    if (maxblobcount > Statistics.size()) return false;
 
     blob = blbbuf;
     for (k = 0; k < maxblobcount; k ++) {
+        const BlobStatistics& stats = Statistics[k];
         blob->ID            = k + 1;
         blob->used          = true;
-        blob->left          = 100000;
-        blob->right         = -1;
-        blob->top           = 100000;
-        blob->bottom        = -1;
-        blob->center_x      = 0;
-        blob->center_y      = 0;
-        blob->area          = 0;
-        blob->circumference = 0;
-        blob->label         = 0;
-        blob ++;
-    }
-
-    for (j = 0; j < height; j ++) {
-        for (i = 0; i < width; i ++) {
-
-            k = *blobids;
-            if (k > 0 && k <= maxblobcount) {
-
-                blob = blbbuf + k - 1;
-
-                // Bounding rectangle
-                if (i < blob->left) blob->left = i;
-                if (i > blob->right) blob->right = i;
-                if (j < blob->top) blob->top = j;
-                if (j > blob->bottom) blob->bottom = j;
-
-                // Center of weight
-                blob->center_x += i;
-                blob->center_y += j;
-
-                // Area
-                blob->area ++;
-
-                // Circumference
-                if ((i > 0         && blobids[    -1] != k) ||
-                    (i < width_m1  && blobids[     1] != k) ||
-                    (j > 0         && blobids[-width] != k) ||
-                    (j < height_m1 && blobids[ width] != k)) {
-                    blob->circumference ++;
-                }
-
-                // Label
-                if (blob->label == 0) blob->label = *imgbuf;
-            }
-
-            imgbuf ++;
-            blobids ++;
-        }
-    }
-
-    blob = blbbuf;
-    for (k = 0; k < maxblobcount; k ++) {
-        blob->center_x /= blob->area;
-        blob->center_y /= blob->area;
+        blob->left          = stats.Left;
+        blob->right         = stats.Right;
+        blob->top           = stats.Top;
+        blob->bottom        = stats.Bottom;
+        blob->center_x      = static_cast<int>(stats.SumX / stats.Area);
+        blob->center_y      = static_cast<int>(stats.SumY / stats.Area);
+        blob->area          = stats.Area;
+        blob->circumference = stats.Circumference;
+        blob->label         = stats.Value;
         blob ++;
     }
 
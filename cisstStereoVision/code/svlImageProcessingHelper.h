@@ -23,10 +23,12 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstStereoVision/svlTypes.h>
 #include <cisstStereoVision/svlTypes.h>
+#include <cisstStereoVision/svlImageProcessing.h>
 #include <cisstVector/vctFixedSizeMatrixTypes.h>
 #include <cisstVector/vctFixedSizeVectorTypes.h>
 #include <cisstVector/vctDynamicMatrixTypes.h>
 #include <string>
+#include <vector>
 
 #if CISST_SVL_HAS_CISSTNETLIB
     #include <cisstNumerical/nmrNetlib.h>
@@ -133,6 +135,42 @@ namespace svlImageProcessingHelper
     void CISST_EXPORT ConvolutionMono16(unsigned short* input, unsigned short* output, const int width, const int height, vctDynamicMatrix<int> & kernel, bool absres);
     void CISST_EXPORT ConvolutionMono32(unsigned int* input, unsigned int* output, const int width, const int height, vctDynamicMatrix<int> & kernel, bool absres);
 
+    class CISST_EXPORT ConvolutionInternals : public svlImageProcessingInternals
+    {
+    public:
+        enum KernelType
+        {
+            KernelGeneric,
+            KernelSymmetric,
+            KernelBox
+        };
+
+        ConvolutionInternals();
+
+        void SetKernels(const vctDynamicVector<double> & kernel_horiz, const vctDynamicVector<double> & kernel_vert);
+        void SetThreadCount(unsigned int count);
+        unsigned char* GetRowBuffer(unsigned int thread, unsigned int size);
+        short* GetSumBuffer(unsigned int thread, unsigned int size);
+        unsigned char* GetImageBuffer(unsigned int size);
+
+        vctDynamicVector<int> FPKernelHoriz;
+        vctDynamicVector<int> FPKernelVert;
+        KernelType TypeHoriz;
+        KernelType TypeVert;
+
+    private:
+        KernelType GetKernelType(const vctDynamicVector<int> & kernel);
+
+        vctDynamicVector<double> KernelHoriz;
+        vctDynamicVector<double> KernelVert;
+        vctDynamicVector< vctDynamicVector<unsigned char> > RowBuffers;
+        vctDynamicVector< vctDynamicVector<short> > SumBuffers;
+        vctDynamicVector<unsigned char> ImageBuffer;
+    };
+
+    void CISST_EXPORT ConvolutionRows8(const unsigned char* input, unsigned char* output, const int width, const int height, const int pixelsize,
+                                       const int row_from, const int row_to, ConvolutionInternals & internals, const unsigned int thread, bool absres);
+
     //////////////////
     // Unsharp Mask //
     //////////////////
@@ -161,6 +199,97 @@ namespace svlImageProcessingHelper
                                       unsigned char* dst, const unsigned int dstheight,
                                       const unsigned int width);
 
+    class CISST_EXPORT ResizeInternals : public svlImageProcessingInternals
+    {
+    public:
+        // Source rows per work unit; each band of the source is read once
+        // while the destination rows of all levels mapping into it are computed
+        enum { BandHeight = 32 };
+        // Fixed point precision of the resampling weights
+        enum { WeightShift = 14 };
+
+        enum LevelType
+        {
+            LevelCopy,  // same size as the source
+            LevelBox,   // integer ratio area averaging
+            LevelTable  // separable resampling with per-column and per-row weight tables
+        };
+
+        class Level
+        {
+        public:
+            Level();
+
+            unsigned int Width;
+            unsigned int Height;
+            LevelType Type;
+            unsigned int FactorX;
+            unsigned int FactorY;
+            unsigned int BoxScale;
+            unsigned int TapsX;
+            unsigned int TapsY;
+            std::vector<int> ColumnOffset;      // Width x TapsX byte offsets within a source row
+            std::vector<int> ColumnWeight;      // Width x TapsX
+            std::vector<int> RowIndex;          // Height x TapsY source rows
+            std::vector<int> RowWeight;         // Height x TapsY
+            std::vector<unsigned int> BandStart;  // first destination row of each band
+            std::vector< std::vector<unsigned char> > RowCache;  // horizontally resampled source rows, per thread
+            std::vector< std::vector<int> > RowCacheTag;         // source row held by each cache slot, per thread
+            std::vector< std::vector<const unsigned char*> > RowPointers; // per thread
+            std::vector< std::vector<unsigned short> > ColumnSums; // per thread
+        };
+
+        ResizeInternals();
+
+        //! Will not do anything if neither the sizes, the method, nor the threads have changed
+        void Setup(const unsigned int srcwidth, const unsigned int srcheight, const unsigned int pixelsize,
+                   const std::vector<unsigned int> & dstwidth, const std::vector<unsigned int> & dstheight,
+                   const int method, unsigned int threadcount);
+        unsigned int GetBandCount() const;
+
+        std::vector<Level> Levels;
+
+    private:
+        void SetupLevel(Level & level, const unsigned int threadcount);
+        static void BuildTable(const unsigned int srcsize, const unsigned int dstsize, const int method, const int stride,
+                               unsigned int & taps, std::vector<int> & index, std::vector<int> & weight);
+
+        unsigned int SrcWidth;
+        unsigned int SrcHeight;
+        unsigned int PixelSize;
+        int Method;
+        unsigned int ThreadCount;
+    };
+
+    //! Computes the destination rows of all levels that belong to the source bands [band_from, band_to)
+    void CISST_EXPORT ResizeBands8(const unsigned char* src, const unsigned int srcwidth, const unsigned int pixelsize,
+                                   unsigned char* const* dst, const unsigned int band_from, const unsigned int band_to,
+                                   ResizeInternals & internals, const unsigned int thread);
+
+    /////////////
+    // Pyramid //
+    /////////////
+
+    class CISST_EXPORT PyramidInternals : public svlImageProcessingInternals
+    {
+    public:
+        PyramidInternals();
+
+        void SetThreadCount(unsigned int count);
+        unsigned short* GetRowBuffer(unsigned int thread, unsigned int size);
+
+        // Box pyramids are built with svlImageProcessing::Resize
+        svlImageProcessing::Internals ResizeInternals[2];
+
+    private:
+        std::vector< std::vector<unsigned short> > RowBuffers;
+    };
+
+    //! Rows [row_from, row_to) of the next pyramid level: 5x5 binomial filter followed by 2x decimation
+    void CISST_EXPORT PyramidDownRows8(const unsigned char* src, const unsigned int srcwidth, const unsigned int srcheight, const unsigned int pixelsize,
+                                       unsigned char* dst, const unsigned int dstwidth, const unsigned int row_from, const unsigned int row_to,
+                                       unsigned short* buffer);
+
     ///////////////////
     // Deinterlacing //
     ///////////////////
@@ -181,10 +310,31 @@ namespace svlImageProcessingHelper
         virtual ~RectificationInternals();
 
         bool Generate(unsigned int width, unsigned int height,const svlSampleCameraGeometry & geometry, unsigned int cam_id = SVL_LEFT);
-        bool Load(const std::string &filepath, int exponentlen = 3);
+        bool Load(const std::string &filepath, int exponentlen = 3, bool usecache = false);
         bool SetFromCameraCalibration(unsigned int height,unsigned int width,vct3x3 R,vct2 f, vct2 c, vctFixedSizeVector<double,7> k, double alpha, unsigned int videoch=0);
         void TransposeLUTArray2(unsigned int* index, unsigned int size, unsigned int width, unsigned int height);
 
+        // Compact LUT: one 8 byte entry per destination pixel, grouped in
+        // tiles of TileWidth x TileHeight pixels stored one after the other.
+        // The entry holds the position of the top-left pixel of the 2x2
+        // source neighborhood relative to the destination pixel and the
+        // blending weights of the four source pixels.
+        struct CompactEntry
+        {
+            short OffsetX;
+            short OffsetY;
+            unsigned char Weights[4];
+        };
+        enum { TileWidth = 64, TileHeight = 32 };
+        enum { InvalidOffset = -32768 }; // OffsetX of destination pixels not in the LUT
+
+        bool Compact();
+        bool SaveCompact(const std::string &filepath, unsigned long long sourcesize = 0, unsigned long long sourcetime = 0) const;
+        bool LoadCompact(const std::string &filepath, unsigned long long sourcesize = 0, unsigned long long sourcetime = 0);
+        bool IsCompact() const;
+        unsigned int GetTileCount() const;
+        void RemapTiles(const unsigned char* src, unsigned char* dst, unsigned int tile_from, unsigned int tile_to, bool interpolation) const;
+
         unsigned int Width;
         unsigned int Height;
         unsigned int* idxDest;
@@ -206,9 +356,14 @@ namespace svlImageProcessingHelper
         unsigned char* blendSrc4;
         int blendSrc4Size;
 
+        std::vector<CompactEntry> CompactTable;
+        std::vector<unsigned int> TileOffsets;
+
     protected:
         int LoadLine(std::ifstream &file, double* dblbuf, char* chbuf, unsigned int size, int explen);
         void TransposeLUTArray(unsigned int* index, unsigned int size, unsigned int width, unsigned int height);
+        void ComputeTileOffsets();
+        void ReleaseIndices();
         void Release();
     };
 
@@ -272,9 +427,54 @@ namespace svlImageProcessingHelper
                       double min_compactness,
                       double max_compactness);
 
+        // Run-length labeling in horizontal strips:
+        //   LabelStrip extracts the runs of a strip and connects them,
+        //   MergeStrips connects runs across strip borders, numbers the
+        //   blobs and sums their statistics, and WriteLabels fills the
+        //   label image.  Strips may be processed on different threads;
+        //   SetImageSize has to be called before the strips are labeled
+        //   and MergeStrips needs all strips to be done.
+        void SetImageSize(const svlSampleImage* image, const unsigned int videoch);
+        void SetStripCount(const unsigned int count);
+        unsigned int GetStripCount() const;
+        void LabelStrip(const svlSampleImage* image, const unsigned int videoch, const unsigned int strip);
+        unsigned int MergeStrips();
+        void WriteLabels(svlSampleImage* labels, const unsigned int videoch, const unsigned int strip);
+
     protected:
+        // Horizontal run of pixels of the same non-zero value
+        struct Run
+        {
+            int Row;
+            int Start;
+            int End;
+            unsigned int Parent;        // union-find: strip-local index until merged
+            unsigned int Label;
+            unsigned int Circumference;
+            unsigned char Value;
+        };
+
+        struct BlobStatistics
+        {
+            int Left;
+            int Right;
+            int Top;
+            int Bottom;
+            long long int SumX;
+            long long int SumY;
+            unsigned int Area;
+            unsigned int Circumference;
+            unsigned int Value;
+        };
+
         unsigned int  BlobCount;
-        vctDynamicMatrix<int> ContourBuffer;
+        int Width;
+        int Height;
+        std::vector< std::vector<Run> > StripRuns;
+        std::vector<unsigned int> Parents;
+        std::vector<BlobStatistics> Statistics;
+
+        void GetStripRows(const unsigned int strip, int &from, int &to) const;
 
         unsigned int CalculateLabelsInternal(svlSampleImage* image,
                                              svlSampleImage* labels,
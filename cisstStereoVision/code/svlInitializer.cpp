@@ -192,6 +192,10 @@ void svlInitialize()
     SVL_INITIALIZE(svlFilterImageResizer);
 #endif // _svlFilterImageResizer_h
 
+#ifdef _svlFilterImagePyramid_h
+    SVL_INITIALIZE(svlFilterImagePyramid);
+#endif // _svlFilterImagePyramid_h
+
 #ifdef _svlFilterImageZoom_h
     SVL_INITIALIZE(svlFilterImageZoom);
 #endif // _svlFilterImageZoom_h
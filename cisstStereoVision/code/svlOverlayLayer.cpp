@@ -0,0 +1,248 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlOverlayLayer.h"
+#include "svlConvertersSIMD.h"
+#include <string.h>
+#include <algorithm>
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+/*******************************/
+/*** Span kernels **************/
+/*******************************/
+
+// Byte offset of the first byte in [from, to) that differs from the
+// background values (0 on 'black', 255 on 'white')
+static unsigned int FindDrawn(const unsigned char* black, const unsigned char* white,
+                              unsigned int from, const unsigned int to)
+{
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(static_cast<char>(0xFF));
+    while (from + 16 <= to) {
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(black + from));
+        const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(white + from));
+        const __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(b, zero), _mm_cmpeq_epi8(w, ones));
+        if (_mm_movemask_epi8(eq) != 0xFFFF) break;
+        from += 16;
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+    while (from < to && black[from] == 0 && white[from] == 255) from ++;
+    return from;
+}
+
+// bg = c + round(bg * d / 255)
+static void CompositeLine(unsigned char* bg, const unsigned char* c, const unsigned char* d, const unsigned int length)
+{
+    unsigned int i = 0;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(128);
+    __m128i b, w, lo, hi;
+
+    for (; i + 16 <= length; i += 16) {
+        b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bg + i));
+        w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), _mm_unpacklo_epi8(w, zero)), half);
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), _mm_unpackhi_epi8(w, zero)), half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        b = _mm_adds_epu8(_mm_packus_epi16(lo, hi), _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bg + i), b);
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    unsigned int t, v;
+    for (; i < length; i ++) {
+        t = bg[i] * d[i] + 128;
+        v = c[i] + ((t + (t >> 8)) >> 8);
+        bg[i] = static_cast<unsigned char>(v > 255 ? 255 : v);
+    }
+}
+
+
+/*******************************/
+/*** svlOverlayLayer class *****/
+/*******************************/
+
+svlOverlayLayer::svlOverlayLayer() :
+    Valid(false)
+{
+}
+
+bool svlOverlayLayer::IsValid(const svlSampleImage* image) const
+{
+    if (!Valid || !image || image->GetVideoChannels() != Channels.size()) return false;
+    for (unsigned int vch = 0; vch < Channels.size(); vch ++) {
+        if (image->GetWidth(vch)  != Channels[vch].Width ||
+            image->GetHeight(vch) != Channels[vch].Height) return false;
+    }
+    return true;
+}
+
+void svlOverlayLayer::Invalidate()
+{
+    Valid = false;
+}
+
+void svlOverlayLayer::Build(svlSampleImage* black, svlSampleImage* white)
+{
+    const unsigned int bpp = black->GetBPP();
+    const unsigned int videochannels = black->GetVideoChannels();
+    unsigned int vch, x, y, start, end, rowlength, length;
+    unsigned char *brow, *wrow;
+    Span span;
+
+    Channels.resize(videochannels);
+
+    for (vch = 0; vch < videochannels; vch ++) {
+        Channel & channel = Channels[vch];
+
+        channel.Width  = black->GetWidth(vch);
+        channel.Height = black->GetHeight(vch);
+        channel.Spans.clear();
+        channel.Data.clear();
+        channel.Rows.resize(channel.Height + 1);
+        channel.Top    = channel.Height;
+        channel.Bottom = 0;
+
+        rowlength = channel.Width * bpp;
+
+        for (y = 0; y < channel.Height; y ++) {
+            channel.Rows[y] = static_cast<unsigned int>(channel.Spans.size());
+
+            brow = black->GetUCharPointer(vch) + y * black->GetRowStride(vch);
+            wrow = white->GetUCharPointer(vch) + y * white->GetRowStride(vch);
+
+            x = 0;
+            while (1) {
+                // Skip to the first drawn pixel
+                x = FindDrawn(brow, wrow, x, rowlength);
+                if (x >= rowlength) break;
+                start = x - x % bpp;
+
+                // Pixels on the span have to be drawn and of the same kind
+                span.Opaque = (memcmp(brow + start, wrow + start, bpp) == 0);
+                for (end = start + bpp; end < rowlength; end += bpp) {
+                    if (FindDrawn(brow, wrow, end, end + bpp) == end + bpp) break;
+                    if ((memcmp(brow + end, wrow + end, bpp) == 0) != span.Opaque) break;
+                }
+                length = end - start;
+
+                span.Start  = start;
+                span.Length = length;
+                span.Data   = static_cast<unsigned int>(channel.Data.size());
+                channel.Spans.push_back(span);
+                channel.Top    = std::min(channel.Top, y);
+                channel.Bottom = y + 1;
+
+                channel.Data.insert(channel.Data.end(), brow + start, brow + end);
+                if (!span.Opaque) {
+                    for (x = start; x < end; x ++) {
+                        channel.Data.push_back(wrow[x] > brow[x] ? wrow[x] - brow[x] : 0);
+                    }
+                }
+
+                // Restore background for the next overlay
+                memset(brow + start, 0,   length);
+                memset(wrow + start, 255, length);
+
+                x = end;
+            }
+        }
+        channel.Rows[channel.Height] = static_cast<unsigned int>(channel.Spans.size());
+    }
+
+    Valid = true;
+}
+
+void svlOverlayLayer::Composite(svlSampleImage* image, const unsigned int videoch,
+                                const unsigned int top, const unsigned int bottom) const
+{
+    if (videoch >= Channels.size()) return;
+
+    const Channel & channel = Channels[videoch];
+    const unsigned int last = std::min(bottom, channel.Bottom);
+    const unsigned int stride = image->GetRowStride(videoch);
+    unsigned char* row;
+    unsigned int y, i;
+
+    for (y = std::max(top, channel.Top); y < last; y ++) {
+        row = image->GetUCharPointer(videoch) + y * stride;
+        for (i = channel.Rows[y]; i < channel.Rows[y + 1]; i ++) {
+            const Span & span = channel.Spans[i];
+            const unsigned char* data = &(channel.Data[span.Data]);
+            if (span.Opaque) memcpy(row + span.Start, data, span.Length);
+            else CompositeLine(row + span.Start, data, data + span.Length, span.Length);
+        }
+    }
+}
+
+bool svlOverlayLayer::IsSameSize(const svlSampleImage* image1, const svlSampleImage* image2)
+{
+    if (!image1 || !image2 ||
+        image1->GetType() != image2->GetType() ||
+        image1->GetVideoChannels() != image2->GetVideoChannels()) return false;
+    for (unsigned int vch = 0; vch < image1->GetVideoChannels(); vch ++) {
+        if (image1->GetWidth(vch)  != image2->GetWidth(vch) ||
+            image1->GetHeight(vch) != image2->GetHeight(vch)) return false;
+    }
+    return true;
+}
+
+void svlOverlayLayer::Fill(svlSampleImage* image, const unsigned char value)
+{
+    for (unsigned int vch = 0; vch < image->GetVideoChannels(); vch ++) {
+        memset(image->GetUCharPointer(vch), value, image->GetDataSize(vch));
+    }
+}
+
+void svlOverlayLayer::BlendLine(unsigned char* bg, const unsigned char* ovrl, const unsigned int length, const unsigned int alpha)
+{
+    const unsigned int w1 = alpha + 1;
+    const unsigned int w0 = 256 - w1;
+    unsigned int i = 0;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    // The weighted sum is at most 256 * 255 and fits in 16 bits
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weight0 = _mm_set1_epi16(static_cast<short>(w0));
+    const __m128i weight1 = _mm_set1_epi16(static_cast<short>(w1));
+    __m128i b, o, lo, hi;
+
+    for (; i + 16 <= length; i += 16) {
+        b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bg + i));
+        o = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ovrl + i));
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weight0),
+                           _mm_mullo_epi16(_mm_unpacklo_epi8(o, zero), weight1));
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weight0),
+                           _mm_mullo_epi16(_mm_unpackhi_epi8(o, zero), weight1));
+        b = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bg + i), b);
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    for (; i < length; i ++) {
+        bg[i] = (w0 * bg[i] + w1 * ovrl[i]) >> 8;
+    }
+}
+
@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlOverlayLayer_h
+#define _svlOverlayLayer_h
+
+#include <cisstStereoVision/svlTypes.h>
+#include <vector>
+
+
+// Cached rasterization of an overlay as horizontal spans of pixels.
+// The overlay is drawn once on a black (all bytes 0) and once on a white
+// (all bytes 255) image of the frame size.  Pixels that are the same on
+// both images are opaque and copied when composited.  Other pixels that
+// differ from the background are blended: the black image holds the
+// premultiplied overlay color, the difference of the two images the
+// weight of the background.  Composited opaque pixels are identical to
+// drawing the overlay, blended pixels differ by at most one level.
+class svlOverlayLayer
+{
+public:
+    svlOverlayLayer();
+
+    // True if the layer has been built for images of this size
+    bool IsValid(const svlSampleImage* image) const;
+    void Invalidate();
+
+    // Extracts the spans from the two renderings and restores the
+    // background values where the overlay has drawn
+    void Build(svlSampleImage* black, svlSampleImage* white);
+    // Composites rows [top, bottom) of the specified video channel
+    void Composite(svlSampleImage* image, const unsigned int videoch,
+                   const unsigned int top, const unsigned int bottom) const;
+
+    static bool IsSameSize(const svlSampleImage* image1, const svlSampleImage* image2);
+    static void Fill(svlSampleImage* image, const unsigned char value);
+    // bg = (bg * (256 - w) + ovrl * w) >> 8 with w = alpha + 1, for 'length' bytes
+    static void BlendLine(unsigned char* bg, const unsigned char* ovrl, const unsigned int length, const unsigned int alpha);
+
+private:
+    typedef struct _Span {
+        unsigned int Start;     // byte offset in row
+        unsigned int Length;    // in bytes
+        unsigned int Data;      // offset in Channel::Data
+        bool         Opaque;    // color only; otherwise color and weight
+    } Span;
+
+    typedef struct _Channel {
+        unsigned int Width;
+        unsigned int Height;
+        unsigned int Top;       // rows [Top, Bottom) have spans
+        unsigned int Bottom;
+        std::vector<Span> Spans;
+        std::vector<unsigned int> Rows;     // first span of each row, Height + 1 entries
+        std::vector<unsigned char> Data;
+    } Channel;
+
+    bool Valid;
+    std::vector<Channel> Channels;
+};
+
+#endif // _svlOverlayLayer_h
+
@@ -23,6 +23,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterInput.h>
 #include <cisstStereoVision/svlFilterOutput.h>
 #include <cisstStereoVision/svlBufferImage.h>
+#include "svlOverlayLayer.h"
 
 
 /****************************/
@@ -40,7 +41,9 @@ svlOverlay::svlOverlay() :
     Next(0),
     Prev(0),
     Used(false),
-    MarkedForRemoval(_DoNotRemove)
+    MarkedForRemoval(_DoNotRemove),
+    Modified(true),
+    Layer(0)
 {
 }
 
@@ -56,17 +59,21 @@ svlOverlay::svlOverlay(unsigned int videoch,
     Next(0),
     Prev(0),
     Used(false),
-    MarkedForRemoval(_DoNotRemove)
+    MarkedForRemoval(_DoNotRemove),
+    Modified(true),
+    Layer(0)
 {
 }
 
 svlOverlay::~svlOverlay()
 {
+    if (Layer) delete Layer;
 }
 
 void svlOverlay::SetVideoChannel(unsigned int videoch)
 {
     VideoCh = videoch;
+    Invalidate();
 }
 
 void svlOverlay::SetVisible(bool visible)
@@ -91,6 +98,8 @@ bool svlOverlay::IsUsed() const
 
 void svlOverlay::SetTransform(const vct3x3 & transform, const double timestamp)
 {
+    // Called on every frame for overlays with transform IDs
+    if (transform != Transform) Invalidate();
     Transform.Assign(transform);
     TransformTimestamp = timestamp;
     if (Transform != vct3x3::Eye()) Transformed = true;
@@ -127,6 +136,16 @@ bool svlOverlay::GetTransformSynchronized() const
     return TransformSynchronized;
 }
 
+void svlOverlay::Invalidate()
+{
+    Modified = true;
+}
+
+bool svlOverlay::IsCacheable() const
+{
+    return false;
+}
+
 void svlOverlay::Draw(svlSampleImage* bgimage, svlSample* input)
 {
     if (!bgimage || !Visible) return;
@@ -411,18 +430,10 @@ void svlOverlayImage::DrawInternal(svlSampleImage* bgimage, svlSample* input)
         }
     }
     else {
-        const unsigned int w1 = Alpha + 1;
-        const unsigned int w0 = 256 - w1;
-        unsigned char *pbg, *pov;
-
-        for (int j = 0; j < linecount; j ++) {
-            pbg = bgdata;   bgdata   += ws;
-            pov = ovrldata; ovrldata += wo;
-
-            for (i = 0; i < copylen; i ++) {
-                *pbg = (w0 * (*pbg) + w1 * (*pov)) >> 8;
-                pov ++; pbg ++;
-            }
+        for (i = 0; i < linecount; i ++) {
+            svlOverlayLayer::BlendLine(bgdata, ovrldata, copylen, Alpha);
+            bgdata += ws;
+            ovrldata += wo;
         }
     }
 }
@@ -888,6 +899,7 @@ void svlOverlayStaticImage::SetImage(const svlSampleImageRGB & image)
     }
 
     Buffer->Push(image.GetUCharPointer(), image.GetDataSize(), false);
+    Invalidate();
 }
 
 void svlOverlayStaticImage::SetImage(const svlSampleImageRGBStereo & image, unsigned int imagech)
@@ -906,27 +918,32 @@ void svlOverlayStaticImage::SetImage(const svlSampleImageRGBStereo & image, unsi
     }
 
     Buffer->Push(image.GetUCharPointer(imagech), image.GetDataSize(imagech), false);
+    Invalidate();
 }
 
 void svlOverlayStaticImage::SetPosition(vctInt2 pos)
 {
     Pos = pos;
+    Invalidate();
 }
 
 void svlOverlayStaticImage::SetPosition(int x, int y)
 {
     Pos[0] = x;
     Pos[1] = y;
+    Invalidate();
 }
 
 void svlOverlayStaticImage::SetAlpha(unsigned char alpha)
 {
     Alpha = alpha;
+    Invalidate();
 }
 
 void svlOverlayStaticImage::SetEnableQuadMapping(bool enable)
 {
     QuadMappingEnabled = enable;
+    Invalidate();
 }
 
 void svlOverlayStaticImage::SetQuadMapping(vctInt2 ul, vctInt2 ur, vctInt2 ll, vctInt2 lr)
@@ -936,6 +953,7 @@ void svlOverlayStaticImage::SetQuadMapping(vctInt2 ul, vctInt2 ur, vctInt2 ll, v
     QuadLL = ll;
     QuadLR = lr;
     QuadMappingSet = true;
+    Invalidate();
 }
 
 void svlOverlayStaticImage::SetQuadMapping(int xul, int yul, int xur, int yur, int xll, int yll, int xlr, int ylr)
@@ -945,6 +963,7 @@ void svlOverlayStaticImage::SetQuadMapping(int xul, int yul, int xur, int yur, i
     QuadLL.Assign(xll, yll);
     QuadLR.Assign(xlr, ylr);
     QuadMappingSet = true;
+    Invalidate();
 }
 
 vctInt2 svlOverlayStaticImage::GetPosition() const
@@ -962,6 +981,11 @@ bool svlOverlayStaticImage::GetEnableQuadMapping() const
     return QuadMappingEnabled;
 }
 
+bool svlOverlayStaticImage::IsCacheable() const
+{
+    return true;
+}
+
 void svlOverlayStaticImage::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     if (!Buffer) return;
@@ -1081,18 +1105,10 @@ void svlOverlayStaticImage::DrawInternal(svlSampleImage* bgimage, svlSample* CMN
         }
     }
     else {
-        const unsigned int w1 = Alpha + 1;
-        const unsigned int w0 = 256 - w1;
-        unsigned char *pbg, *pov;
-
-        for (int j = 0; j < linecount; j ++) {
-            pbg = bgdata;   bgdata   += ws;
-            pov = ovrldata; ovrldata += wo;
-
-            for (i = 0; i < copylen; i ++) {
-                *pbg = (w0 * (*pbg) + w1 * (*pov)) >> 8;
-                pov ++; pbg ++;
-            }
+        for (i = 0; i < linecount; i ++) {
+            svlOverlayLayer::BlendLine(bgdata, ovrldata, copylen, Alpha);
+            bgdata += ws;
+            ovrldata += wo;
         }
     }
 }
@@ -1158,37 +1174,44 @@ svlOverlayStaticText::~svlOverlayStaticText()
 void svlOverlayStaticText::SetText(const std::string & text)
 {
     Text = text;
+    Invalidate();
 }
 
 void svlOverlayStaticText::SetRect(svlRect rect)
 {
     Rect = rect;
+    Invalidate();
 }
 
 void svlOverlayStaticText::SetRect(int left, int top, int right, int bottom)
 {
     Rect.Assign(left, top, right, bottom);
+    Invalidate();
 }
 
 void svlOverlayStaticText::SetTextColor(svlRGB txtcolor)
 {
     TxtColor = txtcolor;
+    Invalidate();
 }
 
 void svlOverlayStaticText::SetFontSize(double size)
 {
     FontSize = size / SVL_OCV_FONT_SCALE;
     FontChanged = true;
+    Invalidate();
 }
 
 void svlOverlayStaticText::SetBackground(bool enable)
 {
     Background = enable;
+    Invalidate();
 }
 
 void svlOverlayStaticText::SetBackgroundColor(svlRGB bgcolor)
 {
     BGColor = bgcolor;
+    Invalidate();
 }
 
 const std::string & svlOverlayStaticText::GetText() const
@@ -1260,6 +1283,11 @@ svlRect svlOverlayStaticText::GetTextSize(const std::string & CMN_UNUSED(text))
 
 #endif // CISST_SVL_HAS_OPENCV
 
+bool svlOverlayStaticText::IsCacheable() const
+{
+    return true;
+}
+
 #if CISST_SVL_HAS_OPENCV
 
 void svlOverlayStaticText::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
@@ -1364,6 +1392,12 @@ bool svlOverlayText::IsInputTypeValid(svlStreamType inputtype)
     return false;
 }
 
+bool svlOverlayText::IsCacheable() const
+{
+    // The text comes from the input
+    return false;
+}
+
 void svlOverlayText::DrawInternal(svlSampleImage* bgimage, svlSample* input)
 {
     // Get sample from input
@@ -1409,21 +1443,25 @@ svlOverlayStaticRect::~svlOverlayStaticRect()
 void svlOverlayStaticRect::SetRect(const svlRect & rect)
 {
     Rect = rect;
+    Invalidate();
 }
 
 void svlOverlayStaticRect::SetRect(int left, int top, int right, int bottom)
 {
     Rect.Assign(left, top, right, bottom);
+    Invalidate();
 }
 
 void svlOverlayStaticRect::SetColor(const svlRGB & color)
 {
     Color = color;
+    Invalidate();
 }
 
 void svlOverlayStaticRect::SetFill(bool fill)
 {
     Fill = fill;
+    Invalidate();
 }
 
 svlRect svlOverlayStaticRect::GetRect() const
@@ -1449,6 +1487,11 @@ bool svlOverlayStaticRect::GetFill() const
     return Fill;
 }
 
+bool svlOverlayStaticRect::IsCacheable() const
+{
+    return true;
+}
+
 void svlOverlayStaticRect::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     if (Transformed) {
@@ -1557,43 +1600,51 @@ svlOverlayStaticEllipse::~svlOverlayStaticEllipse()
 void svlOverlayStaticEllipse::SetEllipse(const svlEllipse & ellipse)
 {
     Ellipse = ellipse;
+    Invalidate();
 }
 
 void svlOverlayStaticEllipse::SetCenter(const svlPoint2D & center)
 {
     Ellipse.cx = center.x;
     Ellipse.cy = center.y;
+    Invalidate();
 }
 
 void svlOverlayStaticEllipse::SetRadius(const int radius_horiz, const int radius_vert)
 {
     Ellipse.rx = radius_horiz;
     Ellipse.ry = radius_vert;
+    Invalidate();
 }
 
 void svlOverlayStaticEllipse::SetRadius(const int radius)
 {
     Ellipse.rx = Ellipse.ry = radius;
+    Invalidate();
 }
 
 void svlOverlayStaticEllipse::SetAngle(const double angle)
 {
     Ellipse.angle = angle;
+    Invalidate();
 }
 
 void svlOverlayStaticEllipse::SetThickness(unsigned int thickness) 
 {
     Thickness = thickness;
+    Invalidate();
 }
 
 void svlOverlayStaticEllipse::SetColor(const svlRGB & color)
 {
     Color = color;
+    Invalidate();
 }
 
 void svlOverlayStaticEllipse::SetFill(bool fill)
 {
     Fill = fill;
+    Invalidate();
 }
 
 svlEllipse svlOverlayStaticEllipse::GetEllipse() const
@@ -1632,6 +1683,11 @@ bool svlOverlayStaticEllipse::GetFill() const
     return Fill;
 }
 
+bool svlOverlayStaticEllipse::IsCacheable() const
+{
+    return true;
+}
+
 void svlOverlayStaticEllipse::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     int cx, cy, rx, ry;
@@ -1726,6 +1782,7 @@ void svlOverlayStaticTriangle::SetCorners(const svlPoint2D corner1,
     Corner1 = corner1;
     Corner2 = corner2;
     Corner3 = corner3;
+    Invalidate();
 }
 
 void svlOverlayStaticTriangle::SetCorners(const int x1, const int y1,
@@ -1735,16 +1792,19 @@ void svlOverlayStaticTriangle::SetCorners(const int x1, const int y1,
     Corner1.Assign(x1, y1);
     Corner2.Assign(x2, y2);
     Corner3.Assign(x3, y3);
+    Invalidate();
 }
 
 void svlOverlayStaticTriangle::SetColor(svlRGB color)
 {
     Color = color;
+    Invalidate();
 }
 
 void svlOverlayStaticTriangle::SetFill(bool fill)
 {
     Fill = fill;
+    Invalidate();
 }
 
 void svlOverlayStaticTriangle::GetCorners(svlPoint2D& corner1,
@@ -1775,6 +1835,11 @@ bool svlOverlayStaticTriangle::GetFill() const
     return Fill;
 }
 
+bool svlOverlayStaticTriangle::IsCacheable() const
+{
+    return true;
+}
+
 void svlOverlayStaticTriangle::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     int x1, y1, x2, y2, x3, y3;
@@ -1984,6 +2049,7 @@ void svlOverlayStaticPoly::SetPoints()
     CS.Enter();
         Poly.SetSize(0);
     CS.Leave();
+    Invalidate();
 }
 
 void svlOverlayStaticPoly::SetPoints(const TypeRef points)
@@ -1991,6 +2057,7 @@ void svlOverlayStaticPoly::SetPoints(const TypeRef points)
     CS.Enter();
         Poly.ForceAssign(points);
     CS.Leave();
+    Invalidate();
 }
 
 void svlOverlayStaticPoly::SetPoints(const TypeRef points, unsigned int start)
@@ -1999,21 +2066,25 @@ void svlOverlayStaticPoly::SetPoints(const TypeRef points, unsigned int start)
         Poly.ForceAssign(points);
         Start = start;
     CS.Leave();
+    Invalidate();
 }
 
 void svlOverlayStaticPoly::SetColor(svlRGB color)
 {
     Color = color;
+    Invalidate();
 }
 
 void svlOverlayStaticPoly::SetThickness(unsigned int thickness)
 {
     Thickness = thickness;
+    Invalidate();
 }
 
 void svlOverlayStaticPoly::SetStart(unsigned int start)
 {
     Start = start;
+    Invalidate();
 }
 
 svlOverlayStaticPoly::TypeRef svlOverlayStaticPoly::GetPoints()
@@ -2043,6 +2114,7 @@ unsigned int svlOverlayStaticPoly::AddPoint(svlPoint2D point)
         Poly.resize(size + 1);
         Poly[size] = point;
     CS.Leave();
+    Invalidate();
     return size;
 }
 
@@ -2054,6 +2126,7 @@ unsigned int svlOverlayStaticPoly::AddPoint(int x, int y)
         Poly[size].x = x;
         Poly[size].y = y;
     CS.Leave();
+    Invalidate();
     return size;
 }
 
@@ -2061,6 +2134,7 @@ int svlOverlayStaticPoly::SetPoint(unsigned int idx, svlPoint2D point)
 {
     if (idx >= Poly.size()) return SVL_FAIL;
     Poly[idx] = point;
+    Invalidate();
     return SVL_OK;
 }
 
@@ -2069,6 +2143,7 @@ int svlOverlayStaticPoly::SetPoint(unsigned int idx, vctInt2 point)
     if (idx >= Poly.size()) return SVL_FAIL;
     Poly[idx].x = point.X();
     Poly[idx].y = point.Y();
+    Invalidate();
     return SVL_OK;
 }
 
@@ -2077,6 +2152,7 @@ int svlOverlayStaticPoly::SetPoint(unsigned int idx, int x, int y)
     if (idx >= Poly.size()) return SVL_FAIL;
     Poly[idx].x = x;
     Poly[idx].y = y;
+    Invalidate();
     return SVL_OK;
 }
 
@@ -2103,6 +2179,11 @@ int svlOverlayStaticPoly::GetPoint(unsigned int idx, int & x, int & y) const
     return SVL_OK;
 }
 
+bool svlOverlayStaticPoly::IsCacheable() const
+{
+    return true;
+}
+
 void svlOverlayStaticPoly::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     if (Transformed) {
@@ -2208,53 +2289,63 @@ svlOverlayStaticBar::~svlOverlayStaticBar()
 void svlOverlayStaticBar::SetRange(const vct2 range)
 {
     Range = range;
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetRange(const double from, const double to)
 {
     Range[0] = from;
     Range[1] = to;
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetValue(const double value)
 {
     Value = value;
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetDirection(const bool vertical)
 {
     Vertical = vertical;
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetRect(svlRect rect)
 {
     Rect = rect;
     Rect.Normalize();
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetRect(int left, int top, int right, int bottom)
 {
     Rect.Assign(left, top, right, bottom);
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetColor(svlRGB color)
 {
     Color = color;
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetBackgroundColor(svlRGB bgcolor)
 {
     BGColor = bgcolor;
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetBorderWidth(const unsigned int pixels)
 {
     BorderWidth = static_cast<int>(pixels);
+    Invalidate();
 }
 
 void svlOverlayStaticBar::SetBorderColor(svlRGB bordercolor)
 {
     BorderColor = bordercolor;
+    Invalidate();
 }
 
 vct2 svlOverlayStaticBar::GetRange() const
@@ -2353,6 +2444,11 @@ int svlOverlayStaticBar::GetImagePosInValue(int imagepos, double & value) const
     return ret;
 }
 
+bool svlOverlayStaticBar::IsCacheable() const
+{
+    return true;
+}
+
 void svlOverlayStaticBar::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     if (Transformed) {
@@ -2573,6 +2669,12 @@ void svlOverlayFramerate::Reset()
     ResetFlag = true;
 }
 
+bool svlOverlayFramerate::IsCacheable() const
+{
+    // The text is updated by DrawInternal
+    return false;
+}
+
 void svlOverlayFramerate::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     if (Filter) {
@@ -2646,6 +2748,12 @@ svlOverlayTimestamp::~svlOverlayTimestamp()
 {
 }
 
+bool svlOverlayTimestamp::IsCacheable() const
+{
+    // The text is updated by DrawInternal
+    return false;
+}
+
 void svlOverlayTimestamp::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     if (Filter) {
@@ -2704,6 +2812,12 @@ svlOverlayAsyncOutputProperties::~svlOverlayAsyncOutputProperties()
 {
 }
 
+bool svlOverlayAsyncOutputProperties::IsCacheable() const
+{
+    // The text is updated by DrawInternal
+    return false;
+}
+
 void svlOverlayAsyncOutputProperties::DrawInternal(svlSampleImage* bgimage, svlSample* CMN_UNUSED(input))
 {
     if (Output) {
@@ -28,12 +28,16 @@ http://www.cisst.org/cisst/license.txt.
 
 svlSample::svlSample() :
     mtsGenericObject(),
-    EncoderParameter(-1)
+    EncoderParameter(-1),
+    Pool(0),
+    References(0)
 {
 }
 
 svlSample::svlSample(const svlSample & other) :
-    mtsGenericObject(other)
+    mtsGenericObject(other),
+    Pool(0),
+    References(0)
 {
     SetTimestamp(other.Timestamp);
     SetEncoder(other.Encoder, other.EncoderParameter);
@@ -65,6 +69,21 @@ double svlSample::GetTimestamp() const
     return Timestamp;
 }
 
+svlSamplePool* svlSample::GetPool() const
+{
+    return Pool;
+}
+
+unsigned int svlSample::GetReferenceCount() const
+{
+    return References;
+}
+
+bool svlSample::IsShared() const
+{
+    return References > 1;
+}
+
 svlSample* svlSample::GetNewFromType(svlStreamType type)
 {
     switch (type) {
@@ -122,6 +141,7 @@ svlSample* svlSample::GetNewFromType(svlStreamType type)
         case svlTypeText:                  return new svlSampleText;
         case svlTypeCameraGeometry:        return new svlSampleCameraGeometry;
         case svlTypeBlobs:                 return new svlSampleBlobs;
+        case svlTypeImagePyramid:          return new svlSampleImagePyramid;
     }
     return 0;
 }
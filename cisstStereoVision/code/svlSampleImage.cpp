@@ -104,6 +104,7 @@ svlPixelType svlSampleImage::GetPixelType() const
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
         break;
     }
     return svlPixelUnknown;
@@ -155,6 +156,7 @@ int svlSampleImage::GetAlphaChannel() const
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
         break;
     }
     return SVL_FAIL;
@@ -401,6 +403,7 @@ int svlSampleImage::ImportMatrix(const svlSampleMatrix* matrix, const int param,
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
         break;
     }
 
@@ -0,0 +1,367 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstStereoVision/svlTypes.h>
+
+
+/***********************************/
+/*** svlSampleImagePyramid class ***/
+/***********************************/
+
+CMN_IMPLEMENT_SERVICES(svlSampleImagePyramid)
+
+svlSampleImagePyramid::svlSampleImagePyramid() :
+    svlSample(),
+    ImageType(svlTypeInvalid),
+    VideoChannels(0),
+    BPP(0),
+    Levels(0)
+{
+}
+
+svlSampleImagePyramid::svlSampleImagePyramid(const svlSampleImagePyramid & other) :
+    svlSample(other),
+    ImageType(svlTypeInvalid),
+    VideoChannels(0),
+    BPP(0),
+    Levels(0)
+{
+    CopyOf(other);
+}
+
+svlSampleImagePyramid & svlSampleImagePyramid::operator= (const svlSampleImagePyramid & other)
+{
+    CopyOf(other);
+    return *this;
+}
+
+svlSampleImagePyramid::~svlSampleImagePyramid()
+{
+    ReleaseLevelImages();
+}
+
+svlSample* svlSampleImagePyramid::GetNewInstance() const
+{
+    return new svlSampleImagePyramid;
+}
+
+svlStreamType svlSampleImagePyramid::GetType() const
+{
+    return svlTypeImagePyramid;
+}
+
+int svlSampleImagePyramid::SetSize(const svlSample* sample)
+{
+    const svlSampleImagePyramid* pyramid = dynamic_cast<const svlSampleImagePyramid*>(sample);
+    if (pyramid == 0) return SVL_FAIL;
+
+    std::vector<unsigned int> width(pyramid->VideoChannels), height(pyramid->VideoChannels);
+    for (unsigned int vch = 0; vch < pyramid->VideoChannels; vch ++) {
+        width[vch]  = pyramid->GetWidth(0, vch);
+        height[vch] = pyramid->GetHeight(0, vch);
+    }
+    return Allocate(pyramid->ImageType, width, height, pyramid->Levels);
+}
+
+int svlSampleImagePyramid::SetSize(const svlSample& sample)
+{
+    return SetSize(&sample);
+}
+
+int svlSampleImagePyramid::CopyOf(const svlSample* sample)
+{
+    const svlSampleImagePyramid* pyramid = dynamic_cast<const svlSampleImagePyramid*>(sample);
+    if (pyramid == 0 || SetSize(pyramid) != SVL_OK) return SVL_FAIL;
+
+    memcpy(GetUCharPointer(), pyramid->GetUCharPointer(), GetDataSize());
+    SetTimestamp(pyramid->GetTimestamp());
+
+    return SVL_OK;
+}
+
+int svlSampleImagePyramid::CopyOf(const svlSample& sample)
+{
+    return CopyOf(&sample);
+}
+
+bool svlSampleImagePyramid::IsInitialized() const
+{
+    return (Levels > 0 && Buffer.size() > 0);
+}
+
+unsigned char* svlSampleImagePyramid::GetUCharPointer()
+{
+    return Buffer.Pointer();
+}
+
+const unsigned char* svlSampleImagePyramid::GetUCharPointer() const
+{
+    return Buffer.Pointer();
+}
+
+unsigned int svlSampleImagePyramid::GetDataSize() const
+{
+    return static_cast<unsigned int>(Buffer.size());
+}
+
+void svlSampleImagePyramid::SerializeRaw(std::ostream & outputStream) const
+{
+    mtsGenericObject::SerializeRaw(outputStream);
+
+    cmnSerializeRaw(outputStream, static_cast<int>(GetType()));
+    cmnSerializeRaw(outputStream, GetTimestamp());
+    cmnSerializeRaw(outputStream, static_cast<int>(ImageType));
+    cmnSerializeRaw(outputStream, VideoChannels);
+    cmnSerializeRaw(outputStream, Levels);
+    for (unsigned int vch = 0; vch < VideoChannels; vch ++) {
+        cmnSerializeRaw(outputStream, GetWidth(0, vch));
+        cmnSerializeRaw(outputStream, GetHeight(0, vch));
+    }
+    if (Buffer.size() > 0) {
+        outputStream.write(reinterpret_cast<const char*>(Buffer.Pointer()), Buffer.size());
+    }
+}
+
+void svlSampleImagePyramid::DeSerializeRaw(std::istream & inputStream)
+{
+    mtsGenericObject::DeSerializeRaw(inputStream);
+
+    int type = -1, imagetype = -1;
+    double timestamp;
+    unsigned int videochannels = 0, levels = 0, vch;
+    cmnDeSerializeRaw(inputStream, type);
+    if (type != GetType()) {
+        CMN_LOG_CLASS_RUN_ERROR << "Deserialized sample type mismatch " << std::endl;
+        return;
+    }
+    cmnDeSerializeRaw(inputStream, timestamp);
+    SetTimestamp(timestamp);
+    cmnDeSerializeRaw(inputStream, imagetype);
+    cmnDeSerializeRaw(inputStream, videochannels);
+    cmnDeSerializeRaw(inputStream, levels);
+    if (videochannels > 2) {
+        CMN_LOG_CLASS_RUN_ERROR << "Deserialized pyramid has invalid number of video channels" << std::endl;
+        return;
+    }
+
+    std::vector<unsigned int> width(videochannels), height(videochannels);
+    for (vch = 0; vch < videochannels; vch ++) {
+        cmnDeSerializeRaw(inputStream, width[vch]);
+        cmnDeSerializeRaw(inputStream, height[vch]);
+    }
+    if (Allocate(static_cast<svlStreamType>(imagetype), width, height, levels) != SVL_OK) {
+        CMN_LOG_CLASS_RUN_ERROR << "Deserialized pyramid has invalid dimensions" << std::endl;
+        return;
+    }
+    if (Buffer.size() > 0) {
+        inputStream.read(reinterpret_cast<char*>(Buffer.Pointer()), Buffer.size());
+    }
+}
+
+int svlSampleImagePyramid::SetSize(const svlSampleImage & image, const unsigned int levels)
+{
+    const unsigned int videochannels = image.GetVideoChannels();
+    std::vector<unsigned int> width(videochannels), height(videochannels);
+    for (unsigned int vch = 0; vch < videochannels; vch ++) {
+        width[vch]  = image.GetWidth(vch);
+        height[vch] = image.GetHeight(vch);
+    }
+    return Allocate(image.GetType(), width, height, levels);
+}
+
+int svlSampleImagePyramid::SetSize(const svlStreamType imagetype, const unsigned int width, const unsigned int height, const unsigned int levels)
+{
+    const unsigned int videochannels = (imagetype == svlTypeImageRGBStereo || imagetype == svlTypeImageMono8Stereo) ? 2 : 1;
+    return Allocate(imagetype, std::vector<unsigned int>(videochannels, width), std::vector<unsigned int>(videochannels, height), levels);
+}
+
+svlStreamType svlSampleImagePyramid::GetImageType() const
+{
+    return ImageType;
+}
+
+svlPixelType svlSampleImagePyramid::GetPixelType() const
+{
+    if (BPP == 3) return svlPixelRGB;
+    if (BPP == 1) return svlPixelMono8;
+    return svlPixelUnknown;
+}
+
+unsigned int svlSampleImagePyramid::GetBPP() const
+{
+    return BPP;
+}
+
+unsigned int svlSampleImagePyramid::GetVideoChannels() const
+{
+    return VideoChannels;
+}
+
+unsigned int svlSampleImagePyramid::GetLevelCount() const
+{
+    return Levels;
+}
+
+unsigned int svlSampleImagePyramid::GetWidth(const unsigned int level, const unsigned int videochannel) const
+{
+    const unsigned int idx = GetIndex(level, videochannel);
+    if (idx < Width.size()) return Width[idx];
+    return 0;
+}
+
+unsigned int svlSampleImagePyramid::GetHeight(const unsigned int level, const unsigned int videochannel) const
+{
+    const unsigned int idx = GetIndex(level, videochannel);
+    if (idx < Height.size()) return Height[idx];
+    return 0;
+}
+
+unsigned char* svlSampleImagePyramid::GetUCharPointer(const unsigned int level, const unsigned int videochannel)
+{
+    const unsigned int idx = GetIndex(level, videochannel);
+    if (idx < Offset.size()) return Buffer.Pointer() + Offset[idx];
+    return 0;
+}
+
+const unsigned char* svlSampleImagePyramid::GetUCharPointer(const unsigned int level, const unsigned int videochannel) const
+{
+    const unsigned int idx = GetIndex(level, videochannel);
+    if (idx < Offset.size()) return Buffer.Pointer() + Offset[idx];
+    return 0;
+}
+
+unsigned int svlSampleImagePyramid::GetDataSize(const unsigned int level, const unsigned int videochannel) const
+{
+    const unsigned int idx = GetIndex(level, videochannel);
+    if (idx < Width.size()) return Width[idx] * Height[idx] * BPP;
+    return 0;
+}
+
+svlSampleImage* svlSampleImagePyramid::GetLevel(const unsigned int level)
+{
+    if (level < LevelImages.size()) return LevelImages[level];
+    return 0;
+}
+
+const svlSampleImage* svlSampleImagePyramid::GetLevel(const unsigned int level) const
+{
+    if (level < LevelImages.size()) return LevelImages[level];
+    return 0;
+}
+
+int svlSampleImagePyramid::Allocate(const svlStreamType imagetype, const std::vector<unsigned int> & width, const std::vector<unsigned int> & height, const unsigned int levels)
+{
+    unsigned int bpp, videochannels;
+
+    switch (imagetype) {
+        case svlTypeImageRGB:         bpp = 3; videochannels = 1; break;
+        case svlTypeImageRGBStereo:   bpp = 3; videochannels = 2; break;
+        case svlTypeImageMono8:       bpp = 1; videochannels = 1; break;
+        case svlTypeImageMono8Stereo: bpp = 1; videochannels = 2; break;
+        default:                      return SVL_FAIL;
+    }
+    if (levels < 1 || width.size() != videochannels || height.size() != videochannels) return SVL_FAIL;
+
+    unsigned int level, vch, idx;
+
+    // Will not reallocate if the layout has not changed
+    bool changed = (ImageType != imagetype || Levels != levels);
+    for (vch = 0; !changed && vch < videochannels; vch ++) {
+        if (Width[vch] != width[vch] || Height[vch] != height[vch]) changed = true;
+    }
+    if (!changed) return SVL_OK;
+
+    ReleaseLevelImages();
+
+    ImageType     = imagetype;
+    VideoChannels = videochannels;
+    BPP           = bpp;
+    Levels        = levels;
+    Width.resize(levels * videochannels);
+    Height.resize(levels * videochannels);
+    Offset.resize(levels * videochannels);
+
+    unsigned int size = 0;
+    for (level = 0; level < levels; level ++) {
+        for (vch = 0; vch < videochannels; vch ++) {
+            idx = GetIndex(level, vch);
+            if (level == 0) {
+                Width[idx]  = width[vch];
+                Height[idx] = height[vch];
+            }
+            else {
+                Width[idx]  = std::max(Width[idx - videochannels]  / 2, 1u);
+                Height[idx] = std::max(Height[idx - videochannels] / 2, 1u);
+            }
+            Offset[idx] = size;
+            size += Width[idx] * Height[idx] * bpp;
+        }
+    }
+    Buffer.SetSize(size);
+
+    CreateLevelImages();
+
+    return SVL_OK;
+}
+
+void svlSampleImagePyramid::ReleaseLevelImages()
+{
+    for (unsigned int level = 0; level < LevelImages.size(); level ++) {
+        delete LevelImages[level];
+    }
+    LevelImages.clear();
+}
+
+void svlSampleImagePyramid::CreateLevelImages()
+{
+    LevelImages.assign(Levels, 0);
+
+    for (unsigned int level = 0; level < Levels; level ++) {
+        svlSampleImage* image = 0;
+
+        // Images that do not own their data
+        switch (ImageType) {
+            case svlTypeImageRGB:         image = new svlSampleImageRGB(false);         break;
+            case svlTypeImageRGBStereo:   image = new svlSampleImageRGBStereo(false);   break;
+            case svlTypeImageMono8:       image = new svlSampleImageMono8(false);       break;
+            case svlTypeImageMono8Stereo: image = new svlSampleImageMono8Stereo(false); break;
+            default:                      break;
+        }
+        if (!image) continue;
+
+        for (unsigned int vch = 0; vch < VideoChannels; vch ++) {
+            const unsigned int rowsize = GetWidth(level, vch) * BPP;
+            vctDynamicMatrixRef<unsigned char> data(GetHeight(level, vch), rowsize, rowsize, 1, GetUCharPointer(level, vch));
+
+            switch (ImageType) {
+                case svlTypeImageRGB:         dynamic_cast<svlSampleImageRGB*>(image)->SetMatrix(data, vch);         break;
+                case svlTypeImageRGBStereo:   dynamic_cast<svlSampleImageRGBStereo*>(image)->SetMatrix(data, vch);   break;
+                case svlTypeImageMono8:       dynamic_cast<svlSampleImageMono8*>(image)->SetMatrix(data, vch);       break;
+                case svlTypeImageMono8Stereo: dynamic_cast<svlSampleImageMono8Stereo*>(image)->SetMatrix(data, vch); break;
+                default:                      break;
+            }
+        }
+        LevelImages[level] = image;
+    }
+}
+
+unsigned int svlSampleImagePyramid::GetIndex(const unsigned int level, const unsigned int videochannel) const
+{
+    if (level >= Levels || videochannel >= VideoChannels) return 0xFFFFFFFF;
+    return level * VideoChannels + videochannel;
+}
+
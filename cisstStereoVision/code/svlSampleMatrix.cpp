@@ -86,6 +86,7 @@ int svlSampleMatrix::ImportData(_TypeIn *input, const unsigned int size)
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
         break;
     }
     return SVL_FAIL;
@@ -144,6 +145,7 @@ int svlSampleMatrix::ImportMatrix(const svlSampleMatrix* matrix)
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
         break;
     }
 
@@ -221,6 +223,7 @@ int svlSampleMatrix::ImportImage(const svlSampleImage* image)
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
         break;
     }
 
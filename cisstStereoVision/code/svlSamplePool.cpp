@@ -0,0 +1,226 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstStereoVision/svlSamplePool.h>
+
+
+/***************************/
+/*** svlSamplePool class ***/
+/***************************/
+
+svlSamplePool::svlSamplePool(unsigned int maxfree) :
+    MaxFree(maxfree),
+    Allocations(0),
+    Recycles(0)
+{
+}
+
+svlSamplePool::~svlSamplePool()
+{
+    Clear();
+}
+
+svlSamplePool* svlSamplePool::GetInstance()
+{
+    // Intentionally leaked: samples may still be released by static
+    // objects and threads after the end of main()
+    static svlSamplePool* Instance = new svlSamplePool;
+    return Instance;
+}
+
+svlSample* svlSamplePool::Acquire(svlStreamType type)
+{
+    svlSample* sample = Recycle(type, 0);
+    if (!sample) {
+        sample = svlSample::GetNewFromType(type);
+        if (!sample) return 0;
+
+        CS.Enter();
+            Allocations ++;
+        CS.Leave();
+    }
+
+    sample->Pool = this;
+    sample->References = 1;
+
+    return sample;
+}
+
+svlSample* svlSamplePool::Acquire(const svlSample* prototype)
+{
+    if (!prototype) return 0;
+
+    const svlStreamType type = prototype->GetType();
+    svlSample* sample = Recycle(type, prototype->GetDataSize());
+    if (!sample) {
+        sample = svlSample::GetNewFromType(type);
+        if (!sample) return 0;
+
+        CS.Enter();
+            Allocations ++;
+        CS.Leave();
+    }
+
+    // No allocation takes place if the recycled sample has the same size
+    sample->SetSize(prototype);
+    sample->Pool = this;
+    sample->References = 1;
+
+    return sample;
+}
+
+svlSample* svlSamplePool::AcquireCopy(const svlSample* source)
+{
+    svlSample* sample = Acquire(source);
+    if (sample && sample->CopyOf(source) != SVL_OK) {
+        Release(sample);
+        return 0;
+    }
+    return sample;
+}
+
+svlSample* svlSamplePool::AddReference(svlSample* sample)
+{
+    if (!sample) return 0;
+
+    // Only pooled samples have a reference count
+    if (!sample->Pool) return AcquireCopy(sample);
+
+    CS.Enter();
+        sample->References ++;
+    CS.Leave();
+
+    return sample;
+}
+
+void svlSamplePool::Release(svlSample* sample)
+{
+    if (!sample || !sample->Pool) return;
+
+    // Samples are returned to the pool that allocated them
+    if (sample->Pool != this) {
+        sample->Pool->Release(sample);
+        return;
+    }
+
+    CS.Enter();
+        if (sample->References > 0 && -- sample->References == 0) {
+            FreeItems.push_back(sample);
+            Trim();
+        }
+    CS.Leave();
+}
+
+svlSample* svlSamplePool::GetWritable(svlSample* sample)
+{
+    if (!sample || !sample->Pool) return sample;
+
+    CS.Enter();
+        const bool shared = sample->References > 1;
+    CS.Leave();
+    if (!shared) return sample;
+
+    // The other holders only read the sample, thus it is safe to copy it
+    svlSample* copy = AcquireCopy(sample);
+    if (!copy) return 0;
+    Release(sample);
+
+    return copy;
+}
+
+void svlSamplePool::SetMaxFreeCount(unsigned int count)
+{
+    CS.Enter();
+        MaxFree = count;
+        Trim();
+    CS.Leave();
+}
+
+unsigned int svlSamplePool::GetMaxFreeCount() const
+{
+    return MaxFree;
+}
+
+unsigned int svlSamplePool::GetFreeCount() const
+{
+    CS.Enter();
+        const unsigned int count = static_cast<unsigned int>(FreeItems.size());
+    CS.Leave();
+    return count;
+}
+
+unsigned int svlSamplePool::GetAllocationCount() const
+{
+    return Allocations;
+}
+
+unsigned int svlSamplePool::GetRecycleCount() const
+{
+    return Recycles;
+}
+
+void svlSamplePool::Clear()
+{
+    CS.Enter();
+        for (std::list<svlSample*>::iterator it = FreeItems.begin(); it != FreeItems.end(); ++ it) {
+            delete *it;
+        }
+        FreeItems.clear();
+    CS.Leave();
+}
+
+svlSample* svlSamplePool::Recycle(svlStreamType type, unsigned int datasize)
+{
+    svlSample* sample = 0;
+
+    CS.Enter();
+        // Most recently released sample of the same size, or else of the same type
+        std::list<svlSample*>::iterator found = FreeItems.end();
+        std::list<svlSample*>::iterator it = FreeItems.end();
+        while (it != FreeItems.begin()) {
+            -- it;
+            if ((*it)->GetType() != type) continue;
+            if (found == FreeItems.end()) found = it;
+            if (datasize == 0 || (*it)->GetDataSize() == datasize) {
+                found = it;
+                break;
+            }
+        }
+        if (found != FreeItems.end()) {
+            sample = *found;
+            FreeItems.erase(found);
+            Recycles ++;
+        }
+    CS.Leave();
+
+    // Recycled samples must not carry over the metadata of the last frame
+    if (sample) {
+        sample->SetTimestamp(-1.0);
+        sample->SetEncoder("", -1);
+    }
+
+    return sample;
+}
+
+void svlSamplePool::Trim()
+{
+    // Called from within the critical section
+    while (FreeItems.size() > MaxFree) {
+        delete FreeItems.front();
+        FreeItems.pop_front();
+    }
+}
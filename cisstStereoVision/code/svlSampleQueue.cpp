@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlSampleQueue.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 
 
 /****************************/
@@ -30,51 +31,61 @@ svlSampleQueue::svlSampleQueue(svlStreamType type, unsigned int size) :
     Type(type),
     Size(std::max(size, 2u)), // TO DO: check why it doesn't work when min=1
     DroppedSamples(0),
-    UnusedItems(Size, 0)
+    ReadOnly(false),
+    PullItem(0),
+    Pool(svlSamplePool::GetInstance())
 {
-    PullItem = svlSample::GetNewFromType(type);
-    for (std::list<svlSample*>::iterator it = UnusedItems.begin();
-         it != UnusedItems.end();
-         ++ it) {
-        *it = svlSample::GetNewFromType(type);
-    }
+    // Keep an initialized sample for Peek() until the first Pull()
+    PullItem = Pool->Acquire(type);
 }
 
 svlSampleQueue::~svlSampleQueue()
 {
-    delete PullItem;
-    for (std::list<svlSample*>::iterator it = UnusedItems.begin();
-         it != UnusedItems.end();
+    Pool->Release(PullItem);
+    for (std::list<svlSample*>::iterator it = BufferedItems.begin();
+         it != BufferedItems.end();
          ++ it) {
-        delete *it;
+        Pool->Release(*it);
     }
 }
 
 bool svlSampleQueue::Push(const svlSample* sample)
 {
-    if (sample->GetType() != Type) return false;
+    if (!sample || sample->GetType() != Type) return false;
+
+    // Copy outside of the critical section; recycled items are already sized
+    svlSample* push_item = Pool->AcquireCopy(sample);
+    if (!push_item) return false;
+
+    return Enqueue(push_item);
+}
+
+bool svlSampleQueue::PushShared(svlSample* sample)
+{
+    if (!sample || sample->GetType() != Type) return false;
 
-    svlSample* push_item;
+    svlSample* push_item = Pool->AddReference(sample);
+    if (!push_item) return false;
+
+    return Enqueue(push_item);
+}
+
+bool svlSampleQueue::Enqueue(svlSample* item)
+{
+    svlSample* dropped_item = 0;
 
     CS.Enter();
-        if (UnusedItems.empty()) {
-            push_item = BufferedItems.back();
+        if (BufferedItems.size() >= Size) {
+            dropped_item = BufferedItems.back();
             BufferedItems.pop_back();
             DroppedSamples ++;
         }
-        else {
-            push_item = UnusedItems.front();
-            UnusedItems.pop_front();
-        }
-    CS.Leave();
-
-    push_item->CopyOf(sample);
-
-    CS.Enter();
-        BufferedItems.push_front(push_item);
+        BufferedItems.push_front(item);
         if (BufferedItems.size() == 1) NewSampleEvent.Raise();
     CS.Leave();
 
+    if (dropped_item) Pool->Release(dropped_item);
+
     return true;
 }
 
@@ -88,18 +99,33 @@ svlSample* svlSampleQueue::Pull(double timeout)
         is_event_reset = true;
     }
 
+    svlSample* pull_item;
+
     CS.Enter();
-        UnusedItems.push_front(PullItem);
-        PullItem = BufferedItems.back();
+        pull_item = BufferedItems.back();
         BufferedItems.pop_back();
 
         // Reset event when buffer is empty
         if (BufferedItems.empty() && !is_event_reset) NewSampleEvent.Wait(0.0);
     CS.Leave();
 
+    // The sample is passed downstream where filters may modify it
+    if (!ReadOnly) {
+        pull_item = Pool->GetWritable(pull_item);
+        if (!pull_item) return 0;
+    }
+
+    Pool->Release(PullItem);
+    PullItem = pull_item;
+
     return PullItem;
 }
 
+void svlSampleQueue::SetReadOnly(bool readonly)
+{
+    ReadOnly = readonly;
+}
+
 svlStreamType svlSampleQueue::GetType()
 {
     return Type;
@@ -112,7 +138,7 @@ unsigned int svlSampleQueue::GetLength()
 
 unsigned int svlSampleQueue::GetUsage()
 {
-    return Size - static_cast<unsigned int>(UnusedItems.size());
+    return static_cast<unsigned int>(BufferedItems.size());
 }
 
 double svlSampleQueue::GetUsageRatio()
@@ -130,6 +156,166 @@ svlSample* svlSampleQueue::Peek()
     return PullItem;
 }
 
+
+/************************************/
+/*** svlSampleQueueBlocking class ***/
+/************************************/
+
+svlSampleQueueBlocking::svlSampleQueueBlocking(svlStreamType type, unsigned int length) :
+    Type(type),
+    Buffer(std::max(length, 1u)),
+    Head(0),
+    Tail(0),
+    Usage(0),
+    MaxUsage(0),
+    PushCount(0),
+    UsageSum(0.0),
+    BlockedTime(0.0),
+    Closed(false),
+    Aborted(false)
+{
+    for (unsigned int i = 0; i < Buffer.size(); i ++) {
+        Buffer[i] = svlSample::GetNewFromType(type);
+    }
+}
+
+svlSampleQueueBlocking::~svlSampleQueueBlocking()
+{
+    for (unsigned int i = 0; i < Buffer.size(); i ++) {
+        delete Buffer[i];
+    }
+}
+
+bool svlSampleQueueBlocking::Push(const svlSample* sample)
+{
+    if (!sample || sample->GetType() != Type) return false;
+
+    CS.Enter();
+        if (Usage == Buffer.size() && !Aborted) {
+            // Back pressure from the consumer
+            const double start = osaGetTime();
+            while (Usage == Buffer.size() && !Aborted) {
+                CS.Leave();
+                NotFullEvent.Wait();
+                CS.Enter();
+            }
+            BlockedTime += osaGetTime() - start;
+        }
+        if (Aborted || Closed) {
+            CS.Leave();
+            return false;
+        }
+    CS.Leave();
+
+    // The tail item is only accessed by the producer until it is queued
+    Buffer[Tail]->CopyOf(sample);
+    Tail = (Tail + 1) % static_cast<unsigned int>(Buffer.size());
+
+    CS.Enter();
+        Usage ++;
+        if (Usage > MaxUsage) MaxUsage = Usage;
+        UsageSum += Usage;
+        PushCount ++;
+        NotEmptyEvent.Raise();
+    CS.Leave();
+
+    return true;
+}
+
+svlSample* svlSampleQueueBlocking::Pull()
+{
+    CS.Enter();
+        while (Usage == 0 && !Aborted && !Closed) {
+            CS.Leave();
+            NotEmptyEvent.Wait();
+            CS.Enter();
+        }
+        svlSample* sample = (Usage > 0 && !Aborted) ? Buffer[Head] : 0;
+    CS.Leave();
+
+    return sample;
+}
+
+void svlSampleQueueBlocking::Pop()
+{
+    CS.Enter();
+        if (Usage > 0) {
+            Head = (Head + 1) % static_cast<unsigned int>(Buffer.size());
+            Usage --;
+            NotFullEvent.Raise();
+        }
+    CS.Leave();
+}
+
+void svlSampleQueueBlocking::Close()
+{
+    CS.Enter();
+        Closed = true;
+        NotEmptyEvent.Raise();
+    CS.Leave();
+}
+
+void svlSampleQueueBlocking::Abort()
+{
+    CS.Enter();
+        Aborted = true;
+        NotEmptyEvent.Raise();
+        NotFullEvent.Raise();
+    CS.Leave();
+}
+
+svlStreamType svlSampleQueueBlocking::GetType() const
+{
+    return Type;
+}
+
+unsigned int svlSampleQueueBlocking::GetLength() const
+{
+    return static_cast<unsigned int>(Buffer.size());
+}
+
+unsigned int svlSampleQueueBlocking::GetUsage() const
+{
+    CS.Enter();
+        const unsigned int usage = Usage;
+    CS.Leave();
+    return usage;
+}
+
+unsigned int svlSampleQueueBlocking::GetMaxUsage() const
+{
+    CS.Enter();
+        const unsigned int maxusage = MaxUsage;
+    CS.Leave();
+    return maxusage;
+}
+
+double svlSampleQueueBlocking::GetAverageUsage() const
+{
+    CS.Enter();
+        const double averageusage = (PushCount > 0) ? UsageSum / PushCount : 0.0;
+    CS.Leave();
+    return averageusage;
+}
+
+double svlSampleQueueBlocking::GetBlockedTime() const
+{
+    CS.Enter();
+        const double blockedtime = BlockedTime;
+    CS.Leave();
+    return blockedtime;
+}
+
+void svlSampleQueueBlocking::GetStatistics(unsigned int & usage, unsigned int & maxusage, double & averageusage, double & blockedtime) const
+{
+    CS.Enter();
+        usage = Usage;
+        maxusage = MaxUsage;
+        averageusage = (PushCount > 0) ? UsageSum / PushCount : 0.0;
+        blockedtime = BlockedTime;
+    CS.Leave();
+}
+
 /*
 svlSampleQueu2::svlSampleQueu2(svlStreamType type, int length) :
     Type(type),
@@ -0,0 +1,644 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlStereoBlockMatching.h"
+#include "svlConvertersSIMD.h"
+#include <cisstStereoVision/svlSyncPoint.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+/**************************/
+/*** Helper functions *****/
+/**************************/
+
+// Maximum Hamming distance of two 3x3 census descriptors
+#define SVL_SBM_MAX_COST    8
+
+static inline int CensusDistance(unsigned int a, unsigned int b)
+{
+    unsigned int v = (a ^ b) & 0xFF;
+    v = v - ((v >> 1) & 0x55);
+    v = (v & 0x33) + ((v >> 2) & 0x33);
+    return static_cast<int>((v + (v >> 4)) & 0x0F);
+}
+
+// Cost of matching right pixel 'x' with left pixel 'x + disparity';
+// columns outside of the image are replicated from the border and
+// pixels without a match get the highest cost
+static inline int MatchingCost(const unsigned char* right, const unsigned char* left, int width, int disparity, int x)
+{
+    if (x < 0) x = 0;
+    else if (x >= width) x = width - 1;
+    const int xl = x + disparity;
+    if (xl < 0 || xl >= width) return SVL_SBM_MAX_COST;
+    return CensusDistance(right[x], left[xl]);
+}
+
+// colsums[i] += cost(add row, x_from + i) - cost(sub row, x_from + i) for i in [0, count)
+// If the 'sub' rows are 0, only the 'add' row is accumulated.
+static void AccumulateCosts(unsigned short* colsums,
+                            const unsigned char* right_add, const unsigned char* left_add,
+                            const unsigned char* right_sub, const unsigned char* left_sub,
+                            const int width, const int disparity, const int x_from, const int count)
+{
+    // Range where both pixels are inside the image
+    const int simd_from = std::min(count, std::max(0, std::max(-x_from, -x_from - disparity)));
+    const int simd_to   = std::max(simd_from, std::min(count, std::min(width - x_from, width - x_from - disparity)));
+    int i = 0;
+
+    for (; i < simd_from; i ++) {
+        colsums[i] += MatchingCost(right_add, left_add, width, disparity, x_from + i);
+        if (right_sub) colsums[i] -= MatchingCost(right_sub, left_sub, width, disparity, x_from + i);
+    }
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask1 = _mm_set1_epi8(0x55);
+    const __m128i mask2 = _mm_set1_epi8(0x33);
+    const __m128i mask4 = _mm_set1_epi8(0x0F);
+    __m128i v, sum_lo, sum_hi;
+
+    // Byte-wise population count of the XOR of the descriptors; the
+    // 16 bit shifts move bits across bytes but the masks remove them
+    #define SVL_SBM_DISTANCE(_r, _l) \
+        v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_r)), \
+                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(_l))); \
+        v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi16(v, 1), mask1)); \
+        v = _mm_add_epi8(_mm_and_si128(v, mask2), _mm_and_si128(_mm_srli_epi16(v, 2), mask2)); \
+        v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi16(v, 4)), mask4);
+
+    for (; i + 16 <= simd_to; i += 16) {
+        const int x = x_from + i;
+        sum_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colsums + i));
+        sum_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colsums + i + 8));
+
+        SVL_SBM_DISTANCE(right_add + x, left_add + x + disparity)
+        sum_lo = _mm_add_epi16(sum_lo, _mm_unpacklo_epi8(v, zero));
+        sum_hi = _mm_add_epi16(sum_hi, _mm_unpackhi_epi8(v, zero));
+
+        if (right_sub) {
+            SVL_SBM_DISTANCE(right_sub + x, left_sub + x + disparity)
+            sum_lo = _mm_sub_epi16(sum_lo, _mm_unpacklo_epi8(v, zero));
+            sum_hi = _mm_sub_epi16(sum_hi, _mm_unpackhi_epi8(v, zero));
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colsums + i), sum_lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colsums + i + 8), sum_hi);
+    }
+
+    #undef SVL_SBM_DISTANCE
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    for (; i < count; i ++) {
+        colsums[i] += MatchingCost(right_add, left_add, width, disparity, x_from + i);
+        if (right_sub) colsums[i] -= MatchingCost(right_sub, left_sub, width, disparity, x_from + i);
+    }
+}
+
+// costs[i] = sum of colsums[i .. i + blocksize - 1] for i in [0, count);
+// both buffers have to be readable/writable up to the next multiple of 8
+static void AggregateRow(const unsigned short* colsums, unsigned short* costs, const int count, const int blocksize)
+{
+    int i = 0, k;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    __m128i sum;
+    for (; i < count; i += 8) {
+        sum = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colsums + i));
+        for (k = 1; k < blocksize; k ++) {
+            sum = _mm_add_epi16(sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(colsums + i + k)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(costs + i), sum);
+    }
+#else // SVL_CONVERTER_HAS_SSE2
+    int sum = 0;
+    for (k = 0; k < blocksize; k ++) sum += colsums[k];
+    for (; i < count; i ++) {
+        costs[i] = static_cast<unsigned short>(sum);
+        sum += colsums[i + blocksize] - colsums[i];
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+}
+
+// Winner-takes-all: keeps the lowest cost and its disparity for each pixel;
+// the lower disparity wins on ties
+static void SelectDisparity(const unsigned short* costs, unsigned short* bestcosts, short* bestdisps, const int count, const short disparity)
+{
+    int i = 0;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i disp = _mm_set1_epi16(disparity);
+    __m128i c, b, m;
+    for (; i + 8 <= count; i += 8) {
+        // Costs are below 32768, signed comparison is fine
+        c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(costs + i));
+        b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bestcosts + i));
+        m = _mm_cmplt_epi16(c, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bestcosts + i), _mm_min_epi16(c, b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bestdisps + i),
+                         _mm_or_si128(_mm_and_si128(m, disp),
+                                      _mm_andnot_si128(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bestdisps + i)))));
+    }
+#endif // SVL_CONVERTER_HAS_SSE2
+
+    for (; i < count; i ++) {
+        if (costs[i] < bestcosts[i]) {
+            bestcosts[i] = costs[i];
+            bestdisps[i] = disparity;
+        }
+    }
+}
+
+// 3x3 census transform: one bit for each neighbor darker than the center;
+// pixels outside of the image are replicated from the border
+static inline unsigned char CensusDescriptor(const unsigned short* up, const unsigned short* mid, const unsigned short* down, int width, int x)
+{
+    const int xm = (x > 0) ? x - 1 : x;
+    const int xp = (x < width - 1) ? x + 1 : x;
+    const unsigned short center = mid[x];
+    return static_cast<unsigned char>((up[xm]   < center ? 0x01 : 0) |
+                                      (up[x]    < center ? 0x02 : 0) |
+                                      (up[xp]   < center ? 0x04 : 0) |
+                                      (mid[xm]  < center ? 0x08 : 0) |
+                                      (mid[xp]  < center ? 0x10 : 0) |
+                                      (down[xm] < center ? 0x20 : 0) |
+                                      (down[x]  < center ? 0x40 : 0) |
+                                      (down[xp] < center ? 0x80 : 0));
+}
+
+// Floor of value / 2^shift for negative values too
+static inline int ShiftDown(int value, int shift)
+{
+    return (value >= 0) ? (value >> shift) : -((-value + (1 << shift) - 1) >> shift);
+}
+
+
+/******************************************/
+/*** svlStereoBlockMatching class *********/
+/******************************************/
+
+svlStereoBlockMatching::svlStereoBlockMatching(int width, int height,
+                                               const svlRect & roi,
+                                               int mindisparity, int maxdisparity,
+                                               int ppoffset,
+                                               int scale,
+                                               int blocksize,
+                                               int searchrad,
+                                               bool subpixel,
+                                               bool crosscheck) :
+    svlComputationalStereoMethodBase(),
+    Width(width),
+    Height(height),
+    ROI(roi),
+    MinDisparity(mindisparity),
+    DisparityRange(maxdisparity - mindisparity),
+    PrincipalPointOffset(ppoffset),
+    Levels(1),
+    BlockRadius(0),
+    SearchRadius(std::max(searchrad, 2)),
+    Subpixel(subpixel),
+    CrossCheck(crosscheck)
+{
+    // The block has an odd size
+    blocksize = std::min(std::max(blocksize, 1), static_cast<int>(MaxBlockSize));
+    BlockRadius = blocksize / 2;
+
+    // Levels below a usable size are dropped
+    scale = std::min(std::max(scale, 0), MaxLevels - 1);
+    while (scale > 0 && ((width >> scale) < TileWidth || (height >> scale) < 16 || (DisparityRange >> scale) < 4)) scale --;
+    Levels = scale + 1;
+}
+
+svlStereoBlockMatching::~svlStereoBlockMatching()
+{
+    Free();
+}
+
+int svlStereoBlockMatching::Initialize()
+{
+    Free();
+
+    if (Width < 3 || Height < 3 || DisparityRange < 0 || DisparityRange > 32767) return -1;
+
+    ROI.Normalize();
+    ROI.Trim(0, Width - 1, 0, Height - 1);
+
+    for (int l = 0; l < Levels; l ++) {
+        const unsigned int size = GetWidth(l) * GetHeight(l);
+        Gray[SVL_LEFT][l].resize(size);
+        Gray[SVL_RIGHT][l].resize(size);
+        Census[SVL_LEFT][l].resize(size);
+        Census[SVL_RIGHT][l].resize(size);
+        if (l > 0) CoarseDisparities[l].assign(size, -1);
+    }
+
+    return 0;
+}
+
+int svlStereoBlockMatching::Process(svlSampleImage *images, int *disparitymap)
+{
+    svlProcInfo procinfo;
+    procinfo.count = 1;
+    procinfo.ID = 0;
+    procinfo.sync = 0;
+    procinfo.cs = 0;
+
+    return Process(&procinfo, images, disparitymap);
+}
+
+int svlStereoBlockMatching::Process(svlProcInfo* procInfo, svlSampleImage *images, int *disparitymap)
+{
+    // Checks have to give the same result on all threads
+    if (!procInfo || !images || !disparitymap ||
+        images->GetVideoChannels() != 2 ||
+        static_cast<int>(images->GetWidth(SVL_LEFT))   != Width || static_cast<int>(images->GetHeight(SVL_LEFT))  != Height ||
+        static_cast<int>(images->GetWidth(SVL_RIGHT))  != Width || static_cast<int>(images->GetHeight(SVL_RIGHT)) != Height ||
+        Gray[SVL_LEFT][0].empty()) return -1;
+
+    const unsigned int bpp = images->GetBPP();
+    if (bpp != 1 && bpp != 2 && bpp != 3) return -2;
+
+    unsigned int from, to, strips, block;
+    int level, ch;
+
+    _OnSingleThread(procInfo) {
+        // Used only after the first synchronization point
+        if (Workspaces.size() < procInfo->count) Workspaces.resize(procInfo->count);
+    }
+
+    // Grayscale pyramid: the bands of rows are aligned to the smallest
+    // level so that each thread only reads rows it has created itself
+    block = 1 << (Levels - 1);
+    _GetParallelSubRange(procInfo, (Height + block - 1) / block, from, to);
+    if (from < to) {
+        for (ch = SVL_LEFT; ch <= SVL_RIGHT; ch ++) {
+            CreateGray(images, ch, from * block, std::min(to * block, static_cast<unsigned int>(Height)));
+            for (level = 1; level < Levels; level ++) {
+                CreatePyramidLevel(level, ch,
+                                   (from * block) >> level,
+                                   std::min((to * block) >> level, static_cast<unsigned int>(GetHeight(level))));
+            }
+        }
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    // Census transform
+    for (level = 0; level < Levels; level ++) {
+        _GetParallelSubRange(procInfo, static_cast<unsigned int>(GetHeight(level)), from, to);
+        if (from < to) {
+            CreateCensus(level, SVL_LEFT,  from, to);
+            CreateCensus(level, SVL_RIGHT, from, to);
+        }
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    // Coarse-to-fine matching
+    Workspace& workspace = Workspaces[procInfo->ID];
+    for (level = Levels - 1; level >= 0; level --) {
+        const int height = GetHeight(level);
+
+        strips = (height + StripHeight - 1) / StripHeight;
+        _GetParallelSubRange(procInfo, strips, from, to);
+        for (; from < to; from ++) {
+            MatchStrip(level, from * StripHeight, std::min(static_cast<int>(from + 1) * StripHeight, height), workspace, disparitymap);
+        }
+
+        // The next level reads the results of the neighboring strips
+        if (level > 0) {
+            _SynchronizeThreads(procInfo);
+        }
+    }
+
+    return 0;
+}
+
+void svlStereoBlockMatching::Free()
+{
+    for (int l = 0; l < MaxLevels; l ++) {
+        Gray[SVL_LEFT][l].clear();
+        Gray[SVL_RIGHT][l].clear();
+        Census[SVL_LEFT][l].clear();
+        Census[SVL_RIGHT][l].clear();
+        CoarseDisparities[l].clear();
+    }
+    Workspaces.clear();
+}
+
+int svlStereoBlockMatching::GetOffset(int level) const
+{
+    return ShiftDown(MinDisparity + PrincipalPointOffset, level);
+}
+
+int svlStereoBlockMatching::GetRange(int level) const
+{
+    // Number of disparities searched, including both ends of the range
+    return (DisparityRange >> level) + 1;
+}
+
+void svlStereoBlockMatching::CreateGray(svlSampleImage *images, unsigned int videoch, int row_from, int row_to)
+{
+    const unsigned int bpp = images->GetBPP();
+    const unsigned char* input = images->GetUCharPointer(videoch) + row_from * Width * bpp;
+    unsigned short* output = &(Gray[videoch][0][row_from * Width]);
+    const unsigned int count = (row_to - row_from) * Width;
+    unsigned int i;
+
+    if (bpp == 1) {
+        for (i = 0; i < count; i ++) output[i] = input[i];
+    }
+    else if (bpp == 2) {
+        memcpy(output, input, count * sizeof(unsigned short));
+    }
+    else {
+        // Only the order of intensities matters for the census transform
+        for (i = 0; i < count; i ++, input += 3) {
+            output[i] = static_cast<unsigned short>(input[0] + 2 * input[1] + input[2]);
+        }
+    }
+}
+
+void svlStereoBlockMatching::CreatePyramidLevel(int level, unsigned int videoch, int row_from, int row_to)
+{
+    const int width = GetWidth(level);
+    const int srcwidth = GetWidth(level - 1);
+    const unsigned short *src1, *src2;
+    unsigned short* output;
+    int x, y;
+
+    for (y = row_from; y < row_to; y ++) {
+        src1 = &(Gray[videoch][level - 1][2 * y * srcwidth]);
+        src2 = src1 + srcwidth;
+        output = &(Gray[videoch][level][y * width]);
+        for (x = 0; x < width; x ++, src1 += 2, src2 += 2) {
+            output[x] = static_cast<unsigned short>((src1[0] + src1[1] + src2[0] + src2[1] + 2) >> 2);
+        }
+    }
+}
+
+void svlStereoBlockMatching::CreateCensus(int level, unsigned int videoch, int row_from, int row_to)
+{
+    const int width = GetWidth(level);
+    const int height = GetHeight(level);
+    const unsigned short *up, *mid, *down;
+    unsigned char* output;
+    int x, y;
+
+    for (y = row_from; y < row_to; y ++) {
+        mid  = &(Gray[videoch][level][y * width]);
+        up   = (y > 0)          ? mid - width : mid;
+        down = (y < height - 1) ? mid + width : mid;
+        output = &(Census[videoch][level][y * width]);
+
+        output[0] = CensusDescriptor(up, mid, down, width, 0);
+        x = 1;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+        // Unsigned 16 bit comparison through the sign bit
+        const __m128i sign = _mm_set1_epi16(static_cast<short>(0x8000));
+        __m128i c, acc;
+
+        #define SVL_SBM_CENSUS_BIT(_row, _dx, _bit) \
+            acc = _mm_or_si128(acc, _mm_and_si128(_mm_cmplt_epi16(_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_row + x + _dx)), sign), c), \
+                                                  _mm_set1_epi16(_bit)));
+
+        // The last column is left to the scalar code
+        for (; x + 8 <= width - 1; x += 8) {
+            c = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mid + x)), sign);
+            acc = _mm_setzero_si128();
+            SVL_SBM_CENSUS_BIT(up,   -1, 0x01)
+            SVL_SBM_CENSUS_BIT(up,    0, 0x02)
+            SVL_SBM_CENSUS_BIT(up,    1, 0x04)
+            SVL_SBM_CENSUS_BIT(mid,  -1, 0x08)
+            SVL_SBM_CENSUS_BIT(mid,   1, 0x10)
+            SVL_SBM_CENSUS_BIT(down, -1, 0x20)
+            SVL_SBM_CENSUS_BIT(down,  0, 0x40)
+            SVL_SBM_CENSUS_BIT(down,  1, 0x80)
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output + x), _mm_packus_epi16(acc, acc));
+        }
+
+        #undef SVL_SBM_CENSUS_BIT
+#endif // SVL_CONVERTER_HAS_SSE2
+
+        for (; x < width; x ++) {
+            output[x] = CensusDescriptor(up, mid, down, width, x);
+        }
+    }
+}
+
+void svlStereoBlockMatching::GetSearchRange(int level, int x_from, int x_to, int y_from, int y_to, int &dmin, int &dmax) const
+{
+    const int range = GetRange(level);
+    dmin = 0;
+    dmax = range;
+
+    // The smallest level searches the full range
+    if (level >= Levels - 1) return;
+
+    const std::vector<short>& coarse = CoarseDisparities[level + 1];
+    const int width = GetWidth(level + 1);
+    const int height = GetHeight(level + 1);
+    const int left   = std::max(x_from / 2 - 1, 0);
+    const int right  = std::min((x_to - 1) / 2 + 1, width - 1);
+    const int top    = std::max(y_from / 2 - 1, 0);
+    const int bottom = std::min((y_to - 1) / 2 + 1, height - 1);
+    int x, y, d, low = 0x7FFF, high = -1;
+
+    for (y = top; y <= bottom; y ++) {
+        for (x = left; x <= right; x ++) {
+            d = coarse[y * width + x];
+            if (d < 0) continue;
+            if (d < low) low = d;
+            if (d > high) high = d;
+        }
+    }
+    if (high < 0) return;
+
+    // Disparities of the coarse level scaled to this level
+    const int shift = 2 * GetOffset(level + 1) - GetOffset(level);
+    dmin = std::max(2 * low  + shift - SearchRadius, 0);
+    dmax = std::min(2 * high + shift + SearchRadius + 1, range);
+    if (dmin >= dmax) {
+        dmin = 0;
+        dmax = range;
+    }
+}
+
+void svlStereoBlockMatching::MatchStrip(int level, int y_from, int y_to, Workspace &workspace, int *disparitymap)
+{
+    const int width = GetWidth(level);
+    const int height = GetHeight(level);
+    const int offset = GetOffset(level);
+    const int range = GetRange(level);
+    const int blocksize = 2 * BlockRadius + 1;
+    const bool subpixel = Subpixel && level == 0;
+    const bool crosscheck = CrossCheck && level == 0;
+    int x, y, i, d, dmin, dmax, x0, count, row, value, disp, xl;
+
+    if (level == 0) {
+        // Rows outside of the region of interest are not processed
+        for (y = y_from; y < y_to && y < ROI.top; y ++) memset(disparitymap + y * Width, 0, Width * sizeof(int));
+        for (y = std::max(y_from, ROI.bottom + 1); y < y_to; y ++) memset(disparitymap + y * Width, 0, Width * sizeof(int));
+        y_from = std::max(y_from, ROI.top);
+        y_to = std::min(y_to, ROI.bottom + 1);
+        if (y_from >= y_to) return;
+    }
+
+    const int rows = y_to - y_from;
+    // Sums are read up to the next multiple of 8 beyond the block border
+    const int colstride = (TileWidth + 2 * BlockRadius + 16) & ~7;
+    const int coststride = TileWidth + 8;
+
+    if (workspace.ColumnSums.size() < static_cast<size_t>(range * colstride)) workspace.ColumnSums.resize(range * colstride);
+    if (workspace.Costs.size() < static_cast<size_t>(range * coststride)) workspace.Costs.resize(range * coststride);
+    if (workspace.Disparities.size() < static_cast<size_t>(StripHeight * width)) workspace.Disparities.resize(StripHeight * width);
+    if (crosscheck) {
+        if (workspace.LeftCosts.size() < static_cast<size_t>(StripHeight * width)) workspace.LeftCosts.resize(StripHeight * width);
+        if (workspace.LeftDisparities.size() < static_cast<size_t>(StripHeight * width)) workspace.LeftDisparities.resize(StripHeight * width);
+        std::fill(workspace.LeftCosts.begin(), workspace.LeftCosts.begin() + rows * width, 0x7FFF);
+        std::fill(workspace.LeftDisparities.begin(), workspace.LeftDisparities.begin() + rows * width, -1);
+    }
+
+    const unsigned char* census_left  = &(Census[SVL_LEFT][level][0]);
+    const unsigned char* census_right = &(Census[SVL_RIGHT][level][0]);
+    unsigned short bestcosts[TileWidth + 8];
+    short bestdisps[TileWidth + 8];
+    unsigned short *colsums, *costs;
+    int yadd, ysub;
+
+    for (x0 = 0; x0 < width; x0 += TileWidth) {
+
+        count = std::min(static_cast<int>(TileWidth), width - x0);
+        GetSearchRange(level, x0, x0 + count, y_from, y_to, dmin, dmax);
+
+        // Column sums of the first row of the strip
+        for (d = dmin; d < dmax; d ++) {
+            colsums = &(workspace.ColumnSums[(d - dmin) * colstride]);
+            memset(colsums, 0, colstride * sizeof(unsigned short));
+            for (i = -BlockRadius; i <= BlockRadius; i ++) {
+                y = std::min(std::max(y_from + i, 0), height - 1);
+                AccumulateCosts(colsums, census_right + y * width, census_left + y * width, 0, 0,
+                                width, d + offset, x0 - BlockRadius, count + 2 * BlockRadius);
+            }
+        }
+
+        for (y = y_from; y < y_to; y ++) {
+
+            row = y - y_from;
+
+            // Sliding the block down by one row
+            if (y > y_from) {
+                yadd = std::min(y + BlockRadius, height - 1);
+                ysub = std::max(y - BlockRadius - 1, 0);
+                for (d = dmin; d < dmax; d ++) {
+                    AccumulateCosts(&(workspace.ColumnSums[(d - dmin) * colstride]),
+                                    census_right + yadd * width, census_left + yadd * width,
+                                    census_right + ysub * width, census_left + ysub * width,
+                                    width, d + offset, x0 - BlockRadius, count + 2 * BlockRadius);
+                }
+            }
+
+            std::fill(bestcosts, bestcosts + TileWidth + 8, 0x7FFF);
+            std::fill(bestdisps, bestdisps + TileWidth + 8, static_cast<short>(dmin));
+
+            for (d = dmin; d < dmax; d ++) {
+                costs = &(workspace.Costs[(d - dmin) * coststride]);
+                AggregateRow(&(workspace.ColumnSums[(d - dmin) * colstride]), costs, count, blocksize);
+                SelectDisparity(costs, bestcosts, bestdisps, count, static_cast<short>(d));
+
+                if (crosscheck) {
+                    // Best match of the left pixels among the candidates of this tile:
+                    // with a fixed disparity the left pixels are contiguous too
+                    xl = x0 + d + offset;
+                    i = std::max(-xl, 0);
+                    const int last = std::min(count, width - xl);
+                    if (i < last) {
+                        SelectDisparity(costs + i,
+                                        &(workspace.LeftCosts[row * width + xl + i]),
+                                        &(workspace.LeftDisparities[row * width + xl + i]),
+                                        last - i, static_cast<short>(d));
+                    }
+                }
+            }
+
+            short* output = &(workspace.Disparities[row * width + x0]);
+            if (subpixel) {
+                // Parabola fitted to the costs around the minimum, in quarter pixels
+                for (i = 0; i < count; i ++) {
+                    d = bestdisps[i];
+                    value = d * 4;
+                    if (d > dmin && d < dmax - 1) {
+                        const int c0 = workspace.Costs[(d - 1 - dmin) * coststride + i];
+                        const int c1 = workspace.Costs[(d     - dmin) * coststride + i];
+                        const int c2 = workspace.Costs[(d + 1 - dmin) * coststride + i];
+                        const int denom = c0 - 2 * c1 + c2;
+                        if (denom > 0) {
+                            value += std::min(std::max(static_cast<int>(floor(2.0 * (c0 - c2) / denom + 0.5)), -2), 2);
+                        }
+                    }
+                    output[i] = static_cast<short>(value);
+                }
+            }
+            else {
+                memcpy(output, bestdisps, count * sizeof(short));
+            }
+        }
+    }
+
+    // Storing results
+    for (y = y_from; y < y_to; y ++) {
+
+        row = y - y_from;
+        const short* input = &(workspace.Disparities[row * width]);
+
+        if (level > 0) {
+            memcpy(&(CoarseDisparities[level][y * width]), input, width * sizeof(short));
+            continue;
+        }
+
+        int* output = disparitymap + y * Width;
+        const short* leftdisps = crosscheck ? &(workspace.LeftDisparities[row * width]) : 0;
+
+        for (x = 0; x < Width; x ++) {
+            if (x < ROI.left || x > ROI.right) {
+                output[x] = 0;
+                continue;
+            }
+
+            value = input[x];
+            if (crosscheck) {
+                // Left-right consistency
+                disp = subpixel ? (value + 2) >> 2 : value;
+                xl = x + disp + offset;
+                if (xl < 0 || xl >= Width || leftdisps[xl] < 0 || abs(leftdisps[xl] - disp) > 1) {
+                    output[x] = 0x7FFFFFFF;
+                    continue;
+                }
+            }
+
+            output[x] = subpixel ? value + (offset << 2) : value + offset;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlStereoBlockMatching_h
+#define _svlStereoBlockMatching_h
+
+#include <cisstStereoVision/svlFilterComputationalStereo.h>
+#include <vector>
+
+
+// Census block matching.
+// Pixels are described by the 3x3 census transform of the grayscale image
+// and the matching cost is the sum of Hamming distances over a square
+// block.  Disparities are searched coarse-to-fine: the full range is only
+// searched on the smallest level of an image pyramid ('scale' levels) and
+// each finer level searches around the disparities found on the level
+// above, separately for every tile of the image.  Rows are split among
+// the threads of the stream.
+// The disparity map is in the same format as the one of svlStereoDP:
+// right image coordinates, offset by the minimum disparity and the
+// principal point offset, in quarter pixels if 'subpixel' is true.
+// If 'crosscheck' is true, pixels failing the left-right consistency
+// check are set to 0x7FFFFFFF.
+class svlStereoBlockMatching : public svlComputationalStereoMethodBase
+{
+public:
+    svlStereoBlockMatching(int width, int height,
+                           const svlRect & roi,
+                           int mindisparity, int maxdisparity,
+                           int ppoffset,
+                           int scale,
+                           int blocksize,
+                           int searchrad,
+                           bool subpixel,
+                           bool crosscheck);
+    virtual ~svlStereoBlockMatching();
+
+    virtual int Initialize();
+    virtual int Process(svlSampleImage *images, int *disparitymap);
+    virtual int Process(svlProcInfo* procInfo, svlSampleImage *images, int *disparitymap);
+    virtual void Free();
+
+private:
+    enum { TileWidth = 64, StripHeight = 32, MaxLevels = 4, MaxBlockSize = 21 };
+
+    struct Workspace
+    {
+        std::vector<unsigned short> ColumnSums;     // per disparity, tile + block border
+        std::vector<unsigned short> Costs;          // per disparity, aggregated costs of the current row
+        std::vector<short>          Disparities;    // per row of the strip
+        std::vector<unsigned short> LeftCosts;      // per row of the strip, for the left-right check
+        std::vector<short>          LeftDisparities;
+    };
+
+    int Width;
+    int Height;
+    svlRect ROI;
+    int MinDisparity;
+    int DisparityRange;
+    int PrincipalPointOffset;
+    int Levels;
+    int BlockRadius;
+    int SearchRadius;
+    bool Subpixel;
+    bool CrossCheck;
+
+    std::vector<unsigned short> Gray[2][MaxLevels];
+    std::vector<unsigned char>  Census[2][MaxLevels];
+    std::vector<short>          CoarseDisparities[MaxLevels];
+    std::vector<Workspace>      Workspaces;
+
+    int GetWidth(int level) const  { return Width >> level; }
+    int GetHeight(int level) const { return Height >> level; }
+    int GetOffset(int level) const;
+    int GetRange(int level) const;
+
+    void CreateGray(svlSampleImage *images, unsigned int videoch, int row_from, int row_to);
+    void CreatePyramidLevel(int level, unsigned int videoch, int row_from, int row_to);
+    void CreateCensus(int level, unsigned int videoch, int row_from, int row_to);
+    void GetSearchRange(int level, int x_from, int x_to, int y_from, int y_to, int &dmin, int &dmax) const;
+    void MatchStrip(int level, int y_from, int y_to, Workspace &workspace, int *disparitymap);
+};
+
+#endif // _svlStereoBlockMatching_h
@@ -65,6 +65,21 @@ int svlStreamBranchSource::Initialize(svlSample* &syncOutput)
 {
     Release();
 
+    // Samples shared with other branches are copied only if a filter
+    // on this branch may write to them
+    bool readonly = true;
+    svlFilterOutput* output = GetOutput();
+    svlFilterBase* filter = output ? output->GetConnectedFilter() : 0;
+    while (filter) {
+        if (filter->IsInputModified()) {
+            readonly = false;
+            break;
+        }
+        output = filter->GetOutput();
+        filter = output ? output->GetConnectedFilter() : 0;
+    }
+    SampleQueue.SetReadOnly(readonly);
+
     // Pass unused but initialized sample downstream
     syncOutput = SampleQueue.Pull(0.0);
     if (!syncOutput) return SVL_FAIL;
@@ -129,6 +144,7 @@ bool svlStreamBranchSource::IsTypeSupported(svlStreamType type)
         case svlTypeText:
         case svlTypeCameraGeometry:
         case svlTypeBlobs:
+        case svlTypeImagePyramid:
             return true;
 
         case svlTypeInvalid:
@@ -150,6 +166,12 @@ void svlStreamBranchSource::PushSample(const svlSample* inputsample)
     SampleQueue.Push(inputsample);
 }
 
+void svlStreamBranchSource::PushSharedSample(svlSample* inputsample)
+{
+    if (InputBlocked) return;
+    SampleQueue.PushShared(inputsample);
+}
+
 int svlStreamBranchSource::GetBufferUsage()
 {
     return SampleQueue.GetUsage();
@@ -0,0 +1,212 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlStreamInstrumentation.h"
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <fstream>
+#include <algorithm>
+
+#define LATENCY_BIN_WIDTH   0.001
+
+
+static std::string EscapeJSON(const std::string & text)
+{
+    std::string escaped;
+    for (unsigned int i = 0; i < text.size(); i ++) {
+        if (text[i] == '"' || text[i] == '\\') escaped += '\\';
+        if (static_cast<unsigned char>(text[i]) >= 0x20) escaped += text[i];
+    }
+    return escaped;
+}
+
+/***********************************/
+/*** svlStreamInstrumentation ******/
+/***********************************/
+
+svlStreamInstrumentation::svlStreamInstrumentation() :
+    TraceLength(0)
+{
+    Reset(1);
+}
+
+void svlStreamInstrumentation::Reset(unsigned int threadcount)
+{
+    CS.Enter();
+
+    LatencyHistogram.assign(LatencyBinCount, 0);
+    LatencyCount = 0;
+    LatencySum   = 0.0;
+    LatencyMin   = 0.0;
+    LatencyMax   = 0.0;
+
+    TraceStart   = osaGetTime();
+    TraceDropped = 0;
+    Names.clear();
+    Trace.resize(threadcount);
+    for (unsigned int i = 0; i < threadcount; i ++) {
+        Trace[i].clear();
+        // Recording never allocates while the stream runs
+        Trace[i].reserve(TraceLength);
+    }
+
+    CS.Leave();
+}
+
+void svlStreamInstrumentation::SetTraceLength(unsigned int maxevents)
+{
+    CS.Enter();
+
+    TraceLength = maxevents;
+    for (unsigned int i = 0; i < Trace.size(); i ++) {
+        if (Trace[i].size() > TraceLength) Trace[i].resize(TraceLength);
+        Trace[i].reserve(TraceLength);
+    }
+
+    CS.Leave();
+}
+
+unsigned int svlStreamInstrumentation::GetTraceLength() const
+{
+    return TraceLength;
+}
+
+void svlStreamInstrumentation::AddLatency(const double latency)
+{
+    if (latency < 0.0) return;
+
+    unsigned int bin = static_cast<unsigned int>(latency / LATENCY_BIN_WIDTH);
+    if (bin >= LatencyBinCount) bin = LatencyBinCount - 1;
+
+    CS.Enter();
+
+    LatencyHistogram[bin] ++;
+    if (LatencyCount == 0 || latency < LatencyMin) LatencyMin = latency;
+    if (LatencyCount == 0 || latency > LatencyMax) LatencyMax = latency;
+    LatencySum += latency;
+    LatencyCount ++;
+
+    CS.Leave();
+}
+
+void svlStreamInstrumentation::AddTraceEvent(unsigned int threadid, const std::string & name, unsigned int frame,
+                                             const double start, const double end, const double barrierwait)
+{
+    if (TraceLength == 0) return;
+
+    CS.Enter();
+
+    if (threadid < Trace.size()) {
+        std::vector<TraceEvent> & events = Trace[threadid];
+        if (events.size() < TraceLength) {
+            TraceEvent event;
+            event.Name = 0;
+            while (event.Name < Names.size() && Names[event.Name] != name) event.Name ++;
+            if (event.Name == Names.size()) Names.push_back(name);
+            event.Frame       = frame;
+            event.Start       = start - TraceStart;
+            event.Duration    = end - start;
+            event.BarrierWait = barrierwait;
+            events.push_back(event);
+        }
+        else TraceDropped ++;
+    }
+
+    CS.Leave();
+}
+
+void svlStreamInstrumentation::GetLatencyHistogram(vctDynamicVector<unsigned int> & histogram, double & binwidth) const
+{
+    CS.Enter();
+
+    histogram.SetSize(LatencyHistogram.size());
+    for (unsigned int i = 0; i < LatencyHistogram.size(); i ++) histogram[i] = LatencyHistogram[i];
+    binwidth = LATENCY_BIN_WIDTH;
+
+    CS.Leave();
+}
+
+unsigned int svlStreamInstrumentation::GetLatency(double & mean, double & min, double & max,
+                                                  double & p50, double & p95, double & p99) const
+{
+    CS.Enter();
+
+    const unsigned int count = LatencyCount;
+    mean = (count > 0) ? LatencySum / count : 0.0;
+    min  = LatencyMin;
+    max  = LatencyMax;
+    p50  = GetPercentile(0.5);
+    p95  = GetPercentile(0.95);
+    p99  = GetPercentile(0.99);
+
+    CS.Leave();
+
+    return count;
+}
+
+double svlStreamInstrumentation::GetPercentile(const double ratio) const
+{
+    if (LatencyCount == 0) return 0.0;
+
+    const double target = ratio * LatencyCount;
+    unsigned int i, sum = 0;
+
+    // Upper edge of the bin that contains the percentile
+    for (i = 0; i < LatencyBinCount - 1; i ++) {
+        sum += LatencyHistogram[i];
+        if (sum >= target) return std::min((i + 1) * LATENCY_BIN_WIDTH, LatencyMax);
+    }
+    return LatencyMax;
+}
+
+int svlStreamInstrumentation::SaveTrace(const std::string & filename, const std::string & streamname) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) return SVL_FAIL;
+
+    unsigned int i, j;
+
+    CS.Enter();
+
+    file.setf(std::ios::fixed);
+    file.precision(3);
+
+    // Complete ("X") events on one process, one track per stream thread; times in microseconds
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"" << EscapeJSON(streamname) << "\"}}";
+    for (i = 0; i < Trace.size(); i ++) {
+        file << "," << std::endl << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i
+             << ",\"args\":{\"name\":\"stream thread " << i << "\"}}";
+    }
+
+    for (i = 0; i < Trace.size(); i ++) {
+        for (j = 0; j < Trace[i].size(); j ++) {
+            const TraceEvent & event = Trace[i][j];
+            file << "," << std::endl << "{\"name\":\"" << EscapeJSON(Names[event.Name]) << "\",\"cat\":\"filter\",\"ph\":\"X\""
+                 << ",\"pid\":0,\"tid\":" << i
+                 << ",\"ts\":" << event.Start * 1000000.0
+                 << ",\"dur\":" << event.Duration * 1000000.0
+                 << ",\"args\":{\"frame\":" << event.Frame
+                 << ",\"barrier_wait_us\":" << event.BarrierWait * 1000000.0 << "}}";
+        }
+    }
+    file << std::endl << "],\"otherData\":{\"dropped_events\":" << TraceDropped << "}}" << std::endl;
+
+    CS.Leave();
+
+    return SVL_OK;
+}
+
@@ -0,0 +1,83 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlStreamInstrumentation_h
+#define _svlStreamInstrumentation_h
+
+#include <cisstOSAbstraction/osaCriticalSection.h>
+#include <cisstStereoVision/svlTypes.h>
+#include <vector>
+
+
+// Stream level measurements of svlStreamManager: capture-to-sink latency
+// histogram and an optional trace of filter executions.  Stream threads
+// add measurements concurrently; all methods are thread safe.
+// The trace is saved in the Trace Event Format of Chrome's trace viewer
+// (chrome://tracing, Perfetto).
+class svlStreamInstrumentation
+{
+public:
+    enum {LatencyBinCount = 250};   // 1 ms bins, last bin collects the rest
+
+    svlStreamInstrumentation();
+
+    // Clears all measurements, keeps the trace length
+    void Reset(unsigned int threadcount);
+    // Events recorded per thread, 0 disables tracing
+    void SetTraceLength(unsigned int maxevents);
+    unsigned int GetTraceLength() const;
+
+    void AddLatency(const double latency);
+    // 'start' and 'end' are osaGetTime() values
+    void AddTraceEvent(unsigned int threadid, const std::string & name, unsigned int frame,
+                       const double start, const double end, const double barrierwait);
+
+    void GetLatencyHistogram(vctDynamicVector<unsigned int> & histogram, double & binwidth) const;
+    // Mean, minimum, maximum and percentiles [s]; returns the number of measurements
+    unsigned int GetLatency(double & mean, double & min, double & max,
+                            double & p50, double & p95, double & p99) const;
+    int SaveTrace(const std::string & filename, const std::string & streamname) const;
+
+private:
+    struct TraceEvent
+    {
+        unsigned int Name;      // index in Names
+        unsigned int Frame;
+        double Start;
+        double Duration;
+        double BarrierWait;
+    };
+
+    mutable osaCriticalSection CS;
+
+    std::vector<unsigned int> LatencyHistogram;
+    unsigned int LatencyCount;
+    double LatencySum;
+    double LatencyMin;
+    double LatencyMax;
+
+    unsigned int TraceLength;
+    double TraceStart;
+    std::vector<std::string> Names;
+    std::vector< std::vector<TraceEvent> > Trace;
+    unsigned int TraceDropped;
+
+    double GetPercentile(const double ratio) const;
+};
+
+#endif // _svlStreamInstrumentation_h
+
@@ -27,6 +27,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlFilterBase.h>
 #include <cisstStereoVision/svlFilterSourceBase.h>
 #include <cisstStereoVision/svlStreamProc.h>
+#include <cisstStereoVision/svlSampleQueue.h>
+#include "svlStreamInstrumentation.h"
 
 #include <cisstOSAbstraction/osaSleep.h>
 #include <cisstOSAbstraction/osaThread.h>
@@ -34,6 +36,8 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 
+#include <sstream>
+
 /*************************************/
 /*** svlStreamManager class **********/
 /*************************************/
@@ -43,7 +47,13 @@ CMN_IMPLEMENT_SERVICES(svlStreamManager);
 svlStreamManager::svlStreamManager() :
     ThreadCount(1),
     SyncPoint(0),
+    SyncPointType(svlSyncPointEvent),
+    SyncPointSpinCount(4000),
     CS(0),
+    PipelineMode(false),
+    PipelineQueueLength(2),
+    PipelineCS(new osaCriticalSection),
+    Instrumentation(new svlStreamInstrumentation),
     StreamSource(0),
     Initialized(false),
     Running(false),
@@ -55,7 +65,13 @@ svlStreamManager::svlStreamManager() :
 svlStreamManager::svlStreamManager(unsigned int threadcount) :
     ThreadCount(std::max(1u, threadcount)),
     SyncPoint(0),
+    SyncPointType(svlSyncPointEvent),
+    SyncPointSpinCount(4000),
     CS(0),
+    PipelineMode(false),
+    PipelineQueueLength(2),
+    PipelineCS(new osaCriticalSection),
+    Instrumentation(new svlStreamInstrumentation),
     StreamSource(0),
     Initialized(false),
     Running(false),
@@ -68,6 +84,8 @@ svlStreamManager::svlStreamManager(unsigned int threadcount) :
 svlStreamManager::~svlStreamManager()
 {
     Release();
+    delete Instrumentation;
+    delete PipelineCS;
 }
 
 int svlStreamManager::SetSourceFilter(svlFilterSourceBase * source)
@@ -336,7 +354,11 @@ int svlStreamManager::Play(void)
     svlFilterBase * filter = StreamSource;
     while (filter) {
         filter->Running = true;
-        if (filter->OnStart(ThreadCount) != SVL_OK) {
+        filter->BarrierWaitTime.SetSize(PipelineMode ? 1 : ThreadCount);
+        filter->BarrierWaitTime.SetAll(0.0);
+        filter->ProcessTime.SetSize(PipelineMode ? 1 : ThreadCount);
+        filter->ProcessTime.SetAll(0.0);
+        if (filter->OnStart(PipelineMode ? 1 : ThreadCount) != SVL_OK) {
             Stop();
             CMN_LOG_CLASS_RUN_ERROR << "Play: filter \"" << filter->GetName()
                                     << "\" \"OnStart\" method failed while starting stream \""
@@ -373,29 +395,56 @@ int svlStreamManager::Play(void)
         }
     }
 
-    // Allocate new thread control object array
-    StreamProcInstance.SetSize(ThreadCount);
-    StreamProcThread.SetSize(ThreadCount);
-
-    // Create thread synchronization object
-    if (ThreadCount > 1) {
-        SyncPoint = new svlSyncPoint;
-        SyncPoint->Count(ThreadCount);
+    if (PipelineMode) {
+        // One stage per trunk filter and one queue between consecutive stages
+        err = CreatePipeline();
+        if (err != SVL_OK) {
+            Stop();
+            CMN_LOG_CLASS_RUN_ERROR << "Play: failed to create pipeline for stream \""
+                                    << this->GetName() << "\"" << std::endl;
+            return err;
+        }
+        StreamProcInstance.SetSize(PipelineStages.size());
+        StreamProcThread.SetSize(PipelineStages.size());
+        StreamProcInstance.SetAll(0);
+        StreamProcThread.SetAll(0);
         CS = new osaCriticalSection;
     }
+    else {
+        // Allocate new thread control object array
+        StreamProcInstance.SetSize(ThreadCount);
+        StreamProcThread.SetSize(ThreadCount);
+
+        // Create thread synchronization object
+        if (ThreadCount > 1) {
+            SyncPoint = new svlSyncPoint;
+            SyncPoint->Count(ThreadCount);
+            SyncPoint->SetType(SyncPointType, SyncPointSpinCount);
+            CS = new osaCriticalSection;
+        }
+    }
 
     StopThread = false;
     StreamStatus = SVL_STREAM_RUNNING;
 
+    // One trace track per stream thread or pipeline stage
+    Instrumentation->Reset(PipelineMode ? static_cast<unsigned int>(PipelineStages.size()) : ThreadCount);
+
     // Initialize media control events
     if (StreamSource->PlayCounter != 0) StreamSource->PauseAtFrameID = -1;
     else StreamSource->PauseAtFrameID = 0;
 
-    for (i = 0; i < ThreadCount; i ++) {
+    const unsigned int proccount = static_cast<unsigned int>(StreamProcInstance.size());
+    for (i = 0; i < proccount; i ++) {
         // Starting multi thread processing
-        StreamProcInstance[i] = new svlStreamProc(ThreadCount, static_cast<unsigned int>(i));
+        StreamProcInstance[i] = new svlStreamProc(proccount, static_cast<unsigned int>(i));
         StreamProcThread[i] = new osaThread;
-        StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::Proc, this);
+        if (PipelineMode) {
+            StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::PipelineProc, this);
+        }
+        else {
+            StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::Proc, this);
+        }
     }
 
     // Start all filter outputs recursively, if any
@@ -504,8 +553,11 @@ void svlStreamManager::Stop(void)
     EventGeneratorChangeState(mtsComponentStateChange(LCM->GetProcessName(), this->GetName(), 
                                                       mtsComponentState::READY));
 
+    // Unblock pipeline stages waiting on their queues
+    AbortPipeline();
+
     // Stopping multi thread processing and delete thread objects
-    for (size_t i = 0; i < ThreadCount; i ++) {
+    for (size_t i = 0; i < StreamProcThread.size(); i ++) {
         if (StreamProcThread[i]) {
             StreamProcThread[i]->Wait();
             delete StreamProcThread[i];
@@ -528,6 +580,7 @@ void svlStreamManager::Stop(void)
         delete CS;
         CS = 0;
     }
+    DeletePipeline();
 
     // Call OnStop for all filters in the trunk
     filter = StreamSource;
@@ -611,8 +664,11 @@ void svlStreamManager::InternalStop(unsigned int callingthreadID)
     EventGeneratorChangeState(mtsComponentStateChange(LCM->GetProcessName(), this->GetName(), 
                                                       mtsComponentState::READY));
 
+    // Unblock pipeline stages waiting on their queues
+    AbortPipeline();
+
     // Stopping multi thread processing and delete thread objects
-    for (size_t i = 0; i < ThreadCount; i ++) {
+    for (size_t i = 0; i < StreamProcThread.size(); i ++) {
         if (i != callingthreadID) {
             if (StreamProcThread[i]) {
                 StreamProcThread[i]->Wait();
@@ -639,6 +695,7 @@ void svlStreamManager::InternalStop(unsigned int callingthreadID)
         delete CS;
         CS = 0;
     }
+    DeletePipeline();
 
     // Call OnStop for all filters in the trunk
     filter = StreamSource;
@@ -678,6 +735,216 @@ int svlStreamManager::GetStreamStatus(void) const
     return StreamStatus;
 }
 
+int svlStreamManager::SetPipelineMode(bool enable, unsigned int queuelength)
+{
+    if (Running) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetPipelineMode: stream \"" << this->GetName()
+                                 << "\" is running, can't change execution mode" << std::endl;
+        return SVL_ALREADY_RUNNING;
+    }
+    PipelineMode = enable;
+    PipelineQueueLength = std::max(1u, queuelength);
+    return SVL_OK;
+}
+
+bool svlStreamManager::GetPipelineMode(void) const
+{
+    return PipelineMode;
+}
+
+int svlStreamManager::SetSyncPointType(svlSyncPointType type, unsigned int spincount)
+{
+    if (Running) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetSyncPointType: stream \"" << this->GetName()
+                                 << "\" is running, can't change sync point type" << std::endl;
+        return SVL_ALREADY_RUNNING;
+    }
+    SyncPointType = type;
+    SyncPointSpinCount = spincount;
+    return SVL_OK;
+}
+
+svlSyncPointType svlStreamManager::GetSyncPointType(void) const
+{
+    return SyncPointType;
+}
+
+std::string svlStreamManager::GetInstrumentationReport(void) const
+{
+    std::stringstream report;
+    mtsComponent::InterfacesOutputMapType::iterator iteroutputs;
+    mtsComponent::InterfacesInputMapType::iterator iterinputs;
+    svlFilterOutput * output;
+    svlFilterInput * input;
+    unsigned int i;
+
+    report.setf(std::ios::fixed);
+    report.precision(3);
+    report << "Stream \"" << this->GetName() << "\" ("
+           << (PipelineMode ? "pipeline" : "lockstep") << " mode)" << std::endl;
+
+    svlFilterBase * filter = StreamSource;
+    while (filter) {
+        report << "  Filter \"" << filter->GetName() << "\": frames=" << filter->GetFrameCounter()
+               << ", process=" << filter->GetProcessTime() * 1000.0 << " ms"
+               << ", barrier=" << filter->GetBarrierWaitTime() * 1000.0 << " ms" << std::endl;
+        if (filter->ProcessTime.size() > 1) {
+            report << "    per thread process/barrier [s]:";
+            for (i = 0; i < filter->ProcessTime.size(); i ++) {
+                report << " " << filter->GetProcessTime(i) << "/" << filter->GetBarrierWaitTime(i);
+            }
+            report << std::endl;
+        }
+
+        // Asynchronous connections
+        for (iteroutputs = filter->InterfacesOutput.begin();
+             iteroutputs != filter->InterfacesOutput.end();
+             iteroutputs ++) {
+            output = dynamic_cast<svlFilterOutput *>(iteroutputs->second);
+            if (output && !output->IsTrunk() && output->GetDroppedSampleCount() >= 0) {
+                report << "    output \"" << output->GetName() << "\": dropped=" << output->GetDroppedSampleCount()
+                       << ", buffer usage=" << output->GetBufferUsage()
+                       << " (" << output->GetBufferUsageRatio() * 100.0 << "%)" << std::endl;
+            }
+        }
+        for (iterinputs = filter->InterfacesInput.begin();
+             iterinputs != filter->InterfacesInput.end();
+             iterinputs ++) {
+            input = dynamic_cast<svlFilterInput *>(iterinputs->second);
+            if (input && !input->IsTrunk() && input->GetDroppedSampleCount() >= 0) {
+                report << "    input \"" << input->GetName() << "\": dropped=" << input->GetDroppedSampleCount() << std::endl;
+            }
+        }
+
+        // Get next filter in the trunk
+        output = filter->GetOutput();
+        filter = 0;
+        // Check if trunk output exists
+        if (output) {
+            input = output->Connection;
+            // Check if trunk output is connected to a trunk input
+            if (input && input->Trunk) filter = input->Filter;
+        }
+    }
+
+    // The report may be requested from any thread while Stop() deletes the queues
+    unsigned int usage, maxusage;
+    double averageusage, blockedtime;
+    PipelineCS->Enter();
+        for (i = 0; i < PipelineQueues.size(); i ++) {
+            if (!PipelineQueues[i]) continue;
+            PipelineQueues[i]->GetStatistics(usage, maxusage, averageusage, blockedtime);
+            report << "  Queue " << i << " -> " << i + 1 << ": length=" << PipelineQueues[i]->GetLength()
+                   << ", usage=" << usage
+                   << ", max=" << maxusage
+                   << ", average=" << averageusage
+                   << ", blocked=" << blockedtime << " s" << std::endl;
+        }
+    PipelineCS->Leave();
+
+    double mean, min, max, p50, p95, p99;
+    const unsigned int count = Instrumentation->GetLatency(mean, min, max, p50, p95, p99);
+    report << "  Latency: frames=" << count;
+    if (count > 0) {
+        report << ", mean=" << mean * 1000.0 << " ms, min=" << min * 1000.0
+               << " ms, max=" << max * 1000.0 << " ms, p50=" << p50 * 1000.0
+               << " ms, p95=" << p95 * 1000.0 << " ms, p99=" << p99 * 1000.0 << " ms";
+    }
+    report << std::endl;
+
+    return report.str();
+}
+
+void svlStreamManager::GetLatencyHistogram(vctDynamicVector<unsigned int> & histogram, double & binwidth) const
+{
+    Instrumentation->GetLatencyHistogram(histogram, binwidth);
+}
+
+void svlStreamManager::ResetInstrumentation(void)
+{
+    Instrumentation->Reset(Running ? static_cast<unsigned int>(StreamProcInstance.size()) : 1);
+}
+
+void svlStreamManager::SetTraceLength(unsigned int maxevents)
+{
+    Instrumentation->SetTraceLength(maxevents);
+}
+
+unsigned int svlStreamManager::GetTraceLength(void) const
+{
+    return Instrumentation->GetTraceLength();
+}
+
+int svlStreamManager::SaveTrace(const std::string & filename) const
+{
+    if (Instrumentation->SaveTrace(filename, this->GetName()) != SVL_OK) {
+        CMN_LOG_CLASS_RUN_ERROR << "SaveTrace: stream \"" << this->GetName()
+                                << "\" failed to write trace file \"" << filename << "\"" << std::endl;
+        return SVL_FAIL;
+    }
+    return SVL_OK;
+}
+
+int svlStreamManager::CreatePipeline(void)
+{
+    svlFilterOutput * output;
+    svlFilterInput * input;
+    std::vector<svlFilterBase*> stages;
+
+    DeletePipeline();
+
+    // Collect the filters of the trunk
+    svlFilterBase * filter = StreamSource;
+    while (filter) {
+        stages.push_back(filter);
+
+        // Get next filter in the trunk
+        output = filter->GetOutput();
+        filter = 0;
+        // Check if trunk output exists
+        if (output) {
+            input = output->Connection;
+            // Check if trunk output is connected to a trunk input
+            if (input && input->Trunk) filter = input->Filter;
+        }
+    }
+
+    PipelineCS->Enter();
+        PipelineStages.SetSize(stages.size());
+        PipelineQueues.SetSize(stages.size() - 1);
+        PipelineQueues.SetAll(0);
+        for (size_t i = 0; i < stages.size(); i ++) {
+            PipelineStages[i] = stages[i];
+            if (i + 1 < stages.size()) {
+                // Trunk output of stage i feeds stage i+1
+                PipelineQueues[i] = new svlSampleQueueBlocking(stages[i]->GetOutput()->GetType(), PipelineQueueLength);
+            }
+        }
+    PipelineCS->Leave();
+
+    CMN_LOG_CLASS_INIT_DEBUG << "CreatePipeline: stream \"" << this->GetName() << "\" has "
+                             << PipelineStages.size() << " pipeline stage(s)" << std::endl;
+    return SVL_OK;
+}
+
+void svlStreamManager::AbortPipeline(void)
+{
+    for (size_t i = 0; i < PipelineQueues.size(); i ++) {
+        if (PipelineQueues[i]) PipelineQueues[i]->Abort();
+    }
+}
+
+void svlStreamManager::DeletePipeline(void)
+{
+    PipelineCS->Enter();
+        for (size_t i = 0; i < PipelineQueues.size(); i ++) {
+            if (PipelineQueues[i]) delete PipelineQueues[i];
+        }
+        PipelineQueues.SetSize(0);
+        PipelineStages.SetSize(0);
+    PipelineCS->Leave();
+}
+
 void svlStreamManager::DisconnectAll(void)
 {
     // First make sure that the stream is released
@@ -728,6 +995,15 @@ void svlStreamManager::CreateInterfaces(void)
         interfaceProvided->AddCommandVoid(&svlStreamManager::InitializeCommand, this, "Initialize");
         interfaceProvided->AddCommandVoid(&svlStreamManager::Release, this, "Release");
     }
+
+    interfaceProvided = this->AddInterfaceProvided("Instrumentation", MTS_COMMANDS_SHOULD_NOT_BE_QUEUED);
+    if (interfaceProvided) {
+        interfaceProvided->AddCommandRead (&svlStreamManager::GetInstrumentationReportCommand, this, "GetReport");
+        interfaceProvided->AddCommandRead (&svlStreamManager::GetLatencyHistogramCommand,      this, "GetLatencyHistogram");
+        interfaceProvided->AddCommandVoid (&svlStreamManager::ResetInstrumentation,            this, "Reset");
+        interfaceProvided->AddCommandWrite(&svlStreamManager::SetTraceLengthCommand,           this, "SetTraceLength");
+        interfaceProvided->AddCommandWrite(&svlStreamManager::SaveTraceCommand,                this, "SaveTrace");
+    }
 }
 
 void svlStreamManager::PlayCommand(void)
@@ -768,3 +1044,24 @@ void svlStreamManager::SetSourceFilterCommand(const mtsStdString & source)
     // finally call the SetSourceFilter method
     SetSourceFilter(filter);
 }
+
+void svlStreamManager::GetInstrumentationReportCommand(mtsStdString & report) const
+{
+    report = GetInstrumentationReport();
+}
+
+void svlStreamManager::GetLatencyHistogramCommand(mtsUIntVec & histogram) const
+{
+    double binwidth;
+    GetLatencyHistogram(histogram, binwidth);
+}
+
+void svlStreamManager::SetTraceLengthCommand(const unsigned int & maxevents)
+{
+    SetTraceLength(maxevents);
+}
+
+void svlStreamManager::SaveTraceCommand(const mtsStdString & filename)
+{
+    SaveTrace(filename);
+}
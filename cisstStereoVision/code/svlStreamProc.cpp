@@ -25,7 +25,10 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlStreamBranchSource.h>
 #include <cisstStereoVision/svlFilterInput.h>
 #include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstStereoVision/svlSampleQueue.h>
+#include "svlStreamInstrumentation.h"
 #include <cisstOSAbstraction/osaTimeServer.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 #include <cisstOSAbstraction/osaSleep.h>
 
 
@@ -60,9 +63,11 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
     svlFilterInput* input;
     svlProcInfo info;
     svlSyncPoint *sync = baseref->SyncPoint;
+    svlStreamInstrumentation* instrumentation = baseref->Instrumentation;
     unsigned int counter = 0;
     osaTimeServer* timeserver = 0;
-    double timestamp;
+    double timestamp, waitstart = 0.0, barrierwait, procstart, procend;
+    double frametimestamp = -1.0;
     int status = SVL_OK;
 
     // Initializing thread info structure
@@ -124,6 +129,9 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
     ////////////////////////////////////
     // Starting from the stream source
 
+        if (ThreadCount > 1) waitstart = sync->GetWaitTime(ThreadID);
+        procstart = osaGetTime();
+
         status = source->Process(&info, outputsample);
         if (status == SVL_STOP_REQUEST) {
             CMN_LOG_INIT_DEBUG << "svlStreamProc::Proc (ThreadID=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): SVL_STOP_REQUEST received" << std::endl;
@@ -141,10 +149,13 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
                 // Get fresh timestamp and assign it to the output sample
                 outputsample->SetTimestamp(GetAbsoluteTime(timeserver));
             }
+            // Latency is measured only against timestamps assigned by the stream
+            frametimestamp = (outputsample && source->AutoTimestamp) ? outputsample->GetTimestamp() : -1.0;
 
         // Execute only on one thread - END
         }
 
+        barrierwait = 0.0;
         if (ThreadCount > 1) {
         // Execute only if multi-threaded - BEGIN
 
@@ -154,9 +165,17 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
                 break;
             }
 
+            // Time spent at barriers on behalf of the source
+            barrierwait = sync->GetWaitTime(ThreadID) - waitstart;
+            source->BarrierWaitTime[ThreadID] += barrierwait;
+
         // Execute only if multi-threaded - END
         }
 
+        procend = osaGetTime();
+        source->ProcessTime[ThreadID] += procend - procstart;
+        instrumentation->AddTraceEvent(ThreadID, source->GetName(), counter, procstart, procend, barrierwait);
+
         // Enabled/Disabled flag to be ignored in case of
         // source filters. Use Pause and Play instead.
 
@@ -209,12 +228,16 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
                 break;
             }
 
+            if (ThreadCount > 1) waitstart = sync->GetWaitTime(ThreadID);
+            procstart = osaGetTime();
+
             status = filter->Process(&info, inputsample, outputsample);
             if (status < 0) {
                 CMN_LOG_INIT_ERROR << "svlStreamProc::Proc (ThreadID=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): svlFilterBase::Process() returned error (" << status << ")" << std::endl;
                 break;
             }
 
+            barrierwait = 0.0;
             if (ThreadCount > 1) {
             // Execute only if multi-threaded - BEGIN
 
@@ -224,9 +247,17 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
                     break;
                 }
 
+                // Time spent at barriers during and after Process
+                barrierwait = sync->GetWaitTime(ThreadID) - waitstart;
+                filter->BarrierWaitTime[ThreadID] += barrierwait;
+
             // Execute only if multi-threaded - END
             }
 
+            procend = osaGetTime();
+            filter->ProcessTime[ThreadID] += procend - procstart;
+            instrumentation->AddTraceEvent(ThreadID, filter->GetName(), counter, procstart, procend, barrierwait);
+
             // Thread-safe propagation of Enabled flag to EnabledInternal.
             // This step introduces at most 1 frame delay to the Enabled/Disabled state.
             if (ThreadID == 0) {
@@ -274,6 +305,11 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
         }
         if (status < 0) break;
 
+        if (ThreadID == 0 && frametimestamp >= 0.0 && baseref->StopThread == false) {
+            // The frame has left the last filter of the trunk
+            instrumentation->AddLatency(GetAbsoluteTime(timeserver) - frametimestamp);
+        }
+
         // incrementing frame counter
         counter ++;
     }
@@ -309,3 +345,206 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
     return this;
 }
 
+void* svlStreamProc::PipelineProc(svlStreamManager* baseref)
+{
+    svlSample *inputsample = 0, *outputsample;
+    svlFilterBase* filter = baseref->PipelineStages[ThreadID];
+    svlFilterSourceBase* source = baseref->StreamSource;
+    svlSampleQueueBlocking* inputqueue = 0;
+    svlSampleQueueBlocking* outputqueue = 0;
+    svlStreamInstrumentation* instrumentation = baseref->Instrumentation;
+    svlProcInfo info;
+    unsigned int counter = 0;
+    osaTimeServer* timeserver = 0;
+    const bool laststage = (ThreadID + 1 == baseref->PipelineStages.size());
+    double procstart = 0.0, procend, frametimestamp;
+    int status = SVL_OK;
+
+    if (ThreadID > 0) inputqueue = baseref->PipelineQueues[ThreadID - 1];
+    if (ThreadID < baseref->PipelineQueues.size()) outputqueue = baseref->PipelineQueues[ThreadID];
+
+    // Each stage is processed by a single thread
+    info.count = 1;
+    info.ID    = 0;
+    info.sync  = 0;
+    info.cs    = baseref->CS;
+
+    if (ThreadID == 0 || laststage) {
+        // Initialize time server for accessing absolute time
+        // (source stage: timestamps, last stage: latency)
+        timeserver = new osaTimeServer;
+        timeserver->SetTimeOrigin();
+    }
+
+    while (baseref->StopThread == false) {
+        filter->FrameCounter = counter;
+        outputsample = 0;
+
+        if (ThreadID == 0) {
+        // Source stage - BEGIN
+
+            // Handle stream control (pause/play)
+            if (source->PauseAtFrameID == static_cast<int>(counter)) {
+                // Wait until playback resumed or stream stopped
+                while (source->PlayCounter == 0 && baseref->StopThread == false) {
+                    osaSleep(0.1); // check 10 times a second
+                }
+                if (baseref->StopThread) {
+                    CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): stream stopped while paused" << std::endl;
+                    break;
+                }
+            }
+            if (source->PlayCounter > 0) source->PlayCounter --;
+            if (source->PlayCounter == 0) {
+                // Pause when the next frame arrives
+                source->PauseAtFrameID = static_cast<int>(counter) + 1;
+            }
+
+            procstart = osaGetTime();
+            status = source->Process(&info, outputsample);
+            if (status == SVL_STOP_REQUEST) {
+                CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): SVL_STOP_REQUEST received" << std::endl;
+                break;
+            }
+            else if (status < 0) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): svlFilterSourceBase::Process() returned error (" << status << ")" << std::endl;
+                break;
+            }
+
+            if (outputsample && (source->AutoTimestamp || outputsample->GetTimestamp() < 0.0)) {
+                // Get fresh timestamp and assign it to the output sample
+                outputsample->SetTimestamp(GetAbsoluteTime(timeserver));
+            }
+
+        // Source stage - END
+        }
+        else {
+        // Filter stage - BEGIN
+
+            // Wait for the next frame from the previous stage
+            inputsample = inputqueue->Pull();
+            if (inputsample == 0) {
+                if (baseref->StopThread == false) {
+                    // Previous stage closed the queue: end of stream
+                    CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): end of stream" << std::endl;
+                    status = SVL_STOP_REQUEST;
+                }
+                break;
+            }
+
+            // Check if the previous output is valid input for the filter
+            status = filter->IsDataValid(filter->GetInput()->Type, inputsample);
+            if (status != SVL_OK) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): svlFilterBase::IsDataValid() returned error (" << status << ")" << std::endl;
+                break;
+            }
+
+            procstart = osaGetTime();
+            status = filter->Process(&info, inputsample, outputsample);
+            if (status < 0) {
+                CMN_LOG_INIT_ERROR << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): svlFilterBase::Process() returned error (" << status << ")" << std::endl;
+                break;
+            }
+
+            // Only this stage's thread processes the filter
+            filter->EnabledInternal = filter->Enabled;
+
+            // Store input time stamp
+            filter->PrevInputTimestamp = inputsample->GetTimestamp();
+
+            // Pass input timestamp to output sample
+            if (outputsample) outputsample->SetTimestamp(filter->PrevInputTimestamp);
+
+        // Filter stage - END
+        }
+
+        procend = osaGetTime();
+        filter->ProcessTime[0] += procend - procstart;
+        instrumentation->AddTraceEvent(ThreadID, filter->GetName(), counter, procstart, procend, 0.0);
+
+        // Read the timestamp before the input is released to the previous stage
+        if (ThreadID == 0) frametimestamp = outputsample ? outputsample->GetTimestamp() : -1.0;
+        else frametimestamp = inputsample->GetTimestamp();
+
+        // Check for errors and stop request
+        if (baseref->StopThread) {
+            CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): StopThread flag is true" << std::endl;
+            break;
+        }
+        else if (baseref->StreamStatus != SVL_OK) {
+            CMN_LOG_INIT_ERROR << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): StreamStatus signals error (" << baseref->StreamStatus << ")" << std::endl;
+            break;
+        }
+
+        // Hand over a copy of the output to the next stage, the output
+        // may be the input sample so it has to be pushed before popping
+        status = PassDownstream(filter, outputsample, outputqueue);
+        if (status != SVL_OK) break;
+        if (inputqueue) inputqueue->Pop();
+
+        if (laststage && source->AutoTimestamp && frametimestamp >= 0.0) {
+            // The frame has left the last filter of the trunk
+            instrumentation->AddLatency(GetAbsoluteTime(timeserver) - frametimestamp);
+        }
+
+        // incrementing frame counter
+        counter ++;
+    }
+
+    if (timeserver) delete timeserver;
+
+    bool internalstop = false;
+    if (status == SVL_STOP_REQUEST && outputqueue) {
+        // Let the next stages finish the frames in flight
+        outputqueue->Close();
+    }
+    else {
+        baseref->CS->Enter();
+            if (baseref->StopThread == false) {
+                // Internal shutdown, claimed by a single stage
+                baseref->StreamStatus = status;
+                baseref->StopThread = true;
+                internalstop = true;
+            }
+        baseref->CS->Leave();
+        baseref->AbortPipeline();
+    }
+
+    // Run InternalStop() method in case of internal shutdown
+    if (internalstop) {
+        baseref->InternalStop(ThreadID);
+    }
+
+    return this;
+}
+
+int svlStreamProc::PassDownstream(svlFilterBase* filter, svlSample* outputsample, svlSampleQueueBlocking* queue)
+{
+    svlFilterOutput* output = filter->GetOutput();
+    // Check if trunk output exists
+    if (!output) return SVL_OK;
+    svlFilterInput* input = output->Connection;
+    // Check if trunk output is connected
+    if (!input) return SVL_OK;
+
+    // Store timestamps on both the filter input and the filter output
+    if (outputsample) {
+        const double timestamp = outputsample->GetTimestamp();
+        output->Timestamp = timestamp;
+        input->Timestamp = timestamp;
+    }
+
+    if (!input->Trunk) {
+        // If connected input is not trunk
+        if (outputsample) input->Buffer->Push(outputsample);
+        return SVL_OK;
+    }
+
+    if (!outputsample) {
+        CMN_LOG_INIT_ERROR << "svlStreamProc::PassDownstream (Stage=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): no output sample for next stage" << std::endl;
+        return SVL_FAIL;
+    }
+    // Push fails only if the pipeline has been aborted
+    if (!queue || !queue->Push(outputsample)) return SVL_FAIL;
+    return SVL_OK;
+}
@@ -21,6 +21,67 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstStereoVision/svlSyncPoint.h>
 #include <cisstStereoVision/svlDefinitions.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaCPUAffinity.h>
+
+#if (CISST_OS == CISST_WINDOWS)
+#include <windows.h>
+#endif
+
+#if (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_LINUX_RTAI)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#define SVL_SYNC_HAS_FUTEX
+#endif
+
+#if (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS)
+#include <sched.h>
+#endif
+
+
+/*************************************/
+/*** Atomic helpers ******************/
+/*************************************/
+
+#if (CISST_OS == CISST_WINDOWS)
+
+static inline LONG svlAtomicDecrement(volatile LONG* value) { return InterlockedDecrement(value); }
+static inline LONG svlAtomicIncrement(volatile LONG* value) { return InterlockedIncrement(value); }
+static inline void svlCpuRelax() { YieldProcessor(); }
+static inline void svlSleepWhileEqual(volatile LONG* /*address*/, LONG /*value*/) { SwitchToThread(); }
+static inline void svlWakeAll(volatile LONG* /*address*/) {}
+
+#else
+
+static inline int svlAtomicDecrement(volatile int* value) { return __sync_sub_and_fetch(value, 1); }
+static inline int svlAtomicIncrement(volatile int* value) { return __sync_add_and_fetch(value, 1); }
+static inline void svlCpuRelax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#else
+    __sync_synchronize();
+#endif
+}
+
+#ifdef SVL_SYNC_HAS_FUTEX
+static inline void svlSleepWhileEqual(volatile int* address, int value)
+{
+    // Returns immediately if *address no longer equals value
+    syscall(SYS_futex, const_cast<int*>(address), FUTEX_WAIT_PRIVATE, value, 0, 0, 0);
+}
+static inline void svlWakeAll(volatile int* address)
+{
+    syscall(SYS_futex, const_cast<int*>(address), FUTEX_WAKE_PRIVATE, INT_MAX, 0, 0, 0);
+}
+#else
+static inline void svlSleepWhileEqual(volatile int* /*address*/, int /*value*/) { sched_yield(); }
+static inline void svlWakeAll(volatile int* /*address*/) {}
+#endif
+
+#endif
 
 
 /*************************************/
@@ -32,11 +93,21 @@ http://www.cisst.org/cisst/license.txt.
 // arguments:
 // *******************************************************************
 svlSyncPoint::svlSyncPoint() :
+    Type(svlSyncPointEvent),
+    SpinCount(4000),
+    EffectiveSpinCount(4000),
     ThreadCount(2),
-    LastChanged(-1)
+    LastChanged(-1),
+    Remaining(2),
+    Generation(0),
+    Sleepers(0),
+    Released(0)
 {
     CheckedInCounter = ThreadCount;
     ReleaseEvent = new osaThreadSignal[ThreadCount];
+    WaitTime.SetSize(ThreadCount);
+    WaitTime.SetAll(0.0);
+    UpdateSpinCount();
 }
 
 // *******************************************************************
@@ -63,9 +134,17 @@ int svlSyncPoint::Count(unsigned int count)
     CheckedInCounter = ThreadCount;
     LastChanged = -1;
 
+    Remaining = static_cast<int>(ThreadCount);
+    Sleepers = 0;
+    Released = 0;
+
     delete [] ReleaseEvent;
     ReleaseEvent = new osaThreadSignal[ThreadCount];
 
+    WaitTime.SetSize(ThreadCount);
+    WaitTime.SetAll(0.0);
+    UpdateSpinCount();
+
     return SVL_SYNC_OK;
 }
 
@@ -74,6 +153,42 @@ unsigned int svlSyncPoint::Count()
     return ThreadCount;
 }
 
+// *******************************************************************
+// svlSyncPoint::SetType method
+// arguments:
+//           type           - barrier implementation
+//           spincount      - polling iterations before sleeping
+// function:
+//    Selects the barrier implementation.
+//    This method is not thread safe.
+// *******************************************************************
+int svlSyncPoint::SetType(svlSyncPointType type, unsigned int spincount)
+{
+    Type = type;
+    SpinCount = spincount;
+    UpdateSpinCount();
+    return SVL_SYNC_OK;
+}
+
+void svlSyncPoint::UpdateSpinCount()
+{
+    // Don't spin if threads have to share CPUs
+    const int cpucount = osaCPUGetCount();
+    if (cpucount > 0 && ThreadCount > static_cast<unsigned int>(cpucount)) EffectiveSpinCount = 0;
+    else EffectiveSpinCount = SpinCount;
+}
+
+svlSyncPointType svlSyncPoint::GetType() const
+{
+    return Type;
+}
+
+double svlSyncPoint::GetWaitTime(unsigned int _id) const
+{
+    if (_id >= ThreadCount) return 0.0;
+    return WaitTime[_id];
+}
+
 // *******************************************************************
 // svlSyncPoint::Sync method
 // arguments:
@@ -86,6 +201,16 @@ int svlSyncPoint::Sync(unsigned int _id)
 {
     if (_id >= ThreadCount) return SVL_SYNC_ERROR;
 
+    const double start = osaGetTime();
+    const int ret = (Type == svlSyncPointSpin) ? SpinSync(_id) : EventSync(_id);
+    // Each thread only updates its own entry
+    WaitTime[_id] += osaGetTime() - start;
+
+    return ret;
+}
+
+int svlSyncPoint::EventSync(unsigned int _id)
+{
     CS.Enter();
         CheckedInCounter --;
         LastChanged = static_cast<int>(_id);
@@ -118,6 +243,38 @@ int svlSyncPoint::Sync(unsigned int _id)
     return SVL_SYNC_OK;
 }
 
+int svlSyncPoint::SpinSync(unsigned int CMN_UNUSED(_id))
+{
+    if (Released) return SVL_SYNC_OK;
+
+    // Generation has to be read before checking in
+    const int generation = Generation;
+
+    if (svlAtomicDecrement(&Remaining) == 0) {
+        // Last thread: reset the counter for the next cycle,
+        // then flip the generation to release the others
+        Remaining = static_cast<int>(ThreadCount);
+        svlAtomicIncrement(&Generation);
+        if (Sleepers > 0) svlWakeAll(&Generation);
+        return SVL_SYNC_OK;
+    }
+
+    // Bounded spinning
+    for (unsigned int i = 0; i < EffectiveSpinCount; i ++) {
+        if (Generation != generation || Released) return SVL_SYNC_OK;
+        svlCpuRelax();
+    }
+
+    // Sleep until the generation changes
+    svlAtomicIncrement(&Sleepers);
+    while (Generation == generation && !Released) {
+        svlSleepWhileEqual(&Generation, generation);
+    }
+    svlAtomicDecrement(&Sleepers);
+
+    return SVL_SYNC_OK;
+}
+
 // *******************************************************************
 // svlSyncPoint::ReleaseAll method
 // function:
@@ -132,6 +289,11 @@ void svlSyncPoint::ReleaseAll()
         
         CheckedInCounter = ThreadCount;
         LastChanged = -1;
+
+        // Spinning and sleeping threads return, following
+        // calls to Sync don't block anymore
+        Released = 1;
+        svlAtomicIncrement(&Generation);
+        svlWakeAll(&Generation);
     CS.Leave();
 }
-
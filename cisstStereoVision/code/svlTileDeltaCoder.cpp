@@ -0,0 +1,376 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlTileDeltaCoder.h"
+#include <cisstStereoVision/svlSyncPoint.h>
+#include "svlConvertersSIMD.h"
+#include <cstring>
+#include <algorithm>
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+// Copies 'rows' rows of 'length' bytes
+static inline void CopyRows(const unsigned char* src, const unsigned int srcstride,
+                            unsigned char* dst, const unsigned int dststride,
+                            const unsigned int length, unsigned int rows)
+{
+    while (rows) {
+        memcpy(dst, src, length);
+        src += srcstride;
+        dst += dststride;
+        rows --;
+    }
+}
+
+// True if any byte differs by more than 'threshold'
+static inline bool RowDiffers(const unsigned char* row1, const unsigned char* row2,
+                              const unsigned int length, const unsigned char threshold)
+{
+    if (threshold == 0) return memcmp(row1, row2, length) != 0;
+
+    unsigned int i = 0;
+
+#ifdef SVL_CONVERTER_HAS_SSE2
+    const __m128i thr = _mm_set1_epi8(static_cast<char>(threshold));
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a, b, diff;
+    for (; i + 16 <= length; i += 16) {
+        a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i));
+        b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row2 + i));
+        diff = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+        // Non-zero where the difference exceeds the threshold
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(diff, thr), zero)) != 0xFFFF) return true;
+    }
+#endif
+
+    for (; i < length; i ++) {
+        if ((row1[i] > row2[i] ? row1[i] - row2[i] : row2[i] - row1[i]) > threshold) return true;
+    }
+    return false;
+}
+
+
+/*************************************/
+/*** svlTileDeltaCoder class *********/
+/*************************************/
+
+svlTileDeltaCoder::svlTileDeltaCoder() :
+    TileWidth(DefaultTileSize),
+    TileHeight(DefaultTileSize),
+    KeyFrameInterval(0),
+    Threshold(0),
+    MaxChangedRatio(0.6),
+    KeyFrameRequested(false),
+    Width(0),
+    Height(0),
+    TilesX(0),
+    TilesY(0),
+    HasReference(false),
+    FrameNumber(0),
+    KeyFrameNumber(0),
+    DecodedKeyFrame(0),
+    KeyFrame(true)
+{
+}
+
+void svlTileDeltaCoder::SetTileSize(const unsigned int width, const unsigned int height)
+{
+    TileWidth  = std::max(2u, width & ~1u);
+    TileHeight = std::max(1u, height);
+    Reset();
+}
+
+void svlTileDeltaCoder::SetKeyFrameInterval(const unsigned int interval)
+{
+    KeyFrameInterval = interval;
+}
+
+unsigned int svlTileDeltaCoder::GetKeyFrameInterval() const
+{
+    return KeyFrameInterval;
+}
+
+void svlTileDeltaCoder::SetThreshold(const unsigned char threshold)
+{
+    Threshold = threshold;
+}
+
+void svlTileDeltaCoder::SetMaxChangedRatio(const double ratio)
+{
+    MaxChangedRatio = ratio;
+}
+
+void svlTileDeltaCoder::Reset()
+{
+    Width = Height = 0;
+    HasReference = false;
+    FrameNumber = KeyFrameNumber = DecodedKeyFrame = 0;
+}
+
+void svlTileDeltaCoder::RequestKeyFrame()
+{
+    KeyFrameRequested = true;
+}
+
+unsigned int svlTileDeltaCoder::GetPaddedSize(const unsigned int width, const unsigned int height)
+{
+    return ((width  + DefaultTileSize - 1) / DefaultTileSize) * DefaultTileSize *
+           ((height + DefaultTileSize - 1) / DefaultTileSize) * DefaultTileSize;
+}
+
+int svlTileDeltaCoder::Encode(svlProcInfo* procInfo, const svlSampleImage &image, const unsigned int videoch)
+{
+    if (videoch >= image.GetVideoChannels() || image.GetBPP() != 3) return SVL_FAIL;
+
+    const unsigned char* img = image.GetUCharPointer(videoch);
+    unsigned int from, to, i, j, x, y, w, h;
+
+    _OnSingleThread(procInfo)
+    {
+        if (image.GetWidth(videoch) != Width || image.GetHeight(videoch) != Height) {
+            SetDimensions(image.GetWidth(videoch), image.GetHeight(videoch));
+        }
+        FrameNumber ++;
+        KeyFrame = !HasReference || KeyFrameRequested ||
+                   KeyFrameInterval <= 1 || FrameNumber - KeyFrameNumber >= KeyFrameInterval;
+        KeyFrameRequested = false;
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    const unsigned int stride = Width * 3;
+
+    if (!KeyFrame) {
+        // Find tiles changed since the key frame, split by tile rows
+        _GetParallelSubRange(procInfo, TilesY, from, to);
+        for (j = from; j < to; j ++) {
+            for (i = j * TilesX; i < (j + 1) * TilesX; i ++) {
+                Changed[i] = IsTileChanged(img, i) ? 1 : 0;
+            }
+        }
+
+        _SynchronizeThreads(procInfo);
+
+        _OnSingleThread(procInfo)
+        {
+            ChangedTiles.clear();
+            for (i = 0; i < TilesX * TilesY; i ++) {
+                if (Changed[i]) ChangedTiles.push_back(i);
+            }
+            // Coding most of the image as tiles is no better than a key frame;
+            // the packed tiles also have to fit in buffers of the padded size
+            if (ChangedTiles.size() > MaxChangedRatio * TilesX * TilesY ||
+                ChangedTiles.size() * TileWidth * TileHeight > GetPaddedSize(Width, Height)) KeyFrame = true;
+            else ResizePackedTiles(static_cast<unsigned int>(ChangedTiles.size()));
+        }
+
+        _SynchronizeThreads(procInfo);
+    }
+
+    if (KeyFrame) {
+        _GetParallelSubRange(procInfo, Height, from, to);
+        if (from < to) memcpy(&(Reference[from * stride]), img + from * stride, (to - from) * stride);
+    }
+    else {
+        // Pack the changed tiles
+        const unsigned int slotsize = TileWidth * TileHeight * 3;
+        const unsigned int count = static_cast<unsigned int>(ChangedTiles.size());
+        unsigned char* packed = PackedTiles.GetUCharPointer();
+        _GetParallelSubRange(procInfo, count, from, to);
+        for (i = from; i < to; i ++) {
+            GetTileRect(ChangedTiles[i], x, y, w, h);
+            const unsigned int offset = y * stride + x * 3;
+            CopyRows(img + offset, stride, packed + i * slotsize, TileWidth * 3, w * 3, h);
+        }
+    }
+
+    _SynchronizeThreads(procInfo);
+
+    _OnSingleThread(procInfo)
+    {
+        if (KeyFrame) {
+            ChangedTiles.clear();
+            KeyFrameNumber = FrameNumber;
+            HasReference = true;
+        }
+    }
+
+    return SVL_OK;
+}
+
+bool svlTileDeltaCoder::IsKeyFrame() const
+{
+    return KeyFrame;
+}
+
+unsigned int svlTileDeltaCoder::GetChangedTileCount() const
+{
+    return static_cast<unsigned int>(ChangedTiles.size());
+}
+
+svlSampleImage& svlTileDeltaCoder::GetPackedTiles()
+{
+    return PackedTiles;
+}
+
+unsigned int svlTileDeltaCoder::GetHeaderSize() const
+{
+    return static_cast<unsigned int>(sizeof(unsigned int) * (5 + ChangedTiles.size()));
+}
+
+unsigned int svlTileDeltaCoder::WriteHeader(unsigned char* buffer) const
+{
+    const unsigned int count = static_cast<unsigned int>(ChangedTiles.size());
+    unsigned int header[5] = { FrameNumber, KeyFrameNumber, TileWidth, TileHeight, count };
+
+    memcpy(buffer, header, sizeof(header));
+    if (count > 0) memcpy(buffer + sizeof(header), &(ChangedTiles[0]), count * sizeof(unsigned int));
+
+    return GetHeaderSize();
+}
+
+unsigned int svlTileDeltaCoder::ReadHeader(const unsigned char* buffer, const unsigned int size,
+                                           const unsigned int width, const unsigned int height)
+{
+    unsigned int header[5], i;
+
+    if (size < sizeof(header)) return 0;
+    memcpy(header, buffer, sizeof(header));
+
+    // The decoder buffers are sized for the tile size of the encoder
+    if (header[2] != TileWidth || header[3] != TileHeight) return 0;
+
+    if (width != Width || height != Height) SetDimensions(width, height);
+
+    const unsigned int count = header[4];
+    if (count > TilesX * TilesY || size - sizeof(header) < count * sizeof(unsigned int) ||
+        static_cast<unsigned long long>(count) * TileWidth * TileHeight > GetPaddedSize(width, height)) return 0;
+
+    FrameNumber = header[0];
+    KeyFrameNumber = header[1];
+    KeyFrame = (FrameNumber == KeyFrameNumber);
+    ChangedTiles.resize(count);
+    if (count > 0) memcpy(&(ChangedTiles[0]), buffer + sizeof(header), count * sizeof(unsigned int));
+    for (i = 0; i < count; i ++) {
+        if (ChangedTiles[i] >= TilesX * TilesY) return 0;
+    }
+
+    return GetHeaderSize();
+}
+
+bool svlTileDeltaCoder::CanDecode() const
+{
+    return KeyFrame || (HasReference && KeyFrameNumber == DecodedKeyFrame);
+}
+
+unsigned int svlTileDeltaCoder::GetFrameNumber() const
+{
+    return FrameNumber;
+}
+
+unsigned int svlTileDeltaCoder::GetKeyFrameNumber() const
+{
+    return KeyFrameNumber;
+}
+
+svlSampleImage& svlTileDeltaCoder::PreparePackedTiles()
+{
+    ResizePackedTiles(static_cast<unsigned int>(ChangedTiles.size()));
+    return PackedTiles;
+}
+
+int svlTileDeltaCoder::Decode(svlSampleImage &image, const unsigned int videoch)
+{
+    if (videoch >= image.GetVideoChannels() || image.GetBPP() != 3 ||
+        image.GetWidth(videoch) != Width || image.GetHeight(videoch) != Height ||
+        !CanDecode()) return SVL_FAIL;
+
+    const unsigned int stride = Width * 3;
+    unsigned char* img = image.GetUCharPointer(videoch);
+
+    if (KeyFrame) {
+        memcpy(&(Reference[0]), img, stride * Height);
+        DecodedKeyFrame = FrameNumber;
+        HasReference = true;
+    }
+    else {
+        const unsigned int slotsize = TileWidth * TileHeight * 3;
+        const unsigned int count = static_cast<unsigned int>(ChangedTiles.size());
+        const unsigned char* packed = PackedTiles.GetUCharPointer();
+        unsigned int i, x, y, w, h;
+        memcpy(img, &(Reference[0]), stride * Height);
+        for (i = 0; i < count; i ++) {
+            GetTileRect(ChangedTiles[i], x, y, w, h);
+            CopyRows(packed + i * slotsize, TileWidth * 3, img + y * stride + x * 3, stride, w * 3, h);
+        }
+    }
+
+    return SVL_OK;
+}
+
+void svlTileDeltaCoder::SetDimensions(const unsigned int width, const unsigned int height)
+{
+    Width  = width;
+    Height = height;
+    TilesX = (width  + TileWidth  - 1) / TileWidth;
+    TilesY = (height + TileHeight - 1) / TileHeight;
+    Reference.resize(width * height * 3);
+    Changed.resize(TilesX * TilesY);
+    ChangedTiles.clear();
+    HasReference = false;
+}
+
+void svlTileDeltaCoder::GetTileRect(const unsigned int tile, unsigned int &x, unsigned int &y, unsigned int &width, unsigned int &height) const
+{
+    x = (tile % TilesX) * TileWidth;
+    y = (tile / TilesX) * TileHeight;
+    width  = std::min(TileWidth,  Width  - x);
+    height = std::min(TileHeight, Height - y);
+}
+
+bool svlTileDeltaCoder::IsTileChanged(const unsigned char* image, const unsigned int tile) const
+{
+    const unsigned int stride = Width * 3;
+    unsigned int x, y, w, h;
+
+    GetTileRect(tile, x, y, w, h);
+    const unsigned int offset = y * stride + x * 3;
+    const unsigned char* src = image + offset;
+    const unsigned char* ref = &(Reference[offset]);
+    while (h) {
+        if (RowDiffers(src, ref, w * 3, Threshold)) return true;
+        src += stride;
+        ref += stride;
+        h --;
+    }
+    return false;
+}
+
+void svlTileDeltaCoder::ResizePackedTiles(const unsigned int count)
+{
+    // At least one tile, so that the image is never empty
+    const unsigned int height = std::max(1u, count) * TileHeight;
+    if (PackedTiles.GetWidth() != TileWidth || PackedTiles.GetHeight() != height) {
+        PackedTiles.SetSize(TileWidth, height);
+        // Padding of edge tiles
+        memset(PackedTiles.GetUCharPointer(), 0, PackedTiles.GetDataSize());
+    }
+}
+
@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlTileDeltaCoder_h
+#define _svlTileDeltaCoder_h
+
+#include <cisstStereoVision/svlTypes.h>
+#include <vector>
+
+
+// Tile based change detection for video codecs of RGB images.
+// The image is divided into tiles and only the tiles that differ from the
+// last key frame are coded: the encoder copies them into a packed image
+// (tiles stacked vertically, TileWidth pixels wide) that the codec
+// compresses with its own method, and the decoder copies them over the
+// decoded key frame.  Delta frames only depend on their key frame, so
+// frames lost or skipped in between do not corrupt the image.
+// A key frame, which the codec compresses in full, is coded every
+// 'key frame interval' frames, on request, and when the changed tiles
+// cover too much of the image.
+// The serialized header precedes the compressed data of each frame:
+//   frame number (the first encoded frame is 1), key frame number, tile width, tile height, changed tile
+//   count (unsigned int each), then the index of each changed tile.
+class svlTileDeltaCoder
+{
+public:
+    enum { DefaultTileSize = 32 };
+
+    svlTileDeltaCoder();
+
+    //! Tile dimensions; width shall be even for YUV 4:2:2 compression.
+    //! The decoder has to use the same tile size as the encoder.
+    void SetTileSize(const unsigned int width, const unsigned int height);
+    //! 0 or 1: every frame is a key frame
+    void SetKeyFrameInterval(const unsigned int interval);
+    unsigned int GetKeyFrameInterval() const;
+    //! Largest per-byte difference still considered unchanged
+    void SetThreshold(const unsigned char threshold);
+    //! Fraction of changed tiles above which a key frame is coded instead
+    void SetMaxChangedRatio(const double ratio);
+    //! Forgets the key frame and restarts frame numbering from 1
+    void Reset();
+    //! The next encoded frame will be a key frame
+    void RequestKeyFrame();
+    //! Pixel count of the image padded to whole tiles of the default size;
+    //! buffers of this size hold the image and the packed tiles as well
+    static unsigned int GetPaddedSize(const unsigned int width, const unsigned int height);
+
+    // Encoder
+    //! Has to be called on all threads; the packed image is complete on return
+    int Encode(svlProcInfo* procInfo, const svlSampleImage &image, const unsigned int videoch);
+    bool IsKeyFrame() const;
+    unsigned int GetChangedTileCount() const;
+    svlSampleImage& GetPackedTiles();
+    unsigned int GetHeaderSize() const;
+    unsigned int WriteHeader(unsigned char* buffer) const;
+
+    // Decoder
+    //! Returns the header size, or 0 if the header is invalid, its tile size
+    //! differs from this coder's, or its tiles do not fit in the padded size
+    unsigned int ReadHeader(const unsigned char* buffer, const unsigned int size, const unsigned int width, const unsigned int height);
+    //! False if the key frame of a delta frame has not been decoded
+    bool CanDecode() const;
+    unsigned int GetFrameNumber() const;
+    unsigned int GetKeyFrameNumber() const;
+    //! Image to decompress the changed tiles of a delta frame into
+    svlSampleImage& PreparePackedTiles();
+    //! Key frames: stores the decoded image; delta frames: returns the
+    //! stored key frame with the packed tiles copied over it in 'image'
+    int Decode(svlSampleImage &image, const unsigned int videoch);
+
+private:
+    unsigned int TileWidth;
+    unsigned int TileHeight;
+    unsigned int KeyFrameInterval;
+    unsigned char Threshold;
+    double MaxChangedRatio;
+    bool KeyFrameRequested;
+
+    unsigned int Width;
+    unsigned int Height;
+    unsigned int TilesX;
+    unsigned int TilesY;
+    bool HasReference;
+    std::vector<unsigned char> Reference;   // last key frame
+
+    unsigned int FrameNumber;
+    unsigned int KeyFrameNumber;
+    unsigned int DecodedKeyFrame;
+    bool KeyFrame;
+    std::vector<unsigned char> Changed;
+    std::vector<unsigned int> ChangedTiles;
+    svlSampleImageRGB PackedTiles;
+
+    void SetDimensions(const unsigned int width, const unsigned int height);
+    void GetTileRect(const unsigned int tile, unsigned int &x, unsigned int &y, unsigned int &width, unsigned int &height) const;
+    bool IsTileChanged(const unsigned char* image, const unsigned int tile) const;
+    void ResizePackedTiles(const unsigned int count);
+};
+
+#endif // _svlTileDeltaCoder_h
+
@@ -20,6 +20,8 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlTrackerMSBruteForce.h>
+#include "svlConvolutionSIMD.h"
+#include <math.h>
 
 //#define __DEBUG_TRACKER
 
@@ -57,20 +59,10 @@ inline unsigned int sqrt_uint64(unsigned long long value)
 
 inline unsigned int sqrt_uint32(unsigned int value)
 {
-    unsigned int a, g = 0;
-    unsigned int bshft = 15;
-    unsigned int b = 1 << bshft;
-
-    do {
-        a = (g + g + b) << bshft;
-        if (value >= a) {
-            g += b;
-            value -= a;
-        }
-        b >>= 1;
-    } while (bshft --);
-
-    return g;
+    // Same as the bitwise integer square root for every 32 bit value (all
+    // of them are exactly representable as double), without its data
+    // dependent branches that dominated the cost of the NCC metrics
+    return static_cast<unsigned int>(sqrt(static_cast<double>(value)));
 }
 
 
@@ -338,7 +330,7 @@ int svlTrackerMSBruteForce::Initialize()
         Targets[i].image_data.SetAll(0);
     }
 
-    MatchMap.SetSize(SearchRadius * 2 + 1, SearchRadius * 2 + 1);
+    MatchMap[0].SetSize(SearchRadius * 2 + 1, SearchRadius * 2 + 1);
 
     TargetsAdded  = false;
     Initialized   = true;
@@ -444,13 +436,14 @@ int svlTrackerMSBruteForce::Track(svlSampleImage & image, unsigned int videoch)
     unsigned int templatesize = TemplateRadius * 2 + 1;
     templatesize *= templatesize * 3;
 
-    if (Metric == svlFastNCC) {
+    if (Metric == svlNCC || Metric == svlFastNCC) {
         if (ZeroMeanTemplate[0].size() < templatesize) {
             ZeroMeanTemplate[0].SetSize(templatesize);
         }
     }
 
     int xpre, ypre, x, y;
+    int* map = MatchMap[0].Pointer();
     svlTarget2D target, *ptgt;
     unsigned char conf, *p_raw_img, *p_preproc_img;
     unsigned int i;
@@ -575,28 +568,28 @@ int svlTrackerMSBruteForce::Track(svlSampleImage & image, unsigned int videoch)
         if (Scale == 1) {
             switch (Metric) {
                 case svlSAD:
-                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, false);
+                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, false, map);
                 break;
 
                 case svlSSD:
-                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, false);
+                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, false, map);
                 break;
 
                 case svlNCC:
-                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[0].Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, true, map);
                 break;
 
                 case svlFastNCC:
-                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[0].Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[0].Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, true, map);
                 break;
 
                 case svlNotQuiteNCC:
-                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, true, map);
                 break;
 
                 default:
@@ -606,28 +599,28 @@ int svlTrackerMSBruteForce::Track(svlSampleImage & image, unsigned int videoch)
         else {
             switch (Metric) {
                 case svlSAD:
-                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, false);
+                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, false, map);
                 break;
 
                 case svlSSD:
-                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, false);
+                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, false, map);
                 break;
 
                 case svlNCC:
-                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[0].Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, true, map);
                 break;
 
                 case svlFastNCC:
-                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[0].Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[0].Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, true, map);
                 break;
 
                 case svlNotQuiteNCC:
-                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, true, map);
                 break;
 
                 default:
@@ -689,13 +682,18 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
         preproc_image = PreProcessedImage;
     }
 
-    if (Metric == svlFastNCC) {
-        if (ZeroMeanTemplate.size() < procInfo->count) {
-            // Too many threads
-            // Increase ZeroMeanTemplate array size
-            return SVL_FAIL;
-        }
+    if (MatchMap.size() < procInfo->count) {
+        // Too many threads
+        // Increase MatchMap and ZeroMeanTemplate array sizes
+        return SVL_FAIL;
+    }
+
+    // Each thread tracks every 'procInfo->count'th target using its own match map
+    const unsigned int winsize = SearchRadius * 2 + 1;
+    if (MatchMap[procInfo->ID].rows() != winsize) {
+        MatchMap[procInfo->ID].SetSize(winsize, winsize);
     }
+    int* map = MatchMap[procInfo->ID].Pointer();
 
     int roi_margin = GetROIMargin();
     svlRect image_roi(roi_margin, roi_margin, preproc_image->GetWidth() - roi_margin, preproc_image->GetHeight() - roi_margin);
@@ -712,7 +710,7 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
     unsigned int templatesize = TemplateRadius * 2 + 1;
     templatesize *= templatesize * 3;
 
-    if (Metric == svlFastNCC) {
+    if (Metric == svlNCC || Metric == svlFastNCC) {
         if (ZeroMeanTemplate[procInfo->ID].size() < templatesize) {
             ZeroMeanTemplate[procInfo->ID].SetSize(templatesize);
         }
@@ -851,28 +849,28 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
         if (Scale == 1) {
             switch (Metric) {
                 case svlSAD:
-                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, false);
+                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, false, map);
                 break;
 
                 case svlSSD:
-                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, false);
+                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, false, map);
                 break;
 
                 case svlNCC:
-                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[procInfo->ID].Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, true, map);
                 break;
 
                 case svlFastNCC:
-                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[procInfo->ID].Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[procInfo->ID].Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, true, map);
                 break;
 
                 case svlNotQuiteNCC:
-                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, ptgt->conf, true, map);
                 break;
 
                 default:
@@ -882,28 +880,28 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
         else {
             switch (Metric) {
                 case svlSAD:
-                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, false);
+                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, false, map);
                 break;
 
                 case svlSSD:
-                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, false);
+                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, false, map);
                 break;
 
                 case svlNCC:
-                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[procInfo->ID].Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, true, map);
                 break;
 
                 case svlFastNCC:
-                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[procInfo->ID].Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[procInfo->ID].Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, true, map);
                 break;
 
                 case svlNotQuiteNCC:
-                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre, map);
+                    GetBestMatch(x, y, conf, true, map);
                 break;
 
                 default:
@@ -946,14 +944,16 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
         }
     }
 
-    ThreadCounter ++;
-    if (ThreadCounter == procInfo->count) {
-        // The last thread to finish stores the current images for later  use
-        memcpy(PreviousRawImage->GetUCharPointer(), raw_image->GetUCharPointer(videoch), PreviousRawImage->GetDataSize());
-        memcpy(PreviousPreProcessedImage->GetUCharPointer(), preproc_image->GetUCharPointer(videoch), PreviousPreProcessedImage->GetDataSize());
+    _CriticalSection(procInfo) {
+        ThreadCounter ++;
+        if (ThreadCounter == procInfo->count) {
+            // The last thread to finish stores the current images for later  use
+            memcpy(PreviousRawImage->GetUCharPointer(), raw_image->GetUCharPointer(videoch), PreviousRawImage->GetDataSize());
+            memcpy(PreviousPreProcessedImage->GetUCharPointer(), preproc_image->GetUCharPointer(videoch), PreviousPreProcessedImage->GetDataSize());
 
-        ThreadCounter = 0;
-        FrameCounter ++;
+            ThreadCounter = 0;
+            FrameCounter ++;
+        }
     }
 
     return SVL_OK;
@@ -1034,21 +1034,21 @@ void svlTrackerMSBruteForce::UpdateTemplate(unsigned char* img, unsigned char* t
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char* tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char* tmp, int x, int y, int* map)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
+    const unsigned int tmpwidth = tmpheight * 3;
     const unsigned int tmppixcount = tmpheight * tmpheight;
-    const unsigned int tmpstride = imgstride - tmpheight * 3;
+    const unsigned int tmpstride = imgstride - tmpwidth;
     const unsigned int winsize = SearchRadius * 2 + 1;
     const unsigned int imgwinstride = imgstride - winsize * 3;
     const int imgwidth = static_cast<int>(Width);
     const int imgheight = static_cast<int>(Height);
 
     int k, l, sum, ival, hfrom, vfrom;
-    int* map = MatchMap.Pointer();
     unsigned char *timg, *ttmp;
-    unsigned int i, j, v, h;
+    unsigned int i, j, v, h, done;
 
     if (x < static_cast<int>(TemplateRadius)) x = TemplateRadius;
     else if (x >= static_cast<int>(Width - TemplateRadius)) x = Width - TemplateRadius - 1;
@@ -1069,18 +1069,18 @@ void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char*
                 if (k >= 0 && k < imgwidth) {
 
                     // match in current position
-                    timg = img; ttmp = tmp;
                     sum = 0;
-                    for (j = 0; j < tmpheight; j ++) {
-                        for (i = 0; i < tmpheight; i ++) {
-                            ival = (static_cast<int>(*timg) - *ttmp); timg ++; ttmp ++;
-                            ival < 0 ? sum -= ival : sum += ival;
-                            ival = (static_cast<int>(*timg) - *ttmp); timg ++; ttmp ++;
-                            ival < 0 ? sum -= ival : sum += ival;
-                            ival = (static_cast<int>(*timg) - *ttmp); timg ++; ttmp ++;
-                            ival < 0 ? sum -= ival : sum += ival;
+                    done = svlConvolutionSIMD::AbsDiffRows(img, imgstride, tmp, tmpwidth, tmpwidth, tmpheight, sum);
+                    if (done < tmpwidth) {
+                        timg = img + done; ttmp = tmp + done;
+                        for (j = 0; j < tmpheight; j ++) {
+                            for (i = done; i < tmpwidth; i ++) {
+                                ival = (static_cast<int>(*timg) - *ttmp); timg ++; ttmp ++;
+                                ival < 0 ? sum -= ival : sum += ival;
+                            }
+                            timg += tmpstride + done;
+                            ttmp += done;
                         }
-                        timg += tmpstride;
                     }
                     sum /= tmppixcount;
 
@@ -1113,21 +1113,21 @@ void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char*
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char* tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char* tmp, int x, int y, int* map)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
+    const unsigned int tmpwidth = tmpheight * 3;
     const unsigned int tmppixcount = tmpheight * tmpheight;
-    const unsigned int tmpstride = imgstride - tmpheight * 3;
+    const unsigned int tmpstride = imgstride - tmpwidth;
     const unsigned int winsize = SearchRadius * 2 + 1;
     const unsigned int imgwinstride = imgstride - winsize * 3;
     const int imgwidth = static_cast<int>(Width);
     const int imgheight = static_cast<int>(Height);
 
     int k, l, sum, ival, hfrom, vfrom;
-    int* map = MatchMap.Pointer();
     unsigned char *timg, *ttmp;
-    unsigned int i, j, v, h;
+    unsigned int i, j, v, h, done;
 
     if (x < static_cast<int>(TemplateRadius)) x = TemplateRadius;
     else if (x >= static_cast<int>(Width - TemplateRadius)) x = Width - TemplateRadius - 1;
@@ -1148,18 +1148,18 @@ void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char*
                 if (k >= 0 && k < imgwidth) {
 
                     // match in current position
-                    timg = img; ttmp = tmp;
                     sum = 0;
-                    for (j = 0; j < tmpheight; j ++) {
-                        for (i = 0; i < tmpheight; i ++) {
-                            ival = (static_cast<int>(*timg) - *ttmp); timg ++; ttmp ++;
-                            sum += ival * ival;
-                            ival = (static_cast<int>(*timg) - *ttmp); timg ++; ttmp ++;
-                            sum += ival * ival;
-                            ival = (static_cast<int>(*timg) - *ttmp); timg ++; ttmp ++;
-                            sum += ival * ival;
+                    done = svlConvolutionSIMD::SqDiffRows(img, imgstride, tmp, tmpwidth, tmpwidth, tmpheight, sum);
+                    if (done < tmpwidth) {
+                        timg = img + done; ttmp = tmp + done;
+                        for (j = 0; j < tmpheight; j ++) {
+                            for (i = done; i < tmpwidth; i ++) {
+                                ival = (static_cast<int>(*timg) - *ttmp); timg ++; ttmp ++;
+                                sum += ival * ival;
+                            }
+                            timg += tmpstride + done;
+                            ttmp += done;
                         }
-                        timg += tmpstride;
                     }
                     sum /= tmppixcount;
 
@@ -1192,7 +1192,7 @@ void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char*
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char* tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char* tmp, short* zero_mean_tmp, int x, int y, int* map)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
@@ -1210,8 +1210,9 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
     int mi1, mi2, mi3, mt1, mt2, mt3;
     int di1, di2, di3, dt1, dt2, dt3;
     int di, dt, cr1, cr2, cr3;
-    int* map = MatchMap.Pointer();
+    int st[3], si[3], sq[3], cr[3], c, done;
     unsigned char *timg, *ttmp;
+    short *zm_tmp;
     unsigned int v, h;
 
     hfrom = x - TemplateRadius - SearchRadius;
@@ -1237,12 +1238,14 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
     mt1 /= tmppixcount; mt2 /= tmppixcount; mt3 /= tmppixcount;
 
     // Compute template standard deviations
-    ttmp = tmp; dt1 = dt2 = dt3 = 0;
+    // The zero mean template and its sums are used on full size windows
+    ttmp = tmp; zm_tmp = zero_mean_tmp; dt1 = dt2 = dt3 = 0;
+    st[0] = st[1] = st[2] = 0;
     for (j = tmpyfrom; j < tmpyto; j ++) {
         for (i = tmpxfrom; i < tmpxto; i ++) {
-            dt = static_cast<int>(*ttmp) - mt1; dt1 += dt * dt; ttmp ++;
-            dt = static_cast<int>(*ttmp) - mt2; dt2 += dt * dt; ttmp ++;
-            dt = static_cast<int>(*ttmp) - mt3; dt3 += dt * dt; ttmp ++;
+            dt = static_cast<int>(*ttmp) - mt1; dt1 += dt * dt; ttmp ++; *zm_tmp = dt; zm_tmp ++; st[0] += dt;
+            dt = static_cast<int>(*ttmp) - mt2; dt2 += dt * dt; ttmp ++; *zm_tmp = dt; zm_tmp ++; st[1] += dt;
+            dt = static_cast<int>(*ttmp) - mt3; dt3 += dt * dt; ttmp ++; *zm_tmp = dt; zm_tmp ++; st[2] += dt;
         }
     }
     dt1 = sqrt_uint32(dt1); dt2 = sqrt_uint32(dt2); dt3 = sqrt_uint32(dt3);
@@ -1298,37 +1301,76 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
                     xoffs *= 3;
                     ioffs = yoffs * imgstride + xoffs;
 
-                    // Compute image means
-                    timg = img + ioffs;
-                    mi1 = mi2 = mi3 = 0;
-                    for (j = tmpyfrom; j <= tmpyto; j ++) {
-                        for (i = tmpxfrom; i <= tmpxto; i ++) {
-                            mi1 += *timg; timg ++;
-                            mi2 += *timg; timg ++;
-                            mi3 += *timg; timg ++;
+                    if (tmppixcount == static_cast<int>(tmpheight * tmpheight)) {
+                        // Full size window: with the window sums S(i), S(i^2), and S(i*(t-mt))
+                        //     S((i-mi)^2)       = S(i^2) - 2*mi*S(i) + n*mi^2
+                        //     S((i-mi)*(t-mt))  = S(i*(t-mt)) - mi*S(t-mt)
+                        // which gives the same results as the direct computation below
+                        si[0] = si[1] = si[2] = 0;
+                        sq[0] = sq[1] = sq[2] = 0;
+                        cr[0] = cr[1] = cr[2] = 0;
+                        done = static_cast<int>(svlConvolutionSIMD::SumRowsRGB(img, imgstride, tmpwidth, tmpheight, si, sq));
+                        if (done != static_cast<int>(svlConvolutionSIMD::CorrelateRowsRGB(img, imgstride, zero_mean_tmp, tmpwidth, tmpwidth, tmpheight, cr))) {
+                            si[0] = si[1] = si[2] = sq[0] = sq[1] = sq[2] = cr[0] = cr[1] = cr[2] = 0;
+                            done = 0;
+                        }
+                        if (done < static_cast<int>(tmpwidth)) {
+                            timg = img + done;
+                            zm_tmp = zero_mean_tmp + done;
+                            for (j = 0; j < static_cast<int>(tmpheight); j ++) {
+                                for (i = done, c = done % 3; i < static_cast<int>(tmpwidth); i ++) {
+                                    di = *timg; timg ++;
+                                    si[c] += di;
+                                    sq[c] += di * di;
+                                    cr[c] += di * (*zm_tmp); zm_tmp ++;
+                                    if (++ c == 3) c = 0;
+                                }
+                                timg += imgstride - tmpwidth + done;
+                                zm_tmp += done;
+                            }
                         }
-                        timg += tmpstride;
-                    }
-                    mi1 /= tmppixcount; mi2 /= tmppixcount; mi3 /= tmppixcount;
 
-                    // Compute image standard deviations and correlations
-                    timg = img + ioffs;
-                    ttmp = tmp + yoffs * tmpwidth + xoffs;
-                    cr1 = cr2 = cr3 = 0;
-                    di1 = di2 = di3 = 0;
-                    for (j = tmpyfrom; j <= tmpyto; j ++) {
-                        for (i = tmpxfrom; i <= tmpxto; i ++) {
-                            di = static_cast<int>(*timg) - mi1; di1 += di * di; timg ++;
-                            dt = static_cast<int>(*ttmp) - mt1;                 ttmp ++;
-                            cr1 += di * dt;
-                            di = static_cast<int>(*timg) - mi2; di2 += di * di; timg ++;
-                            dt = static_cast<int>(*ttmp) - mt2;                 ttmp ++;
-                            cr2 += di * dt;
-                            di = static_cast<int>(*timg) - mi3; di3 += di * di; timg ++;
-                            dt = static_cast<int>(*ttmp) - mt3;                 ttmp ++;
-                            cr3 += di * dt;
+                        mi1 = si[0] / tmppixcount; mi2 = si[1] / tmppixcount; mi3 = si[2] / tmppixcount;
+                        di1 = sq[0] - 2 * mi1 * si[0] + tmppixcount * mi1 * mi1;
+                        di2 = sq[1] - 2 * mi2 * si[1] + tmppixcount * mi2 * mi2;
+                        di3 = sq[2] - 2 * mi3 * si[2] + tmppixcount * mi3 * mi3;
+                        cr1 = cr[0] - mi1 * st[0];
+                        cr2 = cr[1] - mi2 * st[1];
+                        cr3 = cr[2] - mi3 * st[2];
+                    }
+                    else {
+                        // Compute image means
+                        timg = img + ioffs;
+                        mi1 = mi2 = mi3 = 0;
+                        for (j = tmpyfrom; j <= tmpyto; j ++) {
+                            for (i = tmpxfrom; i <= tmpxto; i ++) {
+                                mi1 += *timg; timg ++;
+                                mi2 += *timg; timg ++;
+                                mi3 += *timg; timg ++;
+                            }
+                            timg += tmpstride;
+                        }
+                        mi1 /= tmppixcount; mi2 /= tmppixcount; mi3 /= tmppixcount;
+
+                        // Compute image standard deviations and correlations
+                        timg = img + ioffs;
+                        ttmp = tmp + yoffs * tmpwidth + xoffs;
+                        cr1 = cr2 = cr3 = 0;
+                        di1 = di2 = di3 = 0;
+                        for (j = tmpyfrom; j <= tmpyto; j ++) {
+                            for (i = tmpxfrom; i <= tmpxto; i ++) {
+                                di = static_cast<int>(*timg) - mi1; di1 += di * di; timg ++;
+                                dt = static_cast<int>(*ttmp) - mt1;                 ttmp ++;
+                                cr1 += di * dt;
+                                di = static_cast<int>(*timg) - mi2; di2 += di * di; timg ++;
+                                dt = static_cast<int>(*ttmp) - mt2;                 ttmp ++;
+                                cr2 += di * dt;
+                                di = static_cast<int>(*timg) - mi3; di3 += di * di; timg ++;
+                                dt = static_cast<int>(*ttmp) - mt3;                 ttmp ++;
+                                cr3 += di * dt;
+                            }
+                            timg += tmpstride;
                         }
-                        timg += tmpstride;
                     }
                     di1 = sqrt_uint32(di1); di2 = sqrt_uint32(di2); di3 = sqrt_uint32(di3);
 
@@ -1365,7 +1407,7 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned char* tmp, int* zero_mean_tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned char* tmp, short* zero_mean_tmp, int x, int y, int* map)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
@@ -1389,8 +1431,8 @@ void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned c
     int xoffs, yoffs, ioffs;
     int mt1, mt2, mt3;
     int di1, di2, di3, dis1, dis2, dis3, dt1, dt2, dt3;
-    int dt, cr1, cr2, cr3;
-    int *zm_tmp, *map = MatchMap.Pointer();
+    int dt, cr1, cr2, cr3, cr[3], c, done;
+    short *zm_tmp;
     unsigned char *timg, *ttmp;
     unsigned int v, h, off1, off2, off3, off4;
 
@@ -1496,16 +1538,21 @@ void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned c
                     // Compute image standard deviations and correlations
                     timg = img + ioffs;
                     zm_tmp = zero_mean_tmp + yoffs * tmpwidth + xoffs;
-                    cr1 = cr2 = cr3 = 0;
-                    for (j = tmpyfrom; j <= tmpyto; j ++) {
-                        for (i = tmpxfrom; i <= tmpxto; i ++) {
-                            cr1 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
-                            cr2 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
-                            cr3 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
+                    cr[0] = cr[1] = cr[2] = 0;
+                    done = static_cast<int>(svlConvolutionSIMD::CorrelateRowsRGB(timg, imgstride, zm_tmp, tmpwidth, tmpcolcount3, tmprowcount, cr));
+                    if (done < tmpcolcount3) {
+                        timg += done;
+                        zm_tmp += done;
+                        for (j = tmpyfrom; j <= tmpyto; j ++) {
+                            for (i = done, c = done % 3; i < tmpcolcount3; i ++) {
+                                cr[c] += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
+                                if (++ c == 3) c = 0;
+                            }
+                            timg += tmpstride + done;
+                            zm_tmp += tmpwidth - tmpcolcount3 + done;
                         }
-                        timg += tmpstride;
-                        zm_tmp += tmpwidth - tmpcolcount3;
                     }
+                    cr1 = cr[0]; cr2 = cr[1]; cr3 = cr[2];
 
                     // Compute image normalization denominator
                     off1 = (l_m1 + tmprowcount) * Width + k_m1 + tmpcolcount;
@@ -1580,7 +1627,7 @@ void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned c
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateNotQuiteNCC(unsigned char* img, unsigned char* tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateNotQuiteNCC(unsigned char* img, unsigned char* tmp, int x, int y, int* map)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
@@ -1597,7 +1644,6 @@ void svlTrackerMSBruteForce::MatchTemplateNotQuiteNCC(unsigned char* img, unsign
     int xoffs, yoffs, ioffs;
     int di1, di2, di3, dt1, dt2, dt3;
     int di, dt, cr1, cr2, cr3;
-    int* map = MatchMap.Pointer();
     unsigned char *timg, *ttmp;
     unsigned int v, h;
 
@@ -1728,12 +1774,11 @@ void svlTrackerMSBruteForce::MatchTemplateNotQuiteNCC(unsigned char* img, unsign
     }
 }
 
-void svlTrackerMSBruteForce::GetBestMatch(int &x, int &y, unsigned char &conf, bool higherbetter)
+void svlTrackerMSBruteForce::GetBestMatch(int &x, int &y, unsigned char &conf, bool higherbetter, const int* map)
 {
     const int size = SearchRadius * 2 + 1;
     const int size2 = size * size;
     int i, j, t, avrg, best, best_x = 0, best_y = 0;
-    int* map = MatchMap.Pointer();
 
     // Compute average match and best match
     avrg = 0;
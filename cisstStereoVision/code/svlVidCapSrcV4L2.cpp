@@ -32,6 +32,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <errno.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <sys/select.h>
 #include <linux/types.h>
 #include <linux/videodev2.h>
 
@@ -44,6 +45,7 @@ using namespace std;
 #define MV4LP_METHOD_READ           1
 #define MV4LP_BUFFER_SIZE_TARGET    2
 #define MV4LP_MIN_BUFFER_SIZE       2
+#define MV4LP_STREAMING_BUFFERS     4
 #define MV4LP_FRAME_TIMEOUT         100
 #define MV4LP_CS_UNKNOWN            -1
 #define MV4LP_CS_BGR24              0
@@ -71,11 +73,13 @@ svlVidCapSrcV4L2::svlVidCapSrcV4L2() :
 	CapStride(0),
 	CapWidth(0),
 	CapHeight(0),
+	LineLength(0),
 	DeviceHandle(0),
 	CapMethod(0),
 	ColorSpace(0),
 	FrameBufferSize(0),
     FrameBuffer(0),
+    ConvBuffer(0),
     OutputBuffer(0),
     Format(0)
 {
@@ -106,11 +110,13 @@ int svlVidCapSrcV4L2::SetStreamCount(unsigned int numofstreams)
     CapStride = new int[NumOfStreams];
     CapWidth = new int[NumOfStreams];
     CapHeight = new int[NumOfStreams];
+    LineLength = new int[NumOfStreams];
     DeviceHandle = new int[NumOfStreams];
     CapMethod = new int[NumOfStreams];
     ColorSpace = new int[NumOfStreams];
     FrameBufferSize = new int[NumOfStreams];
     FrameBuffer = new FrameBufferType*[NumOfStreams];
+    ConvBuffer = new unsigned char*[NumOfStreams];
     OutputBuffer = new svlBufferImage*[NumOfStreams];
     Format = new svlFilterSourceVideoCapture::ImageFormat*[NumOfStreams];
 
@@ -122,11 +128,13 @@ int svlVidCapSrcV4L2::SetStreamCount(unsigned int numofstreams)
         CapStride[i] = 0;
         CapWidth[i] = 0;
         CapHeight[i] = 0;
+        LineLength[i] = 0;
         DeviceHandle[i] = -1;
         CapMethod[i] = 0;
         ColorSpace[i] = 0;
         FrameBufferSize[i] = 0;
         FrameBuffer[i] = 0;
+        ConvBuffer[i] = 0;
         OutputBuffer[i] = 0;
         Format[i] = 0;
     }
@@ -179,12 +187,9 @@ int svlVidCapSrcV4L2::GetDeviceList(svlFilterSourceVideoCapture::DeviceInfo **de
             // Getting device properties
             if (ioctl(fd, VIDIOC_QUERYCAP, &devprops) == 0) {
 
-                if ((devprops.capabilities & V4L2_CAP_STREAMING) != 0) {
-                    // streaming source
-                }
-
+                // Both streaming (memory mapped) and read/write I/O are supported
                 if ((devprops.capabilities & V4L2_CAP_VIDEO_CAPTURE) != 0 &&
-                    (devprops.capabilities & V4L2_CAP_READWRITE) != 0) {
+                    (devprops.capabilities & (V4L2_CAP_STREAMING | V4L2_CAP_READWRITE)) != 0) {
 
                     // platform
                     tempinfo[counter].platform = svlFilterSourceVideoCaptureTypes::LinVideo4Linux2;
@@ -246,7 +251,6 @@ int svlVidCapSrcV4L2::Open()
 
     Close();
     
-    int j;
     unsigned int i;
     v4l2_capability devprops;
     v4l2_std_id standard;
@@ -274,14 +278,15 @@ int svlVidCapSrcV4L2::Open()
             CMN_LOG_CLASS_INIT_ERROR << "Open: failed to get ioctl VIDIOC_QUERYCAP" << std::endl;
             goto labError;
         }
+        /// Prefer Streaming method when available: frames are captured into memory
+        /// mapped driver buffers and converted from there in a single pass
         if ((devprops.capabilities & V4L2_CAP_STREAMING) != 0) {
             CapMethod[i] = MV4LP_METHOD_STREAMING;
 #ifdef __verbose__
             cout << "-Open: QUERYCAP done - Streaming method selected" << endl;
 #endif
         }
-        /// Prefer Read method when available
-        if ((devprops.capabilities & V4L2_CAP_READWRITE) != 0){
+        else if ((devprops.capabilities & V4L2_CAP_READWRITE) != 0){
             CapMethod[i] = MV4LP_METHOD_READ;
 #ifdef __verbose__
             cout << "-Open: QUERYCAP done - Read method selected" << endl;
@@ -382,6 +387,7 @@ int svlVidCapSrcV4L2::Open()
 
         // Stride
         CapStride[i] = format.fmt.pix.width * 3;
+        LineLength[i] = format.fmt.pix.bytesperline;
 
 #ifdef __verbose__
         cout << "-Open: Image properties: " << CapWidth[i] << "*" << CapHeight[i];
@@ -422,81 +428,16 @@ int svlVidCapSrcV4L2::Open()
             goto labError;
         }
 
-        if (CapMethod[i] == MV4LP_METHOD_STREAMING) {
-            // Streaming I/O
-            // Not yet supported, works for Hauppauge cards, but not XtremeRGB cards
-            //goto labError;
-///*
-            struct v4l2_requestbuffers reqbuff;
-
-            // Requesting buffer
-            memset(&reqbuff, 0, sizeof(v4l2_requestbuffers));
-            reqbuff.count = MV4LP_BUFFER_SIZE_TARGET;
-            reqbuff.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-            reqbuff.memory = V4L2_MEMORY_MMAP;
-            if (ioctl(DeviceHandle[i], VIDIOC_REQBUFS, &reqbuff) != 0) {
-                CMN_LOG_CLASS_INIT_ERROR << "Open: failed to set ioctl VIDIOC_REQBUFS" << std::endl;
-                goto labError;
-            }
-            // Buffer count may be overridden by the driver
-            if (reqbuff.count < MV4LP_MIN_BUFFER_SIZE) {
-                CMN_LOG_CLASS_INIT_ERROR << "Open: invalid required buffer count" << std::endl;
+        if (CapMethod[i] == MV4LP_METHOD_STREAMING && InitStreamingBuffers(i) != SVL_OK) {
+            ReleaseFrameBuffers(i);
+            if ((devprops.capabilities & V4L2_CAP_READWRITE) == 0) {
+                CMN_LOG_CLASS_INIT_ERROR << "Open: failed to set up streaming buffers" << std::endl;
                 goto labError;
             }
-            FrameBufferSize[i] = reqbuff.count;
-#ifdef __verbose__
-            cout << "-Open: buffers requested" << endl;
-#endif
-
-            // Query buffers
-            FrameBuffer[i] = new FrameBufferType[FrameBufferSize[i]];
-            memset(FrameBuffer[i], 0, FrameBufferSize[i] * sizeof(FrameBufferType));
-
-            for (j = 0; j < FrameBufferSize[i]; j++) {
-                struct v4l2_buffer buffer;
-
-                memset(&buffer, 0, sizeof(v4l2_buffer));
-
-                buffer.index       = j;
-                buffer.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                buffer.memory      = V4L2_MEMORY_MMAP;
-
-                if (ioctl(DeviceHandle[i], VIDIOC_QUERYBUF, &buffer) != 0) {
-                    CMN_LOG_CLASS_INIT_ERROR << "Open: failed to set ioctl VIDIOC_QUERYBUF" << std::endl;
-                    goto labError;
-                }
-
-                FrameBuffer[i][j].length = buffer.length;
-                FrameBuffer[i][j].start = mmap(0,                       // start anywhere
-                                               buffer.length,
-                                               PROT_READ | PROT_WRITE,  // required
-                                               MAP_SHARED,              // recommended
-                                               DeviceHandle[i],
-                                               buffer.m.offset);
-
-                if (FrameBuffer[i][j].start == MAP_FAILED) {
-                    CMN_LOG_CLASS_INIT_ERROR << "Open: frame buffer start failed" << std::endl;
-                    goto labError;
-                }
-#ifdef __verbose__
-                cout << "--Open: buffer " << j << " parameters received" << endl;
-#endif
-            }
-//*/
-        }
-        else {
-            // Read/write I/O
-            FrameBufferSize[i] = MV4LP_BUFFER_SIZE_TARGET;
-            FrameBuffer[i] = new FrameBufferType[FrameBufferSize[i]];
-            memset(FrameBuffer[i], 0, FrameBufferSize[i] * sizeof(FrameBufferType));
-            for (j = 0; j < FrameBufferSize[i]; j++) {
-                FrameBuffer[i][j].length = CapHeight[i] * CapStride[i];
-                FrameBuffer[i][j].start = new unsigned char[FrameBuffer[i][j].length];
-            }
-#ifdef __verbose__
-            cout << "-Open: frame buffers allocated" << endl;
-#endif
+            // Fall back to Read method
+            CapMethod[i] = MV4LP_METHOD_READ;
         }
+        if (CapMethod[i] == MV4LP_METHOD_READ) InitReadBuffers(i);
 
         // allocate output buffers
         OutputBuffer[i] = new svlBufferImage(CapWidth[i], CapHeight[i]);
@@ -516,30 +457,20 @@ void svlVidCapSrcV4L2::Close()
 
     Stop();
 
-    int j;
     unsigned int i;
 
     Initialized = false;
 
     for (i = 0; i < NumOfStreams; i ++) {
 
+        // Driver buffers are released through the device handle
+        ReleaseFrameBuffers(i);
+
         if (DeviceHandle[i] >= 0) {
             close(DeviceHandle[i]);
             DeviceHandle[i] = -1;
         }
 
-        if (FrameBuffer[i]) {
-			for (j = 0; j < FrameBufferSize[i]; j++) {
-                if (CapMethod[i] == MV4LP_METHOD_STREAMING) {
-                    munmap(FrameBuffer[i][j].start, FrameBuffer[i][j].length);
-                } else {
-					delete [] reinterpret_cast<unsigned char*>(FrameBuffer[i][j].start);
-                }
-			}
-            delete [] FrameBuffer[i];
-            FrameBuffer[i] = 0;
-        }
-
         // release output buffers
         if (OutputBuffer[i]) delete OutputBuffer[i];
         OutputBuffer[i] = 0;
@@ -557,6 +488,13 @@ int svlVidCapSrcV4L2::Start()
         if (DeviceHandle[i] < 0) return SVL_FAIL;
     }
 
+    for (i = 0; i < NumOfStreams; i ++) {
+        if (CapMethod[i] == MV4LP_METHOD_STREAMING && StartStreaming(i) != SVL_OK) {
+            Stop();
+            return SVL_FAIL;
+        }
+    }
+
     Running = true;
     for (i = 0; i < NumOfStreams; i ++) {
         CaptureProc[i] = new svlVidCapSrcV4L2Thread(i);
@@ -597,6 +535,7 @@ int svlVidCapSrcV4L2::Stop()
             delete(CaptureProc[i]);
             CaptureProc[i] = 0;
         }
+        if (CapMethod[i] == MV4LP_METHOD_STREAMING) StopStreaming(i);
     }
 
     return SVL_OK;
@@ -845,6 +784,8 @@ int svlVidCapSrcV4L2::ReadFrame(unsigned int videoch)
     }
     if (imbuf == NULL) return SVL_FAIL;
 
+    if (CapMethod[videoch] == MV4LP_METHOD_STREAMING) return ReadStreamingFrame(videoch, imbuf);
+
     const int w = CapWidth[videoch];
     const int h = CapHeight[videoch];
     const int stride = CapStride[videoch];
@@ -906,36 +847,271 @@ int svlVidCapSrcV4L2::ReadFrame(unsigned int videoch)
             }
         }
 
-        if (ColorSpace[videoch] == MV4LP_CS_UYVY) {
-            // Convert UYVY to BGR24
-            YUV420p_to_BGR24(imbuf, buf1, line, ystride, w, h);
+        ConvertFrame(videoch, buf1, imbuf, reinterpret_cast<unsigned char*>(FrameBuffer[videoch][1].start));
+    }
+
+    // Add image to the output buffer
+    OutputBuffer[videoch]->Push();
+
+	return error;
+}
+
+
+int svlVidCapSrcV4L2::ReadStreamingFrame(unsigned int videoch, unsigned char* imbuf)
+{
+    const int handle = DeviceHandle[videoch];
+
+    // Wait for a filled buffer; the timeout lets the capture thread notice Stop()
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(handle, &fds);
+    timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = MV4LP_FRAME_TIMEOUT * 1000;
+
+    int ret = select(handle + 1, &fds, 0, 0, &timeout);
+    if (ret == 0 || (ret < 0 && errno == EINTR)) return SVL_OK;
+    if (ret < 0) return SVL_FAIL;
+
+    v4l2_buffer buffer;
+    memset(&buffer, 0, sizeof(v4l2_buffer));
+    buffer.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+    if (ioctl(handle, VIDIOC_DQBUF, &buffer) != 0) {
+        if (errno == EAGAIN) return SVL_OK;
+#ifdef __verbose__
+        cout << "Capture failed [" << videoch << "]" << endl;
+#endif
+        return SVL_FAIL;
+    }
+    if (static_cast<int>(buffer.index) >= FrameBufferSize[videoch]) return SVL_FAIL;
+
+    // The only copy of the frame: converted from the driver's buffer
+    // straight into the output buffer
+    ConvertFrame(videoch, reinterpret_cast<unsigned char*>(FrameBuffer[videoch][buffer.index].start), imbuf, ConvBuffer[videoch]);
+
+    // Hand the buffer back to the driver right away
+    // so that capturing never runs out of buffers
+    if (ioctl(handle, VIDIOC_QBUF, &buffer) != 0) return SVL_FAIL;
+
+#ifdef __verbose__
+    cout << "Frame captured [" << videoch << "]" << endl;
+#endif
+
+    // Add image to the output buffer
+    OutputBuffer[videoch]->Push();
+
+    return SVL_OK;
+}
+
+void svlVidCapSrcV4L2::ConvertFrame(unsigned int videoch, unsigned char* src, unsigned char* dst, unsigned char* tmp)
+{
+    const int w = CapWidth[videoch];
+    const int h = CapHeight[videoch];
+    const int line = w * 3;
+    const int ystride = CapStride[videoch] / 3;
+    int j;
+
+    if (ColorSpace[videoch] == MV4LP_CS_BGR24) {
+        const int srcline = (LineLength[videoch] > line) ? LineLength[videoch] : line;
+        if (srcline == line) {
+            memcpy(dst, src, line * h);
         }
-        if (ColorSpace[videoch] == MV4LP_CS_YUYV) {
-            // Convert YUYV to BGR24
-            svlConverter::YUV422toRGB24(buf1, imbuf, w*h, true, true, true);
+        else {
+            for (j = 0; j < h; j ++) {
+                memcpy(dst, src, line);
+                dst += line;
+                src += srcline;
+            }
+        }
+    }
+    else if (ColorSpace[videoch] == MV4LP_CS_YUYV) {
+        // Convert YUYV to BGR24 (16 bpp, rows may be padded)
+        const int srcline = (LineLength[videoch] > w * 2) ? LineLength[videoch] : w * 2;
+        if (srcline == w * 2) {
+            svlConverter::YUV422toRGB24(src, dst, w * h, true, true, true);
         }
         else {
-            // Rescramble HM12 to UYVY
-            unsigned char *buf2 = reinterpret_cast<unsigned char*>(FrameBuffer[videoch][1].start);
-            int planesize = ystride * h;
-
-            HM12_de_macro_y(buf2, buf1, ystride, ystride, h);
-            HM12_de_macro_uv(buf2 + planesize,
-                             buf2 + planesize + planesize / 4,
-                             buf1 + planesize,
-                             ystride / 2,
-                             ystride / 2,
-                             h / 2);
-
-            // Convert UYVY to BGR24
-            YUV420p_to_BGR24(imbuf, buf2, line, ystride, w, h);
+            for (j = 0; j < h; j ++) {
+                svlConverter::YUV422toRGB24(src, dst, w, true, true, true);
+                dst += line;
+                src += srcline;
+            }
         }
     }
+    else if (ColorSpace[videoch] == MV4LP_CS_UYVY) {
+        // Convert UYVY to BGR24
+        YUV420p_to_BGR24(dst, src, line, ystride, w, h);
+    }
+    else if (tmp) {
+        // Rescramble HM12 to UYVY
+        int planesize = ystride * h;
+
+        HM12_de_macro_y(tmp, src, ystride, ystride, h);
+        HM12_de_macro_uv(tmp + planesize,
+                         tmp + planesize + planesize / 4,
+                         src + planesize,
+                         ystride / 2,
+                         ystride / 2,
+                         h / 2);
+
+        // Convert UYVY to BGR24
+        YUV420p_to_BGR24(dst, tmp, line, ystride, w, h);
+    }
+}
 
-    // Add image to the output buffer
-    OutputBuffer[videoch]->Push();
+int svlVidCapSrcV4L2::InitStreamingBuffers(unsigned int videoch)
+{
+    const int handle = DeviceHandle[videoch];
+    struct v4l2_requestbuffers reqbuff;
+    int j;
 
-	return error;
+    // Requesting buffers
+    memset(&reqbuff, 0, sizeof(v4l2_requestbuffers));
+    reqbuff.count = MV4LP_STREAMING_BUFFERS;
+    reqbuff.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    reqbuff.memory = V4L2_MEMORY_MMAP;
+    if (ioctl(handle, VIDIOC_REQBUFS, &reqbuff) != 0) {
+        CMN_LOG_CLASS_INIT_WARNING << "InitStreamingBuffers: failed to set ioctl VIDIOC_REQBUFS" << std::endl;
+        return SVL_FAIL;
+    }
+    // Buffer count may be overridden by the driver
+    if (reqbuff.count < MV4LP_MIN_BUFFER_SIZE) {
+        CMN_LOG_CLASS_INIT_WARNING << "InitStreamingBuffers: invalid required buffer count" << std::endl;
+        return SVL_FAIL;
+    }
+    FrameBufferSize[videoch] = reqbuff.count;
+#ifdef __verbose__
+    cout << "-Open: buffers requested" << endl;
+#endif
+
+    // Query buffers
+    FrameBuffer[videoch] = new FrameBufferType[FrameBufferSize[videoch]];
+    for (j = 0; j < FrameBufferSize[videoch]; j++) {
+        FrameBuffer[videoch][j].start = MAP_FAILED;
+        FrameBuffer[videoch][j].length = 0;
+    }
+
+    for (j = 0; j < FrameBufferSize[videoch]; j++) {
+        struct v4l2_buffer buffer;
+
+        memset(&buffer, 0, sizeof(v4l2_buffer));
+
+        buffer.index       = j;
+        buffer.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory      = V4L2_MEMORY_MMAP;
+
+        if (ioctl(handle, VIDIOC_QUERYBUF, &buffer) != 0) {
+            CMN_LOG_CLASS_INIT_WARNING << "InitStreamingBuffers: failed to set ioctl VIDIOC_QUERYBUF" << std::endl;
+            return SVL_FAIL;
+        }
+
+        FrameBuffer[videoch][j].length = buffer.length;
+        FrameBuffer[videoch][j].start = mmap(0,                       // start anywhere
+                                             buffer.length,
+                                             PROT_READ | PROT_WRITE,  // required
+                                             MAP_SHARED,              // recommended
+                                             handle,
+                                             buffer.m.offset);
+
+        if (FrameBuffer[videoch][j].start == MAP_FAILED) {
+            CMN_LOG_CLASS_INIT_WARNING << "InitStreamingBuffers: frame buffer start failed" << std::endl;
+            return SVL_FAIL;
+        }
+#ifdef __verbose__
+        cout << "--Open: buffer " << j << " parameters received" << endl;
+#endif
+    }
+
+    // Driver buffers stay queued while capturing, so HM12 needs its own work buffer
+    if (ColorSpace[videoch] == MV4LP_CS_HM12) {
+        ConvBuffer[videoch] = new unsigned char[CapHeight[videoch] * CapStride[videoch]];
+    }
+
+    return SVL_OK;
+}
+
+int svlVidCapSrcV4L2::InitReadBuffers(unsigned int videoch)
+{
+    FrameBufferSize[videoch] = MV4LP_BUFFER_SIZE_TARGET;
+    FrameBuffer[videoch] = new FrameBufferType[FrameBufferSize[videoch]];
+    memset(FrameBuffer[videoch], 0, FrameBufferSize[videoch] * sizeof(FrameBufferType));
+    for (int j = 0; j < FrameBufferSize[videoch]; j++) {
+        FrameBuffer[videoch][j].length = CapHeight[videoch] * CapStride[videoch];
+        FrameBuffer[videoch][j].start = new unsigned char[FrameBuffer[videoch][j].length];
+    }
+#ifdef __verbose__
+    cout << "-Open: frame buffers allocated" << endl;
+#endif
+
+    return SVL_OK;
+}
+
+void svlVidCapSrcV4L2::ReleaseFrameBuffers(unsigned int videoch)
+{
+    if (FrameBuffer[videoch]) {
+        for (int j = 0; j < FrameBufferSize[videoch]; j++) {
+            if (CapMethod[videoch] == MV4LP_METHOD_STREAMING) {
+                if (FrameBuffer[videoch][j].start != MAP_FAILED) {
+                    munmap(FrameBuffer[videoch][j].start, FrameBuffer[videoch][j].length);
+                }
+            } else {
+                delete [] reinterpret_cast<unsigned char*>(FrameBuffer[videoch][j].start);
+            }
+        }
+        delete [] FrameBuffer[videoch];
+        FrameBuffer[videoch] = 0;
+
+        if (CapMethod[videoch] == MV4LP_METHOD_STREAMING && DeviceHandle[videoch] >= 0) {
+            // Free the driver's buffers
+            struct v4l2_requestbuffers reqbuff;
+            memset(&reqbuff, 0, sizeof(v4l2_requestbuffers));
+            reqbuff.count = 0;
+            reqbuff.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            reqbuff.memory = V4L2_MEMORY_MMAP;
+            ioctl(DeviceHandle[videoch], VIDIOC_REQBUFS, &reqbuff);
+        }
+    }
+    FrameBufferSize[videoch] = 0;
+
+    if (ConvBuffer[videoch]) delete [] ConvBuffer[videoch];
+    ConvBuffer[videoch] = 0;
+}
+
+int svlVidCapSrcV4L2::StartStreaming(unsigned int videoch)
+{
+    const int handle = DeviceHandle[videoch];
+    if (handle < 0 || FrameBuffer[videoch] == 0) return SVL_FAIL;
+
+    // Queue all buffers for capture
+    for (int j = 0; j < FrameBufferSize[videoch]; j++) {
+        v4l2_buffer buffer;
+        memset(&buffer, 0, sizeof(v4l2_buffer));
+        buffer.index  = j;
+        buffer.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        if (ioctl(handle, VIDIOC_QBUF, &buffer) != 0) {
+            CMN_LOG_CLASS_INIT_ERROR << "StartStreaming: failed to set ioctl VIDIOC_QBUF" << std::endl;
+            return SVL_FAIL;
+        }
+    }
+
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (ioctl(handle, VIDIOC_STREAMON, &type) != 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "StartStreaming: failed to set ioctl VIDIOC_STREAMON" << std::endl;
+        return SVL_FAIL;
+    }
+
+    return SVL_OK;
+}
+
+void svlVidCapSrcV4L2::StopStreaming(unsigned int videoch)
+{
+    if (DeviceHandle[videoch] < 0 || FrameBuffer[videoch] == 0) return;
+
+    // Also dequeues all buffers, so StartStreaming can queue them again
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    ioctl(DeviceHandle[videoch], VIDIOC_STREAMOFF, &type);
 }
 
 
@@ -950,11 +1126,13 @@ void svlVidCapSrcV4L2::Release()
     if (CapStride) delete [] CapStride;
     if (CapWidth) delete [] CapWidth;
     if (CapHeight) delete [] CapHeight;
+    if (LineLength) delete [] LineLength;
     if (DeviceHandle) delete [] DeviceHandle;
     if (CapMethod) delete [] CapMethod;
     if (ColorSpace) delete [] ColorSpace;
     if (FrameBufferSize) delete [] FrameBufferSize;
     if (FrameBuffer) delete [] FrameBuffer;
+    if (ConvBuffer) delete [] ConvBuffer;
     if (OutputBuffer) delete [] OutputBuffer;
 
     if (Format) {
@@ -974,11 +1152,13 @@ void svlVidCapSrcV4L2::Release()
 	CapStride = 0;
 	CapWidth = 0;
 	CapHeight = 0;
+	LineLength = 0;
 	DeviceHandle = 0;
 	CapMethod = 0;
 	ColorSpace = 0;
 	FrameBufferSize = 0;
     FrameBuffer = 0;
+    ConvBuffer = 0;
     OutputBuffer = 0;
 }
 
@@ -73,15 +73,25 @@ private:
     int* CapStride;
     int* CapWidth;
     int* CapHeight;
+    int* LineLength;
     int* DeviceHandle;
     int* CapMethod;
     int* ColorSpace;
     int* FrameBufferSize;
     FrameBufferType** FrameBuffer;
+    unsigned char** ConvBuffer;
     svlBufferImage** OutputBuffer;
     svlFilterSourceVideoCapture::ImageFormat** Format;
 
     int ReadFrame(unsigned int videoch);
+    int ReadStreamingFrame(unsigned int videoch, unsigned char* imbuf);
+    void ConvertFrame(unsigned int videoch, unsigned char* src, unsigned char* dst, unsigned char* tmp);
+
+    int InitStreamingBuffers(unsigned int videoch);
+    int InitReadBuffers(unsigned int videoch);
+    void ReleaseFrameBuffers(unsigned int videoch);
+    int StartStreaming(unsigned int videoch);
+    void StopStreaming(unsigned int videoch);
 
     void Release();
     int GetDeviceInputs(int fd, svlFilterSourceVideoCapture::DeviceInfo *deviceinfo);
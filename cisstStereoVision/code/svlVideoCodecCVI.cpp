@@ -20,7 +20,9 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include "svlVideoCodecCVI.h"
+#include "svlCompressionLZ.h"
 #include <cisstCommon/cmnGetChar.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 #include <cisstStereoVision/svlConverters.h>
 #include <cisstStereoVision/svlSyncPoint.h>
 
@@ -36,10 +38,6 @@ CMN_IMPLEMENT_SERVICES_DERIVED(svlVideoCodecCVI, svlVideoCodecBase)
 svlVideoCodecCVI::svlVideoCodecCVI() :
     svlVideoCodecBase(),
     CodecName("CISST Video"),
-    FileStartMarker("CisstSVLVideo\r\n",  // all version strings shall be of equal length
-                    "CisstVid_1.10\r\n",
-                    "CisstVid_1.20\r\n",
-                    "CisstVid_1.30\r\n"),
     FrameStartMarker("\r\nFrame\r\n"),
     Version(-1),
     FooterOffset(0),
@@ -60,20 +58,48 @@ svlVideoCodecCVI::svlVideoCodecCVI() :
     comprBuffer(0),
     comprBufferSize(0),
     saveBufferSize(0),
+    SaveQueueLength(4),
+    SaveQueueHead(0),
+    SaveQueueCount(0),
+    NextFrameOffset(0),
     SaveThread(0),
     SaveInitEvent(0),
     NewFrameEvent(0),
-    WriteDoneEvent(0)
+    WriteDoneEvent(0),
+    CacheSize(12),
+    PrefetchAhead(4),
+    PrefetchBehind(2),
+    PrefetchThreadCount(2),
+    CacheUseCounter(0),
+    LastReadPos(-1),
+    PrefetchCenter(0),
+    PrefetchDirection(1),
+    PrefetchEvent(0),
+    FrameDecodedEvent(0),
+    KillPrefetchThreads(false),
+    CompressionStartTime(0.0),
+    CompressionTime(-1.0),
+    CompressionTimeSum(0.0),
+    CompressedFrames(0)
 {
     SetName("CISST Video Files");
     SetExtensionList(".cvi;");
     SetMultithreaded(true);
     SetVariableFramerate(true);
 
-    saveBuffer.SetAll(0);
+    // All version strings shall be of equal length
+    FileStartMarker[0] = "CisstSVLVideo\r\n";
+    FileStartMarker[1] = "CisstVid_1.10\r\n";
+    FileStartMarker[2] = "CisstVid_1.20\r\n";
+    FileStartMarker[3] = "CisstVid_1.30\r\n";
+    FileStartMarker[4] = "CisstVid_1.40\r\n";
+    FileStartMarker[5] = "CisstVid_1.50\r\n";
 
-    Config.Level        = 4;
-    Config.Differential = 0;
+    Config.Level         = 4;
+    Config.Differential  = DifferentialNone;
+    Config.Method        = MethodZLib;
+    Config.Parts         = 0;
+    Config.KeyFrameEvery = 30;
 
     ProcInfoSingleThread.count = 1;
     ProcInfoSingleThread.ID    = 0;
@@ -85,8 +111,7 @@ svlVideoCodecCVI::~svlVideoCodecCVI()
     if (prevYuvBuffer) delete [] prevYuvBuffer;
     if (yuvBuffer)     delete [] yuvBuffer;
     if (comprBuffer)   delete [] comprBuffer;
-    if (saveBuffer[0]) delete [] saveBuffer[0];
-    if (saveBuffer[1]) delete [] saveBuffer[1];
+    ReleaseSaveBuffers();
 }
 
 int svlVideoCodecCVI::Open(const std::string &filename, unsigned int &width, unsigned int &height, double &framerate)
@@ -125,6 +150,9 @@ int svlVideoCodecCVI::Open(const std::string &filename, unsigned int &width, uns
             break;
         }
 
+        Config.Differential = DifferentialNone;
+        Config.Method = MethodZLib;
+
         if (Version > 0) {
 
             if (Version > 2) {
@@ -134,6 +162,25 @@ int svlVideoCodecCVI::Open(const std::string &filename, unsigned int &width, uns
                     CMN_LOG_CLASS_INIT_ERROR << "Open: failed to read `differential flag`" << std::endl;
                     break;
                 }
+                // Tile coding was introduced in version 1.50
+                if (Config.Differential > DifferentialTiles ||
+                    (Config.Differential == DifferentialTiles && Version < 5)) {
+                    CMN_LOG_CLASS_INIT_ERROR << "Open: invalid `differential flag`" << std::endl;
+                    break;
+                }
+            }
+
+            if (Version > 3) {
+                // Read "compression method"
+                len = sizeof(unsigned char);
+                if (File.Read(reinterpret_cast<char*>(&(Config.Method)), len) != len) {
+                    CMN_LOG_CLASS_INIT_ERROR << "Open: failed to read `compression method`" << std::endl;
+                    break;
+                }
+                if (Config.Method != MethodZLib && Config.Method != MethodLZ) {
+                    CMN_LOG_CLASS_INIT_ERROR << "Open: invalid `compression method`" << std::endl;
+                    break;
+                }
             }
 
             // Read "footer offset"
@@ -233,7 +280,7 @@ int svlVideoCodecCVI::Open(const std::string &filename, unsigned int &width, uns
 
         DataOffset = File.GetPos();
 
-        if (Config.Differential) {
+        if (Config.Differential == DifferentialPixel) {
             // Allocate previous YUV buffer if not done yet
             size = Width * Height * 2;
             if (!prevYuvBuffer) {
@@ -247,8 +294,10 @@ int svlVideoCodecCVI::Open(const std::string &filename, unsigned int &width, uns
             }
         }
 
-        // Allocate YUV buffer if not done yet
-        size = Width * Height * 2;
+        // Allocate YUV buffer if not done yet; tile coded files need
+        // room for the packed tiles of delta frames too
+        if (Config.Differential == DifferentialTiles) size = svlTileDeltaCoder::GetPaddedSize(Width, Height) * 2;
+        else size = Width * Height * 2;
         if (!yuvBuffer) {
             yuvBuffer = new unsigned char[size];
             yuvBufferSize = size;
@@ -271,6 +320,15 @@ int svlVideoCodecCVI::Open(const std::string &filename, unsigned int &width, uns
             comprBufferSize = size;
         }
 
+        // Seekable files are played back from a memory mapping through
+        // the frame cache, with frames around the playback position
+        // decoded in advance; otherwise (or if the file cannot be mapped)
+        // frames are read sequentially
+        if (Version > 0 && !Config.Differential && FileMap.Open(filename) == SVL_OK) {
+            StartPrefetching();
+        }
+        TileCoder.Reset();
+
         Pos = BegPos = 0;
         width = Width;
         height = Height;
@@ -296,7 +354,7 @@ int svlVideoCodecCVI::Create(const std::string &filename, const unsigned int wid
         return SVL_FAIL;
     }
 
-    unsigned int size;
+    unsigned int size, pixels;
     long long int len;
 
     while (1) {
@@ -307,8 +365,9 @@ int svlVideoCodecCVI::Create(const std::string &filename, const unsigned int wid
             break;
         }
 
-        // Write "file start marker" (always writes the latest version)
-        Version = static_cast<int>(FileStartMarker.size()) - 1;
+        // Write "file start marker" (version 1.50 only for tile coded
+        // files, so that older readers can open all other files)
+        Version = (Config.Differential == DifferentialTiles) ? 5 : 4;
         len = FileStartMarker[Version].length();
         if (File.Write(FileStartMarker[Version].c_str(), len) != len) {
             CMN_LOG_CLASS_INIT_ERROR << "Create: failed to write `file start marker`" << std::endl;
@@ -322,6 +381,13 @@ int svlVideoCodecCVI::Create(const std::string &filename, const unsigned int wid
             break;
         }
 
+        // Write "compression method"
+        len = sizeof(unsigned char);
+        if (File.Write(reinterpret_cast<const char*>(&(Config.Method)), len) != len) {
+            CMN_LOG_CLASS_INIT_ERROR << "Create: failed to write `compression method`" << std::endl;
+            break;
+        }
+
         // Write "footer offset" placeholder (will be filled later)
         FooterOffset = 0;
         len = sizeof(long long int);
@@ -347,7 +413,7 @@ int svlVideoCodecCVI::Create(const std::string &filename, const unsigned int wid
             break;
         }
 
-        if (Config.Differential) {
+        if (Config.Differential == DifferentialPixel) {
             // Allocate previous YUV buffer if not done yet
             size = width * height * 2;
             if (!prevYuvBuffer) {
@@ -363,8 +429,12 @@ int svlVideoCodecCVI::Create(const std::string &filename, const unsigned int wid
             memset(prevYuvBuffer, 0, yuvBufferSize);
         }
 
+        // Tile coding needs room for the packed tiles of delta frames too
+        if (Config.Differential == DifferentialTiles) pixels = svlTileDeltaCoder::GetPaddedSize(width, height);
+        else pixels = width * height;
+
         // Allocate YUV buffer if not done yet
-        size = width * height * 2;
+        size = pixels * 2;
         if (!yuvBuffer) {
             yuvBuffer = new unsigned char[size];
             yuvBufferSize = size;
@@ -376,7 +446,7 @@ int svlVideoCodecCVI::Create(const std::string &filename, const unsigned int wid
         }
 
         // Allocate compression buffer if not done yet
-        size = width * height * 3;
+        size = pixels * 3;
         size += size / 100 + 4096;
         if (!comprBuffer) {
             comprBuffer = new unsigned char[size];
@@ -388,22 +458,24 @@ int svlVideoCodecCVI::Create(const std::string &filename, const unsigned int wid
             comprBufferSize = size;
         }
 
-        // Allocate save buffers if not done yet
-        if (saveBufferSize == 0) {
-            saveBuffer[0] = new unsigned char[size];
-            saveBuffer[1] = new unsigned char[size];
-            saveBufferSize = size;
-        }
-        else if (saveBufferSize < size) {
-            delete [] saveBuffer[0];
-            delete [] saveBuffer[1];
-            saveBuffer[0] = new unsigned char[size];
-            saveBuffer[1] = new unsigned char[size];
+        // Allocate write queue buffers if not done yet
+        if (saveBufferSize < size || saveBuffer.size() != SaveQueueLength) {
+            ReleaseSaveBuffers();
+            saveBuffer.SetSize(SaveQueueLength);
+            for (unsigned int i = 0; i < SaveQueueLength; i ++) saveBuffer[i] = new unsigned char[size];
             saveBufferSize = size;
         }
+        SaveBufferUsedSize.SetSize(SaveQueueLength);
+        SaveBufferUsedSize.SetAll(0);
+        SaveQueueHead = 0;
+        SaveQueueCount = 0;
 
-        SaveBufferUsedSize = 0;
-        SaveBufferUsedID = 0;
+        CompressionTime = -1.0;
+        CompressionTimeSum = 0.0;
+        CompressedFrames = 0;
+
+        TileCoder.Reset();
+        TileCoder.SetKeyFrameInterval(Config.KeyFrameEvery);
 
         // Start data saving thread
         SaveInitialized = false;
@@ -439,8 +511,10 @@ int svlVideoCodecCVI::Close()
 
     if (Opened && Writing) {
 
-        // Stop data saving thread
+        // Stop data saving thread after the queued frames are written
+        SaveCS.Enter();
         KillSaveThread = true;
+        SaveCS.Leave();
         if (SaveInitialized) {
             NewFrameEvent->Raise();
             SaveThread->Wait();
@@ -480,7 +554,8 @@ int svlVideoCodecCVI::Close()
 
                 // Seek back to "frame offsets pointer"
                 long long int frameoffsetspointer = FileStartMarker[Version].length() +  // File start marker
-                                                    sizeof(unsigned char);               // Differential flag
+                                                    sizeof(unsigned char) +              // Differential flag
+                                                    sizeof(unsigned char);               // Compression method
                 if (File.Seek(frameoffsetspointer) != SVL_OK) {
                     ret = SVL_FAIL;
                     CMN_LOG_CLASS_INIT_ERROR << "Close: failed to seek to `frame offsets` placeholder" << std::endl;
@@ -500,6 +575,8 @@ int svlVideoCodecCVI::Close()
         }
     }
 
+    StopPrefetching();
+    FileMap.Close();
     File.Close();
 
     delete SaveInitEvent;
@@ -521,6 +598,7 @@ int svlVideoCodecCVI::Close()
     Opened       = false;
     Writing      = false;
     Timestamp    = -1.0;
+    NextFrameOffset = 0;
 
     FrameOffsets.SetSize(0);
     FrameTimestamps.SetSize(0);
@@ -545,7 +623,7 @@ int svlVideoCodecCVI::GetPos() const
 
 int svlVideoCodecCVI::SetPos(const int pos)
 {
-    if (Version == 0 || Config.Differential) {
+    if (Version == 0 || Config.Differential == DifferentialPixel) {
         CMN_LOG_CLASS_INIT_ERROR << "SetPos: seeking is not supported in this CVI version" << std::endl;
         return SVL_FAIL;
     }
@@ -554,6 +632,15 @@ int svlVideoCodecCVI::SetPos(const int pos)
         return SVL_FAIL;
     }
     Pos = pos;
+
+    if (FileMap.IsOpen()) {
+        // Start decoding around the new position right away
+        CacheCS.Enter();
+        PrefetchCenter = pos;
+        CacheCS.Leave();
+        PrefetchEvent->Raise();
+    }
+
     return SVL_OK;
 }
 
@@ -651,8 +738,11 @@ svlVideoIO::Compression* svlVideoCodecCVI::GetCompression() const
     compression->datasize = sizeof(CompressionData);
 
     // CVI specific settings
-    output_data->Level        = Config.Level;
-    output_data->Differential = Config.Differential;
+    output_data->Level         = Config.Level;
+    output_data->Differential  = Config.Differential;
+    output_data->Method        = Config.Method;
+    output_data->Parts         = Config.Parts;
+    output_data->KeyFrameEvery = Config.KeyFrameEvery;
 
     return compression;
 }
@@ -699,13 +789,32 @@ int svlVideoCodecCVI::SetCompression(const svlVideoIO::Compression *compression)
     else {
         local_data->Level = Config.Level;
     }
-    if (compression->datasize >= sizeof(CompressionData)) {
+    // Maintaining compatibility with older versions of the structure
+    if (compression->datasize >= 2 * sizeof(unsigned char) && input_data->Differential <= DifferentialTiles) {
         Config.Differential = local_data->Differential = input_data->Differential;
     }
     else {
-        // Maintaining compatibility with older versions of the structure
         local_data->Differential = Config.Differential;
     }
+    if (compression->datasize >= 4 * sizeof(unsigned char)) {
+        if (input_data->Method == MethodZLib || input_data->Method == MethodLZ) {
+            Config.Method = local_data->Method = input_data->Method;
+        }
+        else {
+            local_data->Method = Config.Method;
+        }
+        Config.Parts = local_data->Parts = input_data->Parts;
+    }
+    else {
+        local_data->Method = Config.Method;
+        local_data->Parts  = Config.Parts;
+    }
+    if (compression->datasize >= sizeof(CompressionData)) {
+        Config.KeyFrameEvery = local_data->KeyFrameEvery = input_data->KeyFrameEvery;
+    }
+    else {
+        local_data->KeyFrameEvery = Config.KeyFrameEvery;
+    }
 
     return SVL_OK;
 }
@@ -717,20 +826,48 @@ int svlVideoCodecCVI::DialogCompression()
         return SVL_FAIL;
     }
 
-    std::cout << " # Enter compression level [0-9]: ";
-    int level = 0;
-    while (level < '0' || level > '9') level = cmnGetChar();
-    level -= '0';
-    std::cout << level << std::endl;
+    std::cout << " # Enable fast LZ compression instead of ZLib ['y' or other]: ";
+    int method = cmnGetChar();
+    if (method == 'y' || method == 'Y') {
+        method = MethodLZ;
+        std::cout << "YES" << std::endl;
+    }
+    else {
+        method = MethodZLib;
+        std::cout << "NO" << std::endl;
+    }
+
+    int level = Config.Level;
+    if (method == MethodZLib) {
+        std::cout << " # Enter compression level [0-9]: ";
+        level = 0;
+        while (level < '0' || level > '9') level = cmnGetChar();
+        level -= '0';
+        std::cout << level << std::endl;
+    }
 
-    std::cout << " # Enable differential encoding (seeking not supported) ['y' or other]: ";
+    std::cout << " # Enable differential encoding: pixels (seeking not supported) ['y'], changed tiles only ['t'] or other: ";
     int differential = cmnGetChar();
+    int keyframeevery = Config.KeyFrameEvery;
     if (differential == 'y' || differential == 'Y') {
-        differential = 1;
-        std::cout << "YES" << std::endl;
+        differential = DifferentialPixel;
+        std::cout << "PIXELS" << std::endl;
+    }
+    else if (differential == 't' || differential == 'T') {
+        differential = DifferentialTiles;
+        std::cout << "TILES" << std::endl;
+        std::cout << " # Enter key frame interval [1-65535] (default=" << keyframeevery << "): ";
+        char input[256];
+        std::cin.getline(input, 256);
+        if (std::cin.gcount() > 1) {
+            keyframeevery = atoi(input);
+            if (keyframeevery < 1) keyframeevery = 1;
+            if (keyframeevery > 65535) keyframeevery = 65535;
+        }
+        std::cout << "    Key frame interval = " << keyframeevery << std::endl;
     }
     else {
-        differential = 0;
+        differential = DifferentialNone;
         std::cout << "NO" << std::endl;
     }
 
@@ -751,8 +888,11 @@ int svlVideoCodecCVI::DialogCompression()
     Codec->datasize = sizeof(CompressionData);
 
     // CVI specific settings
-    Config.Level        = local_data->Level        = static_cast<unsigned char>(level);
-    Config.Differential = local_data->Differential = static_cast<unsigned char>(differential);
+    Config.Level         = local_data->Level         = static_cast<unsigned char>(level);
+    Config.Differential  = local_data->Differential  = static_cast<unsigned char>(differential);
+    Config.Method        = local_data->Method        = static_cast<unsigned char>(method);
+    Config.KeyFrameEvery = local_data->KeyFrameEvery = static_cast<unsigned short>(keyframeevery);
+    local_data->Parts    = Config.Parts;
 
 	return SVL_OK;
 }
@@ -802,10 +942,26 @@ int svlVideoCodecCVI::Read(svlProcInfo* procInfo, svlSampleImage &image, const u
     }
 
     unsigned char* img = image.GetUCharPointer(videoch);
-    unsigned int i, compressedpartsize, offset;
+
+    if (FileMap.IsOpen()) {
+        if (Pos > EndPos) {
+            Pos = 0;
+            return SVL_VID_END_REACHED;
+        }
+        if (ReadCachedFrame(Pos, img) != SVL_OK) {
+            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read frame=" << Pos << std::endl;
+            return SVL_FAIL;
+        }
+        Pos ++;
+        return SVL_OK;
+    }
+
+    unsigned int i, compressedpartsize, offset, yuvsize;
     unsigned long longsize;
+    unsigned char* target;
     long long int len;
     char strbuffer[32];
+    int returnpos = -1;
     int ret = SVL_FAIL;
 
     if (Version > 0) {
@@ -821,7 +977,7 @@ int svlVideoCodecCVI::Read(svlProcInfo* procInfo, svlSampleImage &image, const u
         }
 
         if (Pos == 0) {
-            if (Config.Differential) {
+            if (Config.Differential == DifferentialPixel) {
                 // Reset previous YUV buffer to all zeros
                 memset(prevYuvBuffer, 0, prevYuvBufferSize);
             }
@@ -856,6 +1012,37 @@ int svlVideoCodecCVI::Read(svlProcInfo* procInfo, svlSampleImage &image, const u
             return SVL_FAIL;
         }
 
+        // Delta frames decompress into the packed tiles
+        target = img;
+        yuvsize = Width * Height * 2;
+        if (Config.Differential == DifferentialTiles) {
+            if (ReadTileHeader() != SVL_OK) {
+                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to read `tile header`" << std::endl;
+                return SVL_FAIL;
+            }
+            if (!TileCoder.CanDecode()) {
+                // Decode the key frame first, then return to this frame
+                const int keypos = static_cast<int>(TileCoder.GetKeyFrameNumber()) - 1;
+                if (Version == 0 || returnpos >= 0 || keypos < 0 || keypos >= Pos ||
+                    File.Seek(FrameOffsets[keypos]) != SVL_OK) {
+                    CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to find key frame of frame=" << Pos << std::endl;
+                    return SVL_FAIL;
+                }
+                returnpos = Pos;
+                Pos = keypos;
+                continue;
+            }
+            if (!TileCoder.IsKeyFrame()) {
+                svlSampleImage &packed = TileCoder.PreparePackedTiles();
+                target = packed.GetUCharPointer();
+                yuvsize = packed.GetWidth() * packed.GetHeight() * 2;
+            }
+        }
+        if (yuvsize > yuvBufferSize) {
+            CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") frame does not fit in the decoding buffer" << std::endl;
+            return SVL_FAIL;
+        }
+
         offset = 0;
         for (i = 0; i < PartCount; i ++) {
 
@@ -872,24 +1059,51 @@ int svlVideoCodecCVI::Read(svlProcInfo* procInfo, svlSampleImage &image, const u
             if (File.Read(reinterpret_cast<char*>(comprBuffer), len) != len) break;
 
             // Decompress frame part
-            longsize = yuvBufferSize - offset;
-            if (uncompress(yuvBuffer + offset, &longsize, comprBuffer, compressedpartsize) != Z_OK) {
-                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to uncompress data" << std::endl;
-                return SVL_FAIL;
+            if (Config.Method == MethodLZ) {
+                const int decomprsize = svlCompressionLZ::Decompress(comprBuffer, compressedpartsize, yuvBuffer + offset, yuvsize - offset);
+                if (decomprsize < 0) {
+                    CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to uncompress data" << std::endl;
+                    return SVL_FAIL;
+                }
+                longsize = decomprsize;
+            }
+            else {
+                longsize = yuvsize - offset;
+                if (uncompress(yuvBuffer + offset, &longsize, comprBuffer, compressedpartsize) != Z_OK) {
+                    CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to uncompress data" << std::endl;
+                    return SVL_FAIL;
+                }
             }
 
-            if (Config.Differential) {
+            if (Config.Differential == DifferentialPixel) {
                 // Decode differential encoded data
                 DiffDecode(yuvBuffer + offset, prevYuvBuffer + offset, yuvBuffer + offset, longsize);
             }
 
             // Convert YUV422 planar to RGB format
-            svlConverter::YUV422PtoRGB24(yuvBuffer + offset, img + offset * 3 / 2, longsize >> 1);
+            svlConverter::YUV422PtoRGB24(yuvBuffer + offset, target + offset * 3 / 2, longsize >> 1);
 
             offset += longsize;
         }
         if (i < PartCount) break;
 
+        if (Config.Differential == DifferentialTiles) {
+            if (TileCoder.Decode(image, videoch) != SVL_OK) {
+                CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to decode tiles" << std::endl;
+                return SVL_FAIL;
+            }
+            if (returnpos >= 0) {
+                // Key frame decoded; read the requested frame again
+                Pos = returnpos;
+                returnpos = -1;
+                if (File.Seek(FrameOffsets[Pos]) != SVL_OK) {
+                    CMN_LOG_CLASS_INIT_ERROR << "Read: (thread=" << procInfo->ID << ") failed to seek to frame=" << Pos << std::endl;
+                    return SVL_FAIL;
+                }
+                continue;
+            }
+        }
+
         Pos ++;
         ret = SVL_OK;
 
@@ -961,16 +1175,21 @@ int svlVideoCodecCVI::Write(svlProcInfo* procInfo, const svlSampleImage &image,
 
         _OnSingleThread(procInfo)
         {
-            // Initialize multithreaded processing
-            ComprPartOffset.SetSize(procInfo->count);
-            ComprPartSize.SetSize(procInfo->count);
+            // Initialize multithreaded processing: each part is a
+            // horizontal band compressed independently of the others
+            PartCount = Config.Parts ? Config.Parts : procInfo->count;
+            if (PartCount > 256) PartCount = 256;
+            if (PartCount > Height) PartCount = Height;
+            ComprPartOffset.SetSize(PartCount);
+            ComprPartSize.SetSize(PartCount);
 
             // Write "part count"
             len = sizeof(unsigned int);
-            if (File.Write(reinterpret_cast<char*>(&procInfo->count), len) != len) {
+            if (File.Write(reinterpret_cast<char*>(&PartCount), len) != len) {
                 err = true;
                 CMN_LOG_CLASS_INIT_ERROR << "Write: (thread=" << procInfo->ID << ") failed to write `part count`" << std::endl;
             }
+            NextFrameOffset = File.GetPos();
         }
 
         // Synchronize threads
@@ -979,45 +1198,69 @@ int svlVideoCodecCVI::Write(svlProcInfo* procInfo, const svlSampleImage &image,
         if (err) return SVL_FAIL;
     }
 
+    _OnSingleThread(procInfo)
+    {
+        CompressionStartTime = osaGetTime();
+    }
+
+    // Delta frames compress the packed changed tiles only
+    const bool tiles = (Config.Differential == DifferentialTiles);
+    const svlSampleImage* source = &image;
+    unsigned int sourcech = videoch;
+    if (tiles) {
+        if (TileCoder.Encode(procInfo, image, videoch) != SVL_OK) {
+            CMN_LOG_CLASS_INIT_ERROR << "Write: (thread=" << procInfo->ID << ") failed to find changed tiles" << std::endl;
+            return SVL_FAIL;
+        }
+        if (!TileCoder.IsKeyFrame()) {
+            source = &(TileCoder.GetPackedTiles());
+            sourcech = 0;
+        }
+    }
+    const unsigned int sourcewidth = source->GetWidth(sourcech);
+    const unsigned int sourceheight = source->GetHeight(sourcech);
+
     const unsigned int procid = procInfo->ID;
     const unsigned int proccount = procInfo->count;
-    unsigned int start, end, size, offset;
+    const unsigned int partcapacity = comprBufferSize / PartCount;
+    unsigned int part, start, end, size, offset;
     unsigned long comprsize;
     int compr = Config.Level;
 
     // Multithreaded compression phase
-    while (1) {
+    for (part = procid; part < PartCount; part += proccount) {
 
         // Compute part size and offset
-        size = Height / proccount + 1;
-        comprsize = comprBufferSize / proccount;
-        start = procid * size;
-        if (start >= Height) break;
-        end = start + size;
-        if (end > Height) end = Height;
-        offset = start * Width;
-        size = Width * (end - start);
-        ComprPartOffset[procid] = procid * comprsize;
+        start = part * sourceheight / PartCount;
+        end = (part + 1) * sourceheight / PartCount;
+        offset = start * sourcewidth;
+        size = sourcewidth * (end - start);
+        ComprPartOffset[part] = part * partcapacity;
 
         // Convert RGB to YUV422 planar format
-        svlConverter::RGB24toYUV422P(const_cast<unsigned char*>(image.GetUCharPointer(videoch)) + offset * 3, yuvBuffer + offset * 2, size);
+        svlConverter::RGB24toYUV422P(const_cast<unsigned char*>(source->GetUCharPointer(sourcech)) + offset * 3, yuvBuffer + offset * 2, size);
 
         offset <<= 1; size <<= 1;
 
-        if (Config.Differential) {
+        if (Config.Differential == DifferentialPixel) {
             // Encode data using differential coding
             DiffEncode(yuvBuffer + offset, prevYuvBuffer + offset, yuvBuffer + offset, size);
         }
 
         // Compress part
-        if (compress2(comprBuffer + ComprPartOffset[procid], &comprsize, yuvBuffer + offset, size, compr) != Z_OK) {
-            err = true;
+        if (Config.Method == MethodLZ) {
+            comprsize = svlCompressionLZ::Compress(yuvBuffer + offset, size, comprBuffer + ComprPartOffset[part], partcapacity);
+            if (comprsize == 0) err = true;
+        }
+        else {
+            comprsize = partcapacity;
+            if (compress2(comprBuffer + ComprPartOffset[part], &comprsize, yuvBuffer + offset, size, compr) != Z_OK) err = true;
+        }
+        if (err) {
             CMN_LOG_CLASS_INIT_ERROR << "Write: (thread=" << procInfo->ID << ") failed to compress data" << std::endl;
             break;
         }
-        ComprPartSize[procid] = comprsize;
-
-        break;
+        ComprPartSize[part] = static_cast<unsigned int>(comprsize);
     }
 
     // Synchronize threads
@@ -1028,40 +1271,66 @@ int svlVideoCodecCVI::Write(svlProcInfo* procInfo, const svlSampleImage &image,
     // Single threaded data serialization phase
     _OnSingleThread(procInfo)
     {
-        const unsigned int savebufferid = SaveBufferUsedID ? 0 : 1;
         const double timestamp = image.GetTimestamp();
 
-        // Wait until the previous write operation is done
-        WriteDoneEvent->Wait();
+        CompressionTime = osaGetTime() - CompressionStartTime;
+        CompressionTimeSum += CompressionTime;
+        CompressedFrames ++;
 
-        // Store current file position in frame offsets table (increase table size if needed)
-        if (FrameOffsets.size() <= static_cast<unsigned int>(EndPos)) FrameOffsets.resize(FrameOffsets.size() + 100000);
-        FrameOffsets[EndPos] = File.GetPos();
+        // Wait until there is room in the write queue
+        SaveCS.Enter();
+        while (SaveQueueCount >= SaveQueueLength && !SaveThreadError) {
+            SaveCS.Leave();
+            WriteDoneEvent->Wait(0.01);
+            SaveCS.Enter();
+        }
+        const unsigned int savebufferid = (SaveQueueHead + SaveQueueCount) % SaveQueueLength;
+        SaveCS.Leave();
 
-        // Store current timestamp in frame timestamps table (increase table size if needed)
-        if (FrameTimestamps.size() <= static_cast<unsigned int>(EndPos)) FrameTimestamps.resize(FrameTimestamps.size() + 100000);
-        FrameTimestamps[EndPos] = timestamp;
+        if (SaveThreadError) {
+            CMN_LOG_CLASS_INIT_ERROR << "Write: (thread=" << procInfo->ID << ") error detected on saving thread" << std::endl;
+            return SVL_FAIL;
+        }
+
+        unsigned char* buffer = saveBuffer[savebufferid];
+        unsigned int usedsize;
 
         // Add "frame start marker"
-        memcpy(saveBuffer[savebufferid], FrameStartMarker.c_str(), FrameStartMarker.length());
-        SaveBufferUsedSize = static_cast<unsigned int>(FrameStartMarker.length());
+        memcpy(buffer, FrameStartMarker.c_str(), FrameStartMarker.length());
+        usedsize = static_cast<unsigned int>(FrameStartMarker.length());
 
         // Add "timestamp"
-        memcpy(saveBuffer[savebufferid] + SaveBufferUsedSize, &timestamp, sizeof(double));
-        SaveBufferUsedSize += sizeof(double);
+        memcpy(buffer + usedsize, &timestamp, sizeof(double));
+        usedsize += sizeof(double);
+
+        // Add "tile header"
+        if (tiles) usedsize += TileCoder.WriteHeader(buffer + usedsize);
 
-        for (unsigned int i = 0; i < proccount; i ++) {
+        for (unsigned int i = 0; i < PartCount; i ++) {
             // Add "compressed part size"
-            memcpy(saveBuffer[savebufferid] + SaveBufferUsedSize, &(ComprPartSize[i]), sizeof(unsigned int));
-            SaveBufferUsedSize += sizeof(unsigned int);
+            memcpy(buffer + usedsize, &(ComprPartSize[i]), sizeof(unsigned int));
+            usedsize += sizeof(unsigned int);
 
             // Add compressed frame
-            memcpy(saveBuffer[savebufferid] + SaveBufferUsedSize, comprBuffer + ComprPartOffset[i], ComprPartSize[i]);
-            SaveBufferUsedSize += ComprPartSize[i];
+            memcpy(buffer + usedsize, comprBuffer + ComprPartOffset[i], ComprPartSize[i]);
+            usedsize += ComprPartSize[i];
         }
+        SaveBufferUsedSize[savebufferid] = usedsize;
+
+        // The file position is known in advance since queued frames are written in order;
+        // store it in frame offsets table (increase table size if needed)
+        if (FrameOffsets.size() <= static_cast<unsigned int>(EndPos)) FrameOffsets.resize(FrameOffsets.size() + 100000);
+        FrameOffsets[EndPos] = NextFrameOffset;
+        NextFrameOffset += usedsize;
 
-        // Signal data saving thread to start writing
-        SaveBufferUsedID = savebufferid;
+        // Store current timestamp in frame timestamps table (increase table size if needed)
+        if (FrameTimestamps.size() <= static_cast<unsigned int>(EndPos)) FrameTimestamps.resize(FrameTimestamps.size() + 100000);
+        FrameTimestamps[EndPos] = timestamp;
+
+        // Queue frame and signal data saving thread
+        SaveCS.Enter();
+        SaveQueueCount ++;
+        SaveCS.Leave();
         NewFrameEvent->Raise();
 
 		EndPos ++; Pos ++;
@@ -1070,6 +1339,49 @@ int svlVideoCodecCVI::Write(svlProcInfo* procInfo, const svlSampleImage &image,
 	return SVL_OK;
 }
 
+double svlVideoCodecCVI::GetCompressionTime() const
+{
+    return CompressionTime;
+}
+
+double svlVideoCodecCVI::GetAverageCompressionTime() const
+{
+    if (CompressedFrames < 1) return -1.0;
+    return CompressionTimeSum / CompressedFrames;
+}
+
+int svlVideoCodecCVI::SetWriteQueueLength(const unsigned int length)
+{
+    if (Opened) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetWriteQueueLength: codec is already open" << std::endl;
+        return SVL_FAIL;
+    }
+    if (length < 1) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetWriteQueueLength: queue length must be at least 1" << std::endl;
+        return SVL_FAIL;
+    }
+    SaveQueueLength = length;
+    return SVL_OK;
+}
+
+unsigned int svlVideoCodecCVI::GetWriteQueueLength() const
+{
+    return SaveQueueLength;
+}
+
+int svlVideoCodecCVI::SetPlaybackCache(const unsigned int cachesize, const unsigned int ahead, const unsigned int behind, const unsigned int threads)
+{
+    if (Opened) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetPlaybackCache: codec is already open" << std::endl;
+        return SVL_FAIL;
+    }
+    CacheSize           = cachesize;
+    PrefetchAhead       = ahead;
+    PrefetchBehind      = behind;
+    PrefetchThreadCount = threads;
+    return SVL_OK;
+}
+
 void svlVideoCodecCVI::SetExtension(const std::string & CMN_UNUSED(extension))
 {
     CMN_LOG_CLASS_INIT_ERROR << "SetExtension - feature is not supported by the CVI codec" << std::endl;
@@ -1116,9 +1428,28 @@ void svlVideoCodecCVI::SetDatarate(const int & CMN_UNUSED(datarate))
     CMN_LOG_CLASS_INIT_ERROR << "SetDatarate - feature is not supported by the CVI codec" << std::endl;
 }
 
-void svlVideoCodecCVI::SetKeyFrameEvery(const int & CMN_UNUSED(key_every))
+void svlVideoCodecCVI::SetKeyFrameEvery(const int & key_every)
 {
-    CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - feature is not supported by the CVI codec" << std::endl;
+    if (Opened) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - codec is already open" << std::endl;
+        return;
+    }
+    if (key_every < 0 || key_every > 65535) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - argument out of range [0, 65535]" << std::endl;
+        return;
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "SetKeyFrameEvery - called (" << key_every << ")" << std::endl;
+
+    svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
+
+    // Key frames are only used with tile coding
+    data->KeyFrameEvery = static_cast<unsigned short>(key_every);
+    data->Differential  = DifferentialTiles;
+
+    SetCompression(compr);
+    svlVideoIO::ReleaseCompression(compr);
 }
 
 void svlVideoCodecCVI::IsCompressionLevelEnabled(bool & enabled) const
@@ -1148,7 +1479,7 @@ void svlVideoCodecCVI::IsDatarateEnabled(bool & enabled) const
 void svlVideoCodecCVI::IsKeyFrameEveryEnabled(bool & enabled) const
 {
     CMN_LOG_CLASS_INIT_VERBOSE << "IsFramesEveryEnabled - called" << std::endl;
-    enabled = false;
+    enabled = true;
 }
 
 void svlVideoCodecCVI::GetCompressionLevel(int & compr_level) const
@@ -1195,8 +1526,14 @@ void svlVideoCodecCVI::GetDatarate(int & datarate) const
 
 void svlVideoCodecCVI::GetKeyFrameEvery(int & key_every) const
 {
-    CMN_LOG_CLASS_INIT_ERROR << "GetKeyFrameEvery - feature is not supported by the CVI codec" << std::endl;
-    key_every = -1;
+    CMN_LOG_CLASS_INIT_VERBOSE << "GetKeyFrameEvery - called" << std::endl;
+
+    svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
+
+    key_every = data->KeyFrameEvery;
+
+    svlVideoIO::ReleaseCompression(compr);
 }
 
 void svlVideoCodecCVI::DiffEncode(unsigned char* input, unsigned char* previous, unsigned char* output, const unsigned int size)
@@ -1292,33 +1629,333 @@ void svlVideoCodecCVI::DiffDecode(unsigned char* input, unsigned char* previous,
     }
 }
 
+void svlVideoCodecCVI::StartPrefetching()
+{
+    // Room for the whole prefetch window, the frames being decoded, and the frame being read
+    unsigned int size = PrefetchAhead + PrefetchBehind + PrefetchThreadCount + 2;
+    if (size < CacheSize) size = CacheSize;
+
+    FrameCache.resize(size);
+    for (unsigned int i = 0; i < size; i ++) {
+        FrameCache[i].Pos = -1;
+        FrameCache[i].Ready = false;
+        FrameCache[i].LastUse = 0;
+        FrameCache[i].Timestamp = -1.0;
+        FrameCache[i].Image.resize(Width * Height * 3);
+    }
+    CacheUseCounter   = 0;
+    LastReadPos       = -1;
+    PrefetchCenter    = 0;
+    PrefetchDirection = 1;
+
+    KillPrefetchThreads = false;
+    PrefetchEvent       = new osaThreadSignal;
+    FrameDecodedEvent   = new osaThreadSignal;
+    PrefetchThreads.resize(PrefetchThreadCount);
+    for (unsigned int i = 0; i < PrefetchThreadCount; i ++) {
+        PrefetchThreads[i] = new osaThread;
+        PrefetchThreads[i]->Create<svlVideoCodecCVI, int>(this, &svlVideoCodecCVI::PrefetchProc, static_cast<int>(i));
+    }
+}
+
+void svlVideoCodecCVI::StopPrefetching()
+{
+    CacheCS.Enter();
+    KillPrefetchThreads = true;
+    CacheCS.Leave();
+
+    for (unsigned int i = 0; i < PrefetchThreads.size(); i ++) {
+        PrefetchEvent->Raise();
+        PrefetchThreads[i]->Wait();
+        delete PrefetchThreads[i];
+    }
+    PrefetchThreads.clear();
+
+    delete PrefetchEvent;
+    delete FrameDecodedEvent;
+    PrefetchEvent     = 0;
+    FrameDecodedEvent = 0;
+
+    FrameCache.clear();
+}
+
+int svlVideoCodecCVI::DecodeMappedFrame(const int pos, unsigned char* yuvbuffer, unsigned char* rgbbuffer, double &timestamp) const
+{
+    const unsigned char* data = FileMap.GetPointer();
+    const long long int length = FileMap.GetLength();
+    const unsigned int markerlength = static_cast<unsigned int>(FrameStartMarker.length());
+    const unsigned int yuvsize = Width * Height * 2;
+    long long int offset = FrameOffsets[pos];
+    unsigned int i, compressedpartsize, yuvoffset = 0;
+    unsigned long longsize;
+
+    // "frame start marker" and "timestamp"
+    if (offset < 0 || offset + markerlength + static_cast<long long int>(sizeof(double)) > length) return SVL_FAIL;
+    if (memcmp(data + offset, FrameStartMarker.c_str(), markerlength) != 0) return SVL_FAIL;
+    offset += markerlength;
+    memcpy(&timestamp, data + offset, sizeof(double));
+    offset += sizeof(double);
+
+    for (i = 0; i < PartCount; i ++) {
+
+        // "compressed part size" and compressed frame part
+        if (offset + static_cast<long long int>(sizeof(unsigned int)) > length) return SVL_FAIL;
+        memcpy(&compressedpartsize, data + offset, sizeof(unsigned int));
+        offset += sizeof(unsigned int);
+        if (compressedpartsize == 0 || offset + compressedpartsize > length) return SVL_FAIL;
+
+        // Decompress directly from the mapped file
+        if (Config.Method == MethodLZ) {
+            const int decomprsize = svlCompressionLZ::Decompress(data + offset, compressedpartsize, yuvbuffer + yuvoffset, yuvsize - yuvoffset);
+            if (decomprsize < 0) return SVL_FAIL;
+            longsize = decomprsize;
+        }
+        else {
+            longsize = yuvsize - yuvoffset;
+            if (uncompress(yuvbuffer + yuvoffset, &longsize, data + offset, compressedpartsize) != Z_OK) return SVL_FAIL;
+        }
+        offset += compressedpartsize;
+
+        // Convert YUV422 planar to RGB format
+        svlConverter::YUV422PtoRGB24(yuvbuffer + yuvoffset, rgbbuffer + yuvoffset * 3 / 2, longsize >> 1);
+
+        yuvoffset += longsize;
+    }
+
+    return SVL_OK;
+}
+
+int svlVideoCodecCVI::ReadCachedFrame(const int pos, unsigned char* rgbbuffer)
+{
+    int idx;
+
+    CacheCS.Enter();
+
+    // Playback direction and next expected frame for prefetching
+    if (LastReadPos >= 0 && pos != LastReadPos) PrefetchDirection = (pos > LastReadPos) ? 1 : -1;
+    LastReadPos    = pos;
+    PrefetchCenter = pos + PrefetchDirection;
+
+    // Wait if the frame is being decoded by a prefetching thread
+    idx = FindCachedFrame(pos);
+    while (idx >= 0 && !FrameCache[idx].Ready) {
+        CacheCS.Leave();
+        FrameDecodedEvent->Wait(0.005);
+        CacheCS.Enter();
+        idx = FindCachedFrame(pos);
+    }
+
+    if (idx < 0) {
+        // Cache miss: decode on the calling thread
+        while ((idx = AcquireCacheSlot(pos, false)) < 0) {
+            CacheCS.Leave();
+            FrameDecodedEvent->Wait(0.005);
+            CacheCS.Enter();
+        }
+        CacheCS.Leave();
+        PrefetchEvent->Raise();
+
+        double timestamp;
+        const int ret = DecodeMappedFrame(pos, yuvBuffer, &(FrameCache[idx].Image[0]), timestamp);
+
+        CacheCS.Enter();
+        if (ret != SVL_OK) {
+            FrameCache[idx].Pos = -1;
+            CacheCS.Leave();
+            return SVL_FAIL;
+        }
+        FrameCache[idx].Ready = true;
+        FrameCache[idx].Timestamp = timestamp;
+    }
+
+    memcpy(rgbbuffer, &(FrameCache[idx].Image[0]), FrameCache[idx].Image.size());
+    Timestamp = FrameCache[idx].Timestamp;
+    FrameCache[idx].LastUse = ++ CacheUseCounter;
+
+    CacheCS.Leave();
+
+    PrefetchEvent->Raise();
+
+    return SVL_OK;
+}
+
+int svlVideoCodecCVI::ReadTileHeader()
+{
+    const long long int fixedsize = 5 * sizeof(unsigned int);
+    unsigned int count;
+
+    if (TileHeader.size() < fixedsize) TileHeader.resize(fixedsize);
+    if (File.Read(reinterpret_cast<char*>(&(TileHeader[0])), fixedsize) != fixedsize) return SVL_FAIL;
+
+    // The changed tile indices follow the fixed size fields
+    memcpy(&count, &(TileHeader[4 * sizeof(unsigned int)]), sizeof(unsigned int));
+    if (count > Width * Height) return SVL_FAIL;
+    const long long int len = count * sizeof(unsigned int);
+    TileHeader.resize(fixedsize + len);
+    if (len > 0 && File.Read(reinterpret_cast<char*>(&(TileHeader[fixedsize])), len) != len) return SVL_FAIL;
+
+    if (TileCoder.ReadHeader(&(TileHeader[0]), static_cast<unsigned int>(TileHeader.size()), Width, Height) == 0) return SVL_FAIL;
+
+    return SVL_OK;
+}
+
+int svlVideoCodecCVI::FindCachedFrame(const int pos) const
+{
+    for (unsigned int i = 0; i < FrameCache.size(); i ++) {
+        if (FrameCache[i].Pos == pos) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int svlVideoCodecCVI::AcquireCacheSlot(const int pos, const bool keepwindow)
+{
+    int idx = -1;
+    unsigned int i, lastuse = 0;
+
+    // Unused slot or least recently used decoded frame; frames being
+    // decoded are never evicted and prefetching does not evict frames
+    // it would have to decode again
+    for (i = 0; i < FrameCache.size(); i ++) {
+        if (FrameCache[i].Pos < 0) {
+            idx = static_cast<int>(i);
+            break;
+        }
+        if (!FrameCache[i].Ready) continue;
+        if (keepwindow && IsInPrefetchWindow(FrameCache[i].Pos)) continue;
+        if (idx < 0 || FrameCache[i].LastUse < lastuse) {
+            idx = static_cast<int>(i);
+            lastuse = FrameCache[i].LastUse;
+        }
+    }
+
+    if (idx >= 0) {
+        FrameCache[idx].Pos = pos;
+        FrameCache[idx].Ready = false;
+    }
+    return idx;
+}
+
+bool svlVideoCodecCVI::IsInPrefetchWindow(const int pos) const
+{
+    // Distance from the next expected frame in playback direction;
+    // the window extends behind the last frame read
+    const int distance = (pos - PrefetchCenter) * PrefetchDirection;
+    return distance <= static_cast<int>(PrefetchAhead) && distance >= -1 - static_cast<int>(PrefetchBehind);
+}
+
+int svlVideoCodecCVI::GetPrefetchCandidate() const
+{
+    int k, pos;
+
+    // Closest frames ahead first, then behind
+    for (k = 0; k <= static_cast<int>(PrefetchAhead); k ++) {
+        pos = PrefetchCenter + k * PrefetchDirection;
+        if (pos >= 0 && pos <= EndPos && FindCachedFrame(pos) < 0) return pos;
+    }
+    for (k = 2; k <= static_cast<int>(PrefetchBehind) + 1; k ++) {
+        pos = PrefetchCenter - k * PrefetchDirection;
+        if (pos >= 0 && pos <= EndPos && FindCachedFrame(pos) < 0) return pos;
+    }
+    return -1;
+}
+
+void* svlVideoCodecCVI::PrefetchProc(int CMN_UNUSED(param))
+{
+    std::vector<unsigned char> yuvbuffer(Width * Height * 2);
+    double timestamp;
+    int pos, idx, ret;
+
+    while (1) {
+
+        CacheCS.Enter();
+        if (KillPrefetchThreads) {
+            CacheCS.Leave();
+            break;
+        }
+        pos = GetPrefetchCandidate();
+        idx = (pos >= 0) ? AcquireCacheSlot(pos, true) : -1;
+        CacheCS.Leave();
+
+        if (idx < 0) {
+            // Nothing to do until the playback position changes
+            PrefetchEvent->Wait(0.01);
+            continue;
+        }
+
+        ret = DecodeMappedFrame(pos, &(yuvbuffer[0]), &(FrameCache[idx].Image[0]), timestamp);
+
+        CacheCS.Enter();
+        if (ret == SVL_OK) {
+            FrameCache[idx].Ready = true;
+            FrameCache[idx].Timestamp = timestamp;
+            FrameCache[idx].LastUse = ++ CacheUseCounter;
+        }
+        else {
+            FrameCache[idx].Pos = -1;
+        }
+        CacheCS.Leave();
+
+        FrameDecodedEvent->Raise();
+
+        // Do not retry invalid frames at full speed
+        if (ret != SVL_OK) PrefetchEvent->Wait(0.01);
+    }
+
+    return this;
+}
+
+void svlVideoCodecCVI::ReleaseSaveBuffers()
+{
+    for (unsigned int i = 0; i < saveBuffer.size(); i ++) {
+        if (saveBuffer[i]) delete [] saveBuffer[i];
+    }
+    saveBuffer.SetSize(0);
+    saveBufferSize = 0;
+}
+
 void* svlVideoCodecCVI::SaveProc(int CMN_UNUSED(param))
 {
     SaveThreadError = false;
     SaveInitialized = true;
     SaveInitEvent->Raise();
-    WriteDoneEvent->Raise();
 
     long long int len;
+    unsigned int count, id;
+    bool kill;
 
     while (1) {
 
-        // Wait for new frame to arrive
-        NewFrameEvent->Wait();
-        if (KillSaveThread || SaveThreadError) break;
+        SaveCS.Enter();
+        kill  = KillSaveThread;
+        count = SaveQueueCount;
+        id    = SaveQueueHead;
+        SaveCS.Leave();
 
-        // Write frame
-        len = SaveBufferUsedSize;
-        if (File.Write(reinterpret_cast<char*>(saveBuffer[SaveBufferUsedID]), len) != len) {
+        if (count == 0) {
+            // Exit only when all queued frames have been written
+            if (kill) break;
+
+            // Wait for new frame to arrive
+            NewFrameEvent->Wait(0.01);
+            continue;
+        }
+
+        // Write the oldest frame in the queue
+        len = SaveBufferUsedSize[id];
+        if (File.Write(reinterpret_cast<char*>(saveBuffer[id]), len) != len) {
             SaveThreadError = true;
             CMN_LOG_CLASS_INIT_ERROR << "SaveProc: failed to write compressed data" << std::endl;
             return this;
         }
 
+        SaveCS.Enter();
+        SaveQueueHead = (SaveQueueHead + 1) % SaveQueueLength;
+        SaveQueueCount --;
+        SaveCS.Leave();
+
         // Signal that write is done
         WriteDoneEvent->Raise();
     }
 
     return this;
 }
-
@@ -24,9 +24,13 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstOSAbstraction/osaThread.h>
 #include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
 #include <cisstStereoVision/svlVideoIO.h>
 #include <cisstStereoVision/svlTypes.h>
 #include <cisstStereoVision/svlFile.h>
+#include "svlFileMap.h"
+#include "svlTileDeltaCoder.h"
+#include <vector>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -36,9 +40,23 @@ class CISST_EXPORT svlVideoCodecCVI : public svlVideoCodecBase
     CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION, CMN_LOG_LOD_RUN_ERROR);
 
 public:
+    enum CompressionMethod {
+        MethodZLib = 0,     // zlib, compression level 0-9
+        MethodLZ   = 1      // fast LZ (LZ4 block format), compression level ignored
+    };
+
+    enum DifferentialMode {
+        DifferentialNone  = 0,
+        DifferentialPixel = 1,  // difference to the previous frame; seeking not supported
+        DifferentialTiles = 2   // changed tiles between key frames; seekable
+    };
+
     typedef struct _CompressionData {
-        unsigned char Level;
-        unsigned char Differential;
+        unsigned char  Level;
+        unsigned char  Differential;    // DifferentialMode
+        unsigned char  Method;          // CompressionMethod
+        unsigned char  Parts;           // horizontal bands compressed independently; 0: one per thread
+        unsigned short KeyFrameEvery;   // key frame interval of DifferentialTiles
     } CompressionData;
 
 public:
@@ -69,6 +87,17 @@ public:
     virtual int Read(svlProcInfo* procInfo, svlSampleImage &image, const unsigned int videoch, const bool noresize = false);
     virtual int Write(svlProcInfo* procInfo, const svlSampleImage &image, const unsigned int videoch);
 
+    virtual double GetCompressionTime() const;
+    virtual double GetAverageCompressionTime() const;
+
+    //! Number of compressed frames that may wait for the writer thread; call before Create
+    int SetWriteQueueLength(const unsigned int length);
+    unsigned int GetWriteQueueLength() const;
+
+    //! Playback of seekable files: number of decoded frames kept in memory, frames decoded
+    //! in advance ahead of and behind the playback position, and decoder threads; call before Open
+    int SetPlaybackCache(const unsigned int cachesize, const unsigned int ahead, const unsigned int behind, const unsigned int threads);
+
 public:
     virtual void SetExtension(const std::string & extension);
     virtual void SetEncoderID(const int & encoder_id);
@@ -92,7 +121,7 @@ public:
 
 protected:
     const std::string CodecName;
-    const vctFixedSizeVector<std::string, 4> FileStartMarker;
+    vctFixedSizeVector<std::string, 6> FileStartMarker;
     const std::string FrameStartMarker;
 
     CompressionData Config;
@@ -122,11 +151,17 @@ protected:
     unsigned int comprBufferSize;
     vctDynamicVector<unsigned int> ComprPartOffset;
     vctDynamicVector<unsigned int> ComprPartSize;
+    svlTileDeltaCoder TileCoder;
+    std::vector<unsigned char> TileHeader;
 
-    vctFixedSizeVector<unsigned char*, 2> saveBuffer;
+    vctDynamicVector<unsigned char*> saveBuffer;
     unsigned int saveBufferSize;
-    unsigned int SaveBufferUsedSize;
-    unsigned int SaveBufferUsedID;
+    vctDynamicVector<unsigned int> SaveBufferUsedSize;
+    unsigned int SaveQueueLength;
+    unsigned int SaveQueueHead;
+    unsigned int SaveQueueCount;
+    long long int NextFrameOffset;
+    osaCriticalSection SaveCS;
     osaThread* SaveThread;
     osaThreadSignal* SaveInitEvent;
     osaThreadSignal* NewFrameEvent;
@@ -137,6 +172,49 @@ protected:
 
     svlProcInfo ProcInfoSingleThread;
 
+    struct CachedFrame
+    {
+        int Pos;                // -1 if unused
+        bool Ready;             // false while being decoded
+        unsigned int LastUse;
+        double Timestamp;
+        std::vector<unsigned char> Image;
+    };
+
+    svlFileMap FileMap;
+    std::vector<CachedFrame> FrameCache;
+    osaCriticalSection CacheCS;
+    unsigned int CacheSize;
+    unsigned int PrefetchAhead;
+    unsigned int PrefetchBehind;
+    unsigned int PrefetchThreadCount;
+    unsigned int CacheUseCounter;
+    int LastReadPos;
+    int PrefetchCenter;
+    int PrefetchDirection;
+    std::vector<osaThread*> PrefetchThreads;
+    osaThreadSignal* PrefetchEvent;
+    osaThreadSignal* FrameDecodedEvent;
+    bool KillPrefetchThreads;
+
+    double CompressionStartTime;
+    double CompressionTime;
+    double CompressionTimeSum;
+    unsigned int CompressedFrames;
+
+    void ReleaseSaveBuffers();
+
+    void StartPrefetching();
+    void StopPrefetching();
+    int DecodeMappedFrame(const int pos, unsigned char* yuvbuffer, unsigned char* rgbbuffer, double &timestamp) const;
+    int ReadCachedFrame(const int pos, unsigned char* rgbbuffer);
+    int ReadTileHeader();
+    int FindCachedFrame(const int pos) const;
+    int AcquireCacheSlot(const int pos, const bool keepwindow);
+    bool IsInPrefetchWindow(const int pos) const;
+    int GetPrefetchCandidate() const;
+    void* PrefetchProc(int param);
+
     void DiffEncode(unsigned char* input, unsigned char* previous, unsigned char* output, const unsigned int size);
     void DiffDecode(unsigned char* input, unsigned char* previous, unsigned char* output, const unsigned int size);
 
@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlConverters.h>
 #include <cisstStereoVision/svlSyncPoint.h>
 #include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 
 #include "zlib.h"
 
@@ -72,23 +73,39 @@ http://www.cisst.org/cisst/license.txt.
     #include <sys/socket.h>
     #include <sys/types.h>
     #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#if (CISST_OS == CISST_LINUX)
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
 #endif
 
 #if (CISST_OS == CISST_WINDOWS)
     #define __errno         WSAGetLastError()
     #define __ECONNABORTED  WSAECONNABORTED
     #define __EAGAIN        WSATRY_AGAIN
+    #define __EWOULDBLOCK   WSAEWOULDBLOCK
 #else
     #define __errno         errno
     #define __ECONNABORTED  ECONNABORTED
     #define __EAGAIN        EAGAIN
+    #define __EWOULDBLOCK   EWOULDBLOCK
+#endif
+
+#if (CISST_OS == CISST_LINUX)
+    #define __SENDFLAGS     MSG_NOSIGNAL
+#else
+    #define __SENDFLAGS     0
 #endif
 
 #define _NET_VERBOSE_
 
-#define MAX_CLIENTS         5
+#define MAX_CLIENTS         32
 #define PACKET_SIZE         1300u
 #define BROKEN_FRAME        1
+#define TILE_DELTA_FLAG     0x80000000u   // in the part count: tile header follows
 
 
 /*************************************/
@@ -118,11 +135,15 @@ svlVideoCodecTCPStream::svlVideoCodecTCPStream() :
     yuvBufferSize(0),
     comprBuffer(0),
     comprBufferSize(0),
+    TileCoded(false),
+    KeyFrameRequested(false),
     ServerSocket(-1),
     ServerThread(0),
     ServerInitEvent(0),
     ServerInitialized(false),
     ReceiveBuffer(0),
+    ServerPoll(-1),
+    ServerWakeup(-1),
     ReceiveSocket(-1),
     ReceiveThread(0),
     ReceiveInitEvent(0),
@@ -133,9 +154,6 @@ svlVideoCodecTCPStream::svlVideoCodecTCPStream() :
     SetMultithreaded(true);
     SetVariableFramerate(true);
 
-    SendBuffer.SetSize(MAX_CLIENTS);
-    SendBuffer.SetAll(0);
-
     SockAddr = new char[sizeof(sockaddr_in)];
     PacketData = new char[PACKET_SIZE * 2];
     PacketDataAccumulator = new char[PACKET_SIZE * 2];
@@ -149,8 +167,11 @@ svlVideoCodecTCPStream::~svlVideoCodecTCPStream()
     Close();
 
     delete ReceiveBuffer;
-    for (unsigned int i = 0; i < MAX_CLIENTS; i ++) delete SendBuffer[i];
-    
+    for (unsigned int i = 0; i < FramePool.size(); i ++) {
+        delete [] FramePool[i]->Data;
+        delete FramePool[i];
+    }
+
     if (yuvBuffer) delete [] yuvBuffer;
     if (comprBuffer && comprBufferSize) delete [] comprBuffer;
     if (SockAddr) delete [] SockAddr;
@@ -179,6 +200,7 @@ int svlVideoCodecTCPStream::Open(const std::string &filename, unsigned int &widt
         delete [] yuvBuffer;
         yuvBuffer = 0;
         yuvBufferSize = 0;
+        TileCoder.Reset();
         AccumulatedSize = 0;
 
         // Start data receiving thread
@@ -227,8 +249,9 @@ int svlVideoCodecTCPStream::Create(const std::string &filename, const unsigned i
         Opened = true;
 	    Writing = true;
 
-        // Allocate YUV buffer if not done yet
-        size = width * height * 2;
+        // Allocate YUV buffer if not done yet; large enough for the packed
+        // tiles of delta frames too
+        size = svlTileDeltaCoder::GetPaddedSize(width, height) * 2;
         if (!yuvBuffer) {
             yuvBuffer = new unsigned char[size];
             yuvBufferSize = size;
@@ -240,7 +263,7 @@ int svlVideoCodecTCPStream::Create(const std::string &filename, const unsigned i
         }
 
         // Allocate compression buffer if not done yet
-        size = width * height * 3;
+        size = svlTileDeltaCoder::GetPaddedSize(width, height) * 3;
         size += size / 100 + 4096;
         if (!comprBuffer) {
             comprBuffer = new unsigned char[size];
@@ -252,17 +275,6 @@ int svlVideoCodecTCPStream::Create(const std::string &filename, const unsigned i
             comprBufferSize = size;
         }
 
-        // Allocate streaming buffers if not done yet
-        for (unsigned int i = 0; i < MAX_CLIENTS; i ++) {
-            if (!SendBuffer[i]) {
-                SendBuffer[i] = new svlBufferMemory(size);
-            }
-            else if (SendBuffer[i] && SendBuffer[i]->GetMaxSize() < size) {
-                delete SendBuffer[i];
-                SendBuffer[i] = new svlBufferMemory(size);
-            }
-        }
-
         // Start data saving thread
         ServerInitialized = false;
         KillServerThread = false;
@@ -272,6 +284,10 @@ int svlVideoCodecTCPStream::Create(const std::string &filename, const unsigned i
         ServerInitEvent->Wait();
         if (ServerInitialized == false) break;
 
+        TileCoder.Reset();
+        TileCoder.SetKeyFrameInterval(reinterpret_cast<CompressionData*>(&(Codec->data[0]))->KeyFrameEvery);
+        KeyFrameRequested = false;
+
         BegPos = EndPos = Pos = 0;
         Width = width;
         Height = height;
@@ -340,22 +356,25 @@ svlVideoIO::Compression* svlVideoCodecTCPStream::GetCompression() const
 {
     // The caller will need to release it by calling the
     // svlVideoIO::ReleaseCompression() method
-    unsigned int size = sizeof(svlVideoIO::Compression);
+    unsigned int size = sizeof(svlVideoIO::Compression) - sizeof(unsigned char) + sizeof(CompressionData);
     svlVideoIO::Compression* compression = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[size]);
 
     if (Codec) {
         memcpy(compression, Codec, size);
     }
     else {
-        // Set default compressor to JPEG, compression level to 75
+        // Set default compressor to JPEG, compression level to 75, no tile delta coding
         std::string name("CISST Video Stream over TCP/IP");
         memset(&(compression->extension[0]), 0, 16);
         memcpy(&(compression->extension[0]), ".njpg", 5);
         memset(&(compression->name[0]), 0, 64);
         memcpy(&(compression->name[0]), name.c_str(), std::min(static_cast<int>(name.length()), 63));
         compression->size = size;
-        compression->datasize = 1;
-        compression->data[0] = 75;
+        compression->datasize = sizeof(CompressionData);
+        CompressionData* data = reinterpret_cast<CompressionData*>(&(compression->data[0]));
+        data->Level         = 75;
+        data->Reserved      = 0;
+        data->KeyFrameEvery = 0;
     }
 
     return compression;
@@ -373,16 +392,24 @@ int svlVideoCodecTCPStream::SetCompression(const svlVideoIO::Compression *compre
         return SVL_FAIL;
     }
 
+    const CompressionData* input_data = reinterpret_cast<const CompressionData*>(&(compression->data[0]));
+    // Maintaining compatibility with the single byte version of the structure
+    const unsigned short keyframeevery = (compression->datasize >= sizeof(CompressionData)) ? input_data->KeyFrameEvery : 0;
+
     svlVideoIO::ReleaseCompression(Codec);
-    Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[sizeof(svlVideoIO::Compression)]);
+    unsigned int size = sizeof(svlVideoIO::Compression) - sizeof(unsigned char) + sizeof(CompressionData);
+    Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[size]);
+    CompressionData* local_data = reinterpret_cast<CompressionData*>(&(Codec->data[0]));
 
     std::string name("CISST Video Stream over TCP/IP");
     memset(&(Codec->extension[0]), 0, 16);
     memcpy(&(Codec->extension[0]), extension.c_str(), std::min(static_cast<int>(extension.length()) - 1, 15));
     memset(&(Codec->name[0]), 0, 64);
     memcpy(&(Codec->name[0]), name.c_str(), std::min(static_cast<int>(name.length()), 63));
-    Codec->size = sizeof(svlVideoIO::Compression);
-    Codec->datasize = 1;
+    Codec->size = size;
+    Codec->datasize = sizeof(CompressionData);
+    local_data->Reserved      = 0;
+    local_data->KeyFrameEvery = keyframeevery;
 
     unsigned char max, defaultval;
     if (extension == ".ncvi;") {
@@ -393,8 +420,8 @@ int svlVideoCodecTCPStream::SetCompression(const svlVideoIO::Compression *compre
         max        = 100;
         defaultval = 75;
     }
-    if (compression->data[0] > max) Codec->data[0] = defaultval;
-    else Codec->data[0] = compression->data[0];
+    if (input_data->Level > max) local_data->Level = defaultval;
+    else local_data->Level = input_data->Level;
 
     return SVL_OK;
 }
@@ -460,17 +487,32 @@ int svlVideoCodecTCPStream::DialogCompression(const std::string &filename)
         std::cout << "    Compression level = " << level << std::endl;
     }
 
+    int keyframeevery;
+    std::cout << " # Enter key frame interval for sending changed tiles only (0 or 1: disabled; default=0): ";
+    std::cin.getline(input, 256);
+    if (std::cin.gcount() > 1) {
+        keyframeevery = atoi(input);
+        if (keyframeevery < 0) keyframeevery = 0;
+        if (keyframeevery > 65535) keyframeevery = 65535;
+    }
+    else keyframeevery = 0;
+    std::cout << "    Key frame interval = " << keyframeevery << std::endl;
+
     svlVideoIO::ReleaseCompression(Codec);
-    Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[sizeof(svlVideoIO::Compression)]);
+    unsigned int size = sizeof(svlVideoIO::Compression) - sizeof(unsigned char) + sizeof(CompressionData);
+    Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[size]);
+    CompressionData* local_data = reinterpret_cast<CompressionData*>(&(Codec->data[0]));
 
     std::string name("CISST Video Stream over TCP/IP");
     memset(&(Codec->extension[0]), 0, 16);
     memcpy(&(Codec->extension[0]), extension.c_str(), std::min(static_cast<int>(extension.length()) - 1, 15));
     memset(&(Codec->name[0]), 0, 64);
     memcpy(&(Codec->name[0]), name.c_str(), std::min(static_cast<int>(name.length()), 63));
-    Codec->size = sizeof(svlVideoIO::Compression);
-    Codec->datasize = 1;
-    Codec->data[0] = static_cast<unsigned char>(level);
+    Codec->size = size;
+    Codec->datasize = sizeof(CompressionData);
+    local_data->Level         = static_cast<unsigned char>(level);
+    local_data->Reserved      = 0;
+    local_data->KeyFrameEvery = static_cast<unsigned short>(keyframeevery);
     
     return SVL_OK;
 }
@@ -495,7 +537,7 @@ int svlVideoCodecTCPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
     if (videoch >= image.GetVideoChannels()) return SVL_FAIL;
     if (!Opened || Writing) return SVL_FAIL;
 
-    unsigned int i, used, partcount, compressedpartsize, offset, strmoffset;
+    unsigned int i, used, headersize, partcount, compressedpartsize, offset, strmoffset;
     unsigned long longsize;
     unsigned char *strmbuf = 0;
     int ret = SVL_FAIL;
@@ -533,6 +575,9 @@ int svlVideoCodecTCPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
             // part count
             partcount = reinterpret_cast<unsigned int*>(strmbuf + strmoffset)[0];
             strmoffset += sizeof(unsigned int);
+            TileCoded = ((partcount & TILE_DELTA_FLAG) != 0);
+            partcount &= ~TILE_DELTA_FLAG;
+            if (strmoffset > used || partcount > (used - strmoffset) / sizeof(unsigned int)) break;
 
             // Allocate image buffer if not done yet
             if (Width != image.GetWidth(videoch) || Height != image.GetHeight(videoch)) {
@@ -540,18 +585,34 @@ int svlVideoCodecTCPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
                 image.SetSize(videoch, Width, Height);
             }
 
+            // Tile header
+            if (TileCoded) {
+                headersize = TileCoder.ReadHeader(strmbuf + strmoffset, used - strmoffset, Width, Height);
+                if (headersize == 0) break;
+                strmoffset += headersize;
+                if (!TileCoder.CanDecode()) {
+                    // Wait for the next key frame
+                    strmbuf = 0;
+                    continue;
+                }
+                if (!TileCoder.IsKeyFrame()) TileCoder.PreparePackedTiles();
+            }
+
             // Change part size and offset vector sizes if changed
             ComprPartOffset.SetSize(partcount);
             ComprPartSize.SetSize(partcount);
 
             // Calculate and store part sizes and offsets
             for (i = 0; i < partcount; i ++) {
+                if (used - strmoffset < sizeof(unsigned int)) break;
                 compressedpartsize = reinterpret_cast<unsigned int*>(strmbuf + strmoffset)[0];
                 strmoffset += sizeof(unsigned int);
+                if (used - strmoffset < compressedpartsize) break;
                 ComprPartSize[i]   = compressedpartsize;
                 ComprPartOffset[i] = strmoffset;
                 strmoffset += compressedpartsize;
             }
+            if (i < partcount) break;
 
             // Store compressed data buffer pointer
             comprBuffer = strmbuf;
@@ -564,26 +625,40 @@ int svlVideoCodecTCPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
     _SynchronizeThreads(procInfo);
     if (ReadError) return SVL_FAIL;
 
+    // Delta frames decompress into the packed tiles
+    svlSampleImage* target = &image;
+    unsigned int targetch = videoch;
+    if (TileCoded && !TileCoder.IsKeyFrame()) {
+        target = &(TileCoder.GetPackedTiles());
+        targetch = 0;
+    }
+    const unsigned int targetwidth = target->GetWidth(targetch);
+    const unsigned int targetheight = target->GetHeight(targetch);
+
+    // Decompression is bounded by the YUV buffer
+    if (Compressor == CVI &&
+        static_cast<unsigned long long>(targetwidth) * targetheight * 2 > yuvBufferSize) return SVL_FAIL;
+
     unsigned int size, start, end;
-    unsigned char *img = image.GetUCharPointer(videoch);
+    unsigned char *img = target->GetUCharPointer(targetch);
     partcount = static_cast<unsigned int>(ComprPartOffset.size());
     ret = SVL_OK;
 
     _ParallelLoop(procInfo, i, partcount)
     {
         while (1) {
-            ret = SVL_FAIL;
-
             // Compute part size and offset
-            size = Height / partcount + 1;
+            size = targetheight / partcount + 1;
             start = i * size;
-            if (start >= Height) break;
+            if (start >= targetheight) break;
             end = start + size;
-            if (end > Height) end = Height;
+            if (end > targetheight) end = targetheight;
+
+            ret = SVL_FAIL;
 
             if (Compressor == CVI) {
-                offset = start * Width * 2;
-                longsize = (end - start) * Width * 2;
+                offset = start * targetwidth * 2;
+                longsize = (end - start) * targetwidth * 2;
 
                 // Decompress frame part
                 if (uncompress(yuvBuffer + offset, &longsize, comprBuffer + ComprPartOffset[i], ComprPartSize[i]) != Z_OK) {
@@ -598,7 +673,7 @@ int svlVideoCodecTCPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
             else if (Compressor == JPEG) {
 
                 // Get sub-image reference
-                svlSampleImage *subimage = const_cast<svlSampleImage&>(image).GetSubImage(start, end - start, videoch);
+                svlSampleImage *subimage = target->GetSubImage(start, end - start, targetch);
 
                 // Decompress buffer into sub-image
                 if (svlImageIO::Read(subimage[0], 0, "jpg", comprBuffer + ComprPartOffset[i], ComprPartSize[i], true) != SVL_OK) {
@@ -616,6 +691,15 @@ int svlVideoCodecTCPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
         }
     }
 
+    if (TileCoded) {
+        _SynchronizeThreads(procInfo);
+
+        _OnSingleThread(procInfo)
+        {
+            if (ret == SVL_OK) ret = TileCoder.Decode(image, videoch);
+        }
+    }
+
     return ret;
 }
 
@@ -646,28 +730,53 @@ int svlVideoCodecTCPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
 
     const unsigned int procid = procInfo->ID;
     const unsigned int proccount = procInfo->count;
+    const CompressionData* config = reinterpret_cast<const CompressionData*>(&(Codec->data[0]));
+    const bool tiledelta = (config->KeyFrameEvery > 1);
     unsigned int i, start, end, size, offset;
-    unsigned char* strmbuf = SendBuffer[0]->GetPushBuffer();
+    unsigned char* strmbuf;
     unsigned long comprsize;
-    int compr = Codec->data[0];
+    int compr = config->Level;
+
+    // Delta frames compress the packed changed tiles only
+    const svlSampleImage* source = &image;
+    unsigned int sourcech = videoch;
+    if (tiledelta) {
+        _OnSingleThread(procInfo)
+        {
+            // Set by the server thread when a new client connects
+            if (KeyFrameRequested) {
+                KeyFrameRequested = false;
+                TileCoder.RequestKeyFrame();
+            }
+        }
+        if (TileCoder.Encode(procInfo, image, videoch) != SVL_OK) return SVL_FAIL;
+        if (!TileCoder.IsKeyFrame()) {
+            source = &(TileCoder.GetPackedTiles());
+            sourcech = 0;
+        }
+    }
+    const unsigned int sourcewidth = source->GetWidth(sourcech);
+    const unsigned int sourceheight = source->GetHeight(sourcech);
+
+    ComprPartSize[procid] = 0;
 
     // Multithreaded compression phase
     while (1) {
 
         // Compute part size and offset
-        size = Height / proccount + 1;
+        size = sourceheight / proccount + 1;
         comprsize = comprBufferSize / proccount;
         start = procid * size;
-        if (start >= Height) break;
+        if (start >= sourceheight) break;
         end = start + size;
-        if (end > Height) end = Height;
-        offset = start * Width;
-        size = Width * (end - start);
+        if (end > sourceheight) end = sourceheight;
+        offset = start * sourcewidth;
+        size = sourcewidth * (end - start);
         ComprPartOffset[procid] = procid * comprsize;
 
         if (Compressor == CVI) {
             // Convert RGB to YUV422 planar format
-            svlConverter::RGB24toYUV422P(const_cast<unsigned char*>(image.GetUCharPointer(videoch)) + offset * 3, yuvBuffer + offset * 2, size);
+            svlConverter::RGB24toYUV422P(const_cast<unsigned char*>(source->GetUCharPointer(sourcech)) + offset * 3, yuvBuffer + offset * 2, size);
 
             // Compress part
             if (compress2(comprBuffer + ComprPartOffset[procid], &comprsize, yuvBuffer + offset * 2, size * 2, compr) != Z_OK) {
@@ -677,7 +786,7 @@ int svlVideoCodecTCPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
         }
         else if (Compressor == JPEG) {
             // Get sub-image reference
-            svlSampleImage *subimage = const_cast<svlSampleImage&>(image).GetSubImage(start, end - start, videoch);
+            svlSampleImage *subimage = const_cast<svlSampleImage*>(source)->GetSubImage(start, end - start, sourcech);
 
             // Compress sub-image into buffer
             size_t csize = size * 2;
@@ -706,15 +815,22 @@ int svlVideoCodecTCPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
     _OnSingleThread(procInfo)
     {
         const double timestamp = image.GetTimestamp();
+        const unsigned int partcount = tiledelta ? (proccount | TILE_DELTA_FLAG) : proccount;
         unsigned int used;
 
+        // The frame is serialized once and shared by all clients
+        size = sizeof(unsigned int) * (4 + proccount) + sizeof(double);
+        if (tiledelta) size += TileCoder.GetHeaderSize();
+        for (i = 0; i < proccount; i ++) size += ComprPartSize[i];
+        Frame* frame = AcquireFrame(static_cast<unsigned int>(FrameStartMarker.length()) + size);
+        frame->KeyFrame = !tiledelta || TileCoder.IsKeyFrame();
+        strmbuf = frame->Data;
+
         // Add "frame start marker"
         memcpy(strmbuf, FrameStartMarker.c_str(), FrameStartMarker.length());
         used = static_cast<unsigned int>(FrameStartMarker.length());
 
         // Add "data size after frame start marker"
-        size = sizeof(unsigned int) * (4 + proccount) + sizeof(double);
-        for (i = 0; i < proccount; i ++) size += ComprPartSize[i];
         memcpy(strmbuf + used, &size, sizeof(unsigned int));
         used += sizeof(unsigned int);
 
@@ -731,9 +847,12 @@ int svlVideoCodecTCPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
         used += sizeof(double);
 
         // Add "partcount"
-        memcpy(strmbuf + used, &proccount, sizeof(unsigned int));
+        memcpy(strmbuf + used, &partcount, sizeof(unsigned int));
         used += sizeof(unsigned int);
 
+        // Add "tile header"
+        if (tiledelta) used += TileCoder.WriteHeader(strmbuf + used);
+
         for (i = 0; i < proccount; i ++) {
             // Add "compressed part size"
             memcpy(strmbuf + used, &(ComprPartSize[i]), sizeof(unsigned int));
@@ -744,14 +863,9 @@ int svlVideoCodecTCPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
             used += ComprPartSize[i];
         }
 
-        // Signal data sending threads
-        for (i = 1; i < MAX_CLIENTS; i ++) {
-            if (SendConnection[i] >= 0) {
-                memcpy(SendBuffer[i]->GetPushBuffer(), strmbuf, used);
-                SendBuffer[i]->Push(used);
-            }
-        }
-        SendBuffer[0]->Push(used);
+        // Hand the frame over to the server thread
+        frame->Size = used;
+        PublishFrame(frame);
 
 		EndPos ++; Pos ++;
     }
@@ -759,6 +873,31 @@ int svlVideoCodecTCPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
 	return SVL_OK;
 }
 
+int svlVideoCodecTCPStream::GetClientStatistics(std::vector<svlVideoIO::ClientStatistics> &stats) const
+{
+    if (!Opened || !Writing) return SVL_FAIL;
+
+    const double time = osaGetTime();
+    svlVideoIO::ClientStatistics client;
+
+    ServerCS.Enter();
+    stats.resize(Clients.size());
+    for (unsigned int i = 0; i < Clients.size(); i ++) {
+        client.address        = Clients[i].Address;
+        client.connectiontime = time - Clients[i].ConnectionTime;
+        client.framessent     = Clients[i].FramesSent;
+        client.framesdropped  = Clients[i].FramesDropped;
+        client.bytessent      = Clients[i].BytesSent;
+        client.bandwidth      = (client.connectiontime > 0.0) ? static_cast<double>(client.bytessent) / client.connectiontime : 0.0;
+        client.latency        = Clients[i].Latency;
+        client.averagelatency = Clients[i].FramesSent ? Clients[i].LatencySum / Clients[i].FramesSent : 0.0;
+        stats[i] = client;
+    }
+    ServerCS.Leave();
+
+    return SVL_OK;
+}
+
 void svlVideoCodecTCPStream::SetExtension(const std::string & extension)
 {
     if (Opened) {
@@ -811,8 +950,9 @@ void svlVideoCodecTCPStream::SetCompressionLevel(const int & compr_level)
     CMN_LOG_CLASS_INIT_VERBOSE << "SetCompressionLevel - called (" << compr_level << ")" << std::endl;
 
     svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
 
-    compr->data[0] = compr_level;
+    data->Level = static_cast<unsigned char>(compr_level);
 
     SetCompression(compr);
     svlVideoIO::ReleaseCompression(compr);
@@ -833,9 +973,26 @@ void svlVideoCodecTCPStream::SetDatarate(const int & CMN_UNUSED(datarate))
     CMN_LOG_CLASS_INIT_ERROR << "SetDatarate - feature is not supported by the TCP/IP Streamer codec" << std::endl;
 }
 
-void svlVideoCodecTCPStream::SetKeyFrameEvery(const int & CMN_UNUSED(key_every))
+void svlVideoCodecTCPStream::SetKeyFrameEvery(const int & key_every)
 {
-    CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - feature is not supported by the TCP/IP Streamer codec" << std::endl;
+    if (Opened) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - codec is already open" << std::endl;
+        return;
+    }
+    if (key_every < 0 || key_every > 65535) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - argument out of range [0, 65535]" << std::endl;
+        return;
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "SetKeyFrameEvery - called (" << key_every << ")" << std::endl;
+
+    svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
+
+    data->KeyFrameEvery = static_cast<unsigned short>(key_every);
+
+    SetCompression(compr);
+    svlVideoIO::ReleaseCompression(compr);
 }
 
 void svlVideoCodecTCPStream::IsCompressionLevelEnabled(bool & enabled) const
@@ -865,7 +1022,7 @@ void svlVideoCodecTCPStream::IsDatarateEnabled(bool & enabled) const
 void svlVideoCodecTCPStream::IsKeyFrameEveryEnabled(bool & enabled) const
 {
     CMN_LOG_CLASS_INIT_VERBOSE << "IsFramesEveryEnabled - called" << std::endl;
-    enabled = false;
+    enabled = true;
 }
 
 void svlVideoCodecTCPStream::GetCompressionLevel(int & compr_level) const
@@ -873,8 +1030,9 @@ void svlVideoCodecTCPStream::GetCompressionLevel(int & compr_level) const
     CMN_LOG_CLASS_INIT_VERBOSE << "GetCompressionLevel - called" << std::endl;
 
     svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
 
-    compr_level = compr->data[0];
+    compr_level = data->Level;
 
     svlVideoIO::ReleaseCompression(compr);
 }
@@ -911,8 +1069,14 @@ void svlVideoCodecTCPStream::GetDatarate(int & datarate) const
 
 void svlVideoCodecTCPStream::GetKeyFrameEvery(int & key_every) const
 {
-    CMN_LOG_CLASS_INIT_ERROR << "GetKeyFrameEvery - feature is not supported by the TCP/IP Streamer codec" << std::endl;
-    key_every = -1;
+    CMN_LOG_CLASS_INIT_VERBOSE << "GetKeyFrameEvery - called" << std::endl;
+
+    svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
+
+    key_every = data->KeyFrameEvery;
+
+    svlVideoIO::ReleaseCompression(compr);
 }
 
 void* svlVideoCodecTCPStream::ServerProc(unsigned short port)
@@ -1014,74 +1178,47 @@ void* svlVideoCodecTCPStream::ServerProc(unsigned short port)
         std::cerr << "svlVideoCodecTCPStream::ServerProc - listen success" << std::endl;
 #endif
 
-        ServerInitialized = true;
-        ServerInitEvent->Raise();
-
-        int connection;
+        // Clients are served from this thread with non-blocking sockets
+#if (CISST_OS == CISST_WINDOWS)
+        u_long nonblocking = 1;
+        ioctlsocket(ServerSocket, FIONBIO, &nonblocking);
+#else
+        fcntl(ServerSocket, F_SETFL, fcntl(ServerSocket, F_GETFL, 0) | O_NONBLOCK);
+#endif
 
-        // Create client pool
-        SendThread.SetSize(MAX_CLIENTS);
-        SendConnection.SetSize(MAX_CLIENTS);
-        KillSendThread.SetSize(MAX_CLIENTS);
-        for (clientid = 0; clientid < MAX_CLIENTS; clientid ++) {
-            SendThread[clientid]      = new osaThread;
-            SendConnection[clientid]  = -1;
-            KillSendThread[clientid]  = false;
+#if (CISST_OS == CISST_LINUX)
+        // The poll wakes up on new connections, on sockets becoming
+        // writable again and on new frames signaled through an event
+        ServerPoll = epoll_create(MAX_CLIENTS + 2);
+        ServerWakeup = eventfd(0, EFD_NONBLOCK);
+        if (ServerPoll < 0 || ServerWakeup < 0) {
+#ifdef _NET_VERBOSE_
+            std::cerr << "svlVideoCodecTCPStream::ServerProc - epoll initialization failed" << std::endl;
+#endif
+            break;
         }
+        epoll_event event;
+        memset(&event, 0, sizeof(epoll_event));
+        event.events = EPOLLIN;
+        event.data.fd = ServerSocket;
+        epoll_ctl(ServerPoll, EPOLL_CTL_ADD, ServerSocket, &event);
+        event.data.fd = ServerWakeup;
+        epoll_ctl(ServerPoll, EPOLL_CTL_ADD, ServerWakeup, &event);
+#endif
 
-        fd_set fds;
-        timeval tv;
+        ServerInitialized = true;
+        ServerInitEvent->Raise();
 
         while (!KillServerThread) {
 
-            // Wait 0.5s for new connection, then continue
-            FD_ZERO(&fds); FD_SET(ServerSocket, &fds);
-            tv.tv_sec  = 0; tv.tv_usec = 500000;
-            if (select(ServerSocket + 1, &fds, 0, 0, &tv) <= 0 || !FD_ISSET(ServerSocket, &fds)) {
-                continue;
-            }
-#ifdef _NET_VERBOSE_
-            std::cerr << "svlVideoCodecTCPStream::ServerProc - incoming connection..." << std::endl;
-#endif
-
-            connection = static_cast<int>(accept(ServerSocket, 0, 0));
-            if (connection < 0) {
-#ifdef _NET_VERBOSE_
-                std::cerr << "svlVideoCodecTCPStream::ServerProc - accept failed" << std::endl;
-#endif
-                continue;
-            }
-#ifdef _NET_VERBOSE_
-            std::cerr << "svlVideoCodecTCPStream::ServerProc - accept success" << std::endl;
-#endif
+            WaitForServerEvents();
+            AcceptClients();
 
-            // Find free client in the pool
             clientid = 0;
-            while (clientid < MAX_CLIENTS && SendConnection[clientid] >= 0) clientid ++;
-            if (clientid >= MAX_CLIENTS) {
-#ifdef _NET_VERBOSE_
-                std::cerr << "svlVideoCodecTCPStream::ServerProc - too many clients" << std::endl;
-#endif
-#if (CISST_OS == CISST_WINDOWS)
-                shutdown(connection, SD_BOTH);
-#else
-                shutdown(connection, SHUT_RDWR);
-#endif
-#if (CISST_OS == CISST_WINDOWS)
-                closesocket(connection);
-#else
-                close(connection);
-#endif
-                continue;
+            while (clientid < Clients.size()) {
+                if (SendToClient(Clients[clientid])) clientid ++;
+                else DisconnectClient(clientid);
             }
-#ifdef _NET_VERBOSE_
-            std::cerr << "svlVideoCodecTCPStream::ServerProc - thread (" << clientid << ") assigned to client" << std::endl;
-#endif
-
-            KillSendThread[clientid] = false;
-            SendConnection[clientid] = connection;
-            SendThread[clientid]->Create<svlVideoCodecTCPStream, unsigned int>(this, &svlVideoCodecTCPStream::SendProc, clientid);
-            // The thread will manage the shutdown and closing of the connection when done sending or terminated
         }
 
         break;
@@ -1091,14 +1228,7 @@ void* svlVideoCodecTCPStream::ServerProc(unsigned short port)
 #ifdef _NET_VERBOSE_
         std::cerr << "svlVideoCodecTCPStream::ServerProc - shutting down all connections" << std::endl;
 #endif
-        // Destroy client pool
-        for (clientid = 0; clientid < SendThread.size(); clientid ++) {
-            if (SendConnection[clientid] >= 0) {
-                KillSendThread[clientid] = true;
-                SendThread[clientid]->Wait();
-            }
-            delete SendThread[clientid];
-        }
+        while (!Clients.empty()) DisconnectClient(static_cast<unsigned int>(Clients.size()) - 1);
         ServerInitialized = false;
     }
     else {
@@ -1108,6 +1238,13 @@ void* svlVideoCodecTCPStream::ServerProc(unsigned short port)
         ServerInitEvent->Raise();
     }
 
+#if (CISST_OS == CISST_LINUX)
+    if (ServerWakeup >= 0) close(ServerWakeup);
+    if (ServerPoll >= 0) close(ServerPoll);
+#endif
+    ServerWakeup = -1;
+    ServerPoll = -1;
+
     if (socket_open) {
 #if (CISST_OS == CISST_WINDOWS)
         closesocket(ServerSocket);
@@ -1124,57 +1261,245 @@ void* svlVideoCodecTCPStream::ServerProc(unsigned short port)
     return this;
 }
 
-void* svlVideoCodecTCPStream::SendProc(unsigned int clientid)
+svlVideoCodecTCPStream::Frame* svlVideoCodecTCPStream::AcquireFrame(const unsigned int size)
 {
-    unsigned char* strmbuf;
-    unsigned int used;
-    int ret;
+    Frame* frame = 0;
+    unsigned int i;
+
+    ServerCS.Enter();
+    for (i = 0; i < FramePool.size(); i ++) {
+        if (FramePool[i]->RefCount == 0) {
+            frame = FramePool[i];
+            break;
+        }
+    }
+    if (!frame) {
+        frame = new Frame;
+        frame->Data = 0;
+        frame->BufferSize = 0;
+        FramePool.push_back(frame);
+    }
+    frame->Size = 0;
+    frame->RefCount = 1;
+    ServerCS.Leave();
+
+    if (frame->BufferSize < size) {
+        delete [] frame->Data;
+        frame->Data = new unsigned char[size];
+        frame->BufferSize = size;
+    }
+
+    return frame;
+}
+
+void svlVideoCodecTCPStream::ReleaseFrame(Frame* frame)
+{
+    // Called from within ServerCS
+    if (frame && frame->RefCount > 0) frame->RefCount --;
+}
+
+void svlVideoCodecTCPStream::PublishFrame(Frame* frame)
+{
+    ServerCS.Enter();
+    frame->Time = osaGetTime();
+    for (unsigned int i = 0; i < Clients.size(); i ++) {
+        Client& client = Clients[i];
+        if (client.WaitingForKeyFrame) {
+            if (!frame->KeyFrame) continue;
+            client.WaitingForKeyFrame = false;
+        }
+        if (client.Next) {
+            // The client has not started sending the previous frame yet
+            ReleaseFrame(client.Next);
+            client.FramesDropped ++;
+        }
+        client.Next = frame;
+        frame->RefCount ++;
+    }
+    // Reference held by the writer
+    ReleaseFrame(frame);
+    ServerCS.Leave();
+
+#if (CISST_OS == CISST_LINUX)
+    if (ServerWakeup >= 0) {
+        const unsigned long long count = 1;
+        if (write(ServerWakeup, &count, sizeof(count)) < 0) {
+            // The event counter is already signaled
+        }
+    }
+#endif
+}
 
-    while (!KillSendThread[clientid]) {
+void svlVideoCodecTCPStream::WaitForServerEvents()
+{
+#if (CISST_OS == CISST_LINUX)
+    epoll_event events[MAX_CLIENTS + 2];
+    const int count = epoll_wait(ServerPoll, events, MAX_CLIENTS + 2, 100);
+    for (int i = 0; i < count; i ++) {
+        if (events[i].data.fd == ServerWakeup) {
+            unsigned long long value;
+            if (read(ServerWakeup, &value, sizeof(value)) < 0) {
+                // Nothing to clear
+            }
+        }
+    }
+#else
+    // Without an event to wake up on, new frames are picked up on timeout
+    fd_set readfds, writefds;
+    int maxfd = ServerSocket;
+    timeval tv;
+
+    FD_ZERO(&readfds);
+    FD_ZERO(&writefds);
+    FD_SET(ServerSocket, &readfds);
+    ServerCS.Enter();
+    for (unsigned int i = 0; i < Clients.size(); i ++) {
+        if (Clients[i].Current || Clients[i].Next) {
+            FD_SET(Clients[i].Socket, &writefds);
+            if (Clients[i].Socket > maxfd) maxfd = Clients[i].Socket;
+        }
+    }
+    ServerCS.Leave();
+    tv.tv_sec  = 0;
+    tv.tv_usec = 5000;
+    select(maxfd + 1, &readfds, &writefds, 0, &tv);
+#endif
+}
 
-        // Wait until new frame is acquired
-        strmbuf = 0;
-        while (!strmbuf && !KillSendThread[clientid]) {
-            strmbuf = SendBuffer[clientid]->Pull(used, 0.1);
+void svlVideoCodecTCPStream::AcceptClients()
+{
+    sockaddr_in address;
+    socklen_t addrlen;
+    int connection;
+
+    while (1) {
+        addrlen = sizeof(sockaddr_in);
+        connection = static_cast<int>(accept(ServerSocket, (sockaddr*)(&address), &addrlen));
+        if (connection < 0) break;
+
+        if (Clients.size() >= MAX_CLIENTS) {
+#ifdef _NET_VERBOSE_
+            std::cerr << "svlVideoCodecTCPStream::AcceptClients - too many clients" << std::endl;
+#endif
+#if (CISST_OS == CISST_WINDOWS)
+            shutdown(connection, SD_BOTH);
+            closesocket(connection);
+#else
+            shutdown(connection, SHUT_RDWR);
+            close(connection);
+#endif
+            continue;
         }
 
+#if (CISST_OS == CISST_WINDOWS)
+        u_long nonblocking = 1;
+        ioctlsocket(connection, FIONBIO, &nonblocking);
+#else
+        fcntl(connection, F_SETFL, fcntl(connection, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+#if (CISST_OS == CISST_LINUX)
+        // Edge triggered: reported once each time the send buffer drains
+        epoll_event event;
+        memset(&event, 0, sizeof(epoll_event));
+        event.events = EPOLLOUT | EPOLLET;
+        event.data.fd = connection;
+        epoll_ctl(ServerPoll, EPOLL_CTL_ADD, connection, &event);
+#endif
+
+        Client client;
+        client.Socket         = connection;
+        client.Address        = inet_ntoa(address.sin_addr);
+        client.Current        = 0;
+        client.Next           = 0;
+        client.Sent           = 0;
+        client.ConnectionTime = osaGetTime();
+        client.FramesSent     = 0;
+        client.FramesDropped  = 0;
+        client.BytesSent      = 0;
+        client.Latency        = 0.0;
+        client.LatencySum     = 0.0;
+        client.WaitingForKeyFrame = true;
+
+        ServerCS.Enter();
+        Clients.push_back(client);
+        ServerCS.Leave();
+        KeyFrameRequested = true;
+
 #ifdef _NET_VERBOSE_
-        std::cerr << "svlVideoCodecTCPStream::SendProc - sending frame (" << used << " bytes)" << std::endl;
+        std::cerr << "svlVideoCodecTCPStream::AcceptClients - client connected (" << client.Address << ", "
+                  << Clients.size() << " clients)" << std::endl;
 #endif
+    }
+}
+
+bool svlVideoCodecTCPStream::SendToClient(Client& client)
+{
+    // Only the server thread changes 'Current' and 'Sent'
+    double time;
+    int ret, err;
+
+    while (1) {
 
-        while (used > 0) {
-            ret = send(SendConnection[clientid], reinterpret_cast<const char*>(strmbuf), used, 0);
+        if (!client.Current) {
+            ServerCS.Enter();
+            client.Current = client.Next;
+            client.Next = 0;
+            ServerCS.Leave();
+            if (!client.Current) return true;
+            client.Sent = 0;
+        }
 
+        while (client.Sent < client.Current->Size) {
+            ret = send(client.Socket,
+                       reinterpret_cast<const char*>(client.Current->Data + client.Sent),
+                       client.Current->Size - client.Sent,
+                       __SENDFLAGS);
             if (ret < 0) {
+                err = __errno;
+                if (err == __EWOULDBLOCK || err == __EAGAIN) return true;
 #ifdef _NET_VERBOSE_
-                std::cerr << "svlVideoCodecTCPStream::SendProc - send failed (" << __errno << ")" << std::endl;
+                std::cerr << "svlVideoCodecTCPStream::SendToClient - send failed (" << err << ")" << std::endl;
 #endif
-                KillSendThread[clientid] = true;
-                break;
+                return false;
             }
-
-            strmbuf += ret;
-            used -= ret;
+            client.Sent += ret;
         }
+
+        time = osaGetTime();
+
+        ServerCS.Enter();
+        client.FramesSent ++;
+        client.BytesSent  += client.Current->Size;
+        client.Latency     = time - client.Current->Time;
+        client.LatencySum += client.Latency;
+        ReleaseFrame(client.Current);
+        client.Current = 0;
+        ServerCS.Leave();
     }
+}
+
+void svlVideoCodecTCPStream::DisconnectClient(const unsigned int clientid)
+{
+    const int connection = Clients[clientid].Socket;
 
 #if (CISST_OS == CISST_WINDOWS)
-    shutdown(SendConnection[clientid], SD_BOTH);
-#else
-    shutdown(SendConnection[clientid], SHUT_RDWR);
-#endif
-#if (CISST_OS == CISST_WINDOWS)
-    closesocket(SendConnection[clientid]);
+    shutdown(connection, SD_BOTH);
+    closesocket(connection);
 #else
-    close(SendConnection[clientid]);
+    shutdown(connection, SHUT_RDWR);
+    close(connection);
 #endif
-    SendConnection[clientid] = -1;
+
+    ServerCS.Enter();
+    ReleaseFrame(Clients[clientid].Current);
+    ReleaseFrame(Clients[clientid].Next);
+    Clients.erase(Clients.begin() + clientid);
+    ServerCS.Leave();
 
 #ifdef _NET_VERBOSE_
-    std::cerr << "svlVideoCodecTCPStream::SendProc - client (" << clientid << ") shut down" << std::endl;
+    std::cerr << "svlVideoCodecTCPStream::DisconnectClient - client (" << clientid << ") shut down" << std::endl;
 #endif
-
-    return this;
 }
 
 void* svlVideoCodecTCPStream::ReceiveProc(int CMN_UNUSED(param))
@@ -1419,7 +1744,7 @@ int svlVideoCodecTCPStream::Receive()
                     offset += sizeof(unsigned int);
                     const unsigned int h = reinterpret_cast<unsigned int*>(buffer + offset)[0];
 
-                    size = w * h * 2;
+                    size = svlTileDeltaCoder::GetPaddedSize(w, h) * 2;
                     if (yuvBuffer && yuvBufferSize < size) {
                         delete [] yuvBuffer;
                         yuvBuffer = 0;
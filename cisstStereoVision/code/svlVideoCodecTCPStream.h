@@ -24,9 +24,13 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstOSAbstraction/osaThread.h>
 #include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
 #include <cisstStereoVision/svlVideoIO.h>
 #include <cisstStereoVision/svlBufferMemory.h>
 #include <cisstStereoVision/svlTypes.h>
+#include <vector>
+
+#include "svlTileDeltaCoder.h"
 
 
 class svlVideoCodecTCPStream : public svlVideoCodecBase
@@ -39,6 +43,12 @@ public:
         JPEG
     };
 
+    typedef struct _CompressionData {
+        unsigned char  Level;
+        unsigned char  Reserved;
+        unsigned short KeyFrameEvery;   // >1: only changed tiles are sent between key frames
+    } CompressionData;
+
     svlVideoCodecTCPStream();
     virtual ~svlVideoCodecTCPStream();
 
@@ -61,6 +71,8 @@ public:
     virtual int Read(svlProcInfo* procInfo, svlSampleImage &image, const unsigned int videoch, const bool noresize = false);
     virtual int Write(svlProcInfo* procInfo, const svlSampleImage &image, const unsigned int videoch);
 
+    virtual int GetClientStatistics(std::vector<svlVideoIO::ClientStatistics> &stats) const;
+
 public:
     virtual void SetExtension(const std::string & extension);
     virtual void SetEncoderID(const int & encoder_id);
@@ -109,6 +121,9 @@ protected:
     unsigned int comprBufferSize;
     vctDynamicVector<unsigned int> ComprPartOffset;
     vctDynamicVector<unsigned int> ComprPartSize;
+    svlTileDeltaCoder TileCoder;
+    bool TileCoded;
+    bool KeyFrameRequested;
 
     int ServerSocket;
     osaThread* ServerThread;
@@ -119,10 +134,42 @@ protected:
     bool ReadError;
     svlBufferMemory* ReceiveBuffer;
 
-    vctDynamicVector<svlBufferMemory*> SendBuffer;
-    vctDynamicVector<osaThread*> SendThread;
-    vctDynamicVector<int> SendConnection;
-    vctDynamicVector<bool> KillSendThread;
+    // Encoded frame shared by all clients; released when no client
+    // refers to it any more
+    struct Frame
+    {
+        unsigned char* Data;
+        unsigned int Size;
+        unsigned int BufferSize;
+        unsigned int RefCount;
+        double Time;
+        bool KeyFrame;
+    };
+
+    // Each client sends at most one frame at a time and keeps only the
+    // latest frame waiting; older waiting frames are dropped.
+    // New clients skip delta frames until the next key frame.
+    struct Client
+    {
+        int Socket;
+        std::string Address;
+        Frame* Current;
+        Frame* Next;
+        unsigned int Sent;
+        double ConnectionTime;
+        unsigned int FramesSent;
+        unsigned int FramesDropped;
+        unsigned long long BytesSent;
+        double Latency;
+        double LatencySum;
+        bool WaitingForKeyFrame;
+    };
+
+    std::vector<Frame*> FramePool;
+    std::vector<Client> Clients;
+    mutable osaCriticalSection ServerCS;
+    int ServerPoll;
+    int ServerWakeup;
 
     int ReceiveSocket;
     osaThread* ReceiveThread;
@@ -137,7 +184,13 @@ protected:
 
     void  CloseSocket();
     void* ServerProc(unsigned short port);
-    void* SendProc(unsigned int clientid);
+    Frame* AcquireFrame(const unsigned int size);
+    void  ReleaseFrame(Frame* frame);
+    void  PublishFrame(Frame* frame);
+    void  WaitForServerEvents();
+    void  AcceptClients();
+    bool  SendToClient(Client& client);
+    void  DisconnectClient(const unsigned int clientid);
     void* ReceiveProc(int param);
     int   Receive();
     int   FindFrameHeader(unsigned char* data1, const unsigned char* data2, unsigned int size);
@@ -90,6 +90,7 @@ struct PacketHeaderType {
 
 #define PACKET_SIZE			1316u
 #define	DATA_SIZE			(PACKET_SIZE - sizeof(PacketHeaderType))
+#define TILE_DELTA_FLAG     0x80000000u   // in the part count: tile header follows
 #define BROKEN_FRAME        1
 
 #define MAX_RATE			120 //in Mbps
@@ -149,6 +150,9 @@ svlVideoCodecUDPStream::svlVideoCodecUDPStream() :
 
     TimeServer = new osaTimeServer();
     //TimeServer->SetTimeOrigin();
+
+    ProcInfoSingleThread.count = 1;
+    ProcInfoSingleThread.ID    = 0;
 }
 
 svlVideoCodecUDPStream::~svlVideoCodecUDPStream()
@@ -179,6 +183,7 @@ int svlVideoCodecUDPStream::Open(const std::string &filename, unsigned int &widt
         delete [] yuvBuffer;
         yuvBuffer = 0;
         yuvBufferSize = 0;
+        TileCoder.Reset();
 
         // Start data receiving thread
         ReceiveInitialized = false;
@@ -215,15 +220,7 @@ int svlVideoCodecUDPStream::Create(const std::string &filename, const unsigned i
 
     if (!Codec) {
         // Set default compression level to 4
-        Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[sizeof(svlVideoIO::Compression)]);
-        std::string name("CISST Video Stream over UDP");
-        memset(&(Codec->extension[0]), 0, 16);
-        memcpy(&(Codec->extension[0]), ".ucvi", 3);
-        memset(&(Codec->name[0]), 0, 64);
-        memcpy(&(Codec->name[0]), name.c_str(), std::min(static_cast<int>(name.length()), 63));
-        Codec->size = sizeof(svlVideoIO::Compression);
-        Codec->datasize = 1;
-        Codec->data[0] = 4;
+        Codec = GetCompression();
     }
 
     unsigned int size;
@@ -233,8 +230,9 @@ int svlVideoCodecUDPStream::Create(const std::string &filename, const unsigned i
         Opened = true;
 	    Writing = true;
 
-        // Allocate YUV buffer if not done yet
-        size = width * height * 2;
+        // Allocate YUV buffer if not done yet; large enough for the packed
+        // tiles of delta frames too
+        size = svlTileDeltaCoder::GetPaddedSize(width, height) * 2;
         if (!yuvBuffer) {
             yuvBuffer = new unsigned char[size];
             yuvBufferSize = size;
@@ -246,7 +244,7 @@ int svlVideoCodecUDPStream::Create(const std::string &filename, const unsigned i
         }
 
         // Allocate compression buffer if not done yet
-        size = width * height * 3;
+        size = svlTileDeltaCoder::GetPaddedSize(width, height) * 3;
         size += size / 100 + 4096;
         if (!comprBuffer) {
             comprBuffer = new unsigned char[size];
@@ -277,6 +275,10 @@ int svlVideoCodecUDPStream::Create(const std::string &filename, const unsigned i
         ServerInitEvent->Wait();
         if (ServerInitialized == false) break;
 
+        // Frames lost on the network only affect the image until the next key frame
+        TileCoder.Reset();
+        TileCoder.SetKeyFrameInterval(reinterpret_cast<CompressionData*>(&(Codec->data[0]))->KeyFrameEvery);
+
         BegPos = EndPos = Pos = 0;
         Width = width;
         Height = height;
@@ -346,18 +348,26 @@ svlVideoIO::Compression* svlVideoCodecUDPStream::GetCompression() const
 {
     // The caller will need to release it by calling the
     // svlVideoIO::ReleaseCompression() method
-    unsigned int size = sizeof(svlVideoIO::Compression);
+    unsigned int size = sizeof(svlVideoIO::Compression) - sizeof(unsigned char) + sizeof(CompressionData);
     svlVideoIO::Compression* compression = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[size]);
+    CompressionData* output_data = reinterpret_cast<CompressionData*>(&(compression->data[0]));
 
     std::string name("CISST Video Stream over UDP");
     memset(&(compression->extension[0]), 0, 16);
-    memcpy(&(compression->extension[0]), ".ucvi", 3);
+    memcpy(&(compression->extension[0]), ".ucvi", 5);
     memset(&(compression->name[0]), 0, 64);
     memcpy(&(compression->name[0]), name.c_str(), std::min(static_cast<int>(name.length()), 63));
     compression->size = size;
-    compression->datasize = 1;
-    if (Codec) compression->data[0] = Codec->data[0];
-    else compression->data[0] = 4; // Set default compression level to 4
+    compression->datasize = sizeof(CompressionData);
+    if (Codec) {
+        memcpy(output_data, &(Codec->data[0]), sizeof(CompressionData));
+    }
+    else {
+        // Set default compression level to 4, no tile delta coding
+        output_data->Level         = 4;
+        output_data->Reserved      = 0;
+        output_data->KeyFrameEvery = 0;
+    }
 
     return compression;
 }
@@ -374,17 +384,25 @@ int svlVideoCodecUDPStream::SetCompression(const svlVideoIO::Compression *compre
         return SVL_FAIL;
     }
 
+    const CompressionData* input_data = reinterpret_cast<const CompressionData*>(&(compression->data[0]));
+    // Maintaining compatibility with the single byte version of the structure
+    const unsigned short keyframeevery = (compression->datasize >= sizeof(CompressionData)) ? input_data->KeyFrameEvery : 0;
+
     svlVideoIO::ReleaseCompression(Codec);
-    Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[sizeof(svlVideoIO::Compression)]);
+    unsigned int size = sizeof(svlVideoIO::Compression) - sizeof(unsigned char) + sizeof(CompressionData);
+    Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[size]);
+    CompressionData* local_data = reinterpret_cast<CompressionData*>(&(Codec->data[0]));
 
     std::string name("CISST Video Stream over UDP");
     memset(&(Codec->extension[0]), 0, 16);
     memset(&(Codec->name[0]), 0, 64);
     memcpy(&(Codec->name[0]), name.c_str(), std::min(static_cast<int>(name.length()), 63));
-    Codec->size = sizeof(svlVideoIO::Compression);
-    Codec->datasize = 1;
-    if (compression->data[0] <= 9) Codec->data[0] = compression->data[0];
-    else Codec->data[0] = 4;
+    Codec->size = size;
+    Codec->datasize = sizeof(CompressionData);
+    if (input_data->Level <= 9) local_data->Level = input_data->Level;
+    else local_data->Level = 4;
+    local_data->Reserved      = 0;
+    local_data->KeyFrameEvery = keyframeevery;
 
     return SVL_OK;
 }
@@ -399,17 +417,33 @@ int svlVideoCodecUDPStream::DialogCompression()
     level -= '0';
     std::cout << level << std::endl;
 
+    int keyframeevery;
+    char input[256];
+    std::cout << " # Enter key frame interval for sending changed tiles only (0 or 1: disabled; default=0): ";
+    std::cin.getline(input, 256);
+    if (std::cin.gcount() > 1) {
+        keyframeevery = atoi(input);
+        if (keyframeevery < 0) keyframeevery = 0;
+        if (keyframeevery > 65535) keyframeevery = 65535;
+    }
+    else keyframeevery = 0;
+    std::cout << "    Key frame interval = " << keyframeevery << std::endl;
+
     svlVideoIO::ReleaseCompression(Codec);
-    Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[sizeof(svlVideoIO::Compression)]);
+    unsigned int size = sizeof(svlVideoIO::Compression) - sizeof(unsigned char) + sizeof(CompressionData);
+    Codec = reinterpret_cast<svlVideoIO::Compression*>(new unsigned char[size]);
+    CompressionData* local_data = reinterpret_cast<CompressionData*>(&(Codec->data[0]));
 
     std::string name("CISST Video Stream over UDP");
     memset(&(Codec->extension[0]), 0, 16);
-    memcpy(&(Codec->extension[0]), ".ucvi", 3);
+    memcpy(&(Codec->extension[0]), ".ucvi", 5);
     memset(&(Codec->name[0]), 0, 64);
     memcpy(&(Codec->name[0]), name.c_str(), std::min(static_cast<int>(name.length()), 63));
-    Codec->size = sizeof(svlVideoIO::Compression);
-    Codec->datasize = 1;
-    Codec->data[0] = static_cast<unsigned char>(level);
+    Codec->size = size;
+    Codec->datasize = sizeof(CompressionData);
+    local_data->Level         = static_cast<unsigned char>(level);
+    local_data->Reserved      = 0;
+    local_data->KeyFrameEvery = static_cast<unsigned short>(keyframeevery);
 
 	return SVL_OK;
 }
@@ -435,18 +469,24 @@ int svlVideoCodecUDPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
     // Uses only a single thread
     if (procInfo && procInfo->ID != 0) return SVL_OK;
 
-    unsigned int i, used, width, height, partcount, compressedpartsize, offset = 0, strmoffset;
+    unsigned int i, used, headersize, width, height, partcount, compressedpartsize, offset = 0, strmoffset, targetch, targetsize;
     unsigned long longsize;
-    unsigned char *img, *strmbuf = 0;
+    unsigned char *img, *strmbuf;
+    svlSampleImage *target;
+    bool tilecoded;
     int ret = SVL_FAIL;
 
-    // Wait until new frame is received
-    while (!strmbuf) {
-        strmbuf = ReceiveBuffer->Pull(used, 0.1);
-    }
-    if (!strmbuf || !used) return SVL_FAIL;
-
     while (1) {
+        // Wait until new frame is received
+        strmbuf = 0;
+        while (!strmbuf) {
+            strmbuf = ReceiveBuffer->Pull(used, 0.1);
+        }
+        if (!used) break;
+
+        // Fixed size frame header
+        if (used < FrameStartMarker.length() + 4 * sizeof(unsigned int) + sizeof(double)) break;
+
         // file start marker
         strmoffset = static_cast<unsigned int>(FrameStartMarker.length());
 
@@ -470,6 +510,9 @@ int svlVideoCodecUDPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
         // part count
         partcount = reinterpret_cast<unsigned int*>(strmbuf + strmoffset)[0];
         strmoffset += sizeof(unsigned int);
+        tilecoded = ((partcount & TILE_DELTA_FLAG) != 0);
+        partcount &= ~TILE_DELTA_FLAG;
+        if (partcount > (used - strmoffset) / sizeof(unsigned int)) break;
 
         // Allocate image buffer if not done yet
         if (width != image.GetWidth(videoch) || height != image.GetHeight(videoch)) {
@@ -477,15 +520,36 @@ int svlVideoCodecUDPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
             image.SetSize(videoch, width, height);
         }
 
+        // Tile header; delta frames decompress into the packed tiles
+        target = &image;
+        targetch = videoch;
         img = image.GetUCharPointer(videoch);
+        if (tilecoded) {
+            headersize = TileCoder.ReadHeader(strmbuf + strmoffset, used - strmoffset, width, height);
+            if (headersize == 0) break;
+            strmoffset += headersize;
+            // Frames before the first key frame cannot be decoded
+            if (!TileCoder.CanDecode()) continue;
+            if (!TileCoder.IsKeyFrame()) {
+                target = &(TileCoder.PreparePackedTiles());
+                targetch = 0;
+                img = target->GetUCharPointer();
+            }
+        }
+
+        // Decompression is bounded by the target image in YUV422P terms
+        targetsize = target->GetWidth(targetch) * target->GetHeight(targetch) * 2;
+        if (targetsize > yuvBufferSize) targetsize = yuvBufferSize;
 
         for (i = 0; i < partcount; i ++) {
             // compressed part size
+            if (used - strmoffset < sizeof(unsigned int)) break;
             compressedpartsize = reinterpret_cast<unsigned int*>(strmbuf + strmoffset)[0];
             strmoffset += sizeof(unsigned int);
+            if (compressedpartsize > used - strmoffset || offset >= targetsize) break;
 
             // Decompress frame part
-            longsize = yuvBufferSize - offset;
+            longsize = targetsize - offset;
             if (uncompress(yuvBuffer + offset, &longsize, strmbuf + strmoffset, compressedpartsize) != Z_OK) break;
 
             // Convert YUV422 planar to RGB format
@@ -494,7 +558,12 @@ int svlVideoCodecUDPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
             strmoffset += compressedpartsize;
             offset += longsize;
         }
-        if (i < PartCount) break;
+        if (i < partcount) break;
+
+        if (tilecoded) {
+            ret = TileCoder.Decode(image, videoch);
+            break;
+        }
 
         ret = SVL_OK;
 
@@ -506,6 +575,8 @@ int svlVideoCodecUDPStream::Read(svlProcInfo* procInfo, svlSampleImage &image, c
 
 int svlVideoCodecUDPStream::Write(svlProcInfo* procInfo, const svlSampleImage &image, const unsigned int videoch)
 {
+    if (!procInfo) procInfo = &ProcInfoSingleThread;
+
     if (videoch >= image.GetVideoChannels()) return SVL_FAIL;
     if (!Opened || !Writing) return SVL_FAIL;
 	if (Width != image.GetWidth(videoch) || Height != image.GetHeight(videoch)) return SVL_FAIL;
@@ -529,27 +600,44 @@ int svlVideoCodecUDPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
 
     const unsigned int procid = procInfo->ID;
     const unsigned int proccount = procInfo->count;
+    const CompressionData* config = reinterpret_cast<const CompressionData*>(&(Codec->data[0]));
+    const bool tiledelta = (config->KeyFrameEvery > 1);
     unsigned int i, start, end, size, offset;
     unsigned char* strmbuf = SendBuffer->GetPushBuffer();
     unsigned long comprsize;
-    int compr = Codec->data[0];
+    int compr = config->Level;
+
+    // Delta frames compress the packed changed tiles only
+    const svlSampleImage* source = &image;
+    unsigned int sourcech = videoch;
+    if (tiledelta) {
+        if (TileCoder.Encode(procInfo, image, videoch) != SVL_OK) return SVL_FAIL;
+        if (!TileCoder.IsKeyFrame()) {
+            source = &(TileCoder.GetPackedTiles());
+            sourcech = 0;
+        }
+    }
+    const unsigned int sourcewidth = source->GetWidth(sourcech);
+    const unsigned int sourceheight = source->GetHeight(sourcech);
+
+    ComprPartSize[procid] = 0;
 
     // Multithreaded compression phase
     while (1) {
 
         // Compute part size and offset
-        size = Height / proccount + 1;
+        size = sourceheight / proccount + 1;
         comprsize = comprBufferSize / proccount;
         start = procid * size;
-        if (start >= Height) break;
+        if (start >= sourceheight) break;
         end = start + size;
-        if (end > Height) end = Height;
-        offset = start * Width;
-        size = Width * (end - start);
+        if (end > sourceheight) end = sourceheight;
+        offset = start * sourcewidth;
+        size = sourcewidth * (end - start);
         ComprPartOffset[procid] = procid * comprsize;
 
         // Convert RGB to YUV422 planar format
-        svlConverter::RGB24toYUV422P(const_cast<unsigned char*>(image.GetUCharPointer(videoch)) + offset * 3, yuvBuffer + offset * 2, size);
+        svlConverter::RGB24toYUV422P(const_cast<unsigned char*>(source->GetUCharPointer(sourcech)) + offset * 3, yuvBuffer + offset * 2, size);
 
         // Compress part
         if (compress2(comprBuffer + ComprPartOffset[procid], &comprsize, yuvBuffer + offset * 2, size * 2, compr) != Z_OK) {
@@ -570,6 +658,7 @@ int svlVideoCodecUDPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
     _OnSingleThread(procInfo)
     {
         const double timestamp = image.GetTimestamp();
+        const unsigned int partcount = tiledelta ? (proccount | TILE_DELTA_FLAG) : proccount;
         unsigned int used;
 
         // Add "frame start marker"
@@ -578,6 +667,7 @@ int svlVideoCodecUDPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
 
         // Add "data size after frame start marker"
         size = sizeof(unsigned int) * (4 + proccount) + sizeof(double);
+        if (tiledelta) size += TileCoder.GetHeaderSize();
         for (i = 0; i < proccount; i ++) size += ComprPartSize[i];
         memcpy(strmbuf + used, &size, sizeof(unsigned int));
         used += sizeof(unsigned int);
@@ -595,9 +685,12 @@ int svlVideoCodecUDPStream::Write(svlProcInfo* procInfo, const svlSampleImage &i
         used += sizeof(double);
 
         // Add "partcount"
-        memcpy(strmbuf + used, &proccount, sizeof(unsigned int));
+        memcpy(strmbuf + used, &partcount, sizeof(unsigned int));
         used += sizeof(unsigned int);
 
+        // Add "tile header"
+        if (tiledelta) used += TileCoder.WriteHeader(strmbuf + used);
+
         for (i = 0; i < proccount; i ++) {
             // Add "compressed part size"
             memcpy(strmbuf + used, &(ComprPartSize[i]), sizeof(unsigned int));
@@ -640,8 +733,9 @@ void svlVideoCodecUDPStream::SetCompressionLevel(const int & compr_level)
     CMN_LOG_CLASS_INIT_VERBOSE << "SetCompressionLevel - called (" << compr_level << ")" << std::endl;
 
     svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
 
-    compr->data[0] = compr_level;
+    data->Level = static_cast<unsigned char>(compr_level);
 
     SetCompression(compr);
     svlVideoIO::ReleaseCompression(compr);
@@ -662,9 +756,26 @@ void svlVideoCodecUDPStream::SetDatarate(const int & CMN_UNUSED(datarate))
     CMN_LOG_CLASS_INIT_ERROR << "SetDatarate - feature is not supported by the UDP Streamer codec" << std::endl;
 }
 
-void svlVideoCodecUDPStream::SetKeyFrameEvery(const int & CMN_UNUSED(key_every))
+void svlVideoCodecUDPStream::SetKeyFrameEvery(const int & key_every)
 {
-    CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - feature is not supported by the UDP Streamer codec" << std::endl;
+    if (Opened) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - codec is already open" << std::endl;
+        return;
+    }
+    if (key_every < 0 || key_every > 65535) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetKeyFrameEvery - argument out of range [0, 65535]" << std::endl;
+        return;
+    }
+
+    CMN_LOG_CLASS_INIT_VERBOSE << "SetKeyFrameEvery - called (" << key_every << ")" << std::endl;
+
+    svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
+
+    data->KeyFrameEvery = static_cast<unsigned short>(key_every);
+
+    SetCompression(compr);
+    svlVideoIO::ReleaseCompression(compr);
 }
 
 void svlVideoCodecUDPStream::IsCompressionLevelEnabled(bool & enabled) const
@@ -694,7 +805,7 @@ void svlVideoCodecUDPStream::IsDatarateEnabled(bool & enabled) const
 void svlVideoCodecUDPStream::IsKeyFrameEveryEnabled(bool & enabled) const
 {
     CMN_LOG_CLASS_INIT_VERBOSE << "IsFramesEveryEnabled - called" << std::endl;
-    enabled = false;
+    enabled = true;
 }
 
 void svlVideoCodecUDPStream::GetCompressionLevel(int & compr_level) const
@@ -702,8 +813,9 @@ void svlVideoCodecUDPStream::GetCompressionLevel(int & compr_level) const
     CMN_LOG_CLASS_INIT_VERBOSE << "GetCompressionLevel - called" << std::endl;
 
     svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
 
-    compr_level = compr->data[0];
+    compr_level = data->Level;
 
     svlVideoIO::ReleaseCompression(compr);
 }
@@ -740,8 +852,14 @@ void svlVideoCodecUDPStream::GetDatarate(int & datarate) const
 
 void svlVideoCodecUDPStream::GetKeyFrameEvery(int & key_every) const
 {
-    CMN_LOG_CLASS_INIT_ERROR << "GetKeyFrameEvery - feature is not supported by the UDP Streamer codec" << std::endl;
-    key_every = -1;
+    CMN_LOG_CLASS_INIT_VERBOSE << "GetKeyFrameEvery - called" << std::endl;
+
+    svlVideoIO::Compression* compr = GetCompression();
+    CompressionData* data = reinterpret_cast<CompressionData*>(&(compr->data[0]));
+
+    key_every = data->KeyFrameEvery;
+
+    svlVideoIO::ReleaseCompression(compr);
 }
 
 void* svlVideoCodecUDPStream::ServerProc(unsigned short port)
@@ -1139,7 +1257,7 @@ void* svlVideoCodecUDPStream::Receive(int CMN_UNUSED(param))
                     offset += sizeof(unsigned int);
                     const unsigned int h = reinterpret_cast<unsigned int*>(localbuf + offset)[0];
 
-                    size = w * h * 2;
+                    size = svlTileDeltaCoder::GetPaddedSize(w, h) * 2;
                     if (yuvBuffer && yuvBufferSize < size) {
                         delete [] yuvBuffer;
                         yuvBuffer = 0;
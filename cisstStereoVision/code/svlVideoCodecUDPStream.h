@@ -29,6 +29,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlBufferMemory.h>
 #include <cisstStereoVision/svlTypes.h>
 
+#include "svlTileDeltaCoder.h"
+
 #if (CISST_OS == CISST_WINDOWS)
     #include <winsock2.h>
     #include <ws2tcpip.h>
@@ -46,6 +48,12 @@ class svlVideoCodecUDPStream : public svlVideoCodecBase
     CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION, CMN_LOG_LOD_RUN_ERROR);
 
 public:
+    typedef struct _CompressionData {
+        unsigned char  Level;
+        unsigned char  Reserved;
+        unsigned short KeyFrameEvery;   // >1: only changed tiles are sent between key frames
+    } CompressionData;
+
     svlVideoCodecUDPStream();
     virtual ~svlVideoCodecUDPStream();
 
@@ -107,6 +115,8 @@ protected:
     bool Writing;
     double Timestamp;
 
+    svlProcInfo ProcInfoSingleThread;
+
     char* PacketData;
     unsigned char* yuvBuffer;
     unsigned int yuvBufferSize;
@@ -114,6 +124,7 @@ protected:
     unsigned int comprBufferSize;
     vctDynamicVector<unsigned int> ComprPartOffset;
     vctDynamicVector<unsigned int> ComprPartSize;
+    svlTileDeltaCoder TileCoder;
 
     sockaddr_in SendAddress;
     int ServerSocket;
@@ -557,6 +557,21 @@ int svlVideoCodecBase::SetTimestamp(const double CMN_UNUSED(timestamp))
     return SVL_FAIL;
 }
 
+double svlVideoCodecBase::GetCompressionTime() const
+{
+    return -1.0;
+}
+
+double svlVideoCodecBase::GetAverageCompressionTime() const
+{
+    return -1.0;
+}
+
+int svlVideoCodecBase::GetClientStatistics(std::vector<svlVideoIO::ClientStatistics> & CMN_UNUSED(stats)) const
+{
+    return SVL_FAIL;
+}
+
 void svlVideoCodecBase::SetName(const std::string &name)
 {
     EncoderName = name;
@@ -0,0 +1,199 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstStereoVision/svlConverters.h>
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+
+////////////////////////////////
+//     Conversion wrappers    //
+////////////////////////////////
+
+// Each wrapper converts 'pixels' pixels from 'in' to 'out'
+typedef void (*ConversionFunc)(unsigned char* in, unsigned char* out, unsigned int pixels);
+
+void RGB24toGray8(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::RGB24toGray8(in, out, pixels, true, true);
+}
+
+void RGB24toGray8Fast(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::RGB24toGray8(in, out, pixels, false, false);
+}
+
+void RGBA32toGray8(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::RGBA32toGray8(in, out, pixels, true, false);
+}
+
+void Gray16toGray8(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::Gray16toGray8(reinterpret_cast<unsigned short*>(in), out, pixels, 4);
+}
+
+void Gray16toRGB24(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::Gray16toRGB24(reinterpret_cast<unsigned short*>(in), out, pixels, 2);
+}
+
+void float32toGray8(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::float32toGray8(reinterpret_cast<float*>(in), out, pixels, 0.37f, 1);
+}
+
+void float32toRGB24(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    // Z coordinates of a 3D map
+    svlConverter::float32toRGB24(reinterpret_cast<float*>(in) + 2, out, pixels, 1.0f, 3);
+}
+
+void RGB24toYUV422(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::RGB24toYUV422(in, out, pixels);
+}
+
+void BGR24toYUV422(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::BGR24toYUV422(in, out, pixels);
+}
+
+void YUV422toRGB24(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::YUV422toRGB24(in, out, pixels);
+}
+
+void UYVYtoRGB24(unsigned char* in, unsigned char* out, unsigned int pixels)
+{
+    svlConverter::UYVYtoRGB24(in, out, pixels);
+}
+
+struct Conversion
+{
+    const char* name;
+    ConversionFunc func;
+    unsigned int inputbytes;    // per pixel
+    unsigned int outputbytes;   // per pixel
+    bool floatinput;
+};
+
+const Conversion Conversions[] =
+{
+    {"RGB24toGray8 (accurate)", RGB24toGray8,     3,  1, false},
+    {"RGB24toGray8 (fast)",     RGB24toGray8Fast, 3,  1, false},
+    {"RGBA32toGray8",           RGBA32toGray8,    4,  1, false},
+    {"Gray16toGray8",           Gray16toGray8,    2,  1, false},
+    {"Gray16toRGB24",           Gray16toRGB24,    2,  3, false},
+    {"float32toGray8",          float32toGray8,   4,  1, true},
+    {"float32toRGB24 (3D map)", float32toRGB24,   12, 3, true},
+    {"RGB24toYUV422",           RGB24toYUV422,    3,  2, false},
+    {"BGR24toYUV422",           BGR24toYUV422,    3,  2, false},
+    {"YUV422toRGB24",           YUV422toRGB24,    2,  3, false},
+    {"UYVYtoRGB24",             UYVYtoRGB24,      2,  3, false}
+};
+
+
+////////////////////////////////
+//         Benchmark          //
+////////////////////////////////
+
+// Megapixels per second
+double Measure(const Conversion& conversion, unsigned char* in, unsigned char* out, unsigned int pixels, double duration)
+{
+    unsigned int iterations = 0;
+    const double start = osaGetTime();
+    double elapsed;
+    do {
+        conversion.func(in, out, pixels);
+        iterations ++;
+        elapsed = osaGetTime() - start;
+    } while (elapsed < duration);
+
+    return static_cast<double>(pixels) * iterations / elapsed / 1000000.0;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int width = 1920, height = 1080;
+    double duration = 0.5;
+    if (argc >= 3) {
+        width = static_cast<unsigned int>(atoi(argv[1]));
+        height = static_cast<unsigned int>(atoi(argv[2]));
+    }
+    if (argc >= 4) duration = atof(argv[3]);
+    if (width < 1 || height < 1 || duration <= 0.0) {
+        cerr << "Usage: " << argv[0] << " [width height [seconds per test]]" << endl;
+        return 1;
+    }
+
+    const unsigned int pixels = width * height;
+    cout << "Image size: " << width << "x" << height << ", SIMD "
+         << (svlConverter::IsSIMDSupported() ? "supported" : "not supported") << endl << endl;
+    cout << setw(26) << left << "Conversion"
+         << setw(16) << right << "scalar [MP/s]"
+         << setw(16) << "SIMD [MP/s]"
+         << setw(10) << "speedup"
+         << setw(12) << "identical" << endl;
+
+    srand(1);
+    const unsigned int count = sizeof(Conversions) / sizeof(Conversions[0]);
+    bool all_identical = true;
+
+    for (unsigned int i = 0; i < count; i ++) {
+        const Conversion& conversion = Conversions[i];
+
+        std::vector<unsigned char> in(pixels * conversion.inputbytes);
+        std::vector<unsigned char> out_scalar(pixels * conversion.outputbytes);
+        std::vector<unsigned char> out_simd(pixels * conversion.outputbytes);
+
+        if (conversion.floatinput) {
+            float* fin = reinterpret_cast<float*>(&in[0]);
+            for (unsigned int j = 0; j < in.size() / sizeof(float); j ++) {
+                fin[j] = static_cast<float>(rand() % 4000 - 500) * 0.37f;
+            }
+        }
+        else {
+            for (unsigned int j = 0; j < in.size(); j ++) in[j] = static_cast<unsigned char>(rand());
+        }
+
+        svlConverter::SetSIMDEnabled(false);
+        conversion.func(&in[0], &out_scalar[0], pixels);
+        const double scalar = Measure(conversion, &in[0], &out_scalar[0], pixels, duration);
+
+        svlConverter::SetSIMDEnabled(true);
+        conversion.func(&in[0], &out_simd[0], pixels);
+        const bool identical = (out_scalar == out_simd);
+        const double simd = Measure(conversion, &in[0], &out_simd[0], pixels, duration);
+
+        if (!identical) all_identical = false;
+
+        cout << setw(26) << left << conversion.name << right << fixed << setprecision(1)
+             << setw(16) << scalar
+             << setw(16) << simd
+             << setw(9) << setprecision(2) << simd / scalar << "x"
+             << setw(12) << (identical ? "yes" : "NO") << endl;
+    }
+
+    return all_identical ? 0 : 1;
+}
@@ -0,0 +1,309 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstStereoVision/svlInitializer.h>
+#include <cisstStereoVision/svlStreamManager.h>
+#include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstStereoVision/svlFilterSourceDummy.h>
+#include <cisstStereoVision/svlFilterComputationalStereo.h>
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+
+
+////////////////////////////////
+//          Dataset           //
+////////////////////////////////
+
+// One line of the dataset file:
+//   name left_image right_image min_disparity max_disparity [ground_truth ground_truth_scale]
+// Ground truth disparities are in left image coordinates, multiplied by
+// 'ground_truth_scale' (Middlebury convention); zero means unknown.
+struct StereoPair
+{
+    string name;
+    string left;
+    string right;
+    int mindisparity;
+    int maxdisparity;
+    string groundtruth;
+    double groundtruthscale;
+};
+
+bool LoadDataset(const string& filepath, vector<StereoPair>& pairs)
+{
+    ifstream file(filepath.c_str());
+    if (!file.is_open()) return false;
+
+    string line;
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream stream(line);
+        StereoPair pair;
+        pair.groundtruthscale = 1.0;
+        if (!(stream >> pair.name >> pair.left >> pair.right >> pair.mindisparity >> pair.maxdisparity)) continue;
+        stream >> pair.groundtruth >> pair.groundtruthscale;
+        pairs.push_back(pair);
+    }
+    return !pairs.empty();
+}
+
+
+////////////////////////////////
+//        Result sink         //
+////////////////////////////////
+
+// Counts frames and keeps the last disparity map
+class DisparitySink : public svlFilterBase
+{
+public:
+    DisparitySink() :
+        svlFilterBase(),
+        Frames(0),
+        FirstFrameTime(0.0),
+        LastFrameTime(0.0)
+    {
+        AddInput("input", true);
+        AddInputType("input", svlTypeMatrixFloat);
+        AddOutput("output", true);
+        SetAutomaticOutputType(true);
+    }
+
+    unsigned int Frames;
+    double FirstFrameTime;
+    double LastFrameTime;
+    svlSampleMatrixFloat Disparities;
+
+protected:
+    int Initialize(svlSample* syncInput, svlSample* &syncOutput)
+    {
+        syncOutput = syncInput;
+        return SVL_OK;
+    }
+
+    int Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput)
+    {
+        syncOutput = syncInput;
+        _SkipIfAlreadyProcessed(syncInput, syncOutput);
+
+        _OnSingleThread(procInfo) {
+            LastFrameTime = osaGetTime();
+            if (Frames == 0) FirstFrameTime = LastFrameTime;
+            Frames ++;
+            Disparities.CopyOf(syncInput);
+        }
+        return SVL_OK;
+    }
+};
+
+
+////////////////////////////////
+//         Benchmark          //
+////////////////////////////////
+
+struct Configuration
+{
+    const char* name;
+    svlFilterComputationalStereo::StereoMethod method;
+    unsigned int scale;
+    unsigned int blocksize;
+    bool xcheck;
+};
+
+const Configuration Configurations[] =
+{
+    {"DP",                svlFilterComputationalStereo::DynamicProgramming, 0, 1, true},
+    {"BM",                svlFilterComputationalStereo::BlockMatching,      0, 7, true},
+    {"BM (no x-check)",   svlFilterComputationalStereo::BlockMatching,      0, 7, false},
+    {"BM (3 levels)",     svlFilterComputationalStereo::BlockMatching,      2, 7, true}
+};
+
+// Ground truth moved to right image coordinates, where the filter
+// reports disparities; occluded pixels keep the closer surface
+void WarpGroundTruth(const svlSampleImageRGB& image, double scale, vector<float>& warped)
+{
+    const int width = static_cast<int>(image.GetWidth());
+    const int height = static_cast<int>(image.GetHeight());
+    const unsigned char* pixels = image.GetUCharPointer();
+    int x, y, xr;
+    float d;
+
+    warped.assign(width * height, 0.0f);
+    for (y = 0; y < height; y ++) {
+        for (x = 0; x < width; x ++) {
+            d = static_cast<float>(pixels[(y * width + x) * 3] / scale);
+            if (d <= 0.0f) continue;
+            xr = static_cast<int>(floor(x - d + 0.5f));
+            if (xr >= 0 && xr < width && warped[y * width + xr] < d) warped[y * width + xr] = d;
+        }
+    }
+}
+
+int RunBenchmark(const StereoPair& pair, const Configuration& config, unsigned int threads, double duration,
+                 double& fps, double& badpixels, double& meanerror)
+{
+    svlSampleImageRGBStereo image;
+    if (svlImageIO::Read(image, SVL_LEFT,  pair.left)  != SVL_OK ||
+        svlImageIO::Read(image, SVL_RIGHT, pair.right) != SVL_OK) {
+        cerr << "Failed to read " << pair.left << " or " << pair.right << endl;
+        return SVL_FAIL;
+    }
+    const int width = static_cast<int>(image.GetWidth(SVL_LEFT));
+    const int height = static_cast<int>(image.GetHeight(SVL_LEFT));
+
+    svlCameraGeometry geometry;
+    geometry.SetIntrinsics(width, width, width / 2, height / 2, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, SVL_LEFT);
+    geometry.SetIntrinsics(width, width, width / 2, height / 2, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, SVL_RIGHT);
+    geometry.SetExtrinsics(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, SVL_LEFT);
+    geometry.SetExtrinsics(0.0, 0.0, 0.0, 10.0, 0.0, 0.0, SVL_RIGHT);
+
+    svlStreamManager stream(threads);
+    svlFilterSourceDummy source(image);
+    svlFilterComputationalStereo stereo;
+    DisparitySink sink;
+
+    source.SetTargetFrequency(1000.0);
+
+    // Right image pixels beyond 'width - maxdisparity' have no match;
+    // dynamic programming also needs a border around the region
+    const svlRect roi(5, 5, width - 1 - pair.maxdisparity, height - 6);
+    stereo.SetCameraGeometry(geometry);
+    stereo.SetMethod(config.method);
+    stereo.SetROI(roi);
+    stereo.SetCrossCheck(config.xcheck);
+    stereo.SetSubpixelPrecision(false);
+    stereo.SetDisparityRange(pair.mindisparity, pair.maxdisparity);
+    stereo.SetScalingFactor(config.scale);
+    stereo.SetBlockSize(config.blocksize);
+    stereo.SetQuickSearchRadius(config.method == svlFilterComputationalStereo::BlockMatching ? 4 : pair.maxdisparity);
+    stereo.SetSmoothnessFactor(40);
+    stereo.SetTemporalFiltering(0);
+    stereo.SetSpatialFiltering(0);
+
+    stream.SetSourceFilter(&source);
+    source.GetOutput()->Connect(stereo.GetInput());
+    stereo.GetOutput()->Connect(sink.GetInput());
+
+    if (stream.Play() != SVL_OK) {
+        cerr << "Failed to start stream" << endl;
+        return SVL_FAIL;
+    }
+    osaSleep(duration);
+    stream.Release();
+    stream.DisconnectAll();
+
+    fps = (sink.Frames > 1) ? (sink.Frames - 1) / (sink.LastFrameTime - sink.FirstFrameTime) : 0.0;
+    badpixels = meanerror = -1.0;
+
+    if (pair.groundtruth.empty() || sink.Frames == 0) return SVL_OK;
+
+    svlSampleImageRGB truthimage;
+    if (svlImageIO::Read(truthimage, SVL_LEFT, pair.groundtruth) != SVL_OK ||
+        static_cast<int>(truthimage.GetWidth()) != width ||
+        static_cast<int>(truthimage.GetHeight()) != height) {
+        cerr << "Failed to read " << pair.groundtruth << endl;
+        return SVL_OK;
+    }
+    vector<float> truth;
+    WarpGroundTruth(truthimage, pair.groundtruthscale, truth);
+
+    // Errors inside the region of interest, where the ground truth is known
+    const float* disparities = sink.Disparities.GetPointer();
+    unsigned int count = 0, bad = 0;
+    double sum = 0.0, error;
+    for (int y = roi.top; y <= roi.bottom; y ++) {
+        for (int x = roi.left; x <= roi.right; x ++) {
+            if (truth[y * width + x] <= 0.0f) continue;
+            error = fabs(disparities[y * width + x] - truth[y * width + x]);
+            if (error > 1.0) bad ++;
+            sum += error;
+            count ++;
+        }
+    }
+    if (count > 0) {
+        badpixels = 100.0 * bad / count;
+        meanerror = sum / count;
+    }
+
+    return SVL_OK;
+}
+
+int main(int argc, char** argv)
+{
+    vector<StereoPair> pairs;
+    unsigned int threads = 4;
+    double duration = 3.0;
+
+    // "-" stands for the default dataset
+    if (argc >= 2 && string(argv[1]) != "-" && !LoadDataset(argv[1], pairs)) {
+        cerr << "Usage: " << argv[0] << " [dataset file|- [threads [seconds per test]]]" << endl << endl
+             << "Each line of the dataset file describes a stereo pair:" << endl
+             << "  name left_image right_image min_disparity max_disparity [ground_truth ground_truth_scale]" << endl;
+        return 1;
+    }
+    if (argc >= 3) threads = static_cast<unsigned int>(atoi(argv[2]));
+    if (argc >= 4) duration = atof(argv[3]);
+    if (threads < 1) threads = 1;
+
+    if (pairs.empty()) {
+        // Pairs of the computestereo example, without ground truth
+        StereoPair tsukuba = {"tsukuba", "tsukuba3.bmp", "tsukuba4.bmp", 0, 16, "", 1.0};
+        StereoPair venus   = {"venus",   "venus_l.bmp",  "venus_r.bmp",  0, 20, "", 1.0};
+        pairs.push_back(tsukuba);
+        pairs.push_back(venus);
+    }
+
+    svlInitialize();
+
+    cout << "Threads: " << threads << ", " << duration << " s per test" << endl << endl;
+    cout << setw(16) << left << "Pair"
+         << setw(18) << "Method"
+         << setw(12) << right << "frames/s"
+         << setw(14) << "bad pixels"
+         << setw(14) << "mean error" << endl;
+
+    const unsigned int count = sizeof(Configurations) / sizeof(Configurations[0]);
+    double fps, badpixels, meanerror;
+
+    for (unsigned int i = 0; i < pairs.size(); i ++) {
+        for (unsigned int j = 0; j < count; j ++) {
+            if (RunBenchmark(pairs[i], Configurations[j], threads, duration, fps, badpixels, meanerror) != SVL_OK) break;
+
+            cout << setw(16) << left << pairs[i].name
+                 << setw(18) << Configurations[j].name << right << fixed << setprecision(1)
+                 << setw(12) << fps;
+            if (badpixels >= 0.0) {
+                cout << setw(13) << badpixels << "%"
+                     << setw(14) << setprecision(2) << meanerror;
+            }
+            else {
+                cout << setw(14) << "n/a" << setw(14) << "n/a";
+            }
+            cout << endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,217 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstStereoVision/svlInitializer.h>
+#include <cisstStereoVision/svlTypes.h>
+#include <cisstStereoVision/svlVideoIO.h>
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+
+////////////////////////////////
+//        Test sequence       //
+////////////////////////////////
+
+const unsigned int Width = 160;
+const unsigned int Height = 96;
+const unsigned int SequenceLength = 32;
+
+// Gray frames survive the YUV 4:2:2 conversion of the codecs with
+// rounding errors only; the top-left block encodes the frame number and
+// a moving box changes a few tiles from frame to frame
+void GetFrame(svlSampleImageRGB& image, unsigned int number)
+{
+    unsigned char* pixels = image.GetUCharPointer();
+    unsigned int y;
+
+    memset(pixels, 40, image.GetDataSize());
+    for (y = 0; y < 32; y ++) {
+        memset(pixels + y * Width * 3, (number * 8) & 255, 32 * 3);
+    }
+    const unsigned int boxleft = 40 + number * 3;
+    for (y = 50; y < 70; y ++) {
+        memset(pixels + (y * Width + boxleft) * 3, 200, 16 * 3);
+    }
+}
+
+unsigned int GetFrameNumber(const svlSampleImageRGB& image)
+{
+    return ((image.GetUCharPointer()[(5 * Width + 5) * 3] + 4) / 8) % SequenceLength;
+}
+
+int GetMaxDifference(const svlSampleImageRGB& image1, const svlSampleImageRGB& image2)
+{
+    const unsigned char* pixels1 = image1.GetUCharPointer();
+    const unsigned char* pixels2 = image2.GetUCharPointer();
+    int diff, maxdiff = 0;
+
+    for (unsigned int i = 0; i < image1.GetDataSize(); i ++) {
+        diff = abs(static_cast<int>(pixels1[i]) - static_cast<int>(pixels2[i]));
+        if (diff > maxdiff) maxdiff = diff;
+    }
+    return maxdiff;
+}
+
+
+////////////////////////////////
+//           Sender           //
+////////////////////////////////
+
+// Streams the test sequence in a loop until stopped
+class Sender
+{
+public:
+    Sender(svlVideoCodecBase* codec) :
+        Codec(codec),
+        Stop(false)
+    {
+    }
+
+    void* Proc(int CMN_UNUSED(param))
+    {
+        svlSampleImageRGB image;
+        image.SetSize(Width, Height);
+
+        for (unsigned int number = 0; !Stop; number ++) {
+            GetFrame(image, number % SequenceLength);
+            Codec->Write(0, image, SVL_LEFT);
+            osaSleep(0.02);
+        }
+        return 0;
+    }
+
+    svlVideoCodecBase* Codec;
+    volatile bool Stop;
+};
+
+
+////////////////////////////////
+//         Round trip         //
+////////////////////////////////
+
+struct StreamType
+{
+    const char* extension;
+    const char* senderaddress;
+    bool setextension;
+};
+
+// The TCP sender listens for clients and streams JPEG unless the extension
+// selects the lossless compressor; the UDP sender needs the address of the
+// receiver
+const StreamType StreamTypes[] =
+{
+    {".ncvi", "",          true},
+    {".ucvi", "127.0.0.1", false}
+};
+
+// Returns the number of frames received and decoded correctly
+int RunRoundTrip(const StreamType& type, unsigned short port, int keyframeevery, unsigned int frames)
+{
+    const string extension(type.extension);
+    ostringstream serverpath, clientpath;
+    serverpath << type.senderaddress << "@" << port << extension;
+    clientpath << "127.0.0.1@" << port << extension;
+
+    svlVideoCodecBase* writer = svlVideoIO::GetCodec(serverpath.str());
+    svlVideoCodecBase* reader = svlVideoIO::GetCodec(clientpath.str());
+    if (!writer || !reader) {
+        cerr << "No codec for " << extension << endl;
+        if (writer) svlVideoIO::ReleaseCodec(writer);
+        if (reader) svlVideoIO::ReleaseCodec(reader);
+        return -1;
+    }
+
+    if (type.setextension) writer->SetExtension(extension);
+    writer->SetKeyFrameEvery(keyframeevery);
+    if (writer->Create(serverpath.str(), Width, Height, 50.0) != SVL_OK) {
+        cerr << "Failed to create " << serverpath.str() << endl;
+        svlVideoIO::ReleaseCodec(writer);
+        svlVideoIO::ReleaseCodec(reader);
+        return -1;
+    }
+
+    Sender sender(writer);
+    osaThread thread;
+    thread.Create<Sender, int>(&sender, &Sender::Proc, 0);
+    osaSleep(0.3);
+
+    svlSampleImageRGB image, expected;
+    unsigned int width, height;
+    double framerate;
+    int correct = -1;
+
+    if (reader->Open(clientpath.str(), width, height, framerate) == SVL_OK) {
+        image.SetSize(Width, Height);
+        expected.SetSize(Width, Height);
+        correct = 0;
+
+        for (unsigned int i = 0; i < frames; i ++) {
+            if (reader->Read(0, image, SVL_LEFT) != SVL_OK) continue;
+            GetFrame(expected, GetFrameNumber(image));
+            if (GetMaxDifference(image, expected) <= 3) correct ++;
+        }
+
+        // The receiver has to be closed while the sender is still streaming
+        reader->Close();
+    }
+    else {
+        cerr << "Failed to open " << clientpath.str() << endl;
+    }
+
+    sender.Stop = true;
+    thread.Wait();
+    writer->Close();
+
+    svlVideoIO::ReleaseCodec(writer);
+    svlVideoIO::ReleaseCodec(reader);
+
+    return correct;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned short port = 24790;
+    unsigned int frames = 60;
+
+    if (argc >= 2) port = static_cast<unsigned short>(atoi(argv[1]));
+    if (argc >= 3) frames = static_cast<unsigned int>(atoi(argv[2]));
+
+    svlInitialize();
+
+    // Key frame intervals larger than 1 enable tile delta coding
+    const int keyframeevery[] = { 0, 5, 30 };
+    int result = 0, correct;
+
+    for (unsigned int i = 0; i < sizeof(StreamTypes) / sizeof(StreamTypes[0]); i ++) {
+        for (unsigned int j = 0; j < sizeof(keyframeevery) / sizeof(keyframeevery[0]); j ++) {
+            correct = RunRoundTrip(StreamTypes[i], port ++, keyframeevery[j], frames);
+
+            cout << StreamTypes[i].extension << ", key frame every " << keyframeevery[j] << ": "
+                 << (correct < 0 ? 0 : correct) << "/" << frames << " frames decoded correctly" << endl;
+            if (correct < static_cast<int>(frames)) result = 1;
+        }
+    }
+
+    return result;
+}
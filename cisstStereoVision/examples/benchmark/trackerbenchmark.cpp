@@ -0,0 +1,244 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstStereoVision/svlInitializer.h>
+#include <cisstStereoVision/svlStreamManager.h>
+#include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstStereoVision/svlFilterInput.h>
+#include <cisstStereoVision/svlFilterSourceVideoFile.h>
+#include <cisstStereoVision/svlFilterImageTracker.h>
+#include <cisstStereoVision/svlTrackerMSBruteForce.h>
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+using namespace std;
+
+
+////////////////////////////////
+//        Frame counter       //
+////////////////////////////////
+
+class FrameCounterSink : public svlFilterBase
+{
+public:
+    FrameCounterSink() :
+        svlFilterBase(),
+        Frames(0),
+        FirstFrameTime(0.0),
+        LastFrameTime(0.0)
+    {
+        AddInput("input", true);
+        AddInputType("input", svlTypeImageRGB);
+        AddOutput("output", true);
+        SetAutomaticOutputType(true);
+        SetInputModified(false);
+    }
+
+    unsigned int Frames;
+    double FirstFrameTime;
+    double LastFrameTime;
+
+protected:
+    int Initialize(svlSample* syncInput, svlSample* &syncOutput)
+    {
+        syncOutput = syncInput;
+        return SVL_OK;
+    }
+
+    int Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput)
+    {
+        syncOutput = syncInput;
+        _SkipIfAlreadyProcessed(syncInput, syncOutput);
+
+        _OnSingleThread(procInfo) {
+            LastFrameTime = osaGetTime();
+            if (Frames == 0) FirstFrameTime = LastFrameTime;
+            Frames ++;
+        }
+        return SVL_OK;
+    }
+};
+
+
+////////////////////////////////
+//         Benchmark          //
+////////////////////////////////
+
+struct Configuration
+{
+    const char* name;
+    svlErrorMetric metric;
+    unsigned int scales;
+};
+
+const Configuration Configurations[] =
+{
+    {"SAD",               svlSAD,     1},
+    {"SSD",               svlSSD,     1},
+    {"NCC",               svlNCC,     1},
+    {"FastNCC",           svlFastNCC, 1},
+    {"NCC (3 scales)",    svlNCC,     3}
+};
+
+// Targets on a regular grid around the center of the image
+void GetTargetGrid(unsigned int width, unsigned int height, unsigned int gridsize, unsigned int spacing, svlSampleTargets& targets)
+{
+    const int offset = static_cast<int>((gridsize - 1) * spacing) / 2;
+    vctInt2 position;
+    unsigned int i, j, c = 0;
+
+    targets.SetSize(2, gridsize * gridsize, 1);
+    for (j = 0; j < gridsize; j ++) {
+        for (i = 0; i < gridsize; i ++) {
+            position.X() = static_cast<int>(width / 2 + i * spacing) - offset;
+            position.Y() = static_cast<int>(height / 2 + j * spacing) - offset;
+            targets.SetFlag(c, 1);
+            targets.SetConfidence(c, 255);
+            targets.SetPosition(c, position);
+            c ++;
+        }
+    }
+}
+
+int RunBenchmark(const string& filepath, const svlSampleTargets& targets, const Configuration& config,
+                 unsigned int threads, double duration,
+                 double& fps, double& tracktime, double& confidence)
+{
+    svlStreamManager stream(threads);
+    svlFilterSourceVideoFile source(1);
+    svlFilterImageTracker tracker;
+    svlTrackerMSBruteForce trackeralgo;
+    FrameCounterSink sink;
+
+    if (source.SetFilePath(filepath) != SVL_OK) {
+        cerr << "Failed to open " << filepath << endl;
+        return SVL_FAIL;
+    }
+    source.SetLoop(true);
+    source.SetTargetFrequency(1000.0);
+
+    trackeralgo.SetErrorMetric(config.metric);
+    trackeralgo.SetScales(config.scales);
+    trackeralgo.SetTemplateRadius(8);
+    trackeralgo.SetSearchRadius(16);
+    trackeralgo.SetOverwriteTemplates(false);
+    trackeralgo.SetTemplateUpdate(true);
+    trackeralgo.SetTemplateUpdateWeight(0.1);
+    trackeralgo.SetConfidenceThreshold(0.0);
+
+    tracker.SetTracker(trackeralgo);
+    tracker.SetIterations(1);
+    tracker.SetRigidBody(false);
+    tracker.GetInput("targets")->PushSample(&targets);
+
+    stream.SetSourceFilter(&source);
+    source.GetOutput()->Connect(tracker.GetInput());
+    tracker.GetOutput()->Connect(sink.GetInput());
+
+    if (stream.Play() != SVL_OK) {
+        cerr << "Failed to start stream" << endl;
+        return SVL_FAIL;
+    }
+    osaSleep(duration);
+    stream.Stop();
+
+    fps = (sink.Frames > 1) ? (sink.Frames - 1) / (sink.LastFrameTime - sink.FirstFrameTime) : 0.0;
+    tracktime = tracker.GetProcessTime();
+
+    // Average confidence of the targets on the last frame
+    const unsigned int count = targets.GetMaxTargets();
+    svlTarget2D target;
+    unsigned int used = 0;
+    confidence = 0.0;
+    for (unsigned int i = 0; i < count; i ++) {
+        if (trackeralgo.GetTarget(i, target) != SVL_OK || !target.used) continue;
+        confidence += target.conf;
+        used ++;
+    }
+    if (used > 0) confidence /= used;
+
+    stream.Release();
+    stream.DisconnectAll();
+
+    return SVL_OK;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int threads = 4;
+    unsigned int gridsize = 8;
+    double duration = 3.0;
+
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " video_file [threads [seconds per test [targets per grid row]]]" << endl << endl
+             << "Tracks a grid of targets around the center of a recorded sequence" << endl
+             << "with each error metric of svlTrackerMSBruteForce." << endl;
+        return 1;
+    }
+    const string filepath(argv[1]);
+    if (argc >= 3) threads = static_cast<unsigned int>(atoi(argv[2]));
+    if (argc >= 4) duration = atof(argv[3]);
+    if (argc >= 5) gridsize = static_cast<unsigned int>(atoi(argv[4]));
+    if (threads < 1) threads = 1;
+    if (gridsize < 1) gridsize = 1;
+
+    svlInitialize();
+
+    // Get video dimensions
+    unsigned int width, height;
+    double framerate;
+    svlVideoCodecBase* codec = svlVideoIO::GetCodec(filepath);
+    if (!codec || codec->Open(filepath, width, height, framerate) != SVL_OK) {
+        cerr << "Failed to open " << filepath << endl;
+        if (codec) svlVideoIO::ReleaseCodec(codec);
+        return 1;
+    }
+    svlVideoIO::ReleaseCodec(codec);
+
+    // Keep the search windows of the outermost targets inside the image
+    unsigned int spacing = 32;
+    const unsigned int margin = 2 * (8 + 16) * 4;
+    while (spacing > 1 && (gridsize - 1) * spacing + margin > min(width, height)) spacing /= 2;
+
+    svlSampleTargets targets;
+    GetTargetGrid(width, height, gridsize, spacing, targets);
+
+    cout << filepath << ": " << width << "x" << height << ", "
+         << gridsize * gridsize << " targets, "
+         << threads << " threads, " << duration << " s per test" << endl << endl;
+    cout << setw(18) << left << "Metric"
+         << setw(12) << right << "frames/s"
+         << setw(16) << "tracker [ms]"
+         << setw(16) << "confidence" << endl;
+
+    const unsigned int count = sizeof(Configurations) / sizeof(Configurations[0]);
+    double fps, tracktime, confidence;
+
+    for (unsigned int i = 0; i < count; i ++) {
+        if (RunBenchmark(filepath, targets, Configurations[i], threads, duration, fps, tracktime, confidence) != SVL_OK) break;
+
+        cout << setw(18) << left << Configurations[i].name << right << fixed << setprecision(1)
+             << setw(12) << fps
+             << setw(16) << setprecision(2) << tracktime * 1000.0
+             << setw(16) << setprecision(1) << confidence << endl;
+    }
+
+    return 0;
+}
@@ -50,13 +50,18 @@ public:
 
     svlSample* Pull(bool waitfornew, double timeout = 5.0);
 
+    //! Samples overwritten by Push before they were pulled
+    unsigned int GetDroppedSampleCount() const;
+
 private:
     svlBufferSample();
 
 #if (CISST_OS == CISST_WINDOWS)
     LONG Next, Latest, Locked;
+    LONG Unread, DroppedSamples;
 #else
     unsigned int Next, Latest, Locked;
+    unsigned int Unread, DroppedSamples;
 #endif
     osaThreadSignal NewSampleEvent;
     svlSample* Buffer[3];
@@ -30,6 +30,12 @@ http://www.cisst.org/cisst/license.txt.
 
 namespace svlConverter
 {
+    // The hot conversions use SSE2 kernels when available; results are
+    // identical with the scalar code. Disabling them is meant for testing.
+    CISST_EXPORT bool IsSIMDSupported();
+    CISST_EXPORT bool GetSIMDEnabled();
+    CISST_EXPORT void SetSIMDEnabled(bool enable);
+
     CISST_EXPORT int ConvertSample(const svlSample* inimage, svlSample* outimage,
                                    unsigned int threads = 1, unsigned int threadid = 0);
     CISST_EXPORT int ConvertImage(const svlSampleImage* inimage, svlSampleImage* outimage,
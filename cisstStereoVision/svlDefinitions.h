@@ -232,6 +232,7 @@ enum svlStreamType
     ,svlTypeText                  // Textual data
     ,svlTypeCameraGeometry        // Geometry of a single or multiple camera rig
     ,svlTypeBlobs                 // Image blobs
+    ,svlTypeImagePyramid          // Multi-resolution image
 };
 
 
@@ -279,6 +280,17 @@ enum svlColorSpace
 };
 
 
+///////////////////////////////////
+// Sync point type enumerations //
+///////////////////////////////////
+
+enum svlSyncPointType
+{
+    svlSyncPointEvent,      // Threads block on OS events
+    svlSyncPointSpin        // Atomic barrier, threads spin before sleeping
+};
+
+
 /////////////////////////////
 // Pixel type enumerations //
 /////////////////////////////
@@ -65,6 +65,21 @@ public:
     bool IsEnabled() const;
     bool IsDisabled() const;
 
+    //! False if the filter never writes to the sample on its trunk input;
+    //! stream branches feeding only such filters share samples without copying
+    bool IsInputModified(void) const;
+
+    //! Average time [s] per frame and thread spent waiting at the
+    //! stream's synchronization points during and after Process
+    double GetBarrierWaitTime(void) const;
+    //! Total time [s] stream thread threadid waited since the stream started
+    double GetBarrierWaitTime(unsigned int threadid) const;
+    //! Average time [s] per frame and thread spent in Process, including
+    //! the barrier wait time
+    double GetProcessTime(void) const;
+    //! Total time [s] stream thread threadid spent in Process since the stream started
+    double GetProcessTime(unsigned int threadid) const;
+
 protected:
     unsigned int FrameCounter;
     mtsStateTable StateTable;
@@ -74,6 +89,7 @@ protected:
     int AddInputType(const std::string &inputname, svlStreamType type);
     int SetOutputType(const std::string &outputname, svlStreamType type);
     void SetAutomaticOutputType(bool autotype);
+    void SetInputModified(bool modified);
 
     virtual int  OnConnectInput(svlFilterInput &input, svlStreamType type);
     virtual int  Initialize(svlSample* syncInput, svlSample* &syncOutput) = 0;
@@ -91,7 +107,10 @@ private:
     bool   Initialized;
     bool   Running;
     bool   AutoType;
+    bool   InputModified;
     double PrevInputTimestamp;
+    vctDoubleVec BarrierWaitTime;
+    vctDoubleVec ProcessTime;
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(svlFilterBase)
@@ -38,6 +38,14 @@ public:
     virtual int Initialize() = 0;
     virtual int Process(svlSampleImage * images, int * depthmap) = 0;
     virtual void Free() = 0;
+
+    // Called on all processing threads; methods that do not
+    // split their work among threads run on the first thread
+    virtual int Process(svlProcInfo * procInfo, svlSampleImage * images, int * depthmap)
+    {
+        if (procInfo->ID == 0) return Process(images, depthmap);
+        return 0;
+    }
 };
 
 class CISST_EXPORT svlFilterComputationalStereo : public svlFilterBase
@@ -46,7 +54,8 @@ class CISST_EXPORT svlFilterComputationalStereo : public svlFilterBase
 
 public:
     enum StereoMethod {
-        DynamicProgramming
+        DynamicProgramming,
+        BlockMatching       // Multi-threaded census block matching, coarse-to-fine if the scaling factor is above 0
     };
 
     svlFilterComputationalStereo();
@@ -64,6 +73,7 @@ public:
     void SetSmoothnessFactor(unsigned int smoothness);
     void SetTemporalFiltering(double tempfilt);
     void SetSpatialFiltering(unsigned int radius);
+    int  SetMethod(StereoMethod method);
 
     bool         GetSubpixelPrecision();
     bool         GetCrossCheck();
@@ -74,11 +84,6 @@ public:
     unsigned int GetSmoothnessFactor();
     double       GetTemporalFiltering();
     unsigned int GetSpatialFiltering();
-
-private:
-    // Work in progress...
-    // Other methods not available yet.
-    void SetMethod(StereoMethod method);
     StereoMethod GetMethod();
 
 protected:
@@ -121,6 +126,7 @@ private:
     void CreateXCheckImageColor(unsigned char* source, unsigned char* target, const unsigned int width, const unsigned int height);
 
     void PerformXCheck();
+    void FillDisparityHoles();
     void ConvertDisparitiesToFloat(int* input, float* output, const int width, const int height);
     void ApplySpatialFilter(const int radius,
                             float* depthmap, float* tempbuffer,
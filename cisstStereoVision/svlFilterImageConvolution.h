@@ -51,6 +51,7 @@ private:
     vctDynamicVector<double> KernelVert;
     bool KernelSeparable;
     bool AbsoluteResults;
+    vctFixedSizeVector<svlImageProcessing::Internals, SVL_MAX_CHANNELS> ConvolutionInternals;
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION_EXPORT(svlFilterImageConvolution)
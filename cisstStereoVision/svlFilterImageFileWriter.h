@@ -24,16 +24,35 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstStereoVision/svlFilterBase.h>
 #include <cisstStereoVision/svlImageIO.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
+#include <vector>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
 
 
+class osaThread;
+class osaThreadSignal;
+
 class CISST_EXPORT svlFilterImageFileWriter : public svlFilterBase
 {
     CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
 
 public:
+    enum QueuePolicy {
+        QueueBlock,         //!< Process waits until a queue slot becomes free
+        QueueDropNewest     //!< Frames arriving while the queue is full are not saved
+    };
+
+    typedef struct _AsyncStatistics {
+        unsigned int QueueDepth;        //!< Frames queued or being encoded
+        unsigned int MaxQueueDepth;
+        unsigned int FramesWritten;
+        unsigned int FramesDropped;
+        double AvgEncodeTime;           //!< Seconds per frame, all video channels
+        double MaxEncodeTime;
+    } AsyncStatistics;
+
     svlFilterImageFileWriter();
     virtual ~svlFilterImageFileWriter();
 
@@ -44,6 +63,16 @@ public:
     void Pause();
     void Record(int frames = -1);
 
+    /*! Asynchronous saving: with 'threads' > 0, Process copies the frames into a
+        queue of 'queuelength' slots and a pool of encoder threads writes them.
+        File names are assigned when a frame is queued, so they follow the order
+        of the frames regardless of which thread writes the file.  Release waits
+        until all queued frames are written.  0 threads (default) saves the
+        frames synchronously in Process. */
+    int SetAsync(unsigned int threads, unsigned int queuelength = 8, QueuePolicy policy = QueueBlock);
+    void GetAsyncStatistics(AsyncStatistics & stats);
+    void ResetAsyncStatistics();
+
 protected:
     virtual int Initialize(svlSample* syncInput, svlSample* &syncOutput);
     virtual int Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput);
@@ -57,6 +86,35 @@ private:
     vctDynamicVector<int> Compression;
     bool TimestampsEnabled;
     unsigned int CaptureLength;
+
+    struct QueueSlot
+    {
+        enum {Free, Queued, Encoding} State;
+        unsigned int Sequence;
+        svlSampleImage* Image;
+        std::vector<std::string> Paths;
+    };
+
+    unsigned int EncoderThreadCount;
+    unsigned int QueueLength;
+    QueuePolicy Policy;
+    std::vector<QueueSlot> Queue;
+    std::vector<osaThread*> EncoderThreads;
+    std::vector< vctDynamicVector<svlImageCodecBase*> > EncoderCodecs;
+    osaCriticalSection QueueCS;
+    osaThreadSignal* NewFrameEvent;
+    osaThreadSignal* FrameDoneEvent;
+    bool KillEncoderThreads;
+    bool EncoderError;
+    unsigned int NextSequence;
+    AsyncStatistics Statistics;
+    double TotalEncodeTime;
+
+    void GetFilePath(std::string & path, const unsigned int videoch, const double timestamp) const;
+    int Enqueue(svlSampleImage* image);
+    int StartEncoderThreads(svlSampleImage* image);
+    void StopEncoderThreads();
+    void* EncoderProc(int param);
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION_EXPORT(svlFilterImageFileWriter)
@@ -27,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlOverlayObjects.h>
 #include <cisstVector/vctFixedSizeVectorTypes.h>
 #include <map>
+#include <vector>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -49,6 +50,12 @@ protected:
     typedef std::map<svlFilterInput*, svlSample*> _SampleCacheMap;
     typedef std::map<int, TransformInternal> _TransformCacheMap;
 
+    typedef struct _DrawStep {
+        svlOverlay*      overlay;
+        svlSample*       input;
+        svlOverlayLayer* layer;     // cached rasterization, if any
+    } DrawStep;
+
 public:
     svlFilterImageOverlay();
     virtual ~svlFilterImageOverlay();
@@ -69,6 +76,17 @@ public:
     void SetEnableTransformSync(bool enabled);
     bool GetEnableTransformSync() const;
 
+    /*! When enabled, static overlays that have not changed since the
+        previous frame are rasterized once into a cache of horizontal
+        spans.  Consecutive cached overlays are composited together by all
+        stream threads, each thread processing a horizontal band of the
+        image, while the other overlays are drawn as before.  Composited
+        pixels are identical to drawn pixels, except for semi-transparent
+        pixels that may differ by one intensity level.  Disabled by default.
+    */
+    void SetEnableCaching(bool enabled);
+    bool GetEnableCaching() const;
+
 protected:
     virtual int Initialize(svlSample* syncInput, svlSample* &syncOutput);
     virtual int Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput);
@@ -104,7 +122,13 @@ private:
 
     bool EnableInputSync;
     bool EnableTransformSync;
+    bool EnableCaching;
+
+    std::vector<DrawStep> DrawSteps;
+    svlSampleImage* CacheBlack;
+    svlSampleImage* CacheWhite;
 
+    void AddDrawStep(svlOverlay* overlay, svlSampleImage* image, svlSample* input);
     bool IsInputAlreadyQueued(const std::string &name);
     void AddQueuedItemsInternal();
     void RemoveOverlayInternal(svlOverlay* overlay);
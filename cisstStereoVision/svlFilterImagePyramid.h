@@ -0,0 +1,69 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlFilterImagePyramid_h
+#define _svlFilterImagePyramid_h
+
+#include <cisstStereoVision/svlFilterBase.h>
+#include <cisstStereoVision/svlImageProcessing.h>
+
+// Always include last!
+#include <cisstStereoVision/svlExport.h>
+
+
+/*!
+  Builds an image pyramid (svlSampleImagePyramid) from each input image.
+  Downstream filters can share the pyramid by taking svlSampleImagePyramid::GetLevel()
+  views instead of resizing the image themselves.
+*/
+class CISST_EXPORT svlFilterImagePyramid : public svlFilterBase
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    svlFilterImagePyramid();
+    virtual ~svlFilterImagePyramid();
+
+    //! Number of levels including the full size image (level 0)
+    int SetLevels(const unsigned int levels);
+    unsigned int GetLevels() const;
+    //! svlImageProcessing::PY_Box or PY_Gaussian
+    void SetFilter(const int & filter);
+    void GetFilter(int & filter) const;
+
+protected:
+    virtual int OnConnectInput(svlFilterInput &input, svlStreamType type);
+    virtual int Initialize(svlSample* syncInput, svlSample* &syncOutput);
+    virtual int Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput);
+    virtual int Release();
+
+private:
+    svlSampleImagePyramid* OutputPyramid;
+    unsigned int Levels;
+    int Filter;
+    svlImageProcessing::Internals PyramidInternals;
+
+protected:
+    virtual void CreateInterfaces();
+    virtual void SetLevelsCommand(const int & levels);
+    virtual void GetLevelsCommand(int & levels) const;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION_EXPORT(svlFilterImagePyramid)
+
+#endif // _svlFilterImagePyramid_h
+
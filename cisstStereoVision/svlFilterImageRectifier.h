@@ -37,7 +37,10 @@ public:
     svlFilterImageRectifier();
     virtual ~svlFilterImageRectifier();
 
-    int LoadTable(const std::string &filepath, unsigned int videoch = SVL_LEFT, int exponentlen = 3);
+    //! Loads a text LUT or a compact LUT saved by SaveTable; if 'usecache' is true, text LUTs are cached next to the file (as <filepath>.cache) in compact form
+    int LoadTable(const std::string &filepath, unsigned int videoch = SVL_LEFT, int exponentlen = 3, bool usecache = false);
+    //! Saves the table of the channel as a compact binary LUT that LoadTable reads without parsing
+    int SaveTable(const std::string &filepath, unsigned int videoch = SVL_LEFT);
     //changed from "vctFixedSizeVector<double,5> k", to "vctFixedSizeVector<double,7> k"
     int SetTableFromCameraCalibration(unsigned int height,unsigned int width,vct3x3 R,vct2 f, vct2 c, vctFixedSizeVector<double,7> k, double alpha, unsigned int videoch);
     vctFixedSizeVector<svlImageProcessing::Internals, SVL_MAX_CHANNELS> GetTables(){return Tables;};
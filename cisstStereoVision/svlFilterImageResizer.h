@@ -23,6 +23,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _svlFilterImageResizer_h
 
 #include <cisstStereoVision/svlFilterBase.h>
+#include <cisstStereoVision/svlImageProcessing.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -40,8 +41,19 @@ public:
     int SetOutputRatio(double widthratio, double heightratio, unsigned int videoch = SVL_LEFT);
     void SetInterpolation(const bool & enable);
     void GetInterpolation(bool & enable) const;
+    //! svlImageProcessing::RS_Nearest, RS_Bilinear, RS_Bicubic, or RS_Area
+    void SetMethod(const int & method);
+    void GetMethod(int & method) const;
+
+    //! Adds an asynchronous output carrying the input resized by the given
+    //! ratios; all outputs are computed in a single pass over the input
+    int AddScaledOutput(const std::string & name, double widthratio, double heightratio);
+    //! Adds the outputs "level1", "level2", ... of an image pyramid, each
+    //! level half the size of the previous one
+    int AddPyramidOutputs(unsigned int levels);
 
 protected:
+    virtual int OnConnectInput(svlFilterInput &input, svlStreamType type);
     virtual int Initialize(svlSample* syncInput, svlSample* &syncOutput);
     virtual int Process(svlProcInfo* procInfo, svlSample* syncInput, svlSample* &syncOutput);
     virtual int Release();
@@ -54,8 +66,18 @@ private:
     double HeightRatio[2];
     unsigned int Width[2];
     unsigned int Height[2];
-    bool InterpolationEnabled;
-    vctDynamicVector<unsigned char> Internals[2];
+    int Method;
+    svlImageProcessing::Internals ResizeInternals[2];
+
+    struct ScaledOutput
+    {
+        std::string Name;
+        double WidthRatio;
+        double HeightRatio;
+        svlSampleImage* Image;
+    };
+    std::vector<ScaledOutput> ScaledOutputs;
+    std::vector<svlSampleImage*> Destinations;
 
 protected:
     virtual void CreateInterfaces();
@@ -52,7 +52,7 @@ private:
     int Radius;
     int Threshold;
 
-    void FilterBlur(unsigned char* img_in, unsigned char* img_out, const int width, const int height, int radius);
+    void FilterBlur(unsigned char* img_in, unsigned char* img_out, const int width, const int height, int radius, const int row_from, const int row_to);
     void Sharpening(unsigned char* img_in, unsigned char* img_mask, unsigned char* img_out, const int width, const int height);
 };
 
@@ -71,6 +71,8 @@ class CISST_EXPORT svlFilterInput: public mtsInterfaceInput
 
     int PushSample(const svlSample* sample);
     svlSample* PullSample(bool waitfornew, double timeout = 5.0);
+    //! Samples pushed to a non-trunk input and overwritten before they were pulled
+    int GetDroppedSampleCount(void);
 
     double GetTimestamp(void);
 
@@ -66,6 +66,7 @@ class CISST_EXPORT svlFilterOutput: public mtsInterfaceOutput
 
     void SetupSample(svlSample* sample);
     void PushSample(const svlSample* sample);
+    void PushSharedSample(svlSample* sample);
 
     double GetTimestamp(void);
 
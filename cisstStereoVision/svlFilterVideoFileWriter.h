@@ -62,6 +62,9 @@ public:
     int GetCodecName(std::string &name, unsigned int videoch = SVL_LEFT) const;
     svlVideoIO::Compression* GetCodecParams(unsigned int videoch = SVL_LEFT) const;
     int GetCodecParams(svlVideoIO::Compression **compression, unsigned int videoch = SVL_LEFT) const;
+    double GetCompressionTime(unsigned int videoch = SVL_LEFT);
+    double GetAverageCompressionTime(unsigned int videoch = SVL_LEFT);
+    int GetClientStatistics(std::vector<svlVideoIO::ClientStatistics> &stats, unsigned int videoch = SVL_LEFT);
 
     int OpenFile(unsigned int videoch = SVL_LEFT);
     int CISST_DEPRECATED OpenFile(const std::string &filepath, unsigned int videoch = SVL_LEFT);
@@ -32,6 +32,8 @@ class svlFilterOutput;
 class svlStreamManager;
 class svlStreamProc;
 class svlStreamBranchSource;
+class svlSampleQueueBlocking;
+class svlSamplePool;
 
 class svlFilterImageOverlay;
 
@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstStereoVision/svlTypes.h>
 #include <cisstStereoVision/svlCameraGeometry.h>
+#include <vector>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -57,6 +58,20 @@ namespace svlImageProcessing
         DI_AdaptiveDiscarding
     };
 
+    enum RS_Method
+    {
+        RS_Nearest,
+        RS_Bilinear,
+        RS_Bicubic,
+        RS_Area
+    };
+
+    enum PY_Filter
+    {
+        PY_Box,
+        PY_Gaussian
+    };
+
 
     int CISST_EXPORT Convolution(svlSampleImage* src_img,
                                  unsigned int src_videoch,
@@ -66,6 +81,23 @@ namespace svlImageProcessing
                                  vctDynamicVector<double> kernel_vert,
                                  bool absres = false);
 
+    /*! Separable convolution split into horizontal strips among the threads
+        of the filter; must be called by all threads.  RGB, RGBA, and Mono8
+        images are filtered with vectorized passes (bit-exact with the
+        function above), box and symmetric (e.g. Gaussian) kernels take
+        faster paths.  Other pixel types are processed on a single thread.
+        Source and destination must be different images; the result is
+        written to dst_img and src_img is left unmodified for all types. */
+    int CISST_EXPORT Convolution(svlProcInfo* procInfo,
+                                 svlSampleImage* src_img,
+                                 unsigned int src_videoch,
+                                 svlSampleImage* dst_img,
+                                 unsigned int dst_videoch,
+                                 const vctDynamicVector<double> & kernel_horiz,
+                                 const vctDynamicVector<double> & kernel_vert,
+                                 bool absres,
+                                 Internals& internals);
+
     int CISST_EXPORT Convolution(svlSampleImage* src_img,
                                  unsigned int src_videoch,
                                  svlSampleImage* dst_img,
@@ -73,6 +105,12 @@ namespace svlImageProcessing
                                  vctDynamicMatrix<double> kernel,
                                  bool absres = false);
 
+    /*! Factors a non-negative rank-1 kernel into a horizontal kernel summing
+        to 1 and a vertical kernel; returns false if it cannot be separated. */
+    bool CISST_EXPORT SeparateKernel(const vctDynamicMatrix<double> & kernel,
+                                     vctDynamicVector<double> & kernel_horiz,
+                                     vctDynamicVector<double> & kernel_vert);
+
     int CISST_EXPORT UnsharpMask(const svlSampleImage* src_img,
                                  unsigned int src_videoch,
                                  svlSampleImage* dst_img,
@@ -101,6 +139,43 @@ namespace svlImageProcessing
                             bool interpolation,
                             vctDynamicVector<unsigned char>& internals);
 
+    /*! Resize split into bands of source rows among the threads of the
+        filter; must be called by all threads.  Mono8 and RGB images only.
+        Bilinear and bicubic resampling use precomputed per-column and
+        per-row weight tables and a vectorized vertical pass.  RS_Area
+        averages the source pixels covered by each destination pixel (exact
+        box filter for integer ratios) and should be used for downscaling;
+        when enlarging it is the same as RS_Bilinear. */
+    int CISST_EXPORT Resize(svlProcInfo* procInfo,
+                            svlSampleImage* src_img,
+                            unsigned int src_videoch,
+                            svlSampleImage* dst_img,
+                            unsigned int dst_videoch,
+                            RS_Method method,
+                            Internals& internals);
+
+    /*! Same as above, producing several destination images (e.g. an image
+        pyramid) in a single pass over the source image. */
+    int CISST_EXPORT Resize(svlProcInfo* procInfo,
+                            svlSampleImage* src_img,
+                            unsigned int src_videoch,
+                            const std::vector<svlSampleImage*> & dst_imgs,
+                            unsigned int dst_videoch,
+                            RS_Method method,
+                            Internals& internals);
+
+    /*! Fills all levels of an image pyramid from the source image, which
+        must have the size, pixel type, and video channels of level 0; must
+        be called by all threads.  PY_Box averages 2^k x 2^k pixel blocks of
+        the source for level k in a single pass (see RS_Area).  PY_Gaussian
+        builds each level from the previous one with a 5x5 binomial filter
+        followed by decimation; threads synchronize between levels. */
+    int CISST_EXPORT BuildPyramid(svlProcInfo* procInfo,
+                                  svlSampleImage* src_img,
+                                  svlSampleImagePyramid* pyramid,
+                                  PY_Filter filter,
+                                  Internals& internals);
+
     int CISST_EXPORT Deinterlace(svlSampleImage* image,
                                  unsigned int videoch,
                                  DI_Algorithm algorithm);
@@ -132,6 +207,14 @@ namespace svlImageProcessing
                              bool interpolation,
                              Internals& internals);
 
+    int CISST_EXPORT Rectify(svlProcInfo* procInfo,
+                             svlSampleImage* src_img,
+                             unsigned int src_videoch,
+                             svlSampleImage* dst_img,
+                             unsigned int dst_videoch,
+                             bool interpolation,
+                             Internals& internals);
+
     int CISST_EXPORT SetExposure(svlSampleImage* image,
                                  unsigned int videoch,
                                  double brightness,
@@ -178,6 +261,20 @@ namespace svlImageProcessing
                                          svlSampleImageMono32Stereo* labels,
                                          const unsigned int videoch,
                                          Internals& internals);
+    /*! Multi-threaded blob labeling: the image is split into horizontal
+        strips labeled by the threads of the stream, then the strips are
+        merged and blob statistics are collected for GetBlobsFromLabels.
+        The stereo version labels both channels at the same time.
+        Has to be called on all threads of the filter. */
+    int CISST_EXPORT LabelBlobs(svlProcInfo* procInfo,
+                                const svlSampleImageMono8* image,
+                                svlSampleImageMono32* labels,
+                                Internals& internals);
+    int CISST_EXPORT LabelBlobs(svlProcInfo* procInfo,
+                                const svlSampleImageMono8Stereo* image,
+                                svlSampleImageMono32Stereo* labels,
+                                Internals& internals_left,
+                                Internals& internals_right);
     int CISST_EXPORT GetBlobsFromLabels(const svlSampleImageMono8* image,
                                         const svlSampleImageMono32* labels,
                                         svlSampleBlobs* blobs,
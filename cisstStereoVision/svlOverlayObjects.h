@@ -34,6 +34,7 @@ http://www.cisst.org/cisst/license.txt.
 
 // Forward declarations
 class svlBufferImage;
+class svlOverlayLayer;
 
 
 class CISST_EXPORT svlOverlay
@@ -62,8 +63,16 @@ public:
     void SetTransformSynchronized(bool transform_synchronized);
     bool GetTransformSynchronized() const;
 
+    //! Signals that the overlay has to be redrawn.  Setters call it
+    //! automatically; call it after changing the overlay through other
+    //! means, e.g. through the points returned by svlOverlayStaticPoly::GetPoints().
+    void Invalidate();
+
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input) = 0;
+    //! Overlays that draw the same pixels until Invalidate() is called
+    //! may be rasterized once and cached by svlFilterImageOverlay
+    virtual bool IsCacheable() const;
 
 private:
     void Draw(svlSampleImage* bgimage, svlSample* input);
@@ -82,6 +91,8 @@ private:
     svlOverlay*  Prev;
     bool         Used;
     RemoveState  MarkedForRemoval;
+    bool         Modified;
+    svlOverlayLayer* Layer;
 };
 
 
@@ -281,6 +292,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     svlBufferImage* Buffer;
@@ -332,6 +344,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     std::string Text;
@@ -386,6 +399,7 @@ public:
 protected:
     virtual bool IsInputTypeValid(svlStreamType inputtype);
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     svlRect Rect;
@@ -424,6 +438,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     svlRect Rect;
@@ -465,6 +480,7 @@ public:
     {
         Ellipse.cx = static_cast<int>(center[0]);
         Ellipse.cy = static_cast<int>(center[1]);
+        Invalidate();
     }
 
     void SetCenter(const svlPoint2D & center);
@@ -485,6 +501,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     svlEllipse Ellipse;
@@ -534,6 +551,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     svlPoint2D Corner1;
@@ -626,6 +644,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     Type Poly;
@@ -688,6 +707,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     vct2 Range;
@@ -727,6 +747,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     svlFilterBase* Filter;
@@ -759,6 +780,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     svlFilterBase* Filter;
@@ -786,6 +808,7 @@ public:
 
 protected:
     virtual void DrawInternal(svlSampleImage* bgimage, svlSample* input);
+    virtual bool IsCacheable() const;
 
 private:
     svlFilterOutput* Output;
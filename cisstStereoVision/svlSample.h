@@ -23,6 +23,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _svlSample_h
 
 #include <cisstStereoVision/svlTypes.h>
+#include <cisstStereoVision/svlForwardDeclarations.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -30,6 +31,8 @@ http://www.cisst.org/cisst/license.txt.
 
 class CISST_EXPORT svlSample : public mtsGenericObject
 {
+friend class svlSamplePool;
+
 public:
     svlSample();
     svlSample(const svlSample & other);
@@ -55,11 +58,18 @@ public:
     static svlSample* GetNewFromType(svlStreamType type);
     void SetEncoder(const std::string & codec, const int parameter);
     void GetEncoder(std::string & codec, int & parameter) const;
+    svlSamplePool* GetPool() const;
+    unsigned int GetReferenceCount() const;
+    bool IsShared() const;
 
 private:
     double Timestamp; // [seconds]
     std::string Encoder;
     int EncoderParameter;
+
+    // Managed by svlSamplePool; never copied between samples
+    svlSamplePool* Pool;
+    unsigned int References;
 };
 
 #endif // _svlSample_h
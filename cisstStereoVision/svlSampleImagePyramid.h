@@ -0,0 +1,100 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlSampleImagePyramid_h
+#define _svlSampleImagePyramid_h
+
+#include <cisstStereoVision/svlSampleImage.h>
+#include <vector>
+
+// Always include last!
+#include <cisstStereoVision/svlExport.h>
+
+
+/*!
+  Multi-resolution copy of an 8 bit image (Mono8 or RGB, single or stereo).
+  Level 0 has the size of the original image; each further level is half
+  the size of the previous one (rounded down, at least 1 pixel).  All levels
+  of all video channels are stored in one contiguous buffer.  GetLevel()
+  returns an image referencing the data of a level, so the levels can be
+  passed to any function taking an svlSampleImage without copying.
+*/
+class CISST_EXPORT svlSampleImagePyramid : public svlSample
+{
+    CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+public:
+    svlSampleImagePyramid();
+    svlSampleImagePyramid(const svlSampleImagePyramid & other);
+    svlSampleImagePyramid & operator= (const svlSampleImagePyramid & other);
+    virtual ~svlSampleImagePyramid();
+
+    svlSample* GetNewInstance() const;
+    svlStreamType GetType() const;
+    int SetSize(const svlSample* sample);
+    int SetSize(const svlSample& sample);
+    int CopyOf(const svlSample* sample);
+    int CopyOf(const svlSample& sample);
+    bool IsInitialized() const;
+    unsigned char* GetUCharPointer();
+    const unsigned char* GetUCharPointer() const;
+    unsigned int GetDataSize() const;
+    void SerializeRaw(std::ostream & outputStream) const;
+    void DeSerializeRaw(std::istream & inputStream);
+
+    //! Level 0 takes the type and the size of each video channel of 'image'
+    int SetSize(const svlSampleImage & image, const unsigned int levels);
+    //! Same size for all video channels; 'imagetype' is one of the 8 bit Mono8 or RGB image types
+    int SetSize(const svlStreamType imagetype, const unsigned int width, const unsigned int height, const unsigned int levels);
+
+    svlStreamType GetImageType() const;
+    svlPixelType GetPixelType() const;
+    unsigned int GetBPP() const;
+    unsigned int GetVideoChannels() const;
+    unsigned int GetLevelCount() const;
+    unsigned int GetWidth(const unsigned int level, const unsigned int videochannel = 0) const;
+    unsigned int GetHeight(const unsigned int level, const unsigned int videochannel = 0) const;
+    unsigned char* GetUCharPointer(const unsigned int level, const unsigned int videochannel);
+    const unsigned char* GetUCharPointer(const unsigned int level, const unsigned int videochannel) const;
+    unsigned int GetDataSize(const unsigned int level, const unsigned int videochannel) const;
+
+    //! Image referencing the data of the level; owned by the pyramid and
+    //! valid until the pyramid is resized
+    svlSampleImage* GetLevel(const unsigned int level);
+    const svlSampleImage* GetLevel(const unsigned int level) const;
+
+protected:
+    svlStreamType ImageType;
+    unsigned int VideoChannels;
+    unsigned int BPP;
+    unsigned int Levels;
+    std::vector<unsigned int> Width;    // level * VideoChannels + videochannel
+    std::vector<unsigned int> Height;
+    std::vector<unsigned int> Offset;
+    vctDynamicVector<unsigned char> Buffer;
+    std::vector<svlSampleImage*> LevelImages;
+
+    int Allocate(const svlStreamType imagetype, const std::vector<unsigned int> & width, const std::vector<unsigned int> & height, const unsigned int levels);
+    void ReleaseLevelImages();
+    void CreateLevelImages();
+    unsigned int GetIndex(const unsigned int level, const unsigned int videochannel) const;
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION_EXPORT(svlSampleImagePyramid)
+
+#endif // _svlSampleImagePyramid_h
+
@@ -0,0 +1,88 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlSamplePool_h
+#define _svlSamplePool_h
+
+#include <cisstOSAbstraction/osaCriticalSection.h>
+#include <cisstStereoVision/svlTypes.h>
+
+// Always include last!
+#include <cisstStereoVision/svlExport.h>
+
+
+/*!
+  Recycles svlSample objects and shares them between consumers.
+
+  Acquire() returns a sample with one reference; AddReference() lets
+  further consumers hold the same sample without copying it, and
+  Release() drops a reference.  When the last reference is released the
+  sample, together with its buffers, goes back to the pool and is handed
+  out again, with its timestamp and encoder settings reset, by the next
+  Acquire() of the same type, so filters and
+  buffers re-allocating outputs of the same size do not touch the heap.
+
+  Shared samples are read-only: a holder that needs to modify a sample
+  calls GetWritable(), which returns the sample itself if the caller is
+  the only holder, or a private copy otherwise (copy-on-write).
+
+  The pool is thread-safe.  GetInstance() returns the pool shared by
+  all streams, filters, and buffers of the process.
+*/
+class CISST_EXPORT svlSamplePool
+{
+public:
+    svlSamplePool(unsigned int maxfree = 16);
+    ~svlSamplePool();
+
+    static svlSamplePool* GetInstance();
+
+    //! Sample of the given type, preferably one released recently
+    svlSample* Acquire(svlStreamType type);
+    //! Sample of the same type and size as the prototype (contents not copied)
+    svlSample* Acquire(const svlSample* prototype);
+    //! Sample holding a copy of the source
+    svlSample* AcquireCopy(const svlSample* source);
+
+    //! Shares a pooled sample; samples not allocated by a pool are copied instead
+    svlSample* AddReference(svlSample* sample);
+    //! Drops a reference; ignored for samples not allocated by a pool
+    void Release(svlSample* sample);
+    //! Copy-on-write: sample itself if not shared, otherwise a private copy replacing the caller's reference
+    svlSample* GetWritable(svlSample* sample);
+
+    void SetMaxFreeCount(unsigned int count);
+    unsigned int GetMaxFreeCount() const;
+    unsigned int GetFreeCount() const;
+    unsigned int GetAllocationCount() const;
+    unsigned int GetRecycleCount() const;
+    //! Deletes the samples that are not in use
+    void Clear();
+
+private:
+    svlSample* Recycle(svlStreamType type, unsigned int datasize);
+    void Trim();
+
+    unsigned int MaxFree;
+    unsigned int Allocations;
+    unsigned int Recycles;
+    std::list<svlSample*> FreeItems;
+
+    mutable osaCriticalSection CS;
+};
+
+#endif // _svlSamplePool_h
@@ -25,11 +25,22 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaThreadSignal.h>
 #include <cisstOSAbstraction/osaCriticalSection.h>
 #include <cisstStereoVision/svlTypes.h>
+#include <cisstStereoVision/svlSamplePool.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
 
 
+/*!
+  Queue of samples feeding a stream branch.  When the queue is full the
+  oldest sample is dropped.  Items come from svlSamplePool: Push() queues
+  a pooled copy of the sample while PushShared() queues a reference to a
+  pooled sample, so several branches fed from the same frame share a
+  single copy.  By default Pull() hands out a private sample: a shared
+  item is copied if another branch still holds it.  After
+  SetReadOnly(true) Pull() returns shared items as they are; the
+  consumer must not modify them.
+*/
 class CISST_EXPORT svlSampleQueue
 {
 public:
@@ -37,7 +48,9 @@ public:
     ~svlSampleQueue();
 
     bool Push(const svlSample* sample);
+    bool PushShared(svlSample* sample);
     svlSample* Pull(double timeout = 5.0);
+    void SetReadOnly(bool readonly);
 
     svlStreamType GetType();
     unsigned int GetLength();
@@ -47,17 +60,76 @@ public:
     svlSample* Peek();
 
 private:
+    bool Enqueue(svlSample* item);
+
     svlStreamType Type;
     unsigned int Size;
     unsigned int DroppedSamples;
-    std::list<svlSample*> UnusedItems;
+    bool ReadOnly;
     std::list<svlSample*> BufferedItems;
     svlSample* PullItem;
+    svlSamplePool* Pool;
 
     osaCriticalSection CS;
     osaThreadSignal NewSampleEvent;
 };
 
+
+/*!
+  Bounded FIFO of sample copies between a single producer and a single
+  consumer thread.  Unlike svlSampleQueue, samples are never dropped:
+  Push blocks while the queue is full and Pull blocks while it is empty.
+  Used between the stages of a pipelined svlStreamManager.
+*/
+class CISST_EXPORT svlSampleQueueBlocking
+{
+public:
+    svlSampleQueueBlocking(svlStreamType type, unsigned int length);
+    ~svlSampleQueueBlocking();
+
+    //! Copy sample to the tail, returns false if the queue was aborted
+    bool Push(const svlSample* sample);
+    //! Oldest sample, kept in the queue until Pop(); returns 0 once closed and empty or aborted
+    svlSample* Pull();
+    //! Remove the sample returned by Pull()
+    void Pop();
+    //! No more samples will be pushed, Pull() returns 0 once the queue is empty
+    void Close();
+    //! Unblock both threads, Push() and Pull() fail from now on
+    void Abort();
+
+    svlStreamType GetType() const;
+    unsigned int GetLength() const;
+    unsigned int GetUsage() const;
+    //! Highest number of queued samples since the queue was created
+    unsigned int GetMaxUsage() const;
+    //! Average number of queued samples, sampled at each Push
+    double GetAverageUsage() const;
+    //! Total time [s] Push waited for a free slot
+    double GetBlockedTime() const;
+    //! All of the above in one consistent snapshot
+    void GetStatistics(unsigned int & usage, unsigned int & maxusage, double & averageusage, double & blockedtime) const;
+
+private:
+    svlSampleQueueBlocking();
+
+    svlStreamType Type;
+    vctDynamicVector<svlSample*> Buffer;
+    unsigned int Head;
+    unsigned int Tail;
+    unsigned int Usage;
+    unsigned int MaxUsage;
+    unsigned int PushCount;
+    double UsageSum;
+    double BlockedTime;
+    bool Closed;
+    bool Aborted;
+
+    mutable osaCriticalSection CS;
+    osaThreadSignal NotEmptyEvent;
+    osaThreadSignal NotFullEvent;
+};
+
 /*
 class CISST_EXPORT svlSampleQueu2
 {
@@ -46,6 +46,7 @@ private:
     static bool IsTypeSupported(svlStreamType type);
     void SetInput(svlSample* syncInput);
     void PushSample(const svlSample* syncInput);
+    void PushSharedSample(svlSample* syncInput);
 
     bool InputBlocked;
     svlSampleQueue SampleQueue;
@@ -25,6 +25,8 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstVector/vctDynamicVector.h>
 #include <cisstMultiTask/mtsComponent.h>
+#include <cisstMultiTask/mtsVector.h>
+#include <cisstStereoVision/svlDefinitions.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -35,6 +37,8 @@ class svlSyncPoint;
 class svlFilterBase;
 class svlFilterSourceBase;
 class svlStreamProc;
+class svlSampleQueueBlocking;
+class svlStreamInstrumentation;
 class osaThread;
 class osaCriticalSection;
 
@@ -61,6 +65,57 @@ public:
     int GetStreamStatus(void) const;
     void DisconnectAll(void);
 
+    /*! In pipeline mode each filter of the trunk becomes a pipeline
+        stage running on its own thread, connected to the next stage
+        by a bounded queue of sample copies, so that several frames can
+        be in flight at the same time.  Filters are processed by a
+        single thread (svlProcInfo::count is 1) and must not keep
+        pointers to their input samples between two calls of Process.
+        Sample timestamps are preserved.  When the source stops,
+        the frames already in flight are processed before the stream
+        stops.  Can only be changed while the stream is stopped.
+        \param enable Pipeline mode if true, default lockstep mode otherwise
+        \param queuelength Number of samples buffered between two stages
+    */
+    int SetPipelineMode(bool enable, unsigned int queuelength = 2);
+    bool GetPipelineMode(void) const;
+
+    /*! Selects the barrier used between filters when the stream runs
+        on multiple threads, see svlSyncPoint.  Can only be changed while
+        the stream is stopped.
+        \param type svlSyncPointEvent (default) or svlSyncPointSpin
+        \param spincount Polling iterations before sleeping (svlSyncPointSpin only)
+    */
+    int SetSyncPointType(svlSyncPointType type, unsigned int spincount = 4000);
+    svlSyncPointType GetSyncPointType(void) const;
+
+    /*! Stream instrumentation.  The measurements are reset each time the
+        stream starts.  The report lists, for each filter of the trunk,
+        the average time spent in Process and at barriers, the dropped
+        samples and buffer usage of asynchronous connections, the
+        occupancy of the pipeline queues (while the stream is running)
+        and the capture-to-sink latency.
+        Latency is measured for sources that let the stream timestamp
+        their samples (svlFilterSourceBase(true), the default), from
+        the timestamp until the last filter of the trunk has finished
+        the frame.
+    */
+    std::string GetInstrumentationReport(void) const;
+    //! Latency histogram; bin i counts latencies in [i*binwidth, (i+1)*binwidth) seconds,
+    //! the last bin collects all longer latencies
+    void GetLatencyHistogram(vctDynamicVector<unsigned int> & histogram, double & binwidth) const;
+    void ResetInstrumentation(void);
+
+    /*! Records each execution of a trunk filter (thread, frame, start time,
+        duration and barrier wait time) so that it can be saved in the Trace
+        Event Format of Chrome's trace viewer (chrome://tracing, Perfetto).
+        Recording stops when a thread has recorded maxevents events.
+        \param maxevents Events recorded per thread, 0 (default) disables tracing
+    */
+    void SetTraceLength(unsigned int maxevents);
+    unsigned int GetTraceLength(void) const;
+    int SaveTrace(const std::string & filename) const;
+
     // Virtual methods from mtsComponent (these are temporary measures until 
     // ticket #67 is resolved)
     void Start(void) { Play(); }
@@ -71,8 +126,19 @@ private:
     vctDynamicVector<svlStreamProc*> StreamProcInstance;
     vctDynamicVector<osaThread*> StreamProcThread;
     svlSyncPoint* SyncPoint;
+    svlSyncPointType SyncPointType;
+    unsigned int SyncPointSpinCount;
     osaCriticalSection* CS;
 
+    bool PipelineMode;
+    unsigned int PipelineQueueLength;
+    vctDynamicVector<svlFilterBase*> PipelineStages;
+    vctDynamicVector<svlSampleQueueBlocking*> PipelineQueues;
+    //! Guards PipelineQueues against deletion while a report reads them
+    osaCriticalSection* PipelineCS;
+
+    svlStreamInstrumentation* Instrumentation;
+
     svlFilterSourceBase* StreamSource;
     bool Initialized;
     bool Running;
@@ -80,12 +146,19 @@ private:
     int StreamStatus;
 
     void InternalStop(unsigned int callingthreadID);
+    int CreatePipeline(void);
+    void AbortPipeline(void);
+    void DeletePipeline(void);
 
 protected:
     virtual void CreateInterfaces(void);
     virtual void PlayCommand(void);
     virtual void InitializeCommand(void);
     virtual void SetSourceFilterCommand(const mtsStdString & source);
+    virtual void GetInstrumentationReportCommand(mtsStdString & report) const;
+    virtual void GetLatencyHistogramCommand(mtsUIntVec & histogram) const;
+    virtual void SetTraceLengthCommand(const unsigned int & maxevents);
+    virtual void SaveTraceCommand(const mtsStdString & filename);
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(svlStreamManager);
@@ -34,11 +34,13 @@ public:
     svlStreamProc(unsigned int threadcount, unsigned int threadid);
 
     void* Proc(svlStreamManager* baseref);
+    void* PipelineProc(svlStreamManager* baseref);
 
 private:
     svlStreamProc();
 
     double GetAbsoluteTime(osaTimeServer* timeserver);
+    int PassDownstream(svlFilterBase* filter, svlSample* outputsample, svlSampleQueueBlocking* queue);
 
     unsigned int ThreadID;
     unsigned int ThreadCount;
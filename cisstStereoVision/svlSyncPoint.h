@@ -24,11 +24,30 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstOSAbstraction/osaThreadSignal.h>
 #include <cisstOSAbstraction/osaCriticalSection.h>
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstStereoVision/svlDefinitions.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
 
 
+/*!
+  Barrier synchronizing the threads of a stream.
+
+  svlSyncPointEvent (default): threads check in within a critical
+  section and all but the last one block on their own thread signal.
+
+  svlSyncPointSpin: sense-reversing barrier based on atomic operations.
+  Waiting threads spin for a bounded number of iterations, then sleep
+  (on a futex on Linux, otherwise yield) until the last thread flips
+  the barrier generation.  No system call is made as long as threads
+  arrive within the spin window.  Spinning is disabled when there are
+  more threads than CPUs since a spinning thread would only delay the
+  ones it is waiting for.
+
+  The time each thread spends waiting is accumulated and can be queried
+  with GetWaitTime.
+*/
 class CISST_EXPORT svlSyncPoint
 {
 public:
@@ -40,13 +59,36 @@ public:
     int Sync(unsigned int _id);
     void ReleaseAll();
 
+    /*! Sets the barrier implementation, not thread safe.
+        \param spincount Number of polling iterations before sleeping (svlSyncPointSpin only)
+    */
+    int SetType(svlSyncPointType type, unsigned int spincount = 4000);
+    svlSyncPointType GetType() const;
+
+    //! Total time [s] thread _id spent waiting in Sync
+    double GetWaitTime(unsigned int _id) const;
+
 private:
+    int EventSync(unsigned int _id);
+    int SpinSync(unsigned int _id);
+    void UpdateSpinCount();
+
+    svlSyncPointType Type;
+    unsigned int SpinCount;
+    unsigned int EffectiveSpinCount;
     unsigned int ThreadCount;
     int LastChanged;
     unsigned int CheckedInCounter;
     osaThreadSignal* ReleaseEvent;
     osaCriticalSection CS;
+    vctDoubleVec WaitTime;
+
+#if (CISST_OS == CISST_WINDOWS)
+    // LONG of the Interlocked functions, without including windows.h here
+    volatile long Remaining, Generation, Sleepers, Released;
+#else
+    volatile int Remaining, Generation, Sleepers, Released;
+#endif
 };
 
 #endif // _svlSyncPoint_h
-
@@ -83,10 +83,10 @@ protected:
     unsigned int SearchRadiusRequested;
     unsigned int TemplateRadius;
     unsigned int SearchRadius;
-    vctDynamicMatrix<int> MatchMap;
+    vctFixedSizeVector<vctDynamicMatrix<int>, 128> MatchMap;
     vctFixedSizeVector<vctDynamicMatrix<unsigned int>, 3> SumTable;
     vctFixedSizeVector<vctDynamicMatrix<unsigned int>, 3> SqSumTable;
-    vctFixedSizeVector<vctDynamicVector<int>, 128> ZeroMeanTemplate;
+    vctFixedSizeVector<vctDynamicVector<short>, 128> ZeroMeanTemplate;
 
     int HighPassFilterRadius;
     double HighPassFilterStrength;
@@ -105,12 +105,14 @@ protected:
 
     virtual void CopyTemplate(unsigned char* img, unsigned char* tmp, unsigned int left, unsigned int top);
     virtual void UpdateTemplate(unsigned char* img, unsigned char* tmp, unsigned int left, unsigned int top);
-    virtual void MatchTemplateSAD(unsigned char* img, unsigned char* tmp, int x, int y);
-    virtual void MatchTemplateSSD(unsigned char* img, unsigned char* tmp, int x, int y);
-    virtual void MatchTemplateNCC(unsigned char* img, unsigned char* tmp, int x, int y);
-    virtual void MatchTemplateFastNCC(unsigned char* img, unsigned char* tmp, int* zero_mean_tmp, int x, int y);
-    virtual void MatchTemplateNotQuiteNCC(unsigned char* img, unsigned char* tmp, int x, int y);
-    virtual void GetBestMatch(int &x, int &y, unsigned char &conf, bool higherbetter);
+    // Match maps and zero mean templates are per thread: the threads of
+    // Track(procInfo, ...) process different targets at the same time
+    virtual void MatchTemplateSAD(unsigned char* img, unsigned char* tmp, int x, int y, int* map);
+    virtual void MatchTemplateSSD(unsigned char* img, unsigned char* tmp, int x, int y, int* map);
+    virtual void MatchTemplateNCC(unsigned char* img, unsigned char* tmp, short* zero_mean_tmp, int x, int y, int* map);
+    virtual void MatchTemplateFastNCC(unsigned char* img, unsigned char* tmp, short* zero_mean_tmp, int x, int y, int* map);
+    virtual void MatchTemplateNotQuiteNCC(unsigned char* img, unsigned char* tmp, int x, int y, int* map);
+    virtual void GetBestMatch(int &x, int &y, unsigned char &conf, bool higherbetter, const int* map);
     virtual void ShrinkImage(unsigned char* src, unsigned char* dst);
     virtual void CalculateSumTables(unsigned char* img);
 };
@@ -180,6 +180,7 @@ struct CISST_EXPORT svlBlob
 #include <cisstStereoVision/svlSampleText.h>
 #include <cisstStereoVision/svlSampleCameraGeometry.h>
 #include <cisstStereoVision/svlSampleBlobs.h>
+#include <cisstStereoVision/svlSampleImagePyramid.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
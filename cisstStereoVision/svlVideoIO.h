@@ -26,6 +26,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstVector/vctDynamicVectorTypes.h>
 #include <cisstOSAbstraction/osaCriticalSection.h>
 #include <string>
+#include <vector>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -55,6 +56,19 @@ public:
         unsigned char   data[1];
     } Compression;
 
+    // Statistics of a client connected to a network streaming codec
+    typedef struct _ClientStatistics
+    {
+        std::string         address;
+        double              connectiontime;     // [s] since connected
+        unsigned int        framessent;
+        unsigned int        framesdropped;      // skipped because the client was too slow
+        unsigned long long  bytessent;
+        double              bandwidth;          // [bytes/s] average since connected
+        double              latency;            // [s] from encoding to fully sent, last frame
+        double              averagelatency;     // [s]
+    } ClientStatistics;
+
 private:
     typedef vctDynamicVector<cmnClassServicesBase*> _CodecList;
     typedef vctDynamicVector<svlVideoCodecBase*> _CodecCacheList;
@@ -130,6 +144,10 @@ public:
     virtual int Read(svlProcInfo* procInfo, svlSampleImage &image, const unsigned int videoch, const bool noresize = false) = 0;
     virtual int Write(svlProcInfo* procInfo, const svlSampleImage &image, const unsigned int videoch) = 0;
 
+    virtual double GetCompressionTime() const;
+    virtual double GetAverageCompressionTime() const;
+    virtual int GetClientStatistics(std::vector<svlVideoIO::ClientStatistics> &stats) const;
+
 public:
     virtual void SetExtension(const std::string & extension) = 0;
     virtual void SetEncoderID(const int & encoder_id) = 0;